@@ -352,14 +352,15 @@ namespace Simd
                 size_t j = 0;
                 img1 = &img1_[(i0 + i) * width1 + j0];
 
-                for (; j <= width2 - 2; j += 2, img1 += 2, img2 += 2) {
+                for (; j + 2 <= width2; j += 2, img1 += 2, img2 += 2) {
                     const __m128d v1 = _mm_loadu_pd(img1);
                     const __m128d v2 = _mm_loadu_pd(img2);
                     v_ab = _mm_add_pd(v_ab, _mm_mul_pd(v1, v2));
                 }
 
-                for (; j < width2; j++) {
-                    ab += img1[(i0 + i)*width1 + j0 + j] * img2[i*width2 + j];
+                // img1 and img2 already point to the remaining column of odd width templates
+                for (; j < width2; j++, img1++, img2++) {
+                    ab += (*img1) * (*img2);
                 }
             }
 
@@ -36,7 +36,7 @@
 #include <vector>
 #include <iostream>
 #if !defined(_WIN32) && (defined(__unix__) || defined(__unix) || (defined(__APPLE__) && defined(__MACH__))) // UNIX
-#include <sys/resource.h> // To dynamically change the stack size
+#include <sys/resource.h> // For rlim_t
 #endif
 
 // ViSP include
@@ -56,9 +56,10 @@ BEGIN_VISP_NAMESPACE
  * It is possible to use a boolean mask to ignore some pixels of
  * the input gray-scale image.
  *
- * \warning If the stack size is not sufficient, a SEGFAULT can occur on some images which
- * are really over-exposed.
- * \note The maximum stack on MacOS seems to be 65532000 bytes, see https://stackoverflow.com/a/13261334
+ * The gradient computation and the non-maximum suppression are parallelized over the image rows
+ * when ViSP is built with OpenMP. The edge tracking of the hysteresis step uses an explicit stack, so that
+ * no particular stack size is required whatever the image content, even when the detector is used from
+ * threads with a small fixed stack.
 */
 class VISP_EXPORT vpCannyEdgeDetection
 {
@@ -142,8 +143,6 @@ public:
   /**
    * \brief Detect the edges in an image.
    * Convert the color image into a ViSP gray-scale image.
-   * \warning If the stack size is not sufficient, a SEGFAULT can occur on some images which
-   * are really over-exposed.
    *
    * \param[in] cv_I A color image, in OpenCV format.
    * \return vpImage<unsigned char> 255 means an edge, 0 means not an edge.
@@ -154,8 +153,6 @@ public:
   /**
    * \brief Detect the edges in an image.
    * Convert the color image into a gray-scale image.
-   * \warning If the stack size is not sufficient, a SEGFAULT can occur on some images which
-   * are really over-exposed.
    *
    * \param[in] I_color : An RGB image, in ViSP format.
    * \return vpImage<unsigned char> 255 means an edge, 0 means not an edge.
@@ -164,8 +161,6 @@ public:
 
   /**
    * \brief Detect the edges in a gray-scale image.
-   * \warning If the stack size is not sufficient, a SEGFAULT can occur on some images which
-   * are really over-exposed.
    *
    * \param[in] I : A gray-scale image, in ViSP format.
    * \return vpImage<unsigned char> 255 means an edge, 0 means not an edge.
@@ -276,43 +271,11 @@ public:
   }
 
   /**
-   * \brief Set the minimum stack size, expressed in bytes, due to the recursive algorithm.
-   * If not called, the stack size is left at its default value when running the
-   * Canny edge detection algorithm.
+   * \brief If set to true, the list of the detected edge-points will be available
+   * calling the method \b vpCannyEdgeDetection::getEdgePointsList().
    *
-   * \note The stack size is changed back to its original value after
-   * before leaving the detect() function.
-   * \note On Windows, the minimum stack size is defined at compilation time
-   * and cannot be changed during runtime.
-   * \note The maximum stack on MacOS seems to be 65532000 bytes, see https://stackoverflow.com/a/13261334
-   * \warning If the stack size is not sufficient, a SEGFAULT can occur on some images which
-   * are really over-exposed.
-   *
-   * \param[in] requiredStackSize The required stack size, in bytes.
+   * \param[in] storeEdgePoints The new desired status.
    */
-#if !defined(_WIN32) && (defined(__unix__) || defined(__unix) || (defined(__APPLE__) && defined(__MACH__))) // UNIX
-  inline void setMinimumStackSize(const rlim_t &requiredStackSize)
-  {
-    m_minStackSize = requiredStackSize;
-  }
-#else
-  inline void setMinimumStackSize(const unsigned int &requiredStackSize)
-  {
-    (void)requiredStackSize;
-    static bool hasNotBeenDisplayed = true;
-    if (hasNotBeenDisplayed) {
-      std::cerr << "vpCannyEdgeDetection::setStackSize() has no effect on non-POSIX systems. The stack size is defined during compilation." << std::endl;
-      hasNotBeenDisplayed = false;
-    }
-  }
-#endif
-
-/**
- * \brief If set to true, the list of the detected edge-points will be available
- * calling the method \b vpCannyEdgeDetection::getEdgePointsList().
- *
- * \param[in] storeEdgePoints The new desired status.
- */
   inline void setStoreEdgePoints(const bool &storeEdgePoints)
   {
     m_storeListEdgePoints = storeEdgePoints;
@@ -334,35 +297,46 @@ public:
     return m_edgePointsList;
   }
 
+  //@}
+
+#if defined(VISP_BUILD_DEPRECATED_FUNCTIONS)
+  /*!
+    @name Deprecated functions
+  */
+  //@{
   /**
-   * \brief Get the minimum stack size used by the algorithm.
-   *
-   * \note On Windows, the minimum stack size is defined at compilation time
-   * and cannot be changed during runtime.
-   *
-   * \return rlim_t The minimum stack size.
+   * \deprecated The edge tracking step is no more recursive, there is no need to increase the stack size anymore.
+   * This function does nothing.
    */
 #if !defined(_WIN32) && (defined(__unix__) || defined(__unix) || (defined(__APPLE__) && defined(__MACH__))) // UNIX
-  inline rlim_t getMinimumStackSize() const
+  VP_DEPRECATED inline void setMinimumStackSize(const rlim_t &requiredStackSize)
+#else
+  VP_DEPRECATED inline void setMinimumStackSize(const unsigned int &requiredStackSize)
+#endif
   {
-    return m_minStackSize;
+    (void)requiredStackSize;
   }
+
+  /**
+   * \deprecated The edge tracking step is no more recursive, there is no need to increase the stack size anymore.
+   * \return 0 since no minimum stack size is required.
+   */
+#if !defined(_WIN32) && (defined(__unix__) || defined(__unix) || (defined(__APPLE__) && defined(__MACH__))) // UNIX
+  VP_DEPRECATED inline rlim_t getMinimumStackSize() const
 #else
-  inline unsigned int getMinimumStackSize() const
+  VP_DEPRECATED inline unsigned int getMinimumStackSize() const
+#endif
   {
-    const unsigned int limit = 65532000;
-    return limit;
+    return 0;
   }
-#endif
-
-
   //@}
+#endif
 private:
   typedef enum EdgeType
   {
+    NOT_EDGE, /*!< This pixel is not an edge candidate.*/
     STRONG_EDGE, /*!< This pixel exceeds the upper threshold of the double hysteresis phase, it is thus for sure an edge point.*/
-    WEAK_EDGE,/*!< This pixel is between the lower and upper threshold of the double hysteresis phase, it is an edge point only if it is linked at some point to an edge point.*/
-    ON_CHECK /*!< This pixel is currently tested to know if it is linked to a strong edge point.*/
+    WEAK_EDGE /*!< This pixel is between the lower and upper threshold of the double hysteresis phase, it is an edge point only if it is linked at some point to an edge point.*/
   } EdgeType;
 
   // Filtering + gradient methods choice
@@ -383,7 +357,7 @@ private:
   vpImage<float> m_dIy; /*!< Y-axis gradient.*/
 
   // // Edge thining attributes
-  std::map<std::pair<unsigned int, unsigned int>, float> m_edgeCandidateAndGradient; /*!< Map that contains point image coordinates and corresponding gradient value.*/
+  vpImage<float> m_edgeCandidateAndGradient; /*!< Gradient of the edge candidates that survived the non-maximum suppression, 0 for the other pixels.*/
 
   // // Hysteresis thresholding attributes
   float m_lowerThreshold; /*!< Lower threshold for the hysteresis step. If negative, it will be deduced
@@ -395,12 +369,10 @@ private:
                                     must be lower than the upper threshold \b m_upperThreshold.*/
 
   // // Edge tracking attributes
-#if !defined(_WIN32) && (defined(__unix__) || defined(__unix) || (defined(__APPLE__) && defined(__MACH__))) // UNIX
-  rlim_t m_minStackSize; /*!< Minimum stack size, due to the recursivity used in this step of the algorithm.*/
-#endif
   bool m_storeListEdgePoints; /*!< If true, the vector \b m_edgePointsList will contain the list of the edge points resulting from the whole algorithm.*/
-  std::map<std::pair<unsigned int, unsigned int>, EdgeType> m_edgePointsCandidates; /*!< Map that contains the strong edge points, i.e. the points for which we know for sure they are edge points,
+  vpImage<EdgeType> m_edgePointsCandidates; /*!< Image that flags the strong edge points, i.e. the points for which we know for sure they are edge points,
                                                 and the weak edge points, i.e. the points for which we still must determine if they are actual edge points.*/
+  std::vector<std::pair<unsigned int, unsigned int> > m_edgeTrackingStack; /*!< Explicit stack of the edge points whose neighborhood must be explored during edge tracking.*/
   vpImage<unsigned char> m_edgeMap; /*!< Final edge map that results from the whole Canny algorithm.*/
   std::vector<vpImagePoint> m_edgePointsList; /*!< List of the edge points that belong to the final edge map.*/
   const vpImage<bool> *mp_mask; /*!< Mask that permits to consider only the pixels for which the mask is true.*/
@@ -427,6 +399,14 @@ private:
    */
   void computeFilteringAndGradient(const vpImage<unsigned char> &I);
 
+  /**
+   * \brief Compute the gradients along the horizontal and vertical axes by convolving the blurred image with the
+   * gradient filters. Equivalent to two calls to vpImageFilter::filter() but done in a single pass over the image,
+   * in parallel over the rows when OpenMP is available.
+   * \param[in] Iblur : The blurred image.
+   */
+  void computeGradients(const vpImage<float> &Iblur);
+
   /**
    * \brief Step 3: Edge thining.
    * \details Perform the edge thining step.
@@ -438,10 +418,10 @@ private:
 
   /**
    * \brief Perform hysteresis thresholding.
-   * \details Edge candidates that are greater than \b m_upperThreshold are saved in \b m_strongEdgePoints
+   * \details Edge candidates that are greater than \b m_upperThreshold are flagged as strong edge points
    * and will be kept in the final edge map.
-   * Edge candidates that are between \b m_lowerThreshold and \b m_upperThreshold are saved in
-   * \b m_weakEdgePoints and will be kept in the final edge map only if they are connected
+   * Edge candidates that are between \b m_lowerThreshold and \b m_upperThreshold are flagged as weak
+   * edge points and will be kept in the final edge map only if they are connected
    * to a strong edge point.
    * Edge candidates that are below \b m_lowerThreshold are discarded.
    * \param[in] lowerThreshold Edge candidates that are below this threshold are definitely not
@@ -451,20 +431,11 @@ private:
    */
   void performHysteresisThresholding(const float &lowerThreshold, const float &upperThreshold);
 
-  /**
-   * \brief Search recursively for a strong edge in the neighborhood of a weak edge.
-   *
-   * \param[in] coordinates : The coordinates we are checking.
-   * \return true We found a strong edge point in its 8-connected neighborhood.
-   * \return false We did not found a strong edge point in its 8-connected neighborhood.
-   */
-  bool recursiveSearchForStrongEdge(const std::pair<unsigned int, unsigned int> &coordinates);
-
   /**
    * \brief Perform edge tracking.
-   * \details For each weak edge, we will recursively check if they are 8-connected to a strong edge point.
-   * If so, the weak edge will be saved in \b m_strongEdgePoints and will be kept in the final edge map.
-   * Otherwise, the edge point will be discarded.
+   * \details Starting from each strong edge point, the 8-connected weak edge points are iteratively promoted to
+   * strong edge points using an explicit stack. Weak edge points that are not connected to a strong edge point
+   * are discarded.
    */
   void performEdgeTracking();
   //@}
@@ -0,0 +1,264 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2024 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ *
+ * Description:
+ * Fixed-size matrix stored on the stack.
+ */
+
+/*!
+ * \file vpFixedMatrix.h
+ * \brief Fixed-size matrix stored on the stack.
+ */
+
+#ifndef VP_FIXED_MATRIX_H
+#define VP_FIXED_MATRIX_H
+
+#include <visp3/core/vpArray2D.h>
+#include <visp3/core/vpConfig.h>
+#include <visp3/core/vpException.h>
+
+BEGIN_VISP_NAMESPACE
+/*!
+  \class vpFixedMatrix
+
+  \ingroup group_core_matrices
+
+  \brief Matrix whose dimensions are known at compile time and whose elements
+  are stored in place, without any heap allocation.
+
+  vpMatrix and all the classes that derive from vpArray2D (vpRotationMatrix,
+  vpHomogeneousMatrix, vpVelocityTwistMatrix...) allocate their elements on
+  the heap. This class is intended to hold the small intermediate matrices
+  involved in 6-dof computations (3x3 rotation blocks, 6x6 twists, 2x6
+  interaction matrix rows...) in hot paths. Since all the loop bounds are
+  known at compile time, the compiler is able to unroll and vectorize the
+  arithmetic operations.
+
+  Elements are stored in row-major order. As for vpArray2D, there is no bound
+  checking when accessing elements with operator[] or operator().
+
+  Conversion to and from heap-backed matrices is achieved with
+  vpFixedMatrix(const vpArray2D<Type> &) and copyTo().
+
+  \code
+  #include <visp3/core/vpFixedMatrix.h>
+  #include <visp3/core/vpMatrix.h>
+
+  #ifdef ENABLE_VISP_NAMESPACE
+  using namespace VISP_NAMESPACE_NAME;
+  #endif
+
+  int main()
+  {
+    vpFixedMatrix<3, 3> R;
+    R.eye();
+    vpFixedColVector<3> t;
+    t(0) = 0.1;
+    vpFixedColVector<3> Rt = R * t;
+
+    vpMatrix M(4, 4);
+    R.copyTo(M);
+    Rt.copyTo(M, 0, 3);
+  }
+  \endcode
+*/
+template <unsigned int Rows, unsigned int Cols, typename Type = double> class vpFixedMatrix
+{
+public:
+  //! Build a matrix with all its elements set to zero.
+  vpFixedMatrix()
+  {
+    for (unsigned int k = 0; k < Rows * Cols; ++k) {
+      m_data[k] = Type(0);
+    }
+  }
+
+  /*!
+    Build a matrix from the elements of a heap-backed array.
+
+    \exception vpException::dimensionError If \e A is not a Rows x Cols array.
+  */
+  explicit vpFixedMatrix(const vpArray2D<Type> &A)
+  {
+    if ((A.getRows() != Rows) || (A.getCols() != Cols)) {
+      throw(vpException(vpException::dimensionError, "Cannot build a (%dx%d) fixed-size matrix from a (%dx%d) array",
+                        Rows, Cols, A.getRows(), A.getCols()));
+    }
+    for (unsigned int k = 0; k < Rows * Cols; ++k) {
+      m_data[k] = A.data[k];
+    }
+  }
+
+  /*!
+    Copy the elements of this matrix in the array \e A, starting at row \e r
+    and column \e c. \e A is not resized.
+
+    \exception vpException::dimensionError If the matrix doesn't fit in \e A.
+  */
+  void copyTo(vpArray2D<Type> &A, unsigned int r = 0, unsigned int c = 0) const
+  {
+    if (((r + Rows) > A.getRows()) || ((c + Cols) > A.getCols())) {
+      throw(vpException(vpException::dimensionError, "Cannot copy a (%dx%d) fixed-size matrix at (%d, %d) in a (%dx%d) array",
+                        Rows, Cols, r, c, A.getRows(), A.getCols()));
+    }
+    for (unsigned int i = 0; i < Rows; ++i) {
+      for (unsigned int j = 0; j < Cols; ++j) {
+        A[r + i][c + j] = (*this)[i][j];
+      }
+    }
+  }
+
+  //! Return a pointer to the first element.
+  inline Type *data() { return m_data; }
+  //! Return a pointer to the first element.
+  inline const Type *data() const { return m_data; }
+
+  //! Set the matrix to identity, or to a rectangular diagonal matrix of ones.
+  void eye()
+  {
+    for (unsigned int i = 0; i < Rows; ++i) {
+      for (unsigned int j = 0; j < Cols; ++j) {
+        (*this)[i][j] = (i == j) ? Type(1) : Type(0);
+      }
+    }
+  }
+
+  //! Return the number of columns.
+  inline unsigned int getCols() const { return Cols; }
+  //! Return the number of rows.
+  inline unsigned int getRows() const { return Rows; }
+  //! Return the number of elements.
+  inline unsigned int size() const { return Rows * Cols; }
+
+  //! Return the transpose of the matrix.
+  vpFixedMatrix<Cols, Rows, Type> t() const
+  {
+    vpFixedMatrix<Cols, Rows, Type> At;
+    for (unsigned int i = 0; i < Rows; ++i) {
+      for (unsigned int j = 0; j < Cols; ++j) {
+        At[j][i] = (*this)[i][j];
+      }
+    }
+    return At;
+  }
+
+  //! Return a pointer to the \e i-th row.
+  inline Type *operator[](unsigned int i) { return m_data + (i * Cols); }
+  //! Return a pointer to the \e i-th row.
+  inline const Type *operator[](unsigned int i) const { return m_data + (i * Cols); }
+
+  //! Return a reference to the element at row \e i and column \e j.
+  inline Type &operator()(unsigned int i, unsigned int j) { return m_data[(i * Cols) + j]; }
+  //! Return the element at row \e i and column \e j.
+  inline const Type &operator()(unsigned int i, unsigned int j) const { return m_data[(i * Cols) + j]; }
+
+  //! Return a reference to the \e k-th element in row-major order, typically to access vector elements.
+  inline Type &operator()(unsigned int k) { return m_data[k]; }
+  //! Return the \e k-th element in row-major order, typically to access vector elements.
+  inline const Type &operator()(unsigned int k) const { return m_data[k]; }
+
+  //! Element-wise addition.
+  vpFixedMatrix<Rows, Cols, Type> operator+(const vpFixedMatrix<Rows, Cols, Type> &B) const
+  {
+    vpFixedMatrix<Rows, Cols, Type> C(*this);
+    C += B;
+    return C;
+  }
+
+  //! Element-wise subtraction.
+  vpFixedMatrix<Rows, Cols, Type> operator-(const vpFixedMatrix<Rows, Cols, Type> &B) const
+  {
+    vpFixedMatrix<Rows, Cols, Type> C(*this);
+    C -= B;
+    return C;
+  }
+
+  //! Element-wise addition.
+  vpFixedMatrix<Rows, Cols, Type> &operator+=(const vpFixedMatrix<Rows, Cols, Type> &B)
+  {
+    for (unsigned int k = 0; k < Rows * Cols; ++k) {
+      m_data[k] += B.m_data[k];
+    }
+    return *this;
+  }
+
+  //! Element-wise subtraction.
+  vpFixedMatrix<Rows, Cols, Type> &operator-=(const vpFixedMatrix<Rows, Cols, Type> &B)
+  {
+    for (unsigned int k = 0; k < Rows * Cols; ++k) {
+      m_data[k] -= B.m_data[k];
+    }
+    return *this;
+  }
+
+  //! Multiply all the elements by \e x.
+  vpFixedMatrix<Rows, Cols, Type> operator*(Type x) const
+  {
+    vpFixedMatrix<Rows, Cols, Type> C(*this);
+    C *= x;
+    return C;
+  }
+
+  //! Multiply all the elements by \e x.
+  vpFixedMatrix<Rows, Cols, Type> &operator*=(Type x)
+  {
+    for (unsigned int k = 0; k < Rows * Cols; ++k) {
+      m_data[k] *= x;
+    }
+    return *this;
+  }
+
+  //! Matrix product. The dimensions consistency is checked at compile time.
+  template <unsigned int N>
+  vpFixedMatrix<Rows, N, Type> operator*(const vpFixedMatrix<Cols, N, Type> &B) const
+  {
+    vpFixedMatrix<Rows, N, Type> C;
+    for (unsigned int i = 0; i < Rows; ++i) {
+      for (unsigned int k = 0; k < Cols; ++k) {
+        const Type a = (*this)[i][k];
+        for (unsigned int j = 0; j < N; ++j) {
+          C[i][j] += a * B[k][j];
+        }
+      }
+    }
+    return C;
+  }
+
+private:
+  Type m_data[Rows * Cols]; //!< Elements in row-major order
+};
+
+/*!
+  \ingroup group_core_matrices
+  Fixed-size column vector stored on the stack.
+*/
+template <unsigned int Rows, typename Type = double> using vpFixedColVector = vpFixedMatrix<Rows, 1, Type>;
+END_VISP_NAMESPACE
+#endif
@@ -44,6 +44,9 @@
 // image
 #include <visp3/core/vpConfig.h>
 #include <visp3/core/vpImage.h>
+#include <visp3/core/vpImageView.h>
+#include <visp3/core/vpPointCloud.h>
+#include <visp3/core/vpRect.h>
 // color
 #include <visp3/core/vpRGBa.h>
 
@@ -77,6 +80,8 @@
 #endif
 
 BEGIN_VISP_NAMESPACE
+class vpCameraParameters;
+
 /*!
   \class vpImageConvert
 
@@ -102,6 +107,8 @@ public:
 
   static void convert(const vpImage<unsigned char> &src, vpImage<vpRGBa> &dest);
   static void convert(const vpImage<vpRGBa> &src, vpImage<unsigned char> &dest, unsigned int nThreads = 0);
+  static void convert(const vpImageView<unsigned char> &src, vpImage<vpRGBa> &dest);
+  static void convert(const vpImageView<vpRGBa> &src, vpImage<unsigned char> &dest);
 
   static void convert(const vpImage<float> &src, vpImage<unsigned char> &dest);
   static void convert(const vpImage<vpRGBf> &src, vpImage<vpRGBa> &dest);
@@ -147,6 +154,16 @@ public:
   static void convert(const yarp::sig::ImageOf<yarp::sig::PixelRgb> *src, vpImage<vpRGBa> &dest);
 #endif
 
+  static unsigned int depthToPointCloud(const vpImage<uint16_t> &depth_raw, float depth_scale,
+                                        const vpCameraParameters &cam_depth, vpPointCloud &pointcloud,
+                                        const vpImage<unsigned char> *depth_mask = nullptr, float Z_min = 0.2f,
+                                        float Z_max = 2.5f, unsigned int decimation = 1, const vpRect &roi = vpRect(),
+                                        unsigned int nThreads = 0);
+  static unsigned int depthToPointCloud(const vpImage<float> &depth, const vpCameraParameters &cam_depth,
+                                        vpPointCloud &pointcloud, const vpImage<unsigned char> *depth_mask = nullptr,
+                                        float Z_min = 0.2f, float Z_max = 2.5f, unsigned int decimation = 1,
+                                        const vpRect &roi = vpRect(), unsigned int nThreads = 0);
+
 #if defined(VISP_HAVE_PCL) && defined(VISP_HAVE_PCL_COMMON) && defined(VISP_HAVE_THREADS)
   static int depthToPointCloud(const vpImage<uint16_t> &depth_raw,
                                float depth_scale, const vpCameraParameters &cam_depth,
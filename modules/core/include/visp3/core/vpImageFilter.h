@@ -43,6 +43,7 @@
 #include <iostream>
 #include <math.h>
 #include <string.h>
+#include <vector>
 
 #include <visp3/core/vpConfig.h>
 #include <visp3/core/vpException.h>
@@ -50,6 +51,8 @@
 #include <visp3/core/vpImage.h>
 #include <visp3/core/vpImageConvert.h>
 #include <visp3/core/vpImageException.h>
+#include <visp3/core/vpImageView.h>
+#include <visp3/core/vpIntegralImage.h>
 #include <visp3/core/vpMath.h>
 #include <visp3/core/vpMatrix.h>
 #include <visp3/core/vpRGBa.h>
@@ -62,6 +65,19 @@
 #endif
 
 BEGIN_VISP_NAMESPACE
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+/*
+ * Pairs of image and filter types for which vpImageFilter::sepFilter() is instantiated. The templated filters of
+ * vpImageFilter rely on it for these pairs and keep their generic implementation for the other ones.
+ */
+template <typename ImageType, typename FilterType> struct vpSepFilterSupport { enum { value = 0 }; };
+template <> struct vpSepFilterSupport<unsigned char, float> { enum { value = 1 }; };
+template <> struct vpSepFilterSupport<unsigned char, double> { enum { value = 1 }; };
+template <> struct vpSepFilterSupport<float, float> { enum { value = 1 }; };
+template <> struct vpSepFilterSupport<double, double> { enum { value = 1 }; };
+template <int Supported> struct vpSepFilterTag { };
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
 /*!
  * \class vpImageFilter
  *
@@ -102,6 +118,27 @@ public:
 
   static vpCannyFilteringAndGradientType vpCannyFiltAndGradTypeFromStr(const std::string &name);
 
+  //! Border extrapolation methods of the separable filters
+  typedef enum vpBorderType
+  {
+    BORDER_DEFAULT = 0, //!< Mirror without repeating the border pixel at the top and left borders (`dcb|abcd`), repeating it at the bottom and right borders (`wxyz|zyx`), as filterX() and filterY() do.
+    BORDER_REFLECT_101 = 1, //!< Mirror without repeating the border pixel: `dcb|abcd|cba`.
+    BORDER_REFLECT = 2, //!< Mirror repeating the border pixel: `cba|abcd|dcb`.
+    BORDER_REPLICATE = 3, //!< Replicate the border pixel: `aaa|abcd|ddd`.
+    BORDER_CONSTANT = 4 //!< Pad with zeros: `000|abcd|000`.
+  } vpBorderType;
+
+  static void boxFilter(const vpImage<unsigned char> &I, vpImage<unsigned char> &I_filtered, unsigned int halfSize,
+                        unsigned int nThreads = 0);
+  static void boxFilter(const vpImage<unsigned char> &I, vpImage<float> &I_filtered, unsigned int halfSize,
+                        unsigned int nThreads = 0);
+  static void boxFilter(const vpIntegralImage &II, vpImage<float> &I_filtered, unsigned int halfSize,
+                        unsigned int nThreads = 0);
+  static void localMeanAndStdev(const vpImage<unsigned char> &I, vpImage<float> &I_mean, vpImage<float> &I_stdev,
+                                unsigned int halfSize, unsigned int nThreads = 0);
+  static void localMeanAndStdev(const vpIntegralImage &II, vpImage<float> &I_mean, vpImage<float> &I_stdev,
+                                unsigned int halfSize, unsigned int nThreads = 0);
+
   static void canny(const vpImage<unsigned char> &I, vpImage<unsigned char> &Ic, const unsigned int &gaussianFilterSize,
                     const float &thresholdCanny, const unsigned int &apertureSobel);
 
@@ -535,56 +572,27 @@ public:
   static void filter(const vpImage<ImageType> &I, vpImage<FilterType> &If, const vpArray2D<FilterType> &M, bool convolve = false,
                      const vpImage<bool> *p_mask = nullptr)
   {
-    const unsigned int size_y = M.getRows(), size_x = M.getCols();
-    const unsigned int half_size_y = size_y / 2, half_size_x = size_x / 2;
-
-    const unsigned int inputHeight = I.getHeight(), inputWidth = I.getWidth();
-    If.resize(inputHeight, inputWidth, 0.0);
-
-    if (convolve) {
-      const unsigned int stopHeight = inputHeight - half_size_y;
-      const unsigned int stopWidth = inputWidth - half_size_x;
-      for (unsigned int i = half_size_y; i < stopHeight; ++i) {
-        for (unsigned int j = half_size_x; j < stopWidth; ++j) {
-          // We have to compute the value for each pixel if we don't have a mask or for
-          // pixels for which the mask is true otherwise
-          bool computeVal = checkBooleanMask(p_mask, i, j);
-          if (computeVal) {
-            FilterType conv = 0;
+    filterImpl(I, If, M, convolve, p_mask);
+  }
 
-            for (unsigned int a = 0; a < size_y; ++a) {
-              for (unsigned int b = 0; b < size_x; ++b) {
-                FilterType val = static_cast<FilterType>(I[(i + half_size_y) - a][(j + half_size_x) - b]); // Convolution
-                conv += M[a][b] * val;
-              }
-            }
-            If[i][j] = conv;
-          }
-        }
-      }
-    }
-    else {
-      const unsigned int stopHeight = inputHeight - half_size_y;
-      const unsigned int stopWidth = inputWidth - half_size_x;
-      for (unsigned int i = half_size_y; i < stopHeight; ++i) {
-        for (unsigned int j = half_size_x; j < stopWidth; ++j) {
-          // We have to compute the value for each pixel if we don't have a mask or for
-          // pixels for which the mask is true otherwise
-          bool computeVal = checkBooleanMask(p_mask, i, j);
-          if (computeVal) {
-            FilterType corr = 0;
+  /*!
+    Apply a filter to a strided image view, for example a region of interest of
+    a larger image, without copying it first.
+    \tparam FilterType : Either float, to accelerate the computation time, or double, to have greater precision.
+    \param I : Image view to filter.
+    \param If : Filtered image, with the same size as the view.
+    \param M : Filter kernel.
+    \param convolve : If true, perform a convolution otherwise a correlation.
+    \param p_mask : If different from nullptr, mask expressed in the view coordinates indicating which points to
+    consider (true) or to ignore(false).
 
-            for (unsigned int a = 0; a < size_y; ++a) {
-              for (unsigned int b = 0; b < size_x; ++b) {
-                FilterType val = static_cast<FilterType>(I[(i - half_size_y) + a][(j - half_size_x) + b]); // Correlation
-                corr += M[a][b] * val;
-              }
-            }
-            If[i][j] = corr;
-          }
-        }
-      }
-    }
+    \sa filter(const vpImage<ImageType> &, vpImage<FilterType> &, const vpArray2D<FilterType> &, bool, const vpImage<bool> *)
+  */
+  template <typename ImageType, typename FilterType>
+  static void filter(const vpImageView<ImageType> &I, vpImage<FilterType> &If, const vpArray2D<FilterType> &M,
+                     bool convolve = false, const vpImage<bool> *p_mask = nullptr)
+  {
+    filterImpl(I, If, M, convolve, p_mask);
   }
 
   /**
@@ -711,6 +719,11 @@ public:
 
   static void sepFilter(const vpImage<unsigned char> &I, vpImage<double> &If, const vpColVector &kernelH, const vpColVector &kernelV);
 
+  template <typename ImageType, typename FilterType>
+  static void sepFilter(const vpImage<ImageType> &I, vpImage<FilterType> &If, const FilterType *kernelX,
+                        unsigned int sizeX, const FilterType *kernelY, unsigned int sizeY, bool convolve = false,
+                        const vpBorderType &border = BORDER_DEFAULT, unsigned int nThreads = 0);
+
   /*!
    * Apply a separable filter.
    * \tparam FilterType : Either float, to accelerate the computation time, or double, to have greater precision.
@@ -723,6 +736,10 @@ public:
   template <typename ImageType, typename FilterType>
   static void filter(const vpImage<ImageType> &I, vpImage<FilterType> &GI, const FilterType *filter, unsigned int size, const vpImage<bool> *p_mask = nullptr)
   {
+    if ((p_mask == nullptr) && sepFilterHalfKernels(I, GI, filter, filter, size, false,
+                                                    vpSepFilterTag<vpSepFilterSupport<ImageType, FilterType>::value>())) {
+      return;
+    }
     vpImage<FilterType> GIx;
     filterX<ImageType, FilterType>(I, GIx, filter, size, p_mask);
     filterY<FilterType, FilterType>(GIx, GI, filter, size, p_mask);
@@ -744,6 +761,10 @@ public:
   static void filterX(const vpImage<ImageType> &I, vpImage<FilterType> &dIx, const FilterType *filter, unsigned int size,
                       const vpImage<bool> *p_mask = nullptr)
   {
+    if ((p_mask == nullptr) && sepFilterHalfKernels(I, dIx, filter, static_cast<const FilterType *>(nullptr), size, false,
+                                                    vpSepFilterTag<vpSepFilterSupport<ImageType, FilterType>::value>())) {
+      return;
+    }
     const unsigned int height = I.getHeight();
     const unsigned int width = I.getWidth();
     const unsigned int stop1J = (size - 1) / 2;
@@ -853,6 +874,10 @@ public:
   static void filterY(const vpImage<ImageType> &I, vpImage<FilterType> &dIy, const FilterType *filter, unsigned int size,
                       const vpImage<bool> *p_mask = nullptr)
   {
+    if ((p_mask == nullptr) && sepFilterHalfKernels(I, dIy, static_cast<const FilterType *>(nullptr), filter, size, false,
+                                                    vpSepFilterTag<vpSepFilterSupport<ImageType, FilterType>::value>())) {
+      return;
+    }
     const unsigned int height = I.getHeight(), width = I.getWidth();
     const unsigned int stop1I = (size - 1) / 2;
     const unsigned int stop2I = height - ((size - 1) / 2);
@@ -975,10 +1000,13 @@ public:
   {
     FilterType *fg = new FilterType[(size + 1) / 2];
     vpImageFilter::getGaussianKernel<FilterType>(fg, size, sigma, normalize);
-    vpImage<FilterType> GIx;
-    vpImageFilter::filterX<ImageType, FilterType>(I, GIx, fg, size, p_mask);
-    vpImageFilter::filterY<FilterType, FilterType>(GIx, GI, fg, size, p_mask);
-    GIx.destroy();
+    if ((p_mask != nullptr) || (!sepFilterHalfKernels(I, GI, fg, fg, size, false,
+                                                      vpSepFilterTag<vpSepFilterSupport<ImageType, FilterType>::value>()))) {
+      vpImage<FilterType> GIx;
+      vpImageFilter::filterX<ImageType, FilterType>(I, GIx, fg, size, p_mask);
+      vpImageFilter::filterY<FilterType, FilterType>(GIx, GI, fg, size, p_mask);
+      GIx.destroy();
+    }
     delete[] fg;
   }
 
@@ -1150,6 +1178,19 @@ public:
     const unsigned int height = I.getHeight(), width = I.getWidth();
     const unsigned int stop1J = (size - 1) / 2;
     const unsigned int stop2J = width - ((size - 1) / 2);
+    if ((p_mask == nullptr) && sepFilterHalfKernels(I, dIx, filter, static_cast<const FilterType *>(nullptr), size, true,
+                                                    vpSepFilterTag<vpSepFilterSupport<ImageType, FilterType>::value>())) {
+      // The derivative is not computed near the left and right borders
+      for (unsigned int i = 0; i < height; ++i) {
+        for (unsigned int j = 0; (j < stop1J) && (j < width); ++j) {
+          dIx[i][j] = static_cast<FilterType>(0);
+        }
+        for (unsigned int j = std::max<unsigned int>(stop1J, stop2J); j < width; ++j) {
+          dIx[i][j] = static_cast<FilterType>(0);
+        }
+      }
+      return;
+    }
     resizeAndInitializeIfNeeded(p_mask, height, width, dIx);
 
     for (unsigned int i = 0; i < height; ++i) {
@@ -1241,6 +1282,20 @@ public:
   template <typename ImageType, typename FilterType>
   static void getGradY(const vpImage<ImageType> &I, vpImage<FilterType> &dIy, const FilterType *filter, unsigned int size, const vpImage<bool> *p_mask = nullptr)
   {
+    if ((p_mask == nullptr) && sepFilterHalfKernels(I, dIy, static_cast<const FilterType *>(nullptr), filter, size, true,
+                                                    vpSepFilterTag<vpSepFilterSupport<ImageType, FilterType>::value>())) {
+      // The derivative is not computed near the top and bottom borders
+      const unsigned int height = I.getHeight(), width = I.getWidth();
+      const unsigned int stop1I = (size - 1) / 2;
+      for (unsigned int i = 0; i < height; ++i) {
+        if ((i < stop1I) || ((i + stop1I) >= height)) {
+          for (unsigned int j = 0; j < width; ++j) {
+            dIy[i][j] = static_cast<FilterType>(0);
+          }
+        }
+      }
+      return;
+    }
     const unsigned int height = I.getHeight(), width = I.getWidth();
     const unsigned int stop1I = (size - 1) / 2;
     const unsigned int stop2I = height - ((size - 1) / 2);
@@ -1454,6 +1509,100 @@ public:
 #endif
 
 private:
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+  /*
+   * Apply sepFilter() with kernels given by their half, the first coefficient being the central one. The full
+   * kernels are symmetric, or antisymmetric with a null central coefficient for derivative kernels. A null half
+   * kernel means that the image is not filtered along the corresponding axis.
+   * Return false when sepFilter() is not instantiated for the image and filter types.
+   */
+  template <typename ImageType, typename FilterType>
+  static bool sepFilterHalfKernels(const vpImage<ImageType> &I, vpImage<FilterType> &If, const FilterType *halfKernelX,
+                                   const FilterType *halfKernelY, unsigned int size, bool derivative, vpSepFilterTag<1>)
+  {
+    const unsigned int half = (size - 1) / 2;
+    std::vector<FilterType> kernel((2 * half) + 1);
+    const FilterType *halfKernel = (halfKernelX != nullptr) ? halfKernelX : halfKernelY;
+    kernel[half] = derivative ? static_cast<FilterType>(0) : halfKernel[0];
+    for (unsigned int i = 1; i <= half; ++i) {
+      kernel[half + i] = halfKernel[i];
+      kernel[half - i] = derivative ? -halfKernel[i] : halfKernel[i];
+    }
+    const FilterType identity = static_cast<FilterType>(1);
+    const unsigned int kernelSize = static_cast<unsigned int>(kernel.size());
+    sepFilter(I, If, (halfKernelX != nullptr) ? &kernel[0] : &identity, (halfKernelX != nullptr) ? kernelSize : 1,
+              (halfKernelY != nullptr) ? &kernel[0] : &identity, (halfKernelY != nullptr) ? kernelSize : 1);
+    return true;
+  }
+
+  template <typename ImageType, typename FilterType>
+  static bool sepFilterHalfKernels(const vpImage<ImageType> &, vpImage<FilterType> &, const FilterType *,
+                                   const FilterType *, unsigned int, bool, vpSepFilterTag<0>)
+  {
+    return false;
+  }
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+  /**
+   * \brief Apply a filter to any 2D container providing getHeight(), getWidth() and row access via operator[],
+   * i.e. vpImage or vpImageView.
+   */
+  template <typename ImageContainer, typename FilterType>
+  static void filterImpl(const ImageContainer &I, vpImage<FilterType> &If, const vpArray2D<FilterType> &M, bool convolve,
+                         const vpImage<bool> *p_mask)
+  {
+    const unsigned int size_y = M.getRows(), size_x = M.getCols();
+    const unsigned int half_size_y = size_y / 2, half_size_x = size_x / 2;
+
+    const unsigned int inputHeight = I.getHeight(), inputWidth = I.getWidth();
+    If.resize(inputHeight, inputWidth, 0.0);
+
+    if (convolve) {
+      const unsigned int stopHeight = inputHeight - half_size_y;
+      const unsigned int stopWidth = inputWidth - half_size_x;
+      for (unsigned int i = half_size_y; i < stopHeight; ++i) {
+        for (unsigned int j = half_size_x; j < stopWidth; ++j) {
+          // We have to compute the value for each pixel if we don't have a mask or for
+          // pixels for which the mask is true otherwise
+          bool computeVal = checkBooleanMask(p_mask, i, j);
+          if (computeVal) {
+            FilterType conv = 0;
+
+            for (unsigned int a = 0; a < size_y; ++a) {
+              for (unsigned int b = 0; b < size_x; ++b) {
+                FilterType val = static_cast<FilterType>(I[(i + half_size_y) - a][(j + half_size_x) - b]); // Convolution
+                conv += M[a][b] * val;
+              }
+            }
+            If[i][j] = conv;
+          }
+        }
+      }
+    }
+    else {
+      const unsigned int stopHeight = inputHeight - half_size_y;
+      const unsigned int stopWidth = inputWidth - half_size_x;
+      for (unsigned int i = half_size_y; i < stopHeight; ++i) {
+        for (unsigned int j = half_size_x; j < stopWidth; ++j) {
+          // We have to compute the value for each pixel if we don't have a mask or for
+          // pixels for which the mask is true otherwise
+          bool computeVal = checkBooleanMask(p_mask, i, j);
+          if (computeVal) {
+            FilterType corr = 0;
+
+            for (unsigned int a = 0; a < size_y; ++a) {
+              for (unsigned int b = 0; b < size_x; ++b) {
+                FilterType val = static_cast<FilterType>(I[(i - half_size_y) + a][(j - half_size_x) + b]); // Correlation
+                corr += M[a][b] * val;
+              }
+            }
+            If[i][j] = corr;
+          }
+        }
+      }
+    }
+  }
+
   /**
    * \brief Resize the image \b I to the desired size and, if \b p_mask is different from nullptr, initialize
    * \b I with 0s.
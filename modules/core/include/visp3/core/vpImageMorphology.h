@@ -45,10 +45,16 @@
 #include <visp3/core/vpImageException.h>
 #include <visp3/core/vpMatrix.h>
 
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 #include <math.h>
 #include <string.h>
+#include <vector>
+
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
 
 BEGIN_VISP_NAMESPACE
 /*!
@@ -96,6 +102,13 @@ public:
   template <typename T>
   static void dilatation(vpImage<T> &I, const int &size);
 
+  template <typename T>
+  static void rectangularErosion(vpImage<T> &I, unsigned int width, unsigned int height, unsigned int nThreads = 0);
+
+  template <typename T>
+  static void rectangularDilatation(vpImage<T> &I, unsigned int width, unsigned int height,
+                                    unsigned int nThreads = 0);
+
 #if defined(VISP_BUILD_DEPRECATED_FUNCTIONS)
   /*!
     @name Deprecated functions
@@ -189,17 +202,32 @@ private:
   static void imageOperation(vpImage<T> &I, const T &null_value, vpPixelOperation<T> *operation, const vpConnexityType &connexity = CONNEXITY_4);
 
   /**
-   * \brief Modify the image by applying the \b operation on each of its elements on a \b size x \b size
-   * grid.
+   * \brief Erosion (minimum) or dilatation (maximum) on a 3x3 grid, the borders being ignored.
+   */
+  template <typename T>
+  static void minMax3x3(vpImage<T> &I, bool isMin, const vpConnexityType &connexity);
+
+  /**
+   * \brief SSE2 or NEON version of the 3x3 erosion or dilatation for unsigned char images.
+   */
+  static void minMax3x3(vpImage<unsigned char> &I, bool isMin, const vpConnexityType &connexity);
+
+  /**
+   * \brief Modify the image by applying the \b operation on each of its elements on a \b width x \b height
+   * rectangle centered on the element and clipped to the image, as a horizontal then a vertical pass of the van
+   * Herk/Gil-Werman algorithm. The cost per pixel does not depend on the size of the rectangle.
    *
    * \tparam T Any type such as double, unsigned char ...
+   * \tparam Operation vpPixelOperationMin or vpPixelOperationMax.
    * \param[out] I The image we want to modify.
-   * \param[in] operation The operation to apply to its elements on a the grid.
-   * \param[in] size Size of the kernel of the operation.
+   * \param[in] operation The operation to apply to its elements on the rectangle.
+   * \param[in] width Width of the rectangle, odd.
+   * \param[in] height Height of the rectangle, odd.
+   * \param[in] nThreads Number of threads used with OpenMP, 0 to use the OpenMP default.
    */
-  template <typename T>
-  static void imageOperation(vpImage<T> &I, vpPixelOperation<T> *operation, const int &size = 3);
-
+  template <typename T, typename Operation>
+  static void separableOperation(vpImage<T> &I, const Operation &operation, unsigned int width, unsigned int height,
+                                 unsigned int nThreads);
 };
 
 /*!
@@ -431,8 +459,7 @@ void vpImageMorphology::imageOperation(vpImage<T> &I, const T &null_value, vpPix
 template <typename T>
 void vpImageMorphology::erosion(vpImage<T> &I, const vpConnexityType &connexity)
 {
-  vpPixelOperationMin<T> operation;
-  vpImageMorphology::imageOperation(I, std::numeric_limits<T>::max(), &operation, connexity);
+  vpImageMorphology::minMax3x3(I, true, connexity);
 }
 
 /*!
@@ -461,47 +488,131 @@ void vpImageMorphology::erosion(vpImage<T> &I, const vpConnexityType &connexity)
 template <typename T>
 void vpImageMorphology::dilatation(vpImage<T> &I, const vpConnexityType &connexity)
 {
-  vpPixelOperationMax<T> operation;
-  vpImageMorphology::imageOperation(I, std::numeric_limits<T>::min(), &operation, connexity);
+  vpImageMorphology::minMax3x3(I, false, connexity);
 }
 
-template<typename T>
-void vpImageMorphology::imageOperation(vpImage<T> &I, vpPixelOperation<T> *operation, const int &size)
+template <typename T>
+void vpImageMorphology::minMax3x3(vpImage<T> &I, bool isMin, const vpConnexityType &connexity)
 {
-  if ((size % 2) != 1) {
+  if (isMin) {
+    vpPixelOperationMin<T> operation;
+    vpImageMorphology::imageOperation(I, std::numeric_limits<T>::max(), &operation, connexity);
+  }
+  else {
+    vpPixelOperationMax<T> operation;
+    vpImageMorphology::imageOperation(I, std::numeric_limits<T>::min(), &operation, connexity);
+  }
+}
+
+template <typename T, typename Operation>
+void vpImageMorphology::separableOperation(vpImage<T> &I, const Operation &operation, unsigned int width,
+                                           unsigned int height, unsigned int nThreads)
+{
+  if (((width % 2) != 1) || ((height % 2) != 1)) {
     throw(vpException(vpException::badValue, "Dilatation/erosion kernel must be odd."));
   }
+  if (I.getSize() == 0) {
+    return;
+  }
 
-  const int width_in = I.getWidth();
-  const int height_in = I.getHeight();
-  int halfKernelSize = size / 2;
-  vpImage<T> J = I;
-
-  for (int r = 0; r < height_in; ++r) {
-    // Computing the rows we can explore without going outside the limits of the image
-    int r_iterator_start = -halfKernelSize, r_iterator_stop = halfKernelSize + 1;
-    if ((r - halfKernelSize) < 0) {
-      r_iterator_start = -r;
-    }
-    else if ((r + halfKernelSize) >= height_in) {
-      r_iterator_stop = height_in - r;
-    }
-    for (int c = 0; c < width_in; ++c) {
-      T value = I[r][c];
-      // Computing the columns we can explore without going outside the limits of the image
-      int c_iterator_start = -halfKernelSize, c_iterator_stop = halfKernelSize + 1;
-      if ((c - halfKernelSize) < 0) {
-        c_iterator_start = -c;
-      }
-      else if ((c + halfKernelSize) >= width_in) {
-        c_iterator_stop = width_in - c;
+  const unsigned int img_height = I.getHeight(), img_width = I.getWidth();
+  const unsigned int half_width = width / 2, half_height = height / 2;
+  // The borders are replicated, which does not change the minimum or maximum over the clipped windows, and the
+  // padded lines are split in blocks of the size of the window
+  const unsigned int padded_width = (((img_width + (2 * half_width)) + width) - 1) / width * width;
+  const unsigned int padded_height = (((img_height + (2 * half_height)) + height) - 1) / height * height;
+  // Number of columns processed at once by the vertical pass
+  const unsigned int strip_width = 64;
+  const int nb_rows = static_cast<int>(img_height);
+  const int nb_strips = static_cast<int>((img_width + strip_width) - 1) / static_cast<int>(strip_width);
+
+#if defined(_OPENMP)
+  if (nThreads > 0) {
+    omp_set_num_threads(static_cast<int>(nThreads));
+  }
+#pragma omp parallel
+#else
+  (void)nThreads;
+#endif
+  {
+    // The qualified calls op.Operation::operator()() are not dispatched through the virtual table
+    Operation op = operation;
+
+    if (width > 1) {
+      // Padded row split in blocks, g being the running operation from the beginning of the block and h from the end
+      std::vector<T> p(padded_width), g(padded_width), h(padded_width);
+#if defined(_OPENMP)
+#pragma omp for
+#endif
+      for (int r = 0; r < nb_rows; ++r) {
+        T *row = I[static_cast<unsigned int>(r)];
+        std::fill(p.begin(), p.begin() + half_width, row[0]);
+        std::copy(row, row + img_width, p.begin() + half_width);
+        std::fill(p.begin() + half_width + img_width, p.end(), row[img_width - 1]);
+        for (unsigned int b = 0; b < padded_width; b += width) {
+          g[b] = p[b];
+          for (unsigned int c = b + 1; c < (b + width); ++c) {
+            g[c] = op.Operation::operator()(g[c - 1], p[c]);
+          }
+          h[(b + width) - 1] = p[(b + width) - 1];
+          for (unsigned int c = (b + width) - 1; c > b; --c) {
+            h[c - 1] = op.Operation::operator()(h[c], p[c - 1]);
+          }
+        }
+        for (unsigned int c = 0; c < img_width; ++c) {
+          row[c] = op.Operation::operator()(h[c], g[(c + width) - 1]);
+        }
       }
-      for (int r_iterator = r_iterator_start; r_iterator < r_iterator_stop; ++r_iterator) {
-        for (int c_iterator = c_iterator_start; c_iterator < c_iterator_stop; ++c_iterator) {
-          value = (*operation)(value, J[r + r_iterator][c + c_iterator]);
+    }
+
+    if (height > 1) {
+      // Same as the horizontal pass, on strips of strip_width columns to process whole rows of the strip at once
+      std::vector<T> g(static_cast<size_t>(padded_height) * strip_width);
+      std::vector<T> h(static_cast<size_t>(padded_height) * strip_width);
+#if defined(_OPENMP)
+#pragma omp for
+#endif
+      for (int strip = 0; strip < nb_strips; ++strip) {
+        const unsigned int c0 = static_cast<unsigned int>(strip) * strip_width;
+        const unsigned int n = std::min<unsigned int>(strip_width, img_width - c0);
+        for (unsigned int r = 0; r < padded_height; ++r) {
+          const unsigned int r_img = std::min<unsigned int>(r > half_height ? r - half_height : 0, img_height - 1);
+          const T *src = I[r_img] + c0;
+          T *g_row = &g[static_cast<size_t>(r) * strip_width];
+          if ((r % height) == 0) {
+            std::copy(src, src + n, g_row);
+          }
+          else {
+            const T *g_prev = g_row - strip_width;
+            for (unsigned int c = 0; c < n; ++c) {
+              g_row[c] = op.Operation::operator()(g_prev[c], src[c]);
+            }
+          }
+        }
+        for (unsigned int r = padded_height; r > 0; --r) {
+          const unsigned int r_img = std::min<unsigned int>(r - 1 > half_height ? (r - 1) - half_height : 0,
+                                                            img_height - 1);
+          const T *src = I[r_img] + c0;
+          T *h_row = &h[static_cast<size_t>(r - 1) * strip_width];
+          if ((r % height) == 0) {
+            std::copy(src, src + n, h_row);
+          }
+          else {
+            const T *h_next = h_row + strip_width;
+            for (unsigned int c = 0; c < n; ++c) {
+              h_row[c] = op.Operation::operator()(h_next[c], src[c]);
+            }
+          }
+        }
+        for (unsigned int r = 0; r < img_height; ++r) {
+          const T *h_row = &h[static_cast<size_t>(r) * strip_width];
+          const T *g_row = &g[static_cast<size_t>((r + height) - 1) * strip_width];
+          T *dst = I[r] + c0;
+          for (unsigned int c = 0; c < n; ++c) {
+            dst[c] = op.Operation::operator()(h_row[c], g_row[c]);
+          }
         }
       }
-      I[r][c] = value;
     }
   }
 }
@@ -535,8 +646,11 @@ void vpImageMorphology::imageOperation(vpImage<T> &I, vpPixelOperation<T> *opera
 template <typename T>
 void vpImageMorphology::erosion(vpImage<T> &I, const int &size)
 {
-  vpPixelOperationMin<T> operation;
-  vpImageMorphology::imageOperation(I, &operation, size);
+  if ((size % 2) != 1) {
+    throw(vpException(vpException::badValue, "Dilatation/erosion kernel must be odd."));
+  }
+  vpImageMorphology::separableOperation(I, vpPixelOperationMin<T>(), static_cast<unsigned int>(size),
+                                        static_cast<unsigned int>(size), 0);
 }
 
 /**
@@ -567,8 +681,55 @@ void vpImageMorphology::erosion(vpImage<T> &I, const int &size)
 template<typename T>
 void vpImageMorphology::dilatation(vpImage<T> &I, const int &size)
 {
-  vpPixelOperationMax<T> operation;
-  vpImageMorphology::imageOperation(I, &operation, size);
+  if ((size % 2) != 1) {
+    throw(vpException(vpException::badValue, "Dilatation/erosion kernel must be odd."));
+  }
+  vpImageMorphology::separableOperation(I, vpPixelOperationMax<T>(), static_cast<unsigned int>(size),
+                                        static_cast<unsigned int>(size), 0);
+}
+
+/*!
+  Erode an image with a flat rectangular structuring element of size \e width x \e height centered on each pixel,
+  that is a local-minimum operator over the rectangle clipped to the image.
+
+  The rectangle being separable, the erosion is computed as a horizontal then a vertical pass of the van Herk/Gil-Werman
+  algorithm, whose cost is about three comparisons per pixel and per pass whatever the size of the rectangle. The image
+  is processed in place, by rows for the horizontal pass and by strips of columns for the vertical pass.
+
+  \tparam T Any type of image, except vpRGBa.
+  \param[inout] I : Image to process.
+  \param[in] width : Width of the structuring element, odd.
+  \param[in] height : Height of the structuring element, odd.
+  \param[in] nThreads : Number of threads used with OpenMP, 0 to use the OpenMP default.
+
+  \sa rectangularDilatation(), erosion(vpImage<T> &, const int &)
+*/
+template <typename T>
+void vpImageMorphology::rectangularErosion(vpImage<T> &I, unsigned int width, unsigned int height,
+                                           unsigned int nThreads)
+{
+  vpImageMorphology::separableOperation(I, vpPixelOperationMin<T>(), width, height, nThreads);
+}
+
+/*!
+  Dilate an image with a flat rectangular structuring element of size \e width x \e height centered on each pixel,
+  that is a local-maximum operator over the rectangle clipped to the image.
+
+  See rectangularErosion() for the details of the computation.
+
+  \tparam T Any type of image, except vpRGBa.
+  \param[inout] I : Image to process.
+  \param[in] width : Width of the structuring element, odd.
+  \param[in] height : Height of the structuring element, odd.
+  \param[in] nThreads : Number of threads used with OpenMP, 0 to use the OpenMP default.
+
+  \sa rectangularErosion(), dilatation(vpImage<T> &, const int &)
+*/
+template <typename T>
+void vpImageMorphology::rectangularDilatation(vpImage<T> &I, unsigned int width, unsigned int height,
+                                              unsigned int nThreads)
+{
+  vpImageMorphology::separableOperation(I, vpPixelOperationMax<T>(), width, height, nThreads);
 }
 END_VISP_NAMESPACE
 #endif
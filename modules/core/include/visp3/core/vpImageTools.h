@@ -49,6 +49,8 @@
 
 #include <visp3/core/vpCameraParameters.h>
 #include <visp3/core/vpImageException.h>
+#include <visp3/core/vpImageView.h>
+#include <visp3/core/vpIntegralImage.h>
 #include <visp3/core/vpMath.h>
 #include <visp3/core/vpRect.h>
 #include <visp3/core/vpRectOriented.h>
@@ -83,6 +85,13 @@ public:
     INTERPOLATION_AREA     /*!< Area interpolation (optimized by SIMD lib if enabled). */
   };
 
+  enum vpTemplateMatchingMethod
+  {
+    TEMPLATE_MATCHING_AUTO,    /*!< Fastest computation given the image and template sizes and the steps. */
+    TEMPLATE_MATCHING_SPATIAL, /*!< Spatial correlation (OpenMP, integral images, SIMD dot products). */
+    TEMPLATE_MATCHING_FFT      /*!< Frequency-domain correlation with the bundled FFT (OpenMP). */
+  };
+
   template <class Type>
   static inline void binarise(vpImage<Type> &I, Type threshold1, Type threshold2, Type value1, Type value2, Type value3,
                               bool useLUT = true);
@@ -104,6 +113,9 @@ public:
   template <class Type>
   static void crop(const unsigned char *bitmap, unsigned int width, unsigned int height, const vpRect &roi,
                    vpImage<Type> &crop, unsigned int v_scale = 1, unsigned int h_scale = 1);
+  template <class Type>
+  static void crop(const vpImageView<Type> &view, vpImage<Type> &crop, unsigned int v_scale = 1,
+                   unsigned int h_scale = 1);
 
   static void extract(const vpImage<unsigned char> &src, vpImage<unsigned char> &dst, const vpRectOriented &r);
   static void extract(const vpImage<unsigned char> &src, vpImage<double> &dst, const vpRectOriented &r);
@@ -163,6 +175,12 @@ public:
   static void templateMatching(const vpImage<unsigned char> &I, const vpImage<unsigned char> &I_tpl,
                                vpImage<double> &I_score, unsigned int step_u, unsigned int step_v,
                                bool useOptimized = true);
+  static void templateMatching(const vpImage<unsigned char> &I, const vpImage<unsigned char> &I_tpl,
+                               vpImage<double> &I_score, unsigned int step_u, unsigned int step_v,
+                               const vpTemplateMatchingMethod &method, unsigned int nThreads = 0);
+  static double templateMatchingCoarseToFine(const vpImage<unsigned char> &I, const vpImage<unsigned char> &I_tpl,
+                                             vpImagePoint &ip, unsigned int nbScales = 3,
+                                             unsigned int searchRadius = 2, unsigned int nThreads = 0);
 
   template <class Type>
   static void undistort(const vpImage<Type> &I, const vpCameraParameters &cam, vpImage<Type> &newI,
@@ -204,9 +222,8 @@ private:
   static float lerp(float A, float B, float t);
   static int64_t lerp2(int64_t A, int64_t B, int64_t t, int64_t t_1);
 
-  static double normalizedCorrelation(const vpImage<double> &I1, const vpImage<double> &I2, const vpImage<double> &II,
-                                      const vpImage<double> &IIsq, const vpImage<double> &II_tpl,
-                                      const vpImage<double> &IIsq_tpl, unsigned int i0, unsigned int j0);
+  static double normalizedCorrelation(const vpImage<double> &I1, const vpImage<double> &I2, const vpIntegralImage &II,
+                                      double b2, unsigned int i0, unsigned int j0);
 
   template <class Type>
   static void resizeBicubic(const vpImage<Type> &I, vpImage<Type> &Ires, unsigned int i, unsigned int j, float u,
@@ -317,7 +334,7 @@ void vpImageTools::crop(const vpImage<Type> &I, double roi_top, double roi_left,
 {
   int i_min = std::max<int>(static_cast<int>(ceil(roi_top / v_scale)), 0);
   int j_min = std::max<int>(static_cast<int>(ceil(roi_left / h_scale)), 0);
-  int i_max = std::min<int>(static_cast<int>(ceil(roi_top + roi_height) / v_scale), static_cast<int>(I.getHeight() / v_scale));
+  int i_max = std::min<int>(static_cast<int>(ceil((roi_top + roi_height) / v_scale)), static_cast<int>(I.getHeight() / v_scale));
   int j_max = std::min<int>(static_cast<int>(ceil((roi_left + roi_width) / h_scale)), static_cast<int>(I.getWidth() / h_scale));
 
   unsigned int i_min_u = static_cast<unsigned int>(i_min);
@@ -459,6 +476,57 @@ void vpImageTools::crop(const unsigned char *bitmap, unsigned int width, unsigne
   }
 }
 
+/*!
+  Copy the pixels of a strided image view into a dense image.
+
+  Setting \e v_scale and \e h_scale to values different from 1 allows also to
+  subsample the view. As with crop(const vpImage<Type> &, const vpRect &, vpImage<Type> &, unsigned int, unsigned int),
+  the subsampled pixels are the ones whose coordinates in the image the view was built from are multiples of the
+  scales, so that both functions give the same result for a view over a region of interest.
+
+  \param view : Input view, for example a region of interest of a larger image
+  or a camera buffer with padded rows.
+  \param crop : Dense image containing the viewed pixels.
+  \param v_scale [in] : Vertical subsampling factor applied to the view.
+  \param h_scale [in] : Horizontal subsampling factor applied to the view.
+
+  \sa vpImageView::copyTo()
+*/
+template <class Type>
+void vpImageTools::crop(const vpImageView<Type> &view, vpImage<Type> &crop, unsigned int v_scale, unsigned int h_scale)
+{
+  const double roi_top = view.getTop();
+  const double roi_left = view.getLeft();
+  int i_min = static_cast<int>(ceil(roi_top / v_scale));
+  int j_min = static_cast<int>(ceil(roi_left / h_scale));
+  int i_max = std::min<int>(static_cast<int>(ceil((roi_top + view.getHeight()) / v_scale)),
+                            static_cast<int>(view.getSourceHeight() / v_scale));
+  int j_max = std::min<int>(static_cast<int>(ceil((roi_left + view.getWidth()) / h_scale)),
+                            static_cast<int>(view.getSourceWidth() / h_scale));
+
+  unsigned int r_height = static_cast<unsigned int>(std::max<int>(i_max - i_min, 0));
+  unsigned int r_width = static_cast<unsigned int>(std::max<int>(j_max - j_min, 0));
+
+  crop.resize(r_height, r_width);
+
+  // Position of the first subsampled pixel in the view
+  unsigned int i_first = (static_cast<unsigned int>(i_min) * v_scale) - view.getTop();
+  unsigned int j_first = (static_cast<unsigned int>(j_min) * h_scale) - view.getLeft();
+  if (h_scale == 1) {
+    for (unsigned int i = 0; i < r_height; ++i) {
+      memcpy(crop[i], view[i_first + (i * v_scale)] + j_first, r_width * sizeof(Type));
+    }
+  }
+  else {
+    for (unsigned int i = 0; i < r_height; ++i) {
+      const Type *src = view[i_first + (i * v_scale)] + j_first;
+      for (unsigned int j = 0; j < r_width; ++j) {
+        crop[i][j] = src[j * h_scale];
+      }
+    }
+  }
+}
+
 /*!
   Binarise an image.
 
@@ -0,0 +1,273 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2024 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Strided, non-owning view over image data.
+ */
+
+/*!
+ * \file vpImageView.h
+ * \brief Strided, non-owning view over image data.
+ */
+
+#ifndef VP_IMAGE_VIEW_H
+#define VP_IMAGE_VIEW_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include <visp3/core/vpConfig.h>
+#include <visp3/core/vpException.h>
+#include <visp3/core/vpImage.h>
+#include <visp3/core/vpRect.h>
+
+BEGIN_VISP_NAMESPACE
+/*!
+  \class vpImageView
+
+  \ingroup group_core_image
+
+  \brief Strided, non-owning view over a 2D array of pixels.
+
+  A view is only made of a pointer to the first pixel, a width, a height and
+  a pitch, that is the number of bytes between the beginning of two
+  consecutive rows. It never allocates nor frees memory: the viewed buffer
+  must outlive the view.
+
+  Views allow to:
+  - process a region of interest (ROI) of a vpImage without any copy, since a
+    ROI of an image is just a view with the same pitch as the image;
+  - wrap camera buffers where rows are padded (e.g. V4L2 or RealSense frames
+    with a \e bytesperline larger than \e width * \e sizeof(Type)) without
+    repacking them.
+
+  As for vpImage, there is no bound checking when accessing pixels with
+  operator[] or operator().
+
+  \code
+  #include <visp3/core/vpImageFilter.h>
+  #include <visp3/core/vpImageView.h>
+
+  int main()
+  {
+    vpImage<unsigned char> I(2160, 3840);
+    // Zero-copy 640x480 region of interest
+    vpImageView<unsigned char> roi(I, vpRect(1000, 800, 640, 480));
+    vpImage<double> If;
+    vpArray2D<double> M(3, 3, 1. / 9.);
+    vpImageFilter::filter(roi, If, M);
+  }
+  \endcode
+
+  \sa vpImageTools::crop(const vpImageView<Type> &, vpImage<Type> &, unsigned int, unsigned int)
+*/
+template <class Type> class vpImageView
+{
+public:
+  /*!
+    Default constructor that builds an empty view.
+  */
+  vpImageView()
+    : m_data(nullptr), m_width(0), m_height(0), m_pitch(0), m_top(0), m_left(0), m_sourceHeight(0), m_sourceWidth(0)
+  { }
+
+  /*!
+    Build a view over an existing buffer.
+
+    \param data : Pointer to the first pixel of the view.
+    \param height : Number of rows.
+    \param width : Number of columns.
+    \param pitch : Number of bytes between the first pixels of two consecutive
+    rows. When set to 0, rows are considered as contiguous, i.e. the pitch is
+    \e width * \e sizeof(Type).
+  */
+  vpImageView(Type *data, unsigned int height, unsigned int width, size_t pitch = 0)
+    : m_data(data), m_width(width), m_height(height), m_pitch(pitch == 0 ? width * sizeof(Type) : pitch), m_top(0),
+    m_left(0), m_sourceHeight(height), m_sourceWidth(width)
+  {
+    if (m_pitch < (m_width * sizeof(Type))) {
+      throw(vpException(vpException::dimensionError, "Image view pitch (%d bytes) is smaller than a row (%d bytes)",
+                        static_cast<int>(m_pitch), static_cast<int>(m_width * sizeof(Type))));
+    }
+  }
+
+  /*!
+    Build a view over the whole image \e I.
+  */
+  explicit vpImageView(vpImage<Type> &I)
+    : m_data(I.bitmap), m_width(I.getWidth()), m_height(I.getHeight()), m_pitch(I.getWidth() * sizeof(Type)),
+    m_top(0), m_left(0), m_sourceHeight(I.getHeight()), m_sourceWidth(I.getWidth())
+  { }
+
+  /*!
+    Build a view over a region of interest of image \e I. The ROI is clipped
+    to the image boundaries using the same convention as
+    vpImageTools::crop(const vpImage<Type> &, const vpRect &, vpImage<Type> &, unsigned int, unsigned int).
+
+    \param I : Image that is viewed.
+    \param roi : Region of interest in \e I.
+  */
+  vpImageView(vpImage<Type> &I, const vpRect &roi)
+    : m_data(nullptr), m_width(0), m_height(0), m_pitch(I.getWidth() * sizeof(Type)), m_top(0), m_left(0),
+    m_sourceHeight(I.getHeight()), m_sourceWidth(I.getWidth())
+  {
+    *this = vpImageView<Type>(I).subView(roi);
+  }
+
+  /*!
+    Copy the viewed pixels into a dense image.
+
+    \param I : Destination image, resized to the view size.
+  */
+  void copyTo(vpImage<Type> &I) const
+  {
+    I.resize(m_height, m_width);
+    for (unsigned int i = 0; i < m_height; ++i) {
+      memcpy(I[i], (*this)[i], m_width * sizeof(Type));
+    }
+  }
+
+  /*!
+    Return a pointer to the first pixel of the view.
+  */
+  inline Type *data() const { return m_data; }
+
+  /*!
+    Return the number of columns of the view.
+  */
+  inline unsigned int getCols() const { return m_width; }
+
+  /*!
+    Return the view height.
+  */
+  inline unsigned int getHeight() const { return m_height; }
+
+  /*!
+    Return the column of the first pixel of the view in the image or the
+    buffer it was built from.
+  */
+  inline unsigned int getLeft() const { return m_left; }
+
+  /*!
+    Return the number of bytes between the first pixels of two consecutive rows.
+  */
+  inline size_t getPitch() const { return m_pitch; }
+
+  /*!
+    Return the number of rows of the view.
+  */
+  inline unsigned int getRows() const { return m_height; }
+
+  /*!
+    Return the number of pixels in the view, i.e. width * height.
+  */
+  inline unsigned int getSize() const { return m_width * m_height; }
+
+  /*!
+    Return the height of the image or the buffer the view was built from.
+  */
+  inline unsigned int getSourceHeight() const { return m_sourceHeight; }
+
+  /*!
+    Return the width of the image or the buffer the view was built from.
+  */
+  inline unsigned int getSourceWidth() const { return m_sourceWidth; }
+
+  /*!
+    Return the row of the first pixel of the view in the image or the buffer
+    it was built from.
+  */
+  inline unsigned int getTop() const { return m_top; }
+
+  /*!
+    Return the view width.
+  */
+  inline unsigned int getWidth() const { return m_width; }
+
+  /*!
+    Return true when the rows are stored contiguously in memory, i.e. when the
+    pitch equals \e width * \e sizeof(Type). Such views can be wrapped into a
+    vpImage without copy using vpImage(Type *, unsigned int, unsigned int, bool).
+  */
+  inline bool isContinuous() const { return (m_pitch == (m_width * sizeof(Type))) || (m_height <= 1); }
+
+  /*!
+    Return a pointer to the \e i-th row of the view.
+  */
+  inline Type *operator[](unsigned int i) const
+  {
+    return reinterpret_cast<Type *>(reinterpret_cast<unsigned char *>(m_data) + (i * m_pitch));
+  }
+
+  /*!
+    Return a reference to the pixel at row \e i and column \e j.
+  */
+  inline Type &operator()(unsigned int i, unsigned int j) const { return (*this)[i][j]; }
+
+  /*!
+    Return a view over a region of interest of this view. The ROI is expressed
+    in this view coordinates and is clipped to its boundaries. No pixel is
+    copied.
+
+    \param roi : Region of interest.
+  */
+  vpImageView<Type> subView(const vpRect &roi) const
+  {
+    int i_min = std::max<int>(static_cast<int>(ceil(roi.getTop())), 0);
+    int j_min = std::max<int>(static_cast<int>(ceil(roi.getLeft())), 0);
+    int i_max = std::min<int>(static_cast<int>(ceil(roi.getTop() + roi.getHeight())), static_cast<int>(m_height));
+    int j_max = std::min<int>(static_cast<int>(ceil(roi.getLeft() + roi.getWidth())), static_cast<int>(m_width));
+
+    vpImageView<Type> view;
+    view.m_pitch = m_pitch;
+    view.m_sourceHeight = m_sourceHeight;
+    view.m_sourceWidth = m_sourceWidth;
+    if ((i_max > i_min) && (j_max > j_min)) {
+      view.m_data = (*this)[static_cast<unsigned int>(i_min)] + j_min;
+      view.m_height = static_cast<unsigned int>(i_max - i_min);
+      view.m_width = static_cast<unsigned int>(j_max - j_min);
+      view.m_top = m_top + static_cast<unsigned int>(i_min);
+      view.m_left = m_left + static_cast<unsigned int>(j_min);
+    }
+    return view;
+  }
+
+private:
+  Type *m_data;         //!< Pointer to the first pixel of the view
+  unsigned int m_width;  //!< Number of columns
+  unsigned int m_height; //!< Number of rows
+  size_t m_pitch;        //!< Number of bytes between two consecutive rows
+  unsigned int m_top;    //!< Row of the first pixel in the source image
+  unsigned int m_left;   //!< Column of the first pixel in the source image
+  unsigned int m_sourceHeight; //!< Height of the source image
+  unsigned int m_sourceWidth;  //!< Width of the source image
+};
+END_VISP_NAMESPACE
+#endif
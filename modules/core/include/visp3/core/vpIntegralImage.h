@@ -0,0 +1,174 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2024 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ *
+ * Description:
+ * Integral image with integer accumulators.
+ */
+
+/*!
+ * \file vpIntegralImage.h
+ * \brief Integral image with integer accumulators.
+ */
+
+#ifndef VP_INTEGRAL_IMAGE_H
+#define VP_INTEGRAL_IMAGE_H
+
+#include <stdint.h>
+
+#include <visp3/core/vpConfig.h>
+#include <visp3/core/vpImage.h>
+#include <visp3/core/vpRect.h>
+
+BEGIN_VISP_NAMESPACE
+/*!
+  \class vpIntegralImage
+
+  \ingroup group_core_image
+
+  \brief Integral image of a grayscale image, and optionally of its squared values, with integer accumulators.
+
+  The sum of the pixels, and the sum of their squared values, over any rectangular box of the image are then
+  obtained with four memory accesses, whatever the size of the box. This is the basis of the box filters
+  vpImageFilter::boxFilter() and vpImageFilter::localMeanAndStdev(), and of vpImageTools::templateMatching().
+
+  The integral images have one more row and one more column than the image, the first row and the first column
+  being 0. The sums are stored in 32 bits unsigned integers and computed modulo \f$ 2^{32} \f$, which gives the exact
+  sum over any box whose area is below \f$ 2^{32} / 255 \f$, that is around 16.8 millions of pixels. The squared
+  values are accumulated in 64 bits unsigned integers. Rows are computed with SSE2 or NEON instructions when
+  available.
+
+  When only a part of the image changes, update() recomputes only the part of the integral images that depends
+  on it.
+
+  \code
+  #include <visp3/core/vpIntegralImage.h>
+
+  #ifdef ENABLE_VISP_NAMESPACE
+  using namespace VISP_NAMESPACE_NAME;
+  #endif
+
+  int main()
+  {
+    vpImage<unsigned char> I(480, 640, 128);
+    vpIntegralImage II(I, true);
+    // Mean and variance of the 21x21 box whose top left corner is (100, 200)
+    double mean = II.getMean(100, 200, 121, 221);
+    double variance = II.getVariance(100, 200, 121, 221);
+
+    // Modify a part of the image and update the integral images accordingly
+    vpRect roi(300, 50, 40, 20);
+    for (unsigned int i = 50; i < 70; ++i) {
+      for (unsigned int j = 300; j < 340; ++j) {
+        I[i][j] = 255;
+      }
+    }
+    II.update(I, roi);
+  }
+  \endcode
+*/
+class VISP_EXPORT vpIntegralImage
+{
+public:
+  vpIntegralImage();
+  explicit vpIntegralImage(const vpImage<unsigned char> &I, bool computeSquaredSum = false);
+
+  void compute(const vpImage<unsigned char> &I, bool computeSquaredSum = false);
+
+  //! Return the height of the image the integral images are computed from.
+  inline unsigned int getHeight() const { return m_height; }
+  //! Return the width of the image the integral images are computed from.
+  inline unsigned int getWidth() const { return m_width; }
+
+  /*!
+    Return the mean of the pixels in the box made of the rows in [top, bottom[ and the columns in [left, right[.
+    The box must not be empty.
+  */
+  inline double getMean(unsigned int top, unsigned int left, unsigned int bottom, unsigned int right) const
+  {
+    return static_cast<double>(getSum(top, left, bottom, right)) / ((bottom - top) * (right - left));
+  }
+
+  /*!
+    Return the integral image of the pixels, modulo \f$ 2^{32} \f$.
+  */
+  inline const vpImage<uint32_t> &getSum() const { return m_sum; }
+
+  /*!
+    Return the sum of the pixels in the box made of the rows in [top, bottom[ and the columns in [left, right[.
+  */
+  inline uint32_t getSum(unsigned int top, unsigned int left, unsigned int bottom, unsigned int right) const
+  {
+    // Unsigned wrap around gives the exact sum as long as it fits in 32 bits
+    return ((m_sum[bottom][right] - m_sum[top][right]) - m_sum[bottom][left]) + m_sum[top][left];
+  }
+
+  /*!
+    Return the integral image of the squared pixels, empty when it was not requested.
+  */
+  inline const vpImage<uint64_t> &getSquaredSum() const { return m_squaredSum; }
+
+  /*!
+    Return the sum of the squared pixels in the box made of the rows in [top, bottom[ and the columns in
+    [left, right[. The integral image of the squared pixels must have been computed.
+  */
+  inline uint64_t getSquaredSum(unsigned int top, unsigned int left, unsigned int bottom, unsigned int right) const
+  {
+    return ((m_squaredSum[bottom][right] - m_squaredSum[top][right]) - m_squaredSum[bottom][left]) +
+      m_squaredSum[top][left];
+  }
+
+  /*!
+    Return the variance of the pixels in the box made of the rows in [top, bottom[ and the columns in
+    [left, right[. The integral image of the squared pixels must have been computed and the box must not be empty.
+  */
+  inline double getVariance(unsigned int top, unsigned int left, unsigned int bottom, unsigned int right) const
+  {
+    const double area = static_cast<double>((bottom - top) * (right - left));
+    const double mean = getSum(top, left, bottom, right) / area;
+    const double variance = (getSquaredSum(top, left, bottom, right) / area) - (mean * mean);
+    return variance > 0. ? variance : 0.;
+  }
+
+  //! Return true if the integral image of the squared pixels is computed.
+  inline bool hasSquaredSum() const { return m_hasSquaredSum; }
+
+  void update(const vpImage<unsigned char> &I, const vpRect &roi);
+
+private:
+  void computeRows(const vpImage<unsigned char> &I, unsigned int top, unsigned int left);
+
+  unsigned int m_height;
+  unsigned int m_width;
+  bool m_hasSquaredSum;
+  vpImage<uint32_t> m_sum;
+  vpImage<uint64_t> m_squaredSum;
+};
+END_VISP_NAMESPACE
+#endif
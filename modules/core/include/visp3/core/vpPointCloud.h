@@ -0,0 +1,140 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2024 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ *
+ * Description:
+ * Organized point cloud stored as a structure of arrays.
+ */
+
+/*!
+ * \file vpPointCloud.h
+ * \brief Organized point cloud stored as a structure of arrays.
+ */
+
+#ifndef VP_POINT_CLOUD_H
+#define VP_POINT_CLOUD_H
+
+#include <vector>
+
+#include <visp3/core/vpConfig.h>
+
+BEGIN_VISP_NAMESPACE
+/*!
+  \class vpPointCloud
+
+  \ingroup group_core_image
+
+  \brief Organized point cloud stored as a structure of arrays.
+
+  The point at index `i * getWidth() + j` comes from the pixel \f$(i, j)\f$ of
+  the depth image it was computed from. Its coordinates in meter in the depth
+  camera frame are stored in three contiguous arrays of floats, one per
+  coordinate, which can be processed with SIMD instructions.
+
+  A point is valid when its Z coordinate is strictly positive. The
+  coordinates of invalid points are set to 0.
+
+  The memory is kept when the point cloud is resized to the same size, so that
+  converting a depth stream with vpImageConvert::depthToPointCloud() does not
+  allocate after the first frame.
+
+  \code
+  #include <visp3/core/vpImageConvert.h>
+  #include <visp3/core/vpPointCloud.h>
+
+  #ifdef ENABLE_VISP_NAMESPACE
+  using namespace VISP_NAMESPACE_NAME;
+  #endif
+
+  int main()
+  {
+    vpImage<uint16_t> I_depth(480, 640, 1000);
+    vpCameraParameters cam(600, 600, 320, 240);
+    vpPointCloud pointcloud;
+    // Depth is in mm, keep points between 0.2 and 2.5 m
+    vpImageConvert::depthToPointCloud(I_depth, 0.001f, cam, pointcloud);
+    std::cout << "Number of points: " << pointcloud.getNumberOfValidPoints() << std::endl;
+  }
+  \endcode
+
+  \sa vpImageConvert::depthToPointCloud(), vpMbGenericTracker::track()
+*/
+class VISP_EXPORT vpPointCloud
+{
+public:
+  vpPointCloud();
+  vpPointCloud(unsigned int height, unsigned int width);
+
+  void clear();
+
+  //! Return the height of the organized point cloud.
+  inline unsigned int getHeight() const { return m_height; }
+  //! Return the width of the organized point cloud.
+  inline unsigned int getWidth() const { return m_width; }
+  //! Return the number of points, valid or not, that is the width times the height.
+  inline unsigned int getSize() const { return m_width * m_height; }
+  //! Return the number of points with a strictly positive Z coordinate.
+  inline unsigned int getNumberOfValidPoints() const { return m_nbValidPoints; }
+
+  //! Return the X coordinates, stored row by row.
+  inline const float *getX() const { return m_X.data(); }
+  //! Return the Y coordinates, stored row by row.
+  inline const float *getY() const { return m_Y.data(); }
+  //! Return the Z coordinates, stored row by row.
+  inline const float *getZ() const { return m_Z.data(); }
+  //! Return the X coordinates, stored row by row.
+  inline float *getX() { return m_X.data(); }
+  //! Return the Y coordinates, stored row by row.
+  inline float *getY() { return m_Y.data(); }
+  //! Return the Z coordinates, stored row by row.
+  inline float *getZ() { return m_Z.data(); }
+
+  /*!
+    Return true if the point corresponding to the pixel \f$(i, j)\f$ is valid.
+  */
+  inline bool isValid(unsigned int i, unsigned int j) const { return m_Z[(i * m_width) + j] > 0; }
+
+  void resize(unsigned int height, unsigned int width);
+
+  /*!
+    Set the number of valid points, to call after modifying the coordinates
+    through getX(), getY() and getZ().
+  */
+  inline void setNumberOfValidPoints(unsigned int nbValidPoints) { m_nbValidPoints = nbValidPoints; }
+
+private:
+  unsigned int m_width;
+  unsigned int m_height;
+  unsigned int m_nbValidPoints;
+  std::vector<float> m_X;
+  std::vector<float> m_Y;
+  std::vector<float> m_Z;
+};
+END_VISP_NAMESPACE
+#endif
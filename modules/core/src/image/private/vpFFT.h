@@ -0,0 +1,95 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2024 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ *
+ * Description:
+ * Bundled Fast Fourier Transform used by frequency-domain image processing.
+ */
+
+/*!
+  \file vpFFT.h
+  \brief Mixed-radix complex FFT and FFT-based 2D cross-correlation.
+
+  The transform is a Stockham auto-sort FFT with radix 2, 3, 4 and 5 butterflies and a generic butterfly for the
+  other prime factors, so that any size is supported. It is the fastest for sizes that only have 2, 3 and 5 as
+  prime factors, see vpFFT::getOptimalSize().
+*/
+
+#ifndef VP_FFT_H
+#define VP_FFT_H
+
+#include <complex>
+#include <vector>
+
+#include <visp3/core/vpConfig.h>
+#include <visp3/core/vpImage.h>
+
+BEGIN_VISP_NAMESPACE
+class vpFFT
+{
+public:
+  vpFFT();
+  explicit vpFFT(unsigned int n);
+
+  void init(unsigned int n);
+  inline unsigned int getSize() const { return m_n; }
+
+  /*!
+    In-place forward transform \f$ X_k = \sum_n x_n e^{-2i\pi kn/N} \f$ of getSize() values, \e work being a buffer
+    of getSize() values.
+   */
+  void forward(std::complex<double> *data, std::complex<double> *work) const;
+  /*!
+    In-place inverse transform, not normalized by \f$ 1/N \f$.
+   */
+  void inverse(std::complex<double> *data, std::complex<double> *work) const;
+
+  static unsigned int getOptimalSize(unsigned int n);
+
+private:
+  unsigned int m_n;
+  std::vector<unsigned int> m_radices;
+  //! For each stage of length L and radix r, the twiddle factors \f$ e^{-2i\pi pk/L} \f$, p < L/r, 0 < k < r.
+  std::vector<std::complex<double> > m_twiddles;
+};
+
+/*!
+  Cross-correlation \f$ C(i,j) = \sum_{u,v} I(i+u,j+v) T(u,v) \f$ of the image \e I with the template \e I_tpl at
+  all the positions where the template lies in the image, that is \e I_corr is resized to
+  \f$ (H-h+1) \times (W-w+1) \f$. The two real inputs are packed into a single complex transform.
+
+  \param[in] I : Input image.
+  \param[in] I_tpl : Template, not bigger than \e I.
+  \param[out] I_corr : Cross-correlation.
+  \param[in] nThreads : Number of threads used with OpenMP, 0 to use the OpenMP default.
+ */
+void vp_crossCorrelation(const vpImage<double> &I, const vpImage<double> &I_tpl, vpImage<double> &I_corr,
+                         unsigned int nThreads = 0);
+END_VISP_NAMESPACE
+#endif
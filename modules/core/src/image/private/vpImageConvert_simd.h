@@ -0,0 +1,105 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2024 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ *
+ * Description:
+ * Vectorized color conversion and depth unprojection kernels.
+ */
+
+/*!
+  \file vpImageConvert_simd.h
+  \brief Color conversion and depth unprojection kernels dispatched at runtime to SSE4.1, AVX2 or NEON code.
+
+  Each kernel converts \e size contiguous pixels. The vectorized code gives the exact same results as the scalar
+  code, that is used for the last pixels and when no instruction set is available.
+*/
+
+#ifndef VP_IMAGE_CONVERT_SIMD_H
+#define VP_IMAGE_CONVERT_SIMD_H
+
+#include <stdint.h>
+
+#include <visp3/core/vpConfig.h>
+
+BEGIN_VISP_NAMESPACE
+/*!
+  Grey level computed with the Rec. 709 luma coefficients and 14 bits fixed point arithmetic, rounded to the nearest
+  value.
+ */
+void vp_RGBToGrey(const unsigned char *rgb, unsigned char *grey, unsigned int size);
+void vp_BGRToGrey(const unsigned char *bgr, unsigned char *grey, unsigned int size);
+void vp_RGBaToGrey(const unsigned char *rgba, unsigned char *grey, unsigned int size);
+void vp_BGRaToGrey(const unsigned char *bgra, unsigned char *grey, unsigned int size);
+
+void vp_GreyToRGBa(const unsigned char *grey, unsigned char *rgba, unsigned int size);
+void vp_RGBToRGBa(const unsigned char *rgb, unsigned char *rgba, unsigned int size);
+void vp_BGRToRGBa(const unsigned char *bgr, unsigned char *rgba, unsigned int size);
+void vp_BGRaToRGBa(const unsigned char *bgra, unsigned char *rgba, unsigned int size);
+void vp_RGBaToRGB(const unsigned char *rgba, unsigned char *rgb, unsigned int size);
+
+/*!
+  Split RGBa pixels into 4 planes, all pointers being valid.
+ */
+void vp_splitRGBa(const unsigned char *rgba, unsigned char *R, unsigned char *G, unsigned char *B, unsigned char *A,
+                  unsigned int size);
+/*!
+  Merge 4 planes into RGBa pixels, all pointers being valid.
+ */
+void vp_mergeRGBa(const unsigned char *R, const unsigned char *G, const unsigned char *B, const unsigned char *A,
+                  unsigned char *rgba, unsigned int size);
+
+/*!
+  Convert YUYV 4:2:2 (y0 u01 y1 v01 ...) pixels, \e size being even.
+ */
+void vp_YUYVToRGBa(const unsigned char *yuyv, unsigned char *rgba, unsigned int size);
+/*!
+  Convert YUV 4:2:2 (u01 y0 v01 y1 ...) pixels, \e size being even.
+ */
+void vp_UYVYToRGBa(const unsigned char *uyvy, unsigned char *rgba, unsigned int size);
+/*!
+  Convert two rows of YUV 4:2:0 planar pixels sharing the same chroma row, \e width being even.
+ */
+void vp_YUV420ToRGBa(const unsigned char *y0, const unsigned char *y1, const unsigned char *u, const unsigned char *v,
+                     unsigned char *rgba0, unsigned char *rgba1, unsigned int width);
+
+/*!
+  Unproject a row of raw depth values. The point of column j is \f$Z\,(x_j, y, 1)\f$ with \f$Z\f$ the depth
+  multiplied by \e depth_scale when it lies in \f$]Z_{min}, Z_{max}[\f$, otherwise the point is set to 0.
+
+  \return The number of valid points.
+ */
+unsigned int vp_depthToPoints(const uint16_t *depth, float depth_scale, const float *x, float y, float Z_min,
+                              float Z_max, float *X, float *Y, float *Z, unsigned int size);
+/*!
+  Unproject a row of depth values in meter, as vp_depthToPoints() with a depth scale of 1.
+ */
+unsigned int vp_depthToPoints(const float *depth, const float *x, float y, float Z_min, float Z_max, float *X,
+                              float *Y, float *Z, unsigned int size);
+END_VISP_NAMESPACE
+#endif
@@ -32,10 +32,6 @@
 
 #include <visp3/core/vpImageConvert.h>
 
-#ifdef VISP_USE_MSVC
-#pragma comment(linker, "/STACK:65532000") // Increase max recursion depth
-#endif
-
 #if (VISP_CXX_STANDARD == VISP_CXX_STANDARD_98) // Check if cxx98
 namespace
 {
@@ -102,9 +98,7 @@ vpCannyEdgeDetection::vpCannyEdgeDetection()
   , m_lowerThresholdRatio(0.6f)
   , m_upperThreshold(-1.f)
   , m_upperThresholdRatio(0.8f)
-#if !defined(_WIN32) && (defined(__unix__) || defined(__unix) || (defined(__APPLE__) && defined(__MACH__))) // UNIX
-  , m_minStackSize(0)  // Deactivated by default
-#endif
+  , m_storeListEdgePoints(false)
   , mp_mask(nullptr)
 {
   initGaussianFilters();
@@ -127,9 +121,6 @@ vpCannyEdgeDetection::vpCannyEdgeDetection(const int &gaussianKernelSize, const
   , m_lowerThresholdRatio(lowerThresholdRatio)
   , m_upperThreshold(upperThreshold)
   , m_upperThresholdRatio(upperThresholdRatio)
-#if !defined(_WIN32) && (defined(__unix__) || defined(__unix) || (defined(__APPLE__) && defined(__MACH__))) // UNIX
-  , m_minStackSize(0)  // Deactivated by default
-#endif
   , m_storeListEdgePoints(storeEdgePoints)
   , mp_mask(nullptr)
 {
@@ -142,9 +133,17 @@ vpCannyEdgeDetection::vpCannyEdgeDetection(const int &gaussianKernelSize, const
 using json = nlohmann::json;
 
 vpCannyEdgeDetection::vpCannyEdgeDetection(const std::string &jsonPath)
-#if !defined(_WIN32) && (defined(__unix__) || defined(__unix) || (defined(__APPLE__) && defined(__MACH__))) // UNIX
-  : m_minStackSize(0)  // Deactivated by default
-#endif
+  : m_filteringAndGradientType(vpImageFilter::CANNY_GBLUR_SOBEL_FILTERING)
+  , m_gaussianKernelSize(3)
+  , m_gaussianStdev(1.f)
+  , m_areGradientAvailable(false)
+  , m_gradientFilterKernelSize(3)
+  , m_lowerThreshold(-1.f)
+  , m_lowerThresholdRatio(0.6f)
+  , m_upperThreshold(-1.f)
+  , m_upperThresholdRatio(0.8f)
+  , m_storeListEdgePoints(false)
+  , mp_mask(nullptr)
 {
   initFromJSON(jsonPath);
 }
@@ -254,33 +253,8 @@ vpCannyEdgeDetection::detect(const vpImage<vpRGBa> &I_color)
 vpImage<unsigned char>
 vpCannyEdgeDetection::detect(const vpImage<unsigned char> &I)
 {
-#if !defined(_WIN32) && (defined(__unix__) || defined(__unix) || (defined(__APPLE__) && defined(__MACH__))) // UNIX
-  rlim_t initialStackSize = 0;
-  struct rlimit rl;
-  int result;
-  if (m_minStackSize > 0) {
-    // Check the current stack size
-    result = getrlimit(RLIMIT_STACK, &rl);
-    if (result == 0) {
-      initialStackSize = rl.rlim_cur;
-      if (rl.rlim_cur < m_minStackSize) {
-        // Increase stack size due to the recursive algorithm
-        rl.rlim_cur = m_minStackSize;
-        result = setrlimit(RLIMIT_STACK, &rl);
-        if (result != 0) {
-          throw(vpException(vpException::fatalError, "setrlimit returned result = %d\n", result));
-        }
-      }
-    }
-    else {
-      throw(vpException(vpException::fatalError, "getrlimit returned result = %d\n", result));
-    }
-  }
-#endif
   // // Clearing the previous results
   m_edgeMap.resize(I.getHeight(), I.getWidth(), 0);
-  m_edgeCandidateAndGradient.clear();
-  m_edgePointsCandidates.clear();
   m_edgePointsList.clear();
 
   // // Step 1 and 2: filter the image and compute the gradient, if not given by the user
@@ -311,19 +285,6 @@ vpCannyEdgeDetection::detect(const vpImage<unsigned char> &I)
   // // Step 5: edge tracking
   performEdgeTracking();
 
-#if !defined(_WIN32) && (defined(__unix__) || defined(__unix) || (defined(__APPLE__) && defined(__MACH__))) // UNIX
-  if (m_minStackSize > 0) {
-    if (rl.rlim_cur > initialStackSize) {
-      // Reset stack size to its original value
-      rl.rlim_cur = initialStackSize;
-      result = setrlimit(RLIMIT_STACK, &rl);
-      if (result != 0) {
-        throw(vpException(vpException::fatalError, "setrlimit returned result = %d\n", result));
-
-      }
-    }
-  }
-#endif
   return m_edgeMap;
 }
 
@@ -339,8 +300,7 @@ vpCannyEdgeDetection::computeFilteringAndGradient(const vpImage<unsigned char> &
     vpImageFilter::filterY<float, float>(GIx, Iblur, m_fg.data, m_gaussianKernelSize, mp_mask);
 
     // Computing the gradients
-    vpImageFilter::filter(Iblur, m_dIx, m_gradientFilterX, true, mp_mask);
-    vpImageFilter::filter(Iblur, m_dIy, m_gradientFilterY, true, mp_mask);
+    computeGradients(Iblur);
   }
   else {
     std::string errmsg("Currently, the filtering operation \"");
@@ -350,6 +310,44 @@ vpCannyEdgeDetection::computeFilteringAndGradient(const vpImage<unsigned char> &
   }
 }
 
+void
+vpCannyEdgeDetection::computeGradients(const vpImage<float> &Iblur)
+{
+  const int size_y = static_cast<int>(m_gradientFilterX.getRows());
+  const int size_x = static_cast<int>(m_gradientFilterX.getCols());
+  const int half_size_y = size_y / 2;
+  const int half_size_x = size_x / 2;
+  const int nbRows = static_cast<int>(Iblur.getRows());
+  const int nbCols = static_cast<int>(Iblur.getCols());
+  const int stopRow = nbRows - half_size_y;
+  const int stopCol = nbCols - half_size_x;
+  m_dIx.resize(Iblur.getRows(), Iblur.getCols(), 0.f);
+  m_dIy.resize(Iblur.getRows(), Iblur.getCols(), 0.f);
+
+  // Same convolution as vpImageFilter::filter(), the borders being left to 0
+#ifdef VISP_HAVE_OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+  for (int row = half_size_y; row < stopRow; ++row) {
+    for (int col = half_size_x; col < stopCol; ++col) {
+      if ((mp_mask == nullptr) || (*mp_mask)[row][col]) {
+        float convX = 0.f;
+        float convY = 0.f;
+        for (int a = 0; a < size_y; ++a) {
+          const float *blurRow = Iblur[(row + half_size_y) - a];
+          for (int b = 0; b < size_x; ++b) {
+            const float val = blurRow[(col + half_size_x) - b];
+            convX += m_gradientFilterX[a][b] * val;
+            convY += m_gradientFilterY[a][b] * val;
+          }
+        }
+        m_dIx[row][col] = convX;
+        m_dIy[row][col] = convY;
+      }
+    }
+  }
+}
+
 /**
  * \brief Get the interpolation weights and offsets.
  *
@@ -469,14 +467,16 @@ vpCannyEdgeDetection::performEdgeThinning(const float &lowerThreshold)
 {
   int nbRows = m_dIx.getRows();
   int nbCols = m_dIx.getCols();
+  m_edgeCandidateAndGradient.resize(m_dIx.getRows(), m_dIx.getCols(), 0.f);
 
-  bool ignore_current_pixel = false;
-  bool grad_lower_threshold = false;
+  // Each row is processed independently, the result of a pixel depending only on the gradients
+#ifdef VISP_HAVE_OPENMP
+#pragma omp parallel for schedule(static)
+#endif
   for (int row = 0; row < nbRows; ++row) {
     for (int col = 0; col < nbCols; ++col) {
-      // reset the checks
-      ignore_current_pixel = false;
-      grad_lower_threshold = false;
+      bool ignore_current_pixel = false;
+      bool grad_lower_threshold = false;
 
       if (mp_mask != nullptr) {
         if (!(*mp_mask)[row][col]) {
@@ -516,8 +516,7 @@ vpCannyEdgeDetection::performEdgeThinning(const float &lowerThreshold)
 
           if ((grad >= gradPlus) && (grad >= gradMinus)) {
             // Keeping the edge point that has the highest gradient
-            std::pair<unsigned int, unsigned int> bestPixel(row, col);
-            m_edgeCandidateAndGradient[bestPixel] = grad;
+            m_edgeCandidateAndGradient[row][col] = grad;
           }
         }
       }
@@ -528,14 +527,21 @@ vpCannyEdgeDetection::performEdgeThinning(const float &lowerThreshold)
 void
 vpCannyEdgeDetection::performHysteresisThresholding(const float &lowerThreshold, const float &upperThreshold)
 {
-  std::map<std::pair<unsigned int, unsigned int>, float>::iterator it;
-  std::map<std::pair<unsigned int, unsigned int>, float>::iterator m_edgeCandidateAndGradient_end = m_edgeCandidateAndGradient.end();
-  for (it = m_edgeCandidateAndGradient.begin(); it != m_edgeCandidateAndGradient_end; ++it) {
-    if (it->second >= upperThreshold) {
-      m_edgePointsCandidates[it->first] = STRONG_EDGE;
-    }
-    else if ((it->second >= lowerThreshold) && (it->second < upperThreshold)) {
-      m_edgePointsCandidates[it->first] = WEAK_EDGE;
+  const int nbRows = static_cast<int>(m_edgeCandidateAndGradient.getRows());
+  const unsigned int nbCols = m_edgeCandidateAndGradient.getCols();
+  m_edgePointsCandidates.resize(m_edgeCandidateAndGradient.getRows(), nbCols, NOT_EDGE);
+#ifdef VISP_HAVE_OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+  for (int row = 0; row < nbRows; ++row) {
+    for (unsigned int col = 0; col < nbCols; ++col) {
+      const float grad = m_edgeCandidateAndGradient[row][col];
+      if (grad >= upperThreshold) {
+        m_edgePointsCandidates[row][col] = STRONG_EDGE;
+      }
+      else if ((grad >= lowerThreshold) && (grad < upperThreshold)) {
+        m_edgePointsCandidates[row][col] = WEAK_EDGE;
+      }
     }
   }
 }
@@ -544,83 +550,44 @@ void
 vpCannyEdgeDetection::performEdgeTracking()
 {
   const unsigned char var_uc_255 = 255;
-  std::map<std::pair<unsigned int, unsigned int>, EdgeType>::iterator it;
-  std::map<std::pair<unsigned int, unsigned int>, EdgeType>::iterator m_edgePointsCandidates_end = m_edgePointsCandidates.end();
-  for (it = m_edgePointsCandidates.begin(); it != m_edgePointsCandidates_end; ++it) {
-    if (it->second == STRONG_EDGE) {
-      m_edgeMap[it->first.first][it->first.second] = var_uc_255;
-      if (m_storeListEdgePoints) {
-        m_edgePointsList.push_back(vpImagePoint(it->first.first, it->first.second));
+  const unsigned int nbRows = m_edgePointsCandidates.getRows();
+  const unsigned int nbCols = m_edgePointsCandidates.getCols();
+  for (unsigned int row = 0; row < nbRows; ++row) {
+    for (unsigned int col = 0; col < nbCols; ++col) {
+      if ((m_edgePointsCandidates[row][col] == STRONG_EDGE) && (m_edgeMap[row][col] == 0)) {
+        m_edgeMap[row][col] = var_uc_255;
+        m_edgeTrackingStack.push_back(std::pair<unsigned int, unsigned int>(row, col));
+
+        // Promote the weak edge points that are 8-connected to the strong edge point
+        while (!m_edgeTrackingStack.empty()) {
+          const std::pair<unsigned int, unsigned int> coordinates = m_edgeTrackingStack.back();
+          m_edgeTrackingStack.pop_back();
+          const unsigned int rowMin = (coordinates.first > 0) ? (coordinates.first - 1) : 0;
+          const unsigned int rowMax = std::min<unsigned int>(coordinates.first + 1, nbRows - 1);
+          const unsigned int colMin = (coordinates.second > 0) ? (coordinates.second - 1) : 0;
+          const unsigned int colMax = std::min<unsigned int>(coordinates.second + 1, nbCols - 1);
+          for (unsigned int r = rowMin; r <= rowMax; ++r) {
+            for (unsigned int c = colMin; c <= colMax; ++c) {
+              if (m_edgePointsCandidates[r][c] == WEAK_EDGE) {
+                m_edgePointsCandidates[r][c] = STRONG_EDGE;
+                m_edgeMap[r][c] = var_uc_255;
+                m_edgeTrackingStack.push_back(std::pair<unsigned int, unsigned int>(r, c));
+              }
+            }
+          }
+        }
       }
     }
-    else if (it->second == WEAK_EDGE) {
-      recursiveSearchForStrongEdge(it->first);
-    }
   }
-}
 
-bool
-vpCannyEdgeDetection::recursiveSearchForStrongEdge(const std::pair<unsigned int, unsigned int> &coordinates)
-{
-  bool hasFoundStrongEdge = false;
-  int nbRows = m_dIx.getRows();
-  int nbCols = m_dIx.getCols();
-  m_edgePointsCandidates[coordinates] = ON_CHECK;
-  bool test_row = false;
-  bool test_col = false;
-  bool test_drdc = false;
-  bool edge_in_image_limit = false;
-  int dr = -1;
-  while ((dr <= 1) && (!hasFoundStrongEdge)) {
-    int dc = -1;
-    while ((dc <= 1) && (!hasFoundStrongEdge)) {
-      // reset the check for the edge on image limit
-      edge_in_image_limit = false;
-
-      int idRow = dr + static_cast<int>(coordinates.first);
-      idRow = std::max<int>(idRow, 0); // Avoid getting negative pixel ID
-      int idCol = dc + static_cast<int>(coordinates.second);
-      idCol = std::max<int>(idCol, 0); // Avoid getting negative pixel ID
-
-      // Checking if we are still looking for an edge in the limit of the image
-      test_row = (idRow < 0) || (idRow >= nbRows);
-      test_col = (idCol < 0) || (idCol >= nbCols);
-      test_drdc = (dr == 0) && (dc == 0);
-      if (test_row || test_col || test_drdc) {
-        edge_in_image_limit = true;
-        // the continue is replaced by the test
-      }
-      if (edge_in_image_limit == false) {
-
-        try {
-          std::pair<unsigned int, unsigned int> key_candidate(idRow, idCol);
-          // Checking if the 8-neighbor point is in the list of edge candidates
-          EdgeType type_candidate = m_edgePointsCandidates.at(key_candidate);
-          if (type_candidate == STRONG_EDGE) {
-            // The 8-neighbor point is a strong edge => the weak edge becomes a strong edge
-            hasFoundStrongEdge = true;
-          }
-          else if (type_candidate == WEAK_EDGE) {
-            // Checking if the WEAK_EDGE neighbor has a STRONG_EDGE neighbor
-            hasFoundStrongEdge = recursiveSearchForStrongEdge(key_candidate);
-          }
-        }
-        catch (...) {
-          // continue - nothing to do
+  if (m_storeListEdgePoints) {
+    for (unsigned int row = 0; row < nbRows; ++row) {
+      for (unsigned int col = 0; col < nbCols; ++col) {
+        if (m_edgeMap[row][col] == var_uc_255) {
+          m_edgePointsList.push_back(vpImagePoint(row, col));
         }
       }
-      ++dc;
-    }
-    ++dr;
-  }
-  const unsigned char var_uc_255 = 255;
-  if (hasFoundStrongEdge) {
-    m_edgePointsCandidates[coordinates] = STRONG_EDGE;
-    m_edgeMap[coordinates.first][coordinates.second] = var_uc_255;
-    if (m_storeListEdgePoints) {
-      m_edgePointsList.push_back(vpImagePoint(coordinates.first, coordinates.second));
     }
   }
-  return hasFoundStrongEdge;
 }
 END_VISP_NAMESPACE
@@ -0,0 +1,376 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2024 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ *
+ * Description:
+ * Bundled Fast Fourier Transform used by frequency-domain image processing.
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include <visp3/core/vpException.h>
+#include <visp3/core/vpMath.h>
+
+#include "private/vpFFT.h"
+
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+
+BEGIN_VISP_NAMESPACE
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace
+{
+typedef std::complex<double> vpComplex;
+
+// Plain complex product, std::complex operator* checks for NaN and infinity and is much slower
+inline vpComplex mul(const vpComplex &a, const vpComplex &b)
+{
+  return vpComplex((a.real() * b.real()) - (a.imag() * b.imag()), (a.real() * b.imag()) + (a.imag() * b.real()));
+}
+
+// Multiplication by -i
+inline vpComplex mulMinusI(const vpComplex &a) { return vpComplex(a.imag(), -a.real()); }
+
+void conjugate(vpComplex *data, unsigned int n)
+{
+  for (unsigned int i = 0; i < n; ++i) {
+    data[i] = std::conj(data[i]);
+  }
+}
+
+void setNumThreads(unsigned int nThreads)
+{
+#if defined(_OPENMP)
+  if (nThreads > 0) {
+    omp_set_num_threads(static_cast<int>(nThreads));
+  }
+#else
+  (void)nThreads;
+#endif
+}
+
+/*
+ * Forward or inverse transform of the first nbRows rows of the row-major data of size height x width.
+ */
+void transformRows(vpComplex *data, unsigned int nbRows, const vpFFT &fft, bool inverse, unsigned int nThreads)
+{
+  const unsigned int width = fft.getSize();
+  const int nbRowsAsInt = static_cast<int>(nbRows);
+  setNumThreads(nThreads);
+#if defined(_OPENMP)
+#pragma omp parallel
+#endif
+  {
+    std::vector<vpComplex> work(width);
+#if defined(_OPENMP)
+#pragma omp for
+#endif
+    for (int i = 0; i < nbRowsAsInt; ++i) {
+      vpComplex *row = data + (static_cast<size_t>(i) * width);
+      if (inverse) {
+        fft.inverse(row, &work[0]);
+      }
+      else {
+        fft.forward(row, &work[0]);
+      }
+    }
+  }
+}
+
+/*
+ * Forward or inverse transform of all the columns of the row-major data of size height x width. Columns are
+ * processed by blocks of adjacent columns to read and write full cache lines.
+ */
+void transformColumns(vpComplex *data, unsigned int width, const vpFFT &fft, bool inverse, unsigned int nThreads)
+{
+  const unsigned int height = fft.getSize();
+  const unsigned int blockSize = 8;
+  const int nbBlocks = static_cast<int>((width + blockSize - 1) / blockSize);
+  setNumThreads(nThreads);
+#if defined(_OPENMP)
+#pragma omp parallel
+#endif
+  {
+    std::vector<vpComplex> columns(static_cast<size_t>(height) * blockSize), work(height);
+#if defined(_OPENMP)
+#pragma omp for
+#endif
+    for (int block = 0; block < nbBlocks; ++block) {
+      const unsigned int j0 = static_cast<unsigned int>(block) * blockSize;
+      const unsigned int nbCols = std::min<unsigned int>(blockSize, width - j0);
+      for (unsigned int i = 0; i < height; ++i) {
+        const vpComplex *src = data + (static_cast<size_t>(i) * width) + j0;
+        for (unsigned int c = 0; c < nbCols; ++c) {
+          columns[(static_cast<size_t>(c) * height) + i] = src[c];
+        }
+      }
+      for (unsigned int c = 0; c < nbCols; ++c) {
+        vpComplex *column = &columns[static_cast<size_t>(c) * height];
+        if (inverse) {
+          fft.inverse(column, &work[0]);
+        }
+        else {
+          fft.forward(column, &work[0]);
+        }
+      }
+      for (unsigned int i = 0; i < height; ++i) {
+        vpComplex *dst = data + (static_cast<size_t>(i) * width) + j0;
+        for (unsigned int c = 0; c < nbCols; ++c) {
+          dst[c] = columns[(static_cast<size_t>(c) * height) + i];
+        }
+      }
+    }
+  }
+}
+} // namespace
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+vpFFT::vpFFT() : m_n(0), m_radices(), m_twiddles() { }
+
+vpFFT::vpFFT(unsigned int n) : m_n(0), m_radices(), m_twiddles() { init(n); }
+
+/*!
+  Prepare the transforms of size \e n: factorization of \e n and twiddle factors.
+ */
+void vpFFT::init(unsigned int n)
+{
+  if (n == 0) {
+    throw(vpException(vpException::badValue, "Cannot compute a FFT of size 0"));
+  }
+
+  m_n = n;
+  m_radices.clear();
+  unsigned int remaining = n;
+  while ((remaining % 4) == 0) {
+    m_radices.push_back(4);
+    remaining /= 4;
+  }
+  for (unsigned int radix = 2; remaining > 1; ++radix) {
+    while ((remaining % radix) == 0) {
+      m_radices.push_back(radix);
+      remaining /= radix;
+    }
+  }
+
+  m_twiddles.clear();
+  unsigned int length = n;
+  for (size_t s = 0; s < m_radices.size(); ++s) {
+    const unsigned int radix = m_radices[s];
+    const unsigned int m = length / radix;
+    const double theta = (-2.0 * M_PI) / length;
+    for (unsigned int p = 0; p < m; ++p) {
+      for (unsigned int k = 1; k < radix; ++k) {
+        const double angle = theta * p * k;
+        m_twiddles.push_back(vpComplex(std::cos(angle), std::sin(angle)));
+      }
+    }
+    length = m;
+  }
+}
+
+void vpFFT::forward(std::complex<double> *data, std::complex<double> *work) const
+{
+  vpComplex *x = data;
+  vpComplex *y = work;
+  const vpComplex *twiddles = m_twiddles.empty() ? nullptr : &m_twiddles[0];
+  unsigned int length = m_n, stride = 1;
+  std::vector<vpComplex> a, roots;
+
+  for (size_t s = 0; s < m_radices.size(); ++s) {
+    const unsigned int radix = m_radices[s];
+    const unsigned int m = length / radix;
+
+    if (radix == 2) {
+      for (unsigned int p = 0; p < m; ++p) {
+        const vpComplex w1 = twiddles[p];
+        for (unsigned int q = 0; q < stride; ++q) {
+          const vpComplex a0 = x[q + (stride * p)];
+          const vpComplex a1 = x[q + (stride * (p + m))];
+          y[q + (stride * (2 * p))] = a0 + a1;
+          y[q + (stride * ((2 * p) + 1))] = mul(a0 - a1, w1);
+        }
+      }
+    }
+    else if (radix == 4) {
+      for (unsigned int p = 0; p < m; ++p) {
+        const vpComplex w1 = twiddles[3 * p], w2 = twiddles[(3 * p) + 1], w3 = twiddles[(3 * p) + 2];
+        for (unsigned int q = 0; q < stride; ++q) {
+          const vpComplex a0 = x[q + (stride * p)];
+          const vpComplex a1 = x[q + (stride * (p + m))];
+          const vpComplex a2 = x[q + (stride * (p + (2 * m)))];
+          const vpComplex a3 = x[q + (stride * (p + (3 * m)))];
+          const vpComplex t0 = a0 + a2, t1 = a0 - a2, t2 = a1 + a3, t3 = mulMinusI(a1 - a3);
+          vpComplex *dst = y + q + (stride * (4 * p));
+          dst[0] = t0 + t2;
+          dst[stride] = mul(t1 + t3, w1);
+          dst[2 * stride] = mul(t0 - t2, w2);
+          dst[3 * stride] = mul(t1 - t3, w3);
+        }
+      }
+    }
+    else {
+      // Generic butterfly: DFT of size radix with the roots of unity computed once per stage
+      a.resize(radix);
+      roots.resize(radix);
+      for (unsigned int k = 0; k < radix; ++k) {
+        const double angle = (-2.0 * M_PI * k) / radix;
+        roots[k] = vpComplex(std::cos(angle), std::sin(angle));
+      }
+      for (unsigned int p = 0; p < m; ++p) {
+        const vpComplex *w = twiddles + ((radix - 1) * p);
+        for (unsigned int q = 0; q < stride; ++q) {
+          for (unsigned int k = 0; k < radix; ++k) {
+            a[k] = x[q + (stride * (p + (k * m)))];
+          }
+          vpComplex *dst = y + q + (stride * (radix * p));
+          for (unsigned int k2 = 0; k2 < radix; ++k2) {
+            vpComplex b = a[0];
+            for (unsigned int k = 1; k < radix; ++k) {
+              b += mul(a[k], roots[(k * k2) % radix]);
+            }
+            dst[stride * k2] = (k2 == 0) ? b : mul(b, w[k2 - 1]);
+          }
+        }
+      }
+    }
+
+    twiddles += (radix - 1) * m;
+    std::swap(x, y);
+    length = m;
+    stride *= radix;
+  }
+
+  if (x != data) {
+    std::copy(x, x + m_n, data);
+  }
+}
+
+void vpFFT::inverse(std::complex<double> *data, std::complex<double> *work) const
+{
+  conjugate(data, m_n);
+  forward(data, work);
+  conjugate(data, m_n);
+}
+
+/*!
+  Smallest size greater than or equal to \e n whose prime factors are only 2, 3 and 5.
+ */
+unsigned int vpFFT::getOptimalSize(unsigned int n)
+{
+  unsigned int best = 1;
+  while (best < n) {
+    best *= 2;
+  }
+  for (unsigned int p5 = 1; p5 < best; p5 *= 5) {
+    for (unsigned int p35 = p5; p35 < best; p35 *= 3) {
+      unsigned int size = p35;
+      while (size < n) {
+        size *= 2;
+      }
+      best = std::min<unsigned int>(best, size);
+    }
+  }
+  return best;
+}
+
+void vp_crossCorrelation(const vpImage<double> &I, const vpImage<double> &I_tpl, vpImage<double> &I_corr,
+                         unsigned int nThreads)
+{
+  const unsigned int height = I.getHeight(), width = I.getWidth();
+  const unsigned int height_tpl = I_tpl.getHeight(), width_tpl = I_tpl.getWidth();
+  if ((height_tpl == 0) || (width_tpl == 0) || (height_tpl > height) || (width_tpl > width)) {
+    throw(vpException(vpException::dimensionError, "Cannot correlate a %dx%d image with a %dx%d template", width,
+                      height, width_tpl, height_tpl));
+  }
+
+  // The correlation at the valid positions does not wrap around the borders, no need to pad to H+h-1
+  const vpFFT fftRows(vpFFT::getOptimalSize(width));
+  const vpFFT fftCols(vpFFT::getOptimalSize(height));
+  const unsigned int N = fftCols.getSize(), M = fftRows.getSize();
+
+  // Image in the real part, template in the imaginary part
+  std::vector<vpComplex> Z(static_cast<size_t>(N) * M, vpComplex(0.0, 0.0));
+  for (unsigned int i = 0; i < height; ++i) {
+    vpComplex *row = &Z[static_cast<size_t>(i) * M];
+    for (unsigned int j = 0; j < width; ++j) {
+      row[j].real(I[i][j]);
+    }
+  }
+  for (unsigned int i = 0; i < height_tpl; ++i) {
+    vpComplex *row = &Z[static_cast<size_t>(i) * M];
+    for (unsigned int j = 0; j < width_tpl; ++j) {
+      row[j].imag(I_tpl[i][j]);
+    }
+  }
+
+  // Rows below the image are null and stay null
+  transformRows(&Z[0], height, fftRows, false, nThreads);
+  transformColumns(&Z[0], M, fftCols, false, nThreads);
+
+  // With Z = F(I) + i F(T): F(I)(k) = (Z(k) + conj(Z(-k))) / 2 and F(T)(k) = (Z(k) - conj(Z(-k))) / 2i.
+  // The product P = F(I) conj(F(T)) is the spectrum of a real signal: P(-k) = conj(P(k)).
+  const int halfN = static_cast<int>(N / 2);
+  setNumThreads(nThreads);
+#if defined(_OPENMP)
+#pragma omp parallel for
+#endif
+  for (int kAsInt = 0; kAsInt <= halfN; ++kAsInt) {
+    const unsigned int k = static_cast<unsigned int>(kAsInt);
+    const unsigned int k_opp = (N - k) % N;
+    vpComplex *row = &Z[static_cast<size_t>(k) * M];
+    vpComplex *row_opp = &Z[static_cast<size_t>(k_opp) * M];
+    for (unsigned int l = 0; l < M; ++l) {
+      const unsigned int l_opp = (M - l) % M;
+      if ((k == k_opp) && (l > l_opp)) {
+        continue;
+      }
+      const vpComplex z = row[l];
+      const vpComplex z_opp = std::conj(row_opp[l_opp]);
+      const vpComplex P = 0.25 * mul(vpComplex(0.0, 1.0), mul(z + z_opp, std::conj(z - z_opp)));
+      row[l] = P;
+      row_opp[l_opp] = std::conj(P);
+    }
+  }
+
+  const unsigned int height_corr = (height - height_tpl) + 1, width_corr = (width - width_tpl) + 1;
+  transformColumns(&Z[0], M, fftCols, true, nThreads);
+  transformRows(&Z[0], height_corr, fftRows, true, nThreads);
+
+  const double scale = 1.0 / (static_cast<double>(N) * M);
+  I_corr.resize(height_corr, width_corr);
+  for (unsigned int i = 0; i < height_corr; ++i) {
+    const vpComplex *row = &Z[static_cast<size_t>(i) * M];
+    for (unsigned int j = 0; j < width_corr; ++j) {
+      I_corr[i][j] = row[j].real() * scale;
+    }
+  }
+}
+END_VISP_NAMESPACE
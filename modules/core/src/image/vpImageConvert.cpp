@@ -38,6 +38,7 @@
 
 #include <map>
 #include <sstream>
+#include <vector>
 
 #if defined(_OPENMP)
 #include <omp.h>
@@ -50,6 +51,7 @@
 #include "private/vpBayerConversion.h"
 #endif
 #include "private/vpImageConvert_impl.h"
+#include "private/vpImageConvert_simd.h"
 #if defined(VISP_HAVE_SIMDLIB)
 #include <Simd/SimdLib.h>
 #endif
@@ -64,7 +66,7 @@ int vpImageConvert::vpCbb[256];
 
 /*!
   Convert a vpImage\<unsigned char\> to a vpImage\<vpRGBa\>.
-  Tha alpha component is set to vpRGBa::alpha_default.
+  The alpha component is set to vpRGBa::alpha_default.
   \param[in] src : Source image
   \param[out] dest : Destination image.
 
@@ -93,6 +95,54 @@ void vpImageConvert::convert(const vpImage<vpRGBa> &src, vpImage<unsigned char>
   RGBaToGrey(reinterpret_cast<unsigned char *>(src.bitmap), dest.bitmap, src.getWidth(), src.getHeight(), nThreads);
 }
 
+/*!
+  Convert a strided view over grey pixels, for example a region of interest
+  of a larger image or a camera buffer with padded rows, to a vpImage\<vpRGBa\>.
+  The alpha component is set to vpRGBa::alpha_default.
+  \param[in] src : Source image view.
+  \param[out] dest : Destination image.
+
+  \sa GreyToRGBa()
+*/
+void vpImageConvert::convert(const vpImageView<unsigned char> &src, vpImage<vpRGBa> &dest)
+{
+  dest.resize(src.getHeight(), src.getWidth());
+
+  if (src.isContinuous()) {
+    GreyToRGBa(src.data(), reinterpret_cast<unsigned char *>(dest.bitmap), src.getWidth(), src.getHeight());
+  }
+  else {
+    unsigned int height = src.getHeight();
+    for (unsigned int i = 0; i < height; ++i) {
+      GreyToRGBa(src[i], reinterpret_cast<unsigned char *>(dest[i]), src.getWidth());
+    }
+  }
+}
+
+/*!
+  Convert a strided view over color pixels, for example a region of interest
+  of a larger image or a camera buffer with padded rows, to a
+  vpImage\<unsigned char\>.
+  \param[in] src : Source image view.
+  \param[out] dest : Destination image.
+
+  \sa RGBaToGrey()
+*/
+void vpImageConvert::convert(const vpImageView<vpRGBa> &src, vpImage<unsigned char> &dest)
+{
+  dest.resize(src.getHeight(), src.getWidth());
+
+  if (src.isContinuous()) {
+    RGBaToGrey(reinterpret_cast<unsigned char *>(src.data()), dest.bitmap, src.getWidth() * src.getHeight());
+  }
+  else {
+    unsigned int height = src.getHeight();
+    for (unsigned int i = 0; i < height; ++i) {
+      RGBaToGrey(reinterpret_cast<unsigned char *>(src[i]), dest[i], src.getWidth());
+    }
+  }
+}
+
 /*!
   Convert a vpImage\<float\> to a vpImage\<unsigned char\> by renormalizing
   between 0 and 255.
@@ -338,17 +388,8 @@ void vpImageConvert::RGBToRGBa(unsigned char *rgb, unsigned char *rgba, unsigned
     // starting source address = last line if we need to flip the image
     unsigned char *src = flip ? (rgb + (width * height * 3) + lineStep) : rgb;
 
-    unsigned int j = 0;
-    unsigned int i = 0;
-
-    for (i = 0; i < height; ++i) {
-      unsigned char *line = src;
-      for (j = 0; j < width; ++j) {
-        *rgba++ = *(++line);
-        *rgba++ = *(++line);
-        *rgba++ = *(++line);
-        *rgba++ = vpRGBa::alpha_default;
-      }
+    for (unsigned int i = 0; i < height; ++i) {
+      vp_RGBToRGBa(src, rgba + (i * width * 4), width);
       // go to the next line
       src += lineStep;
     }
@@ -374,16 +415,7 @@ void vpImageConvert::RGBaToRGB(unsigned char *rgba, unsigned char *rgb, unsigned
 #if defined(VISP_HAVE_SIMDLIB)
   SimdBgraToBgr(rgba, size, 1, size * 4, rgb, size * 3);
 #else
-  unsigned char *pt_input = rgba;
-  unsigned char *pt_end = rgba + (4 * size);
-  unsigned char *pt_output = rgb;
-
-  while (pt_input != pt_end) {
-    *(++pt_output) = *(++pt_input); // R
-    *(++pt_output) = *(++pt_input); // G
-    *(++pt_output) = *(++pt_input); // B
-    ++pt_input;
-  }
+  vp_RGBaToRGB(rgba, rgb, size);
 #endif
 }
 
@@ -433,20 +465,8 @@ void vpImageConvert::RGBToGrey(unsigned char *rgb, unsigned char *grey, unsigned
     // starting source address = last line if we need to flip the image
     unsigned char *src = flip ? (rgb + (width * height * 3) + lineStep) : rgb;
 
-    unsigned int j = 0;
-    unsigned int i = 0;
-
-    unsigned r, g, b;
-
-    for (i = 0; i < height; ++i) {
-      unsigned char *line = src;
-      for (j = 0; j < width; ++j) {
-        r = *(++line);
-        g = *(++line);
-        b = *(++line);
-        *grey++ = static_cast<unsigned char>((0.2126 * r) + (0.7152 * g) + (0.0722 * b));
-      }
-
+    for (unsigned int i = 0; i < height; ++i) {
+      vp_RGBToGrey(src, grey + (i * width), width);
       // go to the next line
       src += lineStep;
     }
@@ -489,10 +509,16 @@ void vpImageConvert::RGBaToGrey(unsigned char *rgba, unsigned char *grey, unsign
     SimdRgbaToGray(rgba + (i * width * 4), width, 1, width * 4, grey + (i * width), width);
   }
 #else
+  const int heightAsInt = static_cast<int>(height);
 #if defined(_OPENMP)
-  (void)nThreads;
+  if (nThreads > 0) {
+    omp_set_num_threads(static_cast<int>(nThreads));
+  }
+#pragma omp parallel for
 #endif
-  vpImageConvert::RGBaToGrey(rgba, grey, width * height);
+  for (int i = 0; i < heightAsInt; ++i) {
+    vp_RGBaToGrey(rgba + (i * width * 4), grey + (i * width), width);
+  }
 #endif
 }
 
@@ -515,17 +541,7 @@ void vpImageConvert::RGBaToGrey(unsigned char *rgba, unsigned char *grey, unsign
 #if defined(VISP_HAVE_SIMDLIB)
   SimdRgbaToGray(rgba, size, 1, size * 4, grey, size);
 #else
-  const unsigned int val_2 = 2;
-  const unsigned int val_4 = 4;
-  unsigned char *pt_input = rgba;
-  unsigned char *pt_end = rgba + (size * 4);
-  unsigned char *pt_output = grey;
-
-  while (pt_input != pt_end) {
-    *pt_output = static_cast<unsigned char>((0.2126 * (*pt_input)) + (0.7152 * (*(pt_input + 1))) + (0.0722 * (*(pt_input + val_2))));
-    pt_input += val_4;
-    ++pt_output;
-  }
+  vp_RGBaToGrey(rgba, grey, size);
 #endif
 }
 
@@ -566,23 +582,7 @@ void vpImageConvert::GreyToRGBa(unsigned char *grey, unsigned char *rgba, unsign
 #if defined(VISP_HAVE_SIMDLIB)
   GreyToRGBa(grey, rgba, size, 1);
 #else
-  const unsigned int val_2 = 2;
-  const unsigned int val_3 = 3;
-  const unsigned int val_4 = 4;
-  unsigned char *pt_input = grey;
-  unsigned char *pt_end = grey + size;
-  unsigned char *pt_output = rgba;
-
-  while (pt_input != pt_end) {
-    unsigned char p = *pt_input;
-    *pt_output = p;                         // R
-    *(pt_output + 1) = p;                     // G
-    *(pt_output + val_2) = p;                     // B
-    *(pt_output + val_3) = vpRGBa::alpha_default; // A
-
-    ++pt_input;
-    pt_output += val_4;
-  }
+  vp_GreyToRGBa(grey, rgba, size);
 #endif
 }
 
@@ -645,23 +645,13 @@ void vpImageConvert::BGRToRGBa(unsigned char *bgr, unsigned char *rgba, unsigned
 #endif
     // if we have to flip the image, we start from the end last scanline so the
     // step is negative
-    const unsigned int val_2 = 2;
-    const unsigned int val_3 = 3;
     int lineStep = flip ? -static_cast<int>(width * 3) : static_cast<int>(width * 3);
 
     // starting source address = last line if we need to flip the image
     unsigned char *src = flip ? (bgr + (width * height * 3) + lineStep) : bgr;
 
     for (unsigned int i = 0; i < height; ++i) {
-      unsigned char *line = src;
-      for (unsigned int j = 0; j < width; ++j) {
-        *rgba++ = *(line + val_2);
-        *rgba++ = *(line + 1);
-        *rgba++ = *(line + 0);
-        *rgba++ = vpRGBa::alpha_default;
-
-        line += val_3;
-      }
+      vp_BGRToRGBa(src, rgba + (i * width * 4), width);
       // go to the next line
       src += lineStep;
     }
@@ -695,24 +685,13 @@ void vpImageConvert::BGRaToRGBa(unsigned char *bgra, unsigned char *rgba, unsign
 #endif
     // if we have to flip the image, we start from the end last scanline so the
     // step is negative
-    const unsigned int val_2 = 2;
-    const unsigned int val_3 = 3;
-    const unsigned int val_4 = 4;
     int lineStep = flip ? -static_cast<int>(width * 4) : static_cast<int>(width * 4);
 
     // starting source address = last line if we need to flip the image
-    unsigned char *src = flip ? (bgra + (width * height * val_4) + lineStep) : bgra;
+    unsigned char *src = flip ? (bgra + (width * height * 4) + lineStep) : bgra;
 
     for (unsigned int i = 0; i < height; ++i) {
-      unsigned char *line = src;
-      for (unsigned int j = 0; j < width; ++j) {
-        *rgba++ = *(line + val_2);
-        *rgba++ = *(line + 1);
-        *rgba++ = *(line + 0);
-        *rgba++ = *(line + val_3);
-
-        line += val_4;
-      }
+      vp_BGRaToRGBa(src, rgba + (i * width * 4), width);
       // go to the next line
       src += lineStep;
     }
@@ -743,7 +722,6 @@ void vpImageConvert::BGRToGrey(unsigned char *bgr, unsigned char *grey, unsigned
 #endif
 )
 {
-#if defined(VISP_HAVE_SIMDLIB)
   const int heightAsInt = static_cast<int>(height);
   if (!flip) {
 #if defined(_OPENMP)
@@ -753,36 +731,27 @@ void vpImageConvert::BGRToGrey(unsigned char *bgr, unsigned char *grey, unsigned
 #pragma omp parallel for
 #endif
     for (int i = 0; i < heightAsInt; ++i) {
+#if defined(VISP_HAVE_SIMDLIB)
       SimdBgrToGray(bgr + (i * width * 3), width, 1, width * 3, grey + (i * width), width);
+#else
+      vp_BGRToGrey(bgr + (i * width * 3), grey + (i * width), width);
+#endif
     }
   }
   else {
-#endif
     // if we have to flip the image, we start from the end last scanline so
     // the  step is negative
-    const unsigned int val_2 = 2;
-    const unsigned int val_3 = 3;
-    int lineStep = flip ? -static_cast<int>(width * 3) : static_cast<int>(width * 3);
+    int lineStep = -static_cast<int>(width * 3);
 
-    // starting source address = last line if we need to flip the image
-    unsigned char *src = flip ? (bgr + (width * height * 3) + lineStep) : bgr;
+    // starting source address = last line
+    unsigned char *src = bgr + (width * height * 3) + lineStep;
 
     for (unsigned int i = 0; i < height; ++i) {
-      unsigned char *line = src;
-      for (unsigned int j = 0; j < width; ++j) {
-        *grey++ = static_cast<unsigned int>((0.2126 * *(line + val_2)) + (0.7152 * *(line + 1)) + (0.0722 * *(line + 0)));
-        line += val_3;
-      }
-
+      vp_BGRToGrey(src, grey + (i * width), width);
       // go to the next line
       src += lineStep;
     }
-#if defined(VISP_HAVE_SIMDLIB)
   }
-#endif
-#if !defined(VISP_HAVE_SIMDLIB) && defined(_OPENMP)
-  (void)nThreads;
-#endif
 }
 
 /*!
@@ -807,9 +776,8 @@ void vpImageConvert::BGRaToGrey(unsigned char *bgra, unsigned char *grey, unsign
 #endif
 )
 {
-#if defined(VISP_HAVE_SIMDLIB)
+  const int heightAsInt = static_cast<int>(height);
   if (!flip) {
-    const int heightAsInt = static_cast<int>(height);
 #if defined(_OPENMP)
     if (nThreads > 0) {
       omp_set_num_threads(static_cast<int>(nThreads));
@@ -817,36 +785,27 @@ void vpImageConvert::BGRaToGrey(unsigned char *bgra, unsigned char *grey, unsign
 #pragma omp parallel for
 #endif
     for (int i = 0; i < heightAsInt; ++i) {
+#if defined(VISP_HAVE_SIMDLIB)
       SimdBgraToGray(bgra + (i * width * 4), width, 1, width * 4, grey + (i * width), width);
+#else
+      vp_BGRaToGrey(bgra + (i * width * 4), grey + (i * width), width);
+#endif
     }
   }
   else {
-#endif
     // if we have to flip the image, we start from the end last scanline so
     // the  step is negative
-    const unsigned int val_2 = 2;
-    const unsigned int val_4 = 4;
-    int lineStep = flip ? -static_cast<int>(width * 4) : static_cast<int>(width * 4);
+    int lineStep = -static_cast<int>(width * 4);
 
-    // starting source address = last line if we need to flip the image
-    unsigned char *src = flip ? (bgra + (width * height * 4) + lineStep) : bgra;
+    // starting source address = last line
+    unsigned char *src = bgra + (width * height * 4) + lineStep;
 
     for (unsigned int i = 0; i < height; ++i) {
-      unsigned char *line = src;
-      for (unsigned int j = 0; j < width; ++j) {
-        *grey++ = static_cast<unsigned char>((0.2126 * *(line + val_2)) + (0.7152 * *(line + 1)) + (0.0722 * *(line + 0)));
-        line += val_4;
-      }
-
+      vp_BGRaToGrey(src, grey + (i * width), width);
       // go to the next line
       src += lineStep;
     }
-#if defined(VISP_HAVE_SIMDLIB)
   }
-#endif
-#if !defined(VISP_HAVE_SIMDLIB) && defined(_OPENMP)
-  (void)nThreads;
-#endif
 }
 
 /*!
@@ -1189,7 +1148,6 @@ void vpImageConvert::YCrCbToRGBa(unsigned char *ycrcb, unsigned char *rgba, unsi
 void vpImageConvert::split(const vpImage<vpRGBa> &src, vpImage<unsigned char> *pR, vpImage<unsigned char> *pG,
                            vpImage<unsigned char> *pB, vpImage<unsigned char> *pa)
 {
-#if defined(VISP_HAVE_SIMDLIB)
   if (src.getSize() > 0) {
     if (pR) {
       pR->resize(src.getHeight(), src.getWidth());
@@ -1204,86 +1162,24 @@ void vpImageConvert::split(const vpImage<vpRGBa> &src, vpImage<unsigned char> *p
       pa->resize(src.getHeight(), src.getWidth());
     }
 
-    unsigned char *ptrR = pR ? pR->bitmap : new unsigned char[src.getSize()];
-    unsigned char *ptrG = pG ? pG->bitmap : new unsigned char[src.getSize()];
-    unsigned char *ptrB = pB ? pB->bitmap : new unsigned char[src.getSize()];
-    unsigned char *ptrA = pa ? pa->bitmap : new unsigned char[src.getSize()];
+    // Channels that are not requested are written to the same scratch buffer
+    std::vector<unsigned char> scratch;
+    if ((!pR) || (!pG) || (!pB) || (!pa)) {
+      scratch.resize(src.getSize());
+    }
+    unsigned char *ptrR = pR ? pR->bitmap : scratch.data();
+    unsigned char *ptrG = pG ? pG->bitmap : scratch.data();
+    unsigned char *ptrB = pB ? pB->bitmap : scratch.data();
+    unsigned char *ptrA = pa ? pa->bitmap : scratch.data();
 
+#if defined(VISP_HAVE_SIMDLIB)
     SimdDeinterleaveBgra(reinterpret_cast<unsigned char *>(src.bitmap), src.getWidth() * sizeof(vpRGBa), src.getWidth(),
                          src.getHeight(), ptrR, src.getWidth(), ptrG, src.getWidth(), ptrB, src.getWidth(), ptrA,
                          src.getWidth());
-
-    if (!pR) {
-      delete[] ptrR;
-    }
-    if (!pG) {
-      delete[] ptrG;
-    }
-    if (!pB) {
-      delete[] ptrB;
-    }
-    if (!pa) {
-      delete[] ptrA;
-    }
-  }
 #else
-  size_t n = src.getNumberOfPixel();
-  unsigned int height = src.getHeight();
-  unsigned int width = src.getWidth();
-  unsigned char *input;
-  unsigned char *dst;
-  const unsigned int index_0 = 0;
-  const unsigned int index_1 = 1;
-  const unsigned int index_2 = 2;
-  const unsigned int index_3 = 3;
-
-  vpImage<unsigned char> *tabChannel[4];
-
-  tabChannel[index_0] = pR;
-  tabChannel[index_1] = pG;
-  tabChannel[index_2] = pB;
-  tabChannel[index_3] = pa;
-
-  size_t i; /* ordre    */
-  const unsigned int val_3 = 3;
-  const unsigned int val_4 = 4;
-  for (unsigned int j = 0; j < val_4; ++j) {
-    if (tabChannel[j] != nullptr) {
-      if ((tabChannel[j]->getHeight() != height) || (tabChannel[j]->getWidth() != width)) {
-        tabChannel[j]->resize(height, width);
-      }
-      dst = static_cast<unsigned char *>(tabChannel[j]->bitmap);
-
-      input = (unsigned char *)src.bitmap + j;
-      i = 0;
-      // optimization
-      if (n >= val_4) {
-        n -= val_3;
-        for (; i < n; i += val_4) {
-          *dst = *input;
-          input += val_4;
-          ++dst;
-          *dst = *input;
-          input += val_4;
-          ++dst;
-          *dst = *input;
-          input += val_4;
-          ++dst;
-          *dst = *input;
-          input += val_4;
-          ++dst;
-        }
-        n += val_3;
-      }
-
-      for (; i < n; ++i) {
-        *dst = *input;
-        input += val_4;
-        ++dst;
-      }
-    }
-  }
+    vp_splitRGBa(reinterpret_cast<unsigned char *>(src.bitmap), ptrR, ptrG, ptrB, ptrA, src.getSize());
 #endif
+  }
 }
 
 /*!
@@ -1294,7 +1190,8 @@ void vpImageConvert::split(const vpImage<vpRGBa> &src, vpImage<unsigned char> *p
   \param[in] a : Alpha channel.
   \param[out] RGBa : Destination RGBa image. Image is resized internally if needed.
 
-  \note If R, G, B, a are provided, the SIMD lib is used to accelerate processing on x86 and ARM architecture.
+  \note If R, G, B, a are provided, the SIMD lib or vectorized kernels are used to accelerate processing on x86 and ARM
+  architecture.
 */
 void vpImageConvert::merge(const vpImage<unsigned char> *R, const vpImage<unsigned char> *G,
                            const vpImage<unsigned char> *B, const vpImage<unsigned char> *a, vpImage<vpRGBa> &RGBa)
@@ -1328,13 +1225,16 @@ void vpImageConvert::merge(const vpImage<unsigned char> *R, const vpImage<unsign
     RGBa.resize(height, width);
 
 
-#if defined(VISP_HAVE_SIMDLIB)
     if ((R != nullptr) && (G != nullptr) && (B != nullptr) && (a != nullptr)) {
+#if defined(VISP_HAVE_SIMDLIB)
       SimdInterleaveBgra(R->bitmap, width, G->bitmap, width, B->bitmap, width, a->bitmap, width, width, height,
                          reinterpret_cast<uint8_t *>(RGBa.bitmap), width * sizeof(vpRGBa));
+#else
+      vp_mergeRGBa(R->bitmap, G->bitmap, B->bitmap, a->bitmap, reinterpret_cast<unsigned char *>(RGBa.bitmap),
+                   width * height);
+#endif
     }
     else {
-#endif
       unsigned int size = width * height;
       for (unsigned int i = 0; i < size; ++i) {
         if (R != nullptr) {
@@ -1353,9 +1253,7 @@ void vpImageConvert::merge(const vpImage<unsigned char> *R, const vpImage<unsign
           RGBa.bitmap[i].A = a->bitmap[i];
         }
       }
-#if defined(VISP_HAVE_SIMDLIB)
     }
-#endif
   }
   else {
     throw vpException(vpException::dimensionError, "Mismatched dimensions!");
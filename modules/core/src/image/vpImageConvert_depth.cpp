@@ -0,0 +1,263 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2024 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ *
+ * Description:
+ * Depth image to organized point cloud conversion.
+ */
+
+/*!
+  \file vpImageConvert_depth.cpp
+  \brief Depth image to organized point cloud conversion.
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <visp3/core/vpCameraParameters.h>
+#include <visp3/core/vpImageConvert.h>
+#include <visp3/core/vpImageException.h>
+#include <visp3/core/vpPixelMeterConversion.h>
+
+#include "private/vpImageConvert_simd.h"
+
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+
+BEGIN_VISP_NAMESPACE
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace
+{
+inline unsigned int unprojectRow(const uint16_t *depth, float depth_scale, const float *x, float y, float Z_min,
+                                 float Z_max, float *X, float *Y, float *Z, unsigned int size)
+{
+  return vp_depthToPoints(depth, depth_scale, x, y, Z_min, Z_max, X, Y, Z, size);
+}
+
+inline unsigned int unprojectRow(const float *depth, float /*depth_scale*/, const float *x, float y, float Z_min,
+                                 float Z_max, float *X, float *Y, float *Z, unsigned int size)
+{
+  return vp_depthToPoints(depth, x, y, Z_min, Z_max, X, Y, Z, size);
+}
+
+// Same operations as the vectorized kernels to get the same coordinates
+template <typename DepthType>
+inline bool unprojectPoint(DepthType depth, float depth_scale, float x, float y, float Z_min, float Z_max, float &X,
+                           float &Y, float &Z)
+{
+  float z = static_cast<float>(depth) * depth_scale;
+  const bool valid = (z > Z_min) && (z < Z_max);
+  if (!valid) {
+    z = 0.f;
+  }
+  X = x * z;
+  Y = y * z;
+  Z = z;
+  return valid;
+}
+
+template <typename DepthType>
+unsigned int unprojectDepth(const vpImage<DepthType> &depth, float depth_scale, const vpCameraParameters &cam_depth,
+                            vpPointCloud &pointcloud, const vpImage<unsigned char> *depth_mask, float Z_min,
+                            float Z_max, unsigned int decimation, const vpRect &roi, unsigned int nThreads)
+{
+  const unsigned int height = depth.getHeight();
+  const unsigned int width = depth.getWidth();
+  if (depth_mask && ((depth_mask->getHeight() != height) || (depth_mask->getWidth() != width))) {
+    throw(vpImageException(vpImageException::notInitializedError, "Depth image and mask size differ"));
+  }
+  if (decimation == 0) {
+    throw(vpException(vpException::badValue, "The decimation factor must be strictly positive"));
+  }
+
+  pointcloud.resize(height, width);
+
+  // Same rounding as vpImageView for the region of interest
+  unsigned int i_min = 0, i_max = height, j_min = 0, j_max = width;
+  if (roi.getArea() > 0) {
+    // Bounds clamped to the image, a region outside the image being empty
+    i_min = static_cast<unsigned int>(std::max<int>(std::min<int>(static_cast<int>(ceil(roi.getTop())), static_cast<int>(height)), 0));
+    j_min = static_cast<unsigned int>(std::max<int>(std::min<int>(static_cast<int>(ceil(roi.getLeft())), static_cast<int>(width)), 0));
+    i_max = static_cast<unsigned int>(std::max<int>(std::min<int>(static_cast<int>(ceil(roi.getTop() + roi.getHeight())), static_cast<int>(height)), 0));
+    j_max = static_cast<unsigned int>(std::max<int>(std::min<int>(static_cast<int>(ceil(roi.getLeft() + roi.getWidth())), static_cast<int>(width)), 0));
+    i_max = std::max<unsigned int>(i_min, i_max);
+    j_max = std::max<unsigned int>(j_min, j_max);
+  }
+
+  // Normalized x coordinate of each column, the y coordinate being computed once per row
+  const bool undistort = (cam_depth.get_projModel() != vpCameraParameters::perspectiveProjWithoutDistortion);
+  std::vector<float> x_col(undistort ? 0 : width);
+  for (unsigned int j = 0; j < x_col.size(); ++j) {
+    x_col[j] = static_cast<float>((j - cam_depth.get_u0()) * cam_depth.get_px_inverse());
+  }
+
+  float *X = pointcloud.getX();
+  float *Y = pointcloud.getY();
+  float *Z = pointcloud.getZ();
+  const int heightAsInt = static_cast<int>(height);
+  unsigned int nbValidPoints = 0;
+#if defined(_OPENMP)
+  if (nThreads > 0) {
+    omp_set_num_threads(static_cast<int>(nThreads));
+  }
+#pragma omp parallel for reduction(+:nbValidPoints)
+#else
+  (void)nThreads;
+#endif
+  for (int iAsInt = 0; iAsInt < heightAsInt; ++iAsInt) {
+    const unsigned int i = static_cast<unsigned int>(iAsInt);
+    const unsigned int offset = i * width;
+    float *X_row = X + offset;
+    float *Y_row = Y + offset;
+    float *Z_row = Z + offset;
+
+    if ((i < i_min) || (i >= i_max) || (((i - i_min) % decimation) != 0)) {
+      std::fill(X_row, X_row + width, 0.f);
+      std::fill(Y_row, Y_row + width, 0.f);
+      std::fill(Z_row, Z_row + width, 0.f);
+      continue;
+    }
+
+    const DepthType *depth_row = depth[i];
+    unsigned int nbValid = 0;
+    if ((decimation == 1) && !undistort) {
+      std::fill(X_row, X_row + j_min, 0.f);
+      std::fill(Y_row, Y_row + j_min, 0.f);
+      std::fill(Z_row, Z_row + j_min, 0.f);
+      std::fill(X_row + j_max, X_row + width, 0.f);
+      std::fill(Y_row + j_max, Y_row + width, 0.f);
+      std::fill(Z_row + j_max, Z_row + width, 0.f);
+      const float y = static_cast<float>((i - cam_depth.get_v0()) * cam_depth.get_py_inverse());
+      nbValid = unprojectRow(depth_row + j_min, depth_scale, x_col.data() + j_min, y, Z_min, Z_max, X_row + j_min,
+                             Y_row + j_min, Z_row + j_min, j_max - j_min);
+    }
+    else {
+      std::fill(X_row, X_row + width, 0.f);
+      std::fill(Y_row, Y_row + width, 0.f);
+      std::fill(Z_row, Z_row + width, 0.f);
+      for (unsigned int j = j_min; j < j_max; j += decimation) {
+        double x = 0., y = 0.;
+        if (undistort) {
+          vpPixelMeterConversion::convertPoint(cam_depth, static_cast<double>(j), static_cast<double>(i), x, y);
+        }
+        else {
+          x = x_col[j];
+          y = (i - cam_depth.get_v0()) * cam_depth.get_py_inverse();
+        }
+        if (unprojectPoint(depth_row[j], depth_scale, static_cast<float>(x), static_cast<float>(y), Z_min, Z_max,
+                           X_row[j], Y_row[j], Z_row[j])) {
+          ++nbValid;
+        }
+      }
+    }
+
+    if (depth_mask) {
+      const unsigned char *mask_row = (*depth_mask)[i];
+      for (unsigned int j = j_min; j < j_max; j += decimation) {
+        if ((mask_row[j] == 0) && (Z_row[j] > 0.f)) {
+          X_row[j] = 0.f;
+          Y_row[j] = 0.f;
+          Z_row[j] = 0.f;
+          --nbValid;
+        }
+      }
+    }
+    nbValidPoints += nbValid;
+  }
+
+  pointcloud.setNumberOfValidPoints(nbValidPoints);
+  return nbValidPoints;
+}
+} // namespace
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+/*!
+ * Create an organized point cloud from a depth image, without any third-party library.
+ *
+ * The point at index `i * depth_raw.getWidth() + j` of `pointcloud` is reconstructed from the pixel \f$(i, j)\f$.
+ * Points that are not reconstructed, since they are outside the region of interest, not on the decimation grid,
+ * outside the depth mask or with a Z value outside ]Z_min, Z_max[, have their coordinates set to 0.
+ *
+ * The unprojection is vectorized with SSE4.1, AVX2 or NEON instructions depending on the CPU, and rows
+ * are processed in parallel when OpenMP is available. When the camera parameters have distortion
+ * coefficients, each pixel is undistorted with vpPixelMeterConversion::convertPoint().
+ *
+ * \param[in] depth_raw : Depth raw image.
+ * \param[in] depth_scale : Depth scale to apply to data in `depth_raw` to get meters.
+ * \param[in] cam_depth : Depth camera intrinsics.
+ * \param[out] pointcloud : Computed organized point cloud, resized to the size of `depth_raw`. Its memory is kept
+ * between calls when the depth image size does not change.
+ * \param[in] depth_mask : Optional depth mask. When set to nullptr, all the pixels in `depth_raw` are considered.
+ * Otherwise, we consider only pixels that have a mask value that differ from 0. Its size must be the same as
+ * `depth_raw` size.
+ * \param[in] Z_min : Min Z value to retain the 3D point in the point cloud.
+ * \param[in] Z_max : Max Z value to retain the 3D point in the point cloud.
+ * \param[in] decimation : Only one pixel over `decimation` pixels along the rows and the columns is considered,
+ * starting from the top left corner of the region of interest.
+ * \param[in] roi : Region of interest. When empty, the whole image is considered.
+ * \param[in] nThreads : Number of threads to use when OpenMP is available. When 0, the OpenMP default is used.
+ *
+ * \return The number of valid points, also available with vpPointCloud::getNumberOfValidPoints().
+ */
+unsigned int vpImageConvert::depthToPointCloud(const vpImage<uint16_t> &depth_raw, float depth_scale,
+                                               const vpCameraParameters &cam_depth, vpPointCloud &pointcloud,
+                                               const vpImage<unsigned char> *depth_mask, float Z_min, float Z_max,
+                                               unsigned int decimation, const vpRect &roi, unsigned int nThreads)
+{
+  return unprojectDepth(depth_raw, depth_scale, cam_depth, pointcloud, depth_mask, Z_min, Z_max, decimation, roi,
+                        nThreads);
+}
+
+/*!
+ * Create an organized point cloud from a depth image in meter, without any third-party library.
+ *
+ * \param[in] depth : Depth image in meter.
+ * \param[in] cam_depth : Depth camera intrinsics.
+ * \param[out] pointcloud : Computed organized point cloud.
+ * \param[in] depth_mask : Optional depth mask.
+ * \param[in] Z_min : Min Z value to retain the 3D point in the point cloud.
+ * \param[in] Z_max : Max Z value to retain the 3D point in the point cloud.
+ * \param[in] decimation : Only one pixel over `decimation` pixels along the rows and the columns is considered.
+ * \param[in] roi : Region of interest. When empty, the whole image is considered.
+ * \param[in] nThreads : Number of threads to use when OpenMP is available. When 0, the OpenMP default is used.
+ *
+ * \return The number of valid points.
+ *
+ * \sa depthToPointCloud(const vpImage<uint16_t> &, float, const vpCameraParameters &, vpPointCloud &, const vpImage<unsigned char> *, float, float, unsigned int, const vpRect &, unsigned int)
+ */
+unsigned int vpImageConvert::depthToPointCloud(const vpImage<float> &depth, const vpCameraParameters &cam_depth,
+                                               vpPointCloud &pointcloud, const vpImage<unsigned char> *depth_mask,
+                                               float Z_min, float Z_max, unsigned int decimation, const vpRect &roi,
+                                               unsigned int nThreads)
+{
+  return unprojectDepth(depth, 1.f, cam_depth, pointcloud, depth_mask, Z_min, Z_max, decimation, roi, nThreads);
+}
+END_VISP_NAMESPACE
@@ -0,0 +1,1397 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2024 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ *
+ * Description:
+ * Vectorized color conversion and depth unprojection kernels.
+ */
+
+/*!
+  \file vpImageConvert_simd.cpp
+  \brief Color conversion and depth unprojection kernels dispatched at runtime to SSE4.1, AVX2 or NEON code.
+*/
+
+#include <visp3/core/vpConfig.h>
+#include <visp3/core/vpCPUFeatures.h>
+#include <visp3/core/vpRGBa.h>
+
+#include "private/vpImageConvert_simd.h"
+
+// Vectorized code is compiled for a given instruction set with function attributes, so that the dispatch is done at
+// runtime whatever the compilation flags
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__clang__) || (defined(__GNUC__) && (__GNUC__ >= 5)))
+#include <immintrin.h>
+#define VP_COLOR_CONVERSION_X86 1
+#define VP_TARGET_SSE41 __attribute__((target("sse4.1")))
+#define VP_TARGET_AVX2 __attribute__((target("avx2")))
+#elif defined(_MSC_VER) && (defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)))
+#include <immintrin.h>
+#define VP_COLOR_CONVERSION_X86 1
+#define VP_TARGET_SSE41
+#define VP_TARGET_AVX2
+#elif defined _WIN32 && defined(_M_ARM64)
+#define _ARM64_DISTINCT_NEON_TYPES
+#include <Intrin.h>
+#include <arm_neon.h>
+#define VP_COLOR_CONVERSION_NEON 1
+#elif (defined(__ARM_NEON__) || defined (__ARM_NEON)) && defined(__aarch64__)
+#include <arm_neon.h>
+#define VP_COLOR_CONVERSION_NEON 1
+#endif
+
+BEGIN_VISP_NAMESPACE
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace
+{
+enum vpSimdLevel
+{
+  SIMD_NONE,
+  SIMD_SSE41,
+  SIMD_AVX2,
+  SIMD_NEON
+};
+
+vpSimdLevel detectSimdLevel()
+{
+  vpSimdLevel level = SIMD_NONE;
+#if defined(VP_COLOR_CONVERSION_X86)
+  if (vpCPUFeatures::checkAVX2()) {
+    level = SIMD_AVX2;
+  }
+  else if (vpCPUFeatures::checkSSE41()) {
+    level = SIMD_SSE41;
+  }
+#elif defined(VP_COLOR_CONVERSION_NEON)
+  // NEON is mandatory on 64-bit ARM
+  level = SIMD_NEON;
+#endif
+  return level;
+}
+
+vpSimdLevel getSimdLevel()
+{
+  static const vpSimdLevel level = detectSimdLevel();
+  return level;
+}
+
+// Rec. 709 luma coefficients in 14 bits fixed point, that sum to 1 << greyShift. The result is rounded to the nearest
+// value, whereas the former floating point code truncated it
+const unsigned int greyShift = 14;
+const unsigned int greyRound = 1 << (greyShift - 1);
+const unsigned int greyWeightR = 3483;
+const unsigned int greyWeightG = 11718;
+const unsigned int greyWeightB = 1183;
+
+// YUV 4:2:2 and 4:2:0 chroma factors 0.354 and 0.707 in 16 bits fixed point. Truncated products are the same as in
+// floating point for every chroma value
+const unsigned short chromaFactorU = 23200;
+const unsigned short chromaFactorV = 46334;
+
+//----------------------------------------------------------------------------------------------------------------------
+// Scalar code
+//----------------------------------------------------------------------------------------------------------------------
+inline unsigned char greyValue(unsigned int r, unsigned int g, unsigned int b)
+{
+  return static_cast<unsigned char>(((greyWeightR * r) + (greyWeightG * g) + (greyWeightB * b) + greyRound) >> greyShift);
+}
+
+inline unsigned char saturate(int c)
+{
+  const int val_255 = 255;
+  return static_cast<unsigned char>((c < 0) ? 0 : ((c > val_255) ? val_255 : c));
+}
+
+template <unsigned int nChannels, bool bgr>
+void colorToGreyScalar(const unsigned char *src, unsigned char *grey, unsigned int size)
+{
+  const unsigned int iR = bgr ? 2 : 0;
+  const unsigned int iB = bgr ? 0 : 2;
+  for (unsigned int i = 0; i < size; ++i) {
+    grey[i] = greyValue(src[iR], src[1], src[iB]);
+    src += nChannels;
+  }
+}
+
+void GreyToRGBaScalar(const unsigned char *grey, unsigned char *rgba, unsigned int size)
+{
+  for (unsigned int i = 0; i < size; ++i) {
+    rgba[0] = grey[i];
+    rgba[1] = grey[i];
+    rgba[2] = grey[i];
+    rgba[3] = vpRGBa::alpha_default;
+    rgba += 4;
+  }
+}
+
+template <unsigned int nChannels, bool bgr>
+void colorToRGBaScalar(const unsigned char *src, unsigned char *rgba, unsigned int size)
+{
+  const unsigned int iR = bgr ? 2 : 0;
+  const unsigned int iB = bgr ? 0 : 2;
+  for (unsigned int i = 0; i < size; ++i) {
+    rgba[0] = src[iR];
+    rgba[1] = src[1];
+    rgba[2] = src[iB];
+    rgba[3] = (nChannels == 4) ? src[3] : static_cast<unsigned char>(vpRGBa::alpha_default);
+    src += nChannels;
+    rgba += 4;
+  }
+}
+
+void RGBaToRGBScalar(const unsigned char *rgba, unsigned char *rgb, unsigned int size)
+{
+  for (unsigned int i = 0; i < size; ++i) {
+    rgb[0] = rgba[0];
+    rgb[1] = rgba[1];
+    rgb[2] = rgba[2];
+    rgba += 4;
+    rgb += 3;
+  }
+}
+
+void splitRGBaScalar(const unsigned char *rgba, unsigned char *R, unsigned char *G, unsigned char *B,
+                     unsigned char *A, unsigned int size)
+{
+  for (unsigned int i = 0; i < size; ++i) {
+    R[i] = rgba[0];
+    G[i] = rgba[1];
+    B[i] = rgba[2];
+    A[i] = rgba[3];
+    rgba += 4;
+  }
+}
+
+void mergeRGBaScalar(const unsigned char *R, const unsigned char *G, const unsigned char *B, const unsigned char *A,
+                     unsigned char *rgba, unsigned int size)
+{
+  for (unsigned int i = 0; i < size; ++i) {
+    rgba[0] = R[i];
+    rgba[1] = G[i];
+    rgba[2] = B[i];
+    rgba[3] = A[i];
+    rgba += 4;
+  }
+}
+
+void YUYVToRGBaScalar(const unsigned char *yuyv, unsigned char *rgba, unsigned int size)
+{
+  const int val_128 = 128;
+  const int val_256 = 256;
+  for (unsigned int i = 0; i < size; i += 2) {
+    const int y0 = yuyv[0], u = yuyv[1] - val_128, y1 = yuyv[2], v = yuyv[3] - val_128;
+    const int cb = (u * 454) / val_256;
+    const int cg = ((u * 88) + (v * 183)) / val_256;
+    const int cr = (v * 359) / val_256;
+
+    rgba[0] = saturate(y0 + cr);
+    rgba[1] = saturate(y0 - cg);
+    rgba[2] = saturate(y0 + cb);
+    rgba[3] = vpRGBa::alpha_default;
+    rgba[4] = saturate(y1 + cr);
+    rgba[5] = saturate(y1 - cg);
+    rgba[6] = saturate(y1 + cb);
+    rgba[7] = vpRGBa::alpha_default;
+    yuyv += 4;
+    rgba += 8;
+  }
+}
+
+inline int chromaU(unsigned char u) { return static_cast<int>((static_cast<int>(u) - 128) * 0.354); }
+
+inline int chromaV(unsigned char v) { return static_cast<int>((static_cast<int>(v) - 128) * 0.707); }
+
+// R = Y + 1.402 V, G = Y - 0.344 U - 0.714 V, B = Y + 1.772 U with the approximations U = 0.354 U', V = 0.707 V'
+inline void YUVToRGBa(int y, int U, int V, unsigned char *rgba)
+{
+  rgba[0] = saturate(y + (2 * V));
+  rgba[1] = saturate(y - U - V);
+  rgba[2] = saturate(y + (5 * U));
+  rgba[3] = vpRGBa::alpha_default;
+}
+
+void UYVYToRGBaScalar(const unsigned char *uyvy, unsigned char *rgba, unsigned int size)
+{
+  for (unsigned int i = 0; i < size; i += 2) {
+    const int U = chromaU(uyvy[0]);
+    const int V = chromaV(uyvy[2]);
+    YUVToRGBa(uyvy[1], U, V, rgba);
+    YUVToRGBa(uyvy[3], U, V, rgba + 4);
+    uyvy += 4;
+    rgba += 8;
+  }
+}
+
+void YUV420ToRGBaScalar(const unsigned char *y0, const unsigned char *y1, const unsigned char *u,
+                        const unsigned char *v, unsigned char *rgba0, unsigned char *rgba1, unsigned int width)
+{
+  for (unsigned int j = 0; j < width; j += 2) {
+    const int U = chromaU(u[j / 2]);
+    const int V = chromaV(v[j / 2]);
+    YUVToRGBa(y0[j], U, V, rgba0 + (4 * j));
+    YUVToRGBa(y0[j + 1], U, V, rgba0 + (4 * j) + 4);
+    YUVToRGBa(y1[j], U, V, rgba1 + (4 * j));
+    YUVToRGBa(y1[j + 1], U, V, rgba1 + (4 * j) + 4);
+  }
+}
+
+template <typename DepthType>
+unsigned int depthToPointsScalar(const DepthType *depth, float depth_scale, const float *x, float y, float Z_min,
+                                 float Z_max, float *X, float *Y, float *Z, unsigned int size)
+{
+  unsigned int nbValid = 0;
+  for (unsigned int j = 0; j < size; ++j) {
+    float z = static_cast<float>(depth[j]) * depth_scale;
+    if ((z > Z_min) && (z < Z_max)) {
+      ++nbValid;
+    }
+    else {
+      z = 0.f;
+    }
+    X[j] = x[j] * z;
+    Y[j] = y * z;
+    Z[j] = z;
+  }
+  return nbValid;
+}
+
+#if defined(VP_COLOR_CONVERSION_X86)
+//----------------------------------------------------------------------------------------------------------------------
+// SSE4.1 code, each function returns the number of pixels that were converted
+//----------------------------------------------------------------------------------------------------------------------
+VP_TARGET_SSE41 inline __m128i greySumsSSE41(__m128i px, __m128i weights)
+{
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i lo = _mm_madd_epi16(_mm_unpacklo_epi8(px, zero), weights);
+  const __m128i hi = _mm_madd_epi16(_mm_unpackhi_epi8(px, zero), weights);
+  return _mm_hadd_epi32(lo, hi);
+}
+
+VP_TARGET_SSE41 inline __m128i greyPackSSE41(__m128i s0, __m128i s1, __m128i s2, __m128i s3)
+{
+  const __m128i round = _mm_set1_epi32(greyRound);
+  s0 = _mm_srli_epi32(_mm_add_epi32(s0, round), greyShift);
+  s1 = _mm_srli_epi32(_mm_add_epi32(s1, round), greyShift);
+  s2 = _mm_srli_epi32(_mm_add_epi32(s2, round), greyShift);
+  s3 = _mm_srli_epi32(_mm_add_epi32(s3, round), greyShift);
+  return _mm_packus_epi16(_mm_packus_epi32(s0, s1), _mm_packus_epi32(s2, s3));
+}
+
+VP_TARGET_SSE41 inline __m128i greyWeightsSSE41(bool bgr)
+{
+  const short w0 = static_cast<short>(bgr ? greyWeightB : greyWeightR);
+  const short w1 = static_cast<short>(greyWeightG);
+  const short w2 = static_cast<short>(bgr ? greyWeightR : greyWeightB);
+  return _mm_setr_epi16(w0, w1, w2, 0, w0, w1, w2, 0);
+}
+
+// Interleave 16 pixels of each channel
+VP_TARGET_SSE41 inline void storeRGBaSSE41(__m128i R, __m128i G, __m128i B, __m128i A, unsigned char *rgba)
+{
+  const __m128i rgLo = _mm_unpacklo_epi8(R, G);
+  const __m128i rgHi = _mm_unpackhi_epi8(R, G);
+  const __m128i baLo = _mm_unpacklo_epi8(B, A);
+  const __m128i baHi = _mm_unpackhi_epi8(B, A);
+  __m128i *dst = reinterpret_cast<__m128i *>(rgba);
+  _mm_storeu_si128(dst, _mm_unpacklo_epi16(rgLo, baLo));
+  _mm_storeu_si128(dst + 1, _mm_unpackhi_epi16(rgLo, baLo));
+  _mm_storeu_si128(dst + 2, _mm_unpacklo_epi16(rgHi, baHi));
+  _mm_storeu_si128(dst + 3, _mm_unpackhi_epi16(rgHi, baHi));
+}
+
+VP_TARGET_SSE41 inline __m128i alphaMaskSSE41()
+{
+  return _mm_set1_epi32(static_cast<int>(static_cast<unsigned int>(vpRGBa::alpha_default) << 24));
+}
+
+template <bool bgr>
+VP_TARGET_SSE41 unsigned int RGBaToGreySSE41(const unsigned char *src, unsigned char *grey, unsigned int size)
+{
+  const __m128i weights = greyWeightsSSE41(bgr);
+  unsigned int i = 0;
+  for (; (i + 16) <= size; i += 16) {
+    const __m128i *p = reinterpret_cast<const __m128i *>(src + (4 * i));
+    const __m128i s0 = greySumsSSE41(_mm_loadu_si128(p), weights);
+    const __m128i s1 = greySumsSSE41(_mm_loadu_si128(p + 1), weights);
+    const __m128i s2 = greySumsSSE41(_mm_loadu_si128(p + 2), weights);
+    const __m128i s3 = greySumsSSE41(_mm_loadu_si128(p + 3), weights);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(grey + i), greyPackSSE41(s0, s1, s2, s3));
+  }
+  return i;
+}
+
+VP_TARGET_SSE41 inline __m128i loadRGBxSSE41(const unsigned char *p)
+{
+  const __m128i toRGBx = _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+  return _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p)), toRGBx);
+}
+
+template <bool bgr>
+VP_TARGET_SSE41 unsigned int RGBToGreySSE41(const unsigned char *src, unsigned char *grey, unsigned int size)
+{
+  const __m128i weights = greyWeightsSSE41(bgr);
+  unsigned int i = 0;
+  // The last load of 16 bytes reads 4 bytes after the 16 pixels
+  for (; (i + 18) <= size; i += 16) {
+    const unsigned char *p = src + (3 * i);
+    const __m128i s0 = greySumsSSE41(loadRGBxSSE41(p), weights);
+    const __m128i s1 = greySumsSSE41(loadRGBxSSE41(p + 12), weights);
+    const __m128i s2 = greySumsSSE41(loadRGBxSSE41(p + 24), weights);
+    const __m128i s3 = greySumsSSE41(loadRGBxSSE41(p + 36), weights);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(grey + i), greyPackSSE41(s0, s1, s2, s3));
+  }
+  return i;
+}
+
+VP_TARGET_SSE41 unsigned int GreyToRGBaSSE41(const unsigned char *grey, unsigned char *rgba, unsigned int size)
+{
+  const __m128i alpha = alphaMaskSSE41();
+  const __m128i m0 = _mm_setr_epi8(0, 0, 0, -1, 1, 1, 1, -1, 2, 2, 2, -1, 3, 3, 3, -1);
+  const __m128i m1 = _mm_setr_epi8(4, 4, 4, -1, 5, 5, 5, -1, 6, 6, 6, -1, 7, 7, 7, -1);
+  const __m128i m2 = _mm_setr_epi8(8, 8, 8, -1, 9, 9, 9, -1, 10, 10, 10, -1, 11, 11, 11, -1);
+  const __m128i m3 = _mm_setr_epi8(12, 12, 12, -1, 13, 13, 13, -1, 14, 14, 14, -1, 15, 15, 15, -1);
+  unsigned int i = 0;
+  for (; (i + 16) <= size; i += 16) {
+    const __m128i g = _mm_loadu_si128(reinterpret_cast<const __m128i *>(grey + i));
+    __m128i *dst = reinterpret_cast<__m128i *>(rgba + (4 * i));
+    _mm_storeu_si128(dst, _mm_or_si128(_mm_shuffle_epi8(g, m0), alpha));
+    _mm_storeu_si128(dst + 1, _mm_or_si128(_mm_shuffle_epi8(g, m1), alpha));
+    _mm_storeu_si128(dst + 2, _mm_or_si128(_mm_shuffle_epi8(g, m2), alpha));
+    _mm_storeu_si128(dst + 3, _mm_or_si128(_mm_shuffle_epi8(g, m3), alpha));
+  }
+  return i;
+}
+
+template <bool bgr>
+VP_TARGET_SSE41 unsigned int RGBToRGBaSSE41(const unsigned char *src, unsigned char *rgba, unsigned int size)
+{
+  const __m128i alpha = alphaMaskSSE41();
+  const __m128i shuffle = bgr ? _mm_setr_epi8(2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1)
+    : _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+  unsigned int i = 0;
+  // The last load of 16 bytes reads 4 bytes after the 16 pixels
+  for (; (i + 18) <= size; i += 16) {
+    const unsigned char *p = src + (3 * i);
+    __m128i *dst = reinterpret_cast<__m128i *>(rgba + (4 * i));
+    for (int k = 0; k < 4; ++k) {
+      const __m128i px = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + (12 * k)));
+      _mm_storeu_si128(dst + k, _mm_or_si128(_mm_shuffle_epi8(px, shuffle), alpha));
+    }
+  }
+  return i;
+}
+
+VP_TARGET_SSE41 unsigned int BGRaToRGBaSSE41(const unsigned char *bgra, unsigned char *rgba, unsigned int size)
+{
+  const __m128i shuffle = _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+  unsigned int i = 0;
+  for (; (i + 16) <= size; i += 16) {
+    const __m128i *src = reinterpret_cast<const __m128i *>(bgra + (4 * i));
+    __m128i *dst = reinterpret_cast<__m128i *>(rgba + (4 * i));
+    for (int k = 0; k < 4; ++k) {
+      _mm_storeu_si128(dst + k, _mm_shuffle_epi8(_mm_loadu_si128(src + k), shuffle));
+    }
+  }
+  return i;
+}
+
+VP_TARGET_SSE41 unsigned int RGBaToRGBSSE41(const unsigned char *rgba, unsigned char *rgb, unsigned int size)
+{
+  const __m128i shuffle = _mm_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+  unsigned int i = 0;
+  for (; (i + 16) <= size; i += 16) {
+    const __m128i *src = reinterpret_cast<const __m128i *>(rgba + (4 * i));
+    const __m128i a = _mm_shuffle_epi8(_mm_loadu_si128(src), shuffle);
+    const __m128i b = _mm_shuffle_epi8(_mm_loadu_si128(src + 1), shuffle);
+    const __m128i c = _mm_shuffle_epi8(_mm_loadu_si128(src + 2), shuffle);
+    const __m128i d = _mm_shuffle_epi8(_mm_loadu_si128(src + 3), shuffle);
+    __m128i *dst = reinterpret_cast<__m128i *>(rgb + (3 * i));
+    _mm_storeu_si128(dst, _mm_or_si128(a, _mm_slli_si128(b, 12)));
+    _mm_storeu_si128(dst + 1, _mm_or_si128(_mm_srli_si128(b, 4), _mm_slli_si128(c, 8)));
+    _mm_storeu_si128(dst + 2, _mm_or_si128(_mm_srli_si128(c, 8), _mm_slli_si128(d, 4)));
+  }
+  return i;
+}
+
+VP_TARGET_SSE41 unsigned int splitRGBaSSE41(const unsigned char *rgba, unsigned char *R, unsigned char *G,
+                                            unsigned char *B, unsigned char *A, unsigned int size)
+{
+  // Group the channels of 4 pixels: R0 R1 R2 R3 G0 G1 G2 G3 ...
+  const __m128i shuffle = _mm_setr_epi8(0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15);
+  unsigned int i = 0;
+  for (; (i + 16) <= size; i += 16) {
+    const __m128i *src = reinterpret_cast<const __m128i *>(rgba + (4 * i));
+    const __m128i v0 = _mm_shuffle_epi8(_mm_loadu_si128(src), shuffle);
+    const __m128i v1 = _mm_shuffle_epi8(_mm_loadu_si128(src + 1), shuffle);
+    const __m128i v2 = _mm_shuffle_epi8(_mm_loadu_si128(src + 2), shuffle);
+    const __m128i v3 = _mm_shuffle_epi8(_mm_loadu_si128(src + 3), shuffle);
+    const __m128i t0 = _mm_unpacklo_epi32(v0, v1);
+    const __m128i t1 = _mm_unpackhi_epi32(v0, v1);
+    const __m128i t2 = _mm_unpacklo_epi32(v2, v3);
+    const __m128i t3 = _mm_unpackhi_epi32(v2, v3);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(R + i), _mm_unpacklo_epi64(t0, t2));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(G + i), _mm_unpackhi_epi64(t0, t2));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(B + i), _mm_unpacklo_epi64(t1, t3));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(A + i), _mm_unpackhi_epi64(t1, t3));
+  }
+  return i;
+}
+
+VP_TARGET_SSE41 unsigned int mergeRGBaSSE41(const unsigned char *R, const unsigned char *G, const unsigned char *B,
+                                            const unsigned char *A, unsigned char *rgba, unsigned int size)
+{
+  unsigned int i = 0;
+  for (; (i + 16) <= size; i += 16) {
+    storeRGBaSSE41(_mm_loadu_si128(reinterpret_cast<const __m128i *>(R + i)),
+                   _mm_loadu_si128(reinterpret_cast<const __m128i *>(G + i)),
+                   _mm_loadu_si128(reinterpret_cast<const __m128i *>(B + i)),
+                   _mm_loadu_si128(reinterpret_cast<const __m128i *>(A + i)), rgba + (4 * i));
+  }
+  return i;
+}
+
+// Truncated division by 256 of signed 32 bits integers
+VP_TARGET_SSE41 inline __m128i truncDiv256SSE41(__m128i s)
+{
+  const __m128i bias = _mm_and_si128(_mm_srai_epi32(s, 31), _mm_set1_epi32(255));
+  return _mm_srai_epi32(_mm_add_epi32(s, bias), 8);
+}
+
+// Truncated product of a signed chroma by an unsigned 16 bits fixed point factor
+VP_TARGET_SSE41 inline __m128i chromaProductSSE41(__m128i x, __m128i factor)
+{
+  return _mm_sign_epi16(_mm_mulhi_epu16(_mm_abs_epi16(x), factor), x);
+}
+
+// Convert 8 YUYV pixels into 16 bits R, G, B values
+VP_TARGET_SSE41 inline void YUYVToRGBSSE41(__m128i px, __m128i &r, __m128i &g, __m128i &b)
+{
+  const __m128i c128 = _mm_set1_epi16(128);
+  const __m128i uDup = _mm_setr_epi8(1, -1, 1, -1, 5, -1, 5, -1, 9, -1, 9, -1, 13, -1, 13, -1);
+  const __m128i vDup = _mm_setr_epi8(3, -1, 3, -1, 7, -1, 7, -1, 11, -1, 11, -1, 15, -1, 15, -1);
+  const __m128i uvLo = _mm_setr_epi8(1, -1, 3, -1, 1, -1, 3, -1, 5, -1, 7, -1, 5, -1, 7, -1);
+  const __m128i uvHi = _mm_setr_epi8(9, -1, 11, -1, 9, -1, 11, -1, 13, -1, 15, -1, 13, -1, 15, -1);
+  const __m128i gWeights = _mm_setr_epi16(88, 183, 88, 183, 88, 183, 88, 183);
+
+  const __m128i y = _mm_and_si128(px, _mm_set1_epi16(0x00FF));
+  const __m128i u = _mm_sub_epi16(_mm_shuffle_epi8(px, uDup), c128);
+  const __m128i v = _mm_sub_epi16(_mm_shuffle_epi8(px, vDup), c128);
+  // |u| * 454 and |v| * 359 fit in unsigned 16 bits integers
+  const __m128i cb = _mm_sign_epi16(_mm_srli_epi16(_mm_mullo_epi16(_mm_abs_epi16(u), _mm_set1_epi16(454)), 8), u);
+  const __m128i cr = _mm_sign_epi16(_mm_srli_epi16(_mm_mullo_epi16(_mm_abs_epi16(v), _mm_set1_epi16(359)), 8), v);
+  const __m128i sLo = _mm_madd_epi16(_mm_sub_epi16(_mm_shuffle_epi8(px, uvLo), c128), gWeights);
+  const __m128i sHi = _mm_madd_epi16(_mm_sub_epi16(_mm_shuffle_epi8(px, uvHi), c128), gWeights);
+  const __m128i cg = _mm_packs_epi32(truncDiv256SSE41(sLo), truncDiv256SSE41(sHi));
+
+  r = _mm_add_epi16(y, cr);
+  g = _mm_sub_epi16(y, cg);
+  b = _mm_add_epi16(y, cb);
+}
+
+VP_TARGET_SSE41 unsigned int YUYVToRGBaSSE41(const unsigned char *yuyv, unsigned char *rgba, unsigned int size)
+{
+  const __m128i alpha = _mm_set1_epi8(static_cast<char>(vpRGBa::alpha_default));
+  unsigned int i = 0;
+  for (; (i + 16) <= size; i += 16) {
+    const __m128i *src = reinterpret_cast<const __m128i *>(yuyv + (2 * i));
+    __m128i r0, g0, b0, r1, g1, b1;
+    YUYVToRGBSSE41(_mm_loadu_si128(src), r0, g0, b0);
+    YUYVToRGBSSE41(_mm_loadu_si128(src + 1), r1, g1, b1);
+    storeRGBaSSE41(_mm_packus_epi16(r0, r1), _mm_packus_epi16(g0, g1), _mm_packus_epi16(b0, b1), alpha,
+                   rgba + (4 * i));
+  }
+  return i;
+}
+
+// Offsets added to Y for the R, G and B channels: 2 V, -U - V and 5 U
+VP_TARGET_SSE41 inline void chromaOffsetsSSE41(__m128i U, __m128i V, __m128i &dr, __m128i &dg, __m128i &db)
+{
+  dr = _mm_add_epi16(V, V);
+  dg = _mm_sub_epi16(_mm_setzero_si128(), _mm_add_epi16(U, V));
+  db = _mm_add_epi16(_mm_slli_epi16(U, 2), U);
+}
+
+VP_TARGET_SSE41 unsigned int UYVYToRGBaSSE41(const unsigned char *uyvy, unsigned char *rgba, unsigned int size)
+{
+  const __m128i alpha = _mm_set1_epi8(static_cast<char>(vpRGBa::alpha_default));
+  const __m128i c128 = _mm_set1_epi16(128);
+  const __m128i factorU = _mm_set1_epi16(static_cast<short>(chromaFactorU));
+  const __m128i factorV = _mm_set1_epi16(static_cast<short>(chromaFactorV));
+  const __m128i uDup = _mm_setr_epi8(0, -1, 0, -1, 4, -1, 4, -1, 8, -1, 8, -1, 12, -1, 12, -1);
+  const __m128i vDup = _mm_setr_epi8(2, -1, 2, -1, 6, -1, 6, -1, 10, -1, 10, -1, 14, -1, 14, -1);
+  unsigned int i = 0;
+  for (; (i + 16) <= size; i += 16) {
+    const __m128i *src = reinterpret_cast<const __m128i *>(uyvy + (2 * i));
+    __m128i r[2], g[2], b[2];
+    for (int k = 0; k < 2; ++k) {
+      const __m128i px = _mm_loadu_si128(src + k);
+      const __m128i y = _mm_srli_epi16(px, 8);
+      const __m128i U = chromaProductSSE41(_mm_sub_epi16(_mm_shuffle_epi8(px, uDup), c128), factorU);
+      const __m128i V = chromaProductSSE41(_mm_sub_epi16(_mm_shuffle_epi8(px, vDup), c128), factorV);
+      __m128i dr, dg, db;
+      chromaOffsetsSSE41(U, V, dr, dg, db);
+      r[k] = _mm_add_epi16(y, dr);
+      g[k] = _mm_add_epi16(y, dg);
+      b[k] = _mm_add_epi16(y, db);
+    }
+    storeRGBaSSE41(_mm_packus_epi16(r[0], r[1]), _mm_packus_epi16(g[0], g[1]), _mm_packus_epi16(b[0], b[1]), alpha,
+                   rgba + (4 * i));
+  }
+  return i;
+}
+
+VP_TARGET_SSE41 unsigned int YUV420ToRGBaSSE41(const unsigned char *y0, const unsigned char *y1,
+                                               const unsigned char *u, const unsigned char *v, unsigned char *rgba0,
+                                               unsigned char *rgba1, unsigned int width)
+{
+  const __m128i alpha = _mm_set1_epi8(static_cast<char>(vpRGBa::alpha_default));
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i c128 = _mm_set1_epi16(128);
+  const __m128i factorU = _mm_set1_epi16(static_cast<short>(chromaFactorU));
+  const __m128i factorV = _mm_set1_epi16(static_cast<short>(chromaFactorV));
+  unsigned int j = 0;
+  for (; (j + 16) <= width; j += 16) {
+    const __m128i xu = _mm_sub_epi16(_mm_cvtepu8_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(u + (j / 2)))), c128);
+    const __m128i xv = _mm_sub_epi16(_mm_cvtepu8_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(v + (j / 2)))), c128);
+    const __m128i U = chromaProductSSE41(xu, factorU);
+    const __m128i V = chromaProductSSE41(xv, factorV);
+    __m128i drLo, dgLo, dbLo, drHi, dgHi, dbHi;
+    chromaOffsetsSSE41(_mm_unpacklo_epi16(U, U), _mm_unpacklo_epi16(V, V), drLo, dgLo, dbLo);
+    chromaOffsetsSSE41(_mm_unpackhi_epi16(U, U), _mm_unpackhi_epi16(V, V), drHi, dgHi, dbHi);
+
+    const unsigned char *rows[2] = { y0 + j, y1 + j };
+    unsigned char *dst[2] = { rgba0 + (4 * j), rgba1 + (4 * j) };
+    for (int k = 0; k < 2; ++k) {
+      const __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i *>(rows[k]));
+      const __m128i yLo = _mm_unpacklo_epi8(y, zero);
+      const __m128i yHi = _mm_unpackhi_epi8(y, zero);
+      storeRGBaSSE41(_mm_packus_epi16(_mm_add_epi16(yLo, drLo), _mm_add_epi16(yHi, drHi)),
+                     _mm_packus_epi16(_mm_add_epi16(yLo, dgLo), _mm_add_epi16(yHi, dgHi)),
+                     _mm_packus_epi16(_mm_add_epi16(yLo, dbLo), _mm_add_epi16(yHi, dbHi)), alpha, dst[k]);
+    }
+  }
+  return j;
+}
+
+// Unproject 4 depth values in meter, the count of valid points being decremented by -1 for each valid point
+VP_TARGET_SSE41 inline __m128i depthToPoints4SSE41(__m128 z, const float *x, __m128 y, __m128 zMin, __m128 zMax,
+                                                   float *X, float *Y, float *Z, __m128i count)
+{
+  const __m128 valid = _mm_and_ps(_mm_cmpgt_ps(z, zMin), _mm_cmplt_ps(z, zMax));
+  z = _mm_and_ps(z, valid);
+  _mm_storeu_ps(X, _mm_mul_ps(_mm_loadu_ps(x), z));
+  _mm_storeu_ps(Y, _mm_mul_ps(y, z));
+  _mm_storeu_ps(Z, z);
+  return _mm_sub_epi32(count, _mm_castps_si128(valid));
+}
+
+VP_TARGET_SSE41 inline unsigned int horizontalSumSSE41(__m128i v)
+{
+  v = _mm_add_epi32(v, _mm_shuffle_epi32(v, 0x4E));
+  v = _mm_add_epi32(v, _mm_shuffle_epi32(v, 0xB1));
+  return static_cast<unsigned int>(_mm_cvtsi128_si32(v));
+}
+
+VP_TARGET_SSE41 unsigned int depthToPointsSSE41(const uint16_t *depth, float depth_scale, const float *x, float y,
+                                                float Z_min, float Z_max, float *X, float *Y, float *Z,
+                                                unsigned int size, unsigned int &nbValid)
+{
+  const __m128 scale = _mm_set1_ps(depth_scale);
+  const __m128 yv = _mm_set1_ps(y);
+  const __m128 zMin = _mm_set1_ps(Z_min);
+  const __m128 zMax = _mm_set1_ps(Z_max);
+  __m128i count = _mm_setzero_si128();
+  unsigned int j = 0;
+  for (; (j + 8) <= size; j += 8) {
+    const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i *>(depth + j));
+    const __m128 z0 = _mm_mul_ps(_mm_cvtepi32_ps(_mm_cvtepu16_epi32(d)), scale);
+    const __m128 z1 = _mm_mul_ps(_mm_cvtepi32_ps(_mm_cvtepu16_epi32(_mm_srli_si128(d, 8))), scale);
+    count = depthToPoints4SSE41(z0, x + j, yv, zMin, zMax, X + j, Y + j, Z + j, count);
+    count = depthToPoints4SSE41(z1, x + j + 4, yv, zMin, zMax, X + j + 4, Y + j + 4, Z + j + 4, count);
+  }
+  nbValid = horizontalSumSSE41(count);
+  return j;
+}
+
+VP_TARGET_SSE41 unsigned int depthToPointsSSE41(const float *depth, float depth_scale, const float *x, float y,
+                                                float Z_min, float Z_max, float *X, float *Y, float *Z,
+                                                unsigned int size, unsigned int &nbValid)
+{
+  const __m128 scale = _mm_set1_ps(depth_scale);
+  const __m128 yv = _mm_set1_ps(y);
+  const __m128 zMin = _mm_set1_ps(Z_min);
+  const __m128 zMax = _mm_set1_ps(Z_max);
+  __m128i count = _mm_setzero_si128();
+  unsigned int j = 0;
+  for (; (j + 4) <= size; j += 4) {
+    const __m128 z = _mm_mul_ps(_mm_loadu_ps(depth + j), scale);
+    count = depthToPoints4SSE41(z, x + j, yv, zMin, zMax, X + j, Y + j, Z + j, count);
+  }
+  nbValid = horizontalSumSSE41(count);
+  return j;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// AVX2 code, used where 256 bits registers are worth the lane crossing
+//----------------------------------------------------------------------------------------------------------------------
+VP_TARGET_AVX2 inline __m256i greySumsAVX2(__m256i px, __m256i weights)
+{
+  const __m256i zero = _mm256_setzero_si256();
+  const __m256i lo = _mm256_madd_epi16(_mm256_unpacklo_epi8(px, zero), weights);
+  const __m256i hi = _mm256_madd_epi16(_mm256_unpackhi_epi8(px, zero), weights);
+  return _mm256_hadd_epi32(lo, hi);
+}
+
+// Each sum holds pixels 0 to 3 in the low lane and 4 to 7 in the high lane
+VP_TARGET_AVX2 inline __m256i greyPackAVX2(__m256i s0, __m256i s1, __m256i s2, __m256i s3)
+{
+  const __m256i round = _mm256_set1_epi32(greyRound);
+  s0 = _mm256_srli_epi32(_mm256_add_epi32(s0, round), greyShift);
+  s1 = _mm256_srli_epi32(_mm256_add_epi32(s1, round), greyShift);
+  s2 = _mm256_srli_epi32(_mm256_add_epi32(s2, round), greyShift);
+  s3 = _mm256_srli_epi32(_mm256_add_epi32(s3, round), greyShift);
+  const __m256i grey = _mm256_packus_epi16(_mm256_packus_epi32(s0, s1), _mm256_packus_epi32(s2, s3));
+  return _mm256_permutevar8x32_epi32(grey, _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7));
+}
+
+VP_TARGET_AVX2 inline __m256i greyWeightsAVX2(bool bgr)
+{
+  const short w0 = static_cast<short>(bgr ? greyWeightB : greyWeightR);
+  const short w1 = static_cast<short>(greyWeightG);
+  const short w2 = static_cast<short>(bgr ? greyWeightR : greyWeightB);
+  return _mm256_setr_epi16(w0, w1, w2, 0, w0, w1, w2, 0, w0, w1, w2, 0, w0, w1, w2, 0);
+}
+
+// Load 8 RGB pixels, 4 in each lane, and shuffle them
+VP_TARGET_AVX2 inline __m256i loadRGB8AVX2(const unsigned char *p, __m256i shuffle)
+{
+  const __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+  const __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + 12));
+  return _mm256_shuffle_epi8(_mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1), shuffle);
+}
+
+VP_TARGET_AVX2 inline __m256i alphaMaskAVX2()
+{
+  return _mm256_set1_epi32(static_cast<int>(static_cast<unsigned int>(vpRGBa::alpha_default) << 24));
+}
+
+template <bool bgr>
+VP_TARGET_AVX2 unsigned int RGBaToGreyAVX2(const unsigned char *src, unsigned char *grey, unsigned int size)
+{
+  const __m256i weights = greyWeightsAVX2(bgr);
+  unsigned int i = 0;
+  for (; (i + 32) <= size; i += 32) {
+    const __m256i *p = reinterpret_cast<const __m256i *>(src + (4 * i));
+    const __m256i s0 = greySumsAVX2(_mm256_loadu_si256(p), weights);
+    const __m256i s1 = greySumsAVX2(_mm256_loadu_si256(p + 1), weights);
+    const __m256i s2 = greySumsAVX2(_mm256_loadu_si256(p + 2), weights);
+    const __m256i s3 = greySumsAVX2(_mm256_loadu_si256(p + 3), weights);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(grey + i), greyPackAVX2(s0, s1, s2, s3));
+  }
+  return i;
+}
+
+template <bool bgr>
+VP_TARGET_AVX2 unsigned int RGBToGreyAVX2(const unsigned char *src, unsigned char *grey, unsigned int size)
+{
+  const __m256i weights = greyWeightsAVX2(bgr);
+  const __m256i toRGBx = _mm256_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1,
+                                          0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+  unsigned int i = 0;
+  // The last load of 16 bytes reads 4 bytes after the 32 pixels
+  for (; (i + 34) <= size; i += 32) {
+    const unsigned char *p = src + (3 * i);
+    const __m256i s0 = greySumsAVX2(loadRGB8AVX2(p, toRGBx), weights);
+    const __m256i s1 = greySumsAVX2(loadRGB8AVX2(p + 24, toRGBx), weights);
+    const __m256i s2 = greySumsAVX2(loadRGB8AVX2(p + 48, toRGBx), weights);
+    const __m256i s3 = greySumsAVX2(loadRGB8AVX2(p + 72, toRGBx), weights);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(grey + i), greyPackAVX2(s0, s1, s2, s3));
+  }
+  return i;
+}
+
+VP_TARGET_AVX2 unsigned int GreyToRGBaAVX2(const unsigned char *grey, unsigned char *rgba, unsigned int size)
+{
+  const __m256i alpha = alphaMaskAVX2();
+  const __m256i shuffle = _mm256_setr_epi8(0, 0, 0, -1, 1, 1, 1, -1, 2, 2, 2, -1, 3, 3, 3, -1,
+                                           4, 4, 4, -1, 5, 5, 5, -1, 6, 6, 6, -1, 7, 7, 7, -1);
+  unsigned int i = 0;
+  for (; (i + 32) <= size; i += 32) {
+    __m256i *dst = reinterpret_cast<__m256i *>(rgba + (4 * i));
+    for (int k = 0; k < 4; ++k) {
+      const __m128i g = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(grey + i + (8 * k)));
+      const __m256i g2 = _mm256_inserti128_si256(_mm256_castsi128_si256(g), g, 1);
+      _mm256_storeu_si256(dst + k, _mm256_or_si256(_mm256_shuffle_epi8(g2, shuffle), alpha));
+    }
+  }
+  return i;
+}
+
+template <bool bgr>
+VP_TARGET_AVX2 unsigned int RGBToRGBaAVX2(const unsigned char *src, unsigned char *rgba, unsigned int size)
+{
+  const __m256i alpha = alphaMaskAVX2();
+  const __m256i shuffle = bgr ? _mm256_setr_epi8(2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1,
+                                                 2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1)
+    : _mm256_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1,
+                       0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+  unsigned int i = 0;
+  // The last load of 16 bytes reads 4 bytes after the 32 pixels
+  for (; (i + 34) <= size; i += 32) {
+    const unsigned char *p = src + (3 * i);
+    __m256i *dst = reinterpret_cast<__m256i *>(rgba + (4 * i));
+    for (int k = 0; k < 4; ++k) {
+      _mm256_storeu_si256(dst + k, _mm256_or_si256(loadRGB8AVX2(p + (24 * k), shuffle), alpha));
+    }
+  }
+  return i;
+}
+
+VP_TARGET_AVX2 unsigned int BGRaToRGBaAVX2(const unsigned char *bgra, unsigned char *rgba, unsigned int size)
+{
+  const __m256i shuffle = _mm256_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15,
+                                           2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+  unsigned int i = 0;
+  for (; (i + 32) <= size; i += 32) {
+    const __m256i *src = reinterpret_cast<const __m256i *>(bgra + (4 * i));
+    __m256i *dst = reinterpret_cast<__m256i *>(rgba + (4 * i));
+    for (int k = 0; k < 4; ++k) {
+      _mm256_storeu_si256(dst + k, _mm256_shuffle_epi8(_mm256_loadu_si256(src + k), shuffle));
+    }
+  }
+  return i;
+}
+
+VP_TARGET_AVX2 unsigned int splitRGBaAVX2(const unsigned char *rgba, unsigned char *R, unsigned char *G,
+                                          unsigned char *B, unsigned char *A, unsigned int size)
+{
+  const __m256i shuffle = _mm256_setr_epi8(0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15,
+                                           0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15);
+  const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+  unsigned int i = 0;
+  for (; (i + 32) <= size; i += 32) {
+    const __m256i *src = reinterpret_cast<const __m256i *>(rgba + (4 * i));
+    const __m256i v0 = _mm256_shuffle_epi8(_mm256_loadu_si256(src), shuffle);
+    const __m256i v1 = _mm256_shuffle_epi8(_mm256_loadu_si256(src + 1), shuffle);
+    const __m256i v2 = _mm256_shuffle_epi8(_mm256_loadu_si256(src + 2), shuffle);
+    const __m256i v3 = _mm256_shuffle_epi8(_mm256_loadu_si256(src + 3), shuffle);
+    const __m256i t0 = _mm256_unpacklo_epi32(v0, v1);
+    const __m256i t1 = _mm256_unpackhi_epi32(v0, v1);
+    const __m256i t2 = _mm256_unpacklo_epi32(v2, v3);
+    const __m256i t3 = _mm256_unpackhi_epi32(v2, v3);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(R + i), _mm256_permutevar8x32_epi32(_mm256_unpacklo_epi64(t0, t2), order));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(G + i), _mm256_permutevar8x32_epi32(_mm256_unpackhi_epi64(t0, t2), order));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(B + i), _mm256_permutevar8x32_epi32(_mm256_unpacklo_epi64(t1, t3), order));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(A + i), _mm256_permutevar8x32_epi32(_mm256_unpackhi_epi64(t1, t3), order));
+  }
+  return i;
+}
+
+VP_TARGET_AVX2 unsigned int mergeRGBaAVX2(const unsigned char *R, const unsigned char *G, const unsigned char *B,
+                                          const unsigned char *A, unsigned char *rgba, unsigned int size)
+{
+  unsigned int i = 0;
+  for (; (i + 32) <= size; i += 32) {
+    // Reorder the 64 bits blocks so that in-lane unpacking gives the pixels in order
+    const __m256i r = _mm256_permute4x64_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(R + i)), 0xD8);
+    const __m256i g = _mm256_permute4x64_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(G + i)), 0xD8);
+    const __m256i b = _mm256_permute4x64_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(B + i)), 0xD8);
+    const __m256i a = _mm256_permute4x64_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(A + i)), 0xD8);
+    const __m256i rgLo = _mm256_unpacklo_epi8(r, g);
+    const __m256i rgHi = _mm256_unpackhi_epi8(r, g);
+    const __m256i baLo = _mm256_unpacklo_epi8(b, a);
+    const __m256i baHi = _mm256_unpackhi_epi8(b, a);
+    const __m256i p0 = _mm256_unpacklo_epi16(rgLo, baLo);
+    const __m256i p1 = _mm256_unpackhi_epi16(rgLo, baLo);
+    const __m256i p2 = _mm256_unpacklo_epi16(rgHi, baHi);
+    const __m256i p3 = _mm256_unpackhi_epi16(rgHi, baHi);
+    __m256i *dst = reinterpret_cast<__m256i *>(rgba + (4 * i));
+    _mm256_storeu_si256(dst, _mm256_permute2x128_si256(p0, p1, 0x20));
+    _mm256_storeu_si256(dst + 1, _mm256_permute2x128_si256(p0, p1, 0x31));
+    _mm256_storeu_si256(dst + 2, _mm256_permute2x128_si256(p2, p3, 0x20));
+    _mm256_storeu_si256(dst + 3, _mm256_permute2x128_si256(p2, p3, 0x31));
+  }
+  return i;
+}
+
+VP_TARGET_AVX2 inline __m256i depthToPoints8AVX2(__m256 z, const float *x, __m256 y, __m256 zMin, __m256 zMax,
+                                                 float *X, float *Y, float *Z, __m256i count)
+{
+  const __m256 valid = _mm256_and_ps(_mm256_cmp_ps(z, zMin, _CMP_GT_OQ), _mm256_cmp_ps(z, zMax, _CMP_LT_OQ));
+  z = _mm256_and_ps(z, valid);
+  _mm256_storeu_ps(X, _mm256_mul_ps(_mm256_loadu_ps(x), z));
+  _mm256_storeu_ps(Y, _mm256_mul_ps(y, z));
+  _mm256_storeu_ps(Z, z);
+  return _mm256_sub_epi32(count, _mm256_castps_si256(valid));
+}
+
+VP_TARGET_AVX2 inline unsigned int horizontalSumAVX2(__m256i v)
+{
+  __m128i s = _mm_add_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+  s = _mm_add_epi32(s, _mm_shuffle_epi32(s, 0x4E));
+  s = _mm_add_epi32(s, _mm_shuffle_epi32(s, 0xB1));
+  return static_cast<unsigned int>(_mm_cvtsi128_si32(s));
+}
+
+VP_TARGET_AVX2 unsigned int depthToPointsAVX2(const uint16_t *depth, float depth_scale, const float *x, float y,
+                                              float Z_min, float Z_max, float *X, float *Y, float *Z,
+                                              unsigned int size, unsigned int &nbValid)
+{
+  const __m256 scale = _mm256_set1_ps(depth_scale);
+  const __m256 yv = _mm256_set1_ps(y);
+  const __m256 zMin = _mm256_set1_ps(Z_min);
+  const __m256 zMax = _mm256_set1_ps(Z_max);
+  __m256i count = _mm256_setzero_si256();
+  unsigned int j = 0;
+  for (; (j + 8) <= size; j += 8) {
+    const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i *>(depth + j));
+    const __m256 z = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepu16_epi32(d)), scale);
+    count = depthToPoints8AVX2(z, x + j, yv, zMin, zMax, X + j, Y + j, Z + j, count);
+  }
+  nbValid = horizontalSumAVX2(count);
+  return j;
+}
+
+VP_TARGET_AVX2 unsigned int depthToPointsAVX2(const float *depth, float depth_scale, const float *x, float y,
+                                              float Z_min, float Z_max, float *X, float *Y, float *Z,
+                                              unsigned int size, unsigned int &nbValid)
+{
+  const __m256 scale = _mm256_set1_ps(depth_scale);
+  const __m256 yv = _mm256_set1_ps(y);
+  const __m256 zMin = _mm256_set1_ps(Z_min);
+  const __m256 zMax = _mm256_set1_ps(Z_max);
+  __m256i count = _mm256_setzero_si256();
+  unsigned int j = 0;
+  for (; (j + 8) <= size; j += 8) {
+    const __m256 z = _mm256_mul_ps(_mm256_loadu_ps(depth + j), scale);
+    count = depthToPoints8AVX2(z, x + j, yv, zMin, zMax, X + j, Y + j, Z + j, count);
+  }
+  nbValid = horizontalSumAVX2(count);
+  return j;
+}
+#endif // VP_COLOR_CONVERSION_X86
+
+#if defined(VP_COLOR_CONVERSION_NEON)
+//----------------------------------------------------------------------------------------------------------------------
+// NEON code
+//----------------------------------------------------------------------------------------------------------------------
+inline uint8x8_t greyNEON(uint8x8_t r, uint8x8_t g, uint8x8_t b)
+{
+  const uint16x8_t r16 = vmovl_u8(r);
+  const uint16x8_t g16 = vmovl_u8(g);
+  const uint16x8_t b16 = vmovl_u8(b);
+  uint32x4_t lo = vmull_n_u16(vget_low_u16(r16), static_cast<uint16_t>(greyWeightR));
+  lo = vmlal_n_u16(lo, vget_low_u16(g16), static_cast<uint16_t>(greyWeightG));
+  lo = vmlal_n_u16(lo, vget_low_u16(b16), static_cast<uint16_t>(greyWeightB));
+  uint32x4_t hi = vmull_n_u16(vget_high_u16(r16), static_cast<uint16_t>(greyWeightR));
+  hi = vmlal_n_u16(hi, vget_high_u16(g16), static_cast<uint16_t>(greyWeightG));
+  hi = vmlal_n_u16(hi, vget_high_u16(b16), static_cast<uint16_t>(greyWeightB));
+  // Rounding shift, that adds greyRound
+  return vmovn_u16(vcombine_u16(vrshrn_n_u32(lo, 14), vrshrn_n_u32(hi, 14)));
+}
+
+inline uint8x16_t greyNEON(uint8x16_t r, uint8x16_t g, uint8x16_t b)
+{
+  return vcombine_u8(greyNEON(vget_low_u8(r), vget_low_u8(g), vget_low_u8(b)),
+                     greyNEON(vget_high_u8(r), vget_high_u8(g), vget_high_u8(b)));
+}
+
+template <bool bgr>
+unsigned int RGBaToGreyNEON(const unsigned char *src, unsigned char *grey, unsigned int size)
+{
+  unsigned int i = 0;
+  for (; (i + 16) <= size; i += 16) {
+    const uint8x16x4_t px = vld4q_u8(src + (4 * i));
+    vst1q_u8(grey + i, greyNEON(px.val[bgr ? 2 : 0], px.val[1], px.val[bgr ? 0 : 2]));
+  }
+  return i;
+}
+
+template <bool bgr>
+unsigned int RGBToGreyNEON(const unsigned char *src, unsigned char *grey, unsigned int size)
+{
+  unsigned int i = 0;
+  for (; (i + 16) <= size; i += 16) {
+    const uint8x16x3_t px = vld3q_u8(src + (3 * i));
+    vst1q_u8(grey + i, greyNEON(px.val[bgr ? 2 : 0], px.val[1], px.val[bgr ? 0 : 2]));
+  }
+  return i;
+}
+
+unsigned int GreyToRGBaNEON(const unsigned char *grey, unsigned char *rgba, unsigned int size)
+{
+  uint8x16x4_t px;
+  px.val[3] = vdupq_n_u8(vpRGBa::alpha_default);
+  unsigned int i = 0;
+  for (; (i + 16) <= size; i += 16) {
+    px.val[0] = vld1q_u8(grey + i);
+    px.val[1] = px.val[0];
+    px.val[2] = px.val[0];
+    vst4q_u8(rgba + (4 * i), px);
+  }
+  return i;
+}
+
+template <bool bgr>
+unsigned int RGBToRGBaNEON(const unsigned char *src, unsigned char *rgba, unsigned int size)
+{
+  uint8x16x4_t px;
+  px.val[3] = vdupq_n_u8(vpRGBa::alpha_default);
+  unsigned int i = 0;
+  for (; (i + 16) <= size; i += 16) {
+    const uint8x16x3_t rgb = vld3q_u8(src + (3 * i));
+    px.val[0] = rgb.val[bgr ? 2 : 0];
+    px.val[1] = rgb.val[1];
+    px.val[2] = rgb.val[bgr ? 0 : 2];
+    vst4q_u8(rgba + (4 * i), px);
+  }
+  return i;
+}
+
+unsigned int BGRaToRGBaNEON(const unsigned char *bgra, unsigned char *rgba, unsigned int size)
+{
+  unsigned int i = 0;
+  for (; (i + 16) <= size; i += 16) {
+    uint8x16x4_t px = vld4q_u8(bgra + (4 * i));
+    const uint8x16_t b = px.val[0];
+    px.val[0] = px.val[2];
+    px.val[2] = b;
+    vst4q_u8(rgba + (4 * i), px);
+  }
+  return i;
+}
+
+unsigned int RGBaToRGBNEON(const unsigned char *rgba, unsigned char *rgb, unsigned int size)
+{
+  unsigned int i = 0;
+  for (; (i + 16) <= size; i += 16) {
+    const uint8x16x4_t px = vld4q_u8(rgba + (4 * i));
+    uint8x16x3_t out;
+    out.val[0] = px.val[0];
+    out.val[1] = px.val[1];
+    out.val[2] = px.val[2];
+    vst3q_u8(rgb + (3 * i), out);
+  }
+  return i;
+}
+
+unsigned int splitRGBaNEON(const unsigned char *rgba, unsigned char *R, unsigned char *G, unsigned char *B,
+                           unsigned char *A, unsigned int size)
+{
+  unsigned int i = 0;
+  for (; (i + 16) <= size; i += 16) {
+    const uint8x16x4_t px = vld4q_u8(rgba + (4 * i));
+    vst1q_u8(R + i, px.val[0]);
+    vst1q_u8(G + i, px.val[1]);
+    vst1q_u8(B + i, px.val[2]);
+    vst1q_u8(A + i, px.val[3]);
+  }
+  return i;
+}
+
+unsigned int mergeRGBaNEON(const unsigned char *R, const unsigned char *G, const unsigned char *B,
+                           const unsigned char *A, unsigned char *rgba, unsigned int size)
+{
+  unsigned int i = 0;
+  for (; (i + 16) <= size; i += 16) {
+    uint8x16x4_t px;
+    px.val[0] = vld1q_u8(R + i);
+    px.val[1] = vld1q_u8(G + i);
+    px.val[2] = vld1q_u8(B + i);
+    px.val[3] = vld1q_u8(A + i);
+    vst4q_u8(rgba + (4 * i), px);
+  }
+  return i;
+}
+
+inline uint32x4_t depthToPoints4NEON(float32x4_t z, const float *x, float y, float32x4_t zMin, float32x4_t zMax,
+                                     float *X, float *Y, float *Z, uint32x4_t count)
+{
+  const uint32x4_t valid = vandq_u32(vcgtq_f32(z, zMin), vcltq_f32(z, zMax));
+  z = vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(z), valid));
+  vst1q_f32(X, vmulq_f32(vld1q_f32(x), z));
+  vst1q_f32(Y, vmulq_n_f32(z, y));
+  vst1q_f32(Z, z);
+  return vsubq_u32(count, valid);
+}
+
+unsigned int depthToPointsNEON(const uint16_t *depth, float depth_scale, const float *x, float y, float Z_min,
+                               float Z_max, float *X, float *Y, float *Z, unsigned int size, unsigned int &nbValid)
+{
+  const float32x4_t zMin = vdupq_n_f32(Z_min);
+  const float32x4_t zMax = vdupq_n_f32(Z_max);
+  uint32x4_t count = vdupq_n_u32(0);
+  unsigned int j = 0;
+  for (; (j + 8) <= size; j += 8) {
+    const uint16x8_t d = vld1q_u16(depth + j);
+    const float32x4_t z0 = vmulq_n_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(d))), depth_scale);
+    const float32x4_t z1 = vmulq_n_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(d))), depth_scale);
+    count = depthToPoints4NEON(z0, x + j, y, zMin, zMax, X + j, Y + j, Z + j, count);
+    count = depthToPoints4NEON(z1, x + j + 4, y, zMin, zMax, X + j + 4, Y + j + 4, Z + j + 4, count);
+  }
+  nbValid = vaddvq_u32(count);
+  return j;
+}
+
+unsigned int depthToPointsNEON(const float *depth, float depth_scale, const float *x, float y, float Z_min,
+                               float Z_max, float *X, float *Y, float *Z, unsigned int size, unsigned int &nbValid)
+{
+  const float32x4_t zMin = vdupq_n_f32(Z_min);
+  const float32x4_t zMax = vdupq_n_f32(Z_max);
+  uint32x4_t count = vdupq_n_u32(0);
+  unsigned int j = 0;
+  for (; (j + 4) <= size; j += 4) {
+    const float32x4_t z = vmulq_n_f32(vld1q_f32(depth + j), depth_scale);
+    count = depthToPoints4NEON(z, x + j, y, zMin, zMax, X + j, Y + j, Z + j, count);
+  }
+  nbValid = vaddvq_u32(count);
+  return j;
+}
+#endif // VP_COLOR_CONVERSION_NEON
+} // namespace
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+void vp_RGBToGrey(const unsigned char *rgb, unsigned char *grey, unsigned int size)
+{
+  unsigned int i = 0;
+  switch (getSimdLevel()) {
+#if defined(VP_COLOR_CONVERSION_X86)
+  case SIMD_AVX2:
+    i = RGBToGreyAVX2<false>(rgb, grey, size);
+    break;
+  case SIMD_SSE41:
+    i = RGBToGreySSE41<false>(rgb, grey, size);
+    break;
+#elif defined(VP_COLOR_CONVERSION_NEON)
+  case SIMD_NEON:
+    i = RGBToGreyNEON<false>(rgb, grey, size);
+    break;
+#endif
+  default:
+    break;
+  }
+  colorToGreyScalar<3, false>(rgb + (3 * i), grey + i, size - i);
+}
+
+void vp_BGRToGrey(const unsigned char *bgr, unsigned char *grey, unsigned int size)
+{
+  unsigned int i = 0;
+  switch (getSimdLevel()) {
+#if defined(VP_COLOR_CONVERSION_X86)
+  case SIMD_AVX2:
+    i = RGBToGreyAVX2<true>(bgr, grey, size);
+    break;
+  case SIMD_SSE41:
+    i = RGBToGreySSE41<true>(bgr, grey, size);
+    break;
+#elif defined(VP_COLOR_CONVERSION_NEON)
+  case SIMD_NEON:
+    i = RGBToGreyNEON<true>(bgr, grey, size);
+    break;
+#endif
+  default:
+    break;
+  }
+  colorToGreyScalar<3, true>(bgr + (3 * i), grey + i, size - i);
+}
+
+void vp_RGBaToGrey(const unsigned char *rgba, unsigned char *grey, unsigned int size)
+{
+  unsigned int i = 0;
+  switch (getSimdLevel()) {
+#if defined(VP_COLOR_CONVERSION_X86)
+  case SIMD_AVX2:
+    i = RGBaToGreyAVX2<false>(rgba, grey, size);
+    break;
+  case SIMD_SSE41:
+    i = RGBaToGreySSE41<false>(rgba, grey, size);
+    break;
+#elif defined(VP_COLOR_CONVERSION_NEON)
+  case SIMD_NEON:
+    i = RGBaToGreyNEON<false>(rgba, grey, size);
+    break;
+#endif
+  default:
+    break;
+  }
+  colorToGreyScalar<4, false>(rgba + (4 * i), grey + i, size - i);
+}
+
+void vp_BGRaToGrey(const unsigned char *bgra, unsigned char *grey, unsigned int size)
+{
+  unsigned int i = 0;
+  switch (getSimdLevel()) {
+#if defined(VP_COLOR_CONVERSION_X86)
+  case SIMD_AVX2:
+    i = RGBaToGreyAVX2<true>(bgra, grey, size);
+    break;
+  case SIMD_SSE41:
+    i = RGBaToGreySSE41<true>(bgra, grey, size);
+    break;
+#elif defined(VP_COLOR_CONVERSION_NEON)
+  case SIMD_NEON:
+    i = RGBaToGreyNEON<true>(bgra, grey, size);
+    break;
+#endif
+  default:
+    break;
+  }
+  colorToGreyScalar<4, true>(bgra + (4 * i), grey + i, size - i);
+}
+
+void vp_GreyToRGBa(const unsigned char *grey, unsigned char *rgba, unsigned int size)
+{
+  unsigned int i = 0;
+  switch (getSimdLevel()) {
+#if defined(VP_COLOR_CONVERSION_X86)
+  case SIMD_AVX2:
+    i = GreyToRGBaAVX2(grey, rgba, size);
+    break;
+  case SIMD_SSE41:
+    i = GreyToRGBaSSE41(grey, rgba, size);
+    break;
+#elif defined(VP_COLOR_CONVERSION_NEON)
+  case SIMD_NEON:
+    i = GreyToRGBaNEON(grey, rgba, size);
+    break;
+#endif
+  default:
+    break;
+  }
+  GreyToRGBaScalar(grey + i, rgba + (4 * i), size - i);
+}
+
+void vp_RGBToRGBa(const unsigned char *rgb, unsigned char *rgba, unsigned int size)
+{
+  unsigned int i = 0;
+  switch (getSimdLevel()) {
+#if defined(VP_COLOR_CONVERSION_X86)
+  case SIMD_AVX2:
+    i = RGBToRGBaAVX2<false>(rgb, rgba, size);
+    break;
+  case SIMD_SSE41:
+    i = RGBToRGBaSSE41<false>(rgb, rgba, size);
+    break;
+#elif defined(VP_COLOR_CONVERSION_NEON)
+  case SIMD_NEON:
+    i = RGBToRGBaNEON<false>(rgb, rgba, size);
+    break;
+#endif
+  default:
+    break;
+  }
+  colorToRGBaScalar<3, false>(rgb + (3 * i), rgba + (4 * i), size - i);
+}
+
+void vp_BGRToRGBa(const unsigned char *bgr, unsigned char *rgba, unsigned int size)
+{
+  unsigned int i = 0;
+  switch (getSimdLevel()) {
+#if defined(VP_COLOR_CONVERSION_X86)
+  case SIMD_AVX2:
+    i = RGBToRGBaAVX2<true>(bgr, rgba, size);
+    break;
+  case SIMD_SSE41:
+    i = RGBToRGBaSSE41<true>(bgr, rgba, size);
+    break;
+#elif defined(VP_COLOR_CONVERSION_NEON)
+  case SIMD_NEON:
+    i = RGBToRGBaNEON<true>(bgr, rgba, size);
+    break;
+#endif
+  default:
+    break;
+  }
+  colorToRGBaScalar<3, true>(bgr + (3 * i), rgba + (4 * i), size - i);
+}
+
+void vp_BGRaToRGBa(const unsigned char *bgra, unsigned char *rgba, unsigned int size)
+{
+  unsigned int i = 0;
+  switch (getSimdLevel()) {
+#if defined(VP_COLOR_CONVERSION_X86)
+  case SIMD_AVX2:
+    i = BGRaToRGBaAVX2(bgra, rgba, size);
+    break;
+  case SIMD_SSE41:
+    i = BGRaToRGBaSSE41(bgra, rgba, size);
+    break;
+#elif defined(VP_COLOR_CONVERSION_NEON)
+  case SIMD_NEON:
+    i = BGRaToRGBaNEON(bgra, rgba, size);
+    break;
+#endif
+  default:
+    break;
+  }
+  colorToRGBaScalar<4, true>(bgra + (4 * i), rgba + (4 * i), size - i);
+}
+
+void vp_RGBaToRGB(const unsigned char *rgba, unsigned char *rgb, unsigned int size)
+{
+  unsigned int i = 0;
+  switch (getSimdLevel()) {
+#if defined(VP_COLOR_CONVERSION_X86)
+  case SIMD_AVX2:
+  case SIMD_SSE41:
+    i = RGBaToRGBSSE41(rgba, rgb, size);
+    break;
+#elif defined(VP_COLOR_CONVERSION_NEON)
+  case SIMD_NEON:
+    i = RGBaToRGBNEON(rgba, rgb, size);
+    break;
+#endif
+  default:
+    break;
+  }
+  RGBaToRGBScalar(rgba + (4 * i), rgb + (3 * i), size - i);
+}
+
+void vp_splitRGBa(const unsigned char *rgba, unsigned char *R, unsigned char *G, unsigned char *B, unsigned char *A,
+                  unsigned int size)
+{
+  unsigned int i = 0;
+  switch (getSimdLevel()) {
+#if defined(VP_COLOR_CONVERSION_X86)
+  case SIMD_AVX2:
+    i = splitRGBaAVX2(rgba, R, G, B, A, size);
+    break;
+  case SIMD_SSE41:
+    i = splitRGBaSSE41(rgba, R, G, B, A, size);
+    break;
+#elif defined(VP_COLOR_CONVERSION_NEON)
+  case SIMD_NEON:
+    i = splitRGBaNEON(rgba, R, G, B, A, size);
+    break;
+#endif
+  default:
+    break;
+  }
+  splitRGBaScalar(rgba + (4 * i), R + i, G + i, B + i, A + i, size - i);
+}
+
+void vp_mergeRGBa(const unsigned char *R, const unsigned char *G, const unsigned char *B, const unsigned char *A,
+                  unsigned char *rgba, unsigned int size)
+{
+  unsigned int i = 0;
+  switch (getSimdLevel()) {
+#if defined(VP_COLOR_CONVERSION_X86)
+  case SIMD_AVX2:
+    i = mergeRGBaAVX2(R, G, B, A, rgba, size);
+    break;
+  case SIMD_SSE41:
+    i = mergeRGBaSSE41(R, G, B, A, rgba, size);
+    break;
+#elif defined(VP_COLOR_CONVERSION_NEON)
+  case SIMD_NEON:
+    i = mergeRGBaNEON(R, G, B, A, rgba, size);
+    break;
+#endif
+  default:
+    break;
+  }
+  mergeRGBaScalar(R + i, G + i, B + i, A + i, rgba + (4 * i), size - i);
+}
+
+// The YUV kernels only exist for SSE4.1, the AVX2 level uses them and NEON uses the scalar code
+void vp_YUYVToRGBa(const unsigned char *yuyv, unsigned char *rgba, unsigned int size)
+{
+  unsigned int i = 0;
+#if defined(VP_COLOR_CONVERSION_X86)
+  if (getSimdLevel() != SIMD_NONE) {
+    i = YUYVToRGBaSSE41(yuyv, rgba, size);
+  }
+#endif
+  YUYVToRGBaScalar(yuyv + (2 * i), rgba + (4 * i), size - i);
+}
+
+void vp_UYVYToRGBa(const unsigned char *uyvy, unsigned char *rgba, unsigned int size)
+{
+  unsigned int i = 0;
+#if defined(VP_COLOR_CONVERSION_X86)
+  if (getSimdLevel() != SIMD_NONE) {
+    i = UYVYToRGBaSSE41(uyvy, rgba, size);
+  }
+#endif
+  UYVYToRGBaScalar(uyvy + (2 * i), rgba + (4 * i), size - i);
+}
+
+void vp_YUV420ToRGBa(const unsigned char *y0, const unsigned char *y1, const unsigned char *u, const unsigned char *v,
+                     unsigned char *rgba0, unsigned char *rgba1, unsigned int width)
+{
+  unsigned int j = 0;
+#if defined(VP_COLOR_CONVERSION_X86)
+  if (getSimdLevel() != SIMD_NONE) {
+    j = YUV420ToRGBaSSE41(y0, y1, u, v, rgba0, rgba1, width);
+  }
+#endif
+  YUV420ToRGBaScalar(y0 + j, y1 + j, u + (j / 2), v + (j / 2), rgba0 + (4 * j), rgba1 + (4 * j), width - j);
+}
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace
+{
+template <typename DepthType>
+unsigned int depthToPoints(const DepthType *depth, float depth_scale, const float *x, float y, float Z_min,
+                           float Z_max, float *X, float *Y, float *Z, unsigned int size)
+{
+  unsigned int j = 0;
+  unsigned int nbValid = 0;
+  switch (getSimdLevel()) {
+#if defined(VP_COLOR_CONVERSION_X86)
+  case SIMD_AVX2:
+    j = depthToPointsAVX2(depth, depth_scale, x, y, Z_min, Z_max, X, Y, Z, size, nbValid);
+    break;
+  case SIMD_SSE41:
+    j = depthToPointsSSE41(depth, depth_scale, x, y, Z_min, Z_max, X, Y, Z, size, nbValid);
+    break;
+#elif defined(VP_COLOR_CONVERSION_NEON)
+  case SIMD_NEON:
+    j = depthToPointsNEON(depth, depth_scale, x, y, Z_min, Z_max, X, Y, Z, size, nbValid);
+    break;
+#endif
+  default:
+    break;
+  }
+  return nbValid + depthToPointsScalar(depth + j, depth_scale, x + j, y, Z_min, Z_max, X + j, Y + j, Z + j, size - j);
+}
+} // namespace
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+unsigned int vp_depthToPoints(const uint16_t *depth, float depth_scale, const float *x, float y, float Z_min,
+                              float Z_max, float *X, float *Y, float *Z, unsigned int size)
+{
+  return depthToPoints(depth, depth_scale, x, y, Z_min, Z_max, X, Y, Z, size);
+}
+
+unsigned int vp_depthToPoints(const float *depth, const float *x, float y, float Z_min, float Z_max, float *X,
+                              float *Y, float *Z, unsigned int size)
+{
+  return depthToPoints(depth, 1.f, x, y, Z_min, Z_max, X, Y, Z, size);
+}
+END_VISP_NAMESPACE
@@ -40,6 +40,8 @@
 #include <visp3/core/vpConfig.h>
 #include <visp3/core/vpImageConvert.h>
 
+#include "private/vpImageConvert_simd.h"
+
 namespace
 {
 void vpSAT(int &c)
@@ -70,60 +72,9 @@ BEGIN_VISP_NAMESPACE
 */
 void vpImageConvert::YUYVToRGBa(unsigned char *yuyv, unsigned char *rgba, unsigned int width, unsigned int height)
 {
-  unsigned char *s;
-  unsigned char *d;
-  int w, h;
-  int r, g, b, cr, cg, cb, y1, y2;
-  const int val_2 = 2;
-  const int val_88 = 88;
-  const int val_128 = 128;
-  const int val_183 = 183;
-  const int val_256 = 256;
-  const int val_359 = 359;
-  const int val_454 = 454;
-
-  h = static_cast<int>(height);
-  w = static_cast<int>(width);
-  s = yuyv;
-  d = rgba;
-  while (h--) {
-    int c = w / val_2;
-    while (c--) {
-      y1 = *s;
-      ++s;
-      cb = ((*s - val_128) * val_454) / val_256;
-      cg = (*s - val_128) * val_88;
-      ++s;
-      y2 = *s;
-      ++s;
-      cr = ((*s - val_128) * val_359) / val_256;
-      cg = (cg + ((*s - val_128) * val_183)) / val_256;
-      ++s;
-
-      r = y1 + cr;
-      b = y1 + cb;
-      g = y1 - cg;
-      vpSAT(r);
-      vpSAT(g);
-      vpSAT(b);
-
-      *d++ = static_cast<unsigned char>(r);
-      *d++ = static_cast<unsigned char>(g);
-      *d++ = static_cast<unsigned char>(b);
-      *d++ = vpRGBa::alpha_default;
-
-      r = y2 + cr;
-      b = y2 + cb;
-      g = y2 - cg;
-      vpSAT(r);
-      vpSAT(g);
-      vpSAT(b);
-
-      *d++ = static_cast<unsigned char>(r);
-      *d++ = static_cast<unsigned char>(g);
-      *d++ = static_cast<unsigned char>(b);
-      *d++ = vpRGBa::alpha_default;
-    }
+  const unsigned int evenWidth = (width / 2) * 2;
+  for (unsigned int i = 0; i < height; ++i) {
+    vp_YUYVToRGBa(yuyv + (i * width * 2), rgba + (i * width * 4), evenWidth);
   }
 }
 
@@ -228,7 +179,7 @@ void vpImageConvert::YUYVToGrey(unsigned char *yuyv, unsigned char *grey, unsign
 */
 void vpImageConvert::YUV411ToRGBa(unsigned char *yuv, unsigned char *rgba, unsigned int size)
 {
-  const unsigned int val_128 = 128;
+  const int val_128 = 128;
   for (unsigned int i = size / 4; i; --i) {
     int U = static_cast<int>((*yuv - val_128) * 0.354);
     ++yuv;
@@ -325,51 +276,7 @@ void vpImageConvert::YUV411ToRGBa(unsigned char *yuv, unsigned char *rgba, unsig
 */
 void vpImageConvert::YUV422ToRGBa(unsigned char *yuv, unsigned char *rgba, unsigned int size)
 {
-  const unsigned int val_2 = 2;
-  const unsigned int val_128 = 128;
-  for (unsigned int i = size / val_2; i; --i) {
-    int U = static_cast<int>((*yuv - val_128) * 0.354);
-    ++yuv;
-    int U5 = 5 * U;
-    int Y0 = *yuv;
-    ++yuv;
-    int V = static_cast<int>((*yuv - val_128) * 0.707);
-    ++yuv;
-    int V2 = 2 * V;
-    int Y1 = *yuv;
-    ++yuv;
-    int UV = -U - V;
-
-    //---
-    int R = Y0 + V2;
-    vpSAT(R);
-
-    int G = Y0 + UV;
-    vpSAT(G);
-
-    int B = Y0 + U5;
-    vpSAT(B);
-
-    *rgba++ = static_cast<unsigned char>(R);
-    *rgba++ = static_cast<unsigned char>(G);
-    *rgba++ = static_cast<unsigned char>(B);
-    *rgba++ = vpRGBa::alpha_default;
-
-    //---
-    R = Y1 + V2;
-    vpSAT(R);
-
-    G = Y1 + UV;
-    vpSAT(G);
-
-    B = Y1 + U5;
-    vpSAT(B);
-
-    *rgba++ = static_cast<unsigned char>(R);
-    *rgba++ = static_cast<unsigned char>(G);
-    *rgba++ = static_cast<unsigned char>(B);
-    *rgba++ = vpRGBa::alpha_default;
-  }
+  vp_UYVYToRGBa(yuv, rgba, (size / 2) * 2);
 }
 
 /*!
@@ -414,7 +321,7 @@ void vpImageConvert::YUV411ToGrey(unsigned char *yuv, unsigned char *grey, unsig
 void vpImageConvert::YUV422ToRGB(unsigned char *yuv, unsigned char *rgb, unsigned int size)
 {
   const unsigned int val_2 = 2;
-  const unsigned int val_128 = 128;
+  const int val_128 = 128;
   for (unsigned int i = size / val_2; i; --i) {
     int U = static_cast<int>((*yuv - val_128) * 0.354);
     ++yuv;
@@ -492,7 +399,7 @@ void vpImageConvert::YUV422ToGrey(unsigned char *yuv, unsigned char *grey, unsig
 */
 void vpImageConvert::YUV411ToRGB(unsigned char *yuv, unsigned char *rgb, unsigned int size)
 {
-  const unsigned int val_128 = 128;
+  const int val_128 = 128;
   for (unsigned int i = size / 4; i; --i) {
     int U = static_cast<int>((*yuv - val_128) * 0.354);
     ++yuv;
@@ -583,102 +490,16 @@ void vpImageConvert::YUV411ToRGB(unsigned char *yuv, unsigned char *rgb, unsigne
 */
 void vpImageConvert::YUV420ToRGBa(unsigned char *yuv, unsigned char *rgba, unsigned int width, unsigned int height)
 {
-  int U, V, R, G, B, V2, U5, UV;
-  int Y0, Y1, Y2, Y3;
-  const unsigned int val_2 = 2;
-  const unsigned int val_4 = 4;
-  const unsigned int val_5 = 5;
-  const unsigned int val_7 = 7;
-  unsigned int size = width * height;
-  unsigned char *iU = yuv + size;
-  unsigned char *iV = yuv + ((val_5 * size) / val_4);
-  const unsigned int halfHeight = height / val_2, halfWidth = width / val_2;
-  const unsigned int val_128 = 128;
+  const unsigned int size = width * height;
+  const unsigned char *iU = yuv + size;
+  const unsigned char *iV = yuv + ((5 * size) / 4);
+  const unsigned int halfHeight = height / 2, halfWidth = width / 2;
+  // Each chroma row is shared by two luminance rows
   for (unsigned int i = 0; i < halfHeight; ++i) {
-    for (unsigned int j = 0; j < halfWidth; ++j) {
-      U = static_cast<int>(((*iU) - val_128) * 0.354);
-      ++iU;
-      U5 = val_5 * U;
-      V = static_cast<int>(((*iV) - val_128) * 0.707);
-      ++iV;
-      V2 = val_2 * V;
-      UV = -U - V;
-      Y0 = *yuv;
-      ++yuv;
-      Y1 = *yuv;
-      yuv = yuv + (width - 1);
-      Y2 = *yuv;
-      ++yuv;
-      Y3 = *yuv;
-      yuv = (yuv - width) + 1;
-
-      // Original equations
-      // R = Y           + 1.402 V
-      // G = Y - 0.344 U - 0.714 V
-      // B = Y + 1.772 U
-      R = Y0 + V2;
-      vpSAT(R);
-
-      G = Y0 + UV;
-      vpSAT(G);
-
-      B = Y0 + U5;
-      vpSAT(B);
-
-      *rgba++ = static_cast<unsigned char>(R);
-      *rgba++ = static_cast<unsigned char>(G);
-      *rgba++ = static_cast<unsigned char>(B);
-      *rgba++ = vpRGBa::alpha_default;
-
-      //---
-      R = Y1 + V2;
-      vpSAT(R);
-
-      G = Y1 + UV;
-      vpSAT(G);
-
-      B = Y1 + U5;
-      vpSAT(B);
-
-      *rgba++ = static_cast<unsigned char>(R);
-      *rgba++ = static_cast<unsigned char>(G);
-      *rgba++ = static_cast<unsigned char>(B);
-      *rgba = vpRGBa::alpha_default;
-      rgba = (rgba + (val_4 * width)) - val_7;
-
-      //---
-      R = Y2 + V2;
-      vpSAT(R);
-
-      G = Y2 + UV;
-      vpSAT(G);
-
-      B = Y2 + U5;
-      vpSAT(B);
-
-      *rgba++ = static_cast<unsigned char>(R);
-      *rgba++ = static_cast<unsigned char>(G);
-      *rgba++ = static_cast<unsigned char>(B);
-      *rgba++ = vpRGBa::alpha_default;
-
-      //---
-      R = Y3 + V2;
-      vpSAT(R);
-
-      G = Y3 + UV;
-      vpSAT(G);
-
-      B = Y3 + U5;
-      vpSAT(B);
-
-      *rgba++ = static_cast<unsigned char>(R);
-      *rgba++ = static_cast<unsigned char>(G);
-      *rgba++ = static_cast<unsigned char>(B);
-      *rgba = vpRGBa::alpha_default;
-      rgba = (rgba - (val_4 * width)) + 1;
-    }
-    yuv += width;
-    rgba += val_4 * width;
+    const unsigned char *y0 = yuv + (2 * i * width);
+    unsigned char *rgba0 = rgba + (2 * i * width * 4);
+    vp_YUV420ToRGBa(y0, y0 + width, iU + (i * halfWidth), iV + (i * halfWidth), rgba0, rgba0 + (width * 4),
+                    2 * halfWidth);
   }
 }
 
@@ -702,7 +523,7 @@ void vpImageConvert::YUV420ToRGB(unsigned char *yuv, unsigned char *rgb, unsigne
   unsigned char *iU = yuv + size;
   unsigned char *iV = yuv + ((val_5 * size) / val_4);
   const unsigned int halfHeight = height / val_2, halfWidth = width / val_2;
-  const unsigned int val_128 = 128;
+  const int val_128 = 128;
   for (unsigned int i = 0; i < halfHeight; ++i) {
     for (unsigned int j = 0; j < halfWidth; ++j) {
       U = static_cast<int>(((*iU) - val_128) * 0.354);
@@ -813,7 +634,7 @@ void vpImageConvert::YUV420ToGrey(unsigned char *yuv, unsigned char *grey, unsig
 */
 void vpImageConvert::YUV444ToRGBa(unsigned char *yuv, unsigned char *rgba, unsigned int size)
 {
-  const unsigned int val_128 = 128;
+  const int val_128 = 128;
   for (unsigned int i = 0; i < size; ++i) {
     int U = static_cast<int>((*yuv - val_128) * 0.354);
     ++yuv;
@@ -854,7 +675,7 @@ void vpImageConvert::YUV444ToRGBa(unsigned char *yuv, unsigned char *rgba, unsig
 */
 void vpImageConvert::YUV444ToRGB(unsigned char *yuv, unsigned char *rgb, unsigned int size)
 {
-  const unsigned int val_128 = 128;
+  const int val_128 = 128;
   for (unsigned int i = 0; i < size; ++i) {
     int U = static_cast<int>((*yuv - val_128) * 0.354);
     ++yuv;
@@ -924,7 +745,7 @@ void vpImageConvert::YV12ToRGBa(unsigned char *yuv, unsigned char *rgba, unsigne
   unsigned char *iV = yuv + size;
   unsigned char *iU = yuv + ((val_5 * size) / val_4);
   const unsigned int halfHeight = height / val_2, halfWidth = width / val_2;
-  const unsigned int val_128 = 128;
+  const int val_128 = 128;
   for (unsigned int i = 0; i < halfHeight; ++i) {
     for (unsigned int j = 0; j < halfWidth; ++j) {
       U = static_cast<int>(((*iU) - val_128) * 0.354);
@@ -1033,7 +854,7 @@ void vpImageConvert::YV12ToRGB(unsigned char *yuv, unsigned char *rgb, unsigned
   unsigned char *iV = yuv + size;
   unsigned char *iU = yuv + ((val_5 * size) / val_4);
   const unsigned int halfHeight = height / val_2, halfWidth = width / val_2;
-  const unsigned int val_128 = 128;
+  const int val_128 = 128;
   for (unsigned int i = 0; i < halfHeight; ++i) {
     for (unsigned int j = 0; j < halfWidth; ++j) {
       U = static_cast<int>(((*iU) - val_128) * 0.354);
@@ -1167,7 +988,7 @@ void vpImageConvert::YVU9ToRGBa(unsigned char *yuv, unsigned char *rgba, unsigne
   unsigned char *iV = yuv + size;
   unsigned char *iU = yuv + ((val_17 * size) / val_16);
   const unsigned int quarterHeight = height / val_4, quarterWidth = width / val_4;
-  const unsigned int val_128 = 128;
+  const int val_128 = 128;
   for (unsigned int i = 0; i < quarterHeight; ++i) {
     for (unsigned int j = 0; j < quarterWidth; ++j) {
       U = static_cast<int>(((*iU) - val_128) * 0.354);
@@ -1360,7 +1181,7 @@ void vpImageConvert::YVU9ToRGB(unsigned char *yuv, unsigned char *rgb, unsigned
   unsigned char *iV = yuv + size;
   unsigned char *iU = yuv + ((val_17 * size) / val_16);
   const unsigned int quarterHeight = height / val_4, quarterWidth = width / val_4;
-  const unsigned int val_128 = 128;
+  const int val_128 = 128;
   for (unsigned int i = 0; i < quarterHeight; ++i) {
     for (unsigned int j = 0; j < quarterWidth; ++j) {
       U = static_cast<int>((*iU - val_128) * 0.354);
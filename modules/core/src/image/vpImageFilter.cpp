@@ -124,14 +124,30 @@ void vpImageFilter::filter<double, double>(const vpImage<double> &I, vpImage<dou
   \param[out] If : Filtered image.
   \param[in] kernelH : Separable kernel (performed first).
   \param[in] kernelV : Separable kernel (performed last).
-  \note Only pixels in the input image fully covered by the kernel are considered.
+  \note Only pixels in the input image fully covered by the kernel are considered. When the kernels have different
+  sizes, the rows that are kept are given by the size of \e kernelV and the columns by the size of \e kernelH.
 */
 void vpImageFilter::sepFilter(const vpImage<unsigned char> &I, vpImage<double> &If, const vpColVector &kernelH,
                               const vpColVector &kernelV)
 {
   const unsigned int size = kernelH.size(), sizeV = kernelV.size();
   const unsigned int widthI = I.getWidth(), heightI = I.getHeight();
-  const unsigned int half_size = size / 2;
+  const unsigned int half_size = size / 2, half_sizeV = sizeV / 2;
+
+  if (((size % 2) == 1) && ((sizeV % 2) == 1)) {
+    vpImageFilter::sepFilter<unsigned char, double>(I, If, kernelH.data, size, kernelV.data, sizeV, true,
+                                                    BORDER_CONSTANT);
+    // Only keep the pixels fully covered by the kernels
+    for (unsigned int i = 0; i < heightI; ++i) {
+      const bool rowCovered = (i >= half_sizeV) && ((i + half_sizeV) < heightI);
+      for (unsigned int j = 0; j < widthI; ++j) {
+        if ((!rowCovered) || (j < half_size) || ((j + half_size) >= widthI)) {
+          If[i][j] = 0.0;
+        }
+      }
+    }
+    return;
+  }
 
   If.resize(heightI, widthI, 0.0);
   vpImage<double> I_filter(heightI, widthI, 0.0);
@@ -147,11 +163,11 @@ void vpImageFilter::sepFilter(const vpImage<unsigned char> &I, vpImage<double> &
     }
   }
 
-  for (unsigned int i = half_size; i < (heightI - half_size); ++i) {
+  for (unsigned int i = half_sizeV; i < (heightI - half_sizeV); ++i) {
     for (unsigned int j = 0; j < widthI; ++j) {
       double conv = 0.0;
       for (unsigned int a = 0; a < sizeV; ++a) {
-        conv += kernelV[a] * I_filter[(i + half_size) - a][j];
+        conv += kernelV[a] * I_filter[(i + half_sizeV) - a][j];
       }
 
       If[i][j] = conv;
@@ -159,6 +175,40 @@ void vpImageFilter::sepFilter(const vpImage<unsigned char> &I, vpImage<double> &
   }
 }
 
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace
+{
+/*
+ * Filter the R, G and B channels of a color image along one axis with the separable filters of the grayscale
+ * images, each channel being truncated to unsigned char as the color filters of vpImageFilter do.
+ */
+void filterRGBaChannels(const vpImage<vpRGBa> &I, vpImage<vpRGBa> &If, const double *filter, unsigned int size,
+                        bool alongX)
+{
+  const unsigned int npixels = I.getSize();
+  vpImage<unsigned char> channel(I.getHeight(), I.getWidth());
+  vpImage<double> channelFiltered;
+  If.resize(I.getHeight(), I.getWidth());
+  for (unsigned int c = 0; c < 3; ++c) {
+    const unsigned char *src = reinterpret_cast<const unsigned char *>(I.bitmap) + c;
+    for (unsigned int k = 0; k < npixels; ++k) {
+      channel.bitmap[k] = src[4 * k];
+    }
+    if (alongX) {
+      vpImageFilter::filterX<unsigned char, double>(channel, channelFiltered, filter, size);
+    }
+    else {
+      vpImageFilter::filterY<unsigned char, double>(channel, channelFiltered, filter, size);
+    }
+    unsigned char *dst = reinterpret_cast<unsigned char *>(If.bitmap) + c;
+    for (unsigned int k = 0; k < npixels; ++k) {
+      dst[4 * k] = static_cast<unsigned char>(channelFiltered.bitmap[k]);
+    }
+  }
+}
+} // namespace
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
 /**
  * \cond DO_NOT_DOCUMENT
  */
@@ -182,6 +232,10 @@ void vpImageFilter::filterX<double, double>(const vpImage<double> &I, vpImage<do
 void vpImageFilter::filterX(const vpImage<vpRGBa> &I, vpImage<vpRGBa> &dIx, const double *filter, unsigned int size,
                             const vpImage<bool> *p_mask)
 {
+  if (p_mask == nullptr) {
+    filterRGBaChannels(I, dIx, filter, size, true);
+    return;
+  }
   const unsigned int heightI = I.getHeight(), widthI = I.getWidth();
   const unsigned int stop1J = (size - 1) / 2;
   const unsigned int stop2J = widthI - ((size - 1) / 2);
@@ -244,6 +298,10 @@ void vpImageFilter::filterY<double, double>(const vpImage<double> &I, vpImage<do
 void vpImageFilter::filterY(const vpImage<vpRGBa> &I, vpImage<vpRGBa> &dIy, const double *filter, unsigned int size,
                             const vpImage<bool> *p_mask)
 {
+  if (p_mask == nullptr) {
+    filterRGBaChannels(I, dIy, filter, size, false);
+    return;
+  }
   const unsigned int heightI = I.getHeight(), widthI = I.getWidth();
   const unsigned int stop1I = (size - 1) / 2;
   const unsigned int stop2I = heightI - ((size - 1) / 2);
@@ -441,38 +499,6 @@ void vpImageFilter::getGaussPyramidal(const vpImage<unsigned char> &I, vpImage<u
 #endif
 }
 
-void vpImageFilter::getGaussXPyramidal(const vpImage<unsigned char> &I, vpImage<unsigned char> &GI)
-{
-  const unsigned int w = I.getWidth() / 2;
-  const unsigned int height = I.getHeight();
-  const unsigned int val_2 = 2;
-
-  GI.resize(height, w);
-  for (unsigned int i = 0; i < height; ++i) {
-    GI[i][0] = I[i][0];
-    for (unsigned int j = 1; j < (w - 1); ++j) {
-      GI[i][j] = vpImageFilter::filterGaussXPyramidal(I, i, val_2 * j);
-    }
-    GI[i][w - 1] = I[i][(val_2 * w) - 1];
-  }
-}
-
-void vpImageFilter::getGaussYPyramidal(const vpImage<unsigned char> &I, vpImage<unsigned char> &GI)
-{
-  const unsigned int h = I.getHeight() / 2;
-  const unsigned int width = I.getWidth();
-  const unsigned int val_2 = 2;
-
-  GI.resize(h, width);
-  for (unsigned int j = 0; j < width; ++j) {
-    GI[0][j] = I[0][j];
-    for (unsigned int i = 1; i < (h - 1); ++i) {
-      GI[i][j] = vpImageFilter::filterGaussYPyramidal(I, val_2 * i, j);
-    }
-    GI[h - 1][j] = I[(val_2 * h) - 1][j];
-  }
-}
-
 /**
  * \cond DO_NOT_DOCUMENT
  */
@@ -0,0 +1,223 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2024 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ *
+ * Description:
+ * Box filters based on integral images.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <visp3/core/vpConfig.h>
+#include <visp3/core/vpImageFilter.h>
+#include <visp3/core/vpIntegralImage.h>
+
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+
+BEGIN_VISP_NAMESPACE
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace
+{
+/*
+ * Call rowFunction(i, top, bottom, left, right, invArea) for each row i, where [top, bottom[ and
+ * left[j], right[j] define the box centered on the pixel (i, j) clipped to the image and invArea[j] the
+ * inverse of its area.
+ */
+template <typename RowFunction>
+void forEachBox(unsigned int height, unsigned int width, unsigned int halfSize, unsigned int nThreads,
+                RowFunction rowFunction)
+{
+  std::vector<unsigned int> left(width), right(width);
+  std::vector<double> invWidth(width);
+  for (unsigned int j = 0; j < width; ++j) {
+    left[j] = j > halfSize ? j - halfSize : 0;
+    right[j] = std::min<unsigned int>(j + halfSize + 1, width);
+    invWidth[j] = 1.0 / (right[j] - left[j]);
+  }
+
+  const int heightAsInt = static_cast<int>(height);
+#if defined(_OPENMP)
+  if (nThreads > 0) {
+    omp_set_num_threads(static_cast<int>(nThreads));
+  }
+#pragma omp parallel
+#else
+  (void)nThreads;
+#endif
+  {
+    std::vector<double> invArea(width);
+#if defined(_OPENMP)
+#pragma omp for
+#endif
+    for (int iAsInt = 0; iAsInt < heightAsInt; ++iAsInt) {
+      const unsigned int i = static_cast<unsigned int>(iAsInt);
+      const unsigned int top = i > halfSize ? i - halfSize : 0;
+      const unsigned int bottom = std::min<unsigned int>(i + halfSize + 1, height);
+      const double invHeight = 1.0 / (bottom - top);
+      for (unsigned int j = 0; j < width; ++j) {
+        invArea[j] = invHeight * invWidth[j];
+      }
+      rowFunction(i, top, bottom, left.data(), right.data(), invArea.data());
+    }
+  }
+}
+} // namespace
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+/*!
+  Apply a normalized box filter, that is the mean over a square window of size \f$ 2 \times halfSize + 1 \f$
+  centered on each pixel. Near the image borders, the window is clipped to the image.
+
+  The filter uses an integral image, so that the computation time does not depend on the window size.
+
+  \param[in] I : Input image.
+  \param[out] I_filtered : Filtered image, the mean being rounded to the nearest integer.
+  \param[in] halfSize : Half size of the window.
+  \param[in] nThreads : Number of threads to use when OpenMP is available. When 0, the OpenMP default is used.
+*/
+void vpImageFilter::boxFilter(const vpImage<unsigned char> &I, vpImage<unsigned char> &I_filtered,
+                              unsigned int halfSize, unsigned int nThreads)
+{
+  const vpIntegralImage II(I);
+  const vpImage<uint32_t> &S = II.getSum();
+  I_filtered.resize(I.getHeight(), I.getWidth());
+  forEachBox(I.getHeight(), I.getWidth(), halfSize, nThreads,
+             [&](unsigned int i, unsigned int top, unsigned int bottom, const unsigned int *left,
+                 const unsigned int *right, const double *invArea) {
+               const uint32_t *S_top = S[top];
+               const uint32_t *S_bottom = S[bottom];
+               unsigned char *dst = I_filtered[i];
+               for (unsigned int j = 0; j < I.getWidth(); ++j) {
+                 const uint32_t sum = ((S_bottom[right[j]] - S_top[right[j]]) - S_bottom[left[j]]) + S_top[left[j]];
+                 dst[j] = static_cast<unsigned char>((sum * invArea[j]) + 0.5);
+               }
+             });
+}
+
+/*!
+  Apply a normalized box filter, that is the mean over a square window of size \f$ 2 \times halfSize + 1 \f$
+  centered on each pixel. Near the image borders, the window is clipped to the image.
+
+  \param[in] I : Input image.
+  \param[out] I_filtered : Filtered image.
+  \param[in] halfSize : Half size of the window.
+  \param[in] nThreads : Number of threads to use when OpenMP is available. When 0, the OpenMP default is used.
+*/
+void vpImageFilter::boxFilter(const vpImage<unsigned char> &I, vpImage<float> &I_filtered, unsigned int halfSize,
+                              unsigned int nThreads)
+{
+  boxFilter(vpIntegralImage(I), I_filtered, halfSize, nThreads);
+}
+
+/*!
+  Apply a normalized box filter to the image an integral image is computed from. This allows to apply
+  several box filters of different sizes without computing the integral image again.
+
+  \param[in] II : Integral image of the input image.
+  \param[out] I_filtered : Filtered image.
+  \param[in] halfSize : Half size of the window.
+  \param[in] nThreads : Number of threads to use when OpenMP is available. When 0, the OpenMP default is used.
+*/
+void vpImageFilter::boxFilter(const vpIntegralImage &II, vpImage<float> &I_filtered, unsigned int halfSize,
+                              unsigned int nThreads)
+{
+  const vpImage<uint32_t> &S = II.getSum();
+  I_filtered.resize(II.getHeight(), II.getWidth());
+  forEachBox(II.getHeight(), II.getWidth(), halfSize, nThreads,
+             [&](unsigned int i, unsigned int top, unsigned int bottom, const unsigned int *left,
+                 const unsigned int *right, const double *invArea) {
+               const uint32_t *S_top = S[top];
+               const uint32_t *S_bottom = S[bottom];
+               float *dst = I_filtered[i];
+               for (unsigned int j = 0; j < II.getWidth(); ++j) {
+                 const uint32_t sum = ((S_bottom[right[j]] - S_top[right[j]]) - S_bottom[left[j]]) + S_top[left[j]];
+                 dst[j] = static_cast<float>(sum * invArea[j]);
+               }
+             });
+}
+
+/*!
+  Compute the mean and the standard deviation over a square window of size \f$ 2 \times halfSize + 1 \f$
+  centered on each pixel, as used for instance by adaptive thresholding methods. Near the image borders, the
+  window is clipped to the image.
+
+  \param[in] I : Input image.
+  \param[out] I_mean : Local mean.
+  \param[out] I_stdev : Local standard deviation.
+  \param[in] halfSize : Half size of the window.
+  \param[in] nThreads : Number of threads to use when OpenMP is available. When 0, the OpenMP default is used.
+*/
+void vpImageFilter::localMeanAndStdev(const vpImage<unsigned char> &I, vpImage<float> &I_mean,
+                                      vpImage<float> &I_stdev, unsigned int halfSize, unsigned int nThreads)
+{
+  localMeanAndStdev(vpIntegralImage(I, true), I_mean, I_stdev, halfSize, nThreads);
+}
+
+/*!
+  Compute the local mean and standard deviation of the image an integral image is computed from.
+
+  \param[in] II : Integral images of the input image, with the integral image of the squared pixels.
+  \param[out] I_mean : Local mean.
+  \param[out] I_stdev : Local standard deviation.
+  \param[in] halfSize : Half size of the window.
+  \param[in] nThreads : Number of threads to use when OpenMP is available. When 0, the OpenMP default is used.
+*/
+void vpImageFilter::localMeanAndStdev(const vpIntegralImage &II, vpImage<float> &I_mean, vpImage<float> &I_stdev,
+                                      unsigned int halfSize, unsigned int nThreads)
+{
+  if (!II.hasSquaredSum()) {
+    throw(vpException(vpException::badValue, "The integral image of the squared pixels is not computed"));
+  }
+  const vpImage<uint32_t> &S = II.getSum();
+  const vpImage<uint64_t> &Ssq = II.getSquaredSum();
+  I_mean.resize(II.getHeight(), II.getWidth());
+  I_stdev.resize(II.getHeight(), II.getWidth());
+  forEachBox(II.getHeight(), II.getWidth(), halfSize, nThreads,
+             [&](unsigned int i, unsigned int top, unsigned int bottom, const unsigned int *left,
+                 const unsigned int *right, const double *invArea) {
+               const uint32_t *S_top = S[top];
+               const uint32_t *S_bottom = S[bottom];
+               const uint64_t *Ssq_top = Ssq[top];
+               const uint64_t *Ssq_bottom = Ssq[bottom];
+               for (unsigned int j = 0; j < II.getWidth(); ++j) {
+                 const uint32_t sum = ((S_bottom[right[j]] - S_top[right[j]]) - S_bottom[left[j]]) + S_top[left[j]];
+                 const uint64_t sq_sum =
+                   ((Ssq_bottom[right[j]] - Ssq_top[right[j]]) - Ssq_bottom[left[j]]) + Ssq_top[left[j]];
+                 const double mean = sum * invArea[j];
+                 const double variance = (sq_sum * invArea[j]) - (mean * mean);
+                 I_mean[i][j] = static_cast<float>(mean);
+                 I_stdev[i][j] = variance > 0. ? static_cast<float>(std::sqrt(variance)) : 0.f;
+               }
+             });
+}
+END_VISP_NAMESPACE
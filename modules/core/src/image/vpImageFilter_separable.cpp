@@ -0,0 +1,537 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2024 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ *
+ * Description:
+ * Separable filtering engine and Gaussian pyramid.
+ */
+
+#include <algorithm>
+#include <vector>
+
+#include <visp3/core/vpConfig.h>
+#include <visp3/core/vpImageFilter.h>
+
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define VISP_HAVE_SSE2 1
+#endif
+
+#if defined _M_ARM64 || (defined __ARM_NEON && defined __aarch64__)
+#include <arm_neon.h>
+#define VISP_HAVE_NEON 1
+#endif
+
+BEGIN_VISP_NAMESPACE
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace
+{
+// Minimal number of rows processed by a thread
+const unsigned int minRowsPerThread = 16;
+
+typedef enum vpKernelSymmetry
+{
+  KERNEL_SYMMETRIC,
+  KERNEL_ANTISYMMETRIC, // With a null central coefficient
+  KERNEL_GENERIC
+} vpKernelSymmetry;
+
+// Correlation kernel of odd size
+template <typename FilterType> struct vpKernel1D
+{
+  std::vector<FilterType> m_coeffs;
+  unsigned int m_half;
+  vpKernelSymmetry m_symmetry;
+  bool m_identity;
+};
+
+template <typename FilterType>
+void initKernel(const FilterType *kernel, unsigned int size, bool convolve, vpKernel1D<FilterType> &k)
+{
+  if ((kernel == nullptr) || ((size % 2) == 0)) {
+    throw(vpException(vpException::dimensionError, "The kernels of a separable filter must have an odd size"));
+  }
+  k.m_coeffs.resize(size);
+  for (unsigned int a = 0; a < size; ++a) {
+    k.m_coeffs[a] = convolve ? kernel[size - 1 - a] : kernel[a];
+  }
+  const unsigned int half = size / 2;
+  const FilterType *c = &k.m_coeffs[half];
+  bool symmetric = true;
+  bool antisymmetric = (c[0] == 0);
+  for (unsigned int i = 1; i <= half; ++i) {
+    symmetric = symmetric && (c[i] == c[-static_cast<int>(i)]);
+    antisymmetric = antisymmetric && (c[i] == -c[-static_cast<int>(i)]);
+  }
+  k.m_half = half;
+  k.m_symmetry = symmetric ? KERNEL_SYMMETRIC : (antisymmetric ? KERNEL_ANTISYMMETRIC : KERNEL_GENERIC);
+  k.m_identity = (size == 1) && (c[0] == 1);
+}
+
+// Index of the pixel read at the position p of a line of n pixels, -1 for a null pixel
+int borderIndex(int p, int n, vpImageFilter::vpBorderType border)
+{
+  if ((p >= 0) && (p < n)) {
+    return p;
+  }
+  if (border == vpImageFilter::BORDER_CONSTANT) {
+    return -1;
+  }
+  if ((border == vpImageFilter::BORDER_REPLICATE) || (n == 1)) {
+    return std::min<int>(std::max<int>(p, 0), n - 1);
+  }
+  // Mirrored positions may still be outside the line when the kernel is larger than the image
+  while ((p < 0) || (p >= n)) {
+    if (p < 0) {
+      p = (border == vpImageFilter::BORDER_REFLECT) ? (-p - 1) : -p;
+    }
+    else {
+      p = (border == vpImageFilter::BORDER_REFLECT_101) ? ((2 * n) - p - 2) : ((2 * n) - p - 1);
+    }
+  }
+  return p;
+}
+
+// Vectorized part of applyKernel(), returning the number of pixels processed
+template <typename FilterType>
+unsigned int applyKernelSimd(const FilterType *const *, const vpKernel1D<FilterType> &, FilterType *, unsigned int)
+{
+  return 0;
+}
+
+#if defined(VISP_HAVE_SSE2) || defined(VISP_HAVE_NEON)
+#if defined(VISP_HAVE_SSE2)
+typedef __m128 vpFloat4;
+inline vpFloat4 load4(const float *p) { return _mm_loadu_ps(p); }
+inline void store4(float *p, const vpFloat4 &v) { _mm_storeu_ps(p, v); }
+inline vpFloat4 zero4() { return _mm_setzero_ps(); }
+inline vpFloat4 add4(const vpFloat4 &a, const vpFloat4 &b) { return _mm_add_ps(a, b); }
+inline vpFloat4 sub4(const vpFloat4 &a, const vpFloat4 &b) { return _mm_sub_ps(a, b); }
+inline vpFloat4 mul4(const vpFloat4 &a, float b) { return _mm_mul_ps(a, _mm_set1_ps(b)); }
+#else
+typedef float32x4_t vpFloat4;
+inline vpFloat4 load4(const float *p) { return vld1q_f32(p); }
+inline void store4(float *p, const vpFloat4 &v) { vst1q_f32(p, v); }
+inline vpFloat4 zero4() { return vdupq_n_f32(0.f); }
+inline vpFloat4 add4(const vpFloat4 &a, const vpFloat4 &b) { return vaddq_f32(a, b); }
+inline vpFloat4 sub4(const vpFloat4 &a, const vpFloat4 &b) { return vsubq_f32(a, b); }
+inline vpFloat4 mul4(const vpFloat4 &a, float b) { return vmulq_n_f32(a, b); }
+#endif
+
+// Same operations in the same order as the scalar code of applyKernel(), 8 pixels at a time
+unsigned int applyKernelSimd(const float *const *src, const vpKernel1D<float> &k, float *dst, unsigned int width)
+{
+  const unsigned int half = k.m_half;
+  const float *c = &k.m_coeffs[0];
+  const float *const *s = src + half;
+  unsigned int j = 0;
+  if (k.m_symmetry == KERNEL_SYMMETRIC) {
+    for (; (j + 8) <= width; j += 8) {
+      vpFloat4 acc0 = zero4(), acc1 = zero4();
+      for (unsigned int i = 1; i <= half; ++i) {
+        const float *p = s[i] + j, *m = s[-static_cast<int>(i)] + j;
+        acc0 = add4(acc0, mul4(add4(load4(p), load4(m)), c[half + i]));
+        acc1 = add4(acc1, mul4(add4(load4(p + 4), load4(m + 4)), c[half + i]));
+      }
+      store4(dst + j, add4(acc0, mul4(load4(s[0] + j), c[half])));
+      store4(dst + j + 4, add4(acc1, mul4(load4(s[0] + j + 4), c[half])));
+    }
+  }
+  else if (k.m_symmetry == KERNEL_ANTISYMMETRIC) {
+    for (; (j + 8) <= width; j += 8) {
+      vpFloat4 acc0 = zero4(), acc1 = zero4();
+      for (unsigned int i = 1; i <= half; ++i) {
+        const float *p = s[i] + j, *m = s[-static_cast<int>(i)] + j;
+        acc0 = add4(acc0, mul4(sub4(load4(p), load4(m)), c[half + i]));
+        acc1 = add4(acc1, mul4(sub4(load4(p + 4), load4(m + 4)), c[half + i]));
+      }
+      store4(dst + j, acc0);
+      store4(dst + j + 4, acc1);
+    }
+  }
+  else {
+    const unsigned int size = static_cast<unsigned int>(k.m_coeffs.size());
+    for (; (j + 8) <= width; j += 8) {
+      vpFloat4 acc0 = zero4(), acc1 = zero4();
+      for (unsigned int t = 0; t < size; ++t) {
+        acc0 = add4(acc0, mul4(load4(src[t] + j), c[t]));
+        acc1 = add4(acc1, mul4(load4(src[t] + j + 4), c[t]));
+      }
+      store4(dst + j, acc0);
+      store4(dst + j + 4, acc1);
+    }
+  }
+  return j;
+}
+#endif
+
+/*
+ * dst[j] = sum_t k[t] * src[t][j]. The symmetric and antisymmetric kernels add or subtract the symmetric pixels
+ * before the multiplication, in the same order as the historical filters of vpImageFilter.
+ */
+template <typename FilterType>
+void applyKernel(const FilterType *const *src, const vpKernel1D<FilterType> &k, FilterType *dst, unsigned int width)
+{
+  const unsigned int half = k.m_half;
+  const FilterType *c = &k.m_coeffs[0];
+  const FilterType *const *s = src + half;
+  unsigned int j = applyKernelSimd(src, k, dst, width);
+  if (k.m_symmetry == KERNEL_SYMMETRIC) {
+    for (; j < width; ++j) {
+      FilterType acc = static_cast<FilterType>(0);
+      for (unsigned int i = 1; i <= half; ++i) {
+        acc += c[half + i] * (s[i][j] + s[-static_cast<int>(i)][j]);
+      }
+      dst[j] = acc + (c[half] * s[0][j]);
+    }
+  }
+  else if (k.m_symmetry == KERNEL_ANTISYMMETRIC) {
+    for (; j < width; ++j) {
+      FilterType acc = static_cast<FilterType>(0);
+      for (unsigned int i = 1; i <= half; ++i) {
+        acc += c[half + i] * (s[i][j] - s[-static_cast<int>(i)][j]);
+      }
+      dst[j] = acc;
+    }
+  }
+  else {
+    const unsigned int size = static_cast<unsigned int>(k.m_coeffs.size());
+    for (; j < width; ++j) {
+      FilterType acc = static_cast<FilterType>(0);
+      for (unsigned int t = 0; t < size; ++t) {
+        acc += c[t] * src[t][j];
+      }
+      dst[j] = acc;
+    }
+  }
+}
+
+/*
+ * Filter the rows [rowStart, rowEnd[ of the image. The horizontally filtered rows are kept in a cache of as many
+ * rows as the vertical kernel, the source row r being stored in the slot r % sizeY, so that each of them is
+ * computed once when going down the image.
+ */
+template <typename ImageType, typename FilterType>
+void sepFilterRows(const vpImage<ImageType> &I, vpImage<FilterType> &If, const vpKernel1D<FilterType> &kx,
+                   const vpKernel1D<FilterType> &ky, vpImageFilter::vpBorderType border, unsigned int rowStart,
+                   unsigned int rowEnd)
+{
+  const int height = static_cast<int>(I.getHeight()), width = static_cast<int>(I.getWidth());
+  const int hx = static_cast<int>(kx.m_half), hy = static_cast<int>(ky.m_half);
+  const unsigned int sizeX = static_cast<unsigned int>(kx.m_coeffs.size());
+  const unsigned int sizeY = static_cast<unsigned int>(ky.m_coeffs.size());
+
+  std::vector<FilterType> paddedRow(static_cast<size_t>(width + (2 * hx)));
+  std::vector<const FilterType *> tapsX(sizeX), tapsY(sizeY);
+  for (unsigned int t = 0; t < sizeX; ++t) {
+    tapsX[t] = &paddedRow[t];
+  }
+  std::vector<FilterType> cache(ky.m_identity ? 0 : (static_cast<size_t>(sizeY) * width));
+  std::vector<int> cachedRows(sizeY, -1);
+  std::vector<FilterType> zeroRow(static_cast<size_t>(width), static_cast<FilterType>(0));
+
+  for (unsigned int i = rowStart; i < rowEnd; ++i) {
+    FilterType *dst = If[i];
+    for (int t = 0; t < static_cast<int>(sizeY); ++t) {
+      const int r = borderIndex(static_cast<int>(i) + t - hy, height, border);
+      if (r < 0) {
+        tapsY[t] = &zeroRow[0];
+        continue;
+      }
+      FilterType *rowX = ky.m_identity ? dst : &cache[static_cast<size_t>(r % sizeY) * width];
+      if ((!ky.m_identity) && (cachedRows[r % sizeY] == r)) {
+        tapsY[t] = rowX;
+        continue;
+      }
+      // Horizontal pass of the source row r
+      const ImageType *src = I[r];
+      if (kx.m_identity) {
+        for (int j = 0; j < width; ++j) {
+          rowX[j] = static_cast<FilterType>(src[j]);
+        }
+      }
+      else {
+        FilterType *row = &paddedRow[hx];
+        for (int j = 0; j < width; ++j) {
+          row[j] = static_cast<FilterType>(src[j]);
+        }
+        for (int p = 1; p <= hx; ++p) {
+          const int left = borderIndex(-p, width, border), right = borderIndex((width - 1) + p, width, border);
+          row[-p] = (left < 0) ? static_cast<FilterType>(0) : static_cast<FilterType>(src[left]);
+          row[(width - 1) + p] = (right < 0) ? static_cast<FilterType>(0) : static_cast<FilterType>(src[right]);
+        }
+        applyKernel(&tapsX[0], kx, rowX, static_cast<unsigned int>(width));
+      }
+      if (!ky.m_identity) {
+        cachedRows[r % sizeY] = r;
+      }
+      tapsY[t] = rowX;
+    }
+    if (!ky.m_identity) {
+      // Vertical pass
+      applyKernel(&tapsY[0], ky, dst, static_cast<unsigned int>(width));
+    }
+  }
+}
+
+// Number of bands of rows processed in parallel
+unsigned int getNbBands(unsigned int height, unsigned int nThreads)
+{
+#if defined(_OPENMP)
+  const unsigned int maxThreads = (nThreads > 0) ? nThreads : static_cast<unsigned int>(omp_get_max_threads());
+#else
+  (void)nThreads;
+  const unsigned int maxThreads = 1;
+#endif
+  return std::max<unsigned int>(1, std::min<unsigned int>(maxThreads, height / minRowsPerThread));
+}
+
+// dst[j] = (r0[j] + 4 r1[j] + 6 r2[j] + 4 r3[j] + r4[j]) / 16
+void gaussPyramidalRows(const unsigned char *r0, const unsigned char *r1, const unsigned char *r2,
+                        const unsigned char *r3, const unsigned char *r4, unsigned char *dst, unsigned int width)
+{
+  unsigned int j = 0;
+#if defined(VISP_HAVE_SSE2)
+  const __m128i zero = _mm_setzero_si128();
+  for (; (j + 16) <= width; j += 16) {
+    const __m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(r0 + j));
+    const __m128i v1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(r1 + j));
+    const __m128i v2 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(r2 + j));
+    const __m128i v3 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(r3 + j));
+    const __m128i v4 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(r4 + j));
+    __m128i res[2];
+    for (int h = 0; h < 2; ++h) {
+      const __m128i a = h ? _mm_unpackhi_epi8(v0, zero) : _mm_unpacklo_epi8(v0, zero);
+      const __m128i b = h ? _mm_unpackhi_epi8(v1, zero) : _mm_unpacklo_epi8(v1, zero);
+      const __m128i c = h ? _mm_unpackhi_epi8(v2, zero) : _mm_unpacklo_epi8(v2, zero);
+      const __m128i d = h ? _mm_unpackhi_epi8(v3, zero) : _mm_unpacklo_epi8(v3, zero);
+      const __m128i e = h ? _mm_unpackhi_epi8(v4, zero) : _mm_unpacklo_epi8(v4, zero);
+      __m128i sum = _mm_add_epi16(_mm_add_epi16(a, e), _mm_slli_epi16(_mm_add_epi16(b, d), 2));
+      sum = _mm_add_epi16(sum, _mm_add_epi16(_mm_slli_epi16(c, 2), _mm_slli_epi16(c, 1)));
+      res[h] = _mm_srli_epi16(sum, 4);
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + j), _mm_packus_epi16(res[0], res[1]));
+  }
+#elif defined(VISP_HAVE_NEON)
+  for (; (j + 8) <= width; j += 8) {
+    const uint16x8_t a = vmovl_u8(vld1_u8(r0 + j)), b = vmovl_u8(vld1_u8(r1 + j)), c = vmovl_u8(vld1_u8(r2 + j));
+    const uint16x8_t d = vmovl_u8(vld1_u8(r3 + j)), e = vmovl_u8(vld1_u8(r4 + j));
+    uint16x8_t sum = vaddq_u16(vaddq_u16(a, e), vshlq_n_u16(vaddq_u16(b, d), 2));
+    sum = vaddq_u16(sum, vmulq_n_u16(c, 6));
+    vst1_u8(dst + j, vshrn_n_u16(sum, 4));
+  }
+#endif
+  for (; j < width; ++j) {
+    dst[j] = static_cast<unsigned char>((r0[j] + (4 * r1[j]) + (6 * r2[j]) + (4 * r3[j]) + r4[j]) >> 4);
+  }
+}
+} // namespace
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+/*!
+  Apply a separable filter, that is a horizontal filter followed by a vertical one, as a single pass over the
+  image: each row filtered horizontally is kept in a cache of as many rows as the vertical kernel, so that it is
+  computed once. Near the borders, the pixels outside the image are extrapolated according to \e border.
+
+  Symmetric kernels, and antisymmetric ones with a null central coefficient such as derivative kernels, are
+  detected to halve the number of multiplications. The computations are vectorized for \e float filters
+  (SSE2 or NEON), and bands of rows are processed in parallel when OpenMP is available.
+
+  \tparam ImageType : unsigned char, float or double.
+  \tparam FilterType : float, or double when ImageType is unsigned char or double.
+  \param[in] I : Image to filter.
+  \param[out] If : Filtered image. It can be the input image.
+  \param[in] kernelX : Horizontal kernel of \e sizeX coefficients.
+  \param[in] sizeX : Size of the horizontal kernel, which must be odd. A kernel of size 1 whose coefficient is 1
+  leaves the rows unchanged.
+  \param[in] kernelY : Vertical kernel of \e sizeY coefficients.
+  \param[in] sizeY : Size of the vertical kernel, which must be odd.
+  \param[in] convolve : If true, compute a convolution, a correlation otherwise.
+  \param[in] border : Border extrapolation method. The default one is the one of filterX() and filterY().
+  \param[in] nThreads : Number of threads to use when OpenMP is available. When 0, the OpenMP default is used.
+
+  \sa filterX(), filterY(), gaussianBlur()
+*/
+template <typename ImageType, typename FilterType>
+void vpImageFilter::sepFilter(const vpImage<ImageType> &I, vpImage<FilterType> &If, const FilterType *kernelX,
+                              unsigned int sizeX, const FilterType *kernelY, unsigned int sizeY, bool convolve,
+                              const vpBorderType &border, unsigned int nThreads)
+{
+  vpKernel1D<FilterType> kx, ky;
+  initKernel(kernelX, sizeX, convolve, kx);
+  initKernel(kernelY, sizeY, convolve, ky);
+
+  if (static_cast<const void *>(&I) == static_cast<const void *>(&If)) {
+    // Filtering in place: the rows of the input image are needed after the output ones are written
+    const vpImage<ImageType> I_copy = I;
+    sepFilter(I_copy, If, kernelX, sizeX, kernelY, sizeY, convolve, border, nThreads);
+    return;
+  }
+
+  const unsigned int height = I.getHeight();
+  If.resize(height, I.getWidth());
+  if (I.getSize() == 0) {
+    return;
+  }
+
+  const int nbBands = static_cast<int>(getNbBands(height, nThreads));
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static, 1) num_threads(nbBands)
+#endif
+  for (int band = 0; band < nbBands; ++band) {
+    const unsigned int rowStart = static_cast<unsigned int>((static_cast<size_t>(band) * height) / nbBands);
+    const unsigned int rowEnd = static_cast<unsigned int>((static_cast<size_t>(band + 1) * height) / nbBands);
+    sepFilterRows(I, If, kx, ky, border, rowStart, rowEnd);
+  }
+}
+
+/**
+ * \cond DO_NOT_DOCUMENT
+ */
+template
+void vpImageFilter::sepFilter<unsigned char, float>(const vpImage<unsigned char> &I, vpImage<float> &If,
+                                                    const float *kernelX, unsigned int sizeX, const float *kernelY,
+                                                    unsigned int sizeY, bool convolve, const vpBorderType &border,
+                                                    unsigned int nThreads);
+
+template
+void vpImageFilter::sepFilter<unsigned char, double>(const vpImage<unsigned char> &I, vpImage<double> &If,
+                                                     const double *kernelX, unsigned int sizeX, const double *kernelY,
+                                                     unsigned int sizeY, bool convolve, const vpBorderType &border,
+                                                     unsigned int nThreads);
+
+template
+void vpImageFilter::sepFilter<float, float>(const vpImage<float> &I, vpImage<float> &If, const float *kernelX,
+                                            unsigned int sizeX, const float *kernelY, unsigned int sizeY,
+                                            bool convolve, const vpBorderType &border, unsigned int nThreads);
+
+template
+void vpImageFilter::sepFilter<double, double>(const vpImage<double> &I, vpImage<double> &If, const double *kernelX,
+                                              unsigned int sizeX, const double *kernelY, unsigned int sizeY,
+                                              bool convolve, const vpBorderType &border, unsigned int nThreads);
+/**
+ * \endcond
+ */
+
+/*!
+  Filter the rows of an image with the 5-tap Gaussian kernel [1 4 6 4 1]/16 and keep one column out of two.
+  The first and last columns of the output are copied from the input image.
+
+  \param[in] I : Input image.
+  \param[out] GI : Image of half the width of the input one.
+*/
+void vpImageFilter::getGaussXPyramidal(const vpImage<unsigned char> &I, vpImage<unsigned char> &GI)
+{
+  const unsigned int w = I.getWidth() / 2;
+  const unsigned int height = I.getHeight();
+  const unsigned int val_2 = 2;
+
+  GI.resize(height, w);
+  if (w == 0) {
+    return;
+  }
+  const int nbBands = static_cast<int>(getNbBands(height, 0));
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static) num_threads(nbBands)
+#endif
+  for (int iAsInt = 0; iAsInt < static_cast<int>(height); ++iAsInt) {
+    const unsigned int i = static_cast<unsigned int>(iAsInt);
+    const unsigned char *src = I[i];
+    unsigned char *dst = GI[i];
+    dst[0] = src[0];
+    unsigned int j = 1;
+#if defined(VISP_HAVE_SSE2)
+    // The even and odd columns are the low and high bytes of the 16-bit lanes
+    const __m128i lowBytes = _mm_set1_epi16(0x00FF);
+    for (; (j + 9) <= w; j += 8) {
+      const unsigned char *p = src + ((val_2 * j) - 2);
+      const __m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+      const __m128i v1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + 2));
+      const __m128i v2 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + 4));
+      const __m128i a = _mm_and_si128(v0, lowBytes), b = _mm_srli_epi16(v0, 8);
+      const __m128i c = _mm_and_si128(v1, lowBytes), d = _mm_srli_epi16(v1, 8);
+      const __m128i e = _mm_and_si128(v2, lowBytes);
+      __m128i sum = _mm_add_epi16(_mm_add_epi16(a, e), _mm_slli_epi16(_mm_add_epi16(b, d), 2));
+      sum = _mm_add_epi16(sum, _mm_add_epi16(_mm_slli_epi16(c, 2), _mm_slli_epi16(c, 1)));
+      const __m128i res = _mm_srli_epi16(sum, 4);
+      _mm_storel_epi64(reinterpret_cast<__m128i *>(dst + j), _mm_packus_epi16(res, res));
+    }
+#elif defined(VISP_HAVE_NEON)
+    for (; (j + 9) <= w; j += 8) {
+      const unsigned char *p = src + ((val_2 * j) - 2);
+      const uint8x8x2_t v0 = vld2_u8(p), v1 = vld2_u8(p + 2), v2 = vld2_u8(p + 4);
+      const uint16x8_t a = vmovl_u8(v0.val[0]), b = vmovl_u8(v0.val[1]);
+      const uint16x8_t c = vmovl_u8(v1.val[0]), d = vmovl_u8(v1.val[1]);
+      const uint16x8_t e = vmovl_u8(v2.val[0]);
+      uint16x8_t sum = vaddq_u16(vaddq_u16(a, e), vshlq_n_u16(vaddq_u16(b, d), 2));
+      sum = vaddq_u16(sum, vmulq_n_u16(c, 6));
+      vst1_u8(dst + j, vshrn_n_u16(sum, 4));
+    }
+#endif
+    for (; j < (w - 1); ++j) {
+      dst[j] = vpImageFilter::filterGaussXPyramidal(I, i, val_2 * j);
+    }
+    dst[w - 1] = src[(val_2 * w) - 1];
+  }
+}
+
+/*!
+  Filter the columns of an image with the 5-tap Gaussian kernel [1 4 6 4 1]/16 and keep one row out of two.
+  The first and last rows of the output are copied from the input image.
+
+  \param[in] I : Input image.
+  \param[out] GI : Image of half the height of the input one.
+*/
+void vpImageFilter::getGaussYPyramidal(const vpImage<unsigned char> &I, vpImage<unsigned char> &GI)
+{
+  const unsigned int h = I.getHeight() / 2;
+  const unsigned int width = I.getWidth();
+  const unsigned int val_2 = 2;
+
+  GI.resize(h, width);
+  if (h == 0) {
+    return;
+  }
+  std::copy(I[0], I[0] + width, GI[0]);
+  const int nbBands = static_cast<int>(getNbBands(h, 0));
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static) num_threads(nbBands)
+#endif
+  for (int iAsInt = 1; iAsInt < (static_cast<int>(h) - 1); ++iAsInt) {
+    const unsigned int r = val_2 * static_cast<unsigned int>(iAsInt);
+    gaussPyramidalRows(I[r - 2], I[r - 1], I[r], I[r + 1], I[r + 2], GI[iAsInt], width);
+  }
+  std::copy(I[(val_2 * h) - 1], I[(val_2 * h) - 1] + width, GI[h - 1]);
+}
+
+END_VISP_NAMESPACE
@@ -0,0 +1,152 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2024 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ *
+ * Description:
+ * Vectorized 3x3 erosion and dilatation.
+ */
+
+#include <algorithm>
+
+#include <visp3/core/vpImageMorphology.h>
+
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define VISP_HAVE_SSE2 1
+#endif
+
+#if defined _M_ARM64 || (defined __ARM_NEON && defined __aarch64__)
+#include <arm_neon.h>
+#define VISP_HAVE_NEON 1
+#endif
+
+BEGIN_VISP_NAMESPACE
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace
+{
+inline unsigned char minMax(unsigned char a, unsigned char b, bool isMin)
+{
+  return isMin ? std::min<unsigned char>(a, b) : std::max<unsigned char>(a, b);
+}
+
+// dst[j] = min or max of a[j], b[j] and c[j]
+void minMax3(const unsigned char *a, const unsigned char *b, const unsigned char *c, unsigned char *dst,
+             unsigned int size, bool isMin)
+{
+  unsigned int j = 0;
+#if defined(VISP_HAVE_SSE2)
+  if (isMin) {
+    for (; (j + 16) <= size; j += 16) {
+      const __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + j));
+      const __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + j));
+      const __m128i vc = _mm_loadu_si128(reinterpret_cast<const __m128i *>(c + j));
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + j), _mm_min_epu8(_mm_min_epu8(va, vb), vc));
+    }
+  }
+  else {
+    for (; (j + 16) <= size; j += 16) {
+      const __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + j));
+      const __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + j));
+      const __m128i vc = _mm_loadu_si128(reinterpret_cast<const __m128i *>(c + j));
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + j), _mm_max_epu8(_mm_max_epu8(va, vb), vc));
+    }
+  }
+#elif defined(VISP_HAVE_NEON)
+  if (isMin) {
+    for (; (j + 16) <= size; j += 16) {
+      vst1q_u8(dst + j, vminq_u8(vminq_u8(vld1q_u8(a + j), vld1q_u8(b + j)), vld1q_u8(c + j)));
+    }
+  }
+  else {
+    for (; (j + 16) <= size; j += 16) {
+      vst1q_u8(dst + j, vmaxq_u8(vmaxq_u8(vld1q_u8(a + j), vld1q_u8(b + j)), vld1q_u8(c + j)));
+    }
+  }
+#endif
+  for (; j < size; ++j) {
+    dst[j] = minMax(minMax(a[j], b[j], isMin), c[j], isMin);
+  }
+}
+
+// Min or max of each pixel and its left and right neighbors in the row
+void minMax3Horizontal(const unsigned char *src, unsigned char *dst, unsigned int width, bool isMin)
+{
+  if (width == 1) {
+    dst[0] = src[0];
+    return;
+  }
+  dst[0] = minMax(src[0], src[1], isMin);
+  if (width > 2) {
+    minMax3(src, src + 1, src + 2, dst + 1, width - 2, isMin);
+  }
+  dst[width - 1] = minMax(src[width - 2], src[width - 1], isMin);
+}
+} // namespace
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+void vpImageMorphology::minMax3x3(vpImage<unsigned char> &I, bool isMin, const vpConnexityType &connexity)
+{
+  if (I.getSize() == 0) {
+    return;
+  }
+
+  const unsigned int height = I.getHeight(), width = I.getWidth();
+  const vpImage<unsigned char> I_src = I;
+  vpImage<unsigned char> I_horizontal(height, width);
+  const int nb_rows = static_cast<int>(height);
+
+#if defined(_OPENMP)
+#pragma omp parallel
+#endif
+  {
+#if defined(_OPENMP)
+#pragma omp for
+#endif
+    for (int r = 0; r < nb_rows; ++r) {
+      minMax3Horizontal(I_src[static_cast<unsigned int>(r)], I_horizontal[static_cast<unsigned int>(r)], width, isMin);
+    }
+
+    // Repeating the current row at the top and bottom borders does not change the result
+#if defined(_OPENMP)
+#pragma omp for
+#endif
+    for (int r = 0; r < nb_rows; ++r) {
+      const unsigned int i = static_cast<unsigned int>(r);
+      const unsigned int i_prev = (i > 0) ? i - 1 : i;
+      const unsigned int i_next = (i < (height - 1)) ? i + 1 : i;
+      if (connexity == CONNEXITY_4) {
+        minMax3(I_src[i_prev], I_horizontal[i], I_src[i_next], I[i], width, isMin);
+      }
+      else {
+        minMax3(I_horizontal[i_prev], I_horizontal[i], I_horizontal[i_next], I[i], width, isMin);
+      }
+    }
+  }
+}
+END_VISP_NAMESPACE
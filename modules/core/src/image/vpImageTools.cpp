@@ -32,11 +32,16 @@
  *
 *****************************************************************************/
 
+#include <limits>
+
 #include <visp3/core/vpCPUFeatures.h>
 #include <visp3/core/vpImageConvert.h>
+#include <visp3/core/vpImageFilter.h>
 #include <visp3/core/vpImageTools.h>
 #include <visp3/core/vpImageException.h>
 
+#include "private/vpFFT.h"
+
 #if defined(VISP_HAVE_SIMDLIB)
 #include <Simd/SimdLib.hpp>
 #endif
@@ -523,6 +528,8 @@ void vpImageTools::initUndistortMap(const vpCameraParameters &cam, unsigned int
   \param I : Input image.
   \param II : Integral image II.
   \param IIsq : Integral image IIsq.
+
+  \sa vpIntegralImage, that uses integer accumulators and can be updated after a part of the image changed.
 */
 void vpImageTools::integralImage(const vpImage<unsigned char> &I, vpImage<double> &II, vpImage<double> &IIsq)
 {
@@ -728,6 +735,78 @@ void vpImageTools::extract(const vpImage<unsigned char> &src, vpImage<double> &d
   }
 }
 
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace
+{
+bool checkTemplateMatchingInputs(const vpImage<unsigned char> &I, const vpImage<unsigned char> &I_tpl)
+{
+  if (I.getSize() == 0) {
+    std::cerr << "Error, input image is empty." << std::endl;
+    return false;
+  }
+
+  if (I_tpl.getSize() == 0) {
+    std::cerr << "Error, template image is empty." << std::endl;
+    return false;
+  }
+
+  if ((I_tpl.getHeight() > I.getHeight()) || (I_tpl.getWidth() > I.getWidth())) {
+    std::cerr << "Error, template image is bigger than input image." << std::endl;
+    return false;
+  }
+  return true;
+}
+
+/*
+ * Zero-mean normalized cross-correlation at (i0, j0) from the correlation ab of the image with the zero-mean
+ * template, the squared norm b2 of the zero-mean template and the integral image of the image.
+ */
+inline double normalizedCorrelationScore(double ab, const vpIntegralImage &II, double b2, unsigned int i0,
+                                         unsigned int j0, unsigned int height_tpl, unsigned int width_tpl)
+{
+  const double sum1 = II.getSum(i0, j0, i0 + height_tpl, j0 + width_tpl);
+  const double a2 = static_cast<double>(II.getSquaredSum(i0, j0, i0 + height_tpl, j0 + width_tpl)) -
+    ((1.0 / (height_tpl * width_tpl)) * vpMath::sqr(sum1));
+  return ab / sqrt(a2 * b2);
+}
+
+/*
+ * The spatial correlation costs a dot product of the size of the template per position whereas the frequency-domain
+ * correlation costs two 2D FFT of the size of the image, whatever the steps and the template size. The weight of the
+ * FFT operations has been measured against the vectorized dot product.
+ */
+bool isFrequencyDomainFaster(unsigned int height, unsigned int width, unsigned int height_tpl, unsigned int width_tpl,
+                             unsigned int step_u, unsigned int step_v)
+{
+  const double fftCostFactor = 12.0;
+  const double nbPositions = std::ceil(static_cast<double>(height - height_tpl) / step_v) *
+    std::ceil(static_cast<double>(width - width_tpl) / step_u);
+  const double spatialCost = nbPositions * height_tpl * width_tpl;
+  const double fftSize = static_cast<double>(vpFFT::getOptimalSize(height)) * vpFFT::getOptimalSize(width);
+  const double fftCost = fftCostFactor * fftSize * std::log(fftSize) / std::log(2.0);
+  return spatialCost > fftCost;
+}
+
+/*
+ * Location of the highest score, the non finite scores of the uniform regions being ignored.
+ */
+double getBestScore(const vpImage<double> &I_score, unsigned int &i_best, unsigned int &j_best)
+{
+  double best = -std::numeric_limits<double>::infinity();
+  for (unsigned int i = 0; i < I_score.getHeight(); ++i) {
+    for (unsigned int j = 0; j < I_score.getWidth(); ++j) {
+      if (I_score[i][j] > best) {
+        best = I_score[i][j];
+        i_best = i;
+        j_best = j;
+      }
+    }
+  }
+  return best;
+}
+} // namespace
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
 /*!
   Match a template image into another image using zero-mean normalized cross-correlation:
 
@@ -740,24 +819,20 @@ void vpImageTools::extract(const vpImage<unsigned char> &src, vpImage<double> &d
   \param I_score : Output template matching score.
   \param step_u : Step in u-direction to speed-up the computation.
   \param step_v : Step in v-direction to speed-up the computation.
-  \param useOptimized : Use optimized version (SSE, OpenMP, integral images, ...) if true and available.
+  \param useOptimized : Use optimized version (SSE, OpenMP, integral images, FFT...) if true and available. The
+  optimized version selects the spatial or the frequency-domain computation with
+  vpImageTools::TEMPLATE_MATCHING_AUTO.
 */
 void vpImageTools::templateMatching(const vpImage<unsigned char> &I, const vpImage<unsigned char> &I_tpl,
                                     vpImage<double> &I_score, unsigned int step_u, unsigned int step_v,
                                     bool useOptimized)
 {
-  if (I.getSize() == 0) {
-    std::cerr << "Error, input image is empty." << std::endl;
-    return;
-  }
-
-  if (I_tpl.getSize() == 0) {
-    std::cerr << "Error, template image is empty." << std::endl;
+  if (useOptimized) {
+    templateMatching(I, I_tpl, I_score, step_u, step_v, TEMPLATE_MATCHING_AUTO);
     return;
   }
 
-  if ((I_tpl.getHeight() > I.getHeight()) || (I_tpl.getWidth() > I.getWidth())) {
-    std::cerr << "Error, template image is bigger than input image." << std::endl;
+  if (!checkTemplateMatchingInputs(I, I_tpl)) {
     return;
   }
 
@@ -768,62 +843,226 @@ void vpImageTools::templateMatching(const vpImage<unsigned char> &I, const vpIma
   unsigned int height_tpl = I_tpl.getHeight(), width_tpl = I_tpl.getWidth();
   I_score.resize(I.getHeight() - height_tpl, I.getWidth() - width_tpl, 0.0);
 
-  if (useOptimized) {
-    vpImage<double> II, IIsq;
-    integralImage(I, II, IIsq);
-
-    vpImage<double> II_tpl, IIsq_tpl;
-    integralImage(I_tpl, II_tpl, IIsq_tpl);
-
-    // zero-mean template image
-    const double sum2 = (((II_tpl[height_tpl][width_tpl] + II_tpl[0][0]) - II_tpl[0][width_tpl]) - II_tpl[height_tpl][0]);
-    const double mean2 = sum2 / I_tpl.getSize();
-    unsigned int i_tpl_double_size = I_tpl_double.getSize();
-    for (unsigned int cpt = 0; cpt < i_tpl_double_size; ++cpt) {
-      I_tpl_double.bitmap[cpt] -= mean2;
+  vpImage<double> I_cur;
+
+  unsigned int i_height = I.getHeight();
+  unsigned int i_width = I.getWidth();
+  for (unsigned int i = 0; i < (i_height - height_tpl); i += step_v) {
+    for (unsigned int j = 0; j < (i_width - width_tpl); j += step_u) {
+      vpRect roi(vpImagePoint(i, j), vpImagePoint(((i + height_tpl) - 1), ((j + width_tpl) - 1)));
+      vpImageTools::crop(I_double, roi, I_cur);
+
+      I_score[i][j] = vpImageTools::normalizedCorrelation(I_cur, I_tpl_double, useOptimized);
     }
+  }
+}
 
-#if defined(_OPENMP) && (_OPENMP >= 200711) // OpenMP 3.1
-#pragma omp parallel for schedule(dynamic)
-    for (unsigned int i = 0; i < I.getHeight() - height_tpl; i += step_v) {
-      for (unsigned int j = 0; j < I.getWidth() - width_tpl; j += step_u) {
-        I_score[i][j] = normalizedCorrelation(I_double, I_tpl_double, II, IIsq, II_tpl, IIsq_tpl, i, j);
+/*!
+  Match a template image into another image using zero-mean normalized cross-correlation, with the score given in
+  the other templateMatching() overload.
+
+  The spatial computation costs a dot product of the size of the template per evaluated position. The
+  frequency-domain computation relies on a bundled FFT to compute the correlation at all the positions at once, with
+  a cost that only depends on the image size: it is much faster for large templates, but ignores \e step_u and
+  \e step_v except when filling \e I_score. Both computations give the same scores up to the floating point
+  rounding errors.
+
+  \param[in] I : Input image.
+  \param[in] I_tpl : Template image.
+  \param[out] I_score : Output template matching score, of size \f$ (H-h) \times (W-w) \f$. Only the positions
+  multiple of the steps are computed, the other ones being set to 0.
+  \param[in] step_u : Step in u-direction to speed-up the computation.
+  \param[in] step_v : Step in v-direction to speed-up the computation.
+  \param[in] method : Spatial or frequency-domain computation, vpImageTools::TEMPLATE_MATCHING_AUTO selecting the
+  fastest one from the image and template sizes and the steps.
+  \param[in] nThreads : Number of threads used with OpenMP, 0 to use the OpenMP default.
+
+  \sa templateMatchingCoarseToFine()
+*/
+void vpImageTools::templateMatching(const vpImage<unsigned char> &I, const vpImage<unsigned char> &I_tpl,
+                                    vpImage<double> &I_score, unsigned int step_u, unsigned int step_v,
+                                    const vpTemplateMatchingMethod &method, unsigned int nThreads)
+{
+  if (!checkTemplateMatchingInputs(I, I_tpl)) {
+    return;
+  }
+
+  const unsigned int height_tpl = I_tpl.getHeight(), width_tpl = I_tpl.getWidth();
+  I_score.resize(I.getHeight() - height_tpl, I.getWidth() - width_tpl, 0.0);
+  if (I_score.getSize() == 0) {
+    return;
+  }
+
+  const vpIntegralImage II(I, true);
+  const vpIntegralImage II_tpl(I_tpl, true);
+
+  // zero-mean template image
+  vpImage<double> I_tpl_double;
+  vpImageConvert::convert(I_tpl, I_tpl_double);
+  const double sum2 = II_tpl.getSum(0, 0, height_tpl, width_tpl);
+  const double mean2 = sum2 / I_tpl.getSize();
+  // sum of the squared differences to the mean of the template, the same for all the positions
+  const double b2 = II_tpl.getSquaredSum(0, 0, height_tpl, width_tpl) - ((1.0 / I_tpl.getSize()) * vpMath::sqr(sum2));
+  unsigned int i_tpl_double_size = I_tpl_double.getSize();
+  for (unsigned int cpt = 0; cpt < i_tpl_double_size; ++cpt) {
+    I_tpl_double.bitmap[cpt] -= mean2;
+  }
+
+  bool useFFT = (method == TEMPLATE_MATCHING_FFT);
+  if (method == TEMPLATE_MATCHING_AUTO) {
+    useFFT = isFrequencyDomainFaster(I.getHeight(), I.getWidth(), height_tpl, width_tpl, step_u, step_v);
+  }
+
+  vpImage<double> I_double;
+  vpImageConvert::convert(I, I_double);
+  if (useFFT) {
+    // Since the template is zero-mean, removing the mean of the image does not change the correlation but reduces
+    // the magnitude of the spectrum and thus the rounding errors
+    double mean1 = 0.0;
+    unsigned int i_double_size = I_double.getSize();
+    for (unsigned int cpt = 0; cpt < i_double_size; ++cpt) {
+      mean1 += I_double.bitmap[cpt];
+    }
+    mean1 /= i_double_size;
+    for (unsigned int cpt = 0; cpt < i_double_size; ++cpt) {
+      I_double.bitmap[cpt] -= mean1;
+    }
+
+    vpImage<double> I_ab;
+    vp_crossCorrelation(I_double, I_tpl_double, I_ab, nThreads);
+    for (unsigned int i = 0; i < I_score.getHeight(); i += step_v) {
+      for (unsigned int j = 0; j < I_score.getWidth(); j += step_u) {
+        I_score[i][j] = normalizedCorrelationScore(I_ab[i][j], II, b2, i, j, height_tpl, width_tpl);
       }
     }
+    return;
+  }
+
+#if defined(_OPENMP)
+  if (nThreads > 0) {
+    omp_set_num_threads(static_cast<int>(nThreads));
+  }
 #else
-    // error C3016: 'i': index variable in OpenMP 'for' statement must have signed integral type
-    int end = static_cast<int>((I.getHeight() - height_tpl) / step_v) + 1;
-    std::vector<unsigned int> vec_step_v(static_cast<size_t>(end));
-    unsigned int i_height = I.getHeight();
-    for (unsigned int cpt = 0, idx = 0; cpt < (i_height - height_tpl); cpt += step_v, ++idx) {
-      vec_step_v[static_cast<size_t>(idx)] = cpt;
+  (void)nThreads;
+#endif
+
+#if defined(_OPENMP) && (_OPENMP >= 200711) // OpenMP 3.1
+#pragma omp parallel for schedule(dynamic)
+  for (unsigned int i = 0; i < I.getHeight() - height_tpl; i += step_v) {
+    for (unsigned int j = 0; j < I.getWidth() - width_tpl; j += step_u) {
+      I_score[i][j] = normalizedCorrelation(I_double, I_tpl_double, II, b2, i, j);
     }
+  }
+#else
+  // error C3016: 'i': index variable in OpenMP 'for' statement must have signed integral type
+  int end = static_cast<int>((I.getHeight() - height_tpl) / step_v) + 1;
+  std::vector<unsigned int> vec_step_v(static_cast<size_t>(end));
+  unsigned int i_height = I.getHeight();
+  for (unsigned int cpt = 0, idx = 0; cpt < (i_height - height_tpl); cpt += step_v, ++idx) {
+    vec_step_v[static_cast<size_t>(idx)] = cpt;
+  }
 #if defined(_OPENMP) // only to disable warning: ignoring #pragma omp parallel [-Wunknown-pragmas]
 #pragma omp parallel for schedule(dynamic)
 #endif
-    for (int cpt = 0; cpt < end; ++cpt) {
-      unsigned int i_width = I.getWidth();
-      for (unsigned int j = 0; j < (i_width - width_tpl); j += step_u) {
-        I_score[vec_step_v[cpt]][j] =
-          normalizedCorrelation(I_double, I_tpl_double, II, IIsq, II_tpl, IIsq_tpl, vec_step_v[cpt], j);
-      }
+  for (int cpt = 0; cpt < end; ++cpt) {
+    unsigned int i_width = I.getWidth();
+    for (unsigned int j = 0; j < (i_width - width_tpl); j += step_u) {
+      I_score[vec_step_v[cpt]][j] = normalizedCorrelation(I_double, I_tpl_double, II, b2, vec_step_v[cpt], j);
     }
+  }
 #endif
+}
+
+/*!
+  Coarse-to-fine template matching with zero-mean normalized cross-correlation.
+
+  The image and the template are downscaled with vpImageFilter::getGaussPyramidal() to build Gaussian pyramids of
+  up to \e nbScales levels, the template being kept at least 8 pixels wide and high. The template is searched at all
+  the positions of the coarsest level, then the best location is refined at each finer level in a
+  \f$ (2 \times searchRadius + 1)^2 \f$ neighborhood of the location found at the previous level.
+
+  \code
+  vpImagePoint ip;
+  double score = vpImageTools::templateMatchingCoarseToFine(I, I_tpl, ip, 3);
+  vpDisplay::displayRectangle(I, ip, I_tpl.getWidth(), I_tpl.getHeight(), vpColor::red);
+  \endcode
+
+  \param[in] I : Input image.
+  \param[in] I_tpl : Template image, smaller than the input image.
+  \param[out] ip : Location of the top-left corner of the template in the input image.
+  \param[in] nbScales : Maximal number of pyramid levels, 1 to search at all the positions of the input image.
+  \param[in] searchRadius : Half size of the neighborhood searched at the finer levels.
+  \param[in] nThreads : Number of threads used with OpenMP, 0 to use the OpenMP default.
+  \return The zero-mean normalized cross-correlation score at \e ip.
+
+  \sa templateMatching()
+*/
+double vpImageTools::templateMatchingCoarseToFine(const vpImage<unsigned char> &I,
+                                                  const vpImage<unsigned char> &I_tpl, vpImagePoint &ip,
+                                                  unsigned int nbScales, unsigned int searchRadius,
+                                                  unsigned int nThreads)
+{
+  if ((I_tpl.getSize() == 0) || (I_tpl.getHeight() >= I.getHeight()) || (I_tpl.getWidth() >= I.getWidth())) {
+    throw(vpException(vpException::dimensionError,
+                      "Cannot search a %dx%d template in a %dx%d image, it must be smaller than the image",
+                      I_tpl.getWidth(), I_tpl.getHeight(), I.getWidth(), I.getHeight()));
   }
-  else {
-    vpImage<double> I_cur;
 
-    unsigned int i_height = I.getHeight();
-    unsigned int i_width = I.getWidth();
-    for (unsigned int i = 0; i < (i_height - height_tpl); i += step_v) {
-      for (unsigned int j = 0; j < (i_width - width_tpl); j += step_u) {
-        vpRect roi(vpImagePoint(i, j), vpImagePoint(((i + height_tpl) - 1), ((j + width_tpl) - 1)));
-        vpImageTools::crop(I_double, roi, I_cur);
+  const unsigned int minTemplateSize = 8;
+  std::vector<vpImage<unsigned char> > pyramid(1), pyramid_tpl(1);
+  for (unsigned int level = 1; level < nbScales; ++level) {
+    const vpImage<unsigned char> &I_prev = (level == 1) ? I : pyramid.back();
+    const vpImage<unsigned char> &I_tpl_prev = (level == 1) ? I_tpl : pyramid_tpl.back();
+    if (((I_tpl_prev.getHeight() / 2) < minTemplateSize) || ((I_tpl_prev.getWidth() / 2) < minTemplateSize)) {
+      break;
+    }
 
-        I_score[i][j] = vpImageTools::normalizedCorrelation(I_cur, I_tpl_double, useOptimized);
-      }
+    vpImage<unsigned char> I_down, I_tpl_down;
+    vpImageFilter::getGaussPyramidal(I_prev, I_down);
+    vpImageFilter::getGaussPyramidal(I_tpl_prev, I_tpl_down);
+    if ((I_tpl_down.getHeight() >= I_down.getHeight()) || (I_tpl_down.getWidth() >= I_down.getWidth())) {
+      break;
     }
+    pyramid.push_back(I_down);
+    pyramid_tpl.push_back(I_tpl_down);
+  }
+
+  // The level 0 is the input image, not copied
+  const size_t nbLevels = pyramid.size();
+  const vpImage<unsigned char> &I_coarse = (nbLevels == 1) ? I : pyramid.back();
+  const vpImage<unsigned char> &I_tpl_coarse = (nbLevels == 1) ? I_tpl : pyramid_tpl.back();
+  vpImage<double> I_score;
+  templateMatching(I_coarse, I_tpl_coarse, I_score, 1, 1, TEMPLATE_MATCHING_AUTO, nThreads);
+  unsigned int i_best = 0, j_best = 0;
+  double best = getBestScore(I_score, i_best, j_best);
+
+  vpImage<unsigned char> I_roi;
+  for (size_t level = nbLevels - 1; level > 0; --level) {
+    const vpImage<unsigned char> &I_level = (level == 1) ? I : pyramid[level - 1];
+    const vpImage<unsigned char> &I_tpl_level = (level == 1) ? I_tpl : pyramid_tpl[level - 1];
+    const unsigned int height_tpl = I_tpl_level.getHeight(), width_tpl = I_tpl_level.getWidth();
+    const unsigned int i_max_level = I_level.getHeight() - height_tpl - 1;
+    const unsigned int j_max_level = I_level.getWidth() - width_tpl - 1;
+    const unsigned int i_center = std::min<unsigned int>(2 * i_best, i_max_level);
+    const unsigned int j_center = std::min<unsigned int>(2 * j_best, j_max_level);
+    const unsigned int i_min = (i_center > searchRadius) ? i_center - searchRadius : 0;
+    const unsigned int j_min = (j_center > searchRadius) ? j_center - searchRadius : 0;
+    const unsigned int i_max = std::min<unsigned int>(i_center + searchRadius, i_max_level);
+    const unsigned int j_max = std::min<unsigned int>(j_center + searchRadius, j_max_level);
+
+    // The scores computed on the region give the positions [i_min, i_max] x [j_min, j_max]
+    vpImageTools::crop(I_level, i_min, j_min, (i_max - i_min) + 1 + height_tpl, (j_max - j_min) + 1 + width_tpl,
+                       I_roi);
+    templateMatching(I_roi, I_tpl_level, I_score, 1, 1, TEMPLATE_MATCHING_SPATIAL, nThreads);
+    i_best = 0;
+    j_best = 0;
+    best = getBestScore(I_score, i_best, j_best);
+    i_best += i_min;
+    j_best += j_min;
   }
+
+  ip.set_ij(i_best, j_best);
+  return best;
 }
 
 // Reference:
@@ -852,9 +1091,7 @@ float vpImageTools::lerp(float A, float B, float t) { return (A * (1.0f - t)) +
 int64_t vpImageTools::lerp2(int64_t A, int64_t B, int64_t t, int64_t t_1) { return (A * t_1) + (B * t); }
 
 double vpImageTools::normalizedCorrelation(const vpImage<double> &I1, const vpImage<double> &I2,
-                                           const vpImage<double> &II, const vpImage<double> &IIsq,
-                                           const vpImage<double> &II_tpl, const vpImage<double> &IIsq_tpl,
-                                           unsigned int i0, unsigned int j0)
+                                           const vpIntegralImage &II, double b2, unsigned int i0, unsigned int j0)
 {
   double ab = 0.0;
 
@@ -870,19 +1107,7 @@ double vpImageTools::normalizedCorrelation(const vpImage<double> &I1, const vpIm
   }
 #endif
 
-  unsigned int height_tpl = I2.getHeight(), width_tpl = I2.getWidth();
-  const double sum1 =
-    (((II[i0 + height_tpl][j0 + width_tpl] + II[i0][j0]) - II[i0][j0 + width_tpl]) - II[i0 + height_tpl][j0]);
-  const double sum2 = (((II_tpl[height_tpl][width_tpl] + II_tpl[0][0]) - II_tpl[0][width_tpl]) - II_tpl[height_tpl][0]);
-
-  double a2 = ((((IIsq[i0 + I2.getHeight()][j0 + I2.getWidth()] + IIsq[i0][j0]) - IIsq[i0][j0 + I2.getWidth()]) -
-                IIsq[i0 + I2.getHeight()][j0]) -
-               ((1.0 / I2.getSize()) * vpMath::sqr(sum1)));
-
-  double b2 = ((((IIsq_tpl[I2.getHeight()][I2.getWidth()] + IIsq_tpl[0][0]) - IIsq_tpl[0][I2.getWidth()]) -
-                IIsq_tpl[I2.getHeight()][0]) -
-               ((1.0 / I2.getSize()) * vpMath::sqr(sum2)));
-  return ab / sqrt(a2 * b2);
+  return normalizedCorrelationScore(ab, II, b2, i0, j0, I2.getHeight(), I2.getWidth());
 }
 
 /*!
@@ -0,0 +1,300 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2024 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ *
+ * Description:
+ * Integral image with integer accumulators.
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include <visp3/core/vpException.h>
+#include <visp3/core/vpIntegralImage.h>
+
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define VISP_HAVE_SSE2 1
+#endif
+
+#if defined _WIN32 && defined(_M_ARM64)
+#define _ARM64_DISTINCT_NEON_TYPES
+#include <Intrin.h>
+#include <arm_neon.h>
+#define VISP_HAVE_NEON 1
+#elif (defined(__ARM_NEON__) || defined (__ARM_NEON)) && defined(__aarch64__)
+#include <arm_neon.h>
+#define VISP_HAVE_NEON 1
+#endif
+
+BEGIN_VISP_NAMESPACE
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace
+{
+#if VISP_HAVE_SSE2
+// Inclusive prefix sum of the 8 unsigned 16 bits lanes
+inline __m128i prefixSum16(__m128i x)
+{
+  x = _mm_add_epi16(x, _mm_slli_si128(x, 2));
+  x = _mm_add_epi16(x, _mm_slli_si128(x, 4));
+  return _mm_add_epi16(x, _mm_slli_si128(x, 8));
+}
+
+// Inclusive prefix sum of the 4 unsigned 32 bits lanes
+inline __m128i prefixSum32(__m128i x)
+{
+  x = _mm_add_epi32(x, _mm_slli_si128(x, 4));
+  return _mm_add_epi32(x, _mm_slli_si128(x, 8));
+}
+
+// Integrate 4 squared values given as the prefix sum of 4 unsigned 32 bits lanes, the carry being broadcast
+// in the 2 unsigned 64 bits lanes
+inline void integrateSquared4(__m128i s, const uint64_t *prev, uint64_t *dst, __m128i &carry)
+{
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i lo = _mm_add_epi64(_mm_unpacklo_epi32(s, zero), carry);
+  const __m128i hi = _mm_add_epi64(_mm_unpackhi_epi32(s, zero), carry);
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(dst),
+                   _mm_add_epi64(lo, _mm_loadu_si128(reinterpret_cast<const __m128i *>(prev))));
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + 2),
+                   _mm_add_epi64(hi, _mm_loadu_si128(reinterpret_cast<const __m128i *>(prev + 2))));
+  carry = _mm_unpackhi_epi64(hi, hi);
+}
+#endif
+
+#if VISP_HAVE_NEON
+inline uint32x4_t prefixSum32(uint32x4_t x)
+{
+  const uint32x4_t zero = vdupq_n_u32(0);
+  x = vaddq_u32(x, vextq_u32(zero, x, 3));
+  return vaddq_u32(x, vextq_u32(zero, x, 2));
+}
+
+inline void integrateSquared4(uint32x4_t s, const uint64_t *prev, uint64_t *dst, uint64x2_t &carry)
+{
+  const uint64x2_t lo = vaddq_u64(vmovl_u32(vget_low_u32(s)), carry);
+  const uint64x2_t hi = vaddq_u64(vmovl_u32(vget_high_u32(s)), carry);
+  vst1q_u64(dst, vaddq_u64(lo, vld1q_u64(prev)));
+  vst1q_u64(dst + 2, vaddq_u64(hi, vld1q_u64(prev + 2)));
+  carry = vdupq_laneq_u64(hi, 1);
+}
+#endif
+
+/*
+ * Compute dst[j] = prev[j] + carry + src[0] + ... + src[j], prev and dst being two consecutive rows of the
+ * integral image.
+ */
+void integrateRow(const unsigned char *src, const uint32_t *prev, uint32_t *dst, unsigned int size,
+                  uint32_t carry)
+{
+  unsigned int j = 0;
+#if VISP_HAVE_SSE2
+  const __m128i zero = _mm_setzero_si128();
+  __m128i c = _mm_set1_epi32(static_cast<int>(carry));
+  for (; (j + 16) <= size; j += 16) {
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + j));
+    // The sum of 8 pixels fits in 16 bits
+    const __m128i s[2] = { prefixSum16(_mm_unpacklo_epi8(v, zero)), prefixSum16(_mm_unpackhi_epi8(v, zero)) };
+    for (unsigned int k = 0; k < 2; ++k) {
+      const unsigned int jk = j + (8 * k);
+      const __m128i lo = _mm_add_epi32(_mm_unpacklo_epi16(s[k], zero), c);
+      const __m128i hi = _mm_add_epi32(_mm_unpackhi_epi16(s[k], zero), c);
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + jk),
+                       _mm_add_epi32(lo, _mm_loadu_si128(reinterpret_cast<const __m128i *>(prev + jk))));
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + jk + 4),
+                       _mm_add_epi32(hi, _mm_loadu_si128(reinterpret_cast<const __m128i *>(prev + jk + 4))));
+      c = _mm_shuffle_epi32(hi, 0xFF);
+    }
+  }
+  carry = static_cast<uint32_t>(_mm_cvtsi128_si32(c));
+#elif VISP_HAVE_NEON
+  const uint16x8_t zero = vdupq_n_u16(0);
+  uint32x4_t c = vdupq_n_u32(carry);
+  for (; (j + 16) <= size; j += 16) {
+    const uint8x16_t v = vld1q_u8(src + j);
+    const uint16x8_t s[2] = { vmovl_u8(vget_low_u8(v)), vmovl_u8(vget_high_u8(v)) };
+    for (unsigned int k = 0; k < 2; ++k) {
+      const unsigned int jk = j + (8 * k);
+      uint16x8_t x = s[k];
+      x = vaddq_u16(x, vextq_u16(zero, x, 7));
+      x = vaddq_u16(x, vextq_u16(zero, x, 6));
+      x = vaddq_u16(x, vextq_u16(zero, x, 4));
+      const uint32x4_t lo = vaddq_u32(vmovl_u16(vget_low_u16(x)), c);
+      const uint32x4_t hi = vaddq_u32(vmovl_u16(vget_high_u16(x)), c);
+      vst1q_u32(dst + jk, vaddq_u32(lo, vld1q_u32(prev + jk)));
+      vst1q_u32(dst + jk + 4, vaddq_u32(hi, vld1q_u32(prev + jk + 4)));
+      c = vdupq_laneq_u32(hi, 3);
+    }
+  }
+  carry = vgetq_lane_u32(c, 0);
+#endif
+  for (; j < size; ++j) {
+    carry += src[j];
+    dst[j] = prev[j] + carry;
+  }
+}
+
+// Same as integrateRow() with the squared pixels
+void integrateSquaredRow(const unsigned char *src, const uint64_t *prev, uint64_t *dst, unsigned int size,
+                         uint64_t carry)
+{
+  unsigned int j = 0;
+#if VISP_HAVE_SSE2
+  const __m128i zero = _mm_setzero_si128();
+  __m128i c = _mm_set1_epi64x(static_cast<long long>(carry));
+  for (; (j + 16) <= size; j += 16) {
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + j));
+    const __m128i x[2] = { _mm_unpacklo_epi8(v, zero), _mm_unpackhi_epi8(v, zero) };
+    for (unsigned int k = 0; k < 2; ++k) {
+      const unsigned int jk = j + (8 * k);
+      // A squared pixel fits in 16 bits
+      const __m128i sq = _mm_mullo_epi16(x[k], x[k]);
+      integrateSquared4(prefixSum32(_mm_unpacklo_epi16(sq, zero)), prev + jk, dst + jk, c);
+      integrateSquared4(prefixSum32(_mm_unpackhi_epi16(sq, zero)), prev + jk + 4, dst + jk + 4, c);
+    }
+  }
+  uint64_t c_lanes[2];
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(c_lanes), c);
+  carry = c_lanes[0];
+#elif VISP_HAVE_NEON
+  uint64x2_t c = vdupq_n_u64(carry);
+  for (; (j + 16) <= size; j += 16) {
+    const uint8x16_t v = vld1q_u8(src + j);
+    const uint16x8_t sq[2] = { vmull_u8(vget_low_u8(v), vget_low_u8(v)), vmull_u8(vget_high_u8(v), vget_high_u8(v)) };
+    for (unsigned int k = 0; k < 2; ++k) {
+      const unsigned int jk = j + (8 * k);
+      integrateSquared4(prefixSum32(vmovl_u16(vget_low_u16(sq[k]))), prev + jk, dst + jk, c);
+      integrateSquared4(prefixSum32(vmovl_u16(vget_high_u16(sq[k]))), prev + jk + 4, dst + jk + 4, c);
+    }
+  }
+  carry = vgetq_lane_u64(c, 0);
+#endif
+  for (; j < size; ++j) {
+    carry += static_cast<uint64_t>(src[j]) * src[j];
+    dst[j] = prev[j] + carry;
+  }
+}
+} // namespace
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+/*!
+  Default constructor, with empty integral images.
+*/
+vpIntegralImage::vpIntegralImage() : m_height(0), m_width(0), m_hasSquaredSum(false), m_sum(), m_squaredSum() { }
+
+/*!
+  Compute the integral images of a grayscale image.
+
+  \param I : Input image.
+  \param computeSquaredSum : If true, the integral image of the squared pixels is also computed.
+*/
+vpIntegralImage::vpIntegralImage(const vpImage<unsigned char> &I, bool computeSquaredSum)
+  : m_height(0), m_width(0), m_hasSquaredSum(false), m_sum(), m_squaredSum()
+{
+  compute(I, computeSquaredSum);
+}
+
+/*!
+  Compute the integral images of a grayscale image. The memory is kept when the image size does not change.
+
+  \param I : Input image.
+  \param computeSquaredSum : If true, the integral image of the squared pixels is also computed.
+*/
+void vpIntegralImage::compute(const vpImage<unsigned char> &I, bool computeSquaredSum)
+{
+  m_height = I.getHeight();
+  m_width = I.getWidth();
+  m_hasSquaredSum = computeSquaredSum;
+
+  m_sum.resize(m_height + 1, m_width + 1);
+  std::fill(m_sum[0], m_sum[0] + m_width + 1, 0u);
+  for (unsigned int i = 1; i <= m_height; ++i) {
+    m_sum[i][0] = 0;
+  }
+  if (m_hasSquaredSum) {
+    m_squaredSum.resize(m_height + 1, m_width + 1);
+    std::fill(m_squaredSum[0], m_squaredSum[0] + m_width + 1, static_cast<uint64_t>(0));
+    for (unsigned int i = 1; i <= m_height; ++i) {
+      m_squaredSum[i][0] = 0;
+    }
+  }
+  else {
+    m_squaredSum.destroy();
+  }
+
+  computeRows(I, 0, 0);
+}
+
+/*!
+  Update the integral images after the pixels of the image in a region of interest have been modified.
+
+  Only the part of the integral images below and on the right of the top left corner of the region of interest
+  is computed again, which costs \f$ (H - top) \times (W - left) \f$ operations instead of \f$ H \times W \f$.
+
+  \param I : Modified image, whose size must be the one of the image the integral images were computed from.
+  \param roi : Region of interest that contains all the modified pixels.
+*/
+void vpIntegralImage::update(const vpImage<unsigned char> &I, const vpRect &roi)
+{
+  if ((I.getHeight() != m_height) || (I.getWidth() != m_width)) {
+    throw(vpException(vpException::dimensionError,
+                      "Cannot update a %ux%u integral image with a %ux%u image", m_height, m_width, I.getHeight(),
+                      I.getWidth()));
+  }
+  if ((roi.getWidth() <= 0) || (roi.getHeight() <= 0)) {
+    return;
+  }
+
+  // Pixels partially covered by the region of interest are considered as modified
+  const double top = std::max<double>(std::floor(roi.getTop()), 0.);
+  const double left = std::max<double>(std::floor(roi.getLeft()), 0.);
+  if ((top >= m_height) || (left >= m_width)) {
+    return;
+  }
+  computeRows(I, static_cast<unsigned int>(top), static_cast<unsigned int>(left));
+}
+
+/*!
+  Compute the rows of the integral images from row `top` and column `left` of the image, the previous rows
+  and the previous columns being valid.
+*/
+void vpIntegralImage::computeRows(const vpImage<unsigned char> &I, unsigned int top, unsigned int left)
+{
+  const unsigned int size = m_width - left;
+  for (unsigned int i = top; i < m_height; ++i) {
+    // The sum of the first pixels of the row, on the left of the region to compute
+    const uint32_t carry = m_sum[i + 1][left] - m_sum[i][left];
+    integrateRow(I[i] + left, m_sum[i] + left + 1, m_sum[i + 1] + left + 1, size, carry);
+    if (m_hasSquaredSum) {
+      const uint64_t sq_carry = m_squaredSum[i + 1][left] - m_squaredSum[i][left];
+      integrateSquaredRow(I[i] + left, m_squaredSum[i] + left + 1, m_squaredSum[i + 1] + left + 1, size, sq_carry);
+    }
+  }
+}
+END_VISP_NAMESPACE
@@ -0,0 +1,90 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2024 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ *
+ * Description:
+ * Organized point cloud stored as a structure of arrays.
+ */
+
+/*!
+  \file vpPointCloud.cpp
+  \brief Organized point cloud stored as a structure of arrays.
+*/
+
+#include <visp3/core/vpPointCloud.h>
+
+BEGIN_VISP_NAMESPACE
+/*!
+  Default constructor of an empty point cloud.
+*/
+vpPointCloud::vpPointCloud() : m_width(0), m_height(0), m_nbValidPoints(0), m_X(), m_Y(), m_Z() { }
+
+/*!
+  Create an organized point cloud where all the points are invalid.
+
+  \param[in] height, width : Size of the point cloud, that is the size of the depth image.
+*/
+vpPointCloud::vpPointCloud(unsigned int height, unsigned int width)
+  : m_width(0), m_height(0), m_nbValidPoints(0), m_X(), m_Y(), m_Z()
+{
+  resize(height, width);
+}
+
+/*!
+  Release the memory and set the size to 0.
+*/
+void vpPointCloud::clear()
+{
+  m_width = 0;
+  m_height = 0;
+  m_nbValidPoints = 0;
+  std::vector<float>().swap(m_X);
+  std::vector<float>().swap(m_Y);
+  std::vector<float>().swap(m_Z);
+}
+
+/*!
+  Resize the point cloud. When the size changes, all the points are set
+  invalid. Otherwise the coordinates are kept and no memory is allocated.
+
+  \param[in] height, width : Size of the point cloud, that is the size of the depth image.
+*/
+void vpPointCloud::resize(unsigned int height, unsigned int width)
+{
+  if ((height != m_height) || (width != m_width)) {
+    const size_t size = static_cast<size_t>(height) * width;
+    m_X.assign(size, 0.f);
+    m_Y.assign(size, 0.f);
+    m_Z.assign(size, 0.f);
+    m_height = height;
+    m_width = width;
+    m_nbValidPoints = 0;
+  }
+}
+END_VISP_NAMESPACE
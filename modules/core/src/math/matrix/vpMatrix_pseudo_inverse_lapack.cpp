@@ -50,6 +50,30 @@ BEGIN_VISP_NAMESPACE
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 
 #if defined(VISP_HAVE_LAPACK)
+namespace
+{
+/*!
+  Intermediate matrices used to compute the pseudo inverse. They are kept from
+  one call to the next, so that computing repeatedly the pseudo inverse of
+  matrices with the same size doesn't allocate memory. Like the workspace of
+  vpMatrix::svdLapack(), they keep the size of the largest matrix processed by
+  the thread until the thread exits.
+*/
+struct vpPseudoInverseLapackWorkspace
+{
+  vpMatrix U;
+  vpMatrix V;
+  vpColVector sv;
+};
+
+vpPseudoInverseLapackWorkspace &getPseudoInverseLapackWorkspace()
+{
+  // One workspace per thread, so that concurrent computations are safe
+  static thread_local vpPseudoInverseLapackWorkspace workspace;
+  return workspace;
+}
+} // namespace
+
 /*!
   Compute and return the Moore-Penros pseudo inverse \f$A^+\f$ of a m-by-n
   matrix \f$\bf A\f$ using Lapack 3rd party.
@@ -88,6 +112,10 @@ BEGIN_VISP_NAMESPACE
   }
   \endcode
 
+  \note The returned matrix is allocated at each call. To compute repeatedly
+  the pseudo inverse of matrices with the same size without allocating memory,
+  use pseudoInverseLapack(vpMatrix &, double) const instead.
+
   \sa pseudoInverse(double) const
 */
 vpMatrix vpMatrix::pseudoInverseLapack(double svThreshold) const
@@ -96,8 +124,11 @@ vpMatrix vpMatrix::pseudoInverseLapack(double svThreshold) const
   unsigned int ncols = getCols();
   int rank_out;
 
-  vpMatrix U, V, Ap;
-  vpColVector sv;
+  vpPseudoInverseLapackWorkspace &ws = getPseudoInverseLapackWorkspace();
+  vpMatrix &U = ws.U;
+  vpMatrix &V = ws.V;
+  vpColVector &sv = ws.sv;
+  vpMatrix Ap;
 
   U = *this;
   U.svdLapack(sv, V);
@@ -157,8 +188,10 @@ unsigned int vpMatrix::pseudoInverseLapack(vpMatrix &Ap, double svThreshold) con
   unsigned int ncols = getCols();
   int rank_out;
 
-  vpMatrix U, V;
-  vpColVector sv;
+  vpPseudoInverseLapackWorkspace &ws = getPseudoInverseLapackWorkspace();
+  vpMatrix &U = ws.U;
+  vpMatrix &V = ws.V;
+  vpColVector &sv = ws.sv;
 
   U = *this;
   U.svdLapack(sv, V);
@@ -225,7 +258,9 @@ unsigned int vpMatrix::pseudoInverseLapack(vpMatrix &Ap, vpColVector &sv, double
   unsigned int ncols = getCols();
   int rank_out;
 
-  vpMatrix U, V;
+  vpPseudoInverseLapackWorkspace &ws = getPseudoInverseLapackWorkspace();
+  vpMatrix &U = ws.U;
+  vpMatrix &V = ws.V;
 
   Ap.resize(ncols, nrows, false, false);
 
@@ -353,7 +388,9 @@ unsigned int vpMatrix::pseudoInverseLapack(vpMatrix &Ap, vpColVector &sv, double
   unsigned int nrows = getRows();
   unsigned int ncols = getCols();
   int rank_out;
-  vpMatrix U, V;
+  vpPseudoInverseLapackWorkspace &ws = getPseudoInverseLapackWorkspace();
+  vpMatrix &U = ws.U;
+  vpMatrix &V = ws.V;
 
   if (nrows < ncols) {
     U.resize(ncols, ncols, true);
@@ -408,6 +445,10 @@ unsigned int vpMatrix::pseudoInverseLapack(vpMatrix &Ap, vpColVector &sv, double
   }
   \endcode
 
+  \note The returned matrix is allocated at each call. To compute repeatedly
+  the pseudo inverse of matrices with the same size without allocating memory,
+  use pseudoInverseLapack(vpMatrix &, int) const instead.
+
   \sa pseudoInverse(int) const
 */
 vpMatrix vpMatrix::pseudoInverseLapack(int rank_in) const
@@ -417,8 +458,11 @@ vpMatrix vpMatrix::pseudoInverseLapack(int rank_in) const
   int rank_out;
   double svThreshold = 1e-26;
 
-  vpMatrix U, V, Ap;
-  vpColVector sv;
+  vpPseudoInverseLapackWorkspace &ws = getPseudoInverseLapackWorkspace();
+  vpMatrix &U = ws.U;
+  vpMatrix &V = ws.V;
+  vpColVector &sv = ws.sv;
+  vpMatrix Ap;
 
   U = *this;
   U.svdLapack(sv, V);
@@ -485,8 +529,10 @@ int vpMatrix::pseudoInverseLapack(vpMatrix &Ap, int rank_in) const
   int rank_out;
   double svThreshold = 1e-26;
 
-  vpMatrix U, V;
-  vpColVector sv;
+  vpPseudoInverseLapackWorkspace &ws = getPseudoInverseLapackWorkspace();
+  vpMatrix &U = ws.U;
+  vpMatrix &V = ws.V;
+  vpColVector &sv = ws.sv;
 
   U = *this;
   U.svdLapack(sv, V);
@@ -559,7 +605,9 @@ int vpMatrix::pseudoInverseLapack(vpMatrix &Ap, vpColVector &sv, int rank_in) co
   unsigned int ncols = getCols();
   int rank_out;
   double svThreshold = 1e-26;
-  vpMatrix U, V;
+  vpPseudoInverseLapackWorkspace &ws = getPseudoInverseLapackWorkspace();
+  vpMatrix &U = ws.U;
+  vpMatrix &V = ws.V;
 
   Ap.resize(ncols, nrows, false, false);
 
@@ -693,7 +741,9 @@ int vpMatrix::pseudoInverseLapack(vpMatrix &Ap, vpColVector &sv, int rank_in, vp
   unsigned int ncols = getCols();
   int rank_out;
   double svThreshold = 1e-26;
-  vpMatrix U, V;
+  vpPseudoInverseLapackWorkspace &ws = getPseudoInverseLapackWorkspace();
+  vpMatrix &U = ws.U;
+  vpMatrix &V = ws.V;
 
   if (nrows < ncols) {
     U.resize(ncols, ncols, true);
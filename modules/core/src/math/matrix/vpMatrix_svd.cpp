@@ -67,11 +67,44 @@ extern "C" int dgesdd_(char *jobz, integer *m, integer *n, double *a, integer *l
 
 #include <stdio.h>
 #include <string.h>
+#include <vector>
 #endif
 #endif
 
 BEGIN_VISP_NAMESPACE
 
+#if defined(VISP_HAVE_LAPACK) && !defined(VISP_HAVE_GSL)
+namespace
+{
+/*!
+  Work buffers used by vpMatrix::svdLapack(). They are reused from one call to
+  the next as long as the size of the matrix to decompose doesn't change. They
+  never shrink: the memory of the largest decomposition made by a thread is
+  retained until the thread exits.
+*/
+struct vpSvdLapackWorkspace
+{
+  vpSvdLapackWorkspace() : a(), work(), iwork(), U(), Vt(), m(0), n(0), lwork(0) { }
+
+  std::vector<double> a;
+  std::vector<double> work;
+  std::vector<integer> iwork;
+  vpMatrix U;
+  vpMatrix Vt;
+  integer m;
+  integer n;
+  integer lwork;
+};
+
+vpSvdLapackWorkspace &getSvdLapackWorkspace()
+{
+  // One workspace per thread, so that concurrent decompositions are safe
+  static thread_local vpSvdLapackWorkspace workspace;
+  return workspace;
+}
+} // namespace
+#endif
+
 /*!
 
   Solve a linear system \f$ A X = B \f$ using Singular Value
@@ -431,6 +464,11 @@ void vpMatrix::svdOpenCV(vpColVector &w, vpMatrix &V)
   }
   \endcode
 
+  \note Without GSL, the work buffers are kept from one call to the next in
+  a per-thread workspace, so that decomposing repeatedly matrices of the same
+  size doesn't allocate memory. This workspace keeps the size of the largest
+  matrix decomposed by the thread until the thread exits.
+
   \sa svd(), svdEigen3(), svdOpenCV()
 */
 void vpMatrix::svdLapack(vpColVector &w, vpMatrix &V)
@@ -496,12 +534,15 @@ void vpMatrix::svdLapack(vpColVector &w, vpMatrix &V)
   }
 #else
   {
-    vpMatrix U;
+    // Work buffers are kept from one call to the next to avoid heap
+    // allocations when decomposing matrices of the same size, as it is the
+    // case in virtual visual servoing loops
+    vpSvdLapackWorkspace &ws = getSvdLapackWorkspace();
     unsigned int nc = getCols();
     unsigned int nr = getRows();
 
     if (rowNum < colNum) {
-      U = this->transpose();
+      transpose(ws.U);
       nc = getRows();
       nr = getCols();
     }
@@ -513,9 +554,10 @@ void vpMatrix::svdLapack(vpColVector &w, vpMatrix &V)
     w.resize(nc);
     V.resize(nc, nc);
 
-    double *a = new double[static_cast<unsigned int>(nr * nc)];
+    ws.a.resize(static_cast<size_t>(nr) * nc);
+    double *a = ws.a.data();
     if (rowNum < colNum) {
-      memcpy(a, U.data, this->getRows() * this->getCols() * sizeof(double));
+      memcpy(a, ws.U.data, this->getRows() * this->getCols() * sizeof(double));
     }
     else {
       memcpy(a, this->data, this->getRows() * this->getCols() * sizeof(double));
@@ -526,44 +568,47 @@ void vpMatrix::svdLapack(vpColVector &w, vpMatrix &V)
     integer lda = nc;
     integer ldu = nc;
     integer ldvt = std::min<integer>(nr, nc);
-    integer info, lwork;
+    integer info;
 
-    double wkopt;
-    double *work;
-
-    integer *iwork = new integer[8 * static_cast<integer>(std::min<integer>(nr, nc))];
+    ws.iwork.resize(8 * static_cast<size_t>(std::min<integer>(nr, nc)));
+    integer *iwork = ws.iwork.data();
 
     double *s = w.data;
     double *u = V.data;
     double *vt;
     if (rowNum < colNum) {
-      vt = U.data;
+      vt = ws.U.data;
     }
     else {
       vt = this->data;
     }
 
-    lwork = -1;
-    dgesdd_((char *)"S", &m, &n, a, &lda, s, u, &ldu, vt, &ldvt, &wkopt, &lwork, iwork, &info);
-    lwork = (int)wkopt;
-    work = new double[static_cast<unsigned int>(lwork)];
+    // The optimal work size only depends on the problem size
+    if ((m != ws.m) || (n != ws.n)) {
+      double wkopt;
+      integer lwork = -1;
+      dgesdd_((char *)"S", &m, &n, a, &lda, s, u, &ldu, vt, &ldvt, &wkopt, &lwork, iwork, &info);
+      ws.lwork = (integer)wkopt;
+      ws.work.resize(static_cast<size_t>(ws.lwork));
+      ws.m = m;
+      ws.n = n;
+    }
 
-    dgesdd_((char *)"S", &m, &n, a, &lda, s, u, &ldu, vt, &ldvt, work, &lwork, iwork, &info);
+    dgesdd_((char *)"S", &m, &n, a, &lda, s, u, &ldu, vt, &ldvt, ws.work.data(), &ws.lwork, iwork, &info);
 
     if (info > 0) {
       throw(vpMatrixException(vpMatrixException::fatalError, "The algorithm computing SVD failed to converge."));
     }
 
     if (rowNum < colNum) {
-      (*this) = V.transpose();
-      V = U;
+      // (*this) is resized here since it becomes a square matrix
+      V.transpose(*this);
+      V = ws.U;
     }
     else {
-      V = V.transpose();
+      V.transpose(ws.Vt);
+      V = ws.Vt;
     }
-    delete[] work;
-    delete[] iwork;
-    delete[] a;
   }
 #endif
 }
@@ -32,6 +32,7 @@
  */
 
 #include <visp3/core/vpExponentialMap.h>
+#include <visp3/core/vpFixedMatrix.h>
 
 BEGIN_VISP_NAMESPACE
 /*!
@@ -87,39 +88,51 @@ vpHomogeneousMatrix vpExponentialMap::direct(const vpColVector &v, const double
                       v.size()));
   }
   double theta, si, co, sinc, mcosc, msinc;
-  vpThetaUVector u;
-  vpRotationMatrix rd;
-  vpTranslationVector dt;
+  // Intermediate vectors are kept on the stack, only the returned matrix is allocated
+  vpFixedColVector<3> u;
+  vpFixedColVector<3> dt;
+  vpFixedColVector<6> v_dt;
 
-  vpColVector v_dt = v * delta_t;
+  for (unsigned int i = 0; i < v_size; ++i) {
+    v_dt(i) = v[i] * delta_t;
+  }
 
-  u[index_0] = v_dt[index_3];
-  u[index_1] = v_dt[index_4];
-  u[index_2] = v_dt[index_5];
-  rd.buildFrom(u);
+  u(index_0) = v_dt(index_3);
+  u(index_1) = v_dt(index_4);
+  u(index_2) = v_dt(index_5);
 
-  theta = sqrt((u[index_0] * u[index_0]) + (u[index_1] * u[index_1]) + (u[index_2] * u[index_2]));
+  theta = sqrt((u(index_0) * u(index_0)) + (u(index_1) * u(index_1)) + (u(index_2) * u(index_2)));
   si = sin(theta);
   co = cos(theta);
   sinc = vpMath::sinc(si, theta);
   mcosc = vpMath::mcosc(co, theta);
   msinc = vpMath::msinc(si, theta);
 
-  dt[index_0] = ((v_dt[index_0] * (sinc + (u[index_0] * u[index_0] * msinc))) +
-          (v_dt[index_1] * ((u[index_0] * u[index_1] * msinc) - (u[index_2] * mcosc)))) +
-    (v_dt[index_2] * ((u[index_0] * u[index_2] * msinc) + (u[index_1] * mcosc)));
-
-  dt[index_1] = ((v_dt[index_0] * ((u[index_0] * u[index_1] * msinc) + (u[index_2] * mcosc))) +
-          (v_dt[index_1] * (sinc + (u[index_1] * u[index_1] * msinc)))) +
-    (v_dt[index_2] * ((u[index_1] * u[index_2] * msinc) - (u[index_0] * mcosc)));
-
-  dt[index_2] = ((v_dt[index_0] * ((u[index_0] * u[index_2] * msinc) - (u[index_1] * mcosc))) +
-          (v_dt[index_1] * ((u[index_1] * u[index_2] * msinc) + (u[index_0] * mcosc)))) +
-    (v_dt[index_2] * (sinc + (u[index_2] * u[index_2] * msinc)));
-
+  // Rotation from the theta u vector, as in vpRotationMatrix::buildFrom(const vpThetaUVector &)
   vpHomogeneousMatrix Delta;
-  Delta.insert(rd);
-  Delta.insert(dt);
+  Delta[index_0][index_0] = co + (mcosc * u(index_0) * u(index_0));
+  Delta[index_0][index_1] = (-sinc * u(index_2)) + (mcosc * u(index_0) * u(index_1));
+  Delta[index_0][index_2] = (sinc * u(index_1)) + (mcosc * u(index_0) * u(index_2));
+  Delta[index_1][index_0] = (sinc * u(index_2)) + (mcosc * u(index_1) * u(index_0));
+  Delta[index_1][index_1] = co + (mcosc * u(index_1) * u(index_1));
+  Delta[index_1][index_2] = (-sinc * u(index_0)) + (mcosc * u(index_1) * u(index_2));
+  Delta[index_2][index_0] = (-sinc * u(index_1)) + (mcosc * u(index_2) * u(index_0));
+  Delta[index_2][index_1] = (sinc * u(index_0)) + (mcosc * u(index_2) * u(index_1));
+  Delta[index_2][index_2] = co + (mcosc * u(index_2) * u(index_2));
+
+  dt(index_0) = ((v_dt(index_0) * (sinc + (u(index_0) * u(index_0) * msinc))) +
+          (v_dt(index_1) * ((u(index_0) * u(index_1) * msinc) - (u(index_2) * mcosc)))) +
+    (v_dt(index_2) * ((u(index_0) * u(index_2) * msinc) + (u(index_1) * mcosc)));
+
+  dt(index_1) = ((v_dt(index_0) * ((u(index_0) * u(index_1) * msinc) + (u(index_2) * mcosc))) +
+          (v_dt(index_1) * (sinc + (u(index_1) * u(index_1) * msinc)))) +
+    (v_dt(index_2) * ((u(index_1) * u(index_2) * msinc) - (u(index_0) * mcosc)));
+
+  dt(index_2) = ((v_dt(index_0) * ((u(index_0) * u(index_2) * msinc) - (u(index_1) * mcosc))) +
+          (v_dt(index_1) * ((u(index_1) * u(index_2) * msinc) + (u(index_0) * mcosc)))) +
+    (v_dt(index_2) * (sinc + (u(index_2) * u(index_2) * msinc)));
+
+  dt.copyTo(Delta, 0, index_3);
 
   return Delta;
 }
@@ -163,8 +176,8 @@ vpColVector vpExponentialMap::inverse(const vpHomogeneousMatrix &M, const double
   unsigned int i;
   double theta, si, co, sinc, mcosc, msinc, det;
   vpThetaUVector u;
-  vpRotationMatrix Rd, a;
-  vpTranslationVector dt;
+  vpRotationMatrix Rd;
+  vpFixedMatrix<3, 3> a;
   const unsigned int index_0 = 0;
   const unsigned int index_1 = 1;
   const unsigned int index_2 = 2;
@@ -37,6 +37,7 @@
   the particular case of rotation matrix
 */
 
+#include <visp3/core/vpFixedMatrix.h>
 #include <visp3/core/vpMath.h>
 #include <visp3/core/vpMatrix.h>
 
@@ -696,7 +697,7 @@ void vpRotationMatrix::printVector()
 vpRotationMatrix &vpRotationMatrix::buildFrom(const vpThetaUVector &v)
 {
   double theta, si, co, sinc, mcosc;
-  vpRotationMatrix R;
+  vpFixedMatrix<3, 3> R;
 
   const unsigned int index_0 = 0;
   const unsigned int index_1 = 1;
@@ -43,6 +43,7 @@
 #include <sstream>
 
 #include <visp3/core/vpException.h>
+#include <visp3/core/vpFixedMatrix.h>
 #include <visp3/core/vpVelocityTwistMatrix.h>
 
 BEGIN_VISP_NAMESPACE
@@ -378,7 +379,14 @@ vpVelocityTwistMatrix &vpVelocityTwistMatrix::buildFrom(const vpRotationMatrix &
 */
 vpVelocityTwistMatrix &vpVelocityTwistMatrix::buildFrom(const vpTranslationVector &t, const vpRotationMatrix &R)
 {
-  vpMatrix skewaR = t.skew(t) * R;
+  vpFixedMatrix<3, 3> skewa;
+  skewa[0][1] = -t[2];
+  skewa[0][2] = t[1];
+  skewa[1][0] = t[2];
+  skewa[1][2] = -t[0];
+  skewa[2][0] = -t[1];
+  skewa[2][1] = t[0];
+  vpFixedMatrix<3, 3> skewaR = skewa * vpFixedMatrix<3, 3>(R);
 
   const unsigned int index_3 = 3;
   const unsigned int val_3 = 3;
@@ -465,15 +473,27 @@ vpVelocityTwistMatrix &vpVelocityTwistMatrix::buildFrom(const vpHomogeneousMatri
 //! Invert the velocity twist matrix.
 vpVelocityTwistMatrix vpVelocityTwistMatrix::inverse() const
 {
+  // The inverse of [R [t]x R ; 0 R] is [R^T -R^T ([t]x R) R^T ; 0 R^T].
+  // Blocks are computed on the stack to avoid any intermediate allocation
   vpVelocityTwistMatrix Wi;
-  vpRotationMatrix R;
-  extract(R);
-  vpTranslationVector T;
-  extract(T);
-  vpTranslationVector RtT;
-  RtT = -(R.t() * T);
+  vpFixedMatrix<3, 3> Rt, skewaR;
+  const unsigned int index_3 = 3;
+  const unsigned int val_3 = 3;
+  for (unsigned int i = 0; i < val_3; ++i) {
+    for (unsigned int j = 0; j < val_3; ++j) {
+      Rt[j][i] = (*this)[i][j];
+      skewaR[i][j] = (*this)[i][j + index_3];
+    }
+  }
+  vpFixedMatrix<3, 3> skewaRt = (Rt * skewaR) * Rt;
 
-  Wi.buildFrom(RtT, R.t());
+  for (unsigned int i = 0; i < val_3; ++i) {
+    for (unsigned int j = 0; j < val_3; ++j) {
+      Wi[i][j] = Rt[i][j];
+      Wi[i + index_3][j + index_3] = Rt[i][j];
+      Wi[i][j + index_3] = -skewaRt[i][j];
+    }
+  }
 
   return Wi;
 }
@@ -792,6 +792,60 @@ TEST_CASE("Split <==> Merge conversion", "[image_conversion]")
   CHECK((rgba == rgba_ref));
 }
 
+TEST_CASE("Split with missing channels", "[image_conversion]")
+{
+  vpImage<vpRGBa> rgba_ref(height, width);
+  common_tools::fill(rgba_ref);
+
+  vpImage<unsigned char> R, B;
+  vpImageConvert::split(rgba_ref, &R, nullptr, &B, nullptr);
+  REQUIRE(R.getSize() == rgba_ref.getSize());
+  REQUIRE(B.getSize() == rgba_ref.getSize());
+  for (unsigned int i = 0; i < rgba_ref.getSize(); i++) {
+    CHECK(R.bitmap[i] == rgba_ref.bitmap[i].R);
+    CHECK(B.bitmap[i] == rgba_ref.bitmap[i].B);
+  }
+}
+
+TEST_CASE("YUV to RGBa conversion", "[image_conversion]")
+{
+  // Even sizes, with a width that is not a multiple of the vector size
+  const unsigned int w = 2 * (width / 2 + 1), h = 2 * (height / 2);
+
+  SECTION("YUYV")
+  {
+    std::vector<unsigned char> yuyv(w * h * 2);
+    common_tools::fill(yuyv);
+
+    vpImage<vpRGBa> rgba_ref(h, w), rgba(h, w);
+    common_tools::YUYVToRGBaRef(yuyv.data(), reinterpret_cast<unsigned char *>(rgba_ref.bitmap), w * h);
+    vpImageConvert::YUYVToRGBa(yuyv.data(), reinterpret_cast<unsigned char *>(rgba.bitmap), w, h);
+    CHECK((rgba == rgba_ref));
+  }
+
+  SECTION("UYVY")
+  {
+    std::vector<unsigned char> uyvy(w * h * 2);
+    common_tools::fill(uyvy);
+
+    vpImage<vpRGBa> rgba_ref(h, w), rgba(h, w);
+    common_tools::YUV422ToRGBaRef(uyvy.data(), reinterpret_cast<unsigned char *>(rgba_ref.bitmap), w * h);
+    vpImageConvert::YUV422ToRGBa(uyvy.data(), reinterpret_cast<unsigned char *>(rgba.bitmap), w * h);
+    CHECK((rgba == rgba_ref));
+  }
+
+  SECTION("YUV 4:2:0")
+  {
+    std::vector<unsigned char> yuv((w * h * 3) / 2);
+    common_tools::fill(yuv);
+
+    vpImage<vpRGBa> rgba_ref(h, w), rgba(h, w);
+    common_tools::YUV420ToRGBaRef(yuv.data(), reinterpret_cast<unsigned char *>(rgba_ref.bitmap), w, h);
+    vpImageConvert::YUV420ToRGBa(yuv.data(), reinterpret_cast<unsigned char *>(rgba.bitmap), w, h);
+    CHECK((rgba == rgba_ref));
+  }
+}
+
 #if defined(VISP_HAVE_OPENCV) && defined(HAVE_OPENCV_IMGPROC)
 TEST_CASE("OpenCV Mat <==> vpImage conversion", "[image_conversion]")
 {
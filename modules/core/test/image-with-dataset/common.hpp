@@ -626,6 +626,56 @@ void BGRaToRGBaRef(unsigned char *bgra, unsigned char *rgba, unsigned int width,
   }
 }
 
+void YUVToRGBaRef(int y, int u, int v, unsigned char *rgba)
+{
+  int U = static_cast<int>((u - 128) * 0.354);
+  int V = static_cast<int>((v - 128) * 0.707);
+  *rgba++ = vpMath::saturate<unsigned char>(y + 2 * V);
+  *rgba++ = vpMath::saturate<unsigned char>(y - U - V);
+  *rgba++ = vpMath::saturate<unsigned char>(y + 5 * U);
+  *rgba = vpRGBa::alpha_default;
+}
+
+void YUV422ToRGBaRef(unsigned char *uyvy, unsigned char *rgba, unsigned int size)
+{
+  for (unsigned int i = 0; i < size; i += 2) {
+    YUVToRGBaRef(uyvy[1], uyvy[0], uyvy[2], rgba);
+    YUVToRGBaRef(uyvy[3], uyvy[0], uyvy[2], rgba + 4);
+    uyvy += 4;
+    rgba += 8;
+  }
+}
+
+void YUV420ToRGBaRef(unsigned char *yuv, unsigned char *rgba, unsigned int width, unsigned int height)
+{
+  unsigned char *iU = yuv + width * height;
+  unsigned char *iV = iU + (width / 2) * (height / 2);
+  for (unsigned int i = 0; i < height; i++) {
+    for (unsigned int j = 0; j < width; j++) {
+      unsigned int k = (i / 2) * (width / 2) + j / 2;
+      YUVToRGBaRef(yuv[i * width + j], iU[k], iV[k], rgba + 4 * (i * width + j));
+    }
+  }
+}
+
+void YUYVToRGBaRef(unsigned char *yuyv, unsigned char *rgba, unsigned int size)
+{
+  for (unsigned int i = 0; i < size; i += 2) {
+    int u = yuyv[1] - 128, v = yuyv[3] - 128;
+    int cb = (u * 454) / 256;
+    int cg = (u * 88 + v * 183) / 256;
+    int cr = (v * 359) / 256;
+    for (unsigned int k = 0; k < 2; k++) {
+      int y = yuyv[2 * k];
+      *rgba++ = vpMath::saturate<unsigned char>(y + cr);
+      *rgba++ = vpMath::saturate<unsigned char>(y - cg);
+      *rgba++ = vpMath::saturate<unsigned char>(y + cb);
+      *rgba++ = vpRGBa::alpha_default;
+    }
+    yuyv += 4;
+  }
+}
+
 #if defined(VISP_HAVE_OPENCV)
 void fill(cv::Mat &img)
 {
@@ -312,6 +312,115 @@ TEST_CASE("Benchmark bgra to rgba (ViSP)", "[benchmark]")
   };
 }
 
+TEST_CASE("Benchmark rgb <==> rgba (ViSP)", "[benchmark]")
+{
+  vpImage<vpRGBa> I;
+  vpImageIo::read(I, imagePathColor);
+
+  std::vector<unsigned char> rgb(I.getSize() * 3);
+  BENCHMARK("Benchmark rgba to rgb (ViSP)")
+  {
+    vpImageConvert::RGBaToRGB(reinterpret_cast<unsigned char *>(I.bitmap), rgb.data(), I.getSize());
+    return rgb;
+  };
+
+  vpImage<vpRGBa> I_rgba(I.getHeight(), I.getWidth());
+  BENCHMARK("Benchmark rgb to rgba (ViSP)")
+  {
+    vpImageConvert::RGBToRGBa(rgb.data(), reinterpret_cast<unsigned char *>(I_rgba.bitmap), I.getSize());
+    return I_rgba;
+  };
+}
+
+TEST_CASE("Benchmark yuv to rgba", "[benchmark]")
+{
+  vpImage<vpRGBa> I;
+  vpImageIo::read(I, imagePathColor);
+  // YUV 4:2:0 and 4:2:2 formats need even sizes
+  const unsigned int w = (I.getWidth() / 2) * 2, h = (I.getHeight() / 2) * 2;
+
+  std::vector<unsigned char> yuv422(w * h * 2);
+  common_tools::fill(yuv422);
+  std::vector<unsigned char> yuv420((w * h * 3) / 2);
+  common_tools::fill(yuv420);
+  vpImage<vpRGBa> I_rgba(h, w);
+
+  BENCHMARK("Benchmark yuyv to rgba (ViSP)")
+  {
+    vpImageConvert::YUYVToRGBa(yuv422.data(), reinterpret_cast<unsigned char *>(I_rgba.bitmap), w, h);
+    return I_rgba;
+  };
+
+  BENCHMARK("Benchmark uyvy to rgba (naive code)")
+  {
+    common_tools::YUV422ToRGBaRef(yuv422.data(), reinterpret_cast<unsigned char *>(I_rgba.bitmap), w * h);
+    return I_rgba;
+  };
+
+  BENCHMARK("Benchmark uyvy to rgba (ViSP)")
+  {
+    vpImageConvert::YUV422ToRGBa(yuv422.data(), reinterpret_cast<unsigned char *>(I_rgba.bitmap), w * h);
+    return I_rgba;
+  };
+
+  BENCHMARK("Benchmark yuv420 to rgba (naive code)")
+  {
+    common_tools::YUV420ToRGBaRef(yuv420.data(), reinterpret_cast<unsigned char *>(I_rgba.bitmap), w, h);
+    return I_rgba;
+  };
+
+  BENCHMARK("Benchmark yuv420 to rgba (ViSP)")
+  {
+    vpImageConvert::YUV420ToRGBa(yuv420.data(), reinterpret_cast<unsigned char *>(I_rgba.bitmap), w, h);
+    return I_rgba;
+  };
+}
+
+TEST_CASE("Benchmark rgba <==> hsv (ViSP)", "[benchmark]")
+{
+  vpImage<vpRGBa> I;
+  vpImageIo::read(I, imagePathColor);
+
+  std::vector<unsigned char> hue(I.getSize()), saturation(I.getSize()), value(I.getSize());
+  BENCHMARK("Benchmark rgba to hsv (ViSP)")
+  {
+    vpImageConvert::RGBaToHSV(reinterpret_cast<unsigned char *>(I.bitmap), hue.data(), saturation.data(), value.data(),
+                              I.getSize());
+    return hue;
+  };
+
+  vpImage<vpRGBa> I_rgba(I.getHeight(), I.getWidth());
+  BENCHMARK("Benchmark hsv to rgba (ViSP)")
+  {
+    vpImageConvert::HSVToRGBa(hue.data(), saturation.data(), value.data(),
+                              reinterpret_cast<unsigned char *>(I_rgba.bitmap), I.getSize());
+    return I_rgba;
+  };
+}
+
+#ifndef VISP_SKIP_BAYER_CONVERSION
+TEST_CASE("Benchmark bayer to rgba (ViSP)", "[benchmark]")
+{
+  vpImage<unsigned char> I;
+  vpImageIo::read(I, imagePathGray);
+
+  vpImage<vpRGBa> I_rgba(I.getHeight(), I.getWidth());
+  BENCHMARK("Benchmark bayer BGGR to rgba, bilinear (ViSP)")
+  {
+    vpImageConvert::demosaicBGGRToRGBaBilinear(I.bitmap, reinterpret_cast<unsigned char *>(I_rgba.bitmap),
+                                               I.getWidth(), I.getHeight(), nThreads);
+    return I_rgba;
+  };
+
+  BENCHMARK("Benchmark bayer BGGR to rgba, Malvar (ViSP)")
+  {
+    vpImageConvert::demosaicBGGRToRGBaMalvar(I.bitmap, reinterpret_cast<unsigned char *>(I_rgba.bitmap),
+                                             I.getWidth(), I.getHeight(), nThreads);
+    return I_rgba;
+  };
+}
+#endif
+
 int main(int argc, char *argv[])
 {
   Catch::Session session;
@@ -120,6 +120,21 @@ TEST_CASE("vpImageFilter::gaussianBlur", "[benchmark]")
     };
   }
 
+  SECTION("unsigned char to float")
+  {
+    vpImage<unsigned char> I;
+    vpImageIo::read(I, imagePath);
+
+    vpImage<float> I_blur;
+    const unsigned int kernelSize = 7;
+    const float sigma = 5.0f;
+    BENCHMARK("Benchmark vpImageFilter::gaussianBlur uchar to float")
+    {
+      vpImageFilter::gaussianBlur(I, I_blur, kernelSize, sigma);
+      return I_blur;
+    };
+  }
+
   SECTION("vpRGBa")
   {
     vpImage<vpRGBa> I, I_blur;
@@ -135,6 +150,18 @@ TEST_CASE("vpImageFilter::gaussianBlur", "[benchmark]")
   }
 }
 
+TEST_CASE("vpImageFilter::getGaussPyramidal", "[benchmark]")
+{
+  vpImage<unsigned char> I, I_pyr;
+  vpImageIo::read(I, imagePath);
+
+  BENCHMARK("Benchmark vpImageFilter::getGaussPyramidal uchar")
+  {
+    vpImageFilter::getGaussPyramidal(I, I_pyr);
+    return I_pyr;
+  };
+}
+
 #if defined(VISP_HAVE_OPENCV) && defined(HAVE_OPENCV_IMGCODECS) && defined(HAVE_OPENCV_IMGPROC)
 
 TEST_CASE("Gaussian filter (OpenCV)", "[benchmark]")
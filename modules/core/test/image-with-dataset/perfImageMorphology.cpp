@@ -39,6 +39,8 @@
 
 #if defined(VISP_HAVE_CATCH2)
 
+#include <vector>
+
 #include <catch_amalgamated.hpp>
 
 #include "common.hpp"
@@ -133,6 +135,92 @@ TEST_CASE("Benchmark binary image morphology", "[benchmark]")
   }
 }
 
+namespace
+{
+// Erosion computing the minimum over the whole window at each pixel
+void imageErosionSquareRef(vpImage<unsigned char> &I, int size)
+{
+  const vpImage<unsigned char> J = I;
+  const int height = static_cast<int>(I.getHeight()), width = static_cast<int>(I.getWidth());
+  for (int r = 0; r < height; ++r) {
+    for (int c = 0; c < width; ++c) {
+      unsigned char value = J[r][c];
+      for (int rr = std::max<int>(0, r - (size / 2)); rr <= std::min<int>(height - 1, r + (size / 2)); ++rr) {
+        for (int cc = std::max<int>(0, c - (size / 2)); cc <= std::min<int>(width - 1, c + (size / 2)); ++cc) {
+          value = std::min<unsigned char>(value, J[rr][cc]);
+        }
+      }
+      I[r][c] = value;
+    }
+  }
+}
+} // namespace
+
+TEST_CASE("Benchmark gray image morphology with large structuring elements", "[benchmark]")
+{
+  std::string imagePath = vpIoTools::createFilePath(ipath, "Klimt/Klimt.pgm");
+  vpImage<unsigned char> I;
+  vpImageIo::read(I, imagePath);
+
+  const int sizes[] = { 3, 11, 31 };
+  for (unsigned int k = 0; k < 3; ++k) {
+    const int size = sizes[k];
+    std::stringstream buffer;
+    buffer << "Benchmark erosion " << size << "x" << size << " (naive code)";
+    BENCHMARK_ADVANCED(buffer.str().c_str())(Catch::Benchmark::Chronometer meter)
+    {
+      // Each run erodes its own copy of the input, made before the measure
+      std::vector<vpImage<unsigned char> > I_scratch(static_cast<size_t>(meter.runs()), I);
+      meter.measure([&](int i) {
+        imageErosionSquareRef(I_scratch[i], size);
+        return I_scratch[i];
+      });
+    };
+
+    buffer.str("");
+    buffer << "Benchmark erosion " << size << "x" << size << " (ViSP, 1 thread)";
+    BENCHMARK_ADVANCED(buffer.str().c_str())(Catch::Benchmark::Chronometer meter)
+    {
+      std::vector<vpImage<unsigned char> > I_scratch(static_cast<size_t>(meter.runs()), I);
+      meter.measure([&](int i) {
+        vpImageMorphology::rectangularErosion(I_scratch[i], static_cast<unsigned int>(size),
+                                              static_cast<unsigned int>(size), 1);
+        return I_scratch[i];
+      });
+    };
+
+    buffer.str("");
+    buffer << "Benchmark erosion " << size << "x" << size << " (ViSP)";
+    BENCHMARK_ADVANCED(buffer.str().c_str())(Catch::Benchmark::Chronometer meter)
+    {
+      std::vector<vpImage<unsigned char> > I_scratch(static_cast<size_t>(meter.runs()), I);
+      meter.measure([&](int i) {
+        vpImageMorphology::erosion(I_scratch[i], size);
+        return I_scratch[i];
+      });
+    };
+
+#if (VISP_HAVE_OPENCV_VERSION >= 0x030000) && defined(HAVE_OPENCV_IMGPROC)
+    cv::Mat imgMorph;
+    vpImageConvert::convert(I, imgMorph);
+    cv::Mat rect_SE = cv::getStructuringElement(cv::MORPH_RECT, cv::Size(size, size));
+    buffer.str("");
+    buffer << "Benchmark erosion " << size << "x" << size << " (OpenCV)";
+    BENCHMARK_ADVANCED(buffer.str().c_str())(Catch::Benchmark::Chronometer meter)
+    {
+      std::vector<cv::Mat> imgScratch(static_cast<size_t>(meter.runs()));
+      for (cv::Mat &img : imgScratch) {
+        img = imgMorph.clone();
+      }
+      meter.measure([&](int i) {
+        cv::morphologyEx(imgScratch[i], imgScratch[i], cv::MORPH_ERODE, rect_SE);
+        return imgScratch[i];
+      });
+    };
+#endif
+  }
+}
+
 #if (VISP_HAVE_OPENCV_VERSION >= 0x030000) && defined(HAVE_OPENCV_IMGPROC)
 TEST_CASE("Benchmark gray image morphology", "[benchmark]")
 {
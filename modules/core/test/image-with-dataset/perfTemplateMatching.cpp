@@ -0,0 +1,163 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2024 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ *
+ * Description:
+ * Benchmark template matching.
+ */
+
+/*!
+  \example perfTemplateMatching.cpp
+ */
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2) && defined(VISP_HAVE_THREADS)
+
+#include <catch_amalgamated.hpp>
+
+#include <thread>
+#include <visp3/core/vpImageTools.h>
+#include <visp3/core/vpIoTools.h>
+#include <visp3/io/vpImageIo.h>
+
+#ifdef ENABLE_VISP_NAMESPACE
+using namespace VISP_NAMESPACE_NAME;
+#endif
+
+// Same image and template as testImageTemplateMatching.cpp
+#if defined(VISP_HAVE_DATASET) && (VISP_HAVE_DATASET_VERSION < 0x030600)
+static std::string imagePath = vpIoTools::createFilePath(vpIoTools::getViSPImagesDataPath(), "mbt/cube/image0000.pgm");
+#else
+static std::string imagePath = vpIoTools::createFilePath(vpIoTools::getViSPImagesDataPath(), "mbt/cube/image0000.png");
+#endif
+static unsigned int g_tpl_top = 201;
+static unsigned int g_tpl_left = 310;
+static unsigned int g_tpl_height = 152;
+static unsigned int g_tpl_width = 138;
+
+TEST_CASE("Template matching", "[benchmark]")
+{
+  vpImage<unsigned char> I, I_tpl;
+  vpImageIo::read(I, imagePath);
+  vpImageTools::crop(I, g_tpl_top, g_tpl_left, g_tpl_height, g_tpl_width, I_tpl);
+  vpImage<double> I_score;
+  const unsigned int nThreads = std::thread::hardware_concurrency();
+
+  const unsigned int steps[] = { 1, 5 };
+  for (unsigned int s = 0; s < 2; ++s) {
+    const unsigned int step = steps[s];
+    std::stringstream buffer;
+    buffer << "Benchmark spatial template matching (step " << step << ") (1 thread)";
+    BENCHMARK(buffer.str().c_str())
+    {
+      vpImageTools::templateMatching(I, I_tpl, I_score, step, step, vpImageTools::TEMPLATE_MATCHING_SPATIAL, 1);
+      return I_score;
+    };
+
+    buffer.str("");
+    buffer << "Benchmark spatial template matching (step " << step << ") (" << nThreads << " threads)";
+    BENCHMARK(buffer.str().c_str())
+    {
+      vpImageTools::templateMatching(I, I_tpl, I_score, step, step, vpImageTools::TEMPLATE_MATCHING_SPATIAL,
+                                     nThreads);
+      return I_score;
+    };
+
+    buffer.str("");
+    buffer << "Benchmark FFT template matching (step " << step << ") (1 thread)";
+    BENCHMARK(buffer.str().c_str())
+    {
+      vpImageTools::templateMatching(I, I_tpl, I_score, step, step, vpImageTools::TEMPLATE_MATCHING_FFT, 1);
+      return I_score;
+    };
+
+    buffer.str("");
+    buffer << "Benchmark FFT template matching (step " << step << ") (" << nThreads << " threads)";
+    BENCHMARK(buffer.str().c_str())
+    {
+      vpImageTools::templateMatching(I, I_tpl, I_score, step, step, vpImageTools::TEMPLATE_MATCHING_FFT, nThreads);
+      return I_score;
+    };
+
+    buffer.str("");
+    buffer << "Benchmark auto template matching (step " << step << ")";
+    BENCHMARK(buffer.str().c_str())
+    {
+      vpImageTools::templateMatching(I, I_tpl, I_score, step, step);
+      return I_score;
+    };
+  }
+
+  for (unsigned int nbScales = 2; nbScales <= 4; ++nbScales) {
+    std::stringstream buffer;
+    buffer << "Benchmark coarse-to-fine template matching (" << nbScales << " scales)";
+    BENCHMARK(buffer.str().c_str())
+    {
+      vpImagePoint ip;
+      return vpImageTools::templateMatchingCoarseToFine(I, I_tpl, ip, nbScales);
+    };
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session;
+
+  bool runBenchmark = false;
+  auto cli = session.cli()
+    | Catch::Clara::Opt(runBenchmark)["--benchmark"]("run benchmark?")
+    | Catch::Clara::Opt(imagePath, "imagePath")["--image"]("Path to grayscale image")
+    | Catch::Clara::Opt(g_tpl_top, "g_tpl_top")["--top"]("Template top coordinate")
+    | Catch::Clara::Opt(g_tpl_left, "g_tpl_left")["--left"]("Template left coordinate")
+    | Catch::Clara::Opt(g_tpl_height, "g_tpl_height")["--height"]("Template height")
+    | Catch::Clara::Opt(g_tpl_width, "g_tpl_width")["--width"]("Template width");
+
+  session.cli(cli);
+
+  session.applyCommandLine(argc, argv);
+
+  if (runBenchmark) {
+    vpImage<unsigned char> I;
+    vpImageIo::read(I, imagePath);
+    std::cout << "imagePath:\n\t" << imagePath << "\n\t" << I.getWidth() << "x" << I.getHeight() << std::endl;
+    std::cout << "Template: " << g_tpl_width << "x" << g_tpl_height << std::endl;
+
+    int numFailed = session.run();
+
+    return numFailed;
+  }
+
+  return EXIT_SUCCESS;
+}
+#else
+#include <iostream>
+
+int main() { return EXIT_SUCCESS; }
+#endif
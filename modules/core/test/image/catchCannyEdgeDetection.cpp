@@ -0,0 +1,170 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2024 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test Canny edge detection.
+ */
+
+/*!
+  \example catchCannyEdgeDetection.cpp
+
+  \brief Test Canny edge detection.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2)
+
+#include <catch_amalgamated.hpp>
+#include <visp3/core/vpCannyEdgeDetection.h>
+#include <visp3/core/vpImageFilter.h>
+#include <visp3/core/vpUniRand.h>
+
+#ifdef ENABLE_VISP_NAMESPACE
+using namespace VISP_NAMESPACE_NAME;
+#endif
+
+namespace
+{
+void fillRect(vpImage<unsigned char> &I, unsigned int top, unsigned int left, unsigned int bottom, unsigned int right,
+              unsigned char value)
+{
+  for (unsigned int i = top; i < bottom; ++i) {
+    for (unsigned int j = left; j < right; ++j) {
+      I[i][j] = value;
+    }
+  }
+}
+
+unsigned int countEdgePoints(const vpImage<unsigned char> &I_edges, unsigned int top, unsigned int left,
+                             unsigned int bottom, unsigned int right)
+{
+  unsigned int nb = 0;
+  for (unsigned int i = top; i < bottom; ++i) {
+    for (unsigned int j = left; j < right; ++j) {
+      if (I_edges[i][j] == 255) {
+        ++nb;
+      }
+    }
+  }
+  return nb;
+}
+} // anonymous namespace
+
+TEST_CASE("Canny gradients", "[canny]")
+{
+  vpImage<unsigned char> I(120, 160, 0);
+  fillRect(I, 20, 30, 90, 120, 180);
+  fillRect(I, 50, 60, 70, 100, 60);
+
+  const int gaussianKernelSize = 5;
+  const float gaussianStdev = 1.5f;
+  const unsigned int apertureSize = 3;
+  vpCannyEdgeDetection detector(gaussianKernelSize, gaussianStdev, apertureSize, 10.f, 40.f);
+  vpImage<unsigned char> I_edges = detector.detect(I);
+
+  // Same gradients computed with vpImageFilter and given to the detector
+  vpArray2D<float> fg(1, (gaussianKernelSize + 1) / 2);
+  vpImageFilter::getGaussianKernel(fg.data, gaussianKernelSize, gaussianStdev, true);
+  vpArray2D<float> gradientFilterX(apertureSize, apertureSize), gradientFilterY(apertureSize, apertureSize);
+  float scaleX = vpImageFilter::getSobelKernelX(gradientFilterX.data, (apertureSize - 1) / 2);
+  float scaleY = vpImageFilter::getSobelKernelY(gradientFilterY.data, (apertureSize - 1) / 2);
+  for (unsigned int r = 0; r < apertureSize; ++r) {
+    for (unsigned int c = 0; c < apertureSize; ++c) {
+      gradientFilterX[r][c] = gradientFilterX[r][c] * scaleX;
+      gradientFilterY[r][c] = gradientFilterY[r][c] * scaleY;
+    }
+  }
+  vpImage<float> GIx, Iblur, dIx, dIy;
+  vpImageFilter::filterX<unsigned char, float>(I, GIx, fg.data, gaussianKernelSize, nullptr);
+  vpImageFilter::filterY<float, float>(GIx, Iblur, fg.data, gaussianKernelSize, nullptr);
+  vpImageFilter::filter(Iblur, dIx, gradientFilterX, true);
+  vpImageFilter::filter(Iblur, dIy, gradientFilterY, true);
+
+  detector.setGradients(dIx, dIy);
+  vpImage<unsigned char> I_edges_ref = detector.detect(I);
+  CHECK((I_edges == I_edges_ref));
+  CHECK(countEdgePoints(I_edges, 0, 0, I.getHeight(), I.getWidth()) > 0);
+}
+
+TEST_CASE("Canny hysteresis", "[canny]")
+{
+  // A high contrast vertical edge whose contrast smoothly decreases, and an isolated low contrast square
+  vpImage<unsigned char> I(100, 100, 0);
+  fillRect(I, 10, 50, 40, 100, 200);
+  for (unsigned int i = 40; i < 60; ++i) {
+    fillRect(I, i, 50, i + 1, 100, static_cast<unsigned char>(200 - ((i - 40) * 17) / 2));
+  }
+  fillRect(I, 60, 50, 95, 100, 30);
+  fillRect(I, 60, 10, 90, 25, 30);
+
+  vpCannyEdgeDetection detector(3, 1.f, 3, 5.f, 40.f);
+  detector.setStoreEdgePoints(true);
+  vpImage<unsigned char> I_edges = detector.detect(I);
+
+  // Weak edge points connected to the strong edge are kept
+  CHECK(countEdgePoints(I_edges, 65, 45, 90, 55) >= 25);
+  // Weak edge points that are not connected to a strong edge are discarded
+  CHECK(countEdgePoints(I_edges, 55, 5, 95, 30) == 0);
+
+  // The list of edge points matches the edge map
+  std::vector<vpImagePoint> edgePoints = detector.getEdgePointsList();
+  CHECK(edgePoints.size() == countEdgePoints(I_edges, 0, 0, I.getHeight(), I.getWidth()));
+  for (size_t n = 0; n < edgePoints.size(); ++n) {
+    CHECK(I_edges[static_cast<unsigned int>(edgePoints[n].get_i())][static_cast<unsigned int>(edgePoints[n].get_j())] == 255);
+  }
+}
+
+TEST_CASE("Canny on a noisy full HD image", "[canny]")
+{
+  // Low thresholds on noise lead to very long chains of weak edge points,
+  // that used to overflow the stack with the former recursive edge tracking
+  vpImage<unsigned char> I(1080, 1920);
+  vpUniRand rng(42);
+  for (unsigned int i = 0; i < I.getSize(); ++i) {
+    I.bitmap[i] = static_cast<unsigned char>(rng.uniform(0, 256));
+  }
+
+  vpCannyEdgeDetection detector(3, 1.f, 3, 1.f, 2.f);
+  vpImage<unsigned char> I_edges = detector.detect(I);
+  CHECK(I_edges.getHeight() == I.getHeight());
+  CHECK(I_edges.getWidth() == I.getWidth());
+  CHECK(countEdgePoints(I_edges, 0, 0, I.getHeight(), I.getWidth()) > 0);
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session;
+  session.applyCommandLine(argc, argv);
+  int numFailed = session.run();
+  return numFailed;
+}
+#else
+int main() { return EXIT_SUCCESS; }
+#endif
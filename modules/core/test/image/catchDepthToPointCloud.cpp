@@ -0,0 +1,209 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2024 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ *
+ * Description:
+ * Test depth image to organized point cloud conversion.
+ */
+
+/*!
+  \example catchDepthToPointCloud.cpp
+
+  \brief Test depth image to organized point cloud conversion.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2)
+
+#include <catch_amalgamated.hpp>
+#include <visp3/core/vpCameraParameters.h>
+#include <visp3/core/vpImageConvert.h>
+#include <visp3/core/vpPixelMeterConversion.h>
+#include <visp3/core/vpPointCloud.h>
+#include <visp3/core/vpUniRand.h>
+
+#ifdef ENABLE_VISP_NAMESPACE
+using namespace VISP_NAMESPACE_NAME;
+#endif
+
+namespace
+{
+// Straightforward per pixel reconstruction, with the same float operations than the conversion
+template <typename DepthType>
+unsigned int depthToPointCloudRef(const vpImage<DepthType> &depth, float depth_scale, const vpCameraParameters &cam,
+                                  vpPointCloud &pointcloud, const vpImage<unsigned char> *mask, float Z_min,
+                                  float Z_max, unsigned int decimation, unsigned int top, unsigned int left,
+                                  unsigned int bottom, unsigned int right)
+{
+  pointcloud.resize(depth.getHeight(), depth.getWidth());
+  unsigned int nb = 0;
+  for (unsigned int i = 0; i < depth.getHeight(); ++i) {
+    for (unsigned int j = 0; j < depth.getWidth(); ++j) {
+      const unsigned int idx = (i * depth.getWidth()) + j;
+      pointcloud.getX()[idx] = 0.f;
+      pointcloud.getY()[idx] = 0.f;
+      pointcloud.getZ()[idx] = 0.f;
+      if ((i < top) || (i >= bottom) || (j < left) || (j >= right) || (((i - top) % decimation) != 0) ||
+          (((j - left) % decimation) != 0) || (mask && ((*mask)[i][j] == 0))) {
+        continue;
+      }
+      const float Z = static_cast<float>(depth[i][j]) * depth_scale;
+      if ((Z > Z_min) && (Z < Z_max)) {
+        double x = 0, y = 0;
+        vpPixelMeterConversion::convertPoint(cam, static_cast<double>(j), static_cast<double>(i), x, y);
+        pointcloud.getX()[idx] = static_cast<float>(x) * Z;
+        pointcloud.getY()[idx] = static_cast<float>(y) * Z;
+        pointcloud.getZ()[idx] = Z;
+        ++nb;
+      }
+    }
+  }
+  pointcloud.setNumberOfValidPoints(nb);
+  return nb;
+}
+
+bool comparePointClouds(const vpPointCloud &pc, const vpPointCloud &pc_ref)
+{
+  if ((pc.getHeight() != pc_ref.getHeight()) || (pc.getWidth() != pc_ref.getWidth()) ||
+      (pc.getNumberOfValidPoints() != pc_ref.getNumberOfValidPoints())) {
+    return false;
+  }
+  for (unsigned int i = 0; i < pc.getSize(); ++i) {
+    if ((pc.getZ()[i] != pc_ref.getZ()[i]) || !vpMath::equal(pc.getX()[i], pc_ref.getX()[i], 1e-6) ||
+        !vpMath::equal(pc.getY()[i], pc_ref.getY()[i], 1e-6)) {
+      return false;
+    }
+  }
+  return true;
+}
+} // anonymous namespace
+
+TEST_CASE("Depth to point cloud", "[depth_to_pointcloud]")
+{
+  // Odd width to exercise the scalar tail of the vectorized code
+  const unsigned int height = 97, width = 131;
+  const float depth_scale = 0.001f;
+  const vpCameraParameters cam(120., 118., 64.3, 49.7);
+  vpUniRand rng(1234);
+  vpImage<uint16_t> I_depth_raw(height, width);
+  vpImage<float> I_depth(height, width);
+  vpImage<unsigned char> I_mask(height, width);
+  for (unsigned int i = 0; i < I_depth_raw.getSize(); ++i) {
+    // Some pixels without depth, and some pixels beyond Z_max
+    I_depth_raw.bitmap[i] = static_cast<uint16_t>(rng.uniform(0, 3000));
+    I_depth.bitmap[i] = I_depth_raw.bitmap[i] * depth_scale;
+    I_mask.bitmap[i] = static_cast<unsigned char>(rng.uniform(0, 4) > 0 ? 255 : 0);
+  }
+
+  vpPointCloud pc, pc_ref;
+  SECTION("Full image")
+  {
+    unsigned int nb = vpImageConvert::depthToPointCloud(I_depth_raw, depth_scale, cam, pc);
+    depthToPointCloudRef(I_depth_raw, depth_scale, cam, pc_ref, nullptr, 0.2f, 2.5f, 1, 0, 0, height, width);
+    CHECK(nb == pc.getNumberOfValidPoints());
+    CHECK(nb > 0);
+    CHECK(comparePointClouds(pc, pc_ref));
+
+    vpImageConvert::depthToPointCloud(I_depth, cam, pc);
+    CHECK(comparePointClouds(pc, pc_ref));
+  }
+
+  SECTION("Mask, region of interest and decimation")
+  {
+    const vpRect roi(10.5, 7, 100, 60.2);
+    for (unsigned int decimation = 1; decimation <= 3; ++decimation) {
+      for (unsigned int nThreads = 0; nThreads <= 2; ++nThreads) {
+        vpImageConvert::depthToPointCloud(I_depth_raw, depth_scale, cam, pc, &I_mask, 0.5f, 2.f, decimation, roi,
+                                          nThreads);
+        depthToPointCloudRef(I_depth_raw, depth_scale, cam, pc_ref, &I_mask, 0.5f, 2.f, decimation, 7, 11, 68, 111);
+        CHECK(comparePointClouds(pc, pc_ref));
+
+        vpImageConvert::depthToPointCloud(I_depth, cam, pc, &I_mask, 0.5f, 2.f, decimation, roi, nThreads);
+        CHECK(comparePointClouds(pc, pc_ref));
+      }
+    }
+  }
+
+  SECTION("Region of interest partly or fully outside the image")
+  {
+    const vpRect roi_partial(width - 20.5, height - 10.2, 100, 100);
+    for (unsigned int decimation = 1; decimation <= 2; ++decimation) {
+      vpImageConvert::depthToPointCloud(I_depth_raw, depth_scale, cam, pc, &I_mask, 0.5f, 2.f, decimation,
+                                        roi_partial);
+      depthToPointCloudRef(I_depth_raw, depth_scale, cam, pc_ref, &I_mask, 0.5f, 2.f, decimation, height - 10,
+                           width - 20, height, width);
+      CHECK(comparePointClouds(pc, pc_ref));
+    }
+
+    const vpRect roi_right(width + 10, 5, 50, 50);
+    const vpRect roi_below(5, height + 10, 50, 50);
+    const vpRect roi_beyond(width + 10, height + 10, 50, 50);
+    const vpRect rois[] = { roi_right, roi_below, roi_beyond };
+    for (unsigned int k = 0; k < 3; ++k) {
+      for (unsigned int decimation = 1; decimation <= 2; ++decimation) {
+        unsigned int nb = vpImageConvert::depthToPointCloud(I_depth_raw, depth_scale, cam, pc, &I_mask, 0.5f, 2.f,
+                                                            decimation, rois[k]);
+        CHECK(nb == 0);
+        depthToPointCloudRef(I_depth_raw, depth_scale, cam, pc_ref, nullptr, 0.5f, 2.f, 1, 0, 0, 0, 0);
+        CHECK(comparePointClouds(pc, pc_ref));
+
+        nb = vpImageConvert::depthToPointCloud(I_depth, cam, pc, &I_mask, 0.5f, 2.f, decimation, rois[k]);
+        CHECK(nb == 0);
+        CHECK(comparePointClouds(pc, pc_ref));
+      }
+    }
+  }
+
+  SECTION("Camera with distortion")
+  {
+    const vpCameraParameters cam_dist(120., 118., 64.3, 49.7, -0.1, 0.1);
+    vpImageConvert::depthToPointCloud(I_depth_raw, depth_scale, cam_dist, pc);
+    depthToPointCloudRef(I_depth_raw, depth_scale, cam_dist, pc_ref, nullptr, 0.2f, 2.5f, 1, 0, 0, height, width);
+    CHECK(comparePointClouds(pc, pc_ref));
+  }
+
+  SECTION("Mask size differs")
+  {
+    vpImage<unsigned char> I_mask_small(height - 1, width);
+    CHECK_THROWS_AS(vpImageConvert::depthToPointCloud(I_depth_raw, depth_scale, cam, pc, &I_mask_small),
+                    vpImageException);
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session;
+  session.applyCommandLine(argc, argv);
+  int numFailed = session.run();
+  return numFailed;
+}
+#else
+int main() { return EXIT_SUCCESS; }
+#endif
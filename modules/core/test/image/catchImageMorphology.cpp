@@ -45,10 +45,33 @@
 #include <catch_amalgamated.hpp>
 #include <visp3/core/vpImageFilter.h>
 #include <visp3/core/vpImageMorphology.h>
+#include <visp3/core/vpUniRand.h>
 
 #ifdef ENABLE_VISP_NAMESPACE
 using namespace VISP_NAMESPACE_NAME;
 #endif
+
+namespace
+{
+// Minimum or maximum over the width x height rectangle centered on each pixel, clipped to the image
+template <typename T>
+void rectangularMorphologyRef(vpImage<T> &I, int width, int height, bool erosion)
+{
+  const vpImage<T> J = I;
+  const int img_height = static_cast<int>(I.getHeight()), img_width = static_cast<int>(I.getWidth());
+  for (int r = 0; r < img_height; ++r) {
+    for (int c = 0; c < img_width; ++c) {
+      T value = J[r][c];
+      for (int rr = std::max<int>(0, r - (height / 2)); rr <= std::min<int>(img_height - 1, r + (height / 2)); ++rr) {
+        for (int cc = std::max<int>(0, c - (width / 2)); cc <= std::min<int>(img_width - 1, c + (width / 2)); ++cc) {
+          value = erosion ? std::min<T>(value, J[rr][cc]) : std::max<T>(value, J[rr][cc]);
+        }
+      }
+      I[r][c] = value;
+    }
+  }
+}
+} // namespace
 TEST_CASE("Binary image morphology", "[image_morphology]")
 {
   unsigned char image_data[8 * 16] = { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
@@ -419,6 +442,99 @@ TEST_CASE("Gray image morphology", "[image_morphology]")
   }
 }
 
+TEST_CASE("Rectangular image morphology", "[image_morphology]")
+{
+  vpUniRand rng(5);
+  const unsigned int img_sizes[] = { 1, 7, 45, 131 };
+  const unsigned int kernel_sizes[] = { 1, 3, 5, 9, 31 };
+
+  SECTION("unsigned char")
+  {
+    bool same = true;
+    for (unsigned int h = 0; h < 4; ++h) {
+      for (unsigned int w = 0; w < 4; ++w) {
+        vpImage<unsigned char> I(img_sizes[h], img_sizes[w]);
+        for (unsigned int i = 0; i < I.getSize(); ++i) {
+          I.bitmap[i] = static_cast<unsigned char>(rng.uniform(0, 256));
+        }
+        for (unsigned int kh = 0; kh < 5; ++kh) {
+          for (unsigned int kw = 0; kw < 5; ++kw) {
+            vpImage<unsigned char> I_erosion = I, I_erosion_ref = I;
+            vpImageMorphology::rectangularErosion(I_erosion, kernel_sizes[kw], kernel_sizes[kh]);
+            rectangularMorphologyRef(I_erosion_ref, kernel_sizes[kw], kernel_sizes[kh], true);
+
+            vpImage<unsigned char> I_dilatation = I, I_dilatation_ref = I;
+            vpImageMorphology::rectangularDilatation(I_dilatation, kernel_sizes[kw], kernel_sizes[kh], 2);
+            rectangularMorphologyRef(I_dilatation_ref, kernel_sizes[kw], kernel_sizes[kh], false);
+            same = same && (I_erosion == I_erosion_ref) && (I_dilatation == I_dilatation_ref);
+          }
+        }
+
+        // Square structuring element
+        vpImage<unsigned char> I_erosion = I, I_erosion_ref = I;
+        vpImageMorphology::erosion(I_erosion, 7);
+        rectangularMorphologyRef(I_erosion_ref, 7, 7, true);
+        same = same && (I_erosion == I_erosion_ref);
+      }
+    }
+    CHECK(same);
+  }
+
+  SECTION("float")
+  {
+    vpImage<float> I(45, 131);
+    for (unsigned int i = 0; i < I.getSize(); ++i) {
+      I.bitmap[i] = rng.uniform(-10.0f, 10.0f);
+    }
+    vpImage<float> I_erosion = I, I_erosion_ref = I;
+    vpImageMorphology::rectangularErosion(I_erosion, 9, 3);
+    rectangularMorphologyRef(I_erosion_ref, 9, 3, true);
+    CHECK((I_erosion == I_erosion_ref));
+
+    vpImage<float> I_dilatation = I, I_dilatation_ref = I;
+    vpImageMorphology::dilatation(I_dilatation, 5);
+    rectangularMorphologyRef(I_dilatation_ref, 5, 5, false);
+    CHECK((I_dilatation == I_dilatation_ref));
+  }
+
+  SECTION("Even size")
+  {
+    vpImage<unsigned char> I(10, 10, 0);
+    CHECK_THROWS_AS(vpImageMorphology::rectangularErosion(I, 4, 3), vpException);
+    CHECK_THROWS_AS(vpImageMorphology::dilatation(I, 2), vpException);
+  }
+}
+
+TEST_CASE("Vectorized 3x3 image morphology", "[image_morphology]")
+{
+  // Sizes around the SIMD register width
+  vpUniRand rng(9);
+  const unsigned int sizes[] = { 1, 2, 15, 16, 17, 33, 70 };
+  bool same = true;
+  for (unsigned int h = 0; h < 7; ++h) {
+    for (unsigned int w = 0; w < 7; ++w) {
+      vpImage<unsigned char> I(sizes[h], sizes[w]);
+      for (unsigned int i = 0; i < I.getSize(); ++i) {
+        I.bitmap[i] = static_cast<unsigned char>(rng.uniform(0, 256));
+      }
+
+      const vpImageMorphology::vpConnexityType connexities[] = { vpImageMorphology::CONNEXITY_4,
+                                                                  vpImageMorphology::CONNEXITY_8 };
+      for (unsigned int k = 0; k < 2; ++k) {
+        vpImage<unsigned char> I_erosion = I, I_erosion_ref = I;
+        vpImageMorphology::erosion<unsigned char>(I_erosion, connexities[k]);
+        common_tools::imageErosionRef(I_erosion_ref, connexities[k]);
+
+        vpImage<unsigned char> I_dilatation = I, I_dilatation_ref = I;
+        vpImageMorphology::dilatation<unsigned char>(I_dilatation, connexities[k]);
+        common_tools::imageDilatationRef(I_dilatation_ref, connexities[k]);
+        same = same && (I_erosion == I_erosion_ref) && (I_dilatation == I_dilatation_ref);
+      }
+    }
+  }
+  CHECK(same);
+}
+
 int main(int argc, char *argv[])
 {
   Catch::Session session;
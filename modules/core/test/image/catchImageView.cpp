@@ -0,0 +1,233 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2024 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test strided, non-owning image views.
+ */
+
+/*!
+  \example catchImageView.cpp
+
+  \brief Test strided, non-owning image views.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2)
+
+#include <vector>
+
+#include <catch_amalgamated.hpp>
+#include <visp3/core/vpImageConvert.h>
+#include <visp3/core/vpImageFilter.h>
+#include <visp3/core/vpImageTools.h>
+#include <visp3/core/vpImageView.h>
+
+#ifdef ENABLE_VISP_NAMESPACE
+using namespace VISP_NAMESPACE_NAME;
+#endif
+
+namespace
+{
+void fill(vpImage<unsigned char> &I)
+{
+  for (unsigned int i = 0; i < I.getHeight(); ++i) {
+    for (unsigned int j = 0; j < I.getWidth(); ++j) {
+      I[i][j] = static_cast<unsigned char>((i * 7 + j * 13) % 256);
+    }
+  }
+}
+
+void fill(vpImage<vpRGBa> &I)
+{
+  for (unsigned int i = 0; i < I.getHeight(); ++i) {
+    for (unsigned int j = 0; j < I.getWidth(); ++j) {
+      I[i][j] = vpRGBa(static_cast<unsigned char>((i * 3) % 256), static_cast<unsigned char>((j * 5) % 256),
+                       static_cast<unsigned char>((i + j) % 256));
+    }
+  }
+}
+}
+
+TEST_CASE("Image view over a ROI", "[image_view]")
+{
+  vpImage<unsigned char> I(48, 64);
+  fill(I);
+
+  SECTION("Same pixels as crop")
+  {
+    const vpRect roi(5, 7, 20, 15);
+    vpImageView<unsigned char> view(I, roi);
+    CHECK(view.getWidth() == 20);
+    CHECK(view.getHeight() == 15);
+    CHECK(view.getPitch() == I.getWidth());
+    CHECK_FALSE(view.isContinuous());
+    CHECK(view.data() == &I[7][5]);
+
+    vpImage<unsigned char> I_crop_ref, I_crop;
+    vpImageTools::crop(I, roi, I_crop_ref);
+    vpImageTools::crop(view, I_crop);
+    CHECK((I_crop == I_crop_ref));
+
+    vpImageTools::crop(I, roi, I_crop_ref, 2, 3);
+    vpImageTools::crop(view, I_crop, 2, 3);
+    CHECK((I_crop == I_crop_ref));
+
+    // Odd top + height, the last subsampled row being inside the ROI
+    const vpRect roi_odd(5, 7, 20, 14);
+    vpImageView<unsigned char> view_odd(I, roi_odd);
+    vpImageTools::crop(I, roi_odd, I_crop_ref, 2, 3);
+    vpImageTools::crop(view_odd, I_crop, 2, 3);
+    CHECK(I_crop.getHeight() == 7);
+    CHECK((I_crop == I_crop_ref));
+
+    // Right and bottom borders of the image
+    vpImageView<unsigned char> full(I);
+    const vpRect full_roi(0, 0, I.getWidth(), I.getHeight());
+    for (unsigned int v_scale = 1; v_scale <= 3; ++v_scale) {
+      for (unsigned int h_scale = 1; h_scale <= 5; ++h_scale) {
+        vpImageTools::crop(I, full_roi, I_crop_ref, v_scale, h_scale);
+        vpImageTools::crop(full, I_crop, v_scale, h_scale);
+        CHECK((I_crop == I_crop_ref));
+      }
+    }
+  }
+
+  SECTION("ROI is clipped to image boundaries")
+  {
+    vpImageView<unsigned char> view(I, vpRect(-10, 40, 30, 30));
+    CHECK(view.getWidth() == 20);
+    CHECK(view.getHeight() == 8);
+    CHECK(view[0] == I[40]);
+
+    vpImageView<unsigned char> empty(I, vpRect(100, 100, 10, 10));
+    CHECK(empty.getSize() == 0);
+  }
+
+  SECTION("Writing through the view modifies the image")
+  {
+    vpImageView<unsigned char> view(I, vpRect(10, 10, 4, 4));
+    view(1, 2) = 42;
+    CHECK(I[11][12] == 42);
+  }
+
+  SECTION("Sub view")
+  {
+    vpImageView<unsigned char> view(I, vpRect(10, 10, 30, 30));
+    vpImageView<unsigned char> sub = view.subView(vpRect(2, 3, 5, 6));
+    CHECK(sub.data() == &I[13][12]);
+    CHECK(sub.getWidth() == 5);
+    CHECK(sub.getHeight() == 6);
+    CHECK(sub.getTop() == 13);
+    CHECK(sub.getLeft() == 12);
+
+    vpImage<unsigned char> I_crop_ref, I_crop;
+    vpImageTools::crop(I, vpRect(12, 13, 5, 6), I_crop_ref, 2, 3);
+    vpImageTools::crop(sub, I_crop, 2, 3);
+    CHECK((I_crop == I_crop_ref));
+  }
+}
+
+TEST_CASE("Image view over a padded buffer", "[image_view]")
+{
+  const unsigned int width = 13, height = 9, pitch = 16;
+  std::vector<unsigned char> buffer(pitch * height, 255);
+  vpImage<unsigned char> I_ref(height, width);
+  fill(I_ref);
+  for (unsigned int i = 0; i < height; ++i) {
+    for (unsigned int j = 0; j < width; ++j) {
+      buffer[i * pitch + j] = I_ref[i][j];
+    }
+  }
+
+  vpImageView<unsigned char> view(buffer.data(), height, width, pitch);
+  vpImage<unsigned char> I;
+  view.copyTo(I);
+  CHECK((I == I_ref));
+
+  CHECK_THROWS_AS(vpImageView<unsigned char>(buffer.data(), height, pitch + 1, pitch), vpException);
+}
+
+TEST_CASE("Filter an image view", "[image_view]")
+{
+  vpImage<unsigned char> I(40, 50);
+  fill(I);
+  const vpRect roi(8, 6, 25, 20);
+
+  vpArray2D<double> M(3, 3);
+  M[0][0] = 1; M[0][1] = 2; M[0][2] = 1;
+  M[1][0] = 0; M[1][1] = 0; M[1][2] = 0;
+  M[2][0] = -1; M[2][1] = -2; M[2][2] = -1;
+
+  for (int convolve = 0; convolve < 2; ++convolve) {
+    vpImage<unsigned char> I_crop;
+    vpImageTools::crop(I, roi, I_crop);
+    vpImage<double> If_ref, If;
+    vpImageFilter::filter(I_crop, If_ref, M, convolve != 0);
+    vpImageFilter::filter(vpImageView<unsigned char>(I, roi), If, M, convolve != 0);
+    CHECK((If == If_ref));
+  }
+}
+
+TEST_CASE("Convert an image view", "[image_view]")
+{
+  vpImage<vpRGBa> I(30, 40);
+  fill(I);
+  const vpRect roi(3, 4, 21, 17);
+
+  vpImage<vpRGBa> I_crop;
+  vpImageTools::crop(I, roi, I_crop);
+  vpImage<unsigned char> I_grey_ref, I_grey;
+  vpImageConvert::convert(I_crop, I_grey_ref);
+  vpImageConvert::convert(vpImageView<vpRGBa>(I, roi), I_grey);
+  CHECK((I_grey == I_grey_ref));
+
+  vpImage<vpRGBa> I_color_ref, I_color;
+  vpImageConvert::convert(I_grey_ref, I_color_ref);
+  vpImage<unsigned char> I_grey_full(30, 40, 0);
+  vpImageView<unsigned char> grey_view(I_grey_full, roi);
+  for (unsigned int i = 0; i < grey_view.getHeight(); ++i) {
+    for (unsigned int j = 0; j < grey_view.getWidth(); ++j) {
+      grey_view[i][j] = I_grey_ref[i][j];
+    }
+  }
+  vpImageConvert::convert(grey_view, I_color);
+  CHECK((I_color == I_color_ref));
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session;
+  session.applyCommandLine(argc, argv);
+  int numFailed = session.run();
+  return numFailed;
+}
+#else
+int main() { return EXIT_SUCCESS; }
+#endif
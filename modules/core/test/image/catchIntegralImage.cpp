@@ -0,0 +1,216 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2024 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ *
+ * Description:
+ * Test integral images and box filters.
+ */
+
+/*!
+  \example catchIntegralImage.cpp
+
+  \brief Test integral images and box filters.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2)
+
+#include <catch_amalgamated.hpp>
+#include <visp3/core/vpImageFilter.h>
+#include <visp3/core/vpImageTools.h>
+#include <visp3/core/vpIntegralImage.h>
+#include <visp3/core/vpUniRand.h>
+
+#ifdef ENABLE_VISP_NAMESPACE
+using namespace VISP_NAMESPACE_NAME;
+#endif
+
+namespace
+{
+void fillRandom(vpImage<unsigned char> &I, vpUniRand &rng)
+{
+  for (unsigned int i = 0; i < I.getSize(); ++i) {
+    I.bitmap[i] = static_cast<unsigned char>(rng.uniform(0, 256));
+  }
+}
+
+bool checkIntegralImage(const vpImage<unsigned char> &I, const vpIntegralImage &II)
+{
+  vpImage<uint64_t> sum(I.getHeight() + 1, I.getWidth() + 1, 0), sq_sum(I.getHeight() + 1, I.getWidth() + 1, 0);
+  for (unsigned int i = 1; i <= I.getHeight(); ++i) {
+    for (unsigned int j = 1; j <= I.getWidth(); ++j) {
+      const uint64_t v = I[i - 1][j - 1];
+      sum[i][j] = (v + sum[i - 1][j] + sum[i][j - 1]) - sum[i - 1][j - 1];
+      sq_sum[i][j] = ((v * v) + sq_sum[i - 1][j] + sq_sum[i][j - 1]) - sq_sum[i - 1][j - 1];
+    }
+  }
+  for (unsigned int i = 0; i <= I.getHeight(); ++i) {
+    for (unsigned int j = 0; j <= I.getWidth(); ++j) {
+      if ((II.getSum()[i][j] != static_cast<uint32_t>(sum[i][j])) ||
+          (II.hasSquaredSum() && (II.getSquaredSum()[i][j] != sq_sum[i][j]))) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+void boxFilterRef(const vpImage<unsigned char> &I, vpImage<double> &I_mean, vpImage<double> &I_stdev,
+                  unsigned int halfSize)
+{
+  const int h = static_cast<int>(I.getHeight()), w = static_cast<int>(I.getWidth()), r = static_cast<int>(halfSize);
+  I_mean.resize(I.getHeight(), I.getWidth());
+  I_stdev.resize(I.getHeight(), I.getWidth());
+  for (int i = 0; i < h; ++i) {
+    for (int j = 0; j < w; ++j) {
+      double sum = 0, sq_sum = 0, n = 0;
+      for (int k = std::max(i - r, 0); k < std::min(i + r + 1, h); ++k) {
+        for (int l = std::max(j - r, 0); l < std::min(j + r + 1, w); ++l) {
+          sum += I[k][l];
+          sq_sum += I[k][l] * I[k][l];
+          ++n;
+        }
+      }
+      I_mean[i][j] = sum / n;
+      I_stdev[i][j] = std::sqrt(std::max(sq_sum / n - vpMath::sqr(sum / n), 0.));
+    }
+  }
+}
+} // anonymous namespace
+
+TEST_CASE("Integral image", "[integral_image]")
+{
+  vpUniRand rng(42);
+  // Width not a multiple of the vector size
+  vpImage<unsigned char> I(61, 83);
+  fillRandom(I, rng);
+
+  SECTION("Compute")
+  {
+    vpIntegralImage II(I);
+    CHECK(II.getHeight() == I.getHeight());
+    CHECK(II.getWidth() == I.getWidth());
+    CHECK_FALSE(II.hasSquaredSum());
+    CHECK(checkIntegralImage(I, II));
+
+    II.compute(I, true);
+    CHECK(II.hasSquaredSum());
+    CHECK(checkIntegralImage(I, II));
+
+    uint32_t sum = 0;
+    uint64_t sq_sum = 0;
+    for (unsigned int i = 10; i < 30; ++i) {
+      for (unsigned int j = 5; j < 50; ++j) {
+        sum += I[i][j];
+        sq_sum += I[i][j] * I[i][j];
+      }
+    }
+    CHECK(II.getSum(10, 5, 30, 50) == sum);
+    CHECK(II.getSquaredSum(10, 5, 30, 50) == sq_sum);
+    CHECK(II.getMean(10, 5, 30, 50) == Catch::Approx(sum / 900.));
+    CHECK(II.getVariance(10, 5, 30, 50) == Catch::Approx(sq_sum / 900. - vpMath::sqr(sum / 900.)));
+  }
+
+  SECTION("Update")
+  {
+    vpIntegralImage II(I, true);
+    // Modify pixels in a region of interest whose corners are not on the pixel grid
+    const vpRect roi(20.5, 12.3, 30, 25);
+    for (unsigned int i = 12; i < 38; ++i) {
+      for (unsigned int j = 20; j < 51; ++j) {
+        I[i][j] = static_cast<unsigned char>(255 - I[i][j]);
+      }
+    }
+    II.update(I, roi);
+    CHECK(checkIntegralImage(I, II));
+
+    vpImage<unsigned char> I_small(10, 10);
+    CHECK_THROWS_AS(II.update(I_small, roi), vpException);
+  }
+}
+
+TEST_CASE("Box filters", "[integral_image]")
+{
+  vpUniRand rng(1);
+  vpImage<unsigned char> I(47, 71);
+  fillRandom(I, rng);
+
+  for (unsigned int halfSize = 0; halfSize <= 30; halfSize += 5) {
+    vpImage<double> I_mean_ref, I_stdev_ref;
+    boxFilterRef(I, I_mean_ref, I_stdev_ref, halfSize);
+
+    vpImage<float> I_mean, I_stdev;
+    vpImage<unsigned char> I_mean_uchar;
+    vpImageFilter::boxFilter(I, I_mean, halfSize);
+    vpImageFilter::boxFilter(I, I_mean_uchar, halfSize);
+    vpImageFilter::localMeanAndStdev(I, I_mean, I_stdev, halfSize, 2);
+    bool same = true;
+    for (unsigned int i = 0; i < I.getSize(); ++i) {
+      same = same && vpMath::equal(I_mean.bitmap[i], I_mean_ref.bitmap[i], 1e-4) &&
+        vpMath::equal(I_stdev.bitmap[i], I_stdev_ref.bitmap[i], 1e-3) &&
+        (I_mean_uchar.bitmap[i] == vpMath::saturate<unsigned char>(I_mean_ref.bitmap[i]));
+    }
+    CHECK(same);
+  }
+
+  // The integral image of the squared pixels is needed for the standard deviation
+  vpImage<float> I_mean, I_stdev;
+  CHECK_THROWS_AS(vpImageFilter::localMeanAndStdev(vpIntegralImage(I), I_mean, I_stdev, 1), vpException);
+}
+
+TEST_CASE("Template matching with integral images", "[integral_image]")
+{
+  vpUniRand rng(7);
+  vpImage<unsigned char> I(60, 80);
+  fillRandom(I, rng);
+  vpImage<unsigned char> I_tpl;
+  vpImageTools::crop(I, vpRect(30, 20, 16, 12), I_tpl);
+
+  vpImage<double> I_score, I_score_ref;
+  vpImageTools::templateMatching(I, I_tpl, I_score, 1, 1, true);
+  vpImageTools::templateMatching(I, I_tpl, I_score_ref, 1, 1, false);
+  bool same = true;
+  for (unsigned int i = 0; i < I_score.getSize(); ++i) {
+    same = same && vpMath::equal(I_score.bitmap[i], I_score_ref.bitmap[i], 1e-9);
+  }
+  CHECK(same);
+  CHECK(I_score[20][30] == Catch::Approx(1.0));
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session;
+  session.applyCommandLine(argc, argv);
+  int numFailed = session.run();
+  return numFailed;
+}
+#else
+int main() { return EXIT_SUCCESS; }
+#endif
@@ -0,0 +1,460 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2024 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ *
+ * Description:
+ * Test and benchmark the separable filters and the Gaussian pyramid.
+ */
+
+/*!
+  \example catchSeparableFilter.cpp
+
+  \brief Test and benchmark the separable filters and the Gaussian pyramid.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2)
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+#include <catch_amalgamated.hpp>
+#include <visp3/core/vpImageFilter.h>
+#include <visp3/core/vpUniRand.h>
+
+#ifdef ENABLE_VISP_NAMESPACE
+using namespace VISP_NAMESPACE_NAME;
+#endif
+
+static bool runBenchmark = false;
+
+namespace
+{
+void fillRandom(vpImage<unsigned char> &I, vpUniRand &rng)
+{
+  for (unsigned int i = 0; i < I.getSize(); ++i) {
+    I.bitmap[i] = static_cast<unsigned char>(rng.uniform(0, 256));
+  }
+}
+
+void fillRandom(vpImage<vpRGBa> &I, vpUniRand &rng)
+{
+  for (unsigned int i = 0; i < I.getSize(); ++i) {
+    I.bitmap[i] = vpRGBa(static_cast<unsigned char>(rng.uniform(0, 256)),
+                         static_cast<unsigned char>(rng.uniform(0, 256)),
+                         static_cast<unsigned char>(rng.uniform(0, 256)), 255);
+  }
+}
+
+// Straightforward implementation of the border extrapolation
+int referenceIndex(int p, int n, vpImageFilter::vpBorderType border)
+{
+  while ((p < 0) || (p >= n)) {
+    switch (border) {
+    case vpImageFilter::BORDER_CONSTANT:
+      return -1;
+    case vpImageFilter::BORDER_REPLICATE:
+      p = (p < 0) ? 0 : (n - 1);
+      break;
+    case vpImageFilter::BORDER_REFLECT:
+      p = (p < 0) ? (-p - 1) : ((2 * n) - p - 1);
+      break;
+    case vpImageFilter::BORDER_REFLECT_101:
+      p = (n == 1) ? 0 : ((p < 0) ? -p : ((2 * n) - p - 2));
+      break;
+    case vpImageFilter::BORDER_DEFAULT:
+    default:
+      p = (n == 1) ? 0 : ((p < 0) ? -p : ((2 * n) - p - 1));
+      break;
+    }
+  }
+  return p;
+}
+
+// Separable correlation computed in double with the straightforward extrapolation of the borders
+template <typename ImageType>
+void referenceSepFilter(const vpImage<ImageType> &I, vpImage<double> &If, const std::vector<double> &kx,
+                        const std::vector<double> &ky, vpImageFilter::vpBorderType border)
+{
+  const int h = static_cast<int>(I.getHeight()), w = static_cast<int>(I.getWidth());
+  const int hx = static_cast<int>(kx.size() / 2), hy = static_cast<int>(ky.size() / 2);
+  vpImage<double> Ix(I.getHeight(), I.getWidth());
+  for (int i = 0; i < h; ++i) {
+    for (int j = 0; j < w; ++j) {
+      double acc = 0.;
+      for (int t = -hx; t <= hx; ++t) {
+        const int c = referenceIndex(j + t, w, border);
+        acc += (c < 0) ? 0. : (kx[t + hx] * static_cast<double>(I[i][c]));
+      }
+      Ix[i][j] = acc;
+    }
+  }
+  If.resize(I.getHeight(), I.getWidth());
+  for (int i = 0; i < h; ++i) {
+    for (int j = 0; j < w; ++j) {
+      double acc = 0.;
+      for (int t = -hy; t <= hy; ++t) {
+        const int r = referenceIndex(i + t, h, border);
+        acc += (r < 0) ? 0. : (ky[t + hy] * Ix[r][j]);
+      }
+      If[i][j] = acc;
+    }
+  }
+}
+
+template <typename Type1, typename Type2>
+double maxAbsDiff(const vpImage<Type1> &I1, const vpImage<Type2> &I2)
+{
+  REQUIRE(I1.getHeight() == I2.getHeight());
+  REQUIRE(I1.getWidth() == I2.getWidth());
+  double maxDiff = 0.;
+  for (unsigned int i = 0; i < I1.getSize(); ++i) {
+    maxDiff = std::max(maxDiff, std::fabs(static_cast<double>(I1.bitmap[i]) - static_cast<double>(I2.bitmap[i])));
+  }
+  return maxDiff;
+}
+
+bool sameColors(const vpImage<vpRGBa> &I1, const vpImage<vpRGBa> &I2)
+{
+  for (unsigned int i = 0; i < I1.getSize(); ++i) {
+    if ((I1.bitmap[i].R != I2.bitmap[i].R) || (I1.bitmap[i].G != I2.bitmap[i].G) ||
+        (I1.bitmap[i].B != I2.bitmap[i].B)) {
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
+TEST_CASE("Separable filter against a reference implementation", "[sepFilter]")
+{
+  vpUniRand rng(42);
+  const vpImageFilter::vpBorderType borders[] = { vpImageFilter::BORDER_DEFAULT, vpImageFilter::BORDER_REFLECT_101,
+                                                  vpImageFilter::BORDER_REFLECT, vpImageFilter::BORDER_REPLICATE,
+                                                  vpImageFilter::BORDER_CONSTANT };
+  // Generic, symmetric and antisymmetric kernels
+  std::vector<std::vector<double> > kernels(3);
+  kernels[0].push_back(0.1); kernels[0].push_back(-0.3); kernels[0].push_back(0.7);
+  kernels[0].push_back(0.2); kernels[0].push_back(0.05);
+  kernels[1].push_back(0.25); kernels[1].push_back(0.5); kernels[1].push_back(0.25);
+  kernels[2].push_back(-1.); kernels[2].push_back(-2.); kernels[2].push_back(0.);
+  kernels[2].push_back(2.); kernels[2].push_back(1.);
+
+  const unsigned int sizes[][2] = { { 37, 53 }, { 1, 9 }, { 9, 1 }, { 3, 2 }, { 64, 41 } };
+  for (unsigned int s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+    vpImage<unsigned char> I(sizes[s][0], sizes[s][1]);
+    fillRandom(I, rng);
+    vpImage<float> I_float(I.getHeight(), I.getWidth());
+    for (unsigned int i = 0; i < I.getSize(); ++i) {
+      I_float.bitmap[i] = static_cast<float>(I.bitmap[i]);
+    }
+
+    for (size_t kx = 0; kx < kernels.size(); ++kx) {
+      for (size_t ky = 0; ky < kernels.size(); ++ky) {
+        for (unsigned int b = 0; b < sizeof(borders) / sizeof(borders[0]); ++b) {
+          for (int convolve = 0; convolve < 2; ++convolve) {
+            std::vector<double> refX = kernels[kx], refY = kernels[ky];
+            if (convolve) {
+              std::reverse(refX.begin(), refX.end());
+              std::reverse(refY.begin(), refY.end());
+            }
+            vpImage<double> Iref;
+            referenceSepFilter(I, Iref, refX, refY, borders[b]);
+
+            std::vector<float> kxFloat(kernels[kx].begin(), kernels[kx].end());
+            std::vector<float> kyFloat(kernels[ky].begin(), kernels[ky].end());
+            for (unsigned int nThreads = 1; nThreads <= 3; ++nThreads) {
+              INFO("Image " << I.getHeight() << "x" << I.getWidth() << ", kernels " << kx << " and " << ky
+                   << ", border " << borders[b] << ", convolve " << convolve << ", " << nThreads << " threads");
+              vpImage<double> If_double;
+              vpImageFilter::sepFilter(I, If_double, &kernels[kx][0], static_cast<unsigned int>(kernels[kx].size()),
+                                       &kernels[ky][0], static_cast<unsigned int>(kernels[ky].size()), convolve != 0,
+                                       borders[b], nThreads);
+              CHECK(maxAbsDiff(If_double, Iref) < 1e-9);
+
+              vpImage<float> If_float;
+              vpImageFilter::sepFilter(I_float, If_float, &kxFloat[0], static_cast<unsigned int>(kxFloat.size()),
+                                       &kyFloat[0], static_cast<unsigned int>(kyFloat.size()), convolve != 0,
+                                       borders[b], nThreads);
+              CHECK(maxAbsDiff(If_float, Iref) < 1e-3);
+            }
+          }
+        }
+      }
+    }
+  }
+
+  SECTION("In place filtering")
+  {
+    vpImage<float> I(48, 67);
+    for (unsigned int i = 0; i < I.getSize(); ++i) {
+      I.bitmap[i] = static_cast<float>(rng.uniform(0., 1.));
+    }
+    const float kernel[] = { 0.25f, 0.5f, 0.25f };
+    vpImage<float> If;
+    vpImageFilter::sepFilter(I, If, kernel, 3, kernel, 3);
+    vpImageFilter::sepFilter(I, I, kernel, 3, kernel, 3);
+    CHECK(maxAbsDiff(I, If) == 0.);
+  }
+
+  SECTION("Even kernel size")
+  {
+    const double kernel[] = { 0.5, 0.5 };
+    vpImage<double> If;
+    CHECK_THROWS_AS(vpImageFilter::sepFilter(vpImage<double>(5, 5, 1.), If, kernel, 2, kernel, 1), vpException);
+  }
+}
+
+TEST_CASE("Filters of vpImageFilter against their masked implementation", "[sepFilter]")
+{
+  // The masked implementation is the historical one, a mask accepting every pixel gives the same results
+  vpUniRand rng(7);
+  vpImage<unsigned char> I(61, 83);
+  fillRandom(I, rng);
+  const vpImage<bool> mask(I.getHeight(), I.getWidth(), true);
+  const unsigned int size = 7;
+
+  SECTION("Gaussian blur")
+  {
+    vpImage<float> GI, GI_masked;
+    vpImageFilter::gaussianBlur(I, GI, size, 1.5f);
+    vpImageFilter::gaussianBlur(I, GI_masked, size, 1.5f, true, &mask);
+    CHECK(maxAbsDiff(GI, GI_masked) < 1e-4);
+
+    vpImage<double> GI_double, GI_double_masked;
+    vpImageFilter::gaussianBlur(I, GI_double, size, 1.5);
+    vpImageFilter::gaussianBlur(I, GI_double_masked, size, 1.5, true, &mask);
+    CHECK(maxAbsDiff(GI_double, GI_double_masked) < 1e-10);
+
+    vpImage<float> GI_float, GI_float_masked;
+    vpImageFilter::gaussianBlur(GI, GI_float, size, 1.5f);
+    vpImageFilter::gaussianBlur(GI, GI_float_masked, size, 1.5f, true, &mask);
+    CHECK(maxAbsDiff(GI_float, GI_float_masked) < 1e-4);
+  }
+
+  SECTION("Filter along each axis")
+  {
+    double filter[(size + 1) / 2];
+    vpImageFilter::getGaussianKernel(filter, size, 2.);
+    vpImage<double> dIx, dIx_masked, dIy, dIy_masked, GI, GI_masked;
+    vpImageFilter::filterX(I, dIx, filter, size);
+    vpImageFilter::filterX(I, dIx_masked, filter, size, &mask);
+    CHECK(maxAbsDiff(dIx, dIx_masked) < 1e-10);
+    vpImageFilter::filterY(I, dIy, filter, size);
+    vpImageFilter::filterY(I, dIy_masked, filter, size, &mask);
+    CHECK(maxAbsDiff(dIy, dIy_masked) < 1e-10);
+    vpImageFilter::filter(I, GI, filter, size);
+    vpImageFilter::filter(I, GI_masked, filter, size, &mask);
+    CHECK(maxAbsDiff(GI, GI_masked) < 1e-10);
+  }
+
+  SECTION("Gradients")
+  {
+    float filter[(size + 1) / 2];
+    vpImageFilter::getGaussianDerivativeKernel(filter, size, 1.f);
+    vpImage<float> dIx, dIx_masked, dIy, dIy_masked;
+    vpImageFilter::getGradX(I, dIx, filter, size);
+    vpImageFilter::getGradX(I, dIx_masked, filter, size, &mask);
+    CHECK(maxAbsDiff(dIx, dIx_masked) < 1e-4);
+    vpImageFilter::getGradY(I, dIy, filter, size);
+    vpImageFilter::getGradY(I, dIy_masked, filter, size, &mask);
+    CHECK(maxAbsDiff(dIy, dIy_masked) < 1e-4);
+  }
+
+  SECTION("Color images")
+  {
+    vpImage<vpRGBa> I_color(I.getHeight(), I.getWidth());
+    fillRandom(I_color, rng);
+    double filter[(size + 1) / 2];
+    vpImageFilter::getGaussianKernel(filter, size, 2.);
+    vpImage<vpRGBa> dIx, dIx_masked, dIy, dIy_masked, GI, GI_masked;
+    vpImageFilter::filterX(I_color, dIx, filter, size);
+    vpImageFilter::filterX(I_color, dIx_masked, filter, size, &mask);
+    CHECK(sameColors(dIx, dIx_masked));
+    vpImageFilter::filterY(I_color, dIy, filter, size);
+    vpImageFilter::filterY(I_color, dIy_masked, filter, size, &mask);
+    CHECK(sameColors(dIy, dIy_masked));
+    vpImageFilter::gaussianBlur(I_color, GI, size, 2.);
+    vpImageFilter::gaussianBlur(I_color, GI_masked, size, 2., true, &mask);
+    CHECK(sameColors(GI, GI_masked));
+  }
+
+  SECTION("Separable filter with vpColVector kernels")
+  {
+    vpColVector kernelH(5), kernelV(5);
+    kernelH[0] = 1.; kernelH[1] = 2.; kernelH[2] = 0.; kernelH[3] = -2.; kernelH[4] = -1.;
+    kernelV[0] = 1.; kernelV[1] = 4.; kernelV[2] = 6.; kernelV[3] = 4.; kernelV[4] = 1.;
+    vpImage<double> If;
+    vpImageFilter::sepFilter(I, If, kernelH, kernelV);
+
+    // Convolution restricted to the pixels fully covered by the kernels
+    vpImage<double> Iref(I.getHeight(), I.getWidth(), 0.);
+    for (unsigned int i = 2; (i + 2) < I.getHeight(); ++i) {
+      for (unsigned int j = 2; (j + 2) < I.getWidth(); ++j) {
+        for (unsigned int a = 0; a < 5; ++a) {
+          for (unsigned int b = 0; b < 5; ++b) {
+            Iref[i][j] += kernelV[a] * kernelH[b] * static_cast<double>(I[(i + 2) - a][(j + 2) - b]);
+          }
+        }
+      }
+    }
+    CHECK(maxAbsDiff(If, Iref) < 1e-9);
+  }
+
+  SECTION("Separable filter with vpColVector kernels of different sizes")
+  {
+    // The rows kept follow the size of the vertical kernel, the columns the size of the horizontal one
+    const unsigned int sizes[2][2] = { { 3, 7 }, { 7, 3 } };
+    for (unsigned int s = 0; s < 2; ++s) {
+      const unsigned int sizeH = sizes[s][0], sizeV = sizes[s][1];
+      const unsigned int halfH = sizeH / 2, halfV = sizeV / 2;
+      vpColVector kernelH(sizeH), kernelV(sizeV);
+      for (unsigned int a = 0; a < sizeH; ++a) {
+        kernelH[a] = static_cast<double>(a) - 1.5;
+      }
+      for (unsigned int a = 0; a < sizeV; ++a) {
+        kernelV[a] = 1. + static_cast<double>(a * a);
+      }
+      vpImage<double> If;
+      vpImageFilter::sepFilter(I, If, kernelH, kernelV);
+
+      vpImage<double> Iref(I.getHeight(), I.getWidth(), 0.);
+      for (unsigned int i = halfV; (i + halfV) < I.getHeight(); ++i) {
+        for (unsigned int j = halfH; (j + halfH) < I.getWidth(); ++j) {
+          for (unsigned int a = 0; a < sizeV; ++a) {
+            for (unsigned int b = 0; b < sizeH; ++b) {
+              Iref[i][j] += kernelV[a] * kernelH[b] * static_cast<double>(I[(i + halfV) - a][(j + halfH) - b]);
+            }
+          }
+        }
+      }
+      CHECK(maxAbsDiff(If, Iref) < 1e-9);
+    }
+  }
+}
+
+TEST_CASE("Gaussian pyramid", "[sepFilter]")
+{
+  vpUniRand rng(3);
+  const unsigned int sizes[][2] = { { 97, 131 }, { 40, 36 }, { 4, 4 }, { 2, 3 } };
+  for (unsigned int s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+    vpImage<unsigned char> I(sizes[s][0], sizes[s][1]);
+    fillRandom(I, rng);
+    const unsigned int w = I.getWidth() / 2, h = I.getHeight() / 2;
+
+    vpImage<unsigned char> GIx, GIy;
+    vpImageFilter::getGaussXPyramidal(I, GIx);
+    vpImageFilter::getGaussYPyramidal(I, GIy);
+    REQUIRE(GIx.getWidth() == w);
+    REQUIRE(GIy.getHeight() == h);
+    bool sameX = true, sameY = true;
+    for (unsigned int i = 0; i < I.getHeight(); ++i) {
+      for (unsigned int j = 1; (j + 1) < w; ++j) {
+        sameX = sameX && (GIx[i][j] == vpImageFilter::filterGaussXPyramidal(I, i, 2 * j));
+      }
+      // With a single column, the last column is the first one
+      sameX = sameX && ((w == 1) || (GIx[i][0] == I[i][0])) && (GIx[i][w - 1] == I[i][(2 * w) - 1]);
+    }
+    for (unsigned int j = 0; j < I.getWidth(); ++j) {
+      for (unsigned int i = 1; (i + 1) < h; ++i) {
+        sameY = sameY && (GIy[i][j] == vpImageFilter::filterGaussYPyramidal(I, 2 * i, j));
+      }
+      sameY = sameY && ((h == 1) || (GIy[0][j] == I[0][j])) && (GIy[h - 1][j] == I[(2 * h) - 1][j]);
+    }
+    INFO("Image " << I.getHeight() << "x" << I.getWidth());
+    CHECK(sameX);
+    CHECK(sameY);
+  }
+}
+
+TEST_CASE("Separable filter benchmark", "[benchmark]")
+{
+  if (runBenchmark) {
+    vpUniRand rng(1);
+    vpImage<unsigned char> I(1080, 1920);
+    fillRandom(I, rng);
+    const unsigned int size = 7;
+    float kernel[size];
+    vpImageFilter::getGaussianKernel(kernel, size, 2.f);
+    std::vector<float> fullKernel(size);
+    for (unsigned int i = 0; i <= size / 2; ++i) {
+      fullKernel[(size / 2) + i] = fullKernel[(size / 2) - i] = kernel[i];
+    }
+    const vpImage<bool> mask(I.getHeight(), I.getWidth(), true);
+
+    vpImage<float> GI;
+    BENCHMARK("Benchmark historical Gaussian blur on a 1080p image")
+    {
+      vpImageFilter::gaussianBlur(I, GI, size, 2.f, true, &mask);
+      return GI;
+    };
+
+    BENCHMARK("Benchmark separable filter on a 1080p image, 1 thread")
+    {
+      vpImageFilter::sepFilter(I, GI, &fullKernel[0], size, &fullKernel[0], size, false,
+                               vpImageFilter::BORDER_DEFAULT, 1);
+      return GI;
+    };
+
+    BENCHMARK("Benchmark separable filter on a 1080p image")
+    {
+      vpImageFilter::sepFilter(I, GI, &fullKernel[0], size, &fullKernel[0], size);
+      return GI;
+    };
+
+    vpImage<unsigned char> I_pyr;
+    BENCHMARK("Benchmark Gaussian pyramid on a 1080p image")
+    {
+      vpImageFilter::getGaussPyramidal(I, I_pyr);
+      return I_pyr;
+    };
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session;
+
+  auto cli = session.cli()         // Get Catch's composite command line parser
+    | Catch::Clara::Opt(runBenchmark)   // bind variable to a new option, with a hint string
+    ["--benchmark"] // the option names it will respond to
+    ("run benchmark of the separable filters"); // description string for the help output
+
+  // Now pass the new composite back to Catch so it uses that
+  session.cli(cli);
+  session.applyCommandLine(argc, argv);
+  int numFailed = session.run();
+  return numFailed;
+}
+#else
+int main() { return EXIT_SUCCESS; }
+#endif
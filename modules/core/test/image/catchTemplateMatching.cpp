@@ -0,0 +1,143 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2024 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ *
+ * Description:
+ * Test spatial, frequency-domain and coarse-to-fine template matching.
+ */
+
+/*!
+  \example catchTemplateMatching.cpp
+
+  \brief Test spatial, frequency-domain and coarse-to-fine template matching.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2)
+
+#include <catch_amalgamated.hpp>
+#include <visp3/core/vpImageFilter.h>
+#include <visp3/core/vpImageTools.h>
+#include <visp3/core/vpUniRand.h>
+
+#ifdef ENABLE_VISP_NAMESPACE
+using namespace VISP_NAMESPACE_NAME;
+#endif
+
+namespace
+{
+// Blurred noise, so that the downscaled images keep a unique match
+void fillTexture(vpImage<unsigned char> &I, vpUniRand &rng)
+{
+  vpImage<unsigned char> I_noise(I.getHeight(), I.getWidth());
+  for (unsigned int i = 0; i < I_noise.getSize(); ++i) {
+    I_noise.bitmap[i] = static_cast<unsigned char>(rng.uniform(0, 256));
+  }
+  vpImageFilter::boxFilter(I_noise, I, 3);
+}
+
+bool sameScores(const vpImage<double> &I_score1, const vpImage<double> &I_score2, double threshold)
+{
+  if ((I_score1.getHeight() != I_score2.getHeight()) || (I_score1.getWidth() != I_score2.getWidth())) {
+    return false;
+  }
+  for (unsigned int i = 0; i < I_score1.getSize(); ++i) {
+    if (!vpMath::equal(I_score1.bitmap[i], I_score2.bitmap[i], threshold)) {
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
+TEST_CASE("Frequency-domain template matching", "[template_matching]")
+{
+  vpUniRand rng(11);
+  // Sizes with prime factors other than 2, 3 and 5 to exercise the FFT padding
+  vpImage<unsigned char> I(97, 131);
+  fillTexture(I, rng);
+
+  SECTION("Same scores as the spatial computation")
+  {
+    vpImage<unsigned char> I_tpl;
+    vpImageTools::crop(I, vpRect(40, 25, 37, 29), I_tpl);
+
+    const unsigned int steps[] = { 1, 3 };
+    for (unsigned int s = 0; s < 2; ++s) {
+      vpImage<double> I_score_fft, I_score_spatial, I_score_ref;
+      vpImageTools::templateMatching(I, I_tpl, I_score_fft, steps[s], steps[s], vpImageTools::TEMPLATE_MATCHING_FFT);
+      vpImageTools::templateMatching(I, I_tpl, I_score_spatial, steps[s], steps[s],
+                                     vpImageTools::TEMPLATE_MATCHING_SPATIAL, 2);
+      vpImageTools::templateMatching(I, I_tpl, I_score_ref, steps[s], steps[s], false);
+      CHECK(sameScores(I_score_fft, I_score_ref, 1e-9));
+      CHECK(sameScores(I_score_spatial, I_score_ref, 1e-9));
+    }
+  }
+
+  SECTION("Template as big as the image")
+  {
+    vpImage<double> I_score;
+    vpImageTools::templateMatching(I, I, I_score, 1, 1, vpImageTools::TEMPLATE_MATCHING_FFT);
+    CHECK(I_score.getSize() == 0);
+  }
+}
+
+TEST_CASE("Coarse-to-fine template matching", "[template_matching]")
+{
+  vpUniRand rng(13);
+  vpImage<unsigned char> I(240, 320);
+  fillTexture(I, rng);
+
+  const unsigned int top = 117, left = 203;
+  vpImage<unsigned char> I_tpl;
+  vpImageTools::crop(I, top, left, 64, 48, I_tpl);
+
+  for (unsigned int nbScales = 1; nbScales <= 4; ++nbScales) {
+    vpImagePoint ip;
+    const double score = vpImageTools::templateMatchingCoarseToFine(I, I_tpl, ip, nbScales);
+    CHECK(ip.get_i() == top);
+    CHECK(ip.get_j() == left);
+    CHECK(score == Catch::Approx(1.0));
+  }
+
+  vpImagePoint ip;
+  CHECK_THROWS_AS(vpImageTools::templateMatchingCoarseToFine(I_tpl, I, ip), vpException);
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session;
+  session.applyCommandLine(argc, argv);
+  int numFailed = session.run();
+  return numFailed;
+}
+#else
+int main() { return EXIT_SUCCESS; }
+#endif
@@ -0,0 +1,187 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2024 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ *
+ * Description:
+ * Test fixed-size matrices.
+ */
+
+/*!
+  \example catchFixedMatrix.cpp
+
+  \brief Test fixed-size matrices and the 6-dof computations relying on them.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2)
+
+#include <catch_amalgamated.hpp>
+
+#include <visp3/core/vpExponentialMap.h>
+#include <visp3/core/vpFixedMatrix.h>
+#include <visp3/core/vpMatrix.h>
+#include <visp3/core/vpUniRand.h>
+#include <visp3/core/vpVelocityTwistMatrix.h>
+
+#ifdef ENABLE_VISP_NAMESPACE
+using namespace VISP_NAMESPACE_NAME;
+#endif
+
+namespace
+{
+vpMatrix generateRandomMatrix(unsigned int rows, unsigned int cols, vpUniRand &rng)
+{
+  vpMatrix M(rows, cols);
+  for (unsigned int i = 0; i < M.getRows(); ++i) {
+    for (unsigned int j = 0; j < M.getCols(); ++j) {
+      M[i][j] = rng.uniform(-1., 1.);
+    }
+  }
+  return M;
+}
+
+template <unsigned int Rows, unsigned int Cols>
+bool equal(const vpFixedMatrix<Rows, Cols> &A, const vpArray2D<double> &B, double epsilon)
+{
+  if ((B.getRows() != Rows) || (B.getCols() != Cols)) {
+    return false;
+  }
+  for (unsigned int i = 0; i < Rows; ++i) {
+    for (unsigned int j = 0; j < Cols; ++j) {
+      if (std::fabs(A[i][j] - B[i][j]) > epsilon) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool equal(const vpArray2D<double> &A, const vpArray2D<double> &B, double epsilon)
+{
+  if ((A.getRows() != B.getRows()) || (A.getCols() != B.getCols())) {
+    return false;
+  }
+  for (unsigned int i = 0; i < A.size(); ++i) {
+    if (std::fabs(A.data[i] - B.data[i]) > epsilon) {
+      return false;
+    }
+  }
+  return true;
+}
+} // anonymous namespace
+
+TEST_CASE("Fixed-size matrix arithmetic", "[fixed_matrix]")
+{
+  vpUniRand rng(42);
+  const vpMatrix A = generateRandomMatrix(2, 6, rng);
+  const vpMatrix B = generateRandomMatrix(6, 6, rng);
+  const vpMatrix C = generateRandomMatrix(2, 6, rng);
+
+  const vpFixedMatrix<2, 6> Af(A);
+  const vpFixedMatrix<6, 6> Bf(B);
+  const vpFixedMatrix<2, 6> Cf(C);
+
+  CHECK(equal(Af, A, 0.));
+  CHECK(equal(Af * Bf, A * B, 1e-12));
+  CHECK(equal(Af + Cf, A + C, 0.));
+  CHECK(equal(Af - Cf, A - C, 0.));
+  CHECK(equal(Af * 3., A * 3., 0.));
+  CHECK(equal(Af.t(), A.t(), 0.));
+
+  vpFixedMatrix<6, 6> I;
+  I.eye();
+  vpMatrix I_ref;
+  I_ref.eye(6);
+  CHECK(equal(I, I_ref, 0.));
+  CHECK(equal(Bf * I, B, 0.));
+
+  vpMatrix M(4, 8, 0.);
+  Af.copyTo(M, 1, 2);
+  CHECK(M[1][2] == A[0][0]);
+  CHECK(M[2][7] == A[1][5]);
+  CHECK(M[0][0] == 0.);
+
+  typedef vpFixedMatrix<3, 3> vpFixedMatrix33;
+  CHECK_THROWS_AS(vpFixedMatrix33(A), vpException);
+  CHECK_THROWS_AS(Af.copyTo(M, 3, 0), vpException);
+}
+
+TEST_CASE("Exponential map", "[fixed_matrix]")
+{
+  vpUniRand rng(42);
+  for (unsigned int n = 0; n < 10; ++n) {
+    vpColVector v(6);
+    for (unsigned int i = 0; i < 6; ++i) {
+      v[i] = rng.uniform(-0.5, 0.5);
+    }
+    const double delta_t = 0.04;
+    vpHomogeneousMatrix M = vpExponentialMap::direct(v, delta_t);
+
+    // Rotation part is the one built from the theta u vector
+    vpRotationMatrix R_ref(vpThetaUVector(v[3] * delta_t, v[4] * delta_t, v[5] * delta_t));
+    CHECK(equal(M.getRotationMatrix(), R_ref, 0.));
+    CHECK(M[3][0] == 0.);
+    CHECK(M[3][3] == 1.);
+    CHECK(equal(vpExponentialMap::inverse(M, delta_t), v, 1e-9));
+  }
+}
+
+TEST_CASE("Velocity twist matrix", "[fixed_matrix]")
+{
+  vpHomogeneousMatrix M(0.1, -0.2, 0.5, vpMath::rad(10), vpMath::rad(-25), vpMath::rad(40));
+  vpTranslationVector t = M.getTranslationVector();
+  vpRotationMatrix R = M.getRotationMatrix();
+  vpVelocityTwistMatrix V(t, R);
+
+  vpMatrix skewaR_ref = vpTranslationVector::skew(t) * R;
+  for (unsigned int i = 0; i < 3; ++i) {
+    for (unsigned int j = 0; j < 3; ++j) {
+      CHECK(V[i][j + 3] == Catch::Approx(skewaR_ref[i][j]).margin(1e-12));
+      CHECK(V[i + 3][j] == 0.);
+    }
+  }
+
+  vpVelocityTwistMatrix V_inv_ref(M.inverse());
+  CHECK(equal(V.inverse(), V_inv_ref, 1e-12));
+  vpMatrix I;
+  I.eye(6);
+  CHECK(equal(V * V.inverse(), I, 1e-12));
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session;
+  session.applyCommandLine(argc, argv);
+  int numFailed = session.run();
+  return numFailed;
+}
+#else
+int main() { return EXIT_SUCCESS; }
+#endif
@@ -0,0 +1,255 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2024 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ *
+ * Description:
+ * Test and benchmark memory reuse in pseudo inverse computation.
+ */
+
+/*!
+  \example perfMatrixPseudoInverse.cpp
+
+  \brief Test that computing repeatedly the pseudo inverse or the SVD of
+  matrices with the same size doesn't allocate memory, and benchmark it.
+ */
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2) && defined(VISP_HAVE_LAPACK)
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include <catch_amalgamated.hpp>
+
+#include <visp3/core/vpColVector.h>
+#include <visp3/core/vpMatrix.h>
+#include <visp3/core/vpUniRand.h>
+
+#ifdef ENABLE_VISP_NAMESPACE
+using namespace VISP_NAMESPACE_NAME;
+#endif
+
+static bool runBenchmark = false;
+static std::atomic<size_t> nbAllocations(0);
+
+#if defined(__GLIBC__)
+// vpArray2D storage is allocated with malloc() and realloc(), that are counted as well as operator new
+extern "C"
+{
+  void *__libc_malloc(std::size_t size);
+  void *__libc_calloc(std::size_t nmemb, std::size_t size);
+  void *__libc_realloc(void *ptr, std::size_t size);
+
+  void *malloc(std::size_t size)
+  {
+    ++nbAllocations;
+    return __libc_malloc(size);
+  }
+
+  void *calloc(std::size_t nmemb, std::size_t size)
+  {
+    ++nbAllocations;
+    return __libc_calloc(nmemb, size);
+  }
+
+  void *realloc(void *ptr, std::size_t size)
+  {
+    ++nbAllocations;
+    return __libc_realloc(ptr, size);
+  }
+}
+#endif
+
+void *operator new(std::size_t size)
+{
+  ++nbAllocations;
+  void *ptr = std::malloc(size == 0 ? 1 : size);
+  if (ptr == nullptr) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+void *operator new[](std::size_t size) { return operator new(size); }
+
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+
+void operator delete[](void *ptr) noexcept { std::free(ptr); }
+
+void operator delete(void *ptr, std::size_t) noexcept { std::free(ptr); }
+
+void operator delete[](void *ptr, std::size_t) noexcept { std::free(ptr); }
+
+namespace
+{
+vpMatrix generateRandomMatrix(unsigned int rows, unsigned int cols, vpUniRand &rng)
+{
+  vpMatrix M(rows, cols);
+  for (unsigned int i = 0; i < M.getRows(); ++i) {
+    for (unsigned int j = 0; j < M.getCols(); ++j) {
+      M[i][j] = rng.uniform(-1., 1.);
+    }
+  }
+  return M;
+}
+
+// Pseudo inverse of a full rank matrix computed from the normal equations
+vpMatrix naivePseudoInverse(const vpMatrix &A)
+{
+  if (A.getRows() >= A.getCols()) {
+    return (A.AtA()).inverseByLU() * A.t();
+  }
+  return A.t() * (A * A.t()).inverseByLU();
+}
+
+bool equal(const vpMatrix &A, const vpMatrix &B, double epsilon)
+{
+  if ((A.getRows() != B.getRows()) || (A.getCols() != B.getCols())) {
+    return false;
+  }
+  for (unsigned int i = 0; i < A.size(); ++i) {
+    if (std::fabs(A.data[i] - B.data[i]) > epsilon) {
+      return false;
+    }
+  }
+  return true;
+}
+} // anonymous namespace
+
+TEST_CASE("Pseudo inverse results", "[pseudo_inverse]")
+{
+  vpUniRand rng(42);
+  // Alternate sizes to check that reused buffers are correctly resized
+  const unsigned int sizes[][2] = { {40, 6}, {6, 40}, {8, 6}, {6, 6}, {40, 6}, {3, 7} };
+  for (size_t n = 0; n < sizeof(sizes) / sizeof(sizes[0]); ++n) {
+    vpMatrix A = generateRandomMatrix(sizes[n][0], sizes[n][1], rng);
+    vpMatrix Ap_ref = naivePseudoInverse(A);
+
+    vpMatrix Ap;
+    CHECK(A.pseudoInverseLapack(Ap) == std::min<unsigned int>(A.getRows(), A.getCols()));
+    CHECK(equal(Ap, Ap_ref, 1e-9));
+    CHECK(equal(A.pseudoInverseLapack(), Ap_ref, 1e-9));
+
+    vpColVector sv;
+    vpMatrix imA, imAt, kerAt;
+    A.pseudoInverseLapack(Ap, sv, 1e-6, imA, imAt, kerAt);
+    CHECK(equal(Ap, Ap_ref, 1e-9));
+
+    vpMatrix U = A, V;
+    vpColVector w;
+    U.svdLapack(w, V);
+    vpMatrix S;
+    S.diag(w);
+    CHECK(equal(U * S * V.t(), A, 1e-9));
+  }
+}
+
+TEST_CASE("Pseudo inverse memory reuse", "[pseudo_inverse]")
+{
+  vpUniRand rng(42);
+  // Typical interaction matrix size in a virtual visual servoing loop
+  const vpMatrix L = generateRandomMatrix(80, 6, rng);
+  const unsigned int nbIterations = 10;
+
+#if defined(__GLIBC__)
+  SECTION("vpArray2D allocations are counted")
+  {
+    size_t nbAllocationsBefore = nbAllocations;
+    vpMatrix M(3, 3);
+    CHECK(nbAllocations > nbAllocationsBefore);
+    nbAllocationsBefore = nbAllocations;
+    M.resize(4, 3);
+    CHECK(nbAllocations > nbAllocationsBefore);
+  }
+#endif
+
+  SECTION("Pseudo inverse")
+  {
+    vpMatrix Lp;
+    L.pseudoInverseLapack(Lp);
+    const double *data = Lp.data;
+
+    size_t nbAllocationsBefore = nbAllocations;
+    for (unsigned int iter = 0; iter < nbIterations; ++iter) {
+      L.pseudoInverseLapack(Lp);
+    }
+    CHECK(nbAllocations == nbAllocationsBefore);
+    CHECK(Lp.data == data);
+  }
+
+  SECTION("SVD")
+  {
+    vpMatrix U = L, V;
+    vpColVector w;
+    U.svdLapack(w, V);
+
+    size_t nbAllocationsBefore = nbAllocations;
+    for (unsigned int iter = 0; iter < nbIterations; ++iter) {
+      U = L;
+      U.svdLapack(w, V);
+    }
+    CHECK(nbAllocations == nbAllocationsBefore);
+  }
+
+  if (runBenchmark) {
+    vpMatrix Lp;
+    BENCHMARK("Benchmark pseudo inverse from normal equations")
+    {
+      Lp = naivePseudoInverse(L);
+      return Lp;
+    };
+
+    BENCHMARK("Benchmark ViSP pseudo inverse")
+    {
+      L.pseudoInverseLapack(Lp);
+      return Lp;
+    };
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session;
+
+  auto cli = session.cli()         // Get Catch's composite command line parser
+    | Catch::Clara::Opt(runBenchmark)   // bind variable to a new option, with a hint string
+    ["--benchmark"] // the option names it will respond to
+    ("run benchmark comparing naive code with ViSP implementation"); // description string for the help output
+
+  // Now pass the new composite back to Catch so it uses that
+  session.cli(cli);
+  session.applyCommandLine(argc, argv);
+  int numFailed = session.run();
+  return numFailed;
+}
+#else
+int main() { return EXIT_SUCCESS; }
+#endif
@@ -1075,10 +1075,34 @@ public:
   {
     m_algoParams.m_recordVotingPoints = record;
   }
+
+  /*!
+   * \brief Set the number of threads used by the center and radius voting steps.
+   * Each thread votes for the centers in its own accumulator, the accumulators being summed at the end,
+   * and the radii of the center candidates are voted in parallel.
+   * Since the floating point center votes are summed in an order that depends on the number of threads,
+   * the detected circles may slightly differ from one number of threads to another.
+   *
+   * \param[in] nbThreads Number of threads used with OpenMP, 0 to use the OpenMP default.
+   */
+  inline void setNbThreads(const unsigned int &nbThreads)
+  {
+    m_nbThreads = nbThreads;
+  }
   //@}
 
   /** @name  Getters */
   //@{
+  /**
+   * \brief Get the number of threads used by the voting steps, 0 meaning the OpenMP default.
+   *
+   * \return unsigned int The number of threads.
+   */
+  inline unsigned int getNbThreads() const
+  {
+    return m_nbThreads;
+  }
+
   /**
    * \brief Get the list of Center Candidates, stored as pair <idRow, idCol>
    *
@@ -1362,6 +1386,7 @@ protected:
 
   // // Gradient computation attributes
   const vpImage<bool> *mp_mask; /*!< Mask that permits to avoid to compute gradients on some regions of the image.*/
+  unsigned int m_nbThreads; /*!< Number of threads used by the voting steps, 0 to use the OpenMP default.*/
   vpArray2D<float> m_gradientFilterX; /*!< Contains the coefficients of the gradient kernel along the X-axis*/
   vpArray2D<float> m_gradientFilterY; /*!< Contains the coefficients of the gradient kernel along the Y-axis*/
   vpImage<float> m_dIx; /*!< Gradient along the x-axis of the input image.*/
@@ -43,6 +43,8 @@
 #include <visp3/core/vpConfig.h>
 #include <visp3/core/vpImage.h>
 #include <visp3/core/vpImageMorphology.h>
+#include <visp3/core/vpImagePoint.h>
+#include <visp3/core/vpRect.h>
 #include <visp3/imgproc/vpContours.h>
 
 namespace VISP_NAMESPACE_NAME
@@ -258,9 +260,12 @@ VISP_EXPORT void adjust(const VISP_NAMESPACE_ADDRESSING vpImage<VISP_NAMESPACE_A
  * transfer function for each pixel independently but for a grid of adjacent
  * boxes of the given block size only and interpolates for locations in
  * between.
+ * \param nThreads : Number of threads used with OpenMP, 0 to use the OpenMP default.
+ * The transfer functions of the blocks and the interpolated rows are computed in parallel
+ * in the fast version, horizontal bands of the image in the accurate one.
  */
 VISP_EXPORT void clahe(const VISP_NAMESPACE_ADDRESSING vpImage<unsigned char> &I1, VISP_NAMESPACE_ADDRESSING vpImage<unsigned char> &I2, int blockRadius = 150,
-                       int bins = 256, float slope = 3.0f, bool fast = true);
+                       int bins = 256, float slope = 3.0f, bool fast = true, unsigned int nThreads = 0);
 
 /*!
  * \ingroup group_imgproc_brightness
@@ -288,9 +293,10 @@ VISP_EXPORT void clahe(const VISP_NAMESPACE_ADDRESSING vpImage<unsigned char> &I
  * transfer function for each pixel independently but for a grid of adjacent
  * boxes of the given block size only and interpolates for locations in
  * between.
+ * \param nThreads : Number of threads used with OpenMP, 0 to use the OpenMP default.
 */
 VISP_EXPORT void clahe(const VISP_NAMESPACE_ADDRESSING vpImage<VISP_NAMESPACE_ADDRESSING vpRGBa> &I1, VISP_NAMESPACE_ADDRESSING vpImage<VISP_NAMESPACE_ADDRESSING vpRGBa> &I2, int blockRadius = 150, int bins = 256,
-                       float slope = 3.0f, bool fast = true);
+                       float slope = 3.0f, bool fast = true, unsigned int nThreads = 0);
 
 /*!
  * \ingroup group_imgproc_histogram
@@ -439,10 +445,12 @@ VISP_EXPORT void gammaCorrection(const VISP_NAMESPACE_ADDRESSING vpImage<VISP_NA
  * \param dynamic : Adjusts the color of the result. Large values produce less
  * saturated images.
  * \param kernelSize : Kernel size for the gaussian blur
- * operation. If -1, the kernel size is calculated from the image size.
+ * operation. If -1, the gaussian blur is computed with a recursive filter whose cost
+ * does not depend on the scale.
+ * \param nThreads : Number of threads used with OpenMP, 0 to use the OpenMP default.
  */
 VISP_EXPORT void retinex(VISP_NAMESPACE_ADDRESSING vpImage<VISP_NAMESPACE_ADDRESSING vpRGBa> &I, int scale = 240, int scaleDiv = 3, int level = RETINEX_UNIFORM,
-                         double dynamic = 1.2, int kernelSize = -1);
+                         double dynamic = 1.2, int kernelSize = -1, unsigned int nThreads = 0);
 
 /*!
  * \ingroup group_imgproc_retinex
@@ -464,10 +472,12 @@ VISP_EXPORT void retinex(VISP_NAMESPACE_ADDRESSING vpImage<VISP_NAMESPACE_ADDRES
  * \param dynamic : Adjusts the color of the result. Large values produce less
  * saturated images.
  * \param kernelSize : Kernel size for the gaussian blur
- * operation. If -1, the kernel size is calculated from the image size.
+ * operation. If -1, the gaussian blur is computed with a recursive filter whose cost
+ * does not depend on the scale.
+ * \param nThreads : Number of threads used with OpenMP, 0 to use the OpenMP default.
  */
 VISP_EXPORT void retinex(const VISP_NAMESPACE_ADDRESSING vpImage<VISP_NAMESPACE_ADDRESSING vpRGBa> &I1, VISP_NAMESPACE_ADDRESSING vpImage<VISP_NAMESPACE_ADDRESSING vpRGBa> &I2, int scale = 240, int scaleDiv = 3,
-                         int level = RETINEX_UNIFORM, double dynamic = 1.2, int kernelSize = -1);
+                         int level = RETINEX_UNIFORM, double dynamic = 1.2, int kernelSize = -1, unsigned int nThreads = 0);
 
 /*!
  * \ingroup group_imgproc_contrast
@@ -575,17 +585,49 @@ VISP_EXPORT void unsharpMask(VISP_NAMESPACE_ADDRESSING vpImage<VISP_NAMESPACE_AD
  */
 VISP_EXPORT void unsharpMask(const VISP_NAMESPACE_ADDRESSING vpImage<VISP_NAMESPACE_ADDRESSING vpRGBa> &I, VISP_NAMESPACE_ADDRESSING vpImage<VISP_NAMESPACE_ADDRESSING vpRGBa> &Ires, float sigma, double weight = 0.6);
 
+/*!
+ * \ingroup group_imgproc_connected_components
+ *
+ * Statistics of a connected component computed by connectedComponents().
+ */
+struct VISP_EXPORT vpConnectedComponentStats
+{
+  unsigned int area; //!< Number of pixels of the component.
+  VISP_NAMESPACE_ADDRESSING vpRect bbox; //!< Bounding box of the component.
+  VISP_NAMESPACE_ADDRESSING vpImagePoint cog; //!< Centroid of the component.
+};
+
 /*!
  * \ingroup group_imgproc_connected_components
  *
  * Perform connected components detection.
  *
+ * Neighboring pixels with the same non null value belong to the same component. Labels are numbered from 1 in the
+ * raster order of the first pixel of each component. The image is labelled by horizontal strips in parallel when
+ * OpenMP is available, using a two-pass union-find algorithm.
+ *
+ * \param I : Input image (0 means background).
+ * \param labels : Label image that contain for each position the component label.
+ * \param nbComponents : Number of connected components.
+ * \param connexity : Type of connexity.
+ */
+VISP_EXPORT void connectedComponents(const VISP_NAMESPACE_ADDRESSING vpImage<unsigned char> &I, VISP_NAMESPACE_ADDRESSING vpImage<int> &labels, int &nbComponents,
+                                     const VISP_NAMESPACE_ADDRESSING vpImageMorphology::vpConnexityType &connexity = VISP_NAMESPACE_ADDRESSING vpImageMorphology::CONNEXITY_4);
+
+/*!
+ * \ingroup group_imgproc_connected_components
+ *
+ * Perform connected components detection and compute the area, the bounding box and the centroid of each component
+ * while labelling.
+ *
  * \param I : Input image (0 means background).
  * \param labels : Label image that contain for each position the component label.
  * \param nbComponents : Number of connected components.
+ * \param stats : Statistics of each component, \e stats[k] corresponding to label \e k+1.
  * \param connexity : Type of connexity.
  */
 VISP_EXPORT void connectedComponents(const VISP_NAMESPACE_ADDRESSING vpImage<unsigned char> &I, VISP_NAMESPACE_ADDRESSING vpImage<int> &labels, int &nbComponents,
+                                     std::vector<vpConnectedComponentStats> &stats,
                                      const VISP_NAMESPACE_ADDRESSING vpImageMorphology::vpConnexityType &connexity = VISP_NAMESPACE_ADDRESSING vpImageMorphology::CONNEXITY_4);
 
 /*!
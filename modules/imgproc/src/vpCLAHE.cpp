@@ -79,6 +79,10 @@
 #include <visp3/core/vpImageConvert.h>
 #include <visp3/imgproc/vpImgproc.h>
 
+#if defined(VISP_HAVE_OPENMP)
+#include <omp.h>
+#endif
+
 namespace VISP_NAMESPACE_NAME
 {
 
@@ -116,57 +120,6 @@ void clipHistogram(const std::vector<int> &hist, std::vector<int> &clippedHist,
   } while (clippedEntries != clippedEntriesBefore);
 }
 
-void createHistogram(int blockRadius, int bins, int blockXCenter, int blockYCenter, const vpImage<unsigned char> &I,
-                     std::vector<int> &hist)
-{
-  std::fill(hist.begin(), hist.end(), 0);
-
-  int xMin = std::max<int>(0, blockXCenter - blockRadius);
-  int yMin = std::max<int>(0, blockYCenter - blockRadius);
-  int xMax = std::min<int>(static_cast<int>(I.getWidth()), blockXCenter + blockRadius + 1);
-  int yMax = std::min<int>(static_cast<int>(I.getHeight()), blockYCenter + blockRadius + 1);
-
-  for (int y = yMin; y < yMax; ++y) {
-    for (int x = xMin; x < xMax; ++x) {
-      ++hist[fastRound((I[y][x] / 255.0f) * bins)];
-    }
-  }
-}
-
-std::vector<float> createTransfer(const std::vector<int> &hist, int limit, std::vector<int> &cdfs)
-{
-  clipHistogram(hist, cdfs, limit);
-  int hMin = static_cast<int>(hist.size()) - 1;
-
-  int stopIdx = hMin;
-  bool hasNotFoundFirstNotZero = true;
-  int i = 0;
-  while ((i < stopIdx) && hasNotFoundFirstNotZero) {
-    if (cdfs[i] != 0) {
-      hMin = i;
-      hasNotFoundFirstNotZero = false;
-    }
-    ++i;
-  }
-  int cdf = 0;
-  int hist_size = static_cast<int>(hist.size());
-  for (int i = hMin; i < hist_size; ++i) {
-    cdf += cdfs[i];
-    cdfs[i] = cdf;
-  }
-
-  int cdfMin = cdfs[hMin];
-  int cdfMax = cdfs[hist.size() - 1];
-
-  std::vector<float> transfer(hist.size());
-  int transfer_size = static_cast<int>(transfer.size());
-  for (int i = 0; i < transfer_size; ++i) {
-    transfer[i] = (cdfs[i] - cdfMin) / static_cast<float>(cdfMax - cdfMin);
-  }
-
-  return transfer;
-}
-
 float transferValue(int v, std::vector<int> &clippedHist)
 {
   int clippedHistLength = static_cast<int>(clippedHist.size());
@@ -226,192 +179,305 @@ bool checkClaheInputs(const int &blockRadius, const int &bins, const unsigned in
   return true;
 }
 
-void clahe(const vpImage<unsigned char> &I1, vpImage<unsigned char> &I2, int blockRadius, int bins, float slope, bool fast)
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace
 {
-  if (!checkClaheInputs(blockRadius, bins, I1.getWidth(), I1.getHeight())) { return; }
+/*!
+ * Minimal number of rows of a band processed by a thread in the accurate version.
+ */
+const int minBandRows = 16;
 
-  I2.resize(I1.getHeight(), I1.getWidth());
-  if (fast) {
-    const int val_2 = 2;
-    int blockSize = (val_2 * blockRadius) + 1;
-    int limit = static_cast<int>(((slope * blockSize * blockSize) / bins) + 0.5);
-    /* div */
-    int nc = I1.getWidth() / blockSize;
-    int nr = I1.getHeight() / blockSize;
-    /* % */
-    int cm = I1.getWidth() - (nc * blockSize);
-    std::vector<int> cs;
-    switch (cm) {
-    case 0:
-      cs.resize(nc);
-      for (int i = 0; i < nc; ++i) {
-        cs[i] = (i * blockSize) + blockRadius + 1;
-      }
-      break;
-    case 1:
-      cs.resize(nc + 1);
-      for (int i = 0; i < nc; ++i) {
-        cs[i] = (i * blockSize) + blockRadius + 1;
-      }
-      cs[nc] = I1.getWidth() - blockRadius - 1;
-      break;
-    default:
-      cs.resize(nc + val_2);
-      cs[0] = blockRadius + 1;
-      for (int i = 0; i < nc; ++i) {
-        cs[i + 1] = (i * blockSize) + blockRadius + 1 + (cm / val_2);
-      }
-      cs[nc + 1] = I1.getWidth() - blockRadius - 1;
+int getNbThreads(unsigned int nThreads)
+{
+#if defined(VISP_HAVE_OPENMP)
+  return (nThreads > 0) ? static_cast<int>(nThreads) : omp_get_max_threads();
+#else
+  (void)nThreads;
+  return 1;
+#endif
+}
+
+/*!
+ * Histogram bin of each intensity value.
+ */
+void computeBinLut(int bins, std::vector<int> &lut)
+{
+  const int nbIntensities = 256;
+  lut.resize(nbIntensities);
+  for (int i = 0; i < nbIntensities; ++i) {
+    lut[i] = fastRound((i / 255.0f) * bins);
+  }
+}
+
+/*!
+ * Centers of the blocks along one dimension of the image, on which the transfer functions are evaluated in the fast
+ * version.
+ */
+void computeBlockCenters(int size, int blockRadius, std::vector<int> &centers)
+{
+  const int val_2 = 2;
+  int blockSize = (val_2 * blockRadius) + 1;
+  /* div */
+  int n = size / blockSize;
+  /* % */
+  int m = size - (n * blockSize);
+  switch (m) {
+  case 0:
+    centers.resize(static_cast<size_t>(n));
+    for (int i = 0; i < n; ++i) {
+      centers[i] = (i * blockSize) + blockRadius + 1;
+    }
+    break;
+  case 1:
+    centers.resize(static_cast<size_t>(n + 1));
+    for (int i = 0; i < n; ++i) {
+      centers[i] = (i * blockSize) + blockRadius + 1;
     }
+    centers[n] = size - blockRadius - 1;
+    break;
+  default:
+    centers.resize(static_cast<size_t>(n + val_2));
+    centers[0] = blockRadius + 1;
+    for (int i = 0; i < n; ++i) {
+      centers[i + 1] = (i * blockSize) + blockRadius + 1 + (m / val_2);
+    }
+    centers[n + 1] = size - blockRadius - 1;
+  }
+}
 
-    int rm = I1.getHeight() - (nr * blockSize);
-    std::vector<int> rs;
-    switch (rm) {
-    case 0:
-      rs.resize(static_cast<size_t>(nr));
-      for (int i = 0; i < nr; ++i) {
-        rs[i] = (i * blockSize) + blockRadius + 1;
-      }
-      break;
-    case 1:
-      rs.resize(static_cast<size_t>(nr + 1));
-      for (int i = 0; i < nr; ++i) {
-        rs[i] = (i * blockSize) + blockRadius + 1;
-      }
-      rs[nr] = I1.getHeight() - blockRadius - 1;
-      break;
-    default:
-      rs.resize(static_cast<size_t>(nr + val_2));
-      rs[0] = blockRadius + 1;
-      for (int i = 0; i < nr; ++i) {
-        rs[i + 1] = (i * blockSize) + blockRadius + 1 + (rm / val_2);
-      }
-      rs[nr + 1] = I1.getHeight() - blockRadius - 1;
+/*!
+ * Compute the histogram of the block centered on (blockXCenter, blockYCenter), the bin of each intensity being read
+ * from a lookup table.
+ */
+void createBlockHistogram(const vpImage<unsigned char> &I, const std::vector<int> &lut, int blockRadius,
+                          int blockXCenter, int blockYCenter, std::vector<int> &hist)
+{
+  std::fill(hist.begin(), hist.end(), 0);
+
+  int xMin = std::max<int>(0, blockXCenter - blockRadius);
+  int yMin = std::max<int>(0, blockYCenter - blockRadius);
+  int xMax = std::min<int>(static_cast<int>(I.getWidth()), blockXCenter + blockRadius + 1);
+  int yMax = std::min<int>(static_cast<int>(I.getHeight()), blockYCenter + blockRadius + 1);
+
+  for (int y = yMin; y < yMax; ++y) {
+    const unsigned char *row = I[y];
+    for (int x = xMin; x < xMax; ++x) {
+      ++hist[lut[row[x]]];
     }
+  }
+}
 
-    std::vector<int> hist(static_cast<size_t>(bins + 1)), cdfs(static_cast<size_t>(bins + 1));
-    std::vector<float> tl, tr, br, bl;
-    int rs_size = static_cast<int>(rs.size());
-    for (int r = 0; r <= rs_size; ++r) {
-      int r0 = std::max<int>(0, r - 1);
-      int r1 = std::min<int>(static_cast<int>(rs.size()) - 1, r);
-      int dr = rs[r1] - rs[r0];
-      createHistogram(blockRadius, bins, cs[0], rs[r0], I1, hist);
-      tr = createTransfer(hist, limit, cdfs);
-      if (r0 == r1) {
-        br = tr;
-      }
-      else {
-        createHistogram(blockRadius, bins, cs[0], rs[r1], I1, hist);
-        br = createTransfer(hist, limit, cdfs);
-      }
+/*!
+ * Compute the transfer function of a block from its clipped and cumulated histogram, in a preallocated buffer of
+ * hist.size() elements.
+ */
+void computeTransfer(const std::vector<int> &hist, int limit, std::vector<int> &cdfs, float *transfer)
+{
+  clipHistogram(hist, cdfs, limit);
+  int hist_size = static_cast<int>(hist.size());
+  int hMin = hist_size - 1;
+  int stopIdx = hMin;
+  bool hasNotFoundFirstNotZero = true;
+  int i = 0;
+  while ((i < stopIdx) && hasNotFoundFirstNotZero) {
+    if (cdfs[i] != 0) {
+      hMin = i;
+      hasNotFoundFirstNotZero = false;
+    }
+    ++i;
+  }
 
-      int yMin = (r == 0 ? 0 : rs[r0]);
-      int yMax = (r < static_cast<int>(rs.size()) ? rs[r1] : I1.getHeight());
-      int cs_size = static_cast<int>(cs.size());
-      for (int c = 0; c <= cs_size; ++c) {
-        int c0 = std::max<int>(0, c - 1);
-        int c1 = std::min<int>(static_cast<int>(cs.size()) - 1, c);
-        int dc = cs[c1] - cs[c0];
-        tl = tr;
-        bl = br;
-        if (c0 != c1) {
-          createHistogram(blockRadius, bins, cs[c1], rs[r0], I1, hist);
-          tr = createTransfer(hist, limit, cdfs);
-          if (r0 == r1) {
-            br = tr;
-          }
-          else {
-            createHistogram(blockRadius, bins, cs[c1], rs[r1], I1, hist);
-            br = createTransfer(hist, limit, cdfs);
-          }
-        }
+  int cdf = 0;
+  for (i = hMin; i < hist_size; ++i) {
+    cdf += cdfs[i];
+    cdfs[i] = cdf;
+  }
 
-        int xMin = (c == 0 ? 0 : cs[c0]);
-        int xMax = (c < static_cast<int>(cs.size()) ? cs[c1] : I1.getWidth());
-        for (int y = yMin; y < yMax; ++y) {
-          float wy = static_cast<float>(rs[r1] - y) / dr;
-          for (int x = xMin; x < xMax; ++x) {
-            float wx = static_cast<float>(cs[c1] - x) / dc;
-            int v = fastRound((I1[y][x] / 255.0f) * bins);
-            float t00 = tl[v];
-            float t01 = tr[v];
-            float t10 = bl[v];
-            float t11 = br[v];
-            float t0 = (c0 == c1) ? t00 : ((wx * t00) + ((1.0f - wx) * t01));
-            float t1 = (c0 == c1) ? t10 : ((wx * t10) + ((1.0f - wx) * t11));
-            float t = (r0 == r1) ? t0 : ((wy * t0) + ((1.0f - wy) * t1));
-            const int maxPixelIntensity = 255;
-            I2[y][x] = std::max<unsigned char>(0, std::min<unsigned char>(maxPixelIntensity, fastRound(t * 255.0f)));
-          }
-        }
+  int cdfMin = cdfs[hMin];
+  int cdfMax = cdfs[hist_size - 1];
+  for (i = 0; i < hist_size; ++i) {
+    transfer[i] = (cdfs[i] - cdfMin) / static_cast<float>(cdfMax - cdfMin);
+  }
+}
+
+/*!
+ * Fast version: the transfer functions of all the blocks are computed once and in parallel, then each row is
+ * interpolated independently.
+ */
+void claheFast(const vpImage<unsigned char> &I1, vpImage<unsigned char> &I2, int blockRadius, int bins, float slope,
+               int nbThreads)
+{
+  const int val_2 = 2;
+  const int width = static_cast<int>(I1.getWidth());
+  const int height = static_cast<int>(I1.getHeight());
+  int blockSize = (val_2 * blockRadius) + 1;
+  int limit = static_cast<int>(((slope * blockSize * blockSize) / bins) + 0.5);
+
+  std::vector<int> cs, rs, lut;
+  computeBlockCenters(width, blockRadius, cs);
+  computeBlockCenters(height, blockRadius, rs);
+  computeBinLut(bins, lut);
+
+  const int nbCols = static_cast<int>(cs.size());
+  const int nbRows = static_cast<int>(rs.size());
+  const int nbBlocks = nbRows * nbCols;
+  const int transferSize = bins + 1;
+  std::vector<float> transfers(static_cast<size_t>(nbBlocks) * static_cast<size_t>(transferSize));
+
+#if defined(VISP_HAVE_OPENMP)
+#pragma omp parallel num_threads(nbThreads)
+#else
+  (void)nbThreads;
+#endif
+  {
+    std::vector<int> hist(static_cast<size_t>(transferSize)), cdfs(static_cast<size_t>(transferSize));
+#if defined(VISP_HAVE_OPENMP)
+#pragma omp for schedule(dynamic)
+#endif
+    for (int k = 0; k < nbBlocks; ++k) {
+      createBlockHistogram(I1, lut, blockRadius, cs[k % nbCols], rs[k / nbCols], hist);
+      computeTransfer(hist, limit, cdfs, &transfers[static_cast<size_t>(k) * transferSize]);
+    }
+  }
+
+  // Interpolation cells: cell c lies between the block centers c-1 and c, the first and last ones being bounded by
+  // the image borders.
+  std::vector<int> rowCells(static_cast<size_t>(height)), colCells(static_cast<size_t>(width));
+  std::vector<float> wxs(static_cast<size_t>(width));
+  for (int r = 0; r <= nbRows; ++r) {
+    int yMin = (r == 0 ? 0 : rs[r - 1]);
+    int yMax = (r < nbRows ? rs[r] : height);
+    for (int y = yMin; y < yMax; ++y) {
+      rowCells[y] = r;
+    }
+  }
+  for (int c = 0; c <= nbCols; ++c) {
+    int c0 = std::max<int>(0, c - 1);
+    int c1 = std::min<int>(nbCols - 1, c);
+    int dc = cs[c1] - cs[c0];
+    int xMin = (c == 0 ? 0 : cs[c0]);
+    int xMax = (c < nbCols ? cs[c1] : width);
+    for (int x = xMin; x < xMax; ++x) {
+      colCells[x] = c;
+      wxs[x] = (c0 == c1) ? 1.0f : (static_cast<float>(cs[c1] - x) / dc);
+    }
+  }
+
+#if defined(VISP_HAVE_OPENMP)
+#pragma omp parallel for schedule(static) num_threads(nbThreads)
+#endif
+  for (int y = 0; y < height; ++y) {
+    const int r = rowCells[y];
+    const int r0 = std::max<int>(0, r - 1);
+    const int r1 = std::min<int>(nbRows - 1, r);
+    const float wy = (r0 == r1) ? 1.0f : (static_cast<float>(rs[r1] - y) / (rs[r1] - rs[r0]));
+    const unsigned char *src = I1[y];
+    unsigned char *dst = I2[y];
+
+    int x = 0;
+    while (x < width) {
+      const int c = colCells[x];
+      const int c0 = std::max<int>(0, c - 1);
+      const int c1 = std::min<int>(nbCols - 1, c);
+      const float *tl = &transfers[static_cast<size_t>((r0 * nbCols) + c0) * transferSize];
+      const float *tr = &transfers[static_cast<size_t>((r0 * nbCols) + c1) * transferSize];
+      const float *bl = &transfers[static_cast<size_t>((r1 * nbCols) + c0) * transferSize];
+      const float *br = &transfers[static_cast<size_t>((r1 * nbCols) + c1) * transferSize];
+      for (; (x < width) && (colCells[x] == c); ++x) {
+        float wx = wxs[x];
+        int v = lut[src[x]];
+        float t00 = tl[v];
+        float t01 = tr[v];
+        float t10 = bl[v];
+        float t11 = br[v];
+        float t0 = (c0 == c1) ? t00 : ((wx * t00) + ((1.0f - wx) * t01));
+        float t1 = (c0 == c1) ? t10 : ((wx * t10) + ((1.0f - wx) * t11));
+        float t = (r0 == r1) ? t0 : ((wy * t0) + ((1.0f - wy) * t1));
+        const int maxPixelIntensity = 255;
+        dst[x] = std::max<unsigned char>(0, std::min<unsigned char>(maxPixelIntensity, fastRound(t * 255.0f)));
       }
     }
   }
-  else {
-    std::vector<int> hist(bins + 1), prev_hist(bins + 1), clippedHist(bins + 1);
-    bool first = true;
+}
+
+/*!
+ * Accurate version: the image is split into horizontal bands processed in parallel, the histogram of the local
+ * region being updated with a sliding window inside each band.
+ */
+void claheAccurate(const vpImage<unsigned char> &I1, vpImage<unsigned char> &I2, int blockRadius, int bins,
+                   float slope, int nbThreads)
+{
+  const int width = static_cast<int>(I1.getWidth());
+  const int height = static_cast<int>(I1.getHeight());
+  std::vector<int> lut;
+  computeBinLut(bins, lut);
+
+  const int nbBands = std::max<int>(1, std::min<int>(nbThreads, height / minBandRows));
+#if defined(VISP_HAVE_OPENMP)
+#pragma omp parallel for schedule(static, 1) num_threads(nbBands)
+#endif
+  for (int band = 0; band < nbBands; ++band) {
+    const int yStart = (band * height) / nbBands;
+    const int yEnd = ((band + 1) * height) / nbBands;
+    std::vector<int> hist(static_cast<size_t>(bins + 1)), prev_hist(static_cast<size_t>(bins + 1)),
+      clippedHist(static_cast<size_t>(bins + 1));
     int xMin0 = 0;
-    int xMax0 = std::min<int>(static_cast<int>(I1.getWidth()), blockRadius);
-    int i1_height = static_cast<int>(I1.getHeight());
-    for (int y = 0; y < i1_height; ++y) {
-      int yMin = std::max<int>(0, y - static_cast<int>(blockRadius));
-      int yMax = std::min<int>(static_cast<int>(I1.getHeight()), y + blockRadius + 1);
+    int xMax0 = std::min<int>(width, blockRadius);
+
+    for (int y = yStart; y < yEnd; ++y) {
+      int yMin = std::max<int>(0, y - blockRadius);
+      int yMax = std::min<int>(height, y + blockRadius + 1);
       int h = yMax - yMin;
 
-      if (first) {
-        first = false;
-        // Compute histogram for the block at (0,0)
+      if (y == yStart) {
+        // Compute histogram for the block at (0,y)
         for (int yi = yMin; yi < yMax; ++yi) {
           for (int xi = xMin0; xi < xMax0; ++xi) {
-            ++hist[fastRound((I1[yi][xi] / 255.0f) * bins)];
+            ++prev_hist[lut[I1[yi][xi]]];
           }
         }
       }
       else {
-        hist = prev_hist;
-
         if (yMin > 0) {
           int yMin1 = yMin - 1;
           // Sliding histogram, remove top
           for (int xi = xMin0; xi < xMax0; ++xi) {
-            --hist[fastRound((I1[yMin1][xi] / 255.0f) * bins)];
+            --prev_hist[lut[I1[yMin1][xi]]];
           }
         }
 
-        if ((y + blockRadius) < static_cast<int>(I1.getHeight())) {
+        if ((y + blockRadius) < height) {
           int yMax1 = yMax - 1;
           // Sliding histogram, add bottom
           for (int xi = xMin0; xi < xMax0; ++xi) {
-            ++hist[fastRound((I1[yMax1][xi] / 255.0f) * bins)];
+            ++prev_hist[lut[I1[yMax1][xi]]];
           }
         }
       }
-      prev_hist = hist;
+      hist = prev_hist;
 
-      int i1_width = static_cast<int>(I1.getWidth());
-      for (int x = 0; x < i1_width; ++x) {
-        int xMin = std::max<int>(0, x - static_cast<int>(blockRadius));
+      for (int x = 0; x < width; ++x) {
+        int xMin = std::max<int>(0, x - blockRadius);
         int xMax = x + blockRadius + 1;
 
         if (xMin > 0) {
           int xMin1 = xMin - 1;
           // Sliding histogram, remove left
           for (int yi = yMin; yi < yMax; ++yi) {
-            --hist[fastRound((I1[yi][xMin1] / 255.0f) * bins)];
+            --hist[lut[I1[yi][xMin1]]];
           }
         }
 
-        if (xMax <= static_cast<int>(I1.getWidth())) {
+        if (xMax <= width) {
           int xMax1 = xMax - 1;
           // Sliding histogram, add right
           for (int yi = yMin; yi < yMax; ++yi) {
-            ++hist[fastRound((I1[yi][xMax1] / 255.0f) * bins)];
+            ++hist[lut[I1[yi][xMax1]]];
           }
         }
 
-        int v = fastRound((I1[y][x] / 255.0f) * bins);
-        int w = std::min<int>(static_cast<int>(I1.getWidth()), xMax) - xMin;
+        int v = lut[I1[y][x]];
+        int w = std::min<int>(width, xMax) - xMin;
         int n = h * w;
         int limit = static_cast<int>(((slope * n) / bins) + 0.5f);
         I2[y][x] = fastRound(transferValue(v, hist, clippedHist, limit) * 255.0f);
@@ -419,8 +485,25 @@ void clahe(const vpImage<unsigned char> &I1, vpImage<unsigned char> &I2, int blo
     }
   }
 }
+} // namespace
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+void clahe(const vpImage<unsigned char> &I1, vpImage<unsigned char> &I2, int blockRadius, int bins, float slope, bool fast,
+           unsigned int nThreads)
+{
+  if (!checkClaheInputs(blockRadius, bins, I1.getWidth(), I1.getHeight())) { return; }
+
+  I2.resize(I1.getHeight(), I1.getWidth());
+  if (fast) {
+    claheFast(I1, I2, blockRadius, bins, slope, getNbThreads(nThreads));
+  }
+  else {
+    claheAccurate(I1, I2, blockRadius, bins, slope, getNbThreads(nThreads));
+  }
+}
 
-void clahe(const vpImage<vpRGBa> &I1, vpImage<vpRGBa> &I2, int blockRadius, int bins, float slope, bool fast)
+void clahe(const vpImage<vpRGBa> &I1, vpImage<vpRGBa> &I2, int blockRadius, int bins, float slope, bool fast,
+           unsigned int nThreads)
 {
   // Split
   vpImage<unsigned char> pR(I1.getHeight(), I1.getWidth());
@@ -432,9 +515,9 @@ void clahe(const vpImage<vpRGBa> &I1, vpImage<vpRGBa> &I2, int blockRadius, int
 
   // Apply CLAHE independently on RGB channels
   vpImage<unsigned char> resR, resG, resB;
-  clahe(pR, resR, blockRadius, bins, slope, fast);
-  clahe(pG, resG, blockRadius, bins, slope, fast);
-  clahe(pB, resB, blockRadius, bins, slope, fast);
+  clahe(pR, resR, blockRadius, bins, slope, fast, nThreads);
+  clahe(pG, resG, blockRadius, bins, slope, fast, nThreads);
+  clahe(pB, resB, blockRadius, bins, slope, fast, nThreads);
 
   const unsigned int sizeRGBa = 4;
   I2.resize(I1.getHeight(), I1.getWidth());
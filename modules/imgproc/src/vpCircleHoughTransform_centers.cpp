@@ -33,11 +33,20 @@
 
 #include <visp3/imgproc/vpCircleHoughTransform.h>
 
+#if defined(VISP_HAVE_OPENMP)
+#include <omp.h>
+#endif
+
 BEGIN_VISP_NAMESPACE
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 namespace
 {
+/**
+ * \brief Minimal number of edge points voting in a center accumulator of their own.
+ */
+const int minEdgePointsPerAccumulator = 1024;
+
   /**
  * \brief Data required to update the center candidates accumulator along the
  * gradient direction.
@@ -378,37 +387,81 @@ vpCircleHoughTransform::computeCenterCandidates()
     throw(vpException(vpException::dimensionError, "[vpCircleHoughTransform::computeCenterCandidates] Accumulator height <= 0!"));
   }
 
-  vpImage<float> centersAccum(accumulatorHeight, accumulatorWidth + 1, 0.); /*!< Votes for the center candidates.*/
-
+  // Compact list of the edge points having a non-null gradient, extracted once from the edge map
+  // and reused by the radius voting step
   for (unsigned int r = 0; r < nbRows; ++r) {
     for (unsigned int c = 0; c < nbCols; ++c) {
       if (m_edgeMap[r][c] == vpCircleHoughTransform::edgeMapOn) {
-        // Voting for points in both direction of the gradient
-        // Step from min_radius to max_radius in both directions of the gradient
         float mag = std::sqrt((m_dIx[r][c] * m_dIx[r][c]) + (m_dIy[r][c] * m_dIy[r][c]));
-
-        float sx = 0.f, sy = 0.f;
         if (std::abs(mag) >= std::numeric_limits<float>::epsilon()) {
-          sx = m_dIx[r][c] / mag;
-          sy = m_dIy[r][c] / mag;
-
-                  // Saving the edge point for further use
           m_edgePointsList.push_back(std::pair<unsigned int, unsigned int>(r, c));
+        }
+      }
+    }
+  }
+
+  vpDataForAccumLoop data;
+  data.r = 0;
+  data.c = 0;
+  data.accumulatorHeight = accumulatorHeight;
+  data.accumulatorWidth = accumulatorWidth;
+  data.maximumXpositionFloat = maximumXpositionFloat;
+  data.maximumYpositionFloat = maximumYpositionFloat;
+  data.maxRadius = m_algoParams.m_maxRadius;
+  data.minimumXpositionFloat = minimumXpositionFloat;
+  data.minimumYpositionFloat = minimumYpositionFloat;
+  data.minRadius = m_algoParams.m_minRadius;
+  data.offsetX = offsetX;
+  data.offsetY = offsetY;
+
+  // Each thread votes in its own accumulator for a contiguous range of edge points, the accumulators being summed
+  // afterwards. The number of accumulators is limited so that each of them gathers enough votes.
+  const int nbEdgePoints = static_cast<int>(m_edgePointsList.size());
+#if defined(VISP_HAVE_OPENMP)
+  const int nbThreads = (m_nbThreads > 0) ? static_cast<int>(m_nbThreads) : omp_get_max_threads();
+#else
+  const int nbThreads = 1;
+#endif
+  const int nbAccumulators = std::max<int>(1, std::min<int>(nbThreads, nbEdgePoints / minEdgePointsPerAccumulator));
+  vpImage<float> centersAccum(accumulatorHeight, accumulatorWidth + 1, 0.); /*!< Votes for the center candidates.*/
+  std::vector<vpImage<float> > threadAccums(static_cast<size_t>(nbAccumulators - 1));
 
-          vpDataForAccumLoop data;
-          data.accumulatorHeight = accumulatorHeight;
-          data.accumulatorWidth = accumulatorWidth;
-          data.c = c;
-          data.maximumXpositionFloat = maximumXpositionFloat;
-          data.maximumYpositionFloat = maximumYpositionFloat;
-          data.maxRadius = m_algoParams.m_maxRadius;
-          data.minimumXpositionFloat = minimumXpositionFloat;
-          data.minimumYpositionFloat = minimumYpositionFloat;
-          data.minRadius = m_algoParams.m_minRadius;
-          data.offsetX = offsetX;
-          data.offsetY = offsetY;
-          data.r = r;
-          updateAccumAlongGradientDir(data, sx, sy, centersAccum);
+#if defined(VISP_HAVE_OPENMP)
+#pragma omp parallel for schedule(static, 1) num_threads(nbAccumulators)
+#endif
+  for (int t = 0; t < nbAccumulators; ++t) {
+    vpImage<float> &accum = (t == 0) ? centersAccum : threadAccums[static_cast<size_t>(t - 1)];
+    if (t > 0) {
+      accum.resize(accumulatorHeight, accumulatorWidth + 1, 0.f);
+    }
+    vpDataForAccumLoop threadData = data;
+    const int start = (t * nbEdgePoints) / nbAccumulators;
+    const int end = ((t + 1) * nbEdgePoints) / nbAccumulators;
+    for (int e = start; e < end; ++e) {
+      const unsigned int r = m_edgePointsList[static_cast<size_t>(e)].first;
+      const unsigned int c = m_edgePointsList[static_cast<size_t>(e)].second;
+      // Voting for points in both direction of the gradient
+      // Step from min_radius to max_radius in both directions of the gradient
+      float mag = std::sqrt((m_dIx[r][c] * m_dIx[r][c]) + (m_dIy[r][c] * m_dIy[r][c]));
+      float sx = m_dIx[r][c] / mag;
+      float sy = m_dIy[r][c] / mag;
+      threadData.r = r;
+      threadData.c = c;
+      updateAccumAlongGradientDir(threadData, sx, sy, accum);
+    }
+  }
+
+  if (nbAccumulators > 1) {
+    const int nbColsAccumulator = accumulatorWidth + 1;
+#if defined(VISP_HAVE_OPENMP)
+#pragma omp parallel for schedule(static) num_threads(nbThreads)
+#endif
+    for (int y = 0; y < accumulatorHeight; ++y) {
+      float *dst = centersAccum[y];
+      for (int t = 0; t < (nbAccumulators - 1); ++t) {
+        const float *src = threadAccums[static_cast<size_t>(t)][y];
+        for (int x = 0; x < nbColsAccumulator; ++x) {
+          dst[x] += src[x];
         }
       }
     }
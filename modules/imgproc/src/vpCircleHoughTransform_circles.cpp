@@ -33,6 +33,10 @@
 
 #include <visp3/imgproc/vpCircleHoughTransform.h>
 
+#if defined(VISP_HAVE_OPENMP)
+#include <omp.h>
+#endif
+
 BEGIN_VISP_NAMESPACE
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
@@ -52,10 +56,9 @@ float computeEffectiveRadius(const float &votes, const float &weigthedSumRadius)
 typedef struct vpDataUpdateRadAccum
 {
   int m_nbBins;
-  std::pair<float, float> m_centerCandidate;
   std::pair<unsigned int, unsigned int> m_edgePoint;
-  const vpImage<float> &m_dIx;
-  const vpImage<float> &m_dIy;
+  float m_gx;
+  float m_gy;
   float m_rx;
   float m_ry;
   float m_circlePerfectness2;
@@ -63,20 +66,38 @@ typedef struct vpDataUpdateRadAccum
   float m_minRadius;
   float m_mergingRadiusDiffThresh;
   bool m_recordVotingPoints;
-
-  vpDataUpdateRadAccum(const vpImage<float> &dIx, const vpImage<float> &dIy)
-    : m_dIx(dIx)
-    , m_dIy(dIy)
-  { }
 } vpDataUpdateRadAccum;
 
+/**
+ * \brief Edge points stored in flat arrays, read for each center candidate by the radius voting step.
+ */
+typedef struct vpEdgePointsArrays
+{
+  std::vector<float> m_x; /*!< Column of the edge points.*/
+  std::vector<float> m_y; /*!< Row of the edge points.*/
+  std::vector<float> m_gx; /*!< Gradient along x at the edge points.*/
+  std::vector<float> m_gy; /*!< Gradient along y at the edge points.*/
+} vpEdgePointsArrays;
+
+/**
+ * \brief Circle candidates found around a center candidate, gathered in the order of the center candidates
+ * once all of them have been processed.
+ */
+typedef struct vpCircleCandidatesOfCenter
+{
+  std::vector<vpImageCircle> m_circles;
+  std::vector<float> m_probabilities;
+  std::vector<unsigned int> m_votes;
+  std::vector<std::vector<std::pair<unsigned int, unsigned int> > > m_votingPoints;
+} vpCircleCandidatesOfCenter;
+
 void
 updateRadiusAccumulator(const vpDataUpdateRadAccum &data, std::vector<float> &radiusAccumList,
                         std::vector<float> &radiusActualValueList,
                         std::vector<std::vector<std::pair<unsigned int, unsigned int> > > &votingPoints)
 {
-  float gx = data.m_dIx[data.m_edgePoint.first][data.m_edgePoint.second];
-  float gy = data.m_dIy[data.m_edgePoint.first][data.m_edgePoint.second];
+  float gx = data.m_gx;
+  float gy = data.m_gy;
   float grad2 = (gx * gx) + (gy * gy);
   float scalProd = (data.m_rx * gx) + (data.m_ry * gy);
   float scalProd2 = scalProd * scalProd;
@@ -134,142 +155,180 @@ updateRadiusAccumulator(const vpDataUpdateRadAccum &data, std::vector<float> &ra
 void
 vpCircleHoughTransform::computeCircleCandidates()
 {
-  size_t nbCenterCandidates = m_centerCandidatesList.size();
+  int nbCenterCandidates = static_cast<int>(m_centerCandidatesList.size());
   int nbBins = static_cast<int>(((m_algoParams.m_maxRadius - m_algoParams.m_minRadius) + 1) / m_algoParams.m_mergingRadiusDiffThresh);
   nbBins = std::max<int>(static_cast<int>(1), nbBins); // Avoid having 0 bins, which causes segfault
-  std::vector<float> radiusAccumList; // Radius accumulator for each center candidates.
-  std::vector<float> radiusActualValueList; // Vector that contains the actual distance between the edge points and the center candidates.
 
   float rmin2 = m_algoParams.m_minRadius * m_algoParams.m_minRadius;
   float rmax2 = m_algoParams.m_maxRadius * m_algoParams.m_maxRadius;
   float circlePerfectness2 = m_algoParams.m_circlePerfectness * m_algoParams.m_circlePerfectness;
 
-  vpDataUpdateRadAccum data(m_dIx, m_dIy);
-  data.m_nbBins = nbBins;
-  data.m_circlePerfectness2 = circlePerfectness2;
-  data.m_minRadius = m_algoParams.m_minRadius;
-  data.m_mergingRadiusDiffThresh = m_algoParams.m_mergingRadiusDiffThresh;
-  data.m_recordVotingPoints = m_algoParams.m_recordVotingPoints;
+  // Position and gradient of the edge points, gathered once for all the center candidates
+  const unsigned int nbEdgePoints = static_cast<unsigned int>(m_edgePointsList.size());
+  vpEdgePointsArrays edgePoints;
+  edgePoints.m_x.resize(nbEdgePoints);
+  edgePoints.m_y.resize(nbEdgePoints);
+  edgePoints.m_gx.resize(nbEdgePoints);
+  edgePoints.m_gy.resize(nbEdgePoints);
+  for (unsigned int e = 0; e < nbEdgePoints; ++e) {
+    const std::pair<unsigned int, unsigned int> &edgePoint = m_edgePointsList[e];
+    edgePoints.m_x[e] = static_cast<float>(edgePoint.second);
+    edgePoints.m_y[e] = static_cast<float>(edgePoint.first);
+    edgePoints.m_gx[e] = m_dIx[edgePoint.first][edgePoint.second];
+    edgePoints.m_gy[e] = m_dIy[edgePoint.first][edgePoint.second];
+  }
+
+#if defined(VISP_HAVE_OPENMP)
+  const int nbThreads = (m_nbThreads > 0) ? static_cast<int>(m_nbThreads) : omp_get_max_threads();
+#endif
+
+  // The center candidates are processed in parallel, each thread using its own radius accumulators
+  std::vector<vpCircleCandidatesOfCenter> candidatesOfCenters(static_cast<size_t>(nbCenterCandidates));
+#if defined(VISP_HAVE_OPENMP)
+#pragma omp parallel num_threads(nbThreads)
+#endif
+  {
+    std::vector<float> radiusAccumList(static_cast<size_t>(nbBins)); // Radius accumulator for each center candidates.
+    std::vector<float> radiusActualValueList(static_cast<size_t>(nbBins)); // Vector that contains the actual distance between the edge points and the center candidates.
 
-  for (size_t i = 0; i < nbCenterCandidates; ++i) {
-    std::vector<std::vector<std::pair<unsigned int, unsigned int> > > votingPoints(nbBins); // Vectors that contain the points voting for each radius bin
-    std::pair<float, float> centerCandidate = m_centerCandidatesList[i];
-    // Initialize the radius accumulator of the candidate with 0s
-    radiusAccumList.clear();
-    radiusAccumList.resize(nbBins, 0);
-    radiusActualValueList.clear();
-    radiusActualValueList.resize(nbBins, 0.);
+    vpDataUpdateRadAccum data;
+    data.m_nbBins = nbBins;
+    data.m_circlePerfectness2 = circlePerfectness2;
+    data.m_minRadius = m_algoParams.m_minRadius;
+    data.m_mergingRadiusDiffThresh = m_algoParams.m_mergingRadiusDiffThresh;
+    data.m_recordVotingPoints = m_algoParams.m_recordVotingPoints;
 
-    const unsigned int nbEdgePoints = static_cast<unsigned int>(m_edgePointsList.size());
-    for (unsigned int e = 0; e < nbEdgePoints; ++e) {
-      const std::pair<unsigned int, unsigned int> &edgePoint = m_edgePointsList[e];
+#if defined(VISP_HAVE_OPENMP)
+#pragma omp for schedule(dynamic)
+#endif
+    for (int i = 0; i < nbCenterCandidates; ++i) {
+      std::vector<std::vector<std::pair<unsigned int, unsigned int> > > votingPoints(nbBins); // Vectors that contain the points voting for each radius bin
+      std::pair<float, float> centerCandidate = m_centerCandidatesList[i];
+      vpCircleCandidatesOfCenter &candidatesOfCenter = candidatesOfCenters[static_cast<size_t>(i)];
+      // Initialize the radius accumulator of the candidate with 0s
+      std::fill(radiusAccumList.begin(), radiusAccumList.end(), 0.f);
+      std::fill(radiusActualValueList.begin(), radiusActualValueList.end(), 0.f);
 
-      // For each center candidate CeC_i, compute the distance with each edge point EP_j d_ij = dist(CeC_i; EP_j)
-      float rx = edgePoint.second - centerCandidate.second;
-      float ry = edgePoint.first - centerCandidate.first;
-      float r2 = (rx * rx) + (ry * ry);
-      if ((r2 > rmin2) && (r2 < rmax2)) {
-        data.m_centerCandidate = centerCandidate;
-        data.m_edgePoint = edgePoint;
-        data.m_rx = rx;
-        data.m_ry = ry;
-        data.m_r2 = r2;
-        updateRadiusAccumulator(data, radiusAccumList, radiusActualValueList, votingPoints);
+      for (unsigned int e = 0; e < nbEdgePoints; ++e) {
+        // For each center candidate CeC_i, compute the distance with each edge point EP_j d_ij = dist(CeC_i; EP_j)
+        float rx = edgePoints.m_x[e] - centerCandidate.second;
+        float ry = edgePoints.m_y[e] - centerCandidate.first;
+        float r2 = (rx * rx) + (ry * ry);
+        if ((r2 > rmin2) && (r2 < rmax2)) {
+          data.m_edgePoint = m_edgePointsList[e];
+          data.m_gx = edgePoints.m_gx[e];
+          data.m_gy = edgePoints.m_gy[e];
+          data.m_rx = rx;
+          data.m_ry = ry;
+          data.m_r2 = r2;
+          updateRadiusAccumulator(data, radiusAccumList, radiusActualValueList, votingPoints);
+        }
       }
-    }
 
 #if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
-    // Lambda to compute the effective radius (i.e. barycenter) of each radius bin
-    auto computeEffectiveRadius = [](const float &votes, const float &weigthedSumRadius) {
-      float r_effective = -1.f;
-      if (votes > std::numeric_limits<float>::epsilon()) {
-        r_effective = weigthedSumRadius / votes;
-      }
-      return r_effective;
-      };
+      // Lambda to compute the effective radius (i.e. barycenter) of each radius bin
+      auto computeEffectiveRadius = [](const float &votes, const float &weigthedSumRadius) {
+        float r_effective = -1.f;
+        if (votes > std::numeric_limits<float>::epsilon()) {
+          r_effective = weigthedSumRadius / votes;
+        }
+        return r_effective;
+        };
 #endif
 
-    // Merging similar candidates
-    std::vector<float> v_r_effective; // Vector of radius of each candidate after the merge step
-    std::vector<float> v_votes_effective; // Vector of number of votes of each candidate after the merge step
-    std::vector<std::vector<std::pair<unsigned int, unsigned int> > > v_votingPoints_effective; // Vector of voting points after the merge step
-    std::vector<bool> v_hasMerged_effective; // Vector indicating if merge has been performed for the different candidates
-    for (int idBin = 0; idBin < nbBins; ++idBin) {
-      float r_effective = computeEffectiveRadius(radiusAccumList[idBin], radiusActualValueList[idBin]);
-      float votes_effective = radiusAccumList[idBin];
-      std::vector<std::pair<unsigned int, unsigned int> > votingPoints_effective = votingPoints[idBin];
-      bool is_r_effective_similar = (r_effective > 0.f);
-      // Looking for potential similar radii in the following bins
-      // If so, compute the barycenter radius between them
-      int idCandidate = idBin + 1;
-      bool hasMerged = false;
-      while ((idCandidate < nbBins) && is_r_effective_similar) {
-        float r_effective_candidate = computeEffectiveRadius(radiusAccumList[idCandidate], radiusActualValueList[idCandidate]);
-        if (std::abs(r_effective_candidate - r_effective) < m_algoParams.m_mergingRadiusDiffThresh) {
-          r_effective = ((r_effective * votes_effective) + (r_effective_candidate * radiusAccumList[idCandidate])) / (votes_effective + radiusAccumList[idCandidate]);
-          votes_effective += radiusAccumList[idCandidate];
-          radiusAccumList[idCandidate] = -.1f;
-          radiusActualValueList[idCandidate] = -1.f;
-          is_r_effective_similar = true;
-          if (m_algoParams.m_recordVotingPoints) {
-            // Move elements from votingPoints[idCandidate] to votingPoints_effective.
-            // votingPoints[idCandidate] is left in undefined but safe-to-destruct state.
+      // Merging similar candidates
+      std::vector<float> v_r_effective; // Vector of radius of each candidate after the merge step
+      std::vector<float> v_votes_effective; // Vector of number of votes of each candidate after the merge step
+      std::vector<std::vector<std::pair<unsigned int, unsigned int> > > v_votingPoints_effective; // Vector of voting points after the merge step
+      std::vector<bool> v_hasMerged_effective; // Vector indicating if merge has been performed for the different candidates
+      for (int idBin = 0; idBin < nbBins; ++idBin) {
+        float r_effective = computeEffectiveRadius(radiusAccumList[idBin], radiusActualValueList[idBin]);
+        float votes_effective = radiusAccumList[idBin];
+        std::vector<std::pair<unsigned int, unsigned int> > votingPoints_effective = votingPoints[idBin];
+        bool is_r_effective_similar = (r_effective > 0.f);
+        // Looking for potential similar radii in the following bins
+        // If so, compute the barycenter radius between them
+        int idCandidate = idBin + 1;
+        bool hasMerged = false;
+        while ((idCandidate < nbBins) && is_r_effective_similar) {
+          float r_effective_candidate = computeEffectiveRadius(radiusAccumList[idCandidate], radiusActualValueList[idCandidate]);
+          if (std::abs(r_effective_candidate - r_effective) < m_algoParams.m_mergingRadiusDiffThresh) {
+            r_effective = ((r_effective * votes_effective) + (r_effective_candidate * radiusAccumList[idCandidate])) / (votes_effective + radiusAccumList[idCandidate]);
+            votes_effective += radiusAccumList[idCandidate];
+            radiusAccumList[idCandidate] = -.1f;
+            radiusActualValueList[idCandidate] = -1.f;
+            is_r_effective_similar = true;
+            if (m_algoParams.m_recordVotingPoints) {
+              // Move elements from votingPoints[idCandidate] to votingPoints_effective.
+              // votingPoints[idCandidate] is left in undefined but safe-to-destruct state.
 #if (VISP_CXX_STANDARD > VISP_CXX_STANDARD_98)
-            votingPoints_effective.insert(
-              votingPoints_effective.end(),
-              std::make_move_iterator(votingPoints[idCandidate].begin()),
-              std::make_move_iterator(votingPoints[idCandidate].end())
-            );
+              votingPoints_effective.insert(
+                votingPoints_effective.end(),
+                std::make_move_iterator(votingPoints[idCandidate].begin()),
+                std::make_move_iterator(votingPoints[idCandidate].end())
+              );
 #else
-            votingPoints_effective.insert(
-              votingPoints_effective.end(),
-              votingPoints[idCandidate].begin(),
-              votingPoints[idCandidate].end()
-            );
+              votingPoints_effective.insert(
+                votingPoints_effective.end(),
+                votingPoints[idCandidate].begin(),
+                votingPoints[idCandidate].end()
+              );
 #endif
-            hasMerged = true;
+              hasMerged = true;
+            }
           }
+          else {
+            is_r_effective_similar = false;
+          }
+          ++idCandidate;
         }
-        else {
-          is_r_effective_similar = false;
-        }
-        ++idCandidate;
-      }
 
-      if ((votes_effective > m_algoParams.m_centerMinThresh) && (votes_effective >= (m_algoParams.m_circleVisibilityRatioThresh * 2.f * M_PI_FLOAT * r_effective))) {
-        // Only the circles having enough votes and being visible enough are considered
-        v_r_effective.push_back(r_effective);
-        v_votes_effective.push_back(votes_effective);
-        if (m_algoParams.m_recordVotingPoints) {
-          v_votingPoints_effective.push_back(votingPoints_effective);
-          v_hasMerged_effective.push_back(hasMerged);
+        if ((votes_effective > m_algoParams.m_centerMinThresh) && (votes_effective >= (m_algoParams.m_circleVisibilityRatioThresh * 2.f * M_PI_FLOAT * r_effective))) {
+          // Only the circles having enough votes and being visible enough are considered
+          v_r_effective.push_back(r_effective);
+          v_votes_effective.push_back(votes_effective);
+          if (m_algoParams.m_recordVotingPoints) {
+            v_votingPoints_effective.push_back(votingPoints_effective);
+            v_hasMerged_effective.push_back(hasMerged);
+          }
         }
       }
-    }
 
-    unsigned int nbCandidates = static_cast<unsigned int>(v_r_effective.size());
-    for (unsigned int idBin = 0; idBin < nbCandidates; ++idBin) {
-      // If the circle of center CeC_i  and radius RCB_k has enough votes, it is added to the list
-      // of Circle Candidates
-      float r_effective = v_r_effective[idBin];
-      vpImageCircle candidateCircle(vpImagePoint(centerCandidate.first, centerCandidate.second), r_effective);
-      float proba = computeCircleProbability(candidateCircle, static_cast<unsigned int>(v_votes_effective[idBin]));
-      if (proba > m_algoParams.m_circleProbaThresh) {
-        m_circleCandidates.push_back(candidateCircle);
-        m_circleCandidatesProbabilities.push_back(proba);
-        m_circleCandidatesVotes.push_back(static_cast<unsigned int>(v_votes_effective[idBin]));
-        if (m_algoParams.m_recordVotingPoints) {
-          if (v_hasMerged_effective[idBin]) {
-            // Remove potential duplicated points
-            std::sort(v_votingPoints_effective[idBin].begin(), v_votingPoints_effective[idBin].end());
-            v_votingPoints_effective[idBin].erase(std::unique(v_votingPoints_effective[idBin].begin(), v_votingPoints_effective[idBin].end()), v_votingPoints_effective[idBin].end());
+      unsigned int nbCandidates = static_cast<unsigned int>(v_r_effective.size());
+      for (unsigned int idBin = 0; idBin < nbCandidates; ++idBin) {
+        // If the circle of center CeC_i  and radius RCB_k has enough votes, it is added to the list
+        // of Circle Candidates
+        float r_effective = v_r_effective[idBin];
+        vpImageCircle candidateCircle(vpImagePoint(centerCandidate.first, centerCandidate.second), r_effective);
+        float proba = computeCircleProbability(candidateCircle, static_cast<unsigned int>(v_votes_effective[idBin]));
+        if (proba > m_algoParams.m_circleProbaThresh) {
+          candidatesOfCenter.m_circles.push_back(candidateCircle);
+          candidatesOfCenter.m_probabilities.push_back(proba);
+          candidatesOfCenter.m_votes.push_back(static_cast<unsigned int>(v_votes_effective[idBin]));
+          if (m_algoParams.m_recordVotingPoints) {
+            if (v_hasMerged_effective[idBin]) {
+              // Remove potential duplicated points
+              std::sort(v_votingPoints_effective[idBin].begin(), v_votingPoints_effective[idBin].end());
+              v_votingPoints_effective[idBin].erase(std::unique(v_votingPoints_effective[idBin].begin(), v_votingPoints_effective[idBin].end()), v_votingPoints_effective[idBin].end());
+            }
+            // Save the points
+            candidatesOfCenter.m_votingPoints.push_back(v_votingPoints_effective[idBin]);
           }
-          // Save the points
-          m_circleCandidatesVotingPoints.push_back(v_votingPoints_effective[idBin]);
         }
       }
     }
   }
+
+  // Gathering the circle candidates in the order of the center candidates
+  for (int i = 0; i < nbCenterCandidates; ++i) {
+    const vpCircleCandidatesOfCenter &candidatesOfCenter = candidatesOfCenters[static_cast<size_t>(i)];
+    m_circleCandidates.insert(m_circleCandidates.end(), candidatesOfCenter.m_circles.begin(), candidatesOfCenter.m_circles.end());
+    m_circleCandidatesProbabilities.insert(m_circleCandidatesProbabilities.end(), candidatesOfCenter.m_probabilities.begin(),
+                                           candidatesOfCenter.m_probabilities.end());
+    m_circleCandidatesVotes.insert(m_circleCandidatesVotes.end(), candidatesOfCenter.m_votes.begin(), candidatesOfCenter.m_votes.end());
+    m_circleCandidatesVotingPoints.insert(m_circleCandidatesVotingPoints.end(), candidatesOfCenter.m_votingPoints.begin(),
+                                          candidatesOfCenter.m_votingPoints.end());
+  }
 }
 
 float
@@ -63,6 +63,7 @@ scaleFilter(vpArray2D<float> &filter, const float &scale)
 vpCircleHoughTransform::vpCircleHoughTransform()
   : m_algoParams()
   , mp_mask(nullptr)
+  , m_nbThreads(0)
 {
   initGaussianFilters();
   initGradientFilters();
@@ -71,6 +72,7 @@ vpCircleHoughTransform::vpCircleHoughTransform()
 vpCircleHoughTransform::vpCircleHoughTransform(const vpCircleHoughTransformParams &algoParams)
   : m_algoParams(algoParams)
   , mp_mask(nullptr)
+  , m_nbThreads(0)
 {
   initGaussianFilters();
   initGradientFilters();
@@ -92,6 +94,7 @@ using json = nlohmann::json;
 
 vpCircleHoughTransform::vpCircleHoughTransform(const std::string &jsonPath)
   : mp_mask(nullptr)
+  , m_nbThreads(0)
 {
   initFromJSON(jsonPath);
 }
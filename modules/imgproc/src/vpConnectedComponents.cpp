@@ -33,131 +33,358 @@
 
 /*!
   \file vpConnectedComponents.cpp
-  \brief Basic connected components.
+  \brief Connected components labelling with union-find.
 */
 
-#include <queue>
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
 #include <visp3/imgproc/vpImgproc.h>
 
+#if defined(VISP_HAVE_OPENMP)
+#include <omp.h>
+#endif
+
 namespace VISP_NAMESPACE_NAME
 {
-
-void getNeighbors(const vpImage<unsigned char> &I, std::queue<vpImagePoint> &listOfNeighbors, unsigned int i,
-                  unsigned int j, const vpImageMorphology::vpConnexityType &connexity)
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace
 {
-  unsigned char currValue = I[i][j];
+/*!
+ * Minimal number of rows of a strip labelled by a thread.
+ */
+const unsigned int minStripRows = 32;
 
-  if (connexity == vpImageMorphology::CONNEXITY_4) {
-    // Top
-    if (I[i - 1][j] == currValue) {
-      listOfNeighbors.push(vpImagePoint(i - 1, j));
-    }
+/*!
+ * Root of a provisional label. A parent always has a lower label than its children, the root being the label of the
+ * first pixel in raster order of the component.
+ */
+inline int findRoot(std::vector<int> &parent, int label)
+{
+  while (parent[label] < label) {
+    parent[label] = parent[parent[label]];
+    label = parent[label];
+  }
+  return label;
+}
 
-    // Left
-    if (I[i][j - 1] == currValue) {
-      listOfNeighbors.push(vpImagePoint(i, j - 1));
-    }
+inline int merge(std::vector<int> &parent, int label1, int label2)
+{
+  int root1 = findRoot(parent, label1);
+  int root2 = findRoot(parent, label2);
+  if (root1 < root2) {
+    parent[root2] = root1;
+    return root1;
+  }
+  parent[root1] = root2;
+  return root2;
+}
 
-    // Right
-    if (I[i][j + 1] == currValue) {
-      listOfNeighbors.push(vpImagePoint(i, j + 1));
-    }
+/*!
+ * First pass of the labelling over the rows [top, bottom[. Neighboring pixels are connected when they have the same
+ * non null value. Provisional labels start at 1 and are local to the strip, \e parent growing with the number of
+ * labels.
+ */
+void labelStrip(const vpImage<unsigned char> &I, vpImage<int> &labels, std::vector<int> &parent, unsigned int top,
+                unsigned int bottom, bool connexity8)
+{
+  const unsigned int width = I.getWidth();
+  parent.assign(1, 0);
+  for (unsigned int i = top; i < bottom; ++i) {
+    const unsigned char *row = I[i];
+    const unsigned char *prevRow = (i > top) ? I[i - 1] : nullptr;
+    int *labelRow = labels[i];
+    const int *prevLabelRow = (i > top) ? labels[i - 1] : nullptr;
 
-    // Bottom
-    if (I[i + 1][j] == currValue) {
-      listOfNeighbors.push(vpImagePoint(i + 1, j));
-    }
-  }
-  else {
-    for (int cpt1 = -1; cpt1 <= 1; ++cpt1) {
-      for (int cpt2 = -1; cpt2 <= 1; ++cpt2) {
-        // Everything except the current position
-        if ((cpt1 != 0) || (cpt2 != 0)) {
-          if (I[static_cast<int>(i) + cpt1][static_cast<int>(j) + cpt2] == currValue) {
-            listOfNeighbors.push(vpImagePoint(static_cast<int>(i) + cpt1, static_cast<int>(j) + cpt2));
+    for (unsigned int j = 0; j < width; ++j) {
+      const unsigned char value = row[j];
+      int label = 0;
+      if (value != 0) {
+        const bool left = (j > 0) && (row[j - 1] == value);
+        if (prevRow == nullptr) {
+          if (left) {
+            label = labelRow[j - 1];
           }
         }
+        else if (connexity8) {
+          if (prevRow[j] == value) {
+            // Left and top-left neighbors are also neighbors of the top one
+            label = prevLabelRow[j];
+          }
+          else {
+            if (left) {
+              label = labelRow[j - 1];
+            }
+            else if ((j > 0) && (prevRow[j - 1] == value)) {
+              label = prevLabelRow[j - 1];
+            }
+            if (((j + 1) < width) && (prevRow[j + 1] == value)) {
+              label = (label != 0) ? merge(parent, label, prevLabelRow[j + 1]) : prevLabelRow[j + 1];
+            }
+          }
+        }
+        else {
+          if (left) {
+            label = labelRow[j - 1];
+          }
+          if (prevRow[j] == value) {
+            label = (label != 0) ? merge(parent, label, prevLabelRow[j]) : prevLabelRow[j];
+          }
+        }
+
+        if (label == 0) {
+          label = static_cast<int>(parent.size());
+          parent.push_back(label);
+        }
       }
+      labelRow[j] = label;
     }
   }
 }
 
-void visitNeighbors(vpImage<unsigned char> &I_copy, std::queue<vpImagePoint> &listOfNeighbors, vpImage<int> &labels,
-                    int current_label, const vpImageMorphology::vpConnexityType &connexity)
+/*!
+ * Merge the components of the first row of a strip with the ones of the last row of the previous strip. The local
+ * labels of these strips are shifted by \e offset and \e prevOffset in \e parent.
+ */
+void mergeStrips(const vpImage<unsigned char> &I, const vpImage<int> &labels, std::vector<int> &parent,
+                 unsigned int row, int offset, int prevOffset, bool connexity8)
 {
-  // Visit the neighbors
-  while (!listOfNeighbors.empty()) {
-    vpImagePoint imPt = listOfNeighbors.front();
-    unsigned int i = static_cast<unsigned int>(imPt.get_i());
-    unsigned int j = static_cast<unsigned int>(imPt.get_j());
-    listOfNeighbors.pop();
-
-    if (I_copy[i][j]) {
-      getNeighbors(I_copy, listOfNeighbors, i, j, connexity);
-
-      // Reset current position and set label
-      I_copy[i][j] = 0;
-      labels[i][j] = current_label;
+  const unsigned int width = I.getWidth();
+  const unsigned char *values = I[row];
+  const unsigned char *prevValues = I[row - 1];
+  const int *labelRow = labels[row];
+  const int *prevLabelRow = labels[row - 1];
+  for (unsigned int j = 0; j < width; ++j) {
+    const unsigned char value = values[j];
+    if (value != 0) {
+      const int label = offset + labelRow[j];
+      if (prevValues[j] == value) {
+        merge(parent, label, prevOffset + prevLabelRow[j]);
+      }
+      if (connexity8) {
+        if ((j > 0) && (prevValues[j - 1] == value)) {
+          merge(parent, label, prevOffset + prevLabelRow[j - 1]);
+        }
+        if (((j + 1) < width) && (prevValues[j + 1] == value)) {
+          merge(parent, label, prevOffset + prevLabelRow[j + 1]);
+        }
+      }
     }
   }
 }
 
-void connectedComponents(const vpImage<unsigned char> &I, vpImage<int> &labels, int &nbComponents, const vpImageMorphology::vpConnexityType &connexity)
+struct vpComponentAccumulator
 {
-  if (I.getSize() == 0) {
-    return;
-  }
-
-  labels.resize(I.getHeight(), I.getWidth());
+  vpComponentAccumulator()
+    : area(0), top(0), left(0), bottom(0), right(0), sum_i(0.), sum_j(0.)
+  { }
 
-  vpImage<unsigned char> I_copy(I.getHeight() + 2, I.getWidth() + 2);
-  // Copy and add border
-  unsigned int i_copy_height = I_copy.getHeight();
-  for (unsigned int i = 0; i < i_copy_height; ++i) {
-    if ((i == 0) || (i == (I_copy.getHeight() - 1))) {
-      memset(I_copy[i], 0, sizeof(unsigned char) * I_copy.getWidth());
+  void add(unsigned int i, unsigned int j)
+  {
+    if (area == 0) {
+      top = i;
+      bottom = i;
+      left = j;
+      right = j;
     }
     else {
-      I_copy[i][0] = 0;
-      memcpy(I_copy[i] + 1, I[i - 1], sizeof(unsigned char) * I.getWidth());
-      I_copy[i][I_copy.getWidth() - 1] = 0;
+      top = std::min<unsigned int>(top, i);
+      bottom = std::max<unsigned int>(bottom, i);
+      left = std::min<unsigned int>(left, j);
+      right = std::max<unsigned int>(right, j);
     }
+    ++area;
+    sum_i += i;
+    sum_j += j;
   }
 
-  vpImage<int> labels_copy(I.getHeight() + 2, I.getWidth() + 2, 0);
+  void add(const vpComponentAccumulator &other)
+  {
+    if (other.area != 0) {
+      if (area == 0) {
+        *this = other;
+      }
+      else {
+        top = std::min<unsigned int>(top, other.top);
+        bottom = std::max<unsigned int>(bottom, other.bottom);
+        left = std::min<unsigned int>(left, other.left);
+        right = std::max<unsigned int>(right, other.right);
+        area += other.area;
+        sum_i += other.sum_i;
+        sum_j += other.sum_j;
+      }
+    }
+  }
+
+  unsigned int area;
+  unsigned int top, left, bottom, right;
+  double sum_i, sum_j;
+};
+
+/*!
+ * Statistics of the components seen in a strip. A component starting in a previous strip has a pixel in the first
+ * row of the strip, so that there are at most as many of them as columns.
+ */
+struct vpStripAccumulator
+{
+  std::vector<vpComponentAccumulator> components; //!< Components starting in the strip, by increasing label
+  std::unordered_map<int, vpComponentAccumulator> inherited; //!< Components starting in a previous strip
+};
+
+void labelComponents(const vpImage<unsigned char> &I, vpImage<int> &labels, int &nbComponents,
+                     std::vector<vpConnectedComponentStats> *p_stats, const vpImageMorphology::vpConnexityType &connexity)
+{
+  const unsigned int height = I.getHeight(), width = I.getWidth();
+  labels.resize(height, width);
+  nbComponents = 0;
+  if (p_stats != nullptr) {
+    p_stats->clear();
+  }
+  if (I.getSize() == 0) {
+    return;
+  }
 
-  int current_label = 1;
-  std::queue<vpImagePoint> listOfNeighbors;
+  const bool connexity8 = (connexity == vpImageMorphology::CONNEXITY_8);
+
+  // The image is split in horizontal strips that are labelled independently, the provisional labels of a strip
+  // starting after the largest label the previous strips may use
+  int nbStrips = 1;
+#if defined(VISP_HAVE_OPENMP)
+  nbStrips = std::max<int>(1, std::min<int>(omp_get_max_threads(), static_cast<int>(height / minStripRows)));
+#endif
+  std::vector<unsigned int> stripTop(nbStrips + 1);
+  for (int s = 0; s <= nbStrips; ++s) {
+    stripTop[s] = static_cast<unsigned int>((static_cast<unsigned long long>(height) * s) / nbStrips);
+  }
+  // Union-find forest of each strip, labels of strip s being shifted by stripOffset[s] once the strips are merged
+  std::vector<std::vector<int> > stripParent(nbStrips);
 
-  unsigned int i_height = I.getHeight();
-  for (unsigned int cpt1 = 0; cpt1 < i_height; ++cpt1) {
-    unsigned int i = cpt1 + 1;
+#if defined(VISP_HAVE_OPENMP)
+#pragma omp parallel for schedule(static, 1) num_threads(nbStrips)
+#endif
+  for (int s = 0; s < nbStrips; ++s) {
+    labelStrip(I, labels, stripParent[s], stripTop[s], stripTop[s + 1], connexity8);
+  }
 
-    unsigned int i_width = I.getWidth();
-    for (unsigned int cpt2 = 0; cpt2 < i_width; ++cpt2) {
-      unsigned int j = cpt2 + 1;
+  std::vector<int> stripOffset(nbStrips + 1, 0);
+  for (int s = 0; s < nbStrips; ++s) {
+    stripOffset[s + 1] = stripOffset[s] + static_cast<int>(stripParent[s].size()) - 1;
+  }
+  std::vector<int> parent(static_cast<size_t>(stripOffset[nbStrips]) + 1);
+  parent[0] = 0;
+  for (int s = 0; s < nbStrips; ++s) {
+    const std::vector<int> &localParent = stripParent[s];
+    for (size_t label = 1; label < localParent.size(); ++label) {
+      parent[stripOffset[s] + label] = stripOffset[s] + localParent[label];
+    }
+    std::vector<int>().swap(stripParent[s]);
+  }
 
-      if (I_copy[i][j] && (labels_copy[i][j] == 0)) {
-        // Get all the neighbors relative to the current position
-        getNeighbors(I_copy, listOfNeighbors, i, j, connexity);
+  for (int s = 1; s < nbStrips; ++s) {
+    mergeStrips(I, labels, parent, stripTop[s], stripOffset[s], stripOffset[s - 1], connexity8);
+  }
 
-        // Reset current position and set label
-        I_copy[i][j] = 0;
-        labels_copy[i][j] = current_label;
+  // Final labels numbered in raster order of the first pixel of each component. A parent having a lower label than
+  // its children, its final label is already known. The components starting in strip s get the final labels
+  // [stripFirstLabel[s], stripFirstLabel[s + 1][
+  int nbLabels = 0;
+  std::vector<int> stripFirstLabel(nbStrips + 1);
+  for (int s = 0; s < nbStrips; ++s) {
+    stripFirstLabel[s] = nbLabels + 1;
+    for (int label = stripOffset[s] + 1; label <= stripOffset[s + 1]; ++label) {
+      if (parent[label] == label) {
+        ++nbLabels;
+        parent[label] = nbLabels;
+      }
+      else {
+        parent[label] = parent[parent[label]];
+      }
+    }
+  }
+  stripFirstLabel[nbStrips] = nbLabels + 1;
+  nbComponents = nbLabels;
 
-        visitNeighbors(I_copy, listOfNeighbors, labels_copy, current_label, connexity);
+  std::vector<vpStripAccumulator> accumulators;
+  if (p_stats != nullptr) {
+    accumulators.resize(nbStrips);
+  }
 
-        // Increment label
-        ++current_label;
+#if defined(VISP_HAVE_OPENMP)
+#pragma omp parallel for schedule(static, 1) num_threads(nbStrips)
+#endif
+  for (int s = 0; s < nbStrips; ++s) {
+    const int offset = stripOffset[s];
+    const int firstLabel = stripFirstLabel[s];
+    vpStripAccumulator *p_accumulator = nullptr;
+    if (p_stats != nullptr) {
+      p_accumulator = &accumulators[s];
+      p_accumulator->components.resize(static_cast<size_t>(stripFirstLabel[s + 1] - firstLabel));
+    }
+    // Inherited components usually span runs of pixels, avoid a lookup for each of them
+    int lastInheritedLabel = 0;
+    vpComponentAccumulator *p_lastInherited = nullptr;
+    for (unsigned int i = stripTop[s]; i < stripTop[s + 1]; ++i) {
+      int *labelRow = labels[i];
+      for (unsigned int j = 0; j < width; ++j) {
+        if (labelRow[j] != 0) {
+          const int label = parent[offset + labelRow[j]];
+          labelRow[j] = label;
+          if (p_accumulator != nullptr) {
+            if (label >= firstLabel) {
+              p_accumulator->components[label - firstLabel].add(i, j);
+            }
+            else {
+              if (label != lastInheritedLabel) {
+                lastInheritedLabel = label;
+                p_lastInherited = &p_accumulator->inherited[label];
+              }
+              p_lastInherited->add(i, j);
+            }
+          }
+        }
       }
     }
   }
-  unsigned int labels_height = labels.getHeight();
-  for (unsigned int i = 0; i < labels_height; ++i) {
-    memcpy(labels[i], labels_copy[i + 1] + 1, sizeof(int) * labels.getWidth());
+
+  if (p_stats != nullptr) {
+    std::vector<vpComponentAccumulator> accumulator(static_cast<size_t>(nbLabels));
+    for (int s = 0; s < nbStrips; ++s) {
+      const std::vector<vpComponentAccumulator> &components = accumulators[s].components;
+      std::copy(components.begin(), components.end(), accumulator.begin() + (stripFirstLabel[s] - 1));
+    }
+    for (int s = 1; s < nbStrips; ++s) {
+      const std::unordered_map<int, vpComponentAccumulator> &inherited = accumulators[s].inherited;
+      for (std::unordered_map<int, vpComponentAccumulator>::const_iterator it = inherited.begin();
+           it != inherited.end(); ++it) {
+        accumulator[it->first - 1].add(it->second);
+      }
+    }
+
+    p_stats->resize(static_cast<size_t>(nbLabels));
+    for (int k = 0; k < nbLabels; ++k) {
+      const vpComponentAccumulator &acc = accumulator[k];
+      vpConnectedComponentStats &stats = (*p_stats)[k];
+      stats.area = acc.area;
+      stats.bbox = vpRect(vpImagePoint(acc.top, acc.left), vpImagePoint(acc.bottom, acc.right));
+      stats.cog = vpImagePoint(acc.sum_i / acc.area, acc.sum_j / acc.area);
+    }
   }
+}
+} // namespace
+#endif // DOXYGEN_SHOULD_SKIP_THIS
 
-  nbComponents = current_label - 1;
+void connectedComponents(const vpImage<unsigned char> &I, vpImage<int> &labels, int &nbComponents,
+                         const vpImageMorphology::vpConnexityType &connexity)
+{
+  labelComponents(I, labels, nbComponents, nullptr, connexity);
+}
+
+void connectedComponents(const vpImage<unsigned char> &I, vpImage<int> &labels, int &nbComponents,
+                         std::vector<vpConnectedComponentStats> &stats,
+                         const vpImageMorphology::vpConnexityType &connexity)
+{
+  labelComponents(I, labels, nbComponents, &stats, connexity);
 }
 
 } // namespace
@@ -81,13 +81,17 @@
   \brief Retinex algorithm
 */
 
-#include <functional>
-#include <numeric>
+#include <algorithm>
+#include <cmath>
 
 #include <visp3/core/vpImageFilter.h>
 #include <visp3/core/vpMath.h>
 #include <visp3/imgproc/vpImgproc.h>
 
+#if defined(VISP_HAVE_OPENMP)
+#include <omp.h>
+#endif
+
 #define MAX_RETINEX_SCALES 8
 namespace VISP_NAMESPACE_NAME
 {
@@ -135,10 +139,165 @@ std::vector<double> retinexScalesDistribution(int scaleDiv, int level, int scale
   return scales;
 }
 
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace
+{
+/*!
+ * Number of columns filtered together by the vertical pass of the recursive Gaussian filter.
+ */
+const int recursiveGaussianStripWidth = 64;
+
+/*!
+ * Coefficients of the third order recursive Gaussian filter of Young and van Vliet:
+ * w[n] = B x[n] + a1 w[n-1] + a2 w[n-2] + a3 w[n-3], applied forward then backward.
+ *
+ * I. T. Young, L. J. van Vliet. Recursive implementation of the Gaussian filter. Signal Processing,
+ * 1995, 44(2): 139-151
+ */
+struct vpRecursiveGaussianCoeffs
+{
+  explicit vpRecursiveGaussianCoeffs(double sigma)
+  {
+    double q;
+    if (sigma >= 2.5) {
+      q = (0.98711 * sigma) - 0.96330;
+    }
+    else {
+      q = 3.97156 - (4.14554 * std::sqrt(1.0 - (0.26891 * std::max<double>(sigma, 0.5))));
+    }
+    double q2 = q * q, q3 = q2 * q;
+    double b0 = 1.57825 + (2.44413 * q) + (1.4281 * q2) + (0.422205 * q3);
+    a1 = ((2.44413 * q) + (2.85619 * q2) + (1.26661 * q3)) / b0;
+    a2 = -((1.4281 * q2) + (1.26661 * q3)) / b0;
+    a3 = (0.422205 * q3) / b0;
+    B = 1.0 - (a1 + a2 + a3);
+  }
+
+  double B, a1, a2, a3;
+};
+
+/*!
+ * Filter \e N rows in place, the signal being extended with its border values. The recursions of the rows are
+ * interleaved to hide their latency.
+ */
+template <int N>
+void recursiveGaussianRows(double *const *rows, int size, const vpRecursiveGaussianCoeffs &c)
+{
+  double w1[N], w2[N], w3[N];
+  for (int k = 0; k < N; ++k) {
+    w1[k] = rows[k][0];
+    w2[k] = w1[k];
+    w3[k] = w1[k];
+  }
+  for (int i = 0; i < size; ++i) {
+    for (int k = 0; k < N; ++k) {
+      double w = (c.B * rows[k][i]) + (c.a1 * w1[k]) + (c.a2 * w2[k]) + (c.a3 * w3[k]);
+      w3[k] = w2[k];
+      w2[k] = w1[k];
+      w1[k] = w;
+      rows[k][i] = w;
+    }
+  }
+
+  for (int k = 0; k < N; ++k) {
+    w1[k] = rows[k][size - 1];
+    w2[k] = w1[k];
+    w3[k] = w1[k];
+  }
+  for (int i = size - 1; i >= 0; --i) {
+    for (int k = 0; k < N; ++k) {
+      double w = (c.B * rows[k][i]) + (c.a1 * w1[k]) + (c.a2 * w2[k]) + (c.a3 * w3[k]);
+      w3[k] = w2[k];
+      w2[k] = w1[k];
+      w1[k] = w;
+      rows[k][i] = w;
+    }
+  }
+}
+
+/*!
+ * Filter the columns [colMin, colMax) in place. The recursion runs along the rows so that consecutive
+ * columns are processed together.
+ */
+void recursiveGaussianColumns(vpImage<double> &I, int colMin, int colMax, const vpRecursiveGaussianCoeffs &c)
+{
+  const int height = static_cast<int>(I.getHeight());
+  const int last = height - 1;
+  // The first row is left unchanged, being the steady state of the filter on the border value
+  for (int y = 1; y < height; ++y) {
+    double *cur = I[y];
+    const double *w1 = I[y - 1];
+    const double *w2 = I[std::max<int>(y - 2, 0)];
+    const double *w3 = I[std::max<int>(y - 3, 0)];
+    for (int x = colMin; x < colMax; ++x) {
+      cur[x] = (c.B * cur[x]) + (c.a1 * w1[x]) + (c.a2 * w2[x]) + (c.a3 * w3[x]);
+    }
+  }
+
+  for (int y = last - 1; y >= 0; --y) {
+    double *cur = I[y];
+    const double *w1 = I[y + 1];
+    const double *w2 = I[std::min<int>(y + 2, last)];
+    const double *w3 = I[std::min<int>(y + 3, last)];
+    for (int x = colMin; x < colMax; ++x) {
+      cur[x] = (c.B * cur[x]) + (c.a1 * w1[x]) + (c.a2 * w2[x]) + (c.a3 * w3[x]);
+    }
+  }
+}
+
+/*!
+ * Gaussian blur with a recursive filter, whose cost does not depend on \e sigma.
+ */
+void recursiveGaussianBlur(const vpImage<double> &I, vpImage<double> &GI, double sigma, int nbThreads)
+{
+  const vpRecursiveGaussianCoeffs coeffs(sigma);
+  const int height = static_cast<int>(I.getHeight());
+  const int width = static_cast<int>(I.getWidth());
+  GI = I;
+
+  const int nbInterleavedRows = 4;
+  const int nbRowGroups = height / nbInterleavedRows;
+#if defined(VISP_HAVE_OPENMP)
+#pragma omp parallel for schedule(static) num_threads(nbThreads)
+#else
+  (void)nbThreads;
+#endif
+  for (int group = 0; group < nbRowGroups; ++group) {
+    double *rows[nbInterleavedRows];
+    for (int k = 0; k < nbInterleavedRows; ++k) {
+      rows[k] = GI[(group * nbInterleavedRows) + k];
+    }
+    recursiveGaussianRows<nbInterleavedRows>(rows, width, coeffs);
+  }
+  for (int y = nbRowGroups * nbInterleavedRows; y < height; ++y) {
+    double *row = GI[y];
+    recursiveGaussianRows<1>(&row, width, coeffs);
+  }
+
+  const int nbStrips = (width + recursiveGaussianStripWidth - 1) / recursiveGaussianStripWidth;
+#if defined(VISP_HAVE_OPENMP)
+#pragma omp parallel for schedule(dynamic) num_threads(nbThreads)
+#endif
+  for (int strip = 0; strip < nbStrips; ++strip) {
+    const int colMin = strip * recursiveGaussianStripWidth;
+    recursiveGaussianColumns(GI, colMin, std::min<int>(width, colMin + recursiveGaussianStripWidth), coeffs);
+  }
+}
+} // namespace
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
 // See: http://imagej.net/Retinex and
 // https://docs.gimp.org/en/plug-in-retinex.html
-void MSRCR(vpImage<vpRGBa> &I, int v_scale, int scaleDiv, int level, double dynamic, int v_kernelSize)
+void MSRCR(vpImage<vpRGBa> &I, int v_scale, int scaleDiv, int level, double dynamic, int v_kernelSize,
+           unsigned int nThreads)
 {
+#if defined(VISP_HAVE_OPENMP)
+  const int nbThreads = (nThreads > 0) ? static_cast<int>(nThreads) : omp_get_max_threads();
+#else
+  (void)nThreads;
+  const int nbThreads = 1;
+#endif
+
   // Calculate the scales of filtering according to the number of filter and
   // their distribution.
   std::vector<double> retinexScales = retinexScalesDistribution(scaleDiv, level, v_scale);
@@ -148,84 +307,95 @@ void MSRCR(vpImage<vpRGBa> &I, int v_scale, int scaleDiv, int level, double dyna
   // weight(here equivalent for all).
   double weight = 1.0 / static_cast<double>(scaleDiv);
 
-  std::vector<vpImage<double> > doubleRGB(3);
   std::vector<vpImage<double> > doubleResRGB(3);
-  unsigned int size = I.getSize();
-
-  int kernelSize = v_kernelSize;
-  if (kernelSize == -1) {
-    // Compute the kernel size from the input image size
-    kernelSize = static_cast<int>(std::min<unsigned int>(I.getWidth(), I.getHeight()) / 2.0);
-    const int moduloForOddityCheck = 2;
-    kernelSize = (kernelSize - (kernelSize % moduloForOddityCheck)) + 1;
+  vpImage<double> channelImage(I.getHeight(), I.getWidth());
+  vpImage<double> blurImage(I.getHeight(), I.getWidth());
+  vpImage<double> blurProduct(I.getHeight(), I.getWidth());
+  const int size = static_cast<int>(I.getSize());
+
+  // Logarithms of the pixel values, shifted by 1 to avoid problem with log(0), up to the sum of the three channels
+  // shifted by 3
+  const int nbLogs = (3 * 255) + 3;
+  std::vector<double> logLut(nbLogs), logAlphaLut(nbLogs);
+  const double alpha = 128.0;
+  for (int i = 0; i < nbLogs; ++i) {
+    logLut[i] = std::log(i + 1.0);
+    logAlphaLut[i] = std::log(alpha * (i + 1.0));
   }
 
   const int nbChannels = 3;
   const int id0 = 0, id1 = 1, id2 = 2;
   for (int channel = 0; channel < nbChannels; ++channel) {
-    doubleRGB[static_cast<size_t>(channel)] = vpImage<double>(I.getHeight(), I.getWidth());
-    doubleResRGB[static_cast<size_t>(channel)] = vpImage<double>(I.getHeight(), I.getWidth());
-
-    for (unsigned int cpt = 0; cpt < size; ++cpt) {
-      // Shift the pixel values by 1 to avoid problem with log(0)
-      switch (channel) {
-      case 0:
-        doubleRGB[static_cast<size_t>(channel)].bitmap[cpt] = I.bitmap[cpt].R + 1.0;
-        break;
-
-      case 1:
-        doubleRGB[static_cast<size_t>(channel)].bitmap[cpt] = I.bitmap[cpt].G + 1.0;
-        break;
-
-      case id2:
-        doubleRGB[static_cast<size_t>(channel)].bitmap[cpt] = I.bitmap[cpt].B + 1.0;
-        break;
-
-      default:
-        break;
-      }
+    vpImage<double> &resImage = doubleResRGB[static_cast<size_t>(channel)];
+    resImage.resize(I.getHeight(), I.getWidth());
+
+    const unsigned char *src = reinterpret_cast<const unsigned char *>(I.bitmap) + channel;
+    const int sizeRGBa = 4;
+#if defined(VISP_HAVE_OPENMP)
+#pragma omp parallel for schedule(static) num_threads(nbThreads)
+#endif
+    for (int cpt = 0; cpt < size; ++cpt) {
+      channelImage.bitmap[cpt] = src[cpt * sizeRGBa] + 1.0;
+      resImage.bitmap[cpt] = logLut[src[cpt * sizeRGBa]];
+      blurProduct.bitmap[cpt] = 1.0;
     }
 
+    // Summarize the filtered values.
+    // In fact one calculates a ratio between the original values and the
+    // filtered values. The weights being equal and summing to 1, the sum of the
+    // logs of the filtered values is computed as the log of their product.
     for (int sc = 0; sc < scaleDiv; ++sc) {
-      vpImage<double> blurImage;
       double sigma = retinexScales[static_cast<size_t>(sc)];
-      vpImageFilter::gaussianBlur(doubleRGB[static_cast<size_t>(channel)], blurImage, static_cast<unsigned int>(kernelSize), sigma);
-
-      for (unsigned int cpt = 0; cpt < size; ++cpt) {
-        // Summarize the filtered values.
-        // In fact one calculates a ratio between the original values and the
-        // filtered values.
-        doubleResRGB[static_cast<size_t>(channel)].bitmap[cpt] +=
-          weight * (std::log(doubleRGB[static_cast<size_t>(channel)].bitmap[cpt]) - std::log(blurImage.bitmap[cpt]));
+      if (v_kernelSize == -1) {
+        recursiveGaussianBlur(channelImage, blurImage, sigma, nbThreads);
+      }
+      else {
+        vpImageFilter::gaussianBlur(channelImage, blurImage, static_cast<unsigned int>(v_kernelSize), sigma);
+      }
+
+#if defined(VISP_HAVE_OPENMP)
+#pragma omp parallel for schedule(static) num_threads(nbThreads)
+#endif
+      for (int cpt = 0; cpt < size; ++cpt) {
+        blurProduct.bitmap[cpt] *= blurImage.bitmap[cpt];
       }
     }
+
+#if defined(VISP_HAVE_OPENMP)
+#pragma omp parallel for schedule(static) num_threads(nbThreads)
+#endif
+    for (int cpt = 0; cpt < size; ++cpt) {
+      resImage.bitmap[cpt] -= weight * std::log(blurProduct.bitmap[cpt]);
+    }
   }
 
-  std::vector<double> dest(size * nbChannels);
-  const double gain = 1.0, alpha = 128.0, offset = 0.0;
+  std::vector<double> dest(static_cast<size_t>(size) * nbChannels);
+  const double gain = 1.0, offset = 0.0;
 
-  for (unsigned int cpt = 0; cpt < size; ++cpt) {
-    double logl = std::log(static_cast<double>(I.bitmap[cpt].R + I.bitmap[cpt].G + I.bitmap[cpt].B + 3.0));
+  double sum = 0.0;
+#if defined(VISP_HAVE_OPENMP)
+#pragma omp parallel for schedule(static) num_threads(nbThreads) reduction(+:sum)
+#endif
+  for (int cpt = 0; cpt < size; ++cpt) {
+    double logl = logLut[I.bitmap[cpt].R + I.bitmap[cpt].G + I.bitmap[cpt].B + 2];
 
-    dest[cpt * nbChannels] = (gain * (std::log(alpha * doubleRGB[id0].bitmap[cpt]) - logl) * doubleResRGB[id0].bitmap[cpt]) + offset;
-    dest[(cpt * nbChannels) + id1] =
-      (gain * (std::log(alpha * doubleRGB[id1].bitmap[cpt]) - logl) * doubleResRGB[id1].bitmap[cpt]) + offset;
-    dest[(cpt * nbChannels) + id2] =
-      (gain * (std::log(alpha * doubleRGB[id2].bitmap[cpt]) - logl) * doubleResRGB[id2].bitmap[cpt]) + offset;
+    dest[cpt * nbChannels] = (gain * (logAlphaLut[I.bitmap[cpt].R] - logl) * doubleResRGB[id0].bitmap[cpt]) + offset;
+    dest[(cpt * nbChannels) + id1] = (gain * (logAlphaLut[I.bitmap[cpt].G] - logl) * doubleResRGB[id1].bitmap[cpt]) + offset;
+    dest[(cpt * nbChannels) + id2] = (gain * (logAlphaLut[I.bitmap[cpt].B] - logl) * doubleResRGB[id2].bitmap[cpt]) + offset;
+    sum += dest[cpt * nbChannels] + dest[(cpt * nbChannels) + id1] + dest[(cpt * nbChannels) + id2];
   }
 
-  double sum = std::accumulate(dest.begin(), dest.end(), 0.0);
   double mean = sum / dest.size();
 
-  std::vector<double> diff(dest.size());
-
-#if VISP_CXX_STANDARD > VISP_CXX_STANDARD_98
-  std::transform(dest.begin(), dest.end(), diff.begin(), std::bind(std::minus<double>(), std::placeholders::_1, mean));
-#else
-  std::transform(dest.begin(), dest.end(), diff.begin(), std::bind2nd(std::minus<double>(), mean));
+  double sq_sum = 0.0;
+  const int dest_size = static_cast<int>(dest.size());
+#if defined(VISP_HAVE_OPENMP)
+#pragma omp parallel for schedule(static) num_threads(nbThreads) reduction(+:sq_sum)
 #endif
-
-  double sq_sum = std::inner_product(diff.begin(), diff.end(), diff.begin(), 0.0);
+  for (int i = 0; i < dest_size; ++i) {
+    double diff = dest[i] - mean;
+    sq_sum += diff * diff;
+  }
   double stdev = std::sqrt(sq_sum / dest.size());
 
   double mini = mean - (dynamic * stdev);
@@ -236,14 +406,18 @@ void MSRCR(vpImage<vpRGBa> &I, int v_scale, int scaleDiv, int level, double dyna
     range = 1.0;
   }
 
-  for (unsigned int cpt = 0; cpt < size; ++cpt) {
+#if defined(VISP_HAVE_OPENMP)
+#pragma omp parallel for schedule(static) num_threads(nbThreads)
+#endif
+  for (int cpt = 0; cpt < size; ++cpt) {
     I.bitmap[cpt].R = vpMath::saturate<unsigned char>((255.0 * (dest[(cpt * nbChannels) + id0] - mini)) / range);
     I.bitmap[cpt].G = vpMath::saturate<unsigned char>((255.0 * (dest[(cpt * nbChannels) + id1] - mini)) / range);
     I.bitmap[cpt].B = vpMath::saturate<unsigned char>((255.0 * (dest[(cpt * nbChannels) + id2] - mini)) / range);
   }
 }
 
-void retinex(vpImage<vpRGBa> &I, int scale, int scaleDiv, int level, const double dynamic, int kernelSize)
+void retinex(vpImage<vpRGBa> &I, int scale, int scaleDiv, int level, const double dynamic, int kernelSize,
+             unsigned int nThreads)
 {
   // Assert scale
   const int minScale = 16, maxScale = 250;
@@ -263,14 +437,14 @@ void retinex(vpImage<vpRGBa> &I, int scale, int scaleDiv, int level, const doubl
     return;
   }
 
-  MSRCR(I, scale, scaleDiv, level, dynamic, kernelSize);
+  MSRCR(I, scale, scaleDiv, level, dynamic, kernelSize, nThreads);
 }
 
 void retinex(const vpImage<vpRGBa> &I1, vpImage<vpRGBa> &I2, int scale, int scaleDiv, int level, double dynamic,
-                 int kernelSize)
+                 int kernelSize, unsigned int nThreads)
 {
   I2 = I1;
-  retinex(I2, scale, scaleDiv, level, dynamic, kernelSize);
+  retinex(I2, scale, scaleDiv, level, dynamic, kernelSize, nThreads);
 }
 
 } // namespace
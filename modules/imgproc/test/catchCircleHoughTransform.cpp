@@ -0,0 +1,190 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2024 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ *
+ * Description:
+ * Test and benchmark the multithreaded voting steps of the circle Hough transform.
+ */
+
+/*!
+  \example catchCircleHoughTransform.cpp
+
+  \brief Test and benchmark the multithreaded voting steps of the circle Hough transform.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2)
+
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+#include <catch_amalgamated.hpp>
+#include <visp3/imgproc/vpCircleHoughTransform.h>
+
+#ifdef ENABLE_VISP_NAMESPACE
+using namespace VISP_NAMESPACE_NAME;
+#endif
+
+static bool runBenchmark = false;
+
+namespace
+{
+// Dark image containing a grid of bright disks, whose radius varies between 35 and 60 pixels
+void createImage(vpImage<unsigned char> &I, unsigned int height, unsigned int width,
+                 std::vector<vpImageCircle> &circles)
+{
+  I.resize(height, width, 20);
+  circles.clear();
+  const unsigned int step = 160;
+  unsigned int id = 0;
+  for (unsigned int v = step / 2; (v + (step / 2)) <= height; v += step) {
+    for (unsigned int u = step / 2; (u + (step / 2)) <= width; u += step) {
+      const float radius = 35.f + static_cast<float>((id * 7) % 26);
+      circles.push_back(vpImageCircle(vpImagePoint(v, u), radius));
+      for (unsigned int i = v - step / 2; i < v + step / 2; ++i) {
+        for (unsigned int j = u - step / 2; j < u + step / 2; ++j) {
+          const float di = static_cast<float>(i) - static_cast<float>(v);
+          const float dj = static_cast<float>(j) - static_cast<float>(u);
+          if (((di * di) + (dj * dj)) <= (radius * radius)) {
+            I[i][j] = 220;
+          }
+        }
+      }
+      ++id;
+    }
+  }
+}
+
+vpCircleHoughTransform::vpCircleHoughTransformParams createParams(unsigned int height, unsigned int width,
+                                                                  bool recordVotingPoints)
+{
+  return vpCircleHoughTransform::vpCircleHoughTransformParams(5, 1.f, 3, -1.f, -1.f, 0,
+                                                              std::pair<int, int>(0, static_cast<int>(width)),
+                                                              std::pair<int, int>(0, static_cast<int>(height)),
+                                                              30.f, 65.f, 5, 5, 20.f, 0.7f, 0.9f, 10.f, 5.f,
+                                                              vpImageFilter::CANNY_GBLUR_SOBEL_FILTERING,
+                                                              vpImageFilter::CANNY_VISP_BACKEND, 0.6f, 0.8f, -1,
+                                                              recordVotingPoints);
+}
+} // namespace
+
+TEST_CASE("Circle Hough transform detects synthetic disks", "[houghCircle]")
+{
+  vpImage<unsigned char> I;
+  std::vector<vpImageCircle> circles;
+  createImage(I, 480, 640, circles);
+
+  for (unsigned int nbThreads = 1; nbThreads <= 3; ++nbThreads) {
+    vpCircleHoughTransform detector(createParams(I.getHeight(), I.getWidth(), false));
+    detector.setNbThreads(nbThreads);
+    CHECK(detector.getNbThreads() == nbThreads);
+    std::vector<vpImageCircle> detections = detector.detect(I);
+    CHECK(detections.size() == circles.size());
+    for (size_t i = 0; i < circles.size(); ++i) {
+      bool found = false;
+      for (size_t j = 0; (j < detections.size()) && (!found); ++j) {
+        found = (vpImagePoint::distance(circles[i].getCenter(), detections[j].getCenter()) < 5.)
+          && (std::abs(circles[i].getRadius() - detections[j].getRadius()) < 3.f);
+      }
+      INFO("Circle " << i << " of radius " << circles[i].getRadius());
+      CHECK(found);
+    }
+  }
+}
+
+TEST_CASE("Circle Hough transform gives close results whatever the number of threads", "[houghCircle]")
+{
+  vpImage<unsigned char> I;
+  std::vector<vpImageCircle> circles;
+  createImage(I, 960, 1280, circles);
+
+  vpCircleHoughTransform detectorRef(createParams(I.getHeight(), I.getWidth(), true));
+  detectorRef.setNbThreads(1);
+  std::vector<vpImageCircle> detectionsRef = detectorRef.detect(I);
+  REQUIRE(detectionsRef.size() == circles.size());
+
+  for (unsigned int nbThreads = 2; nbThreads <= 4; ++nbThreads) {
+    vpCircleHoughTransform detector(createParams(I.getHeight(), I.getWidth(), true));
+    detector.setNbThreads(nbThreads);
+    std::vector<vpImageCircle> detections = detector.detect(I);
+    REQUIRE(detections.size() == detectionsRef.size());
+    REQUIRE(detector.getCircleCandidates().size() == detectorRef.getCircleCandidates().size());
+    REQUIRE(detector.getDetectionsVotingPoints().size() == detectorRef.getDetectionsVotingPoints().size());
+    for (size_t i = 0; i < detections.size(); ++i) {
+      // The center votes are summed in an order depending on the number of threads, which may slightly move the
+      // centers and change the radii
+      CHECK(vpImagePoint::distance(detections[i].getCenter(), detectionsRef[i].getCenter()) < 1e-2);
+      CHECK(std::abs(detections[i].getRadius() - detectionsRef[i].getRadius()) < 1e-2f);
+      CHECK(detector.getDetectionsVotingPoints()[i].size() == detectorRef.getDetectionsVotingPoints()[i].size());
+    }
+  }
+}
+
+TEST_CASE("Circle Hough transform benchmark", "[benchmark]")
+{
+  if (runBenchmark) {
+    vpImage<unsigned char> I;
+    std::vector<vpImageCircle> circles;
+    createImage(I, 1080, 1920, circles);
+
+    vpCircleHoughTransform detector(createParams(I.getHeight(), I.getWidth(), false));
+    detector.setNbThreads(1);
+    BENCHMARK("Benchmark circle Hough transform on a 1080p image, 1 thread")
+    {
+      return detector.detect(I);
+    };
+
+    detector.setNbThreads(0);
+    BENCHMARK("Benchmark circle Hough transform on a 1080p image")
+    {
+      return detector.detect(I);
+    };
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session;
+
+  auto cli = session.cli()         // Get Catch's composite command line parser
+    | Catch::Clara::Opt(runBenchmark)   // bind variable to a new option, with a hint string
+    ["--benchmark"] // the option names it will respond to
+    ("run benchmark of the circle Hough transform"); // description string for the help output
+
+  // Now pass the new composite back to Catch so it uses that
+  session.cli(cli);
+  session.applyCommandLine(argc, argv);
+  int numFailed = session.run();
+  return numFailed;
+}
+#else
+int main() { return EXIT_SUCCESS; }
+#endif
@@ -0,0 +1,459 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2024 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ *
+ * Description:
+ * Test and benchmark multithreaded CLAHE and Retinex.
+ */
+
+/*!
+  \example catchClaheRetinex.cpp
+
+  \brief Test and benchmark multithreaded CLAHE and Retinex.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2)
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+#include <catch_amalgamated.hpp>
+#include <visp3/core/vpImageConvert.h>
+#include <visp3/core/vpUniRand.h>
+#include <visp3/imgproc/vpImgproc.h>
+
+#ifdef ENABLE_VISP_NAMESPACE
+using namespace VISP_NAMESPACE_NAME;
+#endif
+
+static bool runBenchmark = false;
+
+namespace
+{
+int roundBin(unsigned char v, int bins) { return static_cast<int>(((v / 255.0f) * bins) + 0.5f); }
+
+// Clip the histogram and redistribute the clipped entries until convergence
+void clipHistogram(std::vector<int> &hist, int limit)
+{
+  const int histLength = static_cast<int>(hist.size());
+  int clippedEntries = 0, clippedEntriesBefore = 0;
+  do {
+    clippedEntriesBefore = clippedEntries;
+    clippedEntries = 0;
+    for (int i = 0; i < histLength; ++i) {
+      if (hist[i] > limit) {
+        clippedEntries += hist[i] - limit;
+        hist[i] = limit;
+      }
+    }
+    for (int i = 0; i < histLength; ++i) {
+      hist[i] += clippedEntries / histLength;
+    }
+    const int m = clippedEntries % histLength;
+    if (m != 0) {
+      const int s = (histLength - 1) / m;
+      for (int i = s / 2; i < histLength; i += s) {
+        ++hist[i];
+      }
+    }
+  } while (clippedEntries != clippedEntriesBefore);
+}
+
+// Reference accurate CLAHE: the histogram of the local region is computed from scratch for each pixel
+void claheReference(const vpImage<unsigned char> &I1, vpImage<unsigned char> &I2, int blockRadius, int bins,
+                    float slope)
+{
+  const int height = static_cast<int>(I1.getHeight()), width = static_cast<int>(I1.getWidth());
+  const int histLength = bins + 1;
+  I2.resize(I1.getHeight(), I1.getWidth());
+  std::vector<int> hist(histLength);
+  for (int y = 0; y < height; ++y) {
+    for (int x = 0; x < width; ++x) {
+      const int yMin = std::max<int>(0, y - blockRadius), yMax = std::min<int>(height, y + blockRadius + 1);
+      const int xMin = std::max<int>(0, x - blockRadius), xMax = std::min<int>(width, x + blockRadius + 1);
+      std::fill(hist.begin(), hist.end(), 0);
+      for (int yi = yMin; yi < yMax; ++yi) {
+        for (int xi = xMin; xi < xMax; ++xi) {
+          ++hist[roundBin(I1[yi][xi], bins)];
+        }
+      }
+      const int limit = static_cast<int>(((slope * ((yMax - yMin) * (xMax - xMin))) / bins) + 0.5f);
+      clipHistogram(hist, limit);
+
+      int hMin = histLength - 1;
+      for (int i = 0; i < (histLength - 1); ++i) {
+        if (hist[i] != 0) {
+          hMin = i;
+          break;
+        }
+      }
+      const int v = roundBin(I1[y][x], bins);
+      int cdf = 0, cdfMax = 0;
+      for (int i = hMin; i < histLength; ++i) {
+        cdfMax += hist[i];
+        if (i <= v) {
+          cdf += hist[i];
+        }
+      }
+      const float t = (cdf - hist[hMin]) / static_cast<float>(cdfMax - hist[hMin]);
+      I2[y][x] = static_cast<unsigned char>(static_cast<int>((t * 255.0f) + 0.5f));
+    }
+  }
+}
+
+// Transfer function of the block centered on (xc, yc), as computed by the reference fast CLAHE
+std::vector<float> blockTransfer(const vpImage<unsigned char> &I, int xc, int yc, int blockRadius, int bins, int limit)
+{
+  const int histLength = bins + 1;
+  std::vector<int> hist(histLength, 0);
+  const int yMin = std::max<int>(0, yc - blockRadius), yMax = std::min<int>(I.getHeight(), yc + blockRadius + 1);
+  const int xMin = std::max<int>(0, xc - blockRadius), xMax = std::min<int>(I.getWidth(), xc + blockRadius + 1);
+  for (int y = yMin; y < yMax; ++y) {
+    for (int x = xMin; x < xMax; ++x) {
+      ++hist[roundBin(I[y][x], bins)];
+    }
+  }
+  clipHistogram(hist, limit);
+
+  int hMin = histLength - 1;
+  for (int i = 0; i < (histLength - 1); ++i) {
+    if (hist[i] != 0) {
+      hMin = i;
+      break;
+    }
+  }
+  std::vector<int> cdfs(hist);
+  int cdf = 0;
+  for (int i = hMin; i < histLength; ++i) {
+    cdf += hist[i];
+    cdfs[i] = cdf;
+  }
+  std::vector<float> transfer(histLength);
+  for (int i = 0; i < histLength; ++i) {
+    transfer[i] = (cdfs[i] - cdfs[hMin]) / static_cast<float>(cdfs[histLength - 1] - cdfs[hMin]);
+  }
+  return transfer;
+}
+
+// Centers of the blocks along one dimension, as placed by the reference fast CLAHE
+std::vector<int> blockCenters(int length, int blockRadius)
+{
+  const int blockSize = (2 * blockRadius) + 1;
+  const int n = length / blockSize, rem = length - (n * blockSize);
+  std::vector<int> centers;
+  if (rem > 1) {
+    centers.push_back(blockRadius + 1);
+  }
+  for (int i = 0; i < n; ++i) {
+    centers.push_back((i * blockSize) + blockRadius + 1 + ((rem > 1) ? (rem / 2) : 0));
+  }
+  if (rem > 0) {
+    centers.push_back(length - blockRadius - 1);
+  }
+  return centers;
+}
+
+// Reference fast CLAHE: the transfer functions of the four nearest blocks are interpolated for each pixel
+void claheFastReference(const vpImage<unsigned char> &I1, vpImage<unsigned char> &I2, int blockRadius, int bins,
+                        float slope)
+{
+  const int blockSize = (2 * blockRadius) + 1;
+  const int limit = static_cast<int>(((slope * blockSize * blockSize) / bins) + 0.5);
+  const std::vector<int> cs = blockCenters(I1.getWidth(), blockRadius);
+  const std::vector<int> rs = blockCenters(I1.getHeight(), blockRadius);
+  const int nc = static_cast<int>(cs.size()), nr = static_cast<int>(rs.size());
+  I2.resize(I1.getHeight(), I1.getWidth());
+  for (int r = 0; r <= nr; ++r) {
+    const int r0 = std::max<int>(0, r - 1), r1 = std::min<int>(nr - 1, r);
+    const int yMin = (r == 0) ? 0 : rs[r0], yMax = (r < nr) ? rs[r1] : static_cast<int>(I1.getHeight());
+    for (int c = 0; c <= nc; ++c) {
+      const int c0 = std::max<int>(0, c - 1), c1 = std::min<int>(nc - 1, c);
+      const int xMin = (c == 0) ? 0 : cs[c0], xMax = (c < nc) ? cs[c1] : static_cast<int>(I1.getWidth());
+      const std::vector<float> tl = blockTransfer(I1, cs[c0], rs[r0], blockRadius, bins, limit);
+      const std::vector<float> tr = blockTransfer(I1, cs[c1], rs[r0], blockRadius, bins, limit);
+      const std::vector<float> bl = blockTransfer(I1, cs[c0], rs[r1], blockRadius, bins, limit);
+      const std::vector<float> br = blockTransfer(I1, cs[c1], rs[r1], blockRadius, bins, limit);
+      for (int y = yMin; y < yMax; ++y) {
+        const float wy = static_cast<float>(rs[r1] - y) / (rs[r1] - rs[r0]);
+        for (int x = xMin; x < xMax; ++x) {
+          const float wx = static_cast<float>(cs[c1] - x) / (cs[c1] - cs[c0]);
+          const int v = roundBin(I1[y][x], bins);
+          const float t0 = (c0 == c1) ? tl[v] : ((wx * tl[v]) + ((1.0f - wx) * tr[v]));
+          const float t1 = (c0 == c1) ? bl[v] : ((wx * bl[v]) + ((1.0f - wx) * br[v]));
+          const float t = (r0 == r1) ? t0 : ((wy * t0) + ((1.0f - wy) * t1));
+          const int value = static_cast<int>((t * 255.0f) + 0.5f);
+          I2[y][x] = static_cast<unsigned char>(std::max<int>(0, std::min<int>(255, value)));
+        }
+      }
+    }
+  }
+}
+
+// Smooth illumination with texture and noise, as a dark image that benefits from contrast enhancement
+void createImage(vpImage<unsigned char> &I, unsigned int height, unsigned int width, long seed)
+{
+  vpUniRand rng(seed);
+  I.resize(height, width);
+  for (unsigned int i = 0; i < height; ++i) {
+    for (unsigned int j = 0; j < width; ++j) {
+      double v = 40.0 + (30.0 * std::sin(i / 23.0) * std::cos(j / 31.0)) + ((30.0 * j) / width) + rng.uniform(0.0, 25.0);
+      I[i][j] = vpMath::saturate<unsigned char>(v);
+    }
+  }
+}
+
+void createImage(vpImage<vpRGBa> &I, unsigned int height, unsigned int width, long seed)
+{
+  vpImage<unsigned char> R, G, B;
+  createImage(R, height, width, seed);
+  createImage(G, height, width, seed + 1);
+  createImage(B, height, width, seed + 2);
+  I.resize(height, width);
+  for (unsigned int i = 0; i < I.getSize(); ++i) {
+    I.bitmap[i] = vpRGBa(R.bitmap[i], G.bitmap[i], B.bitmap[i], 255);
+  }
+}
+
+unsigned int maxAbsDiff(const vpImage<vpRGBa> &I1, const vpImage<vpRGBa> &I2)
+{
+  int maxDiff = 0;
+  for (unsigned int i = 0; i < I1.getSize(); ++i) {
+    maxDiff = std::max<int>(maxDiff, std::abs(I1.bitmap[i].R - I2.bitmap[i].R));
+    maxDiff = std::max<int>(maxDiff, std::abs(I1.bitmap[i].G - I2.bitmap[i].G));
+    maxDiff = std::max<int>(maxDiff, std::abs(I1.bitmap[i].B - I2.bitmap[i].B));
+  }
+  return static_cast<unsigned int>(maxDiff);
+}
+} // namespace
+
+TEST_CASE("CLAHE", "[clahe]")
+{
+  SECTION("Accurate version against reference")
+  {
+    const int radius[] = { 3, 6 };
+    const int bins[] = { 256, 64 };
+    vpImage<unsigned char> I;
+    createImage(I, 61, 83, 1);
+    for (size_t k = 0; k < 2; ++k) {
+      vpImage<unsigned char> I_ref, I_clahe;
+      claheReference(I, I_ref, radius[k], bins[k], 3.0f);
+      for (unsigned int nThreads = 1; nThreads <= 3; ++nThreads) {
+        VISP_NAMESPACE_NAME::clahe(I, I_clahe, radius[k], bins[k], 3.0f, false, nThreads);
+        CHECK(I_clahe == I_ref);
+      }
+    }
+  }
+
+  SECTION("Fast version against reference")
+  {
+    // Image sizes covering the three ways the blocks are laid out: exact fit, one extra pixel, larger remainder
+    const unsigned int sizes[][2] = { { 65, 91 }, { 66, 92 }, { 70, 97 } };
+    const int bins[] = { 256, 64, 256 };
+    for (size_t k = 0; k < 3; ++k) {
+      vpImage<unsigned char> I, I_ref, I_clahe;
+      createImage(I, sizes[k][0], sizes[k][1], static_cast<long>(k) + 10);
+      claheFastReference(I, I_ref, 6, bins[k], 3.0f);
+      VISP_NAMESPACE_NAME::clahe(I, I_clahe, 6, bins[k], 3.0f, true, 2);
+      CHECK(I_clahe == I_ref);
+    }
+  }
+
+  SECTION("Fast version independent of the number of threads")
+  {
+    const unsigned int sizes[][2] = { { 240, 320 }, { 97, 211 }, { 100, 303 } };
+    const int radius[] = { 20, 7, 16 };
+    for (size_t k = 0; k < 3; ++k) {
+      vpImage<unsigned char> I, I_ref, I_clahe;
+      createImage(I, sizes[k][0], sizes[k][1], static_cast<long>(k));
+      VISP_NAMESPACE_NAME::clahe(I, I_ref, radius[k], 256, 3.0f, true, 1);
+      for (unsigned int nThreads = 0; nThreads <= 4; ++nThreads) {
+        VISP_NAMESPACE_NAME::clahe(I, I_clahe, radius[k], 256, 3.0f, true, nThreads);
+        CHECK(I_clahe == I_ref);
+      }
+
+      // The fast version interpolates the transfer functions of the blocks: it stays close to the accurate one
+      vpImage<unsigned char> I_accurate;
+      VISP_NAMESPACE_NAME::clahe(I, I_accurate, radius[k], 256, 3.0f, false);
+      double meanDiff = 0.0;
+      for (unsigned int i = 0; i < I.getSize(); ++i) {
+        meanDiff += std::abs(I_ref.bitmap[i] - I_accurate.bitmap[i]);
+      }
+      meanDiff /= I.getSize();
+      CHECK(meanDiff < 20.0);
+    }
+  }
+
+  SECTION("Color image processed channel by channel")
+  {
+    vpImage<vpRGBa> I, I_clahe;
+    createImage(I, 120, 160, 3);
+    vpImage<unsigned char> R(I.getHeight(), I.getWidth()), R_clahe;
+    vpImageConvert::split(I, &R, nullptr, nullptr);
+    VISP_NAMESPACE_NAME::clahe(I, I_clahe, 15, 256, 3.0f, true, 2);
+    VISP_NAMESPACE_NAME::clahe(R, R_clahe, 15, 256, 3.0f, true, 1);
+    bool sameRed = true;
+    for (unsigned int i = 0; i < I.getSize(); ++i) {
+      sameRed = sameRed && (I_clahe.bitmap[i].R == R_clahe.bitmap[i]) && (I_clahe.bitmap[i].A == I.bitmap[i].A);
+    }
+    CHECK(sameRed);
+  }
+}
+
+TEST_CASE("Retinex", "[retinex]")
+{
+  SECTION("Independent of the number of threads")
+  {
+    vpImage<vpRGBa> I, I_ref, I_retinex;
+    createImage(I, 120, 160, 5);
+    const int kernelSizes[] = { -1, 31 };
+    for (size_t k = 0; k < 2; ++k) {
+      VISP_NAMESPACE_NAME::retinex(I, I_ref, 240, 3, VISP_NAMESPACE_NAME::RETINEX_UNIFORM, 1.2, kernelSizes[k], 1);
+      for (unsigned int nThreads = 0; nThreads <= 3; ++nThreads) {
+        VISP_NAMESPACE_NAME::retinex(I, I_retinex, 240, 3, VISP_NAMESPACE_NAME::RETINEX_UNIFORM, 1.2, kernelSizes[k],
+                                     nThreads);
+        // The statistics used for the dynamic range are reduced in a different order
+        CHECK(maxAbsDiff(I_retinex, I_ref) <= 1);
+      }
+    }
+  }
+
+  SECTION("Uniform image")
+  {
+    vpImage<vpRGBa> I(90, 130, vpRGBa(70, 70, 70, 255)), I_retinex;
+    for (int scaleDiv = 1; scaleDiv <= 4; ++scaleDiv) {
+      VISP_NAMESPACE_NAME::retinex(I, I_retinex, 240, scaleDiv);
+      bool uniform = true;
+      for (unsigned int i = 0; i < I_retinex.getSize(); ++i) {
+        uniform = uniform && (I_retinex.bitmap[i] == I_retinex.bitmap[0]);
+      }
+      CHECK(uniform);
+    }
+  }
+
+  SECTION("Saturated image")
+  {
+    // White and near-white pixels use the largest logarithms of the sum of the channels
+    vpImage<vpRGBa> I(90, 130, vpRGBa(255, 255, 255, 255)), I_retinex;
+    VISP_NAMESPACE_NAME::retinex(I, I_retinex);
+    bool uniform = true;
+    for (unsigned int i = 0; i < I_retinex.getSize(); ++i) {
+      uniform = uniform && (I_retinex.bitmap[i] == I_retinex.bitmap[0]);
+    }
+    CHECK(uniform);
+
+    vpUniRand rng(11);
+    for (unsigned int i = 0; i < I.getSize(); ++i) {
+      I.bitmap[i] = vpRGBa(static_cast<unsigned char>(rng.uniform(250, 256)),
+                           static_cast<unsigned char>(rng.uniform(250, 256)),
+                           static_cast<unsigned char>(rng.uniform(250, 256)), 255);
+    }
+    vpImage<vpRGBa> I_ref;
+    VISP_NAMESPACE_NAME::retinex(I, I_ref, 240, 3, VISP_NAMESPACE_NAME::RETINEX_UNIFORM, 1.2, -1, 1);
+    for (unsigned int nThreads = 2; nThreads <= 3; ++nThreads) {
+      VISP_NAMESPACE_NAME::retinex(I, I_retinex, 240, 3, VISP_NAMESPACE_NAME::RETINEX_UNIFORM, 1.2, -1, nThreads);
+      CHECK(maxAbsDiff(I_retinex, I_ref) <= 1);
+    }
+  }
+
+  SECTION("Contrast of a dark image is enhanced")
+  {
+    vpImage<vpRGBa> I, I_retinex;
+    createImage(I, 120, 160, 7);
+    VISP_NAMESPACE_NAME::retinex(I, I_retinex);
+    double mean = 0.0, mean_retinex = 0.0;
+    for (unsigned int i = 0; i < I.getSize(); ++i) {
+      mean += I.bitmap[i].G;
+      mean_retinex += I_retinex.bitmap[i].G;
+    }
+    CHECK(mean_retinex > mean);
+  }
+}
+
+TEST_CASE("CLAHE and Retinex benchmark", "[benchmark]")
+{
+  if (runBenchmark) {
+    vpImage<unsigned char> I, I_clahe;
+    createImage(I, 1080, 1920, 11);
+    vpImage<vpRGBa> I_color, I_color_res;
+    createImage(I_color, 1080, 1920, 13);
+
+    BENCHMARK("Benchmark fast CLAHE on a 1080p gray image, 1 thread")
+    {
+      VISP_NAMESPACE_NAME::clahe(I, I_clahe, 150, 256, 3.0f, true, 1);
+      return I_clahe;
+    };
+
+    BENCHMARK("Benchmark fast CLAHE on a 1080p gray image")
+    {
+      VISP_NAMESPACE_NAME::clahe(I, I_clahe, 150, 256, 3.0f, true);
+      return I_clahe;
+    };
+
+    BENCHMARK("Benchmark fast CLAHE on a 1080p color image")
+    {
+      VISP_NAMESPACE_NAME::clahe(I_color, I_color_res, 150, 256, 3.0f, true);
+      return I_color_res;
+    };
+
+    BENCHMARK("Benchmark Retinex on a 1080p color image, 1 thread")
+    {
+      VISP_NAMESPACE_NAME::retinex(I_color, I_color_res, 240, 3, VISP_NAMESPACE_NAME::RETINEX_UNIFORM, 1.2, -1, 1);
+      return I_color_res;
+    };
+
+    BENCHMARK("Benchmark Retinex on a 1080p color image")
+    {
+      VISP_NAMESPACE_NAME::retinex(I_color, I_color_res);
+      return I_color_res;
+    };
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session;
+
+  auto cli = session.cli()         // Get Catch's composite command line parser
+    | Catch::Clara::Opt(runBenchmark)   // bind variable to a new option, with a hint string
+    ["--benchmark"] // the option names it will respond to
+    ("run benchmark of CLAHE and Retinex"); // description string for the help output
+
+  // Now pass the new composite back to Catch so it uses that
+  session.cli(cli);
+  session.applyCommandLine(argc, argv);
+  int numFailed = session.run();
+  return numFailed;
+}
+#else
+int main() { return EXIT_SUCCESS; }
+#endif
@@ -0,0 +1,300 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2024 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ *
+ * Description:
+ * Test and benchmark connected components labelling.
+ */
+
+/*!
+  \example catchConnectedComponents.cpp
+
+  \brief Test and benchmark connected components labelling.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2)
+
+#include <algorithm>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include <catch_amalgamated.hpp>
+#include <visp3/core/vpUniRand.h>
+#include <visp3/imgproc/vpImgproc.h>
+
+#if defined(VISP_HAVE_OPENMP)
+#include <omp.h>
+#endif
+
+#ifdef ENABLE_VISP_NAMESPACE
+using namespace VISP_NAMESPACE_NAME;
+#endif
+
+static bool runBenchmark = false;
+
+namespace
+{
+// Reference labelling with a flood fill started from each unlabelled pixel in raster order
+int labelReference(const vpImage<unsigned char> &I, vpImage<int> &labels, bool connexity8)
+{
+  const int height = static_cast<int>(I.getHeight()), width = static_cast<int>(I.getWidth());
+  labels.resize(I.getHeight(), I.getWidth(), 0);
+  int nbComponents = 0;
+  for (int i = 0; i < height; ++i) {
+    for (int j = 0; j < width; ++j) {
+      if ((I[i][j] != 0) && (labels[i][j] == 0)) {
+        ++nbComponents;
+        std::queue<std::pair<int, int> > queue;
+        queue.push(std::make_pair(i, j));
+        labels[i][j] = nbComponents;
+        while (!queue.empty()) {
+          std::pair<int, int> p = queue.front();
+          queue.pop();
+          for (int di = -1; di <= 1; ++di) {
+            for (int dj = -1; dj <= 1; ++dj) {
+              int v = p.first + di, u = p.second + dj;
+              bool neighbor = connexity8 ? ((di != 0) || (dj != 0)) : ((di == 0) != (dj == 0));
+              if (neighbor && (v >= 0) && (v < height) && (u >= 0) && (u < width) && (labels[v][u] == 0) &&
+                  (I[v][u] == I[p.first][p.second])) {
+                labels[v][u] = nbComponents;
+                queue.push(std::make_pair(v, u));
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+  return nbComponents;
+}
+
+// Random blobs on a noisy background, that give components with holes, spirals and diagonal links
+void createImage(vpImage<unsigned char> &I, unsigned int height, unsigned int width, unsigned int nbValues,
+                 long seed)
+{
+  vpUniRand rng(seed);
+  I.resize(height, width, 0);
+  for (unsigned int n = 0; n < (height * width) / 200; ++n) {
+    int i0 = rng.uniform(0, static_cast<int>(height)), j0 = rng.uniform(0, static_cast<int>(width));
+    int r = rng.uniform(1, 12);
+    unsigned char value = static_cast<unsigned char>(rng.uniform(1, static_cast<int>(nbValues) + 1));
+    for (int i = std::max<int>(0, i0 - r); i < std::min<int>(static_cast<int>(height), i0 + r); ++i) {
+      for (int j = std::max<int>(0, j0 - r); j < std::min<int>(static_cast<int>(width), j0 + r); ++j) {
+        if (((i - i0) * (i - i0)) + ((j - j0) * (j - j0)) < (r * r)) {
+          I[i][j] = value;
+        }
+      }
+    }
+  }
+  for (unsigned int n = 0; n < (height * width) / 20; ++n) {
+    I[rng.uniform(0, static_cast<int>(height))][rng.uniform(0, static_cast<int>(width))] =
+      static_cast<unsigned char>(rng.uniform(0, static_cast<int>(nbValues) + 1));
+  }
+}
+} // namespace
+
+TEST_CASE("Connected components labelling", "[connected_components]")
+{
+  const vpImageMorphology::vpConnexityType connexities[2] = { vpImageMorphology::CONNEXITY_4,
+                                                               vpImageMorphology::CONNEXITY_8 };
+  const unsigned int nbValues[2] = { 1, 3 };
+  for (unsigned int c = 0; c < 2; ++c) {
+    for (unsigned int v = 0; v < 2; ++v) {
+      vpImage<unsigned char> I;
+      createImage(I, 301, 257, nbValues[v], 42 + v);
+
+      vpImage<int> labels_ref;
+      const int nbComponents_ref = labelReference(I, labels_ref, connexities[c] == vpImageMorphology::CONNEXITY_8);
+      REQUIRE(nbComponents_ref > 100);
+
+#if defined(VISP_HAVE_OPENMP)
+      const int nbThreads = omp_get_max_threads();
+      for (int t = 1; t <= 8; t *= 2) {
+        omp_set_num_threads(t);
+#endif
+        vpImage<int> labels;
+        int nbComponents = 0;
+        VISP_NAMESPACE_NAME::connectedComponents(I, labels, nbComponents, connexities[c]);
+        CHECK(nbComponents == nbComponents_ref);
+        CHECK((labels == labels_ref));
+
+        std::vector<VISP_NAMESPACE_NAME::vpConnectedComponentStats> stats;
+        VISP_NAMESPACE_NAME::connectedComponents(I, labels, nbComponents, stats, connexities[c]);
+        CHECK((labels == labels_ref));
+        REQUIRE(stats.size() == static_cast<size_t>(nbComponents_ref));
+
+        std::vector<unsigned int> area(stats.size(), 0);
+        std::vector<double> sum_i(stats.size(), 0.), sum_j(stats.size(), 0.);
+        std::vector<unsigned int> top(stats.size()), left(stats.size()), bottom(stats.size()), right(stats.size());
+        for (unsigned int i = 0; i < I.getHeight(); ++i) {
+          for (unsigned int j = 0; j < I.getWidth(); ++j) {
+            if (labels_ref[i][j] != 0) {
+              const size_t k = static_cast<size_t>(labels_ref[i][j] - 1);
+              top[k] = (area[k] == 0) ? i : std::min<unsigned int>(top[k], i);
+              left[k] = (area[k] == 0) ? j : std::min<unsigned int>(left[k], j);
+              bottom[k] = (area[k] == 0) ? i : std::max<unsigned int>(bottom[k], i);
+              right[k] = (area[k] == 0) ? j : std::max<unsigned int>(right[k], j);
+              ++area[k];
+              sum_i[k] += i;
+              sum_j[k] += j;
+            }
+          }
+        }
+        bool stats_ok = true;
+        for (size_t k = 0; k < stats.size(); ++k) {
+          stats_ok = stats_ok && (stats[k].area == area[k]) &&
+            (stats[k].bbox == vpRect(vpImagePoint(top[k], left[k]), vpImagePoint(bottom[k], right[k]))) &&
+            (vpImagePoint::distance(stats[k].cog, vpImagePoint(sum_i[k] / area[k], sum_j[k] / area[k])) < 1e-9);
+        }
+        CHECK(stats_ok);
+#if defined(VISP_HAVE_OPENMP)
+      }
+      omp_set_num_threads(nbThreads);
+#endif
+    }
+  }
+}
+
+TEST_CASE("Connected components spanning every strip", "[connected_components]")
+{
+  // A comb whose teeth start in several row strips and are joined by the last row, so that it spans every strip
+  vpImage<unsigned char> I;
+  createImage(I, 300, 200, 2, 7);
+  for (unsigned int i = 0; i < I.getHeight(); ++i) {
+    for (unsigned int j = 0; j < I.getWidth(); j += 10) {
+      I[i][j] = (i >= (j % 290)) ? 3 : 0;
+    }
+  }
+  for (unsigned int j = 0; j < I.getWidth(); ++j) {
+    I[I.getHeight() - 1][j] = 3;
+  }
+
+  vpImage<int> labels_ref;
+  const int nbComponents_ref = labelReference(I, labels_ref, true);
+
+#if defined(VISP_HAVE_OPENMP)
+  const int nbThreads = omp_get_max_threads();
+  omp_set_num_threads(8);
+#endif
+  vpImage<int> labels;
+  int nbComponents = 0;
+  std::vector<VISP_NAMESPACE_NAME::vpConnectedComponentStats> stats;
+  VISP_NAMESPACE_NAME::connectedComponents(I, labels, nbComponents, stats, vpImageMorphology::CONNEXITY_8);
+#if defined(VISP_HAVE_OPENMP)
+  omp_set_num_threads(nbThreads);
+#endif
+  CHECK(nbComponents == nbComponents_ref);
+  CHECK((labels == labels_ref));
+  REQUIRE(stats.size() == static_cast<size_t>(nbComponents_ref));
+
+  std::vector<unsigned int> area(stats.size(), 0);
+  for (unsigned int i = 0; i < I.getHeight(); ++i) {
+    for (unsigned int j = 0; j < I.getWidth(); ++j) {
+      if (labels_ref[i][j] != 0) {
+        ++area[static_cast<size_t>(labels_ref[i][j] - 1)];
+      }
+    }
+  }
+  bool area_ok = true;
+  for (size_t k = 0; k < stats.size(); ++k) {
+    area_ok = area_ok && (stats[k].area == area[k]);
+  }
+  CHECK(area_ok);
+  const int comb = labels_ref[I.getHeight() - 1][0];
+  CHECK(stats[comb - 1].bbox == vpRect(vpImagePoint(0, 0), vpImagePoint(I.getHeight() - 1, I.getWidth() - 1)));
+}
+
+TEST_CASE("Connected components of an empty image", "[connected_components]")
+{
+  vpImage<unsigned char> I(20, 30, 0);
+  vpImage<int> labels;
+  int nbComponents = -1;
+  std::vector<VISP_NAMESPACE_NAME::vpConnectedComponentStats> stats(3);
+  VISP_NAMESPACE_NAME::connectedComponents(I, labels, nbComponents, stats);
+  CHECK(nbComponents == 0);
+  CHECK(stats.empty());
+  CHECK((labels == vpImage<int>(20, 30, 0)));
+}
+
+TEST_CASE("Connected components benchmark", "[connected_components]")
+{
+  if (runBenchmark) {
+    vpImage<unsigned char> I;
+    createImage(I, 2160, 3840, 1, 7);
+    vpImage<int> labels;
+    int nbComponents = 0;
+
+    BENCHMARK("Benchmark 4-connexity labelling of a 4K mask")
+    {
+      VISP_NAMESPACE_NAME::connectedComponents(I, labels, nbComponents, vpImageMorphology::CONNEXITY_4);
+      return nbComponents;
+    };
+
+    BENCHMARK("Benchmark 8-connexity labelling of a 4K mask")
+    {
+      VISP_NAMESPACE_NAME::connectedComponents(I, labels, nbComponents, vpImageMorphology::CONNEXITY_8);
+      return nbComponents;
+    };
+
+    std::vector<VISP_NAMESPACE_NAME::vpConnectedComponentStats> stats;
+    BENCHMARK("Benchmark 8-connexity labelling of a 4K mask with statistics")
+    {
+      VISP_NAMESPACE_NAME::connectedComponents(I, labels, nbComponents, stats, vpImageMorphology::CONNEXITY_8);
+      return nbComponents;
+    };
+
+    vpImage<int> labels_ref;
+    BENCHMARK("Benchmark 8-connexity labelling of a 4K mask with flood fill")
+    {
+      return labelReference(I, labels_ref, true);
+    };
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session;
+
+  auto cli = session.cli()         // Get Catch's composite command line parser
+    | Catch::Clara::Opt(runBenchmark)   // bind variable to a new option, with a hint string
+    ["--benchmark"] // the option names it will respond to
+    ("run benchmark of connected components labelling"); // description string for the help output
+
+  // Now pass the new composite back to Catch so it uses that
+  session.cli(cli);
+  session.applyCommandLine(argc, argv);
+  int numFailed = session.run();
+  return numFailed;
+}
+#else
+int main() { return EXIT_SUCCESS; }
+#endif
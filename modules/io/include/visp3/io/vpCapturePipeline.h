@@ -0,0 +1,497 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2024 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ *
+ * Description:
+ * Multi-stage asynchronous capture pipeline.
+ */
+
+/*!
+ * \file vpCapturePipeline.h
+ * \brief Multi-stage asynchronous capture pipeline.
+ */
+
+#ifndef VP_CAPTURE_PIPELINE_H
+#define VP_CAPTURE_PIPELINE_H
+
+#include <visp3/core/vpConfig.h>
+
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11) && defined(VISP_HAVE_THREADS)
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <visp3/core/vpException.h>
+#include <visp3/core/vpTime.h>
+#include <visp3/io/vpRingBuffer.h>
+
+BEGIN_VISP_NAMESPACE
+/*!
+  \class vpCapturePipeline
+
+  \ingroup group_io_image
+
+  \brief Run image acquisition and the processing stages that follow it
+  (color conversion, tracking, recording...) concurrently, each one in its
+  own thread.
+
+  In a classical loop, acquisition, conversion, tracking and display are
+  serialized, so that the camera idles while the tracker runs and vice
+  versa. With this class, while stage \e k processes frame \e n, stage \e k-1
+  already processes frame \e n+1.
+
+  A frame is an instance of the user-defined \e Frame type that holds all
+  the data exchanged between stages (grabbed image, converted image, pose,
+  timestamp...). A fixed pool of frames is allocated at construction and
+  recycled, so that no allocation happens once every member of the frames
+  has reached its final size. Frames are passed from one stage to the next
+  through lock-free single-producer / single-consumer queues (see
+  vpRingBuffer).
+
+  Two policies are available when a stage is slower than the camera:
+  - vpCapturePipeline::LOSSLESS: every acquired frame is processed by all the
+    stages. The acquisition waits for a free frame, which provides
+    backpressure on the grabber.
+  - vpCapturePipeline::LATEST_ONLY: the acquisition never waits. When no
+    frame is free, the last acquired frame is overwritten by the next one.
+    Each stage only processes the most recent frame in its input queue, older
+    ones are forwarded as dropped to keep frames in order and are skipped by
+    the following stages.
+
+  Processing time, end-to-end latency and number of dropped frames are
+  measured for each stage, see getStatistics().
+
+  \code
+  #include <visp3/core/vpImageConvert.h>
+  #include <visp3/io/vpCapturePipeline.h>
+  #include <visp3/sensor/vpV4l2Grabber.h>
+
+  #ifdef ENABLE_VISP_NAMESPACE
+  using namespace VISP_NAMESPACE_NAME;
+  #endif
+
+  struct Frame
+  {
+    vpImage<vpRGBa> I_color;
+    vpImage<unsigned char> I;
+  };
+
+  int main()
+  {
+    vpV4l2Grabber g;
+    vpCapturePipeline<Frame> pipeline(4, vpCapturePipeline<Frame>::LATEST_ONLY);
+    pipeline.setAcquisition("acquire", [&](Frame &f) { g.acquire(f.I_color); return true; });
+    pipeline.addStage("convert", [](Frame &f) { vpImageConvert::convert(f.I_color, f.I); });
+    pipeline.addStage("track", [&](Frame &f) { tracker.track(f.I); });
+    pipeline.start();
+    // ...
+    pipeline.stop();
+    std::vector<vpCapturePipeline<Frame>::vpStageStatistics> stats = pipeline.getStatistics();
+  }
+  \endcode
+*/
+template <class Frame> class vpCapturePipeline
+{
+public:
+  /*!
+    Behavior when a stage is slower than the acquisition.
+  */
+  typedef enum
+  {
+    LOSSLESS,   //!< All the acquired frames are processed, acquisition waits for a free frame
+    LATEST_ONLY //!< Acquisition never waits, stages only process the most recent frame
+  } vpDropPolicy;
+
+  /*!
+    Statistics of a stage. Times are expressed in milliseconds.
+  */
+  struct vpStageStatistics
+  {
+    vpStageStatistics()
+      : name(), nbProcessed(0), nbDropped(0), meanProcessingTime(0.), maxProcessingTime(0.), meanLatency(0.),
+      maxLatency(0.)
+    { }
+
+    std::string name;          //!< Name of the stage
+    unsigned int nbProcessed;  //!< Number of frames processed by the stage
+    unsigned int nbDropped;    //!< Number of frames dropped by the stage
+    double meanProcessingTime; //!< Mean time spent in the stage function
+    double maxProcessingTime;  //!< Max time spent in the stage function
+    double meanLatency;        //!< Mean time between the beginning of the acquisition and the end of the stage
+    double maxLatency;         //!< Max time between the beginning of the acquisition and the end of the stage
+  };
+
+  /*!
+    Build a pipeline.
+
+    \param nbFrames : Number of frames in the pool, that is the maximum number
+    of frames being acquired or processed at the same time. Should be at least 2.
+    \param policy : Behavior when a stage is slower than the acquisition.
+
+    \exception vpException::badValue If \e nbFrames is lower than 2.
+  */
+  explicit vpCapturePipeline(unsigned int nbFrames = 4, vpDropPolicy policy = LOSSLESS)
+    : m_slots(nbFrames), m_freeSlots(nbFrames), m_stages(), m_threads(), m_policy(policy), m_stop(false),
+    m_running(false), m_failed(false), m_errorMutex(), m_error()
+  {
+    if (nbFrames < 2) {
+      throw(vpException(vpException::badValue, "Capture pipeline needs at least 2 frames, not %d", nbFrames));
+    }
+    for (unsigned int i = 0; i < nbFrames; ++i) {
+      m_freeSlots.tryPush(i);
+    }
+    m_stages.push_back(std::unique_ptr<vpStage>(new vpStage("acquisition", nbFrames)));
+  }
+
+  /*!
+    Destructor that stops the pipeline.
+  */
+  virtual ~vpCapturePipeline()
+  {
+    m_stop = true;
+    join();
+  }
+
+  /*!
+    Add a stage after the existing ones. The function \e process is called
+    in the stage thread with the frame to process.
+
+    \exception vpException::fatalError If the pipeline is running.
+  */
+  void addStage(const std::string &name, const std::function<void(Frame &)> &process)
+  {
+    checkNotRunning();
+    m_stages.push_back(std::unique_ptr<vpStage>(new vpStage(name, static_cast<unsigned int>(m_slots.size()))));
+    m_stages.back()->process = process;
+  }
+
+  /*!
+    Return the frame drop policy.
+  */
+  vpDropPolicy getDropPolicy() const { return m_policy; }
+
+  /*!
+    Return the statistics of the acquisition, in first position, and of each
+    stage in the order they were added. Can be called while the pipeline is
+    running.
+  */
+  std::vector<vpStageStatistics> getStatistics() const
+  {
+    std::vector<vpStageStatistics> stats;
+    for (size_t k = 0; k < m_stages.size(); ++k) {
+      std::lock_guard<std::mutex> lock(m_stages[k]->mutex);
+      stats.push_back(m_stages[k]->stats);
+    }
+    return stats;
+  }
+
+  /*!
+    Return true between start() and the end of the processing of the last
+    frame.
+  */
+  bool isRunning() const { return m_running && !m_stages.back()->done; }
+
+  /*!
+    Set the acquisition function, called in the acquisition thread with the
+    frame to fill. The pipeline ends when it returns false.
+
+    \exception vpException::fatalError If the pipeline is running.
+  */
+  void setAcquisition(const std::string &name, const std::function<bool(Frame &)> &acquire)
+  {
+    checkNotRunning();
+    m_stages.front()->stats.name = name;
+    m_acquire = acquire;
+  }
+
+  /*!
+    Start the acquisition and stage threads.
+
+    \exception vpException::fatalError If the pipeline is already running or
+    if no acquisition function is set.
+  */
+  void start()
+  {
+    checkNotRunning();
+    if (!m_acquire) {
+      throw(vpException(vpException::fatalError, "Cannot start a capture pipeline without acquisition function"));
+    }
+    m_stop = false;
+    m_running = true;
+    m_failed = false;
+    m_error.clear();
+    for (size_t k = 0; k < m_stages.size(); ++k) {
+      m_stages[k]->done = false;
+    }
+    m_threads.push_back(std::thread(&vpCapturePipeline::runAcquisition, this));
+    for (size_t k = 1; k < m_stages.size(); ++k) {
+      m_threads.push_back(std::thread(&vpCapturePipeline::runStage, this, k));
+    }
+  }
+
+  /*!
+    Stop the acquisition and wait until all the acquired frames are
+    processed.
+
+    \exception vpException::fatalError If a stage threw an exception.
+  */
+  void stop()
+  {
+    m_stop = true;
+    wait();
+  }
+
+  /*!
+    Wait until the acquisition function returns false and all the acquired
+    frames are processed.
+
+    \exception vpException::fatalError If a stage threw an exception.
+  */
+  void wait()
+  {
+    join();
+    std::lock_guard<std::mutex> lock(m_errorMutex);
+    if (!m_error.empty()) {
+      std::string error = m_error;
+      m_error.clear();
+      throw(vpException(vpException::fatalError, "Capture pipeline stopped: %s", error.c_str()));
+    }
+  }
+
+private:
+  //! A frame of the pool with the information needed to follow it along the pipeline
+  struct vpSlot
+  {
+    vpSlot() : frame(), t_acquisition(0.), dropped(false) { }
+
+    Frame frame;
+    double t_acquisition;
+    bool dropped;
+  };
+
+  //! A stage with its input queue
+  struct vpStage
+  {
+    vpStage(const std::string &name, unsigned int nbFrames) : process(), input(nbFrames), done(false), mutex(), stats()
+    {
+      stats.name = name;
+    }
+
+    std::function<void(Frame &)> process;
+    vpRingBuffer<unsigned int> input; //!< Frames to process, large enough to hold all the frames
+    std::atomic<bool> done;           //!< Set when the stage processed its last frame
+    mutable std::mutex mutex;         //!< Protects statistics
+    vpStageStatistics stats;
+  };
+
+  void checkNotRunning() const
+  {
+    if (m_running) {
+      throw(vpException(vpException::fatalError, "Capture pipeline is running"));
+    }
+  }
+
+  // Pass a frame to the next stage, or give it back to the acquisition after the last stage
+  void forward(size_t k, unsigned int slot)
+  {
+    if ((k + 1) < m_stages.size()) {
+      m_stages[k + 1]->input.tryPush(slot);
+    }
+    else {
+      m_freeSlots.tryPush(slot);
+    }
+  }
+
+  void join()
+  {
+    for (size_t k = 0; k < m_threads.size(); ++k) {
+      if (m_threads[k].joinable()) {
+        m_threads[k].join();
+      }
+    }
+    m_threads.clear();
+    m_running = false;
+  }
+
+  void setError(const std::string &stage, const std::string &message)
+  {
+    std::lock_guard<std::mutex> lock(m_errorMutex);
+    if (m_error.empty()) {
+      m_error = stage + ": " + message;
+    }
+    m_failed = true;
+    m_stop = true;
+  }
+
+  void updateStatistics(vpStage &stage, double t_acquisition, double t_start, bool dropped)
+  {
+    const double t_end = vpTime::measureTimeMs();
+    std::lock_guard<std::mutex> lock(stage.mutex);
+    vpStageStatistics &stats = stage.stats;
+    if (dropped) {
+      ++stats.nbDropped;
+      return;
+    }
+    const double processingTime = t_end - t_start;
+    const double latency = t_end - t_acquisition;
+    ++stats.nbProcessed;
+    stats.meanProcessingTime += (processingTime - stats.meanProcessingTime) / stats.nbProcessed;
+    stats.maxProcessingTime = std::max<double>(stats.maxProcessingTime, processingTime);
+    stats.meanLatency += (latency - stats.meanLatency) / stats.nbProcessed;
+    stats.maxLatency = std::max<double>(stats.maxLatency, latency);
+  }
+
+  // Wait a little when a queue is empty, without burning a core
+  static void backoff(unsigned int &nbTries)
+  {
+    if (++nbTries < 64) {
+      std::this_thread::yield();
+    }
+    else {
+      std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+  }
+
+  void runAcquisition()
+  {
+    vpStage &stage = *m_stages.front();
+    unsigned int slot = 0;
+    unsigned int nbTries = 0;
+    bool hasSlot = false;
+    try {
+      while (!m_stop) {
+        if (!hasSlot) {
+          hasSlot = m_freeSlots.tryPop(slot);
+          if (!hasSlot) {
+            backoff(nbTries);
+            continue;
+          }
+        }
+        nbTries = 0;
+
+        vpSlot &s = m_slots[slot];
+        s.t_acquisition = vpTime::measureTimeMs();
+        s.dropped = false;
+        if (!m_acquire(s.frame)) {
+          break;
+        }
+
+        unsigned int next = 0;
+        if ((m_policy == LOSSLESS) || m_freeSlots.tryPop(next)) {
+          updateStatistics(stage, s.t_acquisition, s.t_acquisition, false);
+          forward(0, slot);
+          hasSlot = (m_policy == LATEST_ONLY);
+          slot = next;
+        }
+        else {
+          // No free frame: the next acquisition overwrites this one
+          updateStatistics(stage, s.t_acquisition, s.t_acquisition, true);
+        }
+      }
+    }
+    catch (const std::exception &e) {
+      setError(stage.stats.name, e.what());
+    }
+    // Give back the frame held by the acquisition, so that the pool is complete when the pipeline is restarted
+    if (hasSlot) {
+      m_freeSlots.tryPush(slot);
+    }
+    stage.done = true;
+  }
+
+  void runStage(size_t k)
+  {
+    vpStage &stage = *m_stages[k];
+    const vpStage &previous = *m_stages[k - 1];
+    unsigned int nbTries = 0;
+    for (;;) {
+      // Read the upstream state before the queue, so that no frame can be missed
+      const bool previousDone = previous.done;
+      unsigned int slot;
+      if (!stage.input.tryPop(slot)) {
+        if (previousDone) {
+          break;
+        }
+        backoff(nbTries);
+        continue;
+      }
+      nbTries = 0;
+
+      if (m_policy == LATEST_ONLY) {
+        unsigned int next;
+        while (stage.input.tryPop(next)) {
+          if (!m_slots[slot].dropped) {
+            m_slots[slot].dropped = true;
+            updateStatistics(stage, 0., 0., true);
+          }
+          forward(k, slot);
+          slot = next;
+        }
+      }
+
+      vpSlot &s = m_slots[slot];
+      // After an error, remaining frames are only given back to the pool
+      if (!s.dropped && !m_failed) {
+        const double t_start = vpTime::measureTimeMs();
+        try {
+          stage.process(s.frame);
+          updateStatistics(stage, s.t_acquisition, t_start, false);
+        }
+        catch (const std::exception &e) {
+          setError(stage.stats.name, e.what());
+        }
+      }
+      forward(k, slot);
+    }
+    stage.done = true;
+  }
+
+  std::vector<vpSlot> m_slots;              //!< Pool of frames
+  vpRingBuffer<unsigned int> m_freeSlots;   //!< Frames that can be filled by the acquisition
+  std::vector<std::unique_ptr<vpStage> > m_stages; //!< Acquisition followed by the processing stages
+  std::vector<std::thread> m_threads;
+  std::function<bool(Frame &)> m_acquire;
+  vpDropPolicy m_policy;
+  std::atomic<bool> m_stop;
+  std::atomic<bool> m_running;
+  std::atomic<bool> m_failed;
+  std::mutex m_errorMutex;
+  std::string m_error;
+};
+END_VISP_NAMESPACE
+#endif
+#endif
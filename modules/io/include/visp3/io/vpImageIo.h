@@ -41,6 +41,7 @@
 
 #include <visp3/core/vpImage.h>
 #include <visp3/core/vpImageConvert.h>
+#include <visp3/core/vpImageView.h>
 
 #include <iostream>
 #include <stdio.h>
@@ -138,6 +139,8 @@ public:
 
   static void write(const vpImage<unsigned char> &I, const std::string &filename, int backend = IO_DEFAULT_BACKEND);
   static void write(const vpImage<vpRGBa> &I, const std::string &filename, int backend = IO_DEFAULT_BACKEND);
+  static void write(const vpImageView<unsigned char> &I, const std::string &filename, int backend = IO_DEFAULT_BACKEND);
+  static void write(const vpImageView<vpRGBa> &I, const std::string &filename, int backend = IO_DEFAULT_BACKEND);
 
   static void readPFM(vpImage<float> &I, const std::string &filename);
   static void readPFM_HDR(vpImage<float> &I, const std::string &filename);
@@ -176,6 +179,9 @@ public:
 
   static void writePNG(const vpImage<unsigned char> &I, const std::string &filename, int backend = IO_DEFAULT_BACKEND);
   static void writePNG(const vpImage<vpRGBa> &I, const std::string &filename, int backend = IO_DEFAULT_BACKEND);
+  static void writePNG(const vpImage<unsigned char> &I, const std::string &filename, int backend,
+                       int compression_level);
+  static void writePNG(const vpImage<vpRGBa> &I, const std::string &filename, int backend, int compression_level);
 
   static void writeEXR(const vpImage<float> &I, const std::string &filename, int backend = IO_DEFAULT_BACKEND);
   static void writeEXR(const vpImage<vpRGBf> &I, const std::string &filename, int backend = IO_DEFAULT_BACKEND);
@@ -38,14 +38,17 @@
 
 #if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11) && defined(VISP_HAVE_THREADS)
 
+#include <algorithm>
+#include <atomic>
 #include <condition_variable>
+#include <memory>
 #include <mutex>
-#include <queue>
 #include <string>
-#include <thread>
+#include <vector>
 
 #include <visp3/core/vpDisplay.h>
 #include <visp3/core/vpIoTools.h>
+#include <visp3/io/vpRingBuffer.h>
 
 BEGIN_VISP_NAMESPACE
 
@@ -60,6 +63,16 @@ BEGIN_VISP_NAMESPACE
 
   This call is to use with vpImageStorageWorker.
 
+  Images are stored in a ring of slots that is allocated when the first image is pushed, from the memory budget set
+  with setMaxMemory() and the size of this image. One producer thread (the grabber) and one consumer thread (the
+  storage worker) can use it at the same time. Images are exchanged without lock, a mutex is only taken to wake up the
+  consumer when it waits for an image. An image can be written in place in a slot using
+  beginPush() / endPush() and read in place using beginPop() / endPop(), avoiding any copy. When all the slots are
+  used, new images are dropped and counted, see getNbDroppedImages().
+
+  \note Former versions dropped the oldest images waiting in the queue when it was full. The newest images are now
+  dropped instead, since only the consumer is allowed to release a slot: the recorded images keep the order in which
+  they were grabbed, but the sequence stops when the queue is full and resumes once the storage worker caught up.
 */
 template <class Type> class vpImageQueue
 {
@@ -68,16 +81,17 @@ public:
   { };
 
   /*!
-   * Queue (FIFO) constructor. By default the max queue size is set to 1024*8.
+   * Queue (FIFO) constructor. By default the memory used by the queue is limited to 512 MB.
    *
    * \param[in] seqname : Generic sequence name like `"folder/I%04d.png"`. If this name contains a parent folder, it
    * will be created.
    * \param[in] record_mode : 0 to record a sequence of images, 1 to record single images.
    */
   vpImageQueue(const std::string &seqname, int record_mode)
-    : m_cancelled(false), m_cond(), m_queue_image(), m_queue_data(), m_maxQueueSize(1024 * 8), m_mutex(),
-    m_seqname(seqname), m_recording_mode(record_mode), m_start_recording(false), m_directory_to_create(false),
-    m_recording_trigger(false)
+    : m_cancelled(false), m_mutex(), m_cond(), m_slots(), m_data(), m_hasData(), m_filledSlots(), m_freeSlots(), m_allocated(false),
+    m_maxQueueSize(1024 * 8), m_maxMemory(512 * 1024 * 1024), m_nbPushed(0), m_nbDropped(0), m_maxOccupancy(0),
+    m_writeSlot(0), m_readSlot(0), m_seqname(seqname), m_recording_mode(record_mode), m_start_recording(false),
+    m_directory_to_create(false), m_recording_trigger(false)
   {
     m_directory = vpIoTools::getParent(seqname);
     if (!m_directory.empty()) {
@@ -90,16 +104,107 @@ public:
   }
 
   /*!
-   * Emit cancel signal.
+   * Emit cancel signal. Images that are already in the queue are still popped.
    */
   void cancel()
   {
-    std::lock_guard<std::mutex> lock(m_mutex);
     std::cout << "Wait to finish saving images..." << std::endl;
     m_cancelled = true;
-    m_cond.notify_all();
+    notify();
   }
 
+  /*!
+   * Producer side. Return a free slot where the next image to record can be written in place, or nullptr when the
+   * queue is full, in which case the image is counted as dropped. The image is queued by endPush().
+   *
+   * \param[in] I : Image used to size the queue when no image was pushed yet.
+   */
+  vpImage<Type> *beginPush(const vpImage<Type> &I)
+  {
+    if (!m_allocated) {
+      allocate(static_cast<size_t>(I.getSize()) * sizeof(Type));
+    }
+    if (!m_freeSlots->tryPop(m_writeSlot)) {
+      m_nbDropped.fetch_add(1, std::memory_order_relaxed);
+      return nullptr;
+    }
+    return &m_slots[m_writeSlot];
+  }
+
+  /*!
+   * Producer side. Queue the image written in the slot returned by beginPush().
+   *
+   * \param[in] data : Data to record with the image, or nullptr.
+   */
+  void endPush(const std::string *data)
+  {
+    m_hasData[m_writeSlot] = (data != nullptr) ? 1 : 0;
+    if (data != nullptr) {
+      m_data[m_writeSlot] = *data;
+    }
+    m_filledSlots->tryPush(m_writeSlot);
+    m_nbPushed.fetch_add(1, std::memory_order_relaxed);
+    // Only the producer updates the occupancy, a load followed by a store is enough
+    const size_t occupancy = m_filledSlots->size();
+    if (occupancy > m_maxOccupancy.load(std::memory_order_relaxed)) {
+      m_maxOccupancy.store(occupancy, std::memory_order_relaxed);
+    }
+    notify();
+  }
+
+  /*!
+   * Consumer side. Wait for an image and return a reference to it, valid until endPop() is called.
+   *
+   * \param[out] data : Data to record. Left unchanged if no data was pushed with the image.
+   *
+   * \exception vpCancelled_t When the queue is empty and cancel() was called.
+   */
+  const vpImage<Type> &beginPop(std::string &data)
+  {
+    if (!(m_allocated && m_filledSlots->tryPop(m_readSlot))) {
+      bool popped = false;
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_cond.wait(lock, [this, &popped] {
+        // Read the cancel flag before the queue, so that no image can be missed
+        const bool cancelled = m_cancelled;
+        popped = m_allocated && m_filledSlots->tryPop(m_readSlot);
+        return popped || cancelled;
+      });
+      if (!popped) {
+        throw vpCancelled_t();
+      }
+    }
+    if (m_hasData[m_readSlot]) {
+      data = m_data[m_readSlot];
+    }
+    return m_slots[m_readSlot];
+  }
+
+  /*!
+   * Consumer side. Give back the slot returned by beginPop() to the producer.
+   */
+  void endPop() { m_freeSlots->tryPush(m_readSlot); }
+
+  /*!
+   * Return the maximum number of images that were waiting in the queue at the same time.
+   */
+  size_t getMaxOccupancy() const { return m_maxOccupancy.load(std::memory_order_relaxed); }
+
+  /*!
+   * Return the number of images that were not recorded because the queue was full.
+   */
+  unsigned int getNbDroppedImages() const { return m_nbDropped.load(std::memory_order_relaxed); }
+
+  /*!
+   * Return the number of images pushed in the queue.
+   */
+  unsigned int getNbPushedImages() const { return m_nbPushed.load(std::memory_order_relaxed); }
+
+  /*!
+   * Return the number of image slots, or 0 if no image was pushed yet.
+   */
+  size_t getNbSlots() const { return m_allocated ? m_slots.size() : 0; }
+
   /*!
    * Return record mode; 0 when recording a sequence of images, 1 when recording recording single imagess.
    */
@@ -124,58 +229,24 @@ public:
    */
   void pop(vpImage<Type> &I, std::string &data)
   {
-    std::unique_lock<std::mutex> lock(m_mutex);
-
-    while (m_queue_image.empty()) {
-      if (m_cancelled) {
-        throw vpCancelled_t();
-      }
-
-      m_cond.wait(lock);
-
-      if (m_cancelled) {
-        throw vpCancelled_t();
-      }
-    }
-
-    I = m_queue_image.front();
-
-    m_queue_image.pop();
-
-    if (!m_queue_data.empty()) {
-      data = m_queue_data.front();
-      m_queue_data.pop();
-    }
+    I = beginPop(data);
+    endPop();
   }
 
   /*!
-   * Push data to save in the queue (FIFO).
+   * Push data to save in the queue (FIFO). The image is dropped when the queue is full, the images already queued are
+   * kept.
    *
    * \param[in] I : Image to record.
    * \param[in] data : Data to record.
    */
   void push(const vpImage<Type> &I, std::string *data)
   {
-    std::lock_guard<std::mutex> lock(m_mutex);
-
-    m_queue_image.push(I);
-
-    if (data != nullptr) {
-      m_queue_data.push(*data);
-    }
-
-    // Pop extra data in the queue
-    while (m_queue_image.size() > m_maxQueueSize) {
-      m_queue_image.pop();
+    vpImage<Type> *slot = beginPush(I);
+    if (slot != nullptr) {
+      *slot = I;
+      endPush(data);
     }
-
-    if (data != nullptr) {
-      while (m_queue_data.size() > m_maxQueueSize) {
-        m_queue_data.pop();
-      }
-    }
-
-    m_cond.notify_one();
   }
 
   /*!
@@ -265,18 +336,62 @@ public:
   }
 
   /*!
-   * Set queue size.
+   * Set the memory budget used to compute the number of image slots when the first image is pushed. Has no effect
+   * once an image was pushed.
+   * \param[in] max_memory : Memory budget in bytes.
+   */
+  void setMaxMemory(size_t max_memory) { m_maxMemory = max_memory; }
+
+  /*!
+   * Set the maximum number of image slots. Has no effect once an image was pushed.
    * \param[in] max_queue_size : Queue size.
    */
   void setMaxQueueSize(const size_t max_queue_size) { m_maxQueueSize = max_queue_size; }
 
 private:
-  bool m_cancelled;
+  // Called by the producer before the first push
+  void allocate(size_t image_size)
+  {
+    size_t nbSlots = (image_size > 0) ? (m_maxMemory / image_size) : m_maxQueueSize;
+    nbSlots = std::max<size_t>(1, std::min<size_t>(nbSlots, m_maxQueueSize));
+    m_slots.resize(nbSlots);
+    m_data.resize(nbSlots);
+    m_hasData.resize(nbSlots, 0);
+    m_filledSlots.reset(new vpRingBuffer<unsigned int>(nbSlots));
+    m_freeSlots.reset(new vpRingBuffer<unsigned int>(nbSlots));
+    for (size_t i = 0; i < nbSlots; ++i) {
+      m_freeSlots->tryPush(static_cast<unsigned int>(i));
+    }
+    // Publish the slots to the consumer
+    m_allocated = true;
+  }
+
+  // Wake up the consumer if it waits in beginPop(). Taking the mutex ensures that it is either waiting or will see
+  // the new state when it checks the queue.
+  void notify()
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+    }
+    m_cond.notify_one();
+  }
+
+  std::atomic<bool> m_cancelled;
+  std::mutex m_mutex;
   std::condition_variable m_cond;
-  std::queue<vpImage<Type> > m_queue_image;
-  std::queue<std::string> m_queue_data;
+  std::vector<vpImage<Type> > m_slots;
+  std::vector<std::string> m_data;
+  std::vector<unsigned char> m_hasData;
+  std::unique_ptr<vpRingBuffer<unsigned int> > m_filledSlots; //!< Slots to save, from producer to consumer
+  std::unique_ptr<vpRingBuffer<unsigned int> > m_freeSlots;   //!< Slots to fill, from consumer to producer
+  std::atomic<bool> m_allocated;
   size_t m_maxQueueSize;
-  std::mutex m_mutex;
+  size_t m_maxMemory;
+  std::atomic<unsigned int> m_nbPushed;
+  std::atomic<unsigned int> m_nbDropped;
+  std::atomic<size_t> m_maxOccupancy;
+  unsigned int m_writeSlot;
+  unsigned int m_readSlot;
   std::string m_seqname;
   std::string m_directory;
   int m_recording_mode;
@@ -71,11 +71,11 @@ public:
   void run()
   {
     try {
-      vpImage<Type> I;
       std::string data;
 
       for (;;) {
-        m_queue.pop(I, data);
+        // The image is encoded in place, without copying it out of the queue
+        const vpImage<Type> &I = m_queue.beginPop(data);
 
         // Save image
         std::string filename = vpIoTools::formatString(m_seqname, m_cpt);
@@ -104,6 +104,7 @@ public:
           }
           m_ofs_data << vpIoTools::getName(filename) << " " << data << std::endl;
         }
+        m_queue.endPop();
 
         m_cpt++;
       }
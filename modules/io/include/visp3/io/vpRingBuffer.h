@@ -0,0 +1,148 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2024 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ *
+ * Description:
+ * Bounded single-producer / single-consumer lock-free queue.
+ */
+
+/*!
+ * \file vpRingBuffer.h
+ * \brief Bounded single-producer / single-consumer lock-free queue.
+ */
+
+#ifndef VP_RING_BUFFER_H
+#define VP_RING_BUFFER_H
+
+#include <visp3/core/vpConfig.h>
+
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11) && defined(VISP_HAVE_THREADS)
+
+#include <atomic>
+#include <vector>
+
+#include <visp3/core/vpException.h>
+
+BEGIN_VISP_NAMESPACE
+/*!
+  \class vpRingBuffer
+
+  \ingroup group_io_image
+
+  \brief Bounded FIFO queue that can be shared without any lock between one
+  producer thread and one consumer thread.
+
+  All the elements are allocated at construction. Pushing or popping an
+  element never allocates memory and never blocks: tryPush() returns false
+  when the queue is full and tryPop() returns false when it is empty, letting
+  the caller decide whether to wait, to retry or to drop data.
+
+  \warning Only one thread may call the producer functions and only one
+  thread may call the consumer functions.
+*/
+template <class Type> class vpRingBuffer
+{
+public:
+  /*!
+    Build a queue able to hold \e capacity elements.
+
+    \exception vpException::badValue If \e capacity is 0.
+  */
+  explicit vpRingBuffer(size_t capacity) : m_buffer(capacity + 1), m_head(0), m_tail(0)
+  {
+    if (capacity == 0) {
+      throw(vpException(vpException::badValue, "Ring buffer capacity should be greater than 0"));
+    }
+  }
+
+  /*!
+    Return the maximum number of elements in the queue.
+  */
+  inline size_t capacity() const { return m_buffer.size() - 1; }
+
+  /*!
+    Return true if the queue is empty. The result may be outdated as soon as
+    it is returned if the producer is running.
+  */
+  inline bool empty() const { return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_acquire); }
+
+  /*!
+    Return the number of elements in the queue. The result may be outdated as
+    soon as it is returned if the other thread is running.
+  */
+  size_t size() const
+  {
+    const size_t head = m_head.load(std::memory_order_acquire);
+    const size_t tail = m_tail.load(std::memory_order_acquire);
+    return (tail >= head) ? (tail - head) : ((m_buffer.size() - head) + tail);
+  }
+
+  /*!
+    Producer side. Append a copy of \e value at the end of the queue.
+
+    \return false if the queue is full, in which case it is left unchanged.
+  */
+  bool tryPush(const Type &value)
+  {
+    const size_t tail = m_tail.load(std::memory_order_relaxed);
+    const size_t next = increment(tail);
+    if (next == m_head.load(std::memory_order_acquire)) {
+      return false;
+    }
+    m_buffer[tail] = value;
+    m_tail.store(next, std::memory_order_release);
+    return true;
+  }
+
+  /*!
+    Consumer side. Move the first element of the queue in \e value.
+
+    \return false if the queue is empty, in which case \e value is left unchanged.
+  */
+  bool tryPop(Type &value)
+  {
+    const size_t head = m_head.load(std::memory_order_relaxed);
+    if (head == m_tail.load(std::memory_order_acquire)) {
+      return false;
+    }
+    value = m_buffer[head];
+    m_head.store(increment(head), std::memory_order_release);
+    return true;
+  }
+
+private:
+  inline size_t increment(size_t index) const { return ((index + 1) == m_buffer.size()) ? 0 : (index + 1); }
+
+  std::vector<Type> m_buffer; //!< One more element than the capacity to distinguish full from empty
+  std::atomic<size_t> m_head; //!< Index of the first element, written by the consumer
+  std::atomic<size_t> m_tail; //!< Index after the last element, written by the producer
+};
+END_VISP_NAMESPACE
+#endif
+#endif
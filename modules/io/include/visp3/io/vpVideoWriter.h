@@ -43,6 +43,10 @@
 
 #include <visp3/io/vpImageIo.h>
 
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11) && defined(VISP_HAVE_THREADS)
+#include <memory>
+#endif
+
 #if ((VISP_HAVE_OPENCV_VERSION < 0x030000) && defined(HAVE_OPENCV_HIGHGUI)) || ((VISP_HAVE_OPENCV_VERSION >= 0x030000) && defined(HAVE_OPENCV_VIDEOIO))
 
 #if (VISP_HAVE_OPENCV_VERSION < 0x030000) && defined(HAVE_OPENCV_HIGHGUI)
@@ -163,6 +167,30 @@ BEGIN_VISP_NAMESPACE
     return 0;
   }
   \endcode
+
+  When recording an image sequence at sensor rate, encoding each frame on the
+  caller's thread may be too slow, especially for large PNG images. Calling
+  setNbThreads() before open() fans the encoding out across a pool of worker
+  threads. saveFrame() then only copies the image into a recycled buffer and
+  returns, while the workers write the frames. The recording stays lossless:
+  when all the buffers are in use, saveFrame() waits for a worker to be
+  available. Frames are completed in order, meaning that the files that are
+  known to be written always form a contiguous sequence starting at the first
+  frame. close() waits until all the pending frames are written. Combined with
+  setPNGCompressionLevel(), this allows to record 1080p PNG sequences at 30 Hz.
+
+  \code
+  vpVideoWriter writer;
+  writer.setFileName("./image/image%04d.png");
+  writer.setNbThreads(4);
+  writer.setPNGCompressionLevel(1);
+  writer.open(I);
+  for (unsigned int cpt = 0; cpt < 300; ++cpt) {
+    // Here the code to capture an image and store it in I
+    writer.saveFrame(I);
+  }
+  writer.close();
+  \endcode
 */
 
 class VISP_EXPORT vpVideoWriter
@@ -212,6 +240,17 @@ private:
 
   int m_frameStep;
 
+  //! Number of threads used to encode the images of a sequence
+  unsigned int m_nbThreads;
+  //! zlib compression level used to encode PNG images, negative for the default level
+  int m_pngCompressionLevel;
+
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11) && defined(VISP_HAVE_THREADS)
+  class vpSequenceRecorder;
+  //! Pool of workers encoding the frames of an image sequence
+  std::unique_ptr<vpSequenceRecorder> m_recorder;
+#endif
+
 public:
   vpVideoWriter();
   virtual ~vpVideoWriter();
@@ -225,10 +264,16 @@ public:
   */
   inline unsigned int getCurrentFrameIndex() const { return m_frameCount; }
   /*!
-   * Return the name of the file in which the last frame was saved.
+   * Return the name of the file in which the last frame was saved. When
+   * several threads are used, the frame may still be pending.
    */
   inline std::string getFrameName() const { return m_frameName; }
 
+  /*!
+   * Return the number of threads used to encode the images of a sequence.
+   */
+  inline unsigned int getNbThreads() const { return m_nbThreads; }
+
   void open(vpImage<vpRGBa> &I);
   void open(vpImage<unsigned char> &I);
   /*!
@@ -267,10 +312,23 @@ public:
    * \param frame_step : Step between 2 successive images. The default value is 1.
    */
   inline void setFrameStep(const int frame_step) { m_frameStep = frame_step; }
+  void setNbThreads(unsigned int nb_threads);
+  /*!
+   * Set the zlib compression level used to write a sequence of PNG images.
+   * \param level : Compression level in [0, 9]. Low levels are much faster
+   * to encode at the price of larger files, 1 being a good trade-off when
+   * recording at sensor rate. A negative value, which is the default, keeps
+   * the default level of the image I/O backend.
+   *
+   * \sa vpImageIo::writePNG()
+   */
+  inline void setPNGCompressionLevel(int level) { m_pngCompressionLevel = level; }
 
 private:
   vpVideoFormatType getFormat(const std::string &filename);
   static std::string getExtension(const std::string &filename);
+  bool isImageSequence() const;
+  template <class Type> void saveImage(const vpImage<Type> &I);
 };
 
 END_VISP_NAMESPACE
@@ -73,8 +73,8 @@ void writeJPEGLibjpeg(const vpImage<vpRGBa> &I, const std::string &filename, int
 void readPNGLibpng(vpImage<unsigned char> &I, const std::string &filename);
 void readPNGLibpng(vpImage<vpRGBa> &I, const std::string &filename);
 
-void writePNGLibpng(const vpImage<unsigned char> &I, const std::string &filename);
-void writePNGLibpng(const vpImage<vpRGBa> &I, const std::string &filename);
+void writePNGLibpng(const vpImage<unsigned char> &I, const std::string &filename, int compression_level);
+void writePNGLibpng(const vpImage<vpRGBa> &I, const std::string &filename, int compression_level);
 
 #if ((VISP_HAVE_OPENCV_VERSION >= 0x030000) && defined(HAVE_OPENCV_IMGCODECS)) || ((VISP_HAVE_OPENCV_VERSION < 0x030000) \
     && defined(HAVE_OPENCV_HIGHGUI) && defined(HAVE_OPENCV_IMGPROC))
@@ -125,8 +125,8 @@ void readStb(vpImage<vpRGBa> &I, const std::string &filename);
 void writeJPEGStb(const vpImage<unsigned char> &I, const std::string &filename, int quality);
 void writeJPEGStb(const vpImage<vpRGBa> &I, const std::string &filename, int quality);
 
-void writePNGStb(const vpImage<unsigned char> &I, const std::string &filename);
-void writePNGStb(const vpImage<vpRGBa> &I, const std::string &filename);
+void writePNGStb(const vpImage<unsigned char> &I, const std::string &filename, int compression_level);
+void writePNGStb(const vpImage<vpRGBa> &I, const std::string &filename, int compression_level);
 
 void readPNGfromMemStb(const std::vector<unsigned char> &buffer, vpImage<unsigned char> &I);
 void readPNGfromMemStb(const std::vector<unsigned char> &buffer, vpImage<vpRGBa> &I);
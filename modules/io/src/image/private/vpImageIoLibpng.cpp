@@ -36,6 +36,9 @@
   \brief Libpng backend for PNG image I/O operations.
 */
 
+#include <algorithm>
+#include <vector>
+
 #include "vpImageIoBackend.h"
 #include <visp3/core/vpImageConvert.h>
 
@@ -50,14 +53,38 @@
 #if defined(VISP_HAVE_PNG)
 
 BEGIN_VISP_NAMESPACE
+namespace
+{
+/*!
+  Set the zlib compression level. Fast levels also restrict the row filters,
+  since trying all of them for each row is often more expensive than the
+  compression itself.
+*/
+void setCompressionLevel(png_structp png_ptr, int compression_level)
+{
+  if (compression_level >= 0) {
+    compression_level = std::min<int>(compression_level, 9);
+    png_set_compression_level(png_ptr, compression_level);
+    if (compression_level == 0) {
+      png_set_filter(png_ptr, PNG_FILTER_TYPE_BASE, PNG_FILTER_NONE);
+    }
+    else if (compression_level <= 3) {
+      png_set_filter(png_ptr, PNG_FILTER_TYPE_BASE, PNG_FILTER_SUB);
+    }
+  }
+}
+}
+
 /*!
   Write the content of the image bitmap in the file which name is given by \e
   filename. This function writes a PNG file.
 
   \param I : Image to save as a PNG file.
   \param filename : Name of the file containing the image.
+  \param compression_level : zlib compression level in [0, 9]. When negative,
+  the libpng default level is used.
 */
-void writePNGLibpng(const vpImage<unsigned char> &I, const std::string &filename)
+void writePNGLibpng(const vpImage<unsigned char> &I, const std::string &filename, int compression_level)
 {
   FILE *file;
 
@@ -113,31 +140,20 @@ void writePNGLibpng(const vpImage<unsigned char> &I, const std::string &filename
   png_set_IHDR(png_ptr, info_ptr, width, height, bit_depth, color_type, PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_BASE,
                PNG_FILTER_TYPE_BASE);
 
-  png_write_info(png_ptr, info_ptr);
+  setCompressionLevel(png_ptr, compression_level);
 
-  png_bytep *row_ptrs = new png_bytep[height];
-  for (unsigned int i = 0; i < height; ++i)
-    row_ptrs[i] = new png_byte[width];
-
-  unsigned char *input = (unsigned char *)I.bitmap;
+  png_write_info(png_ptr, info_ptr);
 
+  // Rows are given to libpng without copy, libpng does not modify them
+  std::vector<png_bytep> row_ptrs(height);
   for (unsigned int i = 0; i < height; ++i) {
-    png_byte *row = row_ptrs[i];
-    for (unsigned int j = 0; j < width; ++j) {
-      row[j] = *(input);
-      input++;
-    }
+    row_ptrs[i] = const_cast<png_bytep>(I[i]);
   }
 
-  png_write_image(png_ptr, row_ptrs);
+  png_write_image(png_ptr, row_ptrs.data());
 
   png_write_end(png_ptr, nullptr);
 
-  for (unsigned int j = 0; j < height; ++j)
-    delete[] row_ptrs[j];
-
-  delete[] row_ptrs;
-
   png_destroy_write_struct(&png_ptr, &info_ptr);
 
   fclose(file);
@@ -149,8 +165,10 @@ void writePNGLibpng(const vpImage<unsigned char> &I, const std::string &filename
 
   \param I : Image to save as a PNG file.
   \param filename : Name of the file containing the image.
+  \param compression_level : zlib compression level in [0, 9]. When negative,
+  the libpng default level is used.
 */
-void writePNGLibpng(const vpImage<vpRGBa> &I, const std::string &filename)
+void writePNGLibpng(const vpImage<vpRGBa> &I, const std::string &filename, int compression_level)
 {
   FILE *file;
 
@@ -206,36 +224,21 @@ void writePNGLibpng(const vpImage<vpRGBa> &I, const std::string &filename)
   png_set_IHDR(png_ptr, info_ptr, width, height, bit_depth, color_type, PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_BASE,
                PNG_FILTER_TYPE_BASE);
 
-  png_write_info(png_ptr, info_ptr);
-
-  png_bytep *row_ptrs = new png_bytep[height];
-  for (unsigned int i = 0; i < height; ++i)
-    row_ptrs[i] = new png_byte[3 * width];
+  setCompressionLevel(png_ptr, compression_level);
 
-  unsigned char *input = (unsigned char *)I.bitmap;
+  png_write_info(png_ptr, info_ptr);
 
+  // Rows are given to libpng without copy, the alpha channel being stripped as a filler byte
+  png_set_filler(png_ptr, 0, PNG_FILLER_AFTER);
+  std::vector<png_bytep> row_ptrs(height);
   for (unsigned int i = 0; i < height; ++i) {
-    png_byte *row = row_ptrs[i];
-    for (unsigned int j = 0; j < width; ++j) {
-      row[3 * j] = *(input);
-      input++;
-      row[3 * j + 1] = *(input);
-      input++;
-      row[3 * j + 2] = *(input);
-      input++;
-      input++;
-    }
+    row_ptrs[i] = reinterpret_cast<png_bytep>(const_cast<vpRGBa *>(I[i]));
   }
 
-  png_write_image(png_ptr, row_ptrs);
+  png_write_image(png_ptr, row_ptrs.data());
 
   png_write_end(png_ptr, nullptr);
 
-  for (unsigned int j = 0; j < height; ++j)
-    delete[] row_ptrs[j];
-
-  delete[] row_ptrs;
-
   png_destroy_write_struct(&png_ptr, &info_ptr);
 
   fclose(file);
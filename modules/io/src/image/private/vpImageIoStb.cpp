@@ -40,6 +40,12 @@
 
 #if defined(VISP_HAVE_STBIMAGE)
 
+#include <algorithm>
+#if defined(VISP_HAVE_THREADS)
+#include <condition_variable>
+#include <mutex>
+#endif
+
 #include "vpImageIoBackend.h"
 #include <visp3/core/vpImageConvert.h>
 
@@ -99,8 +105,51 @@ void writeJPEGStb(const vpImage<vpRGBa> &I, const std::string &filename, int qua
   }
 }
 
-void writePNGStb(const vpImage<unsigned char> &I, const std::string &filename)
+namespace
+{
+#if defined(VISP_HAVE_THREADS)
+std::mutex g_png_level_mutex;
+std::condition_variable g_png_level_cond;
+unsigned int g_png_level_users = 0;
+#endif
+
+/*!
+  The PNG compression level of stb_image_write is a global variable. This
+  scoped lock sets it for the lifetime of the object. Concurrent encodings
+  using the same level run in parallel, while an encoding using another level
+  waits until the current ones are over.
+*/
+class vpStbPngCompressionLevel
+{
+public:
+  explicit vpStbPngCompressionLevel(int compression_level)
+  {
+    // stb_image_write default level is 8, its minimal effective level is 5
+    const int level = (compression_level < 0) ? 8 : std::min<int>(compression_level, 9);
+#if defined(VISP_HAVE_THREADS)
+    std::unique_lock<std::mutex> lock(g_png_level_mutex);
+    g_png_level_cond.wait(lock, [level] { return (g_png_level_users == 0) || (stbi_write_png_compression_level == level); });
+    ++g_png_level_users;
+#endif
+    stbi_write_png_compression_level = level;
+  }
+
+  ~vpStbPngCompressionLevel()
+  {
+#if defined(VISP_HAVE_THREADS)
+    std::lock_guard<std::mutex> lock(g_png_level_mutex);
+    --g_png_level_users;
+    if (g_png_level_users == 0) {
+      g_png_level_cond.notify_all();
+    }
+#endif
+  }
+};
+}
+
+void writePNGStb(const vpImage<unsigned char> &I, const std::string &filename, int compression_level)
 {
+  vpStbPngCompressionLevel level_lock(compression_level);
   const int stride_in_bytes = static_cast<int>(I.getWidth());
   int res = stbi_write_png(filename.c_str(), static_cast<int>(I.getWidth()), static_cast<int>(I.getHeight()), STBI_grey,
                            reinterpret_cast<void *>(I.bitmap), stride_in_bytes);
@@ -109,8 +158,9 @@ void writePNGStb(const vpImage<unsigned char> &I, const std::string &filename)
   }
 }
 
-void writePNGStb(const vpImage<vpRGBa> &I, const std::string &filename)
+void writePNGStb(const vpImage<vpRGBa> &I, const std::string &filename, int compression_level)
 {
+  vpStbPngCompressionLevel level_lock(compression_level);
   const int stride_in_bytes = static_cast<int>(4 * I.getWidth());
   int res = stbi_write_png(filename.c_str(), static_cast<int>(I.getWidth()), static_cast<int>(I.getHeight()),
                            STBI_rgb_alpha, reinterpret_cast<void *>(I.bitmap), stride_in_bytes);
@@ -204,6 +254,7 @@ void writePNGtoMemStb(const vpImage<unsigned char> &I, std::vector<unsigned char
   const int width = I.getCols();
   const int channels = 1;
 
+  vpStbPngCompressionLevel level_lock(-1);
   custom_stbi_mem_context context;
   context.last_pos = 0;
   buffer.resize(I.getHeight() * I.getWidth());
@@ -238,6 +289,7 @@ void writePNGtoMemStb(const vpImage<vpRGBa> &I_color, std::vector<unsigned char>
   const int width = I_color.getCols();
   const int channels = saveAlpha ? 4 : 3;
 
+  vpStbPngCompressionLevel level_lock(-1);
   custom_stbi_mem_context context;
   context.last_pos = 0;
   buffer.resize(height * width * channels);
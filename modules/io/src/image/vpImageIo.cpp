@@ -386,6 +386,56 @@ void vpImageIo::write(const vpImage<vpRGBa> &I, const std::string &filename, int
   }
 }
 
+/*!
+  Write the content of a strided image view in the file which name is given by
+  \e filename. When the view rows are contiguous in memory, the pixels are
+  written without any intermediate copy. Otherwise, they are first packed into
+  a dense image.
+
+  \param I : Image view to write, for example a region of interest of a larger image.
+  \param filename : Name of the file containing the image.
+  \param backend : Library backend type (see vpImageIo::vpImageIoBackendType) for image writing.
+
+  \sa write(const vpImage<unsigned char> &, const std::string &, int)
+ */
+void vpImageIo::write(const vpImageView<unsigned char> &I, const std::string &filename, int backend)
+{
+  if (I.isContinuous()) {
+    const vpImage<unsigned char> I_wrap(I.data(), I.getHeight(), I.getWidth(), false);
+    write(I_wrap, filename, backend);
+  }
+  else {
+    vpImage<unsigned char> I_dense;
+    I.copyTo(I_dense);
+    write(I_dense, filename, backend);
+  }
+}
+
+/*!
+  Write the content of a strided color image view in the file which name is
+  given by \e filename. When the view rows are contiguous in memory, the pixels
+  are written without any intermediate copy. Otherwise, they are first packed
+  into a dense image.
+
+  \param I : Image view to write, for example a region of interest of a larger image.
+  \param filename : Name of the file containing the image.
+  \param backend : Library backend type (see vpImageIo::vpImageIoBackendType) for image writing.
+
+  \sa write(const vpImage<vpRGBa> &, const std::string &, int)
+ */
+void vpImageIo::write(const vpImageView<vpRGBa> &I, const std::string &filename, int backend)
+{
+  if (I.isContinuous()) {
+    const vpImage<vpRGBa> I_wrap(I.data(), I.getHeight(), I.getWidth(), false);
+    write(I_wrap, filename, backend);
+  }
+  else {
+    vpImage<vpRGBa> I_dense;
+    I.copyTo(I_dense);
+    write(I_dense, filename, backend);
+  }
+}
+
 /*!
   Load a jpeg image. If it is a color image it is converted in gray.
   \param[out] I : Gray level image.
@@ -1011,6 +1061,19 @@ void vpImageIo::writeJPEG(const vpImage<vpRGBa> &I, const std::string &filename,
   }
 }
 
+/*!
+  Save an image in png format with the default compression level of the backend.
+  \param[in] I : Gray level image.
+  \param[in] filename : Image location.
+  \param[in] backend : Supported backends are described in vpImageIo::vpImageIoBackendType.
+  Depending on its availability, the default backend vpImageIo::IO_DEFAULT_BACKEND is chosen in the following order:
+  vpImageIo::IO_OPENCV_BACKEND, vpImageIo::IO_SIMDLIB_BACKEND.
+ */
+void vpImageIo::writePNG(const vpImage<unsigned char> &I, const std::string &filename, int backend)
+{
+  writePNG(I, filename, backend, -1);
+}
+
 /*!
   Save an image in png format.
   \param[in] I : Gray level image.
@@ -1018,10 +1081,15 @@ void vpImageIo::writeJPEG(const vpImage<vpRGBa> &I, const std::string &filename,
   \param[in] backend : Supported backends are described in vpImageIo::vpImageIoBackendType.
   Depending on its availability, the default backend vpImageIo::IO_DEFAULT_BACKEND is chosen in the following order:
   vpImageIo::IO_OPENCV_BACKEND, vpImageIo::IO_SIMDLIB_BACKEND.
+  \param[in] compression_level : zlib compression level in [0, 9], where 0 means no compression and
+  gives the fastest encoding, 1 the fastest compression and 9 the smallest files. When negative,
+  the default level of the backend is used. This parameter is only considered by the
+  vpImageIo::IO_SYSTEM_LIB_BACKEND and vpImageIo::IO_STB_IMAGE_BACKEND backends.
  */
 // Strategy based on benchmark: see https://github.com/lagadic/visp/pull/1004
 // Default: 1. opencv, 2. simd
-void vpImageIo::writePNG(const vpImage<unsigned char> &I, const std::string &filename, int backend)
+void vpImageIo::writePNG(const vpImage<unsigned char> &I, const std::string &filename, int backend,
+                         int compression_level)
 {
   if (backend == IO_SYSTEM_LIB_BACKEND) {
 #if !defined(VISP_HAVE_PNG)
@@ -1055,6 +1123,7 @@ void vpImageIo::writePNG(const vpImage<unsigned char> &I, const std::string &fil
 #else
     (void)I;
     (void)filename;
+    (void)compression_level;
     const std::string message = "Cannot save file \"" + filename + "\": no backend available";
     throw(vpImageException(vpImageException::ioError, message));
 #endif
@@ -1066,6 +1135,7 @@ void vpImageIo::writePNG(const vpImage<unsigned char> &I, const std::string &fil
 #else
     (void)I;
     (void)filename;
+    (void)compression_level;
     const std::string message = "Cannot save file \"" + filename + "\": OpenCV library backend is not available";
     throw(vpImageException(vpImageException::ioError, message));
 #endif
@@ -1076,32 +1146,48 @@ void vpImageIo::writePNG(const vpImage<unsigned char> &I, const std::string &fil
 #else
     (void)I;
     (void)filename;
+    (void)compression_level;
     const std::string message = "Cannot save file \"" + filename + "\": Simd library backend is not available";
     throw(vpImageException(vpImageException::ioError, message));
 #endif
   }
   else if (backend == IO_STB_IMAGE_BACKEND) {
 #if defined(VISP_HAVE_STBIMAGE)
-    writePNGStb(I, filename);
+    writePNGStb(I, filename, compression_level);
 #else
     (void)I;
     (void)filename;
+    (void)compression_level;
     const std::string message = "Cannot save file \"" + filename + "\": stb_image backend is not available";
     throw(vpImageException(vpImageException::ioError, message));
 #endif
   }
   else if (backend == IO_SYSTEM_LIB_BACKEND) {
 #if defined(VISP_HAVE_PNG)
-    writePNGLibpng(I, filename);
+    writePNGLibpng(I, filename, compression_level);
 #else
     (void)I;
     (void)filename;
+    (void)compression_level;
     const std::string message = "Cannot save file \"" + filename + "\": png library backend is not available";
     throw(vpImageException(vpImageException::ioError, message));
 #endif
   }
 }
 
+/*!
+  Save an image in png format with the default compression level of the backend.
+  \param[in] I : Color image.
+  \param[in] filename : Image location.
+  \param[in] backend : Supported backends are described in vpImageIo::vpImageIoBackendType.
+  Depending on its availability, the default backend vpImageIo::IO_DEFAULT_BACKEND is chosen in the following order:
+  vpImageIo::IO_OPENCV_BACKEND, vpImageIo::IO_SYSTEM_LIB_BACKEND, vpImageIo::IO_SIMDLIB_BACKEND.
+ */
+void vpImageIo::writePNG(const vpImage<vpRGBa> &I, const std::string &filename, int backend)
+{
+  writePNG(I, filename, backend, -1);
+}
+
 /*!
   Save an image in png format.
   \param[in] I : Color image.
@@ -1109,10 +1195,14 @@ void vpImageIo::writePNG(const vpImage<unsigned char> &I, const std::string &fil
   \param[in] backend : Supported backends are described in vpImageIo::vpImageIoBackendType.
   Depending on its availability, the default backend vpImageIo::IO_DEFAULT_BACKEND is chosen in the following order:
   vpImageIo::IO_OPENCV_BACKEND, vpImageIo::IO_SYSTEM_LIB_BACKEND, vpImageIo::IO_SIMDLIB_BACKEND.
+  \param[in] compression_level : zlib compression level in [0, 9], where 0 means no compression and
+  gives the fastest encoding, 1 the fastest compression and 9 the smallest files. When negative,
+  the default level of the backend is used. This parameter is only considered by the
+  vpImageIo::IO_SYSTEM_LIB_BACKEND and vpImageIo::IO_STB_IMAGE_BACKEND backends.
  */
 // Strategy based on benchmark: see https://github.com/lagadic/visp/pull/1004
 // Default: 1. opencv, 2. system, 3. simd
-void vpImageIo::writePNG(const vpImage<vpRGBa> &I, const std::string &filename, int backend)
+void vpImageIo::writePNG(const vpImage<vpRGBa> &I, const std::string &filename, int backend, int compression_level)
 {
   if (backend == IO_SYSTEM_LIB_BACKEND) {
 #if !defined(VISP_HAVE_PNG)
@@ -1146,6 +1236,7 @@ void vpImageIo::writePNG(const vpImage<vpRGBa> &I, const std::string &filename,
 #else
     (void)I;
     (void)filename;
+    (void)compression_level;
     const std::string message = "Cannot save file \"" + filename + "\": no backend available";
     throw(vpImageException(vpImageException::ioError, message));
 #endif
@@ -1157,6 +1248,7 @@ void vpImageIo::writePNG(const vpImage<vpRGBa> &I, const std::string &filename,
 #else
     (void)I;
     (void)filename;
+    (void)compression_level;
     const std::string message = "Cannot save file \"" + filename + "\": OpenCV backend is not available";
     throw(vpImageException(vpImageException::ioError, message));
 #endif
@@ -1167,26 +1259,29 @@ void vpImageIo::writePNG(const vpImage<vpRGBa> &I, const std::string &filename,
 #else
     (void)I;
     (void)filename;
+    (void)compression_level;
     const std::string message = "Cannot save file \"" + filename + "\": Simd library backend is not available";
     throw(vpImageException(vpImageException::ioError, message));
 #endif
   }
   else if (backend == IO_STB_IMAGE_BACKEND) {
 #if defined(VISP_HAVE_STBIMAGE)
-    writePNGStb(I, filename);
+    writePNGStb(I, filename, compression_level);
 #else
     (void)I;
     (void)filename;
+    (void)compression_level;
     const std::string message = "Cannot save file \"" + filename + "\": stb_image backend is not available";
     throw(vpImageException(vpImageException::ioError, message));
 #endif
   }
   else if (backend == IO_SYSTEM_LIB_BACKEND) {
 #if defined(VISP_HAVE_PNG)
-    writePNGLibpng(I, filename);
+    writePNGLibpng(I, filename, compression_level);
 #else
     (void)I;
     (void)filename;
+    (void)compression_level;
     const std::string message = "Cannot save file \"" + filename + "\": libpng backend is not available";
     throw(vpImageException(vpImageException::ioError, message));
 #endif
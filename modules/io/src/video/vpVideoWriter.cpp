@@ -43,8 +43,202 @@
 #include <opencv2/imgproc/imgproc.hpp>
 #endif
 
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11) && defined(VISP_HAVE_THREADS)
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+#endif
+
 BEGIN_VISP_NAMESPACE
 
+namespace
+{
+/*!
+  Write one image of a sequence, using the requested PNG compression level if
+  any. The level is only supported by the libpng and stb_image backends.
+*/
+template <class Type> void writeSequenceImage(const vpImage<Type> &I, const std::string &filename, bool png,
+                                              int png_compression_level)
+{
+  if (png && (png_compression_level >= 0)) {
+#if defined(VISP_HAVE_PNG)
+    vpImageIo::writePNG(I, filename, vpImageIo::IO_SYSTEM_LIB_BACKEND, png_compression_level);
+#elif defined(VISP_HAVE_STBIMAGE)
+    vpImageIo::writePNG(I, filename, vpImageIo::IO_STB_IMAGE_BACKEND, png_compression_level);
+#else
+    vpImageIo::writePNG(I, filename, vpImageIo::IO_DEFAULT_BACKEND, png_compression_level);
+#endif
+  }
+  else {
+    vpImageIo::write(I, filename);
+  }
+}
+}
+
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11) && defined(VISP_HAVE_THREADS)
+/*!
+  Pool of worker threads encoding the images of a sequence.
+
+  Frames are copied into a fixed number of recycled slots used as a circular
+  buffer. Workers pick the frames in submission order, and a slot is only
+  released when all the previous frames are written, so that completion is
+  ordered. When all the slots are in use, push() waits: no frame is dropped.
+  The first encoding error is rethrown by the next call to push() or flush().
+*/
+class vpVideoWriter::vpSequenceRecorder
+{
+public:
+  vpSequenceRecorder(unsigned int nb_threads, bool png, int png_compression_level)
+    : m_png(png), m_pngCompressionLevel(png_compression_level), m_jobs(2 * nb_threads), m_head(0), m_next(0),
+    m_tail(0), m_stop(false), m_error(), m_errorFrame(0), m_mutex(), m_cond(), m_workers()
+  {
+    for (unsigned int i = 0; i < nb_threads; ++i) {
+      m_workers.push_back(std::thread(&vpSequenceRecorder::run, this));
+    }
+  }
+
+  ~vpSequenceRecorder()
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_stop = true;
+    }
+    m_cond.notify_all();
+    for (size_t i = 0; i < m_workers.size(); ++i) {
+      m_workers[i].join();
+    }
+  }
+
+  /*!
+    Wait until all the pending frames are written.
+  */
+  void flush()
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_cond.wait(lock, [this] { return m_head == m_tail; });
+    rethrowError();
+  }
+
+  /*!
+    Copy a frame into a free slot and hand it to the workers.
+  */
+  template <class Type> void push(const vpImage<Type> &I, const std::string &filename)
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_cond.wait(lock, [this] { return (m_tail - m_head) < m_jobs.size(); });
+    rethrowError();
+    vpJob &job = m_jobs[m_tail % m_jobs.size()];
+    lock.unlock();
+
+    // The slot is neither visible to the workers nor retired before m_tail is incremented
+    job.set(I);
+    job.m_filename = filename;
+    job.m_done = false;
+
+    lock.lock();
+    ++m_tail;
+    lock.unlock();
+    m_cond.notify_all();
+  }
+
+private:
+  //! Frame waiting to be written
+  struct vpJob
+  {
+    vpJob() : m_grey(), m_color(), m_isColor(false), m_filename(), m_done(true) { }
+
+    void set(const vpImage<unsigned char> &I)
+    {
+      m_grey = I;
+      m_isColor = false;
+    }
+
+    void set(const vpImage<vpRGBa> &I)
+    {
+      m_color = I;
+      m_isColor = true;
+    }
+
+    vpImage<unsigned char> m_grey;
+    vpImage<vpRGBa> m_color;
+    bool m_isColor;
+    std::string m_filename;
+    bool m_done;
+  };
+
+  void rethrowError()
+  {
+    if (m_error) {
+      std::exception_ptr error = m_error;
+      m_error = nullptr;
+      std::rethrow_exception(error);
+    }
+  }
+
+  void run()
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (;;) {
+      m_cond.wait(lock, [this] { return m_stop || (m_next < m_tail); });
+      if (m_next == m_tail) {
+        // Stop requested and no more pending frames
+        return;
+      }
+      const size_t frame = m_next++;
+      vpJob &job = m_jobs[frame % m_jobs.size()];
+      lock.unlock();
+
+      std::exception_ptr error;
+      try {
+        if (job.m_isColor) {
+          writeSequenceImage(job.m_color, job.m_filename, m_png, m_pngCompressionLevel);
+        }
+        else {
+          writeSequenceImage(job.m_grey, job.m_filename, m_png, m_pngCompressionLevel);
+        }
+      }
+      catch (...) {
+        error = std::current_exception();
+      }
+
+      lock.lock();
+      job.m_done = true;
+      // Keep the error of the first frame in the sequence
+      if (error && (!m_error || (frame < m_errorFrame))) {
+        m_error = error;
+        m_errorFrame = frame;
+      }
+      // Release the slots of the frames that are written in order
+      bool retired = false;
+      while ((m_head < m_next) && m_jobs[m_head % m_jobs.size()].m_done) {
+        ++m_head;
+        retired = true;
+      }
+      if (retired) {
+        m_cond.notify_all();
+      }
+    }
+  }
+
+  const bool m_png;
+  const int m_pngCompressionLevel;
+  std::vector<vpJob> m_jobs;
+  size_t m_head; //!< Oldest frame that is not yet retired
+  size_t m_next; //!< Next frame to be encoded by a worker
+  size_t m_tail; //!< Next frame to be submitted
+  bool m_stop;
+  std::exception_ptr m_error;
+  size_t m_errorFrame;
+  std::mutex m_mutex;
+  std::condition_variable m_cond;
+  std::vector<std::thread> m_workers;
+};
+#endif
+
 /*!
   Basic constructor.
 */
@@ -54,7 +248,10 @@ vpVideoWriter::vpVideoWriter()
   m_writer(), m_framerate(25.0),
 #endif
   m_formatType(FORMAT_UNKNOWN), m_videoName(), m_frameName(), m_initFileName(false), m_isOpen(false), m_frameCount(0),
-  m_firstFrame(0), m_width(0), m_height(0), m_frameStep(1)
+  m_firstFrame(0), m_width(0), m_height(0), m_frameStep(1), m_nbThreads(1), m_pngCompressionLevel(-1)
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11) && defined(VISP_HAVE_THREADS)
+  , m_recorder()
+#endif
 {
 #if ((VISP_HAVE_OPENCV_VERSION < 0x030000) && defined(HAVE_OPENCV_HIGHGUI)) || ((VISP_HAVE_OPENCV_VERSION >= 0x030000) && defined(HAVE_OPENCV_VIDEOIO))
 #if (VISP_HAVE_OPENCV_VERSION >= 0x030000)
@@ -66,9 +263,75 @@ vpVideoWriter::vpVideoWriter()
 }
 
 /*!
-  Basic destructor.
+  Basic destructor. Pending frames of an image sequence are written before
+  the worker threads are released. Since a destructor can not throw, an error
+  that occurred while encoding them is printed on the standard error output.
+  Call close() before to get it as an exception.
+*/
+vpVideoWriter::~vpVideoWriter()
+{
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11) && defined(VISP_HAVE_THREADS)
+  if (m_recorder) {
+    try {
+      m_recorder->flush();
+    }
+    catch (const std::exception &e) {
+      std::cerr << "vpVideoWriter: cannot write the pending frames: " << e.what() << std::endl;
+    }
+    catch (...) {
+      std::cerr << "vpVideoWriter: cannot write the pending frames" << std::endl;
+    }
+  }
+#endif
+}
+
+/*!
+  Set the number of threads used to encode the images of a sequence. It has
+  to be called before open() and has no effect on video files, that are always
+  encoded sequentially.
+
+  \param nb_threads : Number of threads. When set to 1, which is the default,
+  each image is written by saveFrame() on the caller's thread. When set to 0,
+  the number of concurrent threads supported by the hardware is used.
+
+  \note Without threads support, images are always written on the caller's
+  thread.
 */
-vpVideoWriter::~vpVideoWriter() { }
+void vpVideoWriter::setNbThreads(unsigned int nb_threads)
+{
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11) && defined(VISP_HAVE_THREADS)
+  if (nb_threads == 0) {
+    nb_threads = std::max<unsigned int>(std::thread::hardware_concurrency(), 1);
+  }
+#else
+  nb_threads = 1;
+#endif
+  m_nbThreads = nb_threads;
+}
+
+/*!
+  Return true when the images are written as a sequence of image files.
+*/
+bool vpVideoWriter::isImageSequence() const
+{
+  return (m_formatType == FORMAT_PGM) || (m_formatType == FORMAT_PPM) || (m_formatType == FORMAT_JPEG) ||
+    (m_formatType == FORMAT_PNG);
+}
+
+/*!
+  Write an image of the sequence, either directly or through the worker pool.
+*/
+template <class Type> void vpVideoWriter::saveImage(const vpImage<Type> &I)
+{
+  m_frameName = vpIoTools::formatString(m_videoName, m_frameCount);
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11) && defined(VISP_HAVE_THREADS)
+  if (m_recorder) {
+    m_recorder->push(I, m_frameName);
+    return;
+  }
+#endif
+  writeSequenceImage(I, m_frameName, m_formatType == FORMAT_PNG, m_pngCompressionLevel);
+}
 
 /*!
   It enables to set the path and the name of the video or sequence of images
@@ -118,10 +381,15 @@ void vpVideoWriter::open(vpImage<vpRGBa> &I)
 
   vpIoTools::makeDirectory(vpIoTools::getParent(m_videoName));
 
-  if (m_formatType == FORMAT_PGM || m_formatType == FORMAT_PPM || m_formatType == FORMAT_JPEG ||
-      m_formatType == FORMAT_PNG) {
+  if (isImageSequence()) {
     m_width = I.getWidth();
     m_height = I.getHeight();
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11) && defined(VISP_HAVE_THREADS)
+    m_recorder.reset();
+    if (m_nbThreads > 1) {
+      m_recorder.reset(new vpSequenceRecorder(m_nbThreads, m_formatType == FORMAT_PNG, m_pngCompressionLevel));
+    }
+#endif
   }
   else if (m_formatType == FORMAT_AVI || m_formatType == FORMAT_MPEG || m_formatType == FORMAT_MPEG4 ||
           m_formatType == FORMAT_MOV) {
@@ -158,10 +426,15 @@ void vpVideoWriter::open(vpImage<unsigned char> &I)
 
   vpIoTools::makeDirectory(vpIoTools::getParent(m_videoName));
 
-  if (m_formatType == FORMAT_PGM || m_formatType == FORMAT_PPM || m_formatType == FORMAT_JPEG ||
-      m_formatType == FORMAT_PNG) {
+  if (isImageSequence()) {
     m_width = I.getWidth();
     m_height = I.getHeight();
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11) && defined(VISP_HAVE_THREADS)
+    m_recorder.reset();
+    if (m_nbThreads > 1) {
+      m_recorder.reset(new vpSequenceRecorder(m_nbThreads, m_formatType == FORMAT_PNG, m_pngCompressionLevel));
+    }
+#endif
   }
   else if (m_formatType == FORMAT_AVI || m_formatType == FORMAT_MPEG || m_formatType == FORMAT_MPEG4 ||
           m_formatType == FORMAT_MOV) {
@@ -197,10 +470,8 @@ void vpVideoWriter::saveFrame(vpImage<vpRGBa> &I)
     throw(vpException(vpException::notInitialized, "The video has to be open first with video writer open() method"));
   }
 
-  if (m_formatType == FORMAT_PGM || m_formatType == FORMAT_PPM || m_formatType == FORMAT_JPEG ||
-      m_formatType == FORMAT_PNG) {
-    m_frameName = vpIoTools::formatString(m_videoName, m_frameCount);
-    vpImageIo::write(I, m_frameName);
+  if (isImageSequence()) {
+    saveImage(I);
   }
   else {
 #if ((VISP_HAVE_OPENCV_VERSION < 0x030000) && defined(HAVE_OPENCV_HIGHGUI)) || ((VISP_HAVE_OPENCV_VERSION >= 0x030000) && defined(HAVE_OPENCV_VIDEOIO))
@@ -228,10 +499,8 @@ void vpVideoWriter::saveFrame(vpImage<unsigned char> &I)
     throw(vpException(vpException::notInitialized, "The video has to be open first with video writer open() method"));
   }
 
-  if (m_formatType == FORMAT_PGM || m_formatType == FORMAT_PPM || m_formatType == FORMAT_JPEG ||
-      m_formatType == FORMAT_PNG) {
-    m_frameName = vpIoTools::formatString(m_videoName, m_frameCount);
-    vpImageIo::write(I, m_frameName);
+  if (isImageSequence()) {
+    saveImage(I);
   }
   else {
 #if ((VISP_HAVE_OPENCV_VERSION < 0x030000) && defined(HAVE_OPENCV_HIGHGUI)) || ((VISP_HAVE_OPENCV_VERSION >= 0x030000) && defined(HAVE_OPENCV_VIDEOIO))
@@ -254,12 +523,22 @@ void vpVideoWriter::saveFrame(vpImage<unsigned char> &I)
 
 /*!
   Deallocates parameters use to write the video or the image sequence.
+
+  When several threads are used to write an image sequence, this function waits
+  until all the pending frames are written and rethrows the first error that
+  occurred while encoding them, if any.
 */
 void vpVideoWriter::close()
 {
   if (!m_isOpen) {
     throw(vpException(vpException::notInitialized, "Cannot close video writer: not yet opened"));
   }
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11) && defined(VISP_HAVE_THREADS)
+  if (m_recorder) {
+    std::unique_ptr<vpSequenceRecorder> recorder(std::move(m_recorder));
+    recorder->flush();
+  }
+#endif
 }
 
 /*!
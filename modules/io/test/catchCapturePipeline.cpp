@@ -0,0 +1,306 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2024 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ *
+ * Description:
+ * Test the asynchronous capture pipeline.
+ */
+
+/*!
+  \example catchCapturePipeline.cpp
+
+  \brief Test the lock-free ring buffer and the asynchronous capture pipeline.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2) && (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11) && defined(VISP_HAVE_THREADS)
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <catch_amalgamated.hpp>
+#include <visp3/core/vpImage.h>
+#include <visp3/io/vpCapturePipeline.h>
+#include <visp3/io/vpRingBuffer.h>
+
+#ifdef ENABLE_VISP_NAMESPACE
+using namespace VISP_NAMESPACE_NAME;
+#endif
+
+namespace
+{
+struct Frame
+{
+  Frame() : index(0), I(), value(0) { }
+
+  unsigned int index;
+  vpImage<unsigned char> I;
+  unsigned int value;
+};
+} // anonymous namespace
+
+TEST_CASE("Ring buffer", "[capture_pipeline]")
+{
+  SECTION("Full and empty queue")
+  {
+    vpRingBuffer<int> queue(3);
+    CHECK(queue.capacity() == 3);
+    CHECK(queue.empty());
+    CHECK(queue.tryPush(1));
+    CHECK(queue.tryPush(2));
+    CHECK(queue.tryPush(3));
+    CHECK_FALSE(queue.tryPush(4));
+    CHECK(queue.size() == 3);
+
+    int value = 0;
+    CHECK(queue.tryPop(value));
+    CHECK(value == 1);
+    CHECK(queue.tryPush(4));
+    for (int expected = 2; expected <= 4; ++expected) {
+      CHECK(queue.tryPop(value));
+      CHECK(value == expected);
+    }
+    CHECK_FALSE(queue.tryPop(value));
+    CHECK(queue.empty());
+
+    CHECK_THROWS_AS(vpRingBuffer<int>(0), vpException);
+  }
+
+  SECTION("Producer and consumer threads")
+  {
+    vpRingBuffer<unsigned int> queue(16);
+    const unsigned int nbValues = 100000;
+    std::thread producer([&]() {
+      for (unsigned int i = 0; i < nbValues; ++i) {
+        while (!queue.tryPush(i)) {
+          std::this_thread::yield();
+        }
+      }
+      });
+
+    bool ordered = true;
+    for (unsigned int i = 0; i < nbValues; ++i) {
+      unsigned int value;
+      while (!queue.tryPop(value)) {
+        std::this_thread::yield();
+      }
+      ordered = ordered && (value == i);
+    }
+    producer.join();
+    CHECK(ordered);
+  }
+}
+
+TEST_CASE("Lossless capture pipeline", "[capture_pipeline]")
+{
+  const unsigned int nbFrames = 200;
+  unsigned int nbAcquired = 0;
+  std::vector<unsigned int> values;
+
+  vpCapturePipeline<Frame> pipeline(4, vpCapturePipeline<Frame>::LOSSLESS);
+  pipeline.setAcquisition("acquire", [&](Frame &f) {
+    if (nbAcquired == nbFrames) {
+      return false;
+    }
+    f.index = nbAcquired++;
+    f.I.resize(48, 64, static_cast<unsigned char>(f.index % 256));
+    return true;
+    });
+  pipeline.addStage("process", [](Frame &f) { f.value = f.I[0][0] + 1u; });
+  pipeline.addStage("record", [&](Frame &f) {
+    // Slower than the acquisition
+    std::this_thread::sleep_for(std::chrono::microseconds(200));
+    values.push_back(f.index * 1000 + f.value);
+    });
+
+  pipeline.start();
+  CHECK_THROWS_AS(pipeline.start(), vpException);
+  pipeline.wait();
+  CHECK_FALSE(pipeline.isRunning());
+
+  REQUIRE(values.size() == nbFrames);
+  bool ok = true;
+  for (unsigned int i = 0; i < nbFrames; ++i) {
+    ok = ok && (values[i] == (i * 1000 + (i % 256) + 1));
+  }
+  CHECK(ok);
+
+  std::vector<vpCapturePipeline<Frame>::vpStageStatistics> stats = pipeline.getStatistics();
+  REQUIRE(stats.size() == 3);
+  CHECK(stats[0].name == "acquire");
+  CHECK(stats[2].name == "record");
+  for (size_t k = 0; k < stats.size(); ++k) {
+    CHECK(stats[k].nbProcessed == nbFrames);
+    CHECK(stats[k].nbDropped == 0);
+    CHECK(stats[k].maxProcessingTime >= stats[k].meanProcessingTime);
+    CHECK(stats[k].maxLatency >= stats[k].meanLatency);
+  }
+  CHECK(stats[2].meanLatency >= stats[1].meanLatency);
+}
+
+TEST_CASE("Latest-only capture pipeline", "[capture_pipeline]")
+{
+  unsigned int nbAcquired = 0;
+  std::vector<unsigned int> indexes;
+
+  vpCapturePipeline<Frame> pipeline(3, vpCapturePipeline<Frame>::LATEST_ONLY);
+  pipeline.setAcquisition("acquire", [&](Frame &f) {
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+    f.index = nbAcquired++;
+    return true;
+    });
+  pipeline.addStage("track", [&](Frame &f) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    indexes.push_back(f.index);
+    });
+
+  pipeline.start();
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  pipeline.stop();
+
+  std::vector<vpCapturePipeline<Frame>::vpStageStatistics> stats = pipeline.getStatistics();
+  REQUIRE(stats.size() == 2);
+  // The acquisition doesn't wait for the tracker
+  CHECK(stats[0].nbProcessed + stats[0].nbDropped == nbAcquired);
+  CHECK(stats[0].nbDropped + stats[1].nbDropped > 0);
+  CHECK(stats[1].nbProcessed == indexes.size());
+  CHECK(stats[1].nbProcessed < nbAcquired);
+
+  bool increasing = true;
+  for (size_t i = 1; i < indexes.size(); ++i) {
+    increasing = increasing && (indexes[i] > indexes[i - 1]);
+  }
+  CHECK(increasing);
+}
+
+TEST_CASE("Restart a capture pipeline", "[capture_pipeline]")
+{
+  // With the smallest pool, a frame that is not given back to the pool at the end of a run blocks the next ones
+  SECTION("Lossless")
+  {
+    const unsigned int nbFrames = 20;
+    unsigned int nbAcquired = 0;
+    unsigned int nbProcessed = 0;
+    vpCapturePipeline<Frame> pipeline(2, vpCapturePipeline<Frame>::LOSSLESS);
+    pipeline.setAcquisition("acquire", [&](Frame &f) {
+      if (nbAcquired == nbFrames) {
+        return false;
+      }
+      f.index = nbAcquired++;
+      return true;
+      });
+    pipeline.addStage("track", [&](Frame &) { ++nbProcessed; });
+
+    for (unsigned int run = 0; run < 3; ++run) {
+      nbAcquired = 0;
+      nbProcessed = 0;
+      pipeline.start();
+      pipeline.wait();
+      CHECK(nbProcessed == nbFrames);
+    }
+  }
+
+  SECTION("Latest-only")
+  {
+    unsigned int nbProcessed = 0;
+    vpCapturePipeline<Frame> pipeline(2, vpCapturePipeline<Frame>::LATEST_ONLY);
+    pipeline.setAcquisition("acquire", [&](Frame &) {
+      std::this_thread::sleep_for(std::chrono::microseconds(100));
+      return true;
+      });
+    pipeline.addStage("track", [&](Frame &) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      ++nbProcessed;
+      });
+
+    for (unsigned int run = 0; run < 3; ++run) {
+      nbProcessed = 0;
+      pipeline.start();
+      std::this_thread::sleep_for(std::chrono::milliseconds(50));
+      pipeline.stop();
+      CHECK(nbProcessed > 0);
+    }
+  }
+
+  SECTION("After an acquisition error")
+  {
+    unsigned int nbAcquired = 0;
+    unsigned int nbProcessed = 0;
+    vpCapturePipeline<Frame> pipeline(2, vpCapturePipeline<Frame>::LOSSLESS);
+    pipeline.setAcquisition("acquire", [&](Frame &) {
+      if (++nbAcquired == 5) {
+        throw vpException(vpException::fatalError, "Camera disconnected");
+      }
+      return nbAcquired < 10;
+      });
+    pipeline.addStage("track", [&](Frame &) { ++nbProcessed; });
+
+    pipeline.start();
+    CHECK_THROWS_AS(pipeline.wait(), vpException);
+    nbProcessed = 0;
+    pipeline.start();
+    pipeline.wait();
+    CHECK(nbProcessed == 4);
+  }
+}
+
+TEST_CASE("Capture pipeline errors", "[capture_pipeline]")
+{
+  CHECK_THROWS_AS(vpCapturePipeline<Frame>(1), vpException);
+
+  vpCapturePipeline<Frame> pipeline;
+  CHECK_THROWS_AS(pipeline.start(), vpException);
+
+  unsigned int nbAcquired = 0;
+  pipeline.setAcquisition("acquire", [&](Frame &f) {
+    f.index = nbAcquired++;
+    return true;
+    });
+  pipeline.addStage("track", [](Frame &f) {
+    if (f.index == 10) {
+      throw vpException(vpException::fatalError, "Tracking failed");
+    }
+    });
+  pipeline.start();
+  CHECK_THROWS_AS(pipeline.wait(), vpException);
+  CHECK_FALSE(pipeline.isRunning());
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session;
+  session.applyCommandLine(argc, argv);
+  int numFailed = session.run();
+  return numFailed;
+}
+#else
+int main() { return EXIT_SUCCESS; }
+#endif
@@ -0,0 +1,211 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2024 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ *
+ * Description:
+ * Test the image queue used to record images.
+ */
+
+/*!
+  \example catchImageQueue.cpp
+
+  \brief Test the image queue and the storage worker used to record images.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2) && (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11) && defined(VISP_HAVE_THREADS)
+
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <thread>
+
+#include <catch_amalgamated.hpp>
+#include <visp3/core/vpIoTools.h>
+#include <visp3/io/vpImageIo.h>
+#include <visp3/io/vpImageQueue.h>
+#include <visp3/io/vpImageStorageWorker.h>
+
+#ifdef ENABLE_VISP_NAMESPACE
+using namespace VISP_NAMESPACE_NAME;
+#endif
+
+TEST_CASE("Image queue memory budget", "[image_queue]")
+{
+  vpImageQueue<unsigned char> queue("", 0);
+  vpImage<unsigned char> I(120, 160, 0);
+  queue.setMaxMemory(3 * I.getSize());
+  CHECK(queue.getNbSlots() == 0);
+
+  for (unsigned char i = 0; i < 5; ++i) {
+    I = i;
+    std::string data = std::to_string(i);
+    queue.push(I, &data);
+  }
+  CHECK(queue.getNbSlots() == 3);
+  CHECK(queue.getNbPushedImages() == 3);
+  CHECK(queue.getNbDroppedImages() == 2);
+  CHECK(queue.getMaxOccupancy() == 3);
+
+  // Oldest images are kept, the ones pushed when the queue was full are dropped
+  for (unsigned char i = 0; i < 3; ++i) {
+    std::string data;
+    const vpImage<unsigned char> &I_slot = queue.beginPop(data);
+    CHECK(I_slot[60][80] == i);
+    CHECK(data == std::to_string(i));
+    queue.endPop();
+  }
+
+  // Write an image in place
+  vpImage<unsigned char> *I_slot = queue.beginPush(I);
+  REQUIRE(I_slot != nullptr);
+  I_slot->resize(120, 160, 42);
+  queue.endPush(nullptr);
+
+  std::string data = "unchanged";
+  vpImage<unsigned char> I_pop;
+  queue.pop(I_pop, data);
+  CHECK(I_pop[0][0] == 42);
+  CHECK(data == "unchanged");
+
+  queue.cancel();
+  CHECK_THROWS_AS(queue.pop(I_pop, data), vpImageQueue<unsigned char>::vpCancelled_t);
+}
+
+TEST_CASE("Image queue drops the newest images when full", "[image_queue]")
+{
+  vpImageQueue<unsigned char> queue("", 0);
+  queue.setMaxQueueSize(2);
+  vpImage<unsigned char> I(12, 16, 0);
+  vpImage<unsigned char> I_pop;
+  std::string data;
+
+  // Images 2 and 3 are dropped, the queued images 0 and 1 are kept
+  for (unsigned char i = 0; i < 4; ++i) {
+    I = i;
+    queue.push(I, nullptr);
+  }
+  CHECK(queue.getNbDroppedImages() == 2);
+  queue.pop(I_pop, data);
+  CHECK(I_pop[0][0] == 0);
+
+  // Once a slot is released, the next image is queued after the oldest one
+  I = 4;
+  queue.push(I, nullptr);
+  queue.pop(I_pop, data);
+  CHECK(I_pop[0][0] == 1);
+  queue.pop(I_pop, data);
+  CHECK(I_pop[0][0] == 4);
+  CHECK(queue.getNbPushedImages() == 3);
+  CHECK(queue.getNbDroppedImages() == 2);
+}
+
+TEST_CASE("Image queue wakes up a waiting consumer", "[image_queue]")
+{
+  vpImageQueue<unsigned char> queue("", 0);
+  vpImage<unsigned char> I(12, 16, 7);
+  unsigned char value = 0;
+  bool cancelled = false;
+
+  // The consumer waits in pop() before any image is pushed, and then until the queue is cancelled
+  std::thread consumer([&queue, &value, &cancelled] {
+    vpImage<unsigned char> I_pop;
+    std::string data;
+    queue.pop(I_pop, data);
+    value = I_pop[0][0];
+    try {
+      queue.pop(I_pop, data);
+    }
+    catch (const vpImageQueue<unsigned char>::vpCancelled_t &) {
+      cancelled = true;
+    }
+  });
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  queue.push(I, nullptr);
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  queue.cancel();
+  consumer.join();
+
+  CHECK(value == 7);
+  CHECK(cancelled);
+}
+
+TEST_CASE("Image queue storage", "[image_queue]")
+{
+  const std::string tmp_dir = vpIoTools::makeTempDirectory(vpIoTools::getTempPath() + vpIoTools::path("/") + "visp_test_image_queue");
+  const std::string seqname = tmp_dir + vpIoTools::path("/") + "I%04d.pgm";
+  const unsigned int nbImages = 50;
+
+  vpImageQueue<unsigned char> queue(seqname, 0);
+  vpImageStorageWorker<unsigned char> worker(queue);
+  std::thread worker_thread(&vpImageStorageWorker<unsigned char>::run, &worker);
+
+  vpImage<unsigned char> I(48, 64);
+  for (unsigned int i = 0; i < nbImages; ++i) {
+    I = static_cast<unsigned char>(i);
+    std::string data = std::to_string(i);
+    // Without display, recording starts immediately
+    queue.record(I, &data);
+  }
+  queue.cancel();
+  worker_thread.join();
+
+  CHECK(queue.getNbPushedImages() == nbImages);
+  CHECK(queue.getNbDroppedImages() == 0);
+  for (unsigned int i = 0; i < nbImages; ++i) {
+    vpImage<unsigned char> I_read;
+    vpImageIo::read(I_read, vpIoTools::formatString(seqname, i + 1));
+    CHECK(I_read.getSize() == I.getSize());
+    CHECK(I_read[10][10] == i);
+  }
+
+  std::ifstream ifs(tmp_dir + vpIoTools::path("/") + "I%04d.txt");
+  unsigned int nbLines = 0;
+  std::string name, data;
+  while (ifs >> name >> data) {
+    CHECK(data == std::to_string(nbLines));
+    ++nbLines;
+  }
+  CHECK(nbLines == nbImages);
+
+  vpIoTools::remove(tmp_dir);
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session;
+  session.applyCommandLine(argc, argv);
+  int numFailed = session.run();
+  return numFailed;
+}
+#else
+int main() { return EXIT_SUCCESS; }
+#endif
@@ -0,0 +1,244 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2024 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ *
+ * Description:
+ * Test and benchmark multithreaded image sequence recording.
+ */
+
+/*!
+  \example perfVideoWriter.cpp
+
+  \brief Test and benchmark image sequence recording with vpVideoWriter using
+  a pool of encoding threads.
+ */
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2)
+
+#include <fstream>
+#include <string>
+
+#include <catch_amalgamated.hpp>
+#include <visp3/core/vpIoTools.h>
+#include <visp3/io/vpImageIo.h>
+#include <visp3/io/vpVideoWriter.h>
+
+#ifdef ENABLE_VISP_NAMESPACE
+using namespace VISP_NAMESPACE_NAME;
+#endif
+
+static bool runBenchmark = false;
+
+namespace
+{
+// Each frame differs from the others to detect frames that are swapped or lost
+void createFrame(vpImage<unsigned char> &I, unsigned int index)
+{
+  for (unsigned int i = 0; i < I.getHeight(); ++i) {
+    for (unsigned int j = 0; j < I.getWidth(); ++j) {
+      I[i][j] = static_cast<unsigned char>((i * 3 + j + index * 17) % 256);
+    }
+  }
+}
+
+void createFrame(vpImage<vpRGBa> &I, unsigned int index)
+{
+  for (unsigned int i = 0; i < I.getHeight(); ++i) {
+    for (unsigned int j = 0; j < I.getWidth(); ++j) {
+      I[i][j] = vpRGBa(static_cast<unsigned char>((i + index) % 256), static_cast<unsigned char>((j * 2) % 256),
+                       static_cast<unsigned char>((i * j + index * 31) % 256));
+    }
+  }
+}
+
+template <class Type>
+void recordSequence(const std::string &videoname, unsigned int height, unsigned int width, unsigned int nb_frames,
+                    unsigned int nb_threads, int png_compression_level)
+{
+  vpImage<Type> I(height, width);
+  vpVideoWriter writer;
+  writer.setFileName(videoname);
+  writer.setFirstFrameIndex(1);
+  writer.setNbThreads(nb_threads);
+  writer.setPNGCompressionLevel(png_compression_level);
+  writer.open(I);
+  for (unsigned int index = 0; index < nb_frames; ++index) {
+    createFrame(I, index);
+    writer.saveFrame(I);
+  }
+  writer.close();
+}
+
+template <class Type>
+void checkSequence(const std::string &videoname, unsigned int height, unsigned int width, unsigned int nb_frames)
+{
+  vpImage<Type> I_ref(height, width), I;
+  for (unsigned int index = 0; index < nb_frames; ++index) {
+    createFrame(I_ref, index);
+    vpImageIo::read(I, vpIoTools::formatString(videoname, static_cast<int>(index + 1)));
+    CHECK((I == I_ref));
+  }
+}
+
+size_t getFileSize(const std::string &filename)
+{
+  std::ifstream file(filename.c_str(), std::ios::binary | std::ios::ate);
+  return static_cast<size_t>(file.tellg());
+}
+} // anonymous namespace
+
+TEST_CASE("Multithreaded image sequence recording", "[video_writer]")
+{
+  const std::string tmp_dir = vpIoTools::makeTempDirectory(vpIoTools::getTempPath() + vpIoTools::path("/") + "visp_test_video_writer");
+  const unsigned int height = 60, width = 80, nb_frames = 25;
+
+  SECTION("PGM sequence")
+  {
+    const std::string videoname = tmp_dir + vpIoTools::path("/grey/I%04d.pgm");
+    recordSequence<unsigned char>(videoname, height, width, nb_frames, 4, -1);
+    checkSequence<unsigned char>(videoname, height, width, nb_frames);
+  }
+
+  SECTION("PNG sequence")
+  {
+    const std::string videoname = tmp_dir + vpIoTools::path("/color/I%04d.png");
+    recordSequence<vpRGBa>(videoname, height, width, nb_frames, 3, 1);
+    checkSequence<vpRGBa>(videoname, height, width, nb_frames);
+  }
+
+  SECTION("Same files as sequential recording")
+  {
+    const std::string videoname_seq = tmp_dir + vpIoTools::path("/seq/I%04d.png");
+    const std::string videoname_mt = tmp_dir + vpIoTools::path("/mt/I%04d.png");
+    recordSequence<unsigned char>(videoname_seq, height, width, nb_frames, 1, 6);
+    recordSequence<unsigned char>(videoname_mt, height, width, nb_frames, 0, 6);
+    for (unsigned int index = 1; index <= nb_frames; ++index) {
+      CHECK(getFileSize(vpIoTools::formatString(videoname_seq, static_cast<int>(index))) ==
+            getFileSize(vpIoTools::formatString(videoname_mt, static_cast<int>(index))));
+    }
+  }
+
+  SECTION("Encoding errors are reported")
+  {
+    const std::string videoname = tmp_dir + vpIoTools::path("/removed/I%04d.pgm");
+    vpImage<unsigned char> I(height, width, 0);
+    vpVideoWriter writer;
+    writer.setFileName(videoname);
+    writer.setNbThreads(2);
+    writer.open(I);
+    vpIoTools::remove(vpIoTools::getParent(videoname));
+    CHECK_THROWS_AS([&]() {
+      for (unsigned int index = 0; index < nb_frames; ++index) {
+        writer.saveFrame(I);
+      }
+      writer.close();
+    }(), vpException);
+  }
+
+  vpIoTools::remove(tmp_dir);
+}
+
+TEST_CASE("PNG compression level", "[video_writer]")
+{
+  const std::string tmp_dir = vpIoTools::makeTempDirectory(vpIoTools::getTempPath() + vpIoTools::path("/") + "visp_test_png_level");
+  vpImage<vpRGBa> I(120, 160), I_read;
+  createFrame(I, 0);
+
+  std::vector<int> backends;
+#if defined(VISP_HAVE_PNG)
+  backends.push_back(vpImageIo::IO_SYSTEM_LIB_BACKEND);
+#endif
+#if defined(VISP_HAVE_STBIMAGE)
+  backends.push_back(vpImageIo::IO_STB_IMAGE_BACKEND);
+#endif
+  for (size_t b = 0; b < backends.size(); ++b) {
+    const std::string filename_fast = tmp_dir + vpIoTools::path("/fast.png");
+    const std::string filename_small = tmp_dir + vpIoTools::path("/small.png");
+    vpImageIo::writePNG(I, filename_fast, backends[b], 0);
+    vpImageIo::writePNG(I, filename_small, backends[b], 9);
+    CHECK(getFileSize(filename_fast) > getFileSize(filename_small));
+
+    vpImageIo::read(I_read, filename_fast);
+    CHECK((I_read == I));
+    vpImageIo::read(I_read, filename_small);
+    CHECK((I_read == I));
+  }
+
+  vpIoTools::remove(tmp_dir);
+}
+
+TEST_CASE("Benchmark image sequence recording", "[video_writer]")
+{
+  if (runBenchmark) {
+    const std::string tmp_dir = vpIoTools::makeTempDirectory(vpIoTools::getTempPath() + vpIoTools::path("/") + "visp_bench_video_writer");
+    const std::string videoname = tmp_dir + vpIoTools::path("/I%04d.png");
+    const unsigned int height = 1080, width = 1920, nb_frames = 30;
+
+    BENCHMARK("Benchmark sequential recording of 30 1080p PNG frames")
+    {
+      recordSequence<vpRGBa>(videoname, height, width, nb_frames, 1, -1);
+      return nb_frames;
+    };
+
+    BENCHMARK("Benchmark sequential recording of 30 1080p PNG frames, compression level 1")
+    {
+      recordSequence<vpRGBa>(videoname, height, width, nb_frames, 1, 1);
+      return nb_frames;
+    };
+
+    BENCHMARK("Benchmark multithreaded recording of 30 1080p PNG frames, compression level 1")
+    {
+      recordSequence<vpRGBa>(videoname, height, width, nb_frames, 0, 1);
+      return nb_frames;
+    };
+
+    vpIoTools::remove(tmp_dir);
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session;
+
+  auto cli = session.cli()         // Get Catch's composite command line parser
+    | Catch::Clara::Opt(runBenchmark)   // bind variable to a new option, with a hint string
+    ["--benchmark"] // the option names it will respond to
+    ("run benchmark comparing sequential and multithreaded recording"); // description string for the help output
+
+  // Now pass the new composite back to Catch so it uses that
+  session.cli(cli);
+  session.applyCommandLine(argc, argv);
+  int numFailed = session.run();
+  return numFailed;
+}
+#else
+int main() { return EXIT_SUCCESS; }
+#endif
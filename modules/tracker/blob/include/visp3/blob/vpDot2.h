@@ -188,7 +188,10 @@ public:
    * \param edges_list : The list of all the images points on the dot
    * border. This list is update after a call to track().
    */
-  void getEdges(std::list<vpImagePoint> &edges_list) const { edges_list = m_ip_edges_list; };
+  void getEdges(std::list<vpImagePoint> &edges_list) const
+  {
+    edges_list.assign(m_ip_edges_list.begin(), m_ip_edges_list.end());
+  };
 
   /*!
    * Return the list of all the image points on the dot
@@ -197,7 +200,16 @@ public:
    * \return The list of all the images points on the dot
    * border. This list is update after a call to track().
    */
-  std::list<vpImagePoint> getEdges() const { return m_ip_edges_list; };
+  std::list<vpImagePoint> getEdges() const { return std::list<vpImagePoint>(m_ip_edges_list.begin(), m_ip_edges_list.end()); };
+
+  /*!
+   * Return the image points on the dot border, stored contiguously in the
+   * same order as the Freeman chain.
+   *
+   * \param edges : The image points on the dot border. This vector is update
+   * after a call to track().
+   */
+  void getEdges(std::vector<vpImagePoint> &edges) const { edges = m_ip_edges_list; }
 
   /*!
    * Get the percentage of sampled points that are considered non conform
@@ -374,6 +386,9 @@ public:
   void track(const vpImage<unsigned char> &I, bool canMakeTheWindowGrow = true);
   void track(const vpImage<unsigned char> &I, vpImagePoint &cog, bool canMakeTheWindowGrow = true);
 
+  static unsigned int trackDots(vpDot2 dot[], const unsigned int &n, const vpImage<unsigned char> &I,
+                                std::vector<bool> &tracked, bool canMakeTheWindowGrow = true);
+
   static void trackAndDisplay(vpDot2 dot[], const unsigned int &n, vpImage<unsigned char> &I,
                               std::vector<vpImagePoint> &cogs, vpImagePoint *cogStar = nullptr);
 
@@ -497,7 +512,8 @@ private:
 
   bool isInArea(const unsigned int &u, const unsigned int &v) const;
 
-  void getGridSize(unsigned int &gridWidth, unsigned int &gridHeight);
+  void computeGerms(const vpImage<unsigned char> &I, std::vector<unsigned int> &germs_u,
+                    std::vector<unsigned int> &germs_v);
   void setArea(const vpImage<unsigned char> &I, int u, int v, unsigned int w, unsigned int h);
   void setArea(const vpImage<unsigned char> &I);
   void setArea(const vpRect &a);
@@ -548,8 +564,8 @@ private:
   vpRect m_area;
 
   // other
-  std::list<unsigned int> m_direction_list;
-  std::list<vpImagePoint> m_ip_edges_list;
+  std::vector<unsigned int> m_direction_list;
+  std::vector<vpImagePoint> m_ip_edges_list;
 
   // flag
   bool m_compute_moment; // true moment are computed
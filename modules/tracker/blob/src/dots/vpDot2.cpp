@@ -44,6 +44,7 @@
 #include <visp3/core/vpTrackingException.h>
 
 #include <cmath> // std::fabs
+#include <exception>
 #include <iostream>
 #include <limits> // numeric_limits
 #include <math.h>
@@ -227,9 +228,9 @@ void vpDot2::display(const vpImage<unsigned char> &I, vpColor color, unsigned in
   const unsigned int val_3 = 3;
   const unsigned int val_8 = 8;
   vpDisplay::displayCross(I, m_cog, (val_3 * t) + val_8, color, t);
-  std::list<vpImagePoint>::const_iterator it;
+  std::vector<vpImagePoint>::const_iterator it;
 
-  std::list<vpImagePoint>::const_iterator ip_edges_list_end = m_ip_edges_list.end();
+  std::vector<vpImagePoint>::const_iterator ip_edges_list_end = m_ip_edges_list.end();
   for (it = m_ip_edges_list.begin(); it != ip_edges_list_end; ++it) {
     vpDisplay::displayPoint(I, *it, color);
   }
@@ -1581,32 +1582,6 @@ bool vpDot2::isInArea(const unsigned int &u, const unsigned int &v) const
   return true;
 }
 
-/*!
-  Get the search grid size used to found a dot in a region of interest. This
-  grid is used to parse only some pixels of the search area.
-
-  \param gridWidth : Number of pixels between to vertical lines of the grid
-
-  \param gridHeight : Number of pixels between to horizontal lines of the grid
-*/
-void vpDot2::getGridSize(unsigned int &gridWidth, unsigned int &gridHeight)
-{
-  // first get the research grid width and height Note that
-  // 1/sqrt(2)=cos(pi/4). The grid squares should be small enough to be
-  // contained in the dot. We gent this here if the dot is a perfect disc.
-  // More accurate criterium to define the grid should be implemented if
-  // necessary
-  gridWidth = static_cast<unsigned int>((getWidth() * getMaxSizeSearchDistPrecision()) / sqrt(2.));
-  gridHeight = static_cast<unsigned int>((getHeight() * getMaxSizeSearchDistPrecision()) / sqrt(2.0));
-
-  if (gridWidth == 0) {
-    gridWidth = 1;
-  }
-  if (gridHeight == 0) {
-    gridHeight = 1;
-  }
-}
-
 /*!
   Compute an approximation of  mean gray level of the dot.
   We compute it by searching the mean of vertical and diagonal points
@@ -1804,6 +1779,133 @@ vpMatrix vpDot2::defineDots(vpDot2 dot[], const unsigned int &n, const std::stri
   return Cogs;
 }
 
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace
+{
+// Disable the graphics of a batch of dots and restore them when leaving the scope, even on exception
+class vpDot2GraphicsGuard
+{
+public:
+  vpDot2GraphicsGuard(vpDot2 dot[], unsigned int n, const std::vector<unsigned char> &graphics)
+    : m_dot(dot), m_n(n), m_graphics(graphics)
+  {
+    for (unsigned int i = 0; i < m_n; ++i) {
+      m_dot[i].setGraphics(false);
+    }
+  }
+
+  ~vpDot2GraphicsGuard()
+  {
+    for (unsigned int i = 0; i < m_n; ++i) {
+      m_dot[i].setGraphics(m_graphics[i] != 0);
+    }
+  }
+
+  vpDot2GraphicsGuard(const vpDot2GraphicsGuard &) = delete; // non construction-copyable
+  vpDot2GraphicsGuard &operator=(const vpDot2GraphicsGuard &) = delete; // non copyable
+
+private:
+  vpDot2 *m_dot;
+  unsigned int m_n;
+  const std::vector<unsigned char> &m_graphics;
+};
+} // namespace
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+/*!
+  Track a batch of dots in the same image.
+
+  Each dot is tracked as with track(), but since tracking a dot only modifies
+  its own state, the dots are processed in parallel when ViSP is built with
+  OpenMP. A dot that is lost doesn't interrupt the tracking of the other ones:
+  its status is returned in \e tracked and its parameters are the ones left by
+  track() when it throws a vpTrackingException, see track().
+
+  When the graphics of a dot are enabled with setGraphics(), its border and a
+  cross at its center of gravity are drawn as with track(), but once all the
+  dots are tracked since displays can not be drawn concurrently.
+
+  \param dot : Array of dots to track.
+  \param n : Number of dots in the array.
+  \param I : Image to process.
+  \param tracked : Resized to \e n. The i-th element is set to true if the
+  i-th dot is tracked, and false if it is lost.
+  \param canMakeTheWindowGrow : If true, the size of the area in which a lost
+  dot is searched is increased, see track().
+
+  \return The number of dots that are tracked.
+*/
+unsigned int vpDot2::trackDots(vpDot2 dot[], const unsigned int &n, const vpImage<unsigned char> &I,
+                               std::vector<bool> &tracked, bool canMakeTheWindowGrow)
+{
+  // std::vector<bool> can not be written concurrently
+  std::vector<unsigned char> status(n, 0);
+  std::vector<unsigned char> graphics(n, 0);
+  for (unsigned int i = 0; i < n; ++i) {
+    graphics[i] = dot[i].m_graphics ? 1 : 0;
+  }
+
+  {
+    vpDot2GraphicsGuard guard(dot, n, graphics);
+    const int nb_dots = static_cast<int>(n);
+#ifdef VISP_HAVE_OPENMP
+    std::vector<std::exception_ptr> exceptions(n);
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int i = 0; i < nb_dots; ++i) {
+      vpDot2 &d = dot[i];
+#ifdef VISP_HAVE_OPENMP
+      try {
+#endif
+        try {
+          d.track(I, canMakeTheWindowGrow);
+          status[static_cast<unsigned int>(i)] = 1;
+        }
+        catch (const vpTrackingException &) {
+          status[static_cast<unsigned int>(i)] = 0;
+        }
+#ifdef VISP_HAVE_OPENMP
+      }
+      catch (...) {
+        exceptions[static_cast<unsigned int>(i)] = std::current_exception();
+      }
+#endif
+    }
+#ifdef VISP_HAVE_OPENMP
+    for (unsigned int i = 0; i < n; ++i) {
+      if (exceptions[i]) {
+        std::rethrow_exception(exceptions[i]);
+      }
+    }
+#endif
+  }
+
+  unsigned int nb_tracked = 0;
+  tracked.resize(n);
+  for (unsigned int i = 0; i < n; ++i) {
+    tracked[i] = (status[i] != 0);
+    if (tracked[i]) {
+      ++nb_tracked;
+    }
+  }
+
+  const unsigned int val_3 = 3;
+  const unsigned int val_8 = 8;
+  for (unsigned int i = 0; i < n; ++i) {
+    if (graphics[i] && tracked[i]) {
+      const vpDot2 &d = dot[i];
+      std::vector<vpImagePoint>::const_iterator ip_edges_list_end = d.m_ip_edges_list.end();
+      for (std::vector<vpImagePoint>::const_iterator it = d.m_ip_edges_list.begin(); it != ip_edges_list_end; ++it) {
+        for (unsigned int t = 0; t < d.m_thickness; ++t) {
+          vpDisplay::displayPoint(I, vpImagePoint(it->get_v(), it->get_u() + t), vpColor::red);
+        }
+      }
+      vpDisplay::displayCross(I, d.m_cog, (val_3 * d.m_thickness) + val_8, vpColor::red, d.m_thickness);
+    }
+  }
+  return nb_tracked;
+}
+
 /*!
   Tracks a number of dots in an image and displays their trajectories
 
@@ -1824,8 +1926,11 @@ void vpDot2::trackAndDisplay(vpDot2 dot[], const unsigned int &n, vpImage<unsign
                              std::vector<vpImagePoint> &cogs, vpImagePoint *cogStar)
 {
   // tracking
+  std::vector<bool> tracked;
+  if (trackDots(dot, n, I, tracked) != n) {
+    throw(vpTrackingException(vpTrackingException::featureLostError, "No dot was found"));
+  }
   for (unsigned int i = 0; i < n; ++i) {
-    dot[i].track(I);
     cogs.push_back(dot[i].getCog());
   }
   // trajectories
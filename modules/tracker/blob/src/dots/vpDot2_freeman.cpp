@@ -136,7 +136,10 @@ void computeDownLeftWithMoment(const int &u_p, const int &v_p, float &dMuv, floa
   - 6 : down
   - 7 : down right
 */
-void vpDot2::getFreemanChain(std::list<unsigned int> &freeman_chain) const { freeman_chain = m_direction_list; }
+void vpDot2::getFreemanChain(std::list<unsigned int> &freeman_chain) const
+{
+  freeman_chain.assign(m_direction_list.begin(), m_direction_list.end());
+}
 
 /*!
 
@@ -37,6 +37,21 @@
 
 BEGIN_VISP_NAMESPACE
 
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace
+{
+// Return the root of a label in the union-find forest, with path halving
+unsigned int findRoot(std::vector<unsigned int> &parent, unsigned int label)
+{
+  while (parent[label] != label) {
+    parent[label] = parent[parent[label]];
+    label = parent[label];
+  }
+  return label;
+}
+} // namespace
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
 /**
  * \brief Performs the research of dots in the area when the point u, v is a good germ.
  *
@@ -67,7 +82,7 @@ BEGIN_VISP_NAMESPACE
     while ((itbad != data.m_badDotsVector.end()) && (good_germ == true)) {
       if ((static_cast<double>(data.m_u) >= (*itbad).m_bbox_u_min) && (static_cast<double>(data.m_u) <= (*itbad).m_bbox_u_max) &&
           (static_cast<double>(data.m_v) >= (*itbad).m_bbox_v_min) && (static_cast<double>(data.m_v) <= (*itbad).m_bbox_v_max)) {
-        std::list<vpImagePoint>::const_iterator it_edges = m_ip_edges_list.begin();
+        std::vector<vpImagePoint>::const_iterator it_edges = m_ip_edges_list.begin();
         while ((it_edges != m_ip_edges_list.end()) && (good_germ == true)) {
           // Test if the germ belong to a previously detected dot:
           // - from the germ go right to the border and compare this
@@ -199,6 +214,93 @@ BEGIN_VISP_NAMESPACE
   }
 }
 
+/*!
+  Label the connected components of the pixels of the search area having the
+  right gray level (see hasGoodLevel()), and return one germ per component.
+
+  The labeling is done in a single raster sweep that only keeps the labels of
+  the current and previous rows, equivalences between labels being resolved
+  with a union-find structure. Since labels are created in raster order, the
+  germ of a component is its first pixel in raster order, i.e. the leftmost
+  pixel of its top row. This pixel is on the outer border of the component,
+  so that the dot border found from it is never the border of a hole. Pixels
+  are 8-connected, as for the Freeman chain used to follow the dot border.
+
+  \param I : Image to process.
+  \param germs_u : Column coordinates of the germs, sorted in raster order.
+  \param germs_v : Row coordinates of the germs, sorted in raster order.
+*/
+void vpDot2::computeGerms(const vpImage<unsigned char> &I, std::vector<unsigned int> &germs_u,
+                          std::vector<unsigned int> &germs_v)
+{
+  germs_u.clear();
+  germs_v.clear();
+
+  const unsigned int area_u_min = static_cast<unsigned int>(m_area.getLeft());
+  const unsigned int area_u_max = static_cast<unsigned int>(m_area.getRight());
+  const unsigned int area_v_min = static_cast<unsigned int>(m_area.getTop());
+  const unsigned int area_v_max = static_cast<unsigned int>(m_area.getBottom());
+  if ((area_u_max <= area_u_min) || (area_v_max <= area_v_min)) {
+    return;
+  }
+  const unsigned int width = area_u_max - area_u_min;
+
+  // Label 0 is the background. Rows are padded with a background label on
+  // both sides to avoid testing the area boundaries.
+  std::vector<unsigned int> prev_row(width + 2, 0), cur_row(width + 2, 0);
+  std::vector<unsigned int> parent(1, 0);
+
+  for (unsigned int v = area_v_min; v < area_v_max; ++v) {
+    for (unsigned int c = 0; c < width; ++c) {
+      const unsigned int u = area_u_min + c;
+      unsigned int label = 0;
+      if (hasGoodLevel(I, u, v)) {
+        // Already labeled 8-neighbors: left, up-left, up and up-right
+        const unsigned int neighbors[4] = { cur_row[c], prev_row[c], prev_row[c + 1], prev_row[c + 2] };
+        for (unsigned int k = 0; k < 4; ++k) {
+          if (neighbors[k] != 0) {
+            if (label == 0) {
+              label = neighbors[k];
+            }
+            else {
+              // Merge the two components, the root being the oldest label
+              unsigned int root_a = findRoot(parent, label);
+              unsigned int root_b = findRoot(parent, neighbors[k]);
+              if (root_a < root_b) {
+                parent[root_b] = root_a;
+              }
+              else {
+                parent[root_a] = root_b;
+              }
+            }
+          }
+        }
+        if (label == 0) {
+          label = static_cast<unsigned int>(parent.size());
+          parent.push_back(label);
+          germs_u.push_back(u);
+          germs_v.push_back(v);
+        }
+      }
+      cur_row[c + 1] = label;
+    }
+    prev_row.swap(cur_row);
+  }
+
+  // Keep the germs of the root labels, that are the first pixels of the components
+  size_t nb_germs = 0;
+  const size_t nb_labels = parent.size();
+  for (size_t label = 1; label < nb_labels; ++label) {
+    if (parent[label] == label) {
+      germs_u[nb_germs] = germs_u[label - 1];
+      germs_v[nb_germs] = germs_v[label - 1];
+      ++nb_germs;
+    }
+  }
+  germs_u.resize(nb_germs);
+  germs_v.resize(nb_germs);
+}
+
 /*!
 
   Look for a list of dot matching this dot parameters within a region of
@@ -232,11 +334,6 @@ void vpDot2::searchDotsInArea(const vpImage<unsigned char> &I, int area_u, int a
   // this area and the image.
   setArea(I, area_u, area_v, area_w, area_h);
 
-  // compute the size of the search grid
-  unsigned int gridWidth;
-  unsigned int gridHeight;
-  getGridSize(gridWidth, gridHeight);
-
   if (m_graphics) {
     // Display the area were the dot is search
     vpDisplay::displayRectangle(I, m_area, vpColor::blue, false, m_thickness);
@@ -246,61 +343,48 @@ void vpDot2::searchDotsInArea(const vpImage<unsigned char> &I, int area_u, int a
   vpDisplay::displayRectangle(I, m_area, vpColor::blue);
   vpDisplay::flush(I);
 #endif
-  // start the search loop; for all points of the search grid,
-  // test if the pixel belongs to a valid dot.
+  // Label in a single sweep the connected components of pixels having the
+  // right gray level, and keep one germ per component
+  std::vector<unsigned int> germs_u, germs_v;
+  computeGerms(I, germs_u, germs_v);
+
+  // for all the germs, test if the component is a valid dot.
   // if it is so eventually add it to the vector of valid dots.
   std::list<vpDot2> badDotsVector;
-  std::list<vpDot2>::iterator itnice;
-
-  vpDot2 tmpDot;
-
-  unsigned int area_u_min = static_cast<unsigned int>(m_area.getLeft());
-  unsigned int area_u_max = static_cast<unsigned int>(m_area.getRight());
-  unsigned int area_v_min = static_cast<unsigned int>(m_area.getTop());
-  unsigned int area_v_max = static_cast<unsigned int>(m_area.getBottom());
-
-  unsigned int u, v;
+  std::list<vpDot2>::const_iterator itnice;
   vpImagePoint cogTmpDot;
 
-  v = area_v_min;
-  while (v < area_v_max) {
-    u = area_u_min;
-    while (u < area_u_max) {
-      // if the pixel we're in doesn't have the right color (outside the
-      // graylevel interval), no need to check further, just get to the
-      // next grid intersection.
-      if (hasGoodLevel(I, u, v)) {
+  const size_t nb_germs = germs_u.size();
+  for (size_t n = 0; n < nb_germs; ++n) {
+    unsigned int u = germs_u[n];
+    unsigned int v = germs_v[n];
 
-        // Test if an other germ is inside the bounding box of a dot previously
-        // detected
-        bool good_germ = true;
+    // Test if the germ is inside the bounding box of a dot previously
+    // detected
+    bool good_germ = true;
 
-        itnice = niceDots.begin();
-        while ((itnice != niceDots.end()) && (good_germ == true)) {
-          tmpDot = *itnice;
+    itnice = niceDots.begin();
+    while ((itnice != niceDots.end()) && (good_germ == true)) {
+      const vpDot2 &tmpDot = *itnice;
 
-          cogTmpDot = tmpDot.getCog();
-          double u0 = cogTmpDot.get_u();
-          double v0 = cogTmpDot.get_v();
-          double half_w = tmpDot.getWidth() / 2.;
-          double half_h = tmpDot.getHeight() / 2.;
+      cogTmpDot = tmpDot.getCog();
+      double u0 = cogTmpDot.get_u();
+      double v0 = cogTmpDot.get_v();
+      double half_w = tmpDot.getWidth() / 2.;
+      double half_h = tmpDot.getHeight() / 2.;
 
-          if ((u >= (u0 - half_w)) && (u <= (u0 + half_w)) && (v >= (v0 - half_h)) && (v <= (v0 + half_h))) {
-            // Germ is in a previously detected dot
-            good_germ = false;
-          }
-          ++itnice;
-        }
-
-        if (good_germ) {
-          vpRect area(area_u, area_v, area_w, area_h);
-          vpSearchDotsInAreaGoodGermData data(I, area, u, v, niceDots, badDotsVector);
-          searchDotsAreaGoodGerm(data);
-        }
+      if ((u >= (u0 - half_w)) && (u <= (u0 + half_w)) && (v >= (v0 - half_h)) && (v <= (v0 + half_h))) {
+        // Germ is in a previously detected dot
+        good_germ = false;
       }
-      u = u + gridWidth;
+      ++itnice;
+    }
+
+    if (good_germ) {
+      vpRect area(area_u, area_v, area_w, area_h);
+      vpSearchDotsInAreaGoodGermData data(I, area, u, v, niceDots, badDotsVector);
+      searchDotsAreaGoodGerm(data);
     }
-    v = v + gridHeight;
   }
 }
 
@@ -0,0 +1,253 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2024 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ *
+ * Description:
+ * Test and benchmark batch tracking and search of vpDot2 blobs.
+ */
+
+/*!
+  \example perfDot2Tracking.cpp
+
+  \brief Test and benchmark batch tracking of many vpDot2 blobs and search of
+  blobs in the whole image.
+ */
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2)
+
+#include <list>
+#include <vector>
+
+#include <catch_amalgamated.hpp>
+#include <visp3/blob/vpDot2.h>
+#include <visp3/core/vpImagePoint.h>
+#include <visp3/core/vpMath.h>
+
+#ifdef ENABLE_VISP_NAMESPACE
+using namespace VISP_NAMESPACE_NAME;
+#endif
+
+static bool runBenchmark = false;
+
+namespace
+{
+const unsigned int nb_rows = 10, nb_cols = 15;
+const double radius = 7.5;
+
+// Grid of bright disks on a dark background, shifted by (du, dv)
+void createImage(vpImage<unsigned char> &I, std::vector<vpImagePoint> &centers, double du, double dv)
+{
+  I.resize(520, 640, 20);
+  centers.clear();
+  for (unsigned int r = 0; r < nb_rows; ++r) {
+    for (unsigned int c = 0; c < nb_cols; ++c) {
+      vpImagePoint center(40. + (r * 44.) + dv + (0.13 * c), 30. + (c * 40.) + du + (0.21 * r));
+      centers.push_back(center);
+      for (int i = -10; i <= 10; ++i) {
+        for (int j = -10; j <= 10; ++j) {
+          int v = static_cast<int>(center.get_i()) + i;
+          int u = static_cast<int>(center.get_j()) + j;
+          if (vpMath::sqr(v - center.get_i()) + vpMath::sqr(u - center.get_j()) <= vpMath::sqr(radius)) {
+            I[v][u] = 230;
+          }
+        }
+      }
+    }
+  }
+}
+
+// A ring, i.e. a dot with a hole, and a large bright area that are not valid dots
+void addDistractors(vpImage<unsigned char> &I)
+{
+  for (unsigned int i = 470; i < 500; ++i) {
+    for (unsigned int j = 20; j < 300; ++j) {
+      I[i][j] = 230;
+    }
+  }
+  for (int i = -12; i <= 12; ++i) {
+    for (int j = -12; j <= 12; ++j) {
+      double d2 = (i * i) + (j * j);
+      if ((d2 <= 144) && (d2 >= 36)) {
+        I[485 + i][450 + j] = 230;
+      }
+    }
+  }
+}
+
+std::vector<vpDot2> initDots(const vpImage<unsigned char> &I, const std::vector<vpImagePoint> &centers)
+{
+  std::vector<vpDot2> dots(centers.size());
+  for (size_t n = 0; n < centers.size(); ++n) {
+    dots[n].setGraphics(false);
+    dots[n].initTracking(I, vpImagePoint(vpMath::round(centers[n].get_i()), vpMath::round(centers[n].get_j())), 128,
+                         255);
+  }
+  return dots;
+}
+} // anonymous namespace
+
+TEST_CASE("Batch tracking of dots", "[dot2]")
+{
+  vpImage<unsigned char> I0, I1;
+  std::vector<vpImagePoint> centers0, centers1;
+  createImage(I0, centers0, 0, 0);
+  createImage(I1, centers1, 2.6, -1.7);
+
+  std::vector<vpDot2> dots = initDots(I0, centers0);
+  std::vector<vpDot2> dots_ref = dots;
+
+  std::vector<bool> tracked;
+  CHECK(vpDot2::trackDots(dots.data(), static_cast<unsigned int>(dots.size()), I1, tracked) == dots.size());
+  REQUIRE(tracked.size() == dots.size());
+  for (size_t n = 0; n < dots.size(); ++n) {
+    CHECK(tracked[n]);
+    // Same results as sequential tracking
+    dots_ref[n].track(I1);
+    CHECK(dots[n].getCog() == dots_ref[n].getCog());
+    CHECK(dots[n].getArea() == Catch::Approx(dots_ref[n].getArea()));
+    CHECK(vpImagePoint::distance(dots[n].getCog(), centers1[n]) < 0.5);
+
+    std::list<vpImagePoint> edges_list;
+    std::vector<vpImagePoint> edges;
+    dots[n].getEdges(edges_list);
+    dots[n].getEdges(edges);
+    CHECK(edges.size() == edges_list.size());
+    CHECK(edges.front() == edges_list.front());
+    CHECK(edges.back() == edges_list.back());
+  }
+
+  SECTION("Lost dots do not prevent other dots from being tracked")
+  {
+    vpImage<unsigned char> I2(I1);
+    // Remove the first dot
+    for (unsigned int i = 20; i < 60; ++i) {
+      for (unsigned int j = 10; j < 60; ++j) {
+        I2[i][j] = 20;
+      }
+    }
+    const vpImagePoint cog_lost = dots[0].getCog();
+    CHECK(vpDot2::trackDots(dots.data(), static_cast<unsigned int>(dots.size()), I2, tracked) == dots.size() - 1);
+    CHECK_FALSE(tracked[0]);
+    CHECK(dots[0].getCog() == cog_lost);
+    for (size_t n = 1; n < dots.size(); ++n) {
+      CHECK(tracked[n]);
+    }
+  }
+}
+
+TEST_CASE("Search dots in the whole image", "[dot2]")
+{
+  vpImage<unsigned char> I;
+  std::vector<vpImagePoint> centers;
+  createImage(I, centers, 0.4, 0.3);
+  addDistractors(I);
+
+  vpDot2 blob;
+  blob.setWidth(2 * radius);
+  blob.setHeight(2 * radius);
+  blob.setArea(M_PI * radius * radius);
+  blob.setGrayLevelMin(128);
+  blob.setGrayLevelMax(255);
+  blob.setGrayLevelPrecision(0.8);
+  blob.setSizePrecision(0.65);
+  blob.setEllipsoidShapePrecision(0.65);
+
+  std::list<vpDot2> dots;
+  blob.searchDotsInArea(I, 0, 0, I.getWidth(), I.getHeight(), dots);
+  CHECK(dots.size() == centers.size());
+
+  // Each disk is found once, dots being sorted by distance to the area center
+  const vpImagePoint area_center((I.getHeight() / 2.) - 0.5, (I.getWidth() / 2.) - 0.5);
+  std::vector<unsigned int> nb_found(centers.size(), 0);
+  double prev_distance = 0.;
+  for (std::list<vpDot2>::const_iterator it = dots.begin(); it != dots.end(); ++it) {
+    for (size_t n = 0; n < centers.size(); ++n) {
+      if (vpImagePoint::distance(it->getCog(), centers[n]) < 0.5) {
+        ++nb_found[n];
+      }
+    }
+    double distance = vpImagePoint::distance(it->getCog(), area_center);
+    CHECK(distance >= prev_distance);
+    prev_distance = distance;
+  }
+  for (size_t n = 0; n < centers.size(); ++n) {
+    CHECK(nb_found[n] == 1);
+  }
+
+  if (runBenchmark) {
+    BENCHMARK("Benchmark search of 150 dots in a 640x520 image")
+    {
+      blob.searchDotsInArea(I, 0, 0, I.getWidth(), I.getHeight(), dots);
+      return dots.size();
+    };
+
+    vpImage<unsigned char> I1;
+    std::vector<vpImagePoint> centers1;
+    createImage(I1, centers1, 1.3, 0.8);
+    const std::vector<vpDot2> dots_init = initDots(I, centers);
+
+    std::vector<vpDot2> dots_tracked;
+    BENCHMARK("Benchmark sequential tracking of 150 dots")
+    {
+      dots_tracked = dots_init;
+      for (size_t n = 0; n < dots_tracked.size(); ++n) {
+        dots_tracked[n].track(I1);
+      }
+      return dots_tracked.size();
+    };
+
+    std::vector<bool> tracked;
+    BENCHMARK("Benchmark batch tracking of 150 dots")
+    {
+      dots_tracked = dots_init;
+      return vpDot2::trackDots(dots_tracked.data(), static_cast<unsigned int>(dots_tracked.size()), I1, tracked);
+    };
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session;
+
+  auto cli = session.cli()         // Get Catch's composite command line parser
+    | Catch::Clara::Opt(runBenchmark)   // bind variable to a new option, with a hint string
+    ["--benchmark"] // the option names it will respond to
+    ("run benchmark of batch dot tracking and search"); // description string for the help output
+
+  // Now pass the new composite back to Catch so it uses that
+  session.cli(cli);
+  session.applyCommandLine(argc, argv);
+  int numFailed = session.run();
+  return numFailed;
+}
+#else
+int main() { return EXIT_SUCCESS; }
+#endif
@@ -117,10 +117,14 @@ public:
   virtual void track(const pcl::PointCloud<pcl::PointXYZ>::ConstPtr &point_cloud);
 #endif
   virtual void track(const std::vector<vpColVector> &point_cloud, unsigned int width, unsigned int height);
+  virtual void track(const vpPointCloud &point_cloud);
+  virtual void track(const vpImage<uint16_t> &depth_raw, float depth_scale);
 
 protected:
   //! Set of faces describing the object used only for display with scan line.
   vpMbHiddenFaces<vpMbtPolygon> m_depthDenseHiddenFacesDisplay;
+  //! True if faces have been added since the copy used for display was made
+  bool m_depthDenseHiddenFacesDisplayOutdated;
   //! List of current active (visible and features extracted) faces
   std::vector<vpMbtFaceDepthDense *> m_depthDenseListOfActiveFaces;
   //! Nb features
@@ -171,6 +175,12 @@ protected:
 #endif
   void segmentPointCloud(const std::vector<vpColVector> &point_cloud, unsigned int width, unsigned int height);
   void segmentPointCloud(const vpMatrix &point_cloud, unsigned int width, unsigned int height);
+  void segmentPointCloud(const vpPointCloud &point_cloud);
+  void segmentPointCloud(const vpImage<uint16_t> &depth_raw, float depth_scale);
+
+private:
+  template <class FaceFeatures>
+  void segmentFaces(unsigned int width, unsigned int height, const FaceFeatures &computeFaceFeatures);
 };
 END_VISP_NAMESPACE
 #endif
@@ -119,12 +119,16 @@ public:
   virtual void track(const pcl::PointCloud<pcl::PointXYZ>::ConstPtr &point_cloud);
 #endif
   virtual void track(const std::vector<vpColVector> &point_cloud, unsigned int width, unsigned int height);
+  virtual void track(const vpPointCloud &point_cloud);
+  virtual void track(const vpImage<uint16_t> &depth_raw, float depth_scale);
 
 protected:
   //! Method to estimate the desired features
   vpMbtFaceDepthNormal::vpFeatureEstimationType m_depthNormalFeatureEstimationMethod;
   //! Set of faces describing the object used only for display with scan line.
   vpMbHiddenFaces<vpMbtPolygon> m_depthNormalHiddenFacesDisplay;
+  //! True if faces have been added since the copy used for display was made
+  bool m_depthNormalHiddenFacesDisplayOutdated;
   //! List of current active (visible and with features extracted) faces
   std::vector<vpMbtFaceDepthNormal *> m_depthNormalListOfActiveFaces;
   //! List of desired features
@@ -185,6 +189,12 @@ protected:
 #endif
   void segmentPointCloud(const std::vector<vpColVector> &point_cloud, unsigned int width, unsigned int height);
   void segmentPointCloud(const vpMatrix &point_cloud, unsigned int width, unsigned int height);
+  void segmentPointCloud(const vpPointCloud &point_cloud);
+  void segmentPointCloud(const vpImage<uint16_t> &depth_raw, float depth_scale);
+
+private:
+  template <class FaceFeatures>
+  void segmentFaces(unsigned int width, unsigned int height, const FaceFeatures &computeFaceFeatures);
 };
 END_VISP_NAMESPACE
 #endif
@@ -45,6 +45,7 @@
 #include <visp3/mbt/vpMbtDistanceCircle.h>
 #include <visp3/mbt/vpMbtDistanceCylinder.h>
 #include <visp3/mbt/vpMbtDistanceLine.h>
+#include <visp3/mbt/vpMbtLineIndex.h>
 #include <visp3/mbt/vpMbtMeLine.h>
 #include <visp3/me/vpMe.h>
 
@@ -256,6 +257,8 @@ protected:
   //! of moving edges). Each element of the vector is for a scale (element 0 =
   //! level 0 = no subsampling).
   std::vector<std::list<vpMbtDistanceLine *> > lines;
+  //! Index of the lines of each scale by their extremities, used by addLine()
+  std::vector<vpMbtLineIndex> m_linesIndex;
 
   //! Vector of the tracked circles.
   std::vector<std::list<vpMbtDistanceCircle *> > circles;
@@ -262,6 +262,8 @@ public:
   virtual vpMbHiddenFaces<vpMbtPolygon> &getFaces() VP_OVERRIDE;
   virtual vpMbHiddenFaces<vpMbtPolygon> &getFaces(const std::string &cameraName);
 
+  virtual const vpMbtModel &getModel() const VP_OVERRIDE;
+
 #if defined(VISP_HAVE_MODULE_KLT) && defined(VISP_HAVE_OPENCV) && defined(HAVE_OPENCV_IMGPROC) && defined(HAVE_OPENCV_VIDEO)
   virtual std::list<vpMbtDistanceCircle *> &getFeaturesCircle();
   virtual std::list<vpMbtDistanceKltCylinder *> &getFeaturesKltCylinder();
@@ -344,6 +346,13 @@ public:
   virtual unsigned int getNbPolygon() const VP_OVERRIDE;
   virtual void getNbPolygon(std::map<std::string, unsigned int> &mapOfNbPolygons) const;
 
+  /*!
+   * Return true if the cameras are processed concurrently during tracking.
+   *
+   * \sa setParallelCameraTracking()
+   */
+  virtual inline bool getParallelCameraTracking() const { return m_parallelCameraTracking; }
+
   virtual vpMbtPolygon *getPolygon(unsigned int index) VP_OVERRIDE;
   virtual vpMbtPolygon *getPolygon(const std::string &cameraName, unsigned int index);
 
@@ -437,6 +446,7 @@ public:
   virtual void
     loadModel(const std::map<std::string, std::string> &mapOfModelFiles, bool verbose = false,
       const std::map<std::string, vpHomogeneousMatrix> &mapOfT = std::map<std::string, vpHomogeneousMatrix>());
+  virtual void loadModel(const vpMbtModel &model, const vpHomogeneousMatrix &T = vpHomogeneousMatrix()) VP_OVERRIDE;
 
   virtual void reInitModel(const vpImage<unsigned char> &I, const std::string &cad_name, const vpHomogeneousMatrix &cMo,
     bool verbose = false, const vpHomogeneousMatrix &T = vpHomogeneousMatrix());
@@ -509,12 +519,12 @@ public:
 
   virtual void setFeatureFactors(const std::map<vpTrackerType, double> &mapOfFeatureFactors);
 
+  virtual void setFrustumCullingVisibilityTest(const bool &v) VP_OVERRIDE;
+
   virtual void setGoodMovingEdgesRatioThreshold(double threshold);
 
-#ifdef VISP_HAVE_OGRE
   virtual void setGoodNbRayCastingAttemptsRatio(const double &ratio);
   virtual void setNbRayCastingAttemptsForVisibility(const unsigned int &attempts);
-#endif
 
 #if defined(VISP_HAVE_MODULE_KLT) && defined(VISP_HAVE_OPENCV) && defined(HAVE_OPENCV_IMGPROC) && defined(HAVE_OPENCV_VIDEO)
   virtual void setKltMaskBorder(const unsigned int &e);
@@ -548,6 +558,8 @@ public:
 
   virtual void setOptimizationMethod(const vpMbtOptimizationMethod &opt) VP_OVERRIDE;
 
+  virtual void setParallelCameraTracking(bool parallel);
+
   virtual void setPose(const vpImage<unsigned char> &I, const vpHomogeneousMatrix &cdMo) VP_OVERRIDE;
   virtual void setPose(const vpImage<vpRGBa> &I_color, const vpHomogeneousMatrix &cdMo) VP_OVERRIDE;
 
@@ -567,6 +579,8 @@ public:
   virtual void setProjectionErrorDisplayArrowLength(unsigned int length) VP_OVERRIDE;
   virtual void setProjectionErrorDisplayArrowThickness(unsigned int thickness) VP_OVERRIDE;
 
+  virtual void setRayCastingVisibilityTest(const bool &v) VP_OVERRIDE;
+
   virtual void setReferenceCameraName(const std::string &referenceCameraName);
 
   virtual void setScanLineVisibilityTest(const bool &v) VP_OVERRIDE;
@@ -617,6 +631,16 @@ public:
     std::map<std::string, unsigned int> &mapOfPointCloudWidths,
     std::map<std::string, unsigned int> &mapOfPointCloudHeights);
 
+  virtual void track(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages,
+    std::map<std::string, const vpPointCloud *> &mapOfPointClouds);
+  virtual void track(std::map<std::string, const vpImage<vpRGBa> *> &mapOfColorImages,
+    std::map<std::string, const vpPointCloud *> &mapOfPointClouds);
+
+  virtual void track(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages,
+    std::map<std::string, const vpImage<uint16_t> *> &mapOfDepthImages, float depth_scale);
+  virtual void track(std::map<std::string, const vpImage<vpRGBa> *> &mapOfColorImages,
+    std::map<std::string, const vpImage<uint16_t> *> &mapOfDepthImages, float depth_scale);
+
 protected:
   virtual void computeProjectionError();
 
@@ -653,11 +677,24 @@ protected:
     std::map<std::string, const std::vector<vpColVector> *> &mapOfPointClouds,
     std::map<std::string, unsigned int> &mapOfPointCloudWidths,
     std::map<std::string, unsigned int> &mapOfPointCloudHeights);
+#if defined(VISP_HAVE_PCL) && defined(VISP_HAVE_PCL_COMMON)
+  virtual void postTracking(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages,
+    std::map<std::string, pcl::PointCloud<pcl::PointXYZ>::ConstPtr> &mapOfPointClouds);
+#endif
+  virtual void postTracking(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages,
+    std::map<std::string, unsigned int> &mapOfPointCloudWidths,
+    std::map<std::string, unsigned int> &mapOfPointCloudHeights);
+
   virtual void preTracking(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages,
     std::map<std::string, const vpMatrix *> &mapOfPointClouds,
     std::map<std::string, unsigned int> &mapOfPointCloudWidths,
     std::map<std::string, unsigned int> &mapOfPointCloudHeights);
 
+  virtual void preTracking(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages,
+    std::map<std::string, const vpPointCloud *> &mapOfPointClouds);
+  virtual void preTracking(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages,
+    std::map<std::string, const vpImage<uint16_t> *> &mapOfDepthImages, float depth_scale);
+
 private:
   class TrackerWrapper : public vpMbEdgeTracker,
 #if defined(VISP_HAVE_MODULE_KLT) && defined(VISP_HAVE_OPENCV) && defined(HAVE_OPENCV_IMGPROC) && defined(HAVE_OPENCV_VIDEO)
@@ -774,6 +811,8 @@ private:
 
     virtual void initMbtTracking(const vpImage<unsigned char> *const ptr_I);
 
+    void loadSharedModel(const vpMbtModel &model, const std::string &modelFile, const vpHomogeneousMatrix &odTo);
+
 #if defined(VISP_HAVE_PCL) && defined(VISP_HAVE_PCL_COMMON)
     virtual void postTracking(const vpImage<unsigned char> *const ptr_I,
       const pcl::PointCloud<pcl::PointXYZ>::ConstPtr &point_cloud);
@@ -788,6 +827,9 @@ private:
     virtual void preTracking(const vpImage<unsigned char> *const ptr_I = nullptr,
       const vpMatrix *const point_cloud = nullptr,
       const unsigned int pointcloud_width = 0, const unsigned int pointcloud_height = 0);
+    virtual void preTracking(const vpImage<unsigned char> *const ptr_I, const vpPointCloud *const point_cloud);
+    virtual void preTracking(const vpImage<unsigned char> *const ptr_I, const vpImage<uint16_t> *const depth_raw,
+      float depth_scale);
 
     virtual void reInitModel(const vpImage<unsigned char> *const I, const vpImage<vpRGBa> *const I_color,
       const std::string &cad_name, const vpHomogeneousMatrix &cMo, bool verbose = false,
@@ -808,6 +850,10 @@ private:
     virtual void setPose(const vpImage<unsigned char> *I, const vpImage<vpRGBa> *I_color,
       const vpHomogeneousMatrix &cdMo);
 #endif
+
+  private:
+    template <class DepthSegmentation>
+    void preTrackingDepth(const vpImage<unsigned char> *const ptr_I, const DepthSegmentation &segmentDepth);
   };
 #ifdef VISP_HAVE_NLOHMANN_JSON
   friend void to_json(nlohmann::json &j, const TrackerWrapper &t);
@@ -848,6 +894,16 @@ protected:
   unsigned int m_nb_feat_depthNormal;
   //! Number of depth dense features
   unsigned int m_nb_feat_depthDense;
+  //! If true, the per-camera stages of the tracking are run concurrently
+  bool m_parallelCameraTracking;
+
+private:
+  template <class DepthData, class TrackerPreTracking>
+  void preTrackingDepth(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages,
+    std::map<std::string, const DepthData *> &mapOfDepthData, const TrackerPreTracking &trackerPreTracking);
+  template <class DepthData, class PreTracking>
+  void trackDepth(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages,
+    std::map<std::string, const DepthData *> &mapOfDepthData, const PreTracking &preTrackingCameras);
 };
 
 #ifdef VISP_HAVE_NLOHMANN_JSON
@@ -41,12 +41,15 @@
 #include <visp3/core/vpMeterPixelConversion.h>
 #include <visp3/core/vpPixelMeterConversion.h>
 #include <visp3/mbt/vpMbScanLine.h>
+#include <visp3/mbt/vpMbtBoundingVolumeHierarchy.h>
 #include <visp3/mbt/vpMbtPolygon.h>
 
 #ifdef VISP_HAVE_OGRE
 #include <visp3/ar/vpAROgre.h>
 #endif
 
+#include <algorithm>
+#include <cstdlib>
 #include <limits>
 #include <vector>
 
@@ -74,12 +77,22 @@ private:
   //! Number of visible polygon
   unsigned int nbVisiblePolygon;
   vpMbScanLine scanlineRender;
+  //! Bounding volume hierarchy over the polygons
+  vpMbtBoundingVolumeHierarchy bvh;
+  //! True if the polygons changed since the hierarchy has been built
+  bool bvhOutdated;
+  //! True if the faces outside the view frustum are considered as not visible
+  bool frustumCulling;
+  //! True if the faces occluded by the model are considered as not visible
+  bool rayCasting;
+  unsigned int nbRayAttempts;
+  double ratioVisibleRay;
+  //! Faces to test individually and faces culled by the hierarchy
+  std::vector<unsigned int> bvhCandidates, bvhCulled;
 
 #ifdef VISP_HAVE_OGRE
   vpImage<unsigned char> ogreBackground;
   bool ogreInitialised;
-  unsigned int nbRayAttempts;
-  double ratioVisibleRay;
   vpAROgre *ogre;
   std::vector<Ogre::ManualObject *> lOgrePolygons;
   bool ogreShowConfigDialog;
@@ -89,6 +102,7 @@ private:
                                  const double &angleDisappears, bool &changed, bool useOgre = false,
                                  bool not_used = false, unsigned int width = 0, unsigned int height = 0,
                                  const vpCameraParameters &cam = vpCameraParameters());
+  void updateBoundingVolumeHierarchy();
 
 public:
   vpMbHiddenFaces();
@@ -110,6 +124,9 @@ public:
   void computeScanLineQuery(const vpPoint &a, const vpPoint &b, std::vector<std::pair<vpPoint, vpPoint> > &lines,
                             const bool &displayResults = false);
 
+  void computeScanLineQuery(const std::vector<std::pair<vpPoint, vpPoint> > &queries,
+                            std::vector<std::vector<std::pair<vpPoint, vpPoint> > > &lines);
+
   vpMbScanLine &getMbScanLineRenderer() { return scanlineRender; }
 
 #ifdef VISP_HAVE_OGRE
@@ -134,7 +151,6 @@ public:
    */
   unsigned int getNbVisiblePolygon() const { return nbVisiblePolygon; }
 
-#ifdef VISP_HAVE_OGRE
   /*!
    * Get the number of rays that will be sent toward each polygon for
    * visibility test. Each ray will go from the optic center of the camera to a
@@ -146,12 +162,14 @@ public:
    */
   unsigned int getNbRayCastingAttemptsForVisibility() { return nbRayAttempts; }
 
+#ifdef VISP_HAVE_OGRE
   /*!
    * Get the Ogre3D Context.
    *
    * \return A pointer on a vpAROgre instance.
    */
   vpAROgre *getOgreContext() { return ogre; }
+#endif
 
   /*!
    * Get the ratio of visibility attempts that has to be successful to consider
@@ -163,7 +181,15 @@ public:
    * be between 0.0 (0%) and 1.0 (100%).
    */
   double getGoodNbRayCastingAttemptsRatio() { return ratioVisibleRay; }
-#endif
+
+  /*!
+   * Get the bounding volume hierarchy built over the polygons.
+   *
+   * \warning The hierarchy is built at the first visibility test following a change of the list of polygons.
+   *
+   * \return The bounding volume hierarchy.
+   */
+  const vpMbtBoundingVolumeHierarchy &getBoundingVolumeHierarchy() const { return bvh; }
 
   bool isAppearing(unsigned int i) { return Lpol[i]->isAppearing(); }
 
@@ -189,6 +215,8 @@ public:
   bool isVisibleOgre(const vpTranslationVector &cameraPos, const unsigned int &index);
 #endif
 
+  bool isVisibleRayCasting(const vpTranslationVector &cameraPos, unsigned int index);
+
   //! Operator[] as modifier.
   inline PolygonType *operator[](unsigned int i) { return Lpol[i]; }
   //! Operator[] as reader.
@@ -211,6 +239,34 @@ public:
   {
     ogreBackground = vpImage<unsigned char>(h, w, 0);
   }
+#endif
+
+  /*!
+   * Enable/Disable the view frustum culling. When enabled, the faces that are
+   * entirely outside the field of view of the camera are considered as not
+   * visible by setVisible(). The image size and the camera parameters given to
+   * setVisible() define the field of view.
+   *
+   * By default, this functionality is turned off and a face outside the image
+   * is only hidden by the clipping of its features.
+   *
+   * \param v : True to cull the faces outside the view frustum.
+   */
+  void setFrustumCulling(bool v) { frustumCulling = v; }
+
+  /*!
+   * Enable/Disable the ray casting visibility test. When enabled, a face that
+   * passes the angle test of setVisible() is also considered as not visible if
+   * it is occluded by the other faces of the model. Rays are sent from the
+   * camera toward the face as with Ogre3D (see
+   * setNbRayCastingAttemptsForVisibility()), and are tested against the
+   * bounding volume hierarchy built over the polygons.
+   *
+   * By default, this functionality is turned off.
+   *
+   * \param v : True to use the ray casting visibility test.
+   */
+  void setRayCastingVisibilityTest(bool v) { rayCasting = v; }
 
   /*!
    * Set the number of rays that will be sent toward each polygon for
@@ -240,6 +296,8 @@ public:
     if (ratioVisibleRay < 0.0)
       ratioVisibleRay = 0.0;
   }
+
+#ifdef VISP_HAVE_OGRE
   /*!
    * Enable/Disable the appearance of Ogre config dialog on startup.
    *
@@ -280,12 +338,12 @@ public:
  * Basic constructor.
  */
 template <class PolygonType>
-vpMbHiddenFaces<PolygonType>::vpMbHiddenFaces() : Lpol(), nbVisiblePolygon(0), scanlineRender()
+vpMbHiddenFaces<PolygonType>::vpMbHiddenFaces()
+  : Lpol(), nbVisiblePolygon(0), scanlineRender(), bvh(), bvhOutdated(true), frustumCulling(false), rayCasting(false),
+  nbRayAttempts(1), ratioVisibleRay(1.0), bvhCandidates(), bvhCulled()
 {
 #ifdef VISP_HAVE_OGRE
   ogreInitialised = false;
-  nbRayAttempts = 1;
-  ratioVisibleRay = 1.0;
   ogreShowConfigDialog = false;
   ogre = new vpAROgre();
   ogreBackground = vpImage<unsigned char>(480, 640, 0);
@@ -328,11 +386,13 @@ template <class PolygonType> vpMbHiddenFaces<PolygonType>::~vpMbHiddenFaces()
  */
 template <class PolygonType>
 vpMbHiddenFaces<PolygonType>::vpMbHiddenFaces(const vpMbHiddenFaces<PolygonType> &copy)
-  : Lpol(), nbVisiblePolygon(copy.nbVisiblePolygon), scanlineRender(copy.scanlineRender)
+  : Lpol(), nbVisiblePolygon(copy.nbVisiblePolygon), scanlineRender(copy.scanlineRender), bvh(copy.bvh),
+  bvhOutdated(copy.bvhOutdated), frustumCulling(copy.frustumCulling), rayCasting(copy.rayCasting),
+  nbRayAttempts(copy.nbRayAttempts), ratioVisibleRay(copy.ratioVisibleRay), bvhCandidates(), bvhCulled()
 #ifdef VISP_HAVE_OGRE
   ,
-  ogreBackground(copy.ogreBackground), ogreInitialised(copy.ogreInitialised), nbRayAttempts(copy.nbRayAttempts),
-  ratioVisibleRay(copy.ratioVisibleRay), ogre(nullptr), lOgrePolygons(), ogreShowConfigDialog(copy.ogreShowConfigDialog)
+  ogreBackground(copy.ogreBackground), ogreInitialised(copy.ogreInitialised), ogre(nullptr), lOgrePolygons(),
+  ogreShowConfigDialog(copy.ogreShowConfigDialog)
 #endif
 {
   // Copy the list of polygons
@@ -348,10 +408,14 @@ template <class PolygonType> void swap(vpMbHiddenFaces<PolygonType> &first, vpMb
   swap(first.Lpol, second.Lpol);
   swap(first.nbVisiblePolygon, second.nbVisiblePolygon);
   swap(first.scanlineRender, second.scanlineRender);
-#ifdef VISP_HAVE_OGRE
-  swap(first.ogreInitialised, second.ogreInitialised);
+  swap(first.bvh, second.bvh);
+  swap(first.bvhOutdated, second.bvhOutdated);
+  swap(first.frustumCulling, second.frustumCulling);
+  swap(first.rayCasting, second.rayCasting);
   swap(first.nbRayAttempts, second.nbRayAttempts);
   swap(first.ratioVisibleRay, second.ratioVisibleRay);
+#ifdef VISP_HAVE_OGRE
+  swap(first.ogreInitialised, second.ogreInitialised);
   swap(first.ogreShowConfigDialog, second.ogreShowConfigDialog);
   swap(first.ogre, second.ogre);
   swap(first.ogreBackground, second.ogreBackground);
@@ -389,6 +453,7 @@ template <class PolygonType> void vpMbHiddenFaces<PolygonType>::addPolygon(Polyg
   for (unsigned int i = 0; i < p->nbpt; i++)
     p_new->p[i] = p->p[i];
   Lpol.push_back(p_new);
+  bvhOutdated = true;
 }
 
 /*!
@@ -404,6 +469,10 @@ template <class PolygonType> void vpMbHiddenFaces<PolygonType>::reset()
     Lpol[i] = nullptr;
   }
   Lpol.resize(0);
+  bvh.clear();
+  bvhOutdated = true;
+  nbRayAttempts = 1;
+  ratioVisibleRay = 1.0;
 
 #ifdef VISP_HAVE_OGRE
   if (ogre != nullptr) {
@@ -422,8 +491,6 @@ template <class PolygonType> void vpMbHiddenFaces<PolygonType>::reset()
   lOgrePolygons.resize(0);
 
   ogreInitialised = false;
-  nbRayAttempts = 1;
-  ratioVisibleRay = 1.0;
   ogre = new vpAROgre();
   ogreBackground = vpImage<unsigned char>(480, 640);
 #endif
@@ -503,16 +570,52 @@ void vpMbHiddenFaces<PolygonType>::computeScanLineQuery(const vpPoint &a, const
   scanlineRender.queryLineVisibility(a, b, lines, displayResults);
 }
 
+/*!
+ * Compute scanline visibility results for several lines at once. The lines
+ * are processed in parallel when OpenMP is available.
+ *
+ * \warning computeScanLineRender() function has to be called before
+ *
+ * \param queries : Lines to test, as pairs of points.
+ * \param lines : For each line of \e queries, the list of its visible parts.
+ */
+template <class PolygonType>
+void vpMbHiddenFaces<PolygonType>::computeScanLineQuery(const std::vector<std::pair<vpPoint, vpPoint> > &queries,
+                                                        std::vector<std::vector<std::pair<vpPoint, vpPoint> > > &lines)
+{
+  scanlineRender.queryLinesVisibility(queries, lines);
+}
+
+/*!
+ * Build the bounding volume hierarchy over the polygons if they changed since
+ * the last build, that is when a model has been loaded.
+ */
+template <class PolygonType> void vpMbHiddenFaces<PolygonType>::updateBoundingVolumeHierarchy()
+{
+  if (bvhOutdated) {
+    std::vector<const vpMbtPolygon *> polygons(Lpol.begin(), Lpol.end());
+    bvh.build(polygons);
+    bvhOutdated = false;
+  }
+}
+
 /*!
  * Compute the number of visible polygons.
  *
+ * Unless Ogre3D is used, the faces are first culled by groups with the
+ * bounding volume hierarchy built over the polygons: the faces that are
+ * back-facing with respect to both angles, or outside the view frustum when
+ * setFrustumCulling() is enabled, are set as not visible without being tested
+ * individually. The coordinates of these faces in the camera frame are not
+ * updated.
+ *
  * \param cMo : The pose of the camera
  * \param angleAppears : Angle used to test the appearance of a face
  * \param angleDisappears : Angle used to test the disappearance of a face
  * \param changed : True if a face appeared, disappeared or too many points have been lost. False otherwise
  * \param useOgre : True if a Ogre is used to test the visibility, False otherwise
  * \param not_used : Unused parameter.
- * \param I : Image used to test if a face is entirely projected in the image.
+ * \param width, height : Image size used to test if a face is entirely projected in the image.
  * \param cam : Camera parameters.
  *
  * \return Return the number of visible polygons
@@ -527,6 +630,7 @@ unsigned int vpMbHiddenFaces<PolygonType>::setVisiblePrivate(const vpHomogeneous
   changed = false;
 
   vpTranslationVector cameraPos;
+  updateBoundingVolumeHierarchy();
 
   if (useOgre) {
 #ifdef VISP_HAVE_OGRE
@@ -535,12 +639,36 @@ unsigned int vpMbHiddenFaces<PolygonType>::setVisiblePrivate(const vpHomogeneous
 #else
     vpTRACE("ViSP doesn't have Ogre3D, simple visibility test used");
 #endif
+
+    for (unsigned int i = 0; i < Lpol.size(); i++) {
+      if (computeVisibility(cMo, angleAppears, angleDisappears, changed, useOgre, not_used, width, height, cam,
+                            cameraPos, i))
+        nbVisiblePolygon++;
+    }
+    return nbVisiblePolygon;
   }
 
-  for (unsigned int i = 0; i < Lpol.size(); i++) {
-    // std::cout << "Calling poly: " << i << std::endl;
+  if (rayCasting) {
+    cMo.inverse().extract(cameraPos);
+  }
+
+  // A face beyond both angles, plus the one degree margin used for isAppearing(), is neither visible nor appearing
+  const bool useFrustum = frustumCulling && (width > 0) && (height > 0);
+  bvh.cull(cMo, std::max(angleAppears, angleDisappears) + vpMath::rad(1), bvhCandidates, bvhCulled,
+           useFrustum ? &cam : nullptr, width, height);
+
+  for (size_t k = 0; k < bvhCulled.size(); k++) {
+    PolygonType *polygon = Lpol[bvhCulled[k]];
+    if (polygon->isvisible) {
+      changed = true;
+    }
+    polygon->isvisible = false;
+    polygon->isappearing = false;
+  }
+
+  for (size_t k = 0; k < bvhCandidates.size(); k++) {
     if (computeVisibility(cMo, angleAppears, angleDisappears, changed, useOgre, not_used, width, height, cam, cameraPos,
-                          i))
+                          bvhCandidates[k]))
       nbVisiblePolygon++;
   }
   return nbVisiblePolygon;
@@ -557,7 +685,7 @@ unsigned int vpMbHiddenFaces<PolygonType>::setVisiblePrivate(const vpHomogeneous
  * \param not_used : Unused parameter.
  * \param width, height Image size.
  * \param cam : Camera parameters.
- * \param cameraPos : Position of the camera. Used only when Ogre is used as 3rd party.
+ * \param cameraPos : Position of the camera. Used only when Ogre or the ray casting visibility test is used.
  * \param index : Index of the face to consider.
  *
  * \return Return true if the face is visible.
@@ -598,7 +726,8 @@ bool vpMbHiddenFaces<PolygonType>::computeVisibility(const vpHomogeneousMatrix &
         }
 #endif
         else
-          testDisappear = (!Lpol[i]->isVisible(cMo, angleDisappears, false, cam, width, height));
+          testDisappear = (!Lpol[i]->isVisible(cMo, angleDisappears, false, cam, width, height)) ||
+          (rayCasting && !isVisibleRayCasting(cameraPos, i));
       }
 
       // test if the face is still visible
@@ -628,7 +757,8 @@ bool vpMbHiddenFaces<PolygonType>::computeVisibility(const vpHomogeneousMatrix &
           testAppear = (Lpol[i]->isVisible(cMo, angleAppears, false, cam, width, height));
 #endif
         else
-          testAppear = (Lpol[i]->isVisible(cMo, angleAppears, false, cam, width, height));
+          testAppear = (Lpol[i]->isVisible(cMo, angleAppears, false, cam, width, height)) &&
+          (!rayCasting || isVisibleRayCasting(cameraPos, i));
       }
 
       if (testAppear) {
@@ -705,6 +835,61 @@ unsigned int vpMbHiddenFaces<PolygonType>::setVisible(const vpHomogeneousMatrix
   return setVisiblePrivate(cMo, angleAppears, angleDisappears, changed, false);
 }
 
+/*!
+ * Test the visibility of a polygon via ray casting against the bounding volume
+ * hierarchy built over the polygons. Rays are sent from the camera toward
+ * random points of the polygon, and the polygon is visible if the ratio of
+ * rays that are not occluded by the other polygons reaches
+ * getGoodNbRayCastingAttemptsRatio().
+ *
+ * \warning The hierarchy has to be up to date, which is the case after a call to setVisible().
+ *
+ * \param cameraPos : Position of the camera in the object frame.
+ * \param index : Index of the polygon.
+ *
+ * \return Return true if the polygon is visible, False otherwise.
+ */
+template <class PolygonType>
+bool vpMbHiddenFaces<PolygonType>::isVisibleRayCasting(const vpTranslationVector &cameraPos, unsigned int index)
+{
+  unsigned int nbVisible = 0;
+  const unsigned int nbpt = Lpol[index]->getNbPoint();
+
+  for (unsigned int i = 0; i < nbRayAttempts; i++) {
+    // Random point inside the polygon, the center of gravity for a single ray
+    vpTranslationVector target(0, 0, 0);
+    double totalFactor = 0.0;
+
+    for (unsigned int j = 0; j < nbpt; j++) {
+      double factor = 1.0;
+
+      if (nbRayAttempts > 1) {
+        int r = rand() % 101;
+
+        if (r != 0)
+          factor = ((double)r) / 100.0;
+      }
+
+      const vpPoint &P = Lpol[index]->getPoint(j);
+      target[0] += factor * P.get_oX();
+      target[1] += factor * P.get_oY();
+      target[2] += factor * P.get_oZ();
+      totalFactor += factor;
+    }
+
+    if (totalFactor > 0.0) {
+      target /= totalFactor;
+    }
+
+    if (!bvh.isOccluded(cameraPos, target, index))
+      nbVisible++;
+  }
+
+  return (nbRayAttempts == 0) || ((double)nbVisible) / ((double)nbRayAttempts) > ratioVisibleRay ||
+    std::fabs(((double)nbVisible) / ((double)nbRayAttempts) - ratioVisibleRay) <
+    ratioVisibleRay * std::numeric_limits<double>::epsilon();
+}
+
 #ifdef VISP_HAVE_OGRE
 /*!
  * Initialise the ogre context for face visibility tests.
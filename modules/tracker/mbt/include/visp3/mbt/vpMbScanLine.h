@@ -40,6 +40,7 @@
 #ifndef vpMbScanLine_HH
 #define vpMbScanLine_HH
 
+#include <cmath>
 #include <deque>
 #include <limits> // numeric_limits
 #include <list>
@@ -131,13 +132,117 @@ public:
   };
 
 private:
+  //! Scanline edge stored without allocation, used as a key to find the
+  //! index of an edge of the scene.
+  struct vpMbScanLineEdgeKey
+  {
+    double first[3];
+    double second[3];
+  };
+
+  //! vpMbScanLineEdgeKey Comparator.
+  struct vpMbScanLineEdgeKeyComparator
+  {
+    inline bool operator()(const vpMbScanLineEdgeKey &l0, const vpMbScanLineEdgeKey &l1) const
+    {
+      for (unsigned int i = 0; i < 3; ++i)
+        if (l0.first[i] < l1.first[i])
+          return true;
+        else if (l0.first[i] > l1.first[i])
+          return false;
+      for (unsigned int i = 0; i < 3; ++i)
+        if (l0.second[i] < l1.second[i])
+          return true;
+        else if (l0.second[i] > l1.second[i])
+          return false;
+      return false;
+    }
+  };
+
+  //! Scanline intersection referring to its edge by index, used to render
+  //! the scene.
+  struct vpMbScanLineIntersection
+  {
+    vpMbScanLineIntersection() : type(START), edge(0), p(0), P1(0), P2(0), Z1(0), Z2(0), ID(0), b_sample_Y(false) { }
+    vpMbScanLineType type;
+    unsigned int edge; // Index of the edge in the list of the edges of the scene
+    double p;
+    double P1, P2;
+    double Z1, Z2;
+    int ID;
+    bool b_sample_Y;
+  };
+
+  //! vpMbScanLineIntersection Comparators.
+  struct vpMbScanLineIntersectionComparator
+  {
+    inline bool operator()(const vpMbScanLineIntersection &a, const vpMbScanLineIntersection &b) const
+    {
+      return (std::fabs(a.p - b.p) <= std::numeric_limits<double>::epsilon()) ? a.type < b.type : a.p < b.p;
+    }
+
+    inline bool operator()(const std::pair<double, vpMbScanLineIntersection> &a,
+                           const std::pair<double, vpMbScanLineIntersection> &b) const
+    {
+      return a.first < b.first;
+    }
+  };
+
+  //! Projection of a polygon vertex in the image, in pixel.
+  struct vpMbScanLineVertex
+  {
+    double x, y, z;
+  };
+
+  //! Projected polygon, whose vertices and edges are stored in the
+  //! vertices and polygonEdges vectors.
+  struct vpMbScanLinePolygon
+  {
+    size_t first;
+    size_t size;
+    int ID;
+    double xmin, xmax, ymin, ymax;
+  };
+
+  //! State carried from one scanline to the next one.
+  struct vpMbScanLineState
+  {
+    vpMbScanLineState() : last_ID(-1), last_visible() { }
+    int last_ID;
+    vpMbScanLineIntersection last_visible;
+  };
+
+  //! Working buffers of a band of scanlines.
+  struct vpMbScanLineBuffer
+  {
+    std::vector<std::vector<vpMbScanLineIntersection> > localScanlines;
+    std::vector<std::pair<double, vpMbScanLineIntersection> > stack;
+  };
+
   unsigned int w, h;
   vpCameraParameters K;
   unsigned int maskBorder;
   vpImage<unsigned char> mask;
+  vpImage<unsigned char> maskX, maskY;
   vpImage<int> primitive_ids;
-  std::map<vpMbScanLineEdge, std::set<int>, vpMbScanLineEdgeComparator> visibility_samples;
   double depthTreshold;
+  unsigned int nbThreads;
+
+  // Scene, rebuilt by drawScene() in buffers that are reused from one frame to the next
+  std::vector<vpMbScanLineVertex> vertices;
+  std::vector<unsigned int> polygonEdges;
+  std::vector<vpMbScanLinePolygon> scenePolygons;
+  std::vector<std::pair<vpMbScanLineEdgeKey, size_t> > edgeKeys;
+  std::vector<std::vector<vpMbScanLineIntersection> > scanlinesY, scanlinesX;
+  std::vector<std::vector<unsigned int> > samplesY, samplesX;
+  std::vector<vpMbScanLineState> statesY, statesX;
+  std::vector<vpMbScanLineBuffer> buffers;
+
+  // Visibility samples of the edges, edges[i] owns visibility_samples[sampleBegins[i]] to
+  // visibility_samples[sampleBegins[i + 1] - 1], sorted in increasing order
+  std::vector<vpMbScanLineEdgeKey> edges;
+  std::vector<size_t> sampleBegins;
+  std::vector<int> visibility_samples;
 
 public:
 #if defined(DEBUG_DISP)
@@ -162,10 +267,20 @@ public:
   double getDepthTreshold() { return depthTreshold; }
   unsigned int getMaskBorder() { return maskBorder; }
   const vpImage<unsigned char> &getMask() const { return mask; }
+
+  /*!
+    Get the number of threads used to render the scene.
+
+    \return Number of threads, 0 means the OpenMP default.
+  */
+  unsigned int getNbThreads() const { return nbThreads; }
   const vpImage<int> &getPrimitiveIDs() const { return primitive_ids; }
 
   void queryLineVisibility(const vpPoint &a, const vpPoint &b, std::vector<std::pair<vpPoint, vpPoint> > &lines,
-                           const bool &displayResults = false);
+                           const bool &displayResults = false) const;
+
+  void queryLinesVisibility(const std::vector<std::pair<vpPoint, vpPoint> > &queries,
+                            std::vector<std::vector<std::pair<vpPoint, vpPoint> > > &lines) const;
 
   /*!
     If there is one polygon behind another,
@@ -177,26 +292,45 @@ public:
   void setDepthTreshold(const double &treshold) { depthTreshold = treshold; }
   void setMaskBorder(const unsigned int &mb) { maskBorder = mb; }
 
+  /*!
+    Set the number of threads used to render the scene and to answer the
+    batched visibility queries. It has no effect if ViSP is built without
+    OpenMP.
+
+    \param nb : Number of threads, 0 to use the OpenMP default.
+  */
+  void setNbThreads(unsigned int nb) { nbThreads = nb; }
+
 private:
-  void createScanLinesFromLocals(std::vector<std::vector<vpMbScanLineSegment> > &scanlines,
-                                 std::vector<std::vector<vpMbScanLineSegment> > &localScanlines,
-                                 const unsigned int &size);
+  void createScanLinesFromLocals(std::vector<std::vector<vpMbScanLineIntersection> > &scanlines,
+                                 std::vector<std::vector<vpMbScanLineIntersection> > &localScanlines,
+                                 unsigned int first, unsigned int last, unsigned int offset);
+
+  void drawBand(bool axisY, unsigned int first, unsigned int last, vpMbScanLineBuffer &buffer);
+
+  void drawLineY(const vpMbScanLineVertex &a, const vpMbScanLineVertex &b, unsigned int edge, const int ID,
+                 unsigned int first, unsigned int last, unsigned int offset,
+                 std::vector<std::vector<vpMbScanLineIntersection> > &scanlines, unsigned int &touchedFirst,
+                 unsigned int &touchedLast);
+
+  void drawLineX(const vpMbScanLineVertex &a, const vpMbScanLineVertex &b, unsigned int edge, const int ID,
+                 unsigned int first, unsigned int last, unsigned int offset,
+                 std::vector<std::vector<vpMbScanLineIntersection> > &scanlines, unsigned int &touchedFirst,
+                 unsigned int &touchedLast);
 
-  void drawLineY(const vpColVector &a, const vpColVector &b, const vpMbScanLineEdge &line_ID, const int ID,
-                 std::vector<std::vector<vpMbScanLineSegment> > &scanlines);
+  void drawPolygon(bool axisY, const vpMbScanLinePolygon &polygon, unsigned int first, unsigned int last,
+                   vpMbScanLineBuffer &buffer);
 
-  void drawLineX(const vpColVector &a, const vpColVector &b, const vpMbScanLineEdge &line_ID, const int ID,
-                 std::vector<std::vector<vpMbScanLineSegment> > &scanlines);
+  void renderScanLine(bool axisY, unsigned int line, vpMbScanLineState &state,
+                      std::vector<std::pair<double, vpMbScanLineIntersection> > &stack);
 
-  void drawPolygonY(const std::vector<std::pair<vpPoint, unsigned int> > &polygon, const int ID,
-                    std::vector<std::vector<vpMbScanLineSegment> > &scanlines);
+  void resetScanLine(bool axisY, unsigned int line);
 
-  void drawPolygonX(const std::vector<std::pair<vpPoint, unsigned int> > &polygon, const int ID,
-                    std::vector<std::vector<vpMbScanLineSegment> > &scanlines);
+  void buildEdgeSamples();
 
   // Static functions
-  static vpMbScanLineEdge makeMbScanLineEdge(const vpPoint &a, const vpPoint &b);
-  static void createVectorFromPoint(const vpPoint &p, vpColVector &v, const vpCameraParameters &K);
+  static vpMbScanLineEdgeKey makeMbScanLineEdgeKey(const vpPoint &a, const vpPoint &b);
+  static vpMbScanLineVertex projectPoint(const vpPoint &p, const vpCameraParameters &K);
   static double getAlpha(double x, double X0, double Z0, double X1, double Z1);
   static double mix(double a, double b, double alpha);
   static vpPoint mix(const vpPoint &a, const vpPoint &b, double alpha);
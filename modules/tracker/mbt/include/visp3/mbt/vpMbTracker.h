@@ -66,6 +66,8 @@
 #include <visp3/mbt/vpMbtDistanceCircle.h>
 #include <visp3/mbt/vpMbtDistanceCylinder.h>
 #include <visp3/mbt/vpMbtDistanceLine.h>
+#include <visp3/mbt/vpMbtLineIndex.h>
+#include <visp3/mbt/vpMbtModel.h>
 
 #ifdef VISP_HAVE_COIN3D
 // Work around to avoid type redefinition int8_t with Coin
@@ -196,6 +198,8 @@ protected:
 
   //! Distance line primitives for projection error
   std::vector<vpMbtDistanceLine *> m_projectionErrorLines;
+  //! Index of the projection error lines by their extremities, used by addProjectionErrorLine()
+  vpMbtLineIndex m_projectionErrorLinesIndex;
   //! Distance cylinder primitives for projection error
   std::vector<vpMbtDistanceCylinder *> m_projectionErrorCylinders;
   //! Distance circle primitive for projection error
@@ -227,6 +231,8 @@ protected:
   bool m_sodb_init_called;
   //! Random number generator used in vpMbtDistanceLine::buildFrom()
   vpUniRand m_rand;
+  //! Model the primitives were built from, whose buffer is shared with the other trackers loading the same model
+  vpMbtModel m_model;
 
 public:
   vpMbTracker();
@@ -299,6 +305,16 @@ public:
    */
   virtual inline unsigned int getMaxIter() const { return m_maxIter; }
 
+  /*!
+    Get the model the primitives of the tracker were built from when it was
+    last loaded. The returned model shares its buffer with the tracker.
+
+    \return The model.
+
+    \sa loadModel(const vpMbtModel &, const vpHomogeneousMatrix &)
+  */
+  virtual inline const vpMbtModel &getModel() const { return m_model; }
+
   /*!
     Get the error angle between the gradient direction of the model features
     projected at the resulting pose and their normal. The error is expressed
@@ -459,6 +475,7 @@ public:
 
   virtual void loadModel(const std::string &modelFile, bool verbose = false,
                          const vpHomogeneousMatrix &T = vpHomogeneousMatrix());
+  virtual void loadModel(const vpMbtModel &model, const vpHomogeneousMatrix &T = vpHomogeneousMatrix());
 
   /*!
     Set the angle used to test polygons appearance.
@@ -611,9 +628,32 @@ public:
 
   virtual void setOgreVisibilityTest(const bool &v);
 
+  /*!
+    Enable/Disable the view frustum culling of the faces. When enabled, the
+    faces that are entirely outside the field of view of the camera are
+    considered as not visible. By default, this functionality is turned off.
+
+    \param v : True to cull the faces outside the view frustum.
+
+    \sa vpMbHiddenFaces::setFrustumCulling()
+  */
+  virtual void setFrustumCullingVisibilityTest(const bool &v) { faces.setFrustumCulling(v); }
+
+  /*!
+    Enable/Disable the ray casting visibility test without Ogre3D. When
+    enabled, the faces occluded by the other faces of the model are considered
+    as not visible. Rays are cast against a bounding volume hierarchy built over
+    the faces when the model is loaded. By default, this functionality is
+    turned off.
+
+    \param v : True to use the ray casting visibility test.
+
+    \sa setNbRayCastingAttemptsForVisibility(), setGoodNbRayCastingAttemptsRatio()
+  */
+  virtual void setRayCastingVisibilityTest(const bool &v) { faces.setRayCastingVisibilityTest(v); }
+
   void savePose(const std::string &filename) const;
 
-#ifdef VISP_HAVE_OGRE
   /*!
     Set the ratio of visibility attempts that has to be successful to consider
     a polygon as visible.
@@ -637,7 +677,6 @@ public:
   {
     faces.setNbRayCastingAttemptsForVisibility(attempts);
   }
-#endif
 
   /*!
     Enable/Disable the appearance of Ogre config dialog on startup.
@@ -768,6 +807,8 @@ public:
 
 protected:
   /** @name Protected Member Functions Inherited from vpMbTracker */
+  void addModelPrimitives(const vpMbtModel &model, int startIdFace,
+                          const vpHomogeneousMatrix &odTo = vpHomogeneousMatrix());
   void addPolygon(const std::vector<vpPoint> &corners, int idFace = -1, const std::string &polygonName = "",
                   bool useLod = false, double minPolygonAreaThreshold = 2500.0, double minLineLengthThreshold = 50.0);
   void addPolygon(const vpPoint &p1, const vpPoint &p2, const vpPoint &p3, double radius, int idFace = -1,
@@ -820,13 +861,21 @@ protected:
                                         vpColVector *const m_w_prev = nullptr);
   virtual void computeVVSWeights(vpRobust &robust, const vpColVector &error, vpColVector &w);
 
-#ifdef VISP_HAVE_COIN3D
-  virtual void extractGroup(SoVRMLGroup *sceneGraphVRML2, vpHomogeneousMatrix &transform, int &idFace);
-  virtual void extractFaces(SoVRMLIndexedFaceSet *face_set, vpHomogeneousMatrix &transform, int &idFace,
-                            const std::string &polygonName = "");
-  virtual void extractLines(SoVRMLIndexedLineSet *line_set, int &idFace, const std::string &polygonName = "");
-  virtual void extractCylinders(SoVRMLIndexedFaceSet *face_set, vpHomogeneousMatrix &transform, int &idFace,
-                                const std::string &polygonName = "");
+#if defined(VISP_HAVE_COIN3D) && defined(VISP_BUILD_DEPRECATED_FUNCTIONS)
+  /*!
+    @name Deprecated functions
+    These functions are no more called by loadVRMLModel(), that loads the model with vpMbtModel::loadVRML().
+    They add the primitives of a VRML node to the tracker.
+  */
+  //@{
+  VP_DEPRECATED virtual void extractGroup(SoVRMLGroup *sceneGraphVRML2, vpHomogeneousMatrix &transform, int &idFace);
+  VP_DEPRECATED virtual void extractFaces(SoVRMLIndexedFaceSet *face_set, vpHomogeneousMatrix &transform,
+                                          int &idFace, const std::string &polygonName = "");
+  VP_DEPRECATED virtual void extractLines(SoVRMLIndexedLineSet *line_set, int &idFace,
+                                          const std::string &polygonName = "");
+  VP_DEPRECATED virtual void extractCylinders(SoVRMLIndexedFaceSet *face_set, vpHomogeneousMatrix &transform,
+                                              int &idFace, const std::string &polygonName = "");
+  //@}
 #endif
 
   vpPoint getGravityCenter(const std::vector<vpPoint> &_pts) const;
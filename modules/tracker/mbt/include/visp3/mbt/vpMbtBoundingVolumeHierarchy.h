@@ -0,0 +1,154 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2024 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Bounding volume hierarchy over the polygons of the model used by the
+ * model-based tracker.
+ */
+
+/*!
+ * \file vpMbtBoundingVolumeHierarchy.h
+ * \brief Bounding volume hierarchy over the polygons of the model used by the
+ * model-based tracker.
+ */
+
+#ifndef VP_MBT_BOUNDING_VOLUME_HIERARCHY_H
+#define VP_MBT_BOUNDING_VOLUME_HIERARCHY_H
+
+#include <visp3/core/vpConfig.h>
+#include <visp3/core/vpCameraParameters.h>
+#include <visp3/core/vpHomogeneousMatrix.h>
+#include <visp3/core/vpTranslationVector.h>
+#include <visp3/mbt/vpMbtPolygon.h>
+
+#include <vector>
+
+BEGIN_VISP_NAMESPACE
+/*!
+ * \class vpMbtBoundingVolumeHierarchy
+ *
+ * \brief Bounding volume hierarchy (BVH) built over the polygons of the model
+ * used by the model-based tracker.
+ *
+ * The hierarchy is built once from the object frame coordinates of the
+ * polygons, by recursively splitting them at the median of their centroids
+ * along the largest axis. Each node stores an axis-aligned bounding box, a
+ * bounding sphere of the face centroids and a cone bounding the face normals.
+ * It is then used at each frame to:
+ * - reject, without changing their frame, whole groups of faces that are
+ *   back-facing or outside the view frustum (see cull()),
+ * - test if a segment is occluded by the model (see isOccluded()), which is
+ *   what the ray casting visibility test needs.
+ *
+ * Both queries cost a number of operations that depends on the visible part
+ * of the model rather than on its number of faces.
+ *
+ * \sa vpMbHiddenFaces
+ *
+ * \ingroup group_mbt_faces
+ */
+class VISP_EXPORT vpMbtBoundingVolumeHierarchy
+{
+public:
+  vpMbtBoundingVolumeHierarchy();
+
+  void build(const std::vector<const vpMbtPolygon *> &polygons);
+
+  void clear();
+
+  void cull(const vpHomogeneousMatrix &cMo, double angle, std::vector<unsigned int> &candidates,
+            std::vector<unsigned int> &culled, const vpCameraParameters *cam = nullptr, unsigned int width = 0,
+            unsigned int height = 0) const;
+
+  /*!
+   * Get the number of faces the hierarchy has been built with.
+   *
+   * \return Number of faces.
+   */
+  inline unsigned int getNbFaces() const { return static_cast<unsigned int>(m_faces.size()); }
+
+  /*!
+   * Get the number of nodes of the hierarchy.
+   *
+   * \return Number of nodes.
+   */
+  inline unsigned int getNbNodes() const { return static_cast<unsigned int>(m_nodes.size()); }
+
+  bool isOccluded(const vpTranslationVector &origin, const vpTranslationVector &target,
+                  unsigned int ignoredFace) const;
+
+private:
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+  struct vpFace
+  {
+    //! Vertices in the object frame, stored as x, y, z triplets
+    std::vector<double> m_vertices;
+    double m_centroid[3];
+    //! Unit normal given by Newell's method
+    double m_normal[3];
+    //! Plane offset, such as normal . X + offset = 0 on the face
+    double m_offset;
+    //! Axes of the plane the face is projected on for the inside test
+    unsigned int m_axisU, m_axisV;
+    //! True if the face can be rejected from its normal, as vpMbtPolygon::isVisible() would do
+    bool m_orientable;
+    //! True if the face has at least three vertices and can occlude other faces
+    bool m_surface;
+  };
+
+  struct vpNode
+  {
+    double m_bbMin[3], m_bbMax[3];
+    //! Bounding sphere of the centroids of the faces
+    double m_sphereCenter[3];
+    double m_sphereRadius;
+    //! Cone bounding the normals of the faces
+    double m_coneAxis[3];
+    double m_coneAngle;
+    //! True if all the faces of the node are orientable
+    bool m_orientable;
+    //! Range of the number of vertices of the faces
+    unsigned int m_nbptMin, m_nbptMax;
+    //! First face of the node in m_faceIndices
+    unsigned int m_first;
+    unsigned int m_count;
+    //! Index of the second child, the first one immediately follows the node. 0 for a leaf
+    unsigned int m_right;
+  };
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+  unsigned int buildNode(unsigned int first, unsigned int count);
+  bool intersectFace(const vpFace &face, const double origin[3], const double direction[3]) const;
+
+  std::vector<vpFace> m_faces;
+  std::vector<vpNode> m_nodes;
+  std::vector<unsigned int> m_faceIndices;
+};
+END_VISP_NAMESPACE
+#endif
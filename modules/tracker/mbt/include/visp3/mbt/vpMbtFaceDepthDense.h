@@ -45,6 +45,7 @@
 #endif
 
 #include <visp3/core/vpPlane.h>
+#include <visp3/core/vpPointCloud.h>
 #include <visp3/mbt/vpMbTracker.h>
 #include <visp3/mbt/vpMbtDistanceLine.h>
 
@@ -113,6 +114,22 @@ public:
 #if DEBUG_DISPLAY_DEPTH_DENSE
                               ,
                               vpImage<unsigned char> &debugImage, std::vector<std::vector<vpImagePoint> > &roiPts_vec
+#endif
+                              ,
+                              const vpImage<bool> *mask = nullptr);
+  bool computeDesiredFeatures(const vpHomogeneousMatrix &cMo, unsigned int width, unsigned int height,
+                              const vpPointCloud &point_cloud, unsigned int stepX, unsigned int stepY
+#if DEBUG_DISPLAY_DEPTH_DENSE
+                              ,
+                              vpImage<unsigned char> &debugImage, std::vector<std::vector<vpImagePoint> > &roiPts_vec
+#endif
+                              ,
+                              const vpImage<bool> *mask = nullptr);
+  bool computeDesiredFeatures(const vpHomogeneousMatrix &cMo, const vpImage<uint16_t> &depth_raw,
+                              float depth_scale, unsigned int stepX, unsigned int stepY
+#if DEBUG_DISPLAY_DEPTH_DENSE
+                              ,
+                              vpImage<unsigned char> &debugImage, std::vector<std::vector<vpImagePoint> > &roiPts_vec
 #endif
                               ,
                               const vpImage<bool> *mask = nullptr);
@@ -239,6 +256,18 @@ protected:
                   double &distanceToFace);
 
   bool samePoint(const vpPoint &P1, const vpPoint &P2) const;
+
+private:
+  template <class PointAccessor>
+  bool computeDesiredFeaturesFromPoints(const vpHomogeneousMatrix &cMo, unsigned int width, unsigned int height,
+                                        const PointAccessor &points, unsigned int stepX, unsigned int stepY
+#if DEBUG_DISPLAY_DEPTH_DENSE
+                                        ,
+                                        vpImage<unsigned char> &debugImage,
+                                        std::vector<std::vector<vpImagePoint> > &roiPts_vec
+#endif
+                                        ,
+                                        const vpImage<bool> *mask);
 };
 END_VISP_NAMESPACE
 #endif
@@ -45,6 +45,7 @@
 #endif
 
 #include <visp3/core/vpPlane.h>
+#include <visp3/core/vpPointCloud.h>
 #include <visp3/mbt/vpMbTracker.h>
 #include <visp3/mbt/vpMbtDistanceLine.h>
 
@@ -124,6 +125,24 @@ public:
 #if DEBUG_DISPLAY_DEPTH_NORMAL
                               ,
                               vpImage<unsigned char> &debugImage, std::vector<std::vector<vpImagePoint> > &roiPts_vec
+#endif
+                              ,
+                              const vpImage<bool> *mask = nullptr);
+  bool computeDesiredFeatures(const vpHomogeneousMatrix &cMo, unsigned int width, unsigned int height,
+                              const vpPointCloud &point_cloud, vpColVector &desired_features,
+                              unsigned int stepX, unsigned int stepY
+#if DEBUG_DISPLAY_DEPTH_NORMAL
+                              ,
+                              vpImage<unsigned char> &debugImage, std::vector<std::vector<vpImagePoint> > &roiPts_vec
+#endif
+                              ,
+                              const vpImage<bool> *mask = nullptr);
+  bool computeDesiredFeatures(const vpHomogeneousMatrix &cMo, const vpImage<uint16_t> &depth_raw,
+                              float depth_scale, vpColVector &desired_features,
+                              unsigned int stepX, unsigned int stepY
+#if DEBUG_DISPLAY_DEPTH_NORMAL
+                              ,
+                              vpImage<unsigned char> &debugImage, std::vector<std::vector<vpImagePoint> > &roiPts_vec
 #endif
                               ,
                               const vpImage<bool> *mask = nullptr);
@@ -320,6 +339,19 @@ protected:
                                 vpColVector &plane_equation_estimated, vpColVector &centroid);
 
   bool samePoint(const vpPoint &P1, const vpPoint &P2) const;
+
+private:
+  template <class PointAccessor>
+  bool computeDesiredFeaturesFromPoints(const vpHomogeneousMatrix &cMo, unsigned int width, unsigned int height,
+                                        const PointAccessor &points, vpColVector &desired_features,
+                                        unsigned int stepX, unsigned int stepY
+#if DEBUG_DISPLAY_DEPTH_NORMAL
+                                        ,
+                                        vpImage<unsigned char> &debugImage,
+                                        std::vector<std::vector<vpImagePoint> > &roiPts_vec
+#endif
+                                        ,
+                                        const vpImage<bool> *mask);
 };
 END_VISP_NAMESPACE
 
@@ -0,0 +1,109 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2024 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Index of the lines of the model-based tracker by their extremities.
+ */
+
+/*!
+ * \file vpMbtLineIndex.h
+ * \brief Index of the lines of the model-based tracker by their extremities.
+ */
+
+#ifndef VP_MBT_LINE_INDEX_H
+#define VP_MBT_LINE_INDEX_H
+
+#include <visp3/core/vpConfig.h>
+#include <visp3/core/vpPoint.h>
+
+#include <map>
+#include <vector>
+
+BEGIN_VISP_NAMESPACE
+class vpMbtDistanceLine;
+
+/*!
+ * \class vpMbtLineIndex
+ *
+ * \brief Index of a list of vpMbtDistanceLine by the coordinates of their
+ * extremities, used when the model is loaded to find the lines shared by
+ * several faces without going through all the lines already added.
+ *
+ * The lines are sorted by the smallest X coordinate of their extremities in
+ * the object frame. find() returns the lines whose key is close to the one of
+ * the searched segment, which is a superset of the lines with the same
+ * extremities. The caller then applies its own point comparison to the
+ * candidates.
+ *
+ * The index follows the list of lines it was built from: update() rebuilds
+ * it when the list has been modified by other means than insert().
+ *
+ * \ingroup group_mbt_features
+ */
+class VISP_EXPORT vpMbtLineIndex
+{
+public:
+  vpMbtLineIndex();
+
+  void clear();
+
+  void find(const vpPoint &P1, const vpPoint &P2, std::vector<vpMbtDistanceLine *> &candidates) const;
+
+  void insert(vpMbtDistanceLine *line);
+
+  /*!
+   * Rebuild the index if the list of lines has been modified since the last
+   * call to insert() or update().
+   *
+   * \param lines : List of lines the index refers to, either a std::list or a
+   * std::vector of vpMbtDistanceLine pointers.
+   */
+  template <class Container> void update(const Container &lines)
+  {
+    if ((lines.size() == m_size) && (lines.empty() || (lines.back() == m_last))) {
+      return;
+    }
+
+    clear();
+    for (typename Container::const_iterator it = lines.begin(); it != lines.end(); ++it) {
+      insert(*it);
+    }
+  }
+
+private:
+  //! Lines sorted by the smallest X coordinate of their extremities
+  std::multimap<double, vpMbtDistanceLine *> m_lines;
+  //! Number of lines of the list the index refers to
+  size_t m_size;
+  //! Last line of the list the index refers to
+  const vpMbtDistanceLine *m_last;
+};
+END_VISP_NAMESPACE
+
+#endif
@@ -0,0 +1,328 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2024 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Compiled 3D model used by the model-based tracker.
+ */
+
+/*!
+ * \file vpMbtModel.h
+ * \brief Compiled 3D model used by the model-based tracker.
+ */
+
+#ifndef VP_MBT_MODEL_H
+#define VP_MBT_MODEL_H
+
+#include <visp3/core/vpConfig.h>
+#include <visp3/core/vpHomogeneousMatrix.h>
+#include <visp3/core/vpPoint.h>
+
+#include <memory>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#ifdef VISP_HAVE_COIN3D
+#include <Inventor/VRMLnodes/SoVRMLGroup.h>
+#include <Inventor/VRMLnodes/SoVRMLIndexedFaceSet.h>
+#include <Inventor/VRMLnodes/SoVRMLIndexedLineSet.h>
+#endif
+
+BEGIN_VISP_NAMESPACE
+/*!
+ * \class vpMbtModel
+ *
+ * \brief Immutable description of the 3D model of an object, as the
+ * model-based tracker builds its faces from it.
+ *
+ * The model is the list of the primitives (polygons, lines, cylinders and
+ * circles) declared in a *.cao or *.wrl file, in the order the tracker adds
+ * them, with their face ids, names and level of detail settings. It is stored
+ * in a single contiguous buffer that is also the layout of the compiled model
+ * file written by save():
+ * - a header with the counts of the model,
+ * - the fixed size primitive records,
+ * - the point indexes of the primitives,
+ * - the 3D points of the model, expressed in the object frame,
+ * - the names of the primitives.
+ *
+ * Loading a compiled model file with load() only maps the file in memory (or
+ * reads it in a single call when memory mapping is not available), so that a
+ * tracker can be initialized without parsing the text model again. Copies of a
+ * vpMbtModel share the same buffer.
+ *
+ * \code
+ * #include <visp3/mbt/vpMbGenericTracker.h>
+ * #include <visp3/mbt/vpMbtModel.h>
+ *
+ * int main()
+ * {
+ *   // Once, offline
+ *   vpMbtModel::compile("object.cao", "object.bin");
+ *
+ *   // At tracker start-up
+ *   vpMbGenericTracker tracker;
+ *   tracker.loadModel("object.bin");
+ * }
+ * \endcode
+ *
+ * \sa vpMbTracker::loadModel()
+ *
+ * \ingroup group_mbt_faces
+ */
+class VISP_EXPORT vpMbtModel
+{
+public:
+  /*!
+   * Type of a primitive of the model.
+   */
+  typedef enum
+  {
+    POLYGON_FROM_LINES,  //!< Face of a *.cao file defined by its lines, initialized with initFaceFromLines().
+    POLYGON_FROM_POINTS, //!< Face or line defined by its corners, initialized with initFaceFromCorners().
+    CYLINDER,            //!< Cylinder defined by two points on its axis and its radius.
+    CIRCLE               //!< Circle defined by its center, two points on its plane and its radius.
+  } vpPrimitiveType;
+
+  /*!
+   * Origin of a level of detail setting of a primitive.
+   */
+  typedef enum
+  {
+    LOD_EXPLICIT, //!< Value stored in the model.
+    LOD_DEFAULT,  //!< Default of the tracker for this kind of primitive, resolved when the model is loaded.
+    LOD_GENERAL   //!< General setting of the tracker, resolved when the model is loaded.
+  } vpLodMode;
+
+  /*!
+   * Primitive record, as stored in the model buffer.
+   */
+  struct vpPrimitive
+  {
+    uint32_t type;                  //!< Type of the primitive, see vpPrimitiveType.
+    int32_t idFace;                 //!< Id of the first face of the primitive, relative to the first face of the model.
+    uint32_t firstIndex;            //!< Position of the first point index of the primitive.
+    uint32_t nbIndices;             //!< Number of points of the primitive.
+    double radius;                  //!< Radius of the cylinder or of the circle.
+    double minPolygonAreaThreshold; //!< Minimum polygon area used when the area mode is LOD_EXPLICIT.
+    double minLineLengthThreshold;  //!< Minimum line length used when the length mode is LOD_EXPLICIT.
+    uint32_t nameOffset;            //!< Position of the name of the primitive.
+    uint32_t nameLength;            //!< Length of the name of the primitive.
+    uint8_t useLodMode;             //!< Origin of the use of the level of detail, see vpLodMode.
+    uint8_t useLod;                 //!< Use of the level of detail when the mode is LOD_EXPLICIT.
+    uint8_t areaMode;               //!< Origin of the minimum polygon area, see vpLodMode.
+    uint8_t lengthMode;             //!< Origin of the minimum line length, see vpLodMode.
+    uint32_t reserved;              //!< Padding.
+  };
+
+  vpMbtModel();
+
+  static void compile(const std::string &modelFile, const std::string &compiledFile, bool verbose = false,
+                      const vpHomogeneousMatrix &odTo = vpHomogeneousMatrix());
+
+  /*!
+   * Get the number of circles declared in the model.
+   *
+   * \return Number of circles.
+   */
+  inline unsigned int getNbCircles() const { return header().nbCircles; }
+
+  /*!
+   * Get the number of cylinders declared in the model.
+   *
+   * \return Number of cylinders.
+   */
+  inline unsigned int getNbCylinders() const { return header().nbCylinders; }
+
+  /*!
+   * Get the number of face ids used by the model. The primitives of the model
+   * use the ids from 0 to this number minus one, relative to the id of the
+   * first face of the model in the tracker.
+   *
+   * \return Number of face ids.
+   */
+  inline int getNbFaceIds() const { return header().nbFaceIds; }
+
+  /*!
+   * Get the number of lines declared in the model.
+   *
+   * \return Number of lines.
+   */
+  inline unsigned int getNbLines() const { return header().nbLines; }
+
+  /*!
+   * Get the number of points declared in the model.
+   *
+   * \return Number of points.
+   */
+  inline unsigned int getNbPoints() const { return header().nbPoints; }
+
+  /*!
+   * Get the number of polygons declared with their lines in the model.
+   *
+   * \return Number of polygons.
+   */
+  inline unsigned int getNbPolygonLines() const { return header().nbPolygonLines; }
+
+  /*!
+   * Get the number of polygons declared with their points in the model.
+   *
+   * \return Number of polygons.
+   */
+  inline unsigned int getNbPolygonPoints() const { return header().nbPolygonPoints; }
+
+  /*!
+   * Get the number of primitives of the model, in the order they are added
+   * to the tracker.
+   *
+   * \return Number of primitives.
+   */
+  inline unsigned int getNbPrimitives() const { return header().nbPrimitives; }
+
+  /*!
+   * Get a primitive record of the model.
+   *
+   * \param i : Index of the primitive, lower than getNbPrimitives().
+   * \return The primitive record.
+   */
+  inline const vpPrimitive &getPrimitive(unsigned int i) const { return primitives()[i]; }
+
+  std::string getPrimitiveName(unsigned int i) const;
+
+  /*!
+   * Get the index of a point of a primitive in the points of the model.
+   *
+   * \param i : Index of the primitive, lower than getNbPrimitives().
+   * \param j : Index of the point in the primitive, lower than its number of indices.
+   * \return Index of the point, lower than getNbVertices().
+   */
+  inline unsigned int getPrimitiveVertex(unsigned int i, unsigned int j) const
+  {
+    return indices()[primitives()[i].firstIndex + j];
+  }
+
+  /*!
+   * Get the number of 3D points stored in the model.
+   *
+   * \return Number of points.
+   */
+  inline unsigned int getNbVertices() const { return header().nbVertices; }
+
+  /*!
+   * Get the size of the buffer that stores the model, which is also the size
+   * of the compiled model file.
+   *
+   * \return Size in bytes.
+   */
+  inline size_t getSize() const { return m_size; }
+
+  vpPoint getVertex(unsigned int k) const;
+
+  static bool isCompiledModel(const std::string &filename);
+
+  /*!
+   * Check if the model buffer is a memory mapping of a compiled model file.
+   *
+   * \return True if the model is memory mapped.
+   */
+  inline bool isMemoryMapped() const { return m_mapped; }
+
+  void load(const std::string &modelFile, bool verbose = false, const vpHomogeneousMatrix &odTo = vpHomogeneousMatrix());
+  void loadCAO(const std::string &modelFile, std::vector<std::string> &vectorOfModelFilename, bool verbose = false,
+               bool parent = true, const vpHomogeneousMatrix &odTo = vpHomogeneousMatrix());
+  void loadCompiled(const std::string &compiledFile);
+  void loadVRML(const std::string &modelFile);
+#ifdef VISP_HAVE_COIN3D
+  void loadVRMLCylinders(SoVRMLIndexedFaceSet *face_set, vpHomogeneousMatrix &transform, int &idFace,
+                         const std::string &polygonName = "");
+  void loadVRMLFaces(SoVRMLIndexedFaceSet *face_set, vpHomogeneousMatrix &transform, int &idFace,
+                     const std::string &polygonName = "");
+  void loadVRMLGroup(SoVRMLGroup *sceneGraphVRML2, vpHomogeneousMatrix &transform, int &idFace);
+  void loadVRMLLines(SoVRMLIndexedLineSet *line_set, int &idFace, const std::string &polygonName = "");
+#endif
+
+  void save(const std::string &compiledFile) const;
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+  struct vpHeader
+  {
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrder;
+    uint32_t nbPrimitives;
+    uint32_t nbIndices;
+    uint32_t nbVertices;
+    uint32_t namesSize;
+    uint32_t nbPoints;
+    uint32_t nbLines;
+    uint32_t nbPolygonLines;
+    uint32_t nbPolygonPoints;
+    uint32_t nbCylinders;
+    uint32_t nbCircles;
+    int32_t nbFaceIds;
+    uint32_t reserved;
+  };
+
+  class vpBuilder;
+#endif
+
+private:
+  void build(const vpBuilder &builder);
+  void check() const;
+
+#ifdef VISP_HAVE_COIN3D
+  static void extractCylinders(SoVRMLIndexedFaceSet *face_set, vpHomogeneousMatrix &transform, int &idFace,
+                               const std::string &polygonName, vpBuilder &builder);
+  static void extractFaces(SoVRMLIndexedFaceSet *face_set, vpHomogeneousMatrix &transform, int &idFace,
+                           const std::string &polygonName, vpBuilder &builder);
+  static void extractGroup(SoVRMLGroup *sceneGraphVRML2, vpHomogeneousMatrix &transform, int &idFace,
+                           vpBuilder &builder);
+  static void extractLines(SoVRMLIndexedLineSet *line_set, int &idFace, const std::string &polygonName,
+                           vpBuilder &builder);
+#endif
+
+  static void loadCAO(const std::string &modelFile, std::vector<std::string> &vectorOfModelFilename, int &startIdFace,
+                      bool verbose, bool parent, const vpHomogeneousMatrix &odTo, vpBuilder &builder);
+
+  const vpHeader &header() const;
+  const uint32_t *indices() const;
+  const char *names() const;
+  const vpPrimitive *primitives() const;
+  const double *vertices() const;
+
+  //! Buffer of the model, shared by the copies of the model
+  std::shared_ptr<const unsigned char> m_data;
+  //! Size of the buffer in bytes
+  size_t m_size;
+  //! True if the buffer is a memory mapping of a compiled model file
+  bool m_mapped;
+};
+END_VISP_NAMESPACE
+
+#endif
@@ -54,7 +54,7 @@
 
 BEGIN_VISP_NAMESPACE
 vpMbDepthDenseTracker::vpMbDepthDenseTracker()
-  : m_depthDenseHiddenFacesDisplay(), m_depthDenseListOfActiveFaces(), m_denseDepthNbFeatures(0), m_depthDenseFaces(),
+  : m_depthDenseHiddenFacesDisplay(), m_depthDenseHiddenFacesDisplayOutdated(false), m_depthDenseListOfActiveFaces(), m_denseDepthNbFeatures(0), m_depthDenseFaces(),
   m_depthDenseSamplingStepX(2), m_depthDenseSamplingStepY(2), m_error_depthDense(), m_L_depthDense(),
   m_robust_depthDense(), m_w_depthDense(), m_weightedError_depthDense()
 #if DEBUG_DISPLAY_DEPTH_DENSE
@@ -90,8 +90,8 @@ void vpMbDepthDenseTracker::addFace(vpMbtPolygon &polygon, bool alreadyClose)
     return;
   }
 
-  // Copy hidden faces
-  m_depthDenseHiddenFacesDisplay = faces;
+  // The hidden faces are copied for display once all the faces are added
+  m_depthDenseHiddenFacesDisplayOutdated = true;
 
   vpMbtFaceDepthDense *normal_face = new vpMbtFaceDepthDense;
   normal_face->m_hiddenFace = &faces;
@@ -339,6 +339,12 @@ std::vector<std::vector<double> > vpMbDepthDenseTracker::getModelForDisplay(unsi
 
   vpCameraParameters c = cam;
 
+  if (m_depthDenseHiddenFacesDisplayOutdated) {
+    // Copy hidden faces
+    m_depthDenseHiddenFacesDisplay = faces;
+    m_depthDenseHiddenFacesDisplayOutdated = false;
+  }
+
   bool changed = false;
   m_depthDenseHiddenFacesDisplay.setVisible(width, height, c, cMo, angleAppears, angleDisappears, changed);
 
@@ -609,8 +615,13 @@ void vpMbDepthDenseTracker::segmentPointCloud(const pcl::PointCloud<pcl::PointXY
 }
 #endif
 
-void vpMbDepthDenseTracker::segmentPointCloud(const std::vector<vpColVector> &point_cloud, unsigned int width,
-                                              unsigned int height)
+/*!
+  Compute the desired features of the visible and tracked faces with \e computeFaceFeatures, that samples the depth
+  of a face, and keep the faces for which it succeeds. \e width and \e height are the size of the depth data.
+*/
+template <class FaceFeatures>
+void vpMbDepthDenseTracker::segmentFaces(unsigned int width, unsigned int height,
+                                         const FaceFeatures &computeFaceFeatures)
 {
   m_depthDenseListOfActiveFaces.clear();
 
@@ -622,6 +633,9 @@ void vpMbDepthDenseTracker::segmentPointCloud(const std::vector<vpColVector> &po
 
   m_debugImage_depthDense = 0;
   std::vector<std::vector<vpImagePoint> > roiPts_vec;
+#else
+  (void)width;
+  (void)height;
 #endif
 
   for (std::vector<vpMbtFaceDepthDense *>::iterator it = m_depthDenseFaces.begin(); it != m_depthDenseFaces.end();
@@ -632,14 +646,12 @@ void vpMbDepthDenseTracker::segmentPointCloud(const std::vector<vpColVector> &po
 #if DEBUG_DISPLAY_DEPTH_DENSE
       std::vector<std::vector<vpImagePoint> > roiPts_vec_;
 #endif
-      if (face->computeDesiredFeatures(m_cMo, width, height, point_cloud, m_depthDenseSamplingStepX,
-                                       m_depthDenseSamplingStepY
+      if (computeFaceFeatures(face
 #if DEBUG_DISPLAY_DEPTH_DENSE
-                                       ,
-                                       m_debugImage_depthDense, roiPts_vec_
+                              ,
+                              roiPts_vec_
 #endif
-                                       ,
-                                       m_mask)) {
+                              )) {
         m_depthDenseListOfActiveFaces.push_back(*it);
 
 #if DEBUG_DISPLAY_DEPTH_DENSE
@@ -667,63 +679,88 @@ void vpMbDepthDenseTracker::segmentPointCloud(const std::vector<vpColVector> &po
 #endif
 }
 
+void vpMbDepthDenseTracker::segmentPointCloud(const std::vector<vpColVector> &point_cloud, unsigned int width,
+                                              unsigned int height)
+{
+  auto computeFaceFeatures = [&](vpMbtFaceDepthDense *face
+#if DEBUG_DISPLAY_DEPTH_DENSE
+                                 ,
+                                 std::vector<std::vector<vpImagePoint> > &roiPts_vec_
+#endif
+                                 ) {
+    return face->computeDesiredFeatures(m_cMo, width, height, point_cloud, m_depthDenseSamplingStepX,
+                                        m_depthDenseSamplingStepY
+#if DEBUG_DISPLAY_DEPTH_DENSE
+                                        ,
+                                        m_debugImage_depthDense, roiPts_vec_
+#endif
+                                        ,
+                                        m_mask);
+  };
+  segmentFaces(width, height, computeFaceFeatures);
+}
 
 void vpMbDepthDenseTracker::segmentPointCloud(const vpMatrix &point_cloud, unsigned int width,
                                               unsigned int height)
 {
-  m_depthDenseListOfActiveFaces.clear();
-
+  auto computeFaceFeatures = [&](vpMbtFaceDepthDense *face
 #if DEBUG_DISPLAY_DEPTH_DENSE
-  if (!m_debugDisp_depthDense->isInitialised()) {
-    m_debugImage_depthDense.resize(height, width);
-    m_debugDisp_depthDense->init(m_debugImage_depthDense, 50, 0, "Debug display dense depth tracker");
-  }
-
-  m_debugImage_depthDense = 0;
-  std::vector<std::vector<vpImagePoint> > roiPts_vec;
+                                 ,
+                                 std::vector<std::vector<vpImagePoint> > &roiPts_vec_
 #endif
+                                 ) {
+    return face->computeDesiredFeatures(m_cMo, width, height, point_cloud, m_depthDenseSamplingStepX,
+                                        m_depthDenseSamplingStepY
+#if DEBUG_DISPLAY_DEPTH_DENSE
+                                        ,
+                                        m_debugImage_depthDense, roiPts_vec_
+#endif
+                                        ,
+                                        m_mask);
+  };
+  segmentFaces(width, height, computeFaceFeatures);
+}
 
-  for (std::vector<vpMbtFaceDepthDense *>::iterator it = m_depthDenseFaces.begin(); it != m_depthDenseFaces.end();
-       ++it) {
-    vpMbtFaceDepthDense *face = *it;
-
-    if (face->isVisible() && face->isTracked()) {
+void vpMbDepthDenseTracker::segmentPointCloud(const vpPointCloud &point_cloud)
+{
+  const unsigned int width = point_cloud.getWidth(), height = point_cloud.getHeight();
+  auto computeFaceFeatures = [&](vpMbtFaceDepthDense *face
 #if DEBUG_DISPLAY_DEPTH_DENSE
-      std::vector<std::vector<vpImagePoint> > roiPts_vec_;
+                                 ,
+                                 std::vector<std::vector<vpImagePoint> > &roiPts_vec_
 #endif
-      if (face->computeDesiredFeatures(m_cMo, width, height, point_cloud, m_depthDenseSamplingStepX,
-                                       m_depthDenseSamplingStepY
+                                 ) {
+    return face->computeDesiredFeatures(m_cMo, width, height, point_cloud, m_depthDenseSamplingStepX,
+                                        m_depthDenseSamplingStepY
 #if DEBUG_DISPLAY_DEPTH_DENSE
-                                       ,
-                                       m_debugImage_depthDense, roiPts_vec_
+                                        ,
+                                        m_debugImage_depthDense, roiPts_vec_
 #endif
-                                       ,
-                                       m_mask)) {
-        m_depthDenseListOfActiveFaces.push_back(*it);
+                                        ,
+                                        m_mask);
+  };
+  segmentFaces(width, height, computeFaceFeatures);
+}
 
+void vpMbDepthDenseTracker::segmentPointCloud(const vpImage<uint16_t> &depth_raw, float depth_scale)
+{
+  const unsigned int width = depth_raw.getWidth(), height = depth_raw.getHeight();
+  auto computeFaceFeatures = [&](vpMbtFaceDepthDense *face
 #if DEBUG_DISPLAY_DEPTH_DENSE
-        roiPts_vec.insert(roiPts_vec.end(), roiPts_vec_.begin(), roiPts_vec_.end());
+                                 ,
+                                 std::vector<std::vector<vpImagePoint> > &roiPts_vec_
 #endif
-      }
-    }
-  }
-
+                                 ) {
+    return face->computeDesiredFeatures(m_cMo, depth_raw, depth_scale, m_depthDenseSamplingStepX,
+                                        m_depthDenseSamplingStepY
 #if DEBUG_DISPLAY_DEPTH_DENSE
-  vpDisplay::display(m_debugImage_depthDense);
-
-  for (size_t i = 0; i < roiPts_vec.size(); i++) {
-    if (roiPts_vec[i].empty())
-      continue;
-
-    for (size_t j = 0; j < roiPts_vec[i].size() - 1; j++) {
-      vpDisplay::displayLine(m_debugImage_depthDense, roiPts_vec[i][j], roiPts_vec[i][j + 1], vpColor::red, 2);
-    }
-    vpDisplay::displayLine(m_debugImage_depthDense, roiPts_vec[i][0], roiPts_vec[i][roiPts_vec[i].size() - 1],
-                           vpColor::red, 2);
-  }
-
-  vpDisplay::flush(m_debugImage_depthDense);
+                                        ,
+                                        m_debugImage_depthDense, roiPts_vec_
 #endif
+                                        ,
+                                        m_mask);
+  };
+  segmentFaces(width, height, computeFaceFeatures);
 }
 
 void vpMbDepthDenseTracker::setOgreVisibilityTest(const bool &v)
@@ -810,6 +847,35 @@ void vpMbDepthDenseTracker::track(const std::vector<vpColVector> &point_cloud, u
   computeVisibility(width, height);
 }
 
+/*!
+  Track the object in the given organized point cloud, for instance computed with
+  vpImageConvert::depthToPointCloud().
+*/
+void vpMbDepthDenseTracker::track(const vpPointCloud &point_cloud)
+{
+  segmentPointCloud(point_cloud);
+
+  computeVVS();
+
+  computeVisibility(point_cloud.getWidth(), point_cloud.getHeight());
+}
+
+/*!
+  Track the object in the given depth image. Only the pixels inside the projection of the visible faces are
+  unprojected, at the sampling steps of the tracker, using the camera parameters of the tracker.
+
+  \param depth_raw : Raw depth image, of the size used to set the camera parameters.
+  \param depth_scale : Depth scale to convert the raw values in meter, for instance 0.001 for a depth in mm.
+*/
+void vpMbDepthDenseTracker::track(const vpImage<uint16_t> &depth_raw, float depth_scale)
+{
+  segmentPointCloud(depth_raw, depth_scale);
+
+  computeVVS();
+
+  computeVisibility(depth_raw.getWidth(), depth_raw.getHeight());
+}
+
 void vpMbDepthDenseTracker::initCircle(const vpPoint & /*p1*/, const vpPoint & /*p2*/, const vpPoint & /*p3*/,
                                        double /*radius*/, int /*idFace*/, const std::string & /*name*/)
 {
@@ -55,7 +55,7 @@
 BEGIN_VISP_NAMESPACE
 vpMbDepthNormalTracker::vpMbDepthNormalTracker()
   : m_depthNormalFeatureEstimationMethod(vpMbtFaceDepthNormal::ROBUST_FEATURE_ESTIMATION),
-  m_depthNormalHiddenFacesDisplay(), m_depthNormalListOfActiveFaces(), m_depthNormalListOfDesiredFeatures(),
+  m_depthNormalHiddenFacesDisplay(), m_depthNormalHiddenFacesDisplayOutdated(false), m_depthNormalListOfActiveFaces(), m_depthNormalListOfDesiredFeatures(),
   m_depthNormalFaces(), m_depthNormalPclPlaneEstimationMethod(2), m_depthNormalPclPlaneEstimationRansacMaxIter(200),
   m_depthNormalPclPlaneEstimationRansacThreshold(0.001), m_depthNormalSamplingStepX(2), m_depthNormalSamplingStepY(2),
   m_depthNormalUseRobust(false), m_error_depthNormal(), m_featuresToBeDisplayedDepthNormal(), m_L_depthNormal(),
@@ -89,8 +89,8 @@ void vpMbDepthNormalTracker::addFace(vpMbtPolygon &polygon, bool alreadyClose)
     return;
   }
 
-  // Copy hidden faces
-  m_depthNormalHiddenFacesDisplay = faces;
+  // The hidden faces are copied for display once all the faces are added
+  m_depthNormalHiddenFacesDisplayOutdated = true;
 
   vpMbtFaceDepthNormal *normal_face = new vpMbtFaceDepthNormal;
   normal_face->m_hiddenFace = &faces;
@@ -377,6 +377,12 @@ std::vector<std::vector<double> > vpMbDepthNormalTracker::getModelForDisplay(uns
 
   vpCameraParameters c = cam;
 
+  if (m_depthNormalHiddenFacesDisplayOutdated) {
+    // Copy hidden faces
+    m_depthNormalHiddenFacesDisplay = faces;
+    m_depthNormalHiddenFacesDisplayOutdated = false;
+  }
+
   bool changed = false;
   m_depthNormalHiddenFacesDisplay.setVisible(width, height, c, cMo, angleAppears, angleDisappears, changed);
 
@@ -667,8 +673,13 @@ void vpMbDepthNormalTracker::segmentPointCloud(const pcl::PointCloud<pcl::PointX
 }
 #endif
 
-void vpMbDepthNormalTracker::segmentPointCloud(const std::vector<vpColVector> &point_cloud, unsigned int width,
-                                               unsigned int height)
+/*!
+  Compute the desired features of the visible and tracked faces with \e computeFaceFeatures, that samples the depth
+  of a face, and keep the faces for which it succeeds. \e width and \e height are the size of the depth data.
+*/
+template <class FaceFeatures>
+void vpMbDepthNormalTracker::segmentFaces(unsigned int width, unsigned int height,
+                                          const FaceFeatures &computeFaceFeatures)
 {
   m_depthNormalListOfActiveFaces.clear();
   m_depthNormalListOfDesiredFeatures.clear();
@@ -681,6 +692,9 @@ void vpMbDepthNormalTracker::segmentPointCloud(const std::vector<vpColVector> &p
 
   m_debugImage_depthNormal = 0;
   std::vector<std::vector<vpImagePoint> > roiPts_vec;
+#else
+  (void)width;
+  (void)height;
 #endif
 
   for (std::vector<vpMbtFaceDepthNormal *>::iterator it = m_depthNormalFaces.begin(); it != m_depthNormalFaces.end();
@@ -694,14 +708,12 @@ void vpMbDepthNormalTracker::segmentPointCloud(const std::vector<vpColVector> &p
       std::vector<std::vector<vpImagePoint> > roiPts_vec_;
 #endif
 
-      if (face->computeDesiredFeatures(m_cMo, width, height, point_cloud, desired_features, m_depthNormalSamplingStepX,
-                                       m_depthNormalSamplingStepY
+      if (computeFaceFeatures(face, desired_features
 #if DEBUG_DISPLAY_DEPTH_NORMAL
-                                       ,
-                                       m_debugImage_depthNormal, roiPts_vec_
+                              ,
+                              roiPts_vec_
 #endif
-                                       ,
-                                       m_mask)) {
+                              )) {
         m_depthNormalListOfDesiredFeatures.push_back(desired_features);
         m_depthNormalListOfActiveFaces.push_back(face);
 
@@ -730,67 +742,88 @@ void vpMbDepthNormalTracker::segmentPointCloud(const std::vector<vpColVector> &p
 #endif
 }
 
-void vpMbDepthNormalTracker::segmentPointCloud(const vpMatrix &point_cloud, unsigned int width,
+void vpMbDepthNormalTracker::segmentPointCloud(const std::vector<vpColVector> &point_cloud, unsigned int width,
                                                unsigned int height)
 {
-  m_depthNormalListOfActiveFaces.clear();
-  m_depthNormalListOfDesiredFeatures.clear();
-
+  auto computeFaceFeatures = [&](vpMbtFaceDepthNormal *face, vpColVector &desired_features
 #if DEBUG_DISPLAY_DEPTH_NORMAL
-  if (!m_debugDisp_depthNormal->isInitialised()) {
-    m_debugImage_depthNormal.resize(height, width);
-    m_debugDisp_depthNormal->init(m_debugImage_depthNormal, 50, 0, "Debug display normal depth tracker");
-  }
-
-  m_debugImage_depthNormal = 0;
-  std::vector<std::vector<vpImagePoint> > roiPts_vec;
+                                 ,
+                                 std::vector<std::vector<vpImagePoint> > &roiPts_vec_
 #endif
-
-  for (std::vector<vpMbtFaceDepthNormal *>::iterator it = m_depthNormalFaces.begin(); it != m_depthNormalFaces.end();
-       ++it) {
-    vpMbtFaceDepthNormal *face = *it;
-
-    if (face->isVisible() && face->isTracked()) {
-      vpColVector desired_features;
-
+                                 ) {
+    return face->computeDesiredFeatures(m_cMo, width, height, point_cloud, desired_features, m_depthNormalSamplingStepX,
+                                        m_depthNormalSamplingStepY
 #if DEBUG_DISPLAY_DEPTH_NORMAL
-      std::vector<std::vector<vpImagePoint> > roiPts_vec_;
+                                        ,
+                                        m_debugImage_depthNormal, roiPts_vec_
 #endif
+                                        ,
+                                        m_mask);
+  };
+  segmentFaces(width, height, computeFaceFeatures);
+}
 
-      if (face->computeDesiredFeatures(m_cMo, width, height, point_cloud, desired_features, m_depthNormalSamplingStepX,
-                                       m_depthNormalSamplingStepY
+void vpMbDepthNormalTracker::segmentPointCloud(const vpMatrix &point_cloud, unsigned int width,
+                                               unsigned int height)
+{
+  auto computeFaceFeatures = [&](vpMbtFaceDepthNormal *face, vpColVector &desired_features
 #if DEBUG_DISPLAY_DEPTH_NORMAL
-                                       ,
-                                       m_debugImage_depthNormal, roiPts_vec_
+                                 ,
+                                 std::vector<std::vector<vpImagePoint> > &roiPts_vec_
 #endif
-                                       ,
-                                       m_mask)) {
-        m_depthNormalListOfDesiredFeatures.push_back(desired_features);
-        m_depthNormalListOfActiveFaces.push_back(face);
-
+                                 ) {
+    return face->computeDesiredFeatures(m_cMo, width, height, point_cloud, desired_features, m_depthNormalSamplingStepX,
+                                        m_depthNormalSamplingStepY
 #if DEBUG_DISPLAY_DEPTH_NORMAL
-        roiPts_vec.insert(roiPts_vec.end(), roiPts_vec_.begin(), roiPts_vec_.end());
+                                        ,
+                                        m_debugImage_depthNormal, roiPts_vec_
 #endif
-      }
-    }
-  }
+                                        ,
+                                        m_mask);
+  };
+  segmentFaces(width, height, computeFaceFeatures);
+}
 
+void vpMbDepthNormalTracker::segmentPointCloud(const vpPointCloud &point_cloud)
+{
+  const unsigned int width = point_cloud.getWidth(), height = point_cloud.getHeight();
+  auto computeFaceFeatures = [&](vpMbtFaceDepthNormal *face, vpColVector &desired_features
 #if DEBUG_DISPLAY_DEPTH_NORMAL
-  vpDisplay::display(m_debugImage_depthNormal);
-
-  for (size_t i = 0; i < roiPts_vec.size(); i++) {
-    if (roiPts_vec[i].empty())
-      continue;
-
-    for (size_t j = 0; j < roiPts_vec[i].size() - 1; j++) {
-      vpDisplay::displayLine(m_debugImage_depthNormal, roiPts_vec[i][j], roiPts_vec[i][j + 1], vpColor::red, 2);
-    }
-    vpDisplay::displayLine(m_debugImage_depthNormal, roiPts_vec[i][0], roiPts_vec[i][roiPts_vec[i].size() - 1],
-                           vpColor::red, 2);
-  }
+                                 ,
+                                 std::vector<std::vector<vpImagePoint> > &roiPts_vec_
+#endif
+                                 ) {
+    return face->computeDesiredFeatures(m_cMo, width, height, point_cloud, desired_features, m_depthNormalSamplingStepX,
+                                        m_depthNormalSamplingStepY
+#if DEBUG_DISPLAY_DEPTH_NORMAL
+                                        ,
+                                        m_debugImage_depthNormal, roiPts_vec_
+#endif
+                                        ,
+                                        m_mask);
+  };
+  segmentFaces(width, height, computeFaceFeatures);
+}
 
-  vpDisplay::flush(m_debugImage_depthNormal);
+void vpMbDepthNormalTracker::segmentPointCloud(const vpImage<uint16_t> &depth_raw, float depth_scale)
+{
+  const unsigned int width = depth_raw.getWidth(), height = depth_raw.getHeight();
+  auto computeFaceFeatures = [&](vpMbtFaceDepthNormal *face, vpColVector &desired_features
+#if DEBUG_DISPLAY_DEPTH_NORMAL
+                                 ,
+                                 std::vector<std::vector<vpImagePoint> > &roiPts_vec_
+#endif
+                                 ) {
+    return face->computeDesiredFeatures(m_cMo, depth_raw, depth_scale, desired_features, m_depthNormalSamplingStepX,
+                                        m_depthNormalSamplingStepY
+#if DEBUG_DISPLAY_DEPTH_NORMAL
+                                        ,
+                                        m_debugImage_depthNormal, roiPts_vec_
 #endif
+                                        ,
+                                        m_mask);
+  };
+  segmentFaces(width, height, computeFaceFeatures);
 }
 
 void vpMbDepthNormalTracker::setCameraParameters(const vpCameraParameters &cam)
@@ -897,6 +930,35 @@ void vpMbDepthNormalTracker::track(const std::vector<vpColVector> &point_cloud,
   computeVisibility(width, height);
 }
 
+/*!
+  Track the object in the given organized point cloud, for instance computed with
+  vpImageConvert::depthToPointCloud().
+*/
+void vpMbDepthNormalTracker::track(const vpPointCloud &point_cloud)
+{
+  segmentPointCloud(point_cloud);
+
+  computeVVS();
+
+  computeVisibility(point_cloud.getWidth(), point_cloud.getHeight());
+}
+
+/*!
+  Track the object in the given depth image. Only the pixels inside the projection of the visible faces are
+  unprojected, at the sampling steps of the tracker, using the camera parameters of the tracker.
+
+  \param depth_raw : Raw depth image, of the size used to set the camera parameters.
+  \param depth_scale : Depth scale to convert the raw values in meter, for instance 0.001 for a depth in mm.
+*/
+void vpMbDepthNormalTracker::track(const vpImage<uint16_t> &depth_raw, float depth_scale)
+{
+  segmentPointCloud(depth_raw, depth_scale);
+
+  computeVVS();
+
+  computeVisibility(depth_raw.getWidth(), depth_raw.getHeight());
+}
+
 void vpMbDepthNormalTracker::initCircle(const vpPoint & /*p1*/, const vpPoint & /*p2*/, const vpPoint & /*p3*/,
                                         double /*radius*/, int /*idFace*/, const std::string & /*name*/)
 {
@@ -36,6 +36,8 @@
 #include <visp3/core/vpCPUFeatures.h>
 #include <visp3/mbt/vpMbtFaceDepthDense.h>
 
+#include "vpMbtFaceDepthPoints_impl.h"
+
 #if defined(VISP_HAVE_PCL) && defined(VISP_HAVE_PCL_COMMON)
 #include <pcl/common/point_tests.h>
 #endif
@@ -269,11 +271,37 @@ bool vpMbtFaceDepthDense::computeDesiredFeatures(const vpHomogeneousMatrix &cMo,
                                                  ,
                                                  const vpImage<bool> *mask)
 {
-  unsigned int width = point_cloud->width, height = point_cloud->height;
+  const vpMbtRawDepthPoints points(depth_raw, depth_scale, m_cam);
+  return computeDesiredFeaturesFromPoints(cMo, depth_raw.getWidth(), depth_raw.getHeight(), points, stepX, stepY
+#if DEBUG_DISPLAY_DEPTH_DENSE
+                                          ,
+                                          debugImage, roiPts_vec
+#endif
+                                          ,
+                                          mask);
+}
+#endif
+
+/*!
+  Keep the points of the point cloud sampled inside the projection of the face, with the steps \e stepX and \e stepY.
+  The point of a pixel is read through \e points, whatever the representation of the point cloud.
+*/
+template <class PointAccessor>
+bool vpMbtFaceDepthDense::computeDesiredFeaturesFromPoints(const vpHomogeneousMatrix &cMo, unsigned int width,
+                                                           unsigned int height, const PointAccessor &points,
+                                                           unsigned int stepX, unsigned int stepY
+#if DEBUG_DISPLAY_DEPTH_DENSE
+                                                           ,
+                                                           vpImage<unsigned char> &debugImage,
+                                                           std::vector<std::vector<vpImagePoint> > &roiPts_vec
+#endif
+                                                           ,
+                                                           const vpImage<bool> *mask)
+{
   m_pointCloudFace.clear();
 
-  if (point_cloud->width == 0 || point_cloud->height == 0)
-    return false;
+  if (width == 0 || height == 0)
+    return 0;
 
   std::vector<vpImagePoint> roiPts;
   double distanceToFace;
@@ -310,10 +338,6 @@ bool vpMbtFaceDepthDense::computeDesiredFeatures(const vpHomogeneousMatrix &cMo,
   bb.setLeft(left);
   bb.setRight(right);
 
-  if (bb.getHeight() < 0 || bb.getWidth() < 0) {
-    return false;
-  }
-
   m_pointCloudFace.reserve((size_t)(bb.getWidth() * bb.getHeight()));
 
   int totalTheoreticalPoints = 0, totalPoints = 0;
@@ -325,12 +349,14 @@ bool vpMbtFaceDepthDense::computeDesiredFeatures(const vpHomogeneousMatrix &cMo,
            : polygon_2d.isInside(vpImagePoint(i, j)))) {
         totalTheoreticalPoints++;
 
-        if (vpMeTracker::inRoiMask(mask, i, j) && pcl::isFinite((*point_cloud)(j, i)) && (*point_cloud)(j, i).z > 0) {
+        if (vpMeTracker::inRoiMask(mask, i, j) && points.hasPoint(i, j)) {
           totalPoints++;
 
-          m_pointCloudFace.push_back((*point_cloud)(j, i).x);
-          m_pointCloudFace.push_back((*point_cloud)(j, i).y);
-          m_pointCloudFace.push_back((*point_cloud)(j, i).z);
+          double X = 0.0, Y = 0.0, Z = 0.0;
+          points.getPoint(i, j, X, Y, Z);
+          m_pointCloudFace.push_back(X);
+          m_pointCloudFace.push_back(Y);
+          m_pointCloudFace.push_back(Z);
 
 #if DEBUG_DISPLAY_DEPTH_DENSE
           debugImage[i][j] = 255;
@@ -347,7 +373,6 @@ bool vpMbtFaceDepthDense::computeDesiredFeatures(const vpHomogeneousMatrix &cMo,
 
   return true;
 }
-#endif
 
 bool vpMbtFaceDepthDense::computeDesiredFeatures(const vpHomogeneousMatrix &cMo, unsigned int width,
                                                  unsigned int height, const std::vector<vpColVector> &point_cloud,
@@ -360,82 +385,73 @@ bool vpMbtFaceDepthDense::computeDesiredFeatures(const vpHomogeneousMatrix &cMo,
                                                  ,
                                                  const vpImage<bool> *mask)
 {
-  m_pointCloudFace.clear();
-
-  if (width == 0 || height == 0)
-    return 0;
-
-  std::vector<vpImagePoint> roiPts;
-  double distanceToFace;
-  computeROI(cMo, width, height, roiPts
+  const vpMbtColVectorPoints points(point_cloud, width);
+  return computeDesiredFeaturesFromPoints(cMo, width, height, points, stepX, stepY
 #if DEBUG_DISPLAY_DEPTH_DENSE
-             ,
-             roiPts_vec
+                                          ,
+                                          debugImage, roiPts_vec
 #endif
-             ,
-             distanceToFace);
+                                          ,
+                                          mask);
+}
 
-  if (roiPts.size() <= 2) {
-#ifndef NDEBUG
-    std::cerr << "Error: roiPts.size() <= 2 in computeDesiredFeatures" << std::endl;
+bool vpMbtFaceDepthDense::computeDesiredFeatures(const vpHomogeneousMatrix &cMo, unsigned int width,
+                                                 unsigned int height, const vpMatrix &point_cloud,
+                                                 unsigned int stepX, unsigned int stepY
+#if DEBUG_DISPLAY_DEPTH_DENSE
+                                                 ,
+                                                 vpImage<unsigned char> &debugImage,
+                                                 std::vector<std::vector<vpImagePoint> > &roiPts_vec
 #endif
-    return false;
-  }
-
-  if (((m_depthDenseFilteringMethod & MAX_DISTANCE_FILTERING) && distanceToFace > m_depthDenseFilteringMaxDist) ||
-      ((m_depthDenseFilteringMethod & MIN_DISTANCE_FILTERING) && distanceToFace < m_depthDenseFilteringMinDist)) {
-    return false;
-  }
-
-  vpPolygon polygon_2d(roiPts);
-  vpRect bb = polygon_2d.getBoundingBox();
-
-  unsigned int top = (unsigned int)std::max<double>(0.0, bb.getTop());
-  unsigned int bottom = (unsigned int)std::min<double>((double)height, std::max<double>(0.0, bb.getBottom()));
-  unsigned int left = (unsigned int)std::max<double>(0.0, bb.getLeft());
-  unsigned int right = (unsigned int)std::min<double>((double)width, std::max<double>(0.0, bb.getRight()));
-
-  bb.setTop(top);
-  bb.setBottom(bottom);
-  bb.setLeft(left);
-  bb.setRight(right);
-
-  m_pointCloudFace.reserve((size_t)(bb.getWidth() * bb.getHeight()));
-
-  int totalTheoreticalPoints = 0, totalPoints = 0;
-  for (unsigned int i = top; i < bottom; i += stepY) {
-    for (unsigned int j = left; j < right; j += stepX) {
-      if ((m_useScanLine ? (i < m_hiddenFace->getMbScanLineRenderer().getPrimitiveIDs().getHeight() &&
-                            j < m_hiddenFace->getMbScanLineRenderer().getPrimitiveIDs().getWidth() &&
-                            m_hiddenFace->getMbScanLineRenderer().getPrimitiveIDs()[i][j] == m_polygon->getIndex())
-           : polygon_2d.isInside(vpImagePoint(i, j)))) {
-        totalTheoreticalPoints++;
-
-        if (vpMeTracker::inRoiMask(mask, i, j) && point_cloud[i * width + j][2] > 0) {
-          totalPoints++;
-
-          m_pointCloudFace.push_back(point_cloud[i * width + j][0]);
-          m_pointCloudFace.push_back(point_cloud[i * width + j][1]);
-          m_pointCloudFace.push_back(point_cloud[i * width + j][2]);
-
+                                                 ,
+                                                 const vpImage<bool> *mask)
+{
+  const vpMbtMatrixPoints points(point_cloud, width);
+  return computeDesiredFeaturesFromPoints(cMo, width, height, points, stepX, stepY
 #if DEBUG_DISPLAY_DEPTH_DENSE
-          debugImage[i][j] = 255;
+                                          ,
+                                          debugImage, roiPts_vec
 #endif
-        }
-      }
-    }
-  }
-
-  if (totalPoints == 0 || ((m_depthDenseFilteringMethod & DEPTH_OCCUPANCY_RATIO_FILTERING) &&
-                           totalPoints / (double)totalTheoreticalPoints < m_depthDenseFilteringOccupancyRatio)) {
-    return false;
-  }
-
-  return true;
+                                          ,
+                                          mask);
 }
 
 bool vpMbtFaceDepthDense::computeDesiredFeatures(const vpHomogeneousMatrix &cMo, unsigned int width,
-                                                 unsigned int height, const vpMatrix &point_cloud,
+                                                 unsigned int height, const vpPointCloud &point_cloud,
+                                                 unsigned int stepX, unsigned int stepY
+#if DEBUG_DISPLAY_DEPTH_DENSE
+                                                 ,
+                                                 vpImage<unsigned char> &debugImage,
+                                                 std::vector<std::vector<vpImagePoint> > &roiPts_vec
+#endif
+                                                 ,
+                                                 const vpImage<bool> *mask)
+{
+  const vpMbtPointCloudPoints points(point_cloud, width);
+  return computeDesiredFeaturesFromPoints(cMo, width, height, points, stepX, stepY
+#if DEBUG_DISPLAY_DEPTH_DENSE
+                                          ,
+                                          debugImage, roiPts_vec
+#endif
+                                          ,
+                                          mask);
+}
+
+/*!
+  Sample the depth image inside the projection of the face, with the steps \e stepX and \e stepY, and
+  unproject the sampled pixels with the camera parameters of the face.
+
+  \param cMo : Pose of the object in the depth camera frame.
+  \param depth_raw : Raw depth image, of the size used to set the camera parameters.
+  \param depth_scale : Depth scale to convert the raw values in meter, for instance 0.001 for a depth in mm.
+  A null raw value means that the depth is unknown.
+  \param stepX : Sampling step along the columns.
+  \param stepY : Sampling step along the rows.
+  \param mask : If not null, only the pixels of the mask that are true are considered.
+  \return true if the face has enough valid depth samples to be tracked.
+*/
+bool vpMbtFaceDepthDense::computeDesiredFeatures(const vpHomogeneousMatrix &cMo,
+                                                 const vpImage<uint16_t> &depth_raw, float depth_scale,
                                                  unsigned int stepX, unsigned int stepY
 #if DEBUG_DISPLAY_DEPTH_DENSE
                                                  ,
@@ -447,6 +463,7 @@ bool vpMbtFaceDepthDense::computeDesiredFeatures(const vpHomogeneousMatrix &cMo,
 {
   m_pointCloudFace.clear();
 
+  const unsigned int width = depth_raw.getWidth(), height = depth_raw.getHeight();
   if (width == 0 || height == 0)
     return 0;
 
@@ -496,12 +513,16 @@ bool vpMbtFaceDepthDense::computeDesiredFeatures(const vpHomogeneousMatrix &cMo,
            : polygon_2d.isInside(vpImagePoint(i, j)))) {
         totalTheoreticalPoints++;
 
-        if (vpMeTracker::inRoiMask(mask, i, j) && point_cloud[i * width + j][2] > 0) {
+        if (vpMeTracker::inRoiMask(mask, i, j) && depth_raw[i][j] > 0) {
           totalPoints++;
 
-          m_pointCloudFace.push_back(point_cloud[i * width + j][0]);
-          m_pointCloudFace.push_back(point_cloud[i * width + j][1]);
-          m_pointCloudFace.push_back(point_cloud[i * width + j][2]);
+          // Unproject the sampled pixel only
+          const double Z = depth_scale * depth_raw[i][j];
+          double x = 0.0, y = 0.0;
+          vpPixelMeterConversion::convertPoint(m_cam, j, i, x, y);
+          m_pointCloudFace.push_back(x * Z);
+          m_pointCloudFace.push_back(y * Z);
+          m_pointCloudFace.push_back(Z);
 
 #if DEBUG_DISPLAY_DEPTH_DENSE
           debugImage[i][j] = 255;
@@ -37,6 +37,8 @@
 #include <visp3/mbt/vpMbtFaceDepthNormal.h>
 #include <visp3/mbt/vpMbtTukeyEstimator.h>
 
+#include "vpMbtFaceDepthPoints_impl.h"
+
 #if defined(VISP_HAVE_PCL) && defined(VISP_HAVE_PCL_SEGMENTATION) && defined(VISP_HAVE_PCL_FILTERS) && defined(VISP_HAVE_PCL_COMMON)
 #include <pcl/common/centroid.h>
 #include <pcl/filters/extract_indices.h>
@@ -315,16 +317,23 @@ bool vpMbtFaceDepthNormal::computeDesiredFeatures(const vpHomogeneousMatrix &cMo
 }
 #endif
 
-bool vpMbtFaceDepthNormal::computeDesiredFeatures(const vpHomogeneousMatrix &cMo, unsigned int width,
-                                                  unsigned int height, const std::vector<vpColVector> &point_cloud,
-                                                  vpColVector &desired_features, unsigned int stepX, unsigned int stepY
+/*!
+  Estimate the desired features from the points of the point cloud sampled inside the projection of the face, with
+  the steps \e stepX and \e stepY. The point of a pixel is read through \e points, whatever the representation of
+  the point cloud.
+*/
+template <class PointAccessor>
+bool vpMbtFaceDepthNormal::computeDesiredFeaturesFromPoints(const vpHomogeneousMatrix &cMo, unsigned int width,
+                                                            unsigned int height, const PointAccessor &points,
+                                                            vpColVector &desired_features, unsigned int stepX,
+                                                            unsigned int stepY
 #if DEBUG_DISPLAY_DEPTH_NORMAL
-                                                  ,
-                                                  vpImage<unsigned char> &debugImage,
-                                                  std::vector<std::vector<vpImagePoint> > &roiPts_vec
+                                                            ,
+                                                            vpImage<unsigned char> &debugImage,
+                                                            std::vector<std::vector<vpImagePoint> > &roiPts_vec
 #endif
-                                                  ,
-                                                  const vpImage<bool> *mask)
+                                                            ,
+                                                            const vpImage<bool> *mask)
 {
   m_faceActivated = false;
 
@@ -380,15 +389,18 @@ bool vpMbtFaceDepthNormal::computeDesiredFeatures(const vpHomogeneousMatrix &cMo
   double x = 0.0, y = 0.0;
   for (unsigned int i = top; i < bottom; i += stepY) {
     for (unsigned int j = left; j < right; j += stepX) {
-      if (vpMeTracker::inRoiMask(mask, i, j) && point_cloud[i * width + j][2] > 0 &&
+      if (vpMeTracker::inRoiMask(mask, i, j) && points.hasPoint(i, j) &&
           (m_useScanLine ? (i < m_hiddenFace->getMbScanLineRenderer().getPrimitiveIDs().getHeight() &&
                             j < m_hiddenFace->getMbScanLineRenderer().getPrimitiveIDs().getWidth() &&
                             m_hiddenFace->getMbScanLineRenderer().getPrimitiveIDs()[i][j] == m_polygon->getIndex())
            : polygon_2d.isInside(vpImagePoint(i, j)))) {
-// Add point
-        point_cloud_face.push_back(point_cloud[i * width + j][0]);
-        point_cloud_face.push_back(point_cloud[i * width + j][1]);
-        point_cloud_face.push_back(point_cloud[i * width + j][2]);
+        double X = 0.0, Y = 0.0, Z = 0.0;
+        points.getPoint(i, j, X, Y, Z);
+
+        // Add point
+        point_cloud_face.push_back(X);
+        point_cloud_face.push_back(Y);
+        point_cloud_face.push_back(Z);
 
         if (m_featureEstimationMethod == ROBUST_FEATURE_ESTIMATION) {
           // Add point for custom method for plane equation estimation
@@ -400,7 +412,7 @@ bool vpMbtFaceDepthNormal::computeDesiredFeatures(const vpHomogeneousMatrix &cMo
               push = true;
               prev_x = x;
               prev_y = y;
-              prev_z = point_cloud[i * width + j][2];
+              prev_z = Z;
             }
             else {
               push = false;
@@ -411,14 +423,14 @@ bool vpMbtFaceDepthNormal::computeDesiredFeatures(const vpHomogeneousMatrix &cMo
               point_cloud_face_custom.push_back(y);
 
               point_cloud_face_custom.push_back(prev_z);
-              point_cloud_face_custom.push_back(point_cloud[i * width + j][2]);
+              point_cloud_face_custom.push_back(Z);
             }
 #endif
           }
           else {
             point_cloud_face_custom.push_back(x);
             point_cloud_face_custom.push_back(y);
-            point_cloud_face_custom.push_back(point_cloud[i * width + j][2]);
+            point_cloud_face_custom.push_back(Z);
           }
         }
 
@@ -477,7 +489,7 @@ bool vpMbtFaceDepthNormal::computeDesiredFeatures(const vpHomogeneousMatrix &cMo
 }
 
 bool vpMbtFaceDepthNormal::computeDesiredFeatures(const vpHomogeneousMatrix &cMo, unsigned int width,
-                                                  unsigned int height, const vpMatrix &point_cloud,
+                                                  unsigned int height, const std::vector<vpColVector> &point_cloud,
                                                   vpColVector &desired_features, unsigned int stepX, unsigned int stepY
 #if DEBUG_DISPLAY_DEPTH_NORMAL
                                                   ,
@@ -487,154 +499,92 @@ bool vpMbtFaceDepthNormal::computeDesiredFeatures(const vpHomogeneousMatrix &cMo
                                                   ,
                                                   const vpImage<bool> *mask)
 {
-  m_faceActivated = false;
-
-  if (width == 0 || height == 0)
-    return false;
-
-  std::vector<vpImagePoint> roiPts;
-  vpColVector desired_normal(3);
-
-  computeROI(cMo, width, height, roiPts
+  const vpMbtColVectorPoints points(point_cloud, width);
+  return computeDesiredFeaturesFromPoints(cMo, width, height, points, desired_features, stepX, stepY
 #if DEBUG_DISPLAY_DEPTH_NORMAL
-             ,
-             roiPts_vec
+                                          ,
+                                          debugImage, roiPts_vec
 #endif
-  );
+                                          ,
+                                          mask);
+}
 
-  if (roiPts.size() <= 2) {
-#ifndef NDEBUG
-    std::cerr << "Error: roiPts.size() <= 2 in computeDesiredFeatures" << std::endl;
+bool vpMbtFaceDepthNormal::computeDesiredFeatures(const vpHomogeneousMatrix &cMo, unsigned int width,
+                                                  unsigned int height, const vpMatrix &point_cloud,
+                                                  vpColVector &desired_features, unsigned int stepX, unsigned int stepY
+#if DEBUG_DISPLAY_DEPTH_NORMAL
+                                                  ,
+                                                  vpImage<unsigned char> &debugImage,
+                                                  std::vector<std::vector<vpImagePoint> > &roiPts_vec
 #endif
-    return false;
-  }
-
-  vpPolygon polygon_2d(roiPts);
-  vpRect bb = polygon_2d.getBoundingBox();
-
-  unsigned int top = (unsigned int)std::max<double>(0.0, bb.getTop());
-  unsigned int bottom = (unsigned int)std::min<double>((double)height, std::max<double>(0.0, bb.getBottom()));
-  unsigned int left = (unsigned int)std::max<double>(0.0, bb.getLeft());
-  unsigned int right = (unsigned int)std::min<double>((double)width, std::max<double>(0.0, bb.getRight()));
-
-  bb.setTop(top);
-  bb.setBottom(bottom);
-  bb.setLeft(left);
-  bb.setRight(right);
-
-  // Keep only 3D points inside the projected polygon face
-  std::vector<double> point_cloud_face, point_cloud_face_custom;
-
-  point_cloud_face.reserve((size_t)(3 * bb.getWidth() * bb.getHeight()));
-  if (m_featureEstimationMethod == ROBUST_FEATURE_ESTIMATION) {
-    point_cloud_face_custom.reserve((size_t)(3 * bb.getWidth() * bb.getHeight()));
-  }
-
-  bool checkSSE2 = vpCPUFeatures::checkSSE2();
-#if !USE_SSE
-  checkSSE2 = false;
-#else
-  bool push = false;
-  double prev_x, prev_y, prev_z;
+                                                  ,
+                                                  const vpImage<bool> *mask)
+{
+  const vpMbtMatrixPoints points(point_cloud, width);
+  return computeDesiredFeaturesFromPoints(cMo, width, height, points, desired_features, stepX, stepY
+#if DEBUG_DISPLAY_DEPTH_NORMAL
+                                          ,
+                                          debugImage, roiPts_vec
 #endif
+                                          ,
+                                          mask);
+}
 
-  double x = 0.0, y = 0.0;
-  for (unsigned int i = top; i < bottom; i += stepY) {
-    for (unsigned int j = left; j < right; j += stepX) {
-      if (vpMeTracker::inRoiMask(mask, i, j) && point_cloud[i * width + j][2] > 0 &&
-          (m_useScanLine ? (i < m_hiddenFace->getMbScanLineRenderer().getPrimitiveIDs().getHeight() &&
-                            j < m_hiddenFace->getMbScanLineRenderer().getPrimitiveIDs().getWidth() &&
-                            m_hiddenFace->getMbScanLineRenderer().getPrimitiveIDs()[i][j] == m_polygon->getIndex())
-           : polygon_2d.isInside(vpImagePoint(i, j)))) {
-// Add point
-        point_cloud_face.push_back(point_cloud[i * width + j][0]);
-        point_cloud_face.push_back(point_cloud[i * width + j][1]);
-        point_cloud_face.push_back(point_cloud[i * width + j][2]);
-
-        if (m_featureEstimationMethod == ROBUST_FEATURE_ESTIMATION) {
-          // Add point for custom method for plane equation estimation
-          vpPixelMeterConversion::convertPoint(m_cam, j, i, x, y);
-
-          if (checkSSE2) {
-#if USE_SSE
-            if (!push) {
-              push = true;
-              prev_x = x;
-              prev_y = y;
-              prev_z = point_cloud[i * width + j][2];
-            }
-            else {
-              push = false;
-              point_cloud_face_custom.push_back(prev_x);
-              point_cloud_face_custom.push_back(x);
-
-              point_cloud_face_custom.push_back(prev_y);
-              point_cloud_face_custom.push_back(y);
-
-              point_cloud_face_custom.push_back(prev_z);
-              point_cloud_face_custom.push_back(point_cloud[i * width + j][2]);
-            }
+bool vpMbtFaceDepthNormal::computeDesiredFeatures(const vpHomogeneousMatrix &cMo, unsigned int width,
+                                                  unsigned int height, const vpPointCloud &point_cloud,
+                                                  vpColVector &desired_features, unsigned int stepX, unsigned int stepY
+#if DEBUG_DISPLAY_DEPTH_NORMAL
+                                                  ,
+                                                  vpImage<unsigned char> &debugImage,
+                                                  std::vector<std::vector<vpImagePoint> > &roiPts_vec
 #endif
-          }
-          else {
-            point_cloud_face_custom.push_back(x);
-            point_cloud_face_custom.push_back(y);
-            point_cloud_face_custom.push_back(point_cloud[i * width + j][2]);
-          }
-        }
-
+                                                  ,
+                                                  const vpImage<bool> *mask)
+{
+  const vpMbtPointCloudPoints points(point_cloud, width);
+  return computeDesiredFeaturesFromPoints(cMo, width, height, points, desired_features, stepX, stepY
 #if DEBUG_DISPLAY_DEPTH_NORMAL
-        debugImage[i][j] = 255;
+                                          ,
+                                          debugImage, roiPts_vec
 #endif
-      }
-    }
-  }
+                                          ,
+                                          mask);
+}
 
-#if USE_SSE
-  if (checkSSE2 && push) {
-    point_cloud_face_custom.push_back(prev_x);
-    point_cloud_face_custom.push_back(prev_y);
-    point_cloud_face_custom.push_back(prev_z);
-  }
+/*!
+  Sample the depth image inside the projection of the face, with the steps \e stepX and \e stepY, unproject
+  the sampled pixels with the camera parameters of the face and estimate the desired plane features.
+
+  \param cMo : Pose of the object in the depth camera frame.
+  \param depth_raw : Raw depth image, of the size used to set the camera parameters.
+  \param depth_scale : Depth scale to convert the raw values in meter, for instance 0.001 for a depth in mm.
+  A null raw value means that the depth is unknown.
+  \param desired_features : Estimated features.
+  \param stepX : Sampling step along the columns.
+  \param stepY : Sampling step along the rows.
+  \param mask : If not null, only the pixels of the mask that are true are considered.
+  \return true if the features of the face could be estimated.
+*/
+bool vpMbtFaceDepthNormal::computeDesiredFeatures(const vpHomogeneousMatrix &cMo,
+                                                  const vpImage<uint16_t> &depth_raw, float depth_scale,
+                                                  vpColVector &desired_features, unsigned int stepX, unsigned int stepY
+#if DEBUG_DISPLAY_DEPTH_NORMAL
+                                                  ,
+                                                  vpImage<unsigned char> &debugImage,
+                                                  std::vector<std::vector<vpImagePoint> > &roiPts_vec
 #endif
-
-  if (point_cloud_face.empty() && point_cloud_face_custom.empty()) {
-    return false;
-  }
-
-  // Face centroid computed by the different methods
-  vpColVector centroid_point(3);
-
-#if defined(VISP_HAVE_PCL) && defined(VISP_HAVE_PCL_SEGMENTATION) && defined(VISP_HAVE_PCL_FILTERS) && defined(VISP_HAVE_PCL_COMMON)
-  if (m_featureEstimationMethod == PCL_PLANE_ESTIMATION) {
-    pcl::PointCloud<pcl::PointXYZ>::Ptr point_cloud_face_pcl(new pcl::PointCloud<pcl::PointXYZ>);
-    point_cloud_face_pcl->reserve(point_cloud_face.size() / 3);
-
-    for (size_t i = 0; i < point_cloud_face.size() / 3; i++) {
-      point_cloud_face_pcl->push_back(
-          pcl::PointXYZ(point_cloud_face[3 * i], point_cloud_face[3 * i + 1], point_cloud_face[3 * i + 2]));
-    }
-
-    computeDesiredFeaturesPCL(point_cloud_face_pcl, desired_features, desired_normal, centroid_point);
-  }
-  else
+                                                  ,
+                                                  const vpImage<bool> *mask)
+{
+  const vpMbtRawDepthPoints points(depth_raw, depth_scale, m_cam);
+  return computeDesiredFeaturesFromPoints(cMo, depth_raw.getWidth(), depth_raw.getHeight(), points, desired_features,
+                                          stepX, stepY
+#if DEBUG_DISPLAY_DEPTH_NORMAL
+                                          ,
+                                          debugImage, roiPts_vec
 #endif
-    if (m_featureEstimationMethod == ROBUST_SVD_PLANE_ESTIMATION) {
-      computeDesiredFeaturesSVD(point_cloud_face, cMo, desired_features, desired_normal, centroid_point);
-    }
-    else if (m_featureEstimationMethod == ROBUST_FEATURE_ESTIMATION) {
-      computeDesiredFeaturesRobustFeatures(point_cloud_face_custom, point_cloud_face, cMo, desired_features,
-                                           desired_normal, centroid_point);
-    }
-    else {
-      throw vpException(vpException::badValue, "Unknown feature estimation method!");
-    }
-
-  computeDesiredNormalAndCentroid(cMo, desired_normal, centroid_point);
-
-  m_faceActivated = true;
-
-  return true;
+                                          ,
+                                          mask);
 }
 #if defined(VISP_HAVE_PCL) && defined(VISP_HAVE_PCL_SEGMENTATION) && defined(VISP_HAVE_PCL_FILTERS) && defined(VISP_HAVE_PCL_COMMON)
 bool vpMbtFaceDepthNormal::computeDesiredFeaturesPCL(const pcl::PointCloud<pcl::PointXYZ>::ConstPtr &point_cloud_face,
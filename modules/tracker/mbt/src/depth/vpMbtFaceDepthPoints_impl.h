@@ -0,0 +1,152 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2024 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Access by pixel to the 3D points sampled by the depth features of a face.
+ */
+
+#ifndef VP_MBT_FACE_DEPTH_POINTS_IMPL_H
+#define VP_MBT_FACE_DEPTH_POINTS_IMPL_H
+
+#include <visp3/core/vpConfig.h>
+#include <visp3/core/vpCameraParameters.h>
+#include <visp3/core/vpColVector.h>
+#include <visp3/core/vpImage.h>
+#include <visp3/core/vpMatrix.h>
+#include <visp3/core/vpPixelMeterConversion.h>
+#include <visp3/core/vpPointCloud.h>
+
+#include <vector>
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+BEGIN_VISP_NAMESPACE
+/*
+  The sampling loops of vpMbtFaceDepthDense and vpMbtFaceDepthNormal are
+  templates on these accessors, one per point cloud representation. hasPoint()
+  tells if the pixel has a depth, getPoint() gives the 3D point of such a pixel
+  in the depth camera frame.
+*/
+
+// Organized point cloud stored as one vpColVector per pixel
+class vpMbtColVectorPoints
+{
+public:
+  vpMbtColVectorPoints(const std::vector<vpColVector> &point_cloud, unsigned int width)
+    : m_pointCloud(point_cloud), m_width(width)
+  { }
+
+  bool hasPoint(unsigned int i, unsigned int j) const { return m_pointCloud[(i * m_width) + j][2] > 0; }
+
+  void getPoint(unsigned int i, unsigned int j, double &X, double &Y, double &Z) const
+  {
+    const vpColVector &P = m_pointCloud[(i * m_width) + j];
+    X = P[0];
+    Y = P[1];
+    Z = P[2];
+  }
+
+private:
+  const std::vector<vpColVector> &m_pointCloud;
+  unsigned int m_width;
+};
+
+// Organized point cloud stored as one row of a vpMatrix per pixel
+class vpMbtMatrixPoints
+{
+public:
+  vpMbtMatrixPoints(const vpMatrix &point_cloud, unsigned int width) : m_pointCloud(point_cloud), m_width(width) { }
+
+  bool hasPoint(unsigned int i, unsigned int j) const { return m_pointCloud[(i * m_width) + j][2] > 0; }
+
+  void getPoint(unsigned int i, unsigned int j, double &X, double &Y, double &Z) const
+  {
+    const double *P = m_pointCloud[(i * m_width) + j];
+    X = P[0];
+    Y = P[1];
+    Z = P[2];
+  }
+
+private:
+  const vpMatrix &m_pointCloud;
+  unsigned int m_width;
+};
+
+// Organized point cloud stored as three float arrays
+class vpMbtPointCloudPoints
+{
+public:
+  vpMbtPointCloudPoints(const vpPointCloud &point_cloud, unsigned int width)
+    : m_X(point_cloud.getX()), m_Y(point_cloud.getY()), m_Z(point_cloud.getZ()), m_width(width)
+  { }
+
+  bool hasPoint(unsigned int i, unsigned int j) const { return m_Z[(i * m_width) + j] > 0; }
+
+  void getPoint(unsigned int i, unsigned int j, double &X, double &Y, double &Z) const
+  {
+    const unsigned int idx = (i * m_width) + j;
+    X = m_X[idx];
+    Y = m_Y[idx];
+    Z = m_Z[idx];
+  }
+
+private:
+  const float *m_X;
+  const float *m_Y;
+  const float *m_Z;
+  unsigned int m_width;
+};
+
+// Raw depth image, only the sampled pixels being unprojected
+class vpMbtRawDepthPoints
+{
+public:
+  vpMbtRawDepthPoints(const vpImage<uint16_t> &depth_raw, float depth_scale, const vpCameraParameters &cam)
+    : m_depthRaw(depth_raw), m_depthScale(depth_scale), m_cam(cam)
+  { }
+
+  bool hasPoint(unsigned int i, unsigned int j) const { return m_depthRaw[i][j] > 0; }
+
+  void getPoint(unsigned int i, unsigned int j, double &X, double &Y, double &Z) const
+  {
+    double x = 0.0, y = 0.0;
+    vpPixelMeterConversion::convertPoint(m_cam, j, i, x, y);
+    Z = m_depthScale * m_depthRaw[i][j];
+    X = x * Z;
+    Y = y * Z;
+  }
+
+private:
+  const vpImage<uint16_t> &m_depthRaw;
+  float m_depthScale;
+  const vpCameraParameters &m_cam;
+};
+END_VISP_NAMESPACE
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+#endif
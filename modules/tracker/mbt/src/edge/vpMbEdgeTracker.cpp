@@ -63,7 +63,7 @@ BEGIN_VISP_NAMESPACE
   Basic constructor
 */
 vpMbEdgeTracker::vpMbEdgeTracker()
-  : me(), lines(1), circles(1), cylinders(1), nline(0), ncircle(0), ncylinder(0), nbvisiblepolygone(0),
+  : me(), lines(1), m_linesIndex(1), circles(1), cylinders(1), nline(0), ncircle(0), ncylinder(0), nbvisiblepolygone(0),
   percentageGdPt(0.4), scales(1), Ipyramid(0), scaleLevel(0), nbFeaturesForProjErrorComputation(0), m_factor(),
   m_robustLines(), m_robustCylinders(), m_robustCircles(), m_wLines(), m_wCylinders(), m_wCircles(), m_errorLines(),
   m_errorCylinders(), m_errorCircles(), m_L_edge(), m_error_edge(), m_w_edge(), m_weightedError_edge(),
@@ -1993,11 +1993,19 @@ void vpMbEdgeTracker::addLine(vpPoint &P1, vpPoint &P2, int polygon, std::string
     // suppress line already in the model
     bool already_here = false;
     vpMbtDistanceLine *l;
+    std::vector<vpMbtDistanceLine *> candidates;
+
+    if (m_linesIndex.size() < lines.size()) {
+      m_linesIndex.resize(lines.size());
+    }
 
     for (unsigned int i = 0; i < scales.size(); i += 1) {
       if (scales[i]) {
         downScale(i);
-        for (std::list<vpMbtDistanceLine *>::const_iterator it = lines[i].begin(); it != lines[i].end(); ++it) {
+        // Only the lines whose extremities are close to P1 and P2 are compared
+        m_linesIndex[i].update(lines[i]);
+        m_linesIndex[i].find(P1, P2, candidates);
+        for (std::vector<vpMbtDistanceLine *>::const_iterator it = candidates.begin(); it != candidates.end(); ++it) {
           l = *it;
           if ((samePoint(*(l->p1), P1) && samePoint(*(l->p2), P2)) ||
               (samePoint(*(l->p1), P2) && samePoint(*(l->p2), P1))) {
@@ -2031,6 +2039,7 @@ void vpMbEdgeTracker::addLine(vpPoint &P1, vpPoint &P2, int polygon, std::string
 
           nline += 1;
           lines[i].push_back(l);
+          m_linesIndex[i].insert(l);
         }
         upScale(i);
       }
@@ -41,16 +41,88 @@
 #include <visp3/core/vpIoTools.h>
 #include <visp3/mbt/vpMbtXmlGenericParser.h>
 
+#include <exception>
+
+#ifdef VISP_HAVE_OPENMP
+#include <omp.h>
+#endif
+
 #ifdef VISP_HAVE_NLOHMANN_JSON
 #include VISP_NLOHMANN_JSON(json.hpp)
 using json = nlohmann::json; //! json namespace shortcut
 #endif
 
 BEGIN_VISP_NAMESPACE
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace
+{
+/*!
+  Call \e func(i) for each camera index i in [0, nbCameras). When \e parallel is true and OpenMP is available,
+  each camera is processed by its own thread. Since each call only modifies the state of its own tracker,
+  results are identical to the sequential execution. Exceptions are caught in the worker threads and the one
+  raised by the first camera (in camera name order) is rethrown in the calling thread.
+*/
+template <typename Func> void vpProcessCameras(size_t nbCameras, bool parallel, const Func &func)
+{
+#ifdef VISP_HAVE_OPENMP
+  if (parallel && (nbCameras > 1)) {
+    int nbThreads = static_cast<int>(nbCameras);
+    std::vector<std::exception_ptr> exceptions(nbCameras);
+#pragma omp parallel for num_threads(nbThreads) schedule(static, 1)
+    for (int i = 0; i < nbThreads; ++i) {
+      try {
+        func(static_cast<size_t>(i));
+      }
+      catch (...) {
+        exceptions[static_cast<size_t>(i)] = std::current_exception();
+      }
+    }
+
+    for (size_t i = 0; i < nbCameras; ++i) {
+      if (exceptions[i]) {
+        std::rethrow_exception(exceptions[i]);
+      }
+    }
+    return;
+  }
+#else
+  (void)parallel;
+#endif
+
+  for (size_t i = 0; i < nbCameras; ++i) {
+    func(i);
+  }
+}
+
+/*!
+  Load a model file once for several trackers. The points of a cao file are transformed by \e T when it is parsed,
+  the ones of a compiled model file when the model is added to a tracker, which is what \e odTo is set for.
+*/
+vpMbtModel vpLoadSharedModel(const std::string &modelFile, bool verbose, const vpHomogeneousMatrix &T,
+  vpHomogeneousMatrix &odTo)
+{
+  vpMbtModel model;
+  model.load(modelFile, verbose, T);
+  odTo = vpMbtModel::isCompiledModel(modelFile) ? T : vpHomogeneousMatrix();
+  return model;
+}
+
+//! Model loaded from a file with a given transformation
+struct vpSharedModel
+{
+  std::string m_modelFile;
+  vpHomogeneousMatrix m_T;
+  vpMbtModel m_model;
+  vpHomogeneousMatrix m_odTo;
+};
+} // namespace
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
 vpMbGenericTracker::vpMbGenericTracker()
   : m_error(), m_L(), m_mapOfCameraTransformationMatrix(), m_mapOfFeatureFactors(), m_mapOfTrackers(),
   m_percentageGdPt(0.4), m_referenceCameraName("Camera"), m_thresholdOutlier(0.5), m_w(), m_weightedError(),
-  m_nb_feat_edge(0), m_nb_feat_klt(0), m_nb_feat_depthNormal(0), m_nb_feat_depthDense(0)
+  m_nb_feat_edge(0), m_nb_feat_klt(0), m_nb_feat_depthNormal(0), m_nb_feat_depthDense(0),
+  m_parallelCameraTracking(false)
 {
   m_mapOfTrackers["Camera"] = new TrackerWrapper(EDGE_TRACKER);
 
@@ -71,7 +143,8 @@ vpMbGenericTracker::vpMbGenericTracker()
 vpMbGenericTracker::vpMbGenericTracker(unsigned int nbCameras, int trackerType)
   : m_error(), m_L(), m_mapOfCameraTransformationMatrix(), m_mapOfFeatureFactors(), m_mapOfTrackers(),
   m_percentageGdPt(0.4), m_referenceCameraName("Camera"), m_thresholdOutlier(0.5), m_w(), m_weightedError(),
-  m_nb_feat_edge(0), m_nb_feat_klt(0), m_nb_feat_depthNormal(0), m_nb_feat_depthDense(0)
+  m_nb_feat_edge(0), m_nb_feat_klt(0), m_nb_feat_depthNormal(0), m_nb_feat_depthDense(0),
+  m_parallelCameraTracking(false)
 {
   if (nbCameras == 0) {
     throw vpException(vpTrackingException::fatalError, "Cannot use no camera!");
@@ -110,7 +183,8 @@ vpMbGenericTracker::vpMbGenericTracker(unsigned int nbCameras, int trackerType)
 vpMbGenericTracker::vpMbGenericTracker(const std::vector<int> &trackerTypes)
   : m_error(), m_L(), m_mapOfCameraTransformationMatrix(), m_mapOfFeatureFactors(), m_mapOfTrackers(),
   m_percentageGdPt(0.4), m_referenceCameraName("Camera"), m_thresholdOutlier(0.5), m_w(), m_weightedError(),
-  m_nb_feat_edge(0), m_nb_feat_klt(0), m_nb_feat_depthNormal(0), m_nb_feat_depthDense(0)
+  m_nb_feat_edge(0), m_nb_feat_klt(0), m_nb_feat_depthNormal(0), m_nb_feat_depthDense(0),
+  m_parallelCameraTracking(false)
 {
   if (trackerTypes.empty()) {
     throw vpException(vpException::badValue, "There is no camera!");
@@ -151,7 +225,8 @@ vpMbGenericTracker::vpMbGenericTracker(const std::vector<std::string> &cameraNam
   const std::vector<int> &trackerTypes)
   : m_error(), m_L(), m_mapOfCameraTransformationMatrix(), m_mapOfFeatureFactors(), m_mapOfTrackers(),
   m_percentageGdPt(0.4), m_referenceCameraName("Camera"), m_thresholdOutlier(0.5), m_w(), m_weightedError(),
-  m_nb_feat_edge(0), m_nb_feat_klt(0), m_nb_feat_depthNormal(0), m_nb_feat_depthDense(0)
+  m_nb_feat_edge(0), m_nb_feat_klt(0), m_nb_feat_depthNormal(0), m_nb_feat_depthDense(0),
+  m_parallelCameraTracking(false)
 {
   if (cameraNames.size() != trackerTypes.size() || cameraNames.empty()) {
     throw vpException(vpTrackingException::badValue,
@@ -543,14 +618,20 @@ void vpMbGenericTracker::computeVVSInit()
 
 void vpMbGenericTracker::computeVVSInit(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages)
 {
-  unsigned int nbFeatures = 0;
-
+  std::vector<TrackerWrapper *> trackers;
+  std::vector<const vpImage<unsigned char> *> images;
   for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
     it != m_mapOfTrackers.end(); ++it) {
-    TrackerWrapper *tracker = it->second;
-    tracker->computeVVSInit(mapOfImages[it->first]);
+    trackers.push_back(it->second);
+    images.push_back(mapOfImages[it->first]);
+  }
 
-    nbFeatures += tracker->m_error.getRows();
+  vpProcessCameras(trackers.size(), m_parallelCameraTracking,
+                   [&](size_t i) { trackers[i]->computeVVSInit(images[i]); });
+
+  unsigned int nbFeatures = 0;
+  for (size_t i = 0; i < trackers.size(); ++i) {
+    nbFeatures += trackers[i]->m_error.getRows();
   }
 
   m_L.resize(nbFeatures, 6, false, false);
@@ -572,39 +653,57 @@ void vpMbGenericTracker::computeVVSInteractionMatrixAndResidu(
   std::map<std::string, const vpImage<unsigned char> *> &mapOfImages,
   std::map<std::string, vpVelocityTwistMatrix> &mapOfVelocityTwist)
 {
-  unsigned int start_index = 0;
-
+  std::vector<TrackerWrapper *> trackers;
+  std::vector<const vpImage<unsigned char> *> images;
+  std::vector<vpHomogeneousMatrix> cameraTransformations;
+  std::vector<vpVelocityTwistMatrix> velocityTwists;
   for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
     it != m_mapOfTrackers.end(); ++it) {
-    TrackerWrapper *tracker = it->second;
+    trackers.push_back(it->second);
+    images.push_back(mapOfImages[it->first]);
+    cameraTransformations.push_back(m_mapOfCameraTransformationMatrix[it->first]);
+    velocityTwists.push_back(mapOfVelocityTwist[it->first]);
+  }
 
-    tracker->m_cMo = m_mapOfCameraTransformationMatrix[it->first] * m_cMo;
+  // Per-camera Jacobians and residuals are independent, only their stacking below must be sequential
+  std::vector<vpMatrix> LVs(trackers.size());
+  vpProcessCameras(trackers.size(), m_parallelCameraTracking, [&](size_t i) {
+    TrackerWrapper *tracker = trackers[i];
+
+    tracker->m_cMo = cameraTransformations[i] * m_cMo;
 #if defined(VISP_HAVE_MODULE_KLT) && defined(VISP_HAVE_OPENCV) && defined(HAVE_OPENCV_IMGPROC) && defined(HAVE_OPENCV_VIDEO)
-    vpHomogeneousMatrix c_curr_tTc_curr0 =
-      m_mapOfCameraTransformationMatrix[it->first] * m_cMo * tracker->c0Mo.inverse();
+    vpHomogeneousMatrix c_curr_tTc_curr0 = cameraTransformations[i] * m_cMo * tracker->c0Mo.inverse();
     tracker->ctTc0 = c_curr_tTc_curr0;
 #endif
 
-    tracker->computeVVSInteractionMatrixAndResidu(mapOfImages[it->first]);
+    tracker->computeVVSInteractionMatrixAndResidu(images[i]);
 
-    m_L.insert(tracker->m_L * mapOfVelocityTwist[it->first], start_index, 0);
-    m_error.insert(start_index, tracker->m_error);
+    LVs[i] = tracker->m_L * velocityTwists[i];
+  });
+
+  unsigned int start_index = 0;
+  for (size_t i = 0; i < trackers.size(); ++i) {
+    m_L.insert(LVs[i], start_index, 0);
+    m_error.insert(start_index, trackers[i]->m_error);
 
-    start_index += tracker->m_error.getRows();
+    start_index += trackers[i]->m_error.getRows();
   }
 }
 
 void vpMbGenericTracker::computeVVSWeights()
 {
-  unsigned int start_index = 0;
-
+  std::vector<TrackerWrapper *> trackers;
   for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
     it != m_mapOfTrackers.end(); ++it) {
-    TrackerWrapper *tracker = it->second;
-    tracker->computeVVSWeights();
+    trackers.push_back(it->second);
+  }
+
+  vpProcessCameras(trackers.size(), m_parallelCameraTracking, [&](size_t i) { trackers[i]->computeVVSWeights(); });
 
-    m_w.insert(start_index, tracker->m_w);
-    start_index += tracker->m_w.getRows();
+  unsigned int start_index = 0;
+  for (size_t i = 0; i < trackers.size(); ++i) {
+    m_w.insert(start_index, trackers[i]->m_w);
+    start_index += trackers[i]->m_w.getRows();
   }
 }
 
@@ -952,6 +1051,23 @@ vpMbHiddenFaces<vpMbtPolygon> &vpMbGenericTracker::getFaces(const std::string &c
   return faces;
 }
 
+/*!
+  Get the model the primitives of the reference camera tracker were built
+  from. The trackers that loaded the same model share its buffer.
+
+  \return The model.
+*/
+const vpMbtModel &vpMbGenericTracker::getModel() const
+{
+  std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.find(m_referenceCameraName);
+  if (it != m_mapOfTrackers.end()) {
+    return it->second->getModel();
+  }
+
+  std::cerr << "The reference camera: " << m_referenceCameraName << " cannot be found!" << std::endl;
+  return m_model;
+}
+
 #if defined(VISP_HAVE_MODULE_KLT) && defined(VISP_HAVE_OPENCV) && defined(HAVE_OPENCV_IMGPROC) && defined(HAVE_OPENCV_VIDEO)
 /*!
   Return the address of the circle feature list for the reference camera.
@@ -3162,8 +3278,8 @@ void vpMbGenericTracker::loadConfigFile(const std::map<std::string, std::string>
 
 /*!
   Load a 3D model from the file in parameter. This file must either be a vrml
-  file (.wrl) or a CAO file (.cao). CAO format is described in the
-  loadCAOModel() method.
+  file (.wrl), a CAO file (.cao) or a compiled model file written by
+  vpMbtModel::compile(). CAO format is described in the loadCAOModel() method.
 
   \throw vpException::ioError if the file cannot be open, or if its extension
 is not wrl or cao.
@@ -3176,21 +3292,25 @@ CAO model files which include other CAO model files.
   3D points expressed in the original object frame to the desired object frame.
 
   \note All the trackers will use the same model in case of stereo / multiple
-cameras configuration.
+cameras configuration. The file is parsed once and the trackers share the
+resulting vpMbtModel, see loadModel(const vpMbtModel &, const vpHomogeneousMatrix &).
 */
 void vpMbGenericTracker::loadModel(const std::string &modelFile, bool verbose, const vpHomogeneousMatrix &T)
 {
+  vpHomogeneousMatrix odTo;
+  vpMbtModel model = vpLoadSharedModel(modelFile, verbose, T, odTo);
+
   for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
     it != m_mapOfTrackers.end(); ++it) {
     TrackerWrapper *tracker = it->second;
-    tracker->loadModel(modelFile, verbose, T);
+    tracker->loadSharedModel(model, modelFile, odTo);
   }
 }
 
 /*!
   Load a 3D model from the file in parameter. This file must either be a vrml
-  file (.wrl) or a CAO file (.cao). CAO format is described in the
-  loadCAOModel() method.
+  file (.wrl), a CAO file (.cao) or a compiled model file written by
+  vpMbtModel::compile(). CAO format is described in the loadCAOModel() method.
 
   \throw vpException::ioError if the file cannot be open, or if its extension
   is not wrl or cao.
@@ -3208,6 +3328,8 @@ void vpMbGenericTracker::loadModel(const std::string &modelFile, bool verbose, c
   T2==T1 if the two models have the same object frame which should be the case most of the time).
 
   \note This function assumes a stereo configuration of the generic tracker.
+  When both cameras use the same file and transformation, the file is parsed
+  once and the two trackers share the model.
 */
 void vpMbGenericTracker::loadModel(const std::string &modelFile1, const std::string &modelFile2, bool verbose,
   const vpHomogeneousMatrix &T1, const vpHomogeneousMatrix &T2)
@@ -3216,19 +3338,29 @@ void vpMbGenericTracker::loadModel(const std::string &modelFile1, const std::str
     throw vpException(vpException::fatalError, "The tracker is not set in a stereo configuration!");
   }
 
+  vpHomogeneousMatrix odTo1;
+  vpMbtModel model1 = vpLoadSharedModel(modelFile1, verbose, T1, odTo1);
+
   std::map<std::string, TrackerWrapper *>::const_iterator it_tracker = m_mapOfTrackers.begin();
   TrackerWrapper *tracker = it_tracker->second;
-  tracker->loadModel(modelFile1, verbose, T1);
+  tracker->loadSharedModel(model1, modelFile1, odTo1);
 
   ++it_tracker;
   tracker = it_tracker->second;
-  tracker->loadModel(modelFile2, verbose, T2);
+  if ((modelFile2 == modelFile1) && (T2 == T1)) {
+    tracker->loadSharedModel(model1, modelFile2, odTo1);
+  }
+  else {
+    vpHomogeneousMatrix odTo2;
+    vpMbtModel model2 = vpLoadSharedModel(modelFile2, verbose, T2, odTo2);
+    tracker->loadSharedModel(model2, modelFile2, odTo2);
+  }
 }
 
 /*!
   Load a 3D model from the file in parameter. This file must either be a vrml
-  file (.wrl) or a CAO file (.cao). CAO format is described in the
-  loadCAOModel() method.
+  file (.wrl), a CAO file (.cao) or a compiled model file written by
+  vpMbtModel::compile(). CAO format is described in the loadCAOModel() method.
 
   \throw vpException::ioError if the file cannot be open, or if its extension
   is not wrl or cao.
@@ -3242,11 +3374,15 @@ void vpMbGenericTracker::loadModel(const std::string &modelFile1, const std::str
   the desired object frame (if the models have the same object frame which should be the
   case most of the time, all the transformation matrices are identical).
 
-  \note Each camera must have a model file.
+  \note Each camera must have a model file. Each distinct pair of model file
+  and transformation is parsed once, and the trackers that use it share the
+  model.
 */
 void vpMbGenericTracker::loadModel(const std::map<std::string, std::string> &mapOfModelFiles, bool verbose,
   const std::map<std::string, vpHomogeneousMatrix> &mapOfT)
 {
+  std::vector<vpSharedModel> sharedModels;
+
   for (std::map<std::string, TrackerWrapper *>::const_iterator it_tracker = m_mapOfTrackers.begin();
     it_tracker != m_mapOfTrackers.end(); ++it_tracker) {
     std::map<std::string, std::string>::const_iterator it_model = mapOfModelFiles.find(it_tracker->first);
@@ -3254,11 +3390,22 @@ void vpMbGenericTracker::loadModel(const std::map<std::string, std::string> &map
     if (it_model != mapOfModelFiles.end()) {
       TrackerWrapper *tracker = it_tracker->second;
       std::map<std::string, vpHomogeneousMatrix>::const_iterator it_T = mapOfT.find(it_tracker->first);
+      const vpHomogeneousMatrix T = (it_T != mapOfT.end()) ? it_T->second : vpHomogeneousMatrix();
 
-      if (it_T != mapOfT.end())
-        tracker->loadModel(it_model->second, verbose, it_T->second);
-      else
-        tracker->loadModel(it_model->second, verbose);
+      size_t i = 0;
+      while ((i < sharedModels.size()) &&
+        !((sharedModels[i].m_modelFile == it_model->second) && (sharedModels[i].m_T == T))) {
+        ++i;
+      }
+      if (i == sharedModels.size()) {
+        vpSharedModel sharedModel;
+        sharedModel.m_modelFile = it_model->second;
+        sharedModel.m_T = T;
+        sharedModel.m_model = vpLoadSharedModel(it_model->second, verbose, T, sharedModel.m_odTo);
+        sharedModels.push_back(sharedModel);
+      }
+
+      tracker->loadSharedModel(sharedModels[i].m_model, sharedModels[i].m_modelFile, sharedModels[i].m_odTo);
     }
     else {
       throw vpException(vpTrackingException::initializationError, "Cannot load model for camera: %s",
@@ -3267,15 +3414,40 @@ void vpMbGenericTracker::loadModel(const std::map<std::string, std::string> &map
   }
 }
 
+/*!
+  Load in all the trackers a 3D model that has already been loaded or
+  compiled, see vpMbtModel. The trackers share the buffer of the model, while
+  the faces and the features built from it are created for each tracker.
+
+  \param model : The model.
+  \param T : optional transformation matrix to transform 3D points expressed
+  in the frame of the model to the desired object frame.
+*/
+void vpMbGenericTracker::loadModel(const vpMbtModel &model, const vpHomogeneousMatrix &T)
+{
+  for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
+    it != m_mapOfTrackers.end(); ++it) {
+    TrackerWrapper *tracker = it->second;
+    tracker->loadModel(model, T);
+  }
+}
+
 #if defined(VISP_HAVE_PCL) && defined(VISP_HAVE_PCL_COMMON)
 void vpMbGenericTracker::preTracking(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages,
   std::map<std::string, pcl::PointCloud<pcl::PointXYZ>::ConstPtr> &mapOfPointClouds)
 {
+  std::vector<TrackerWrapper *> trackers;
+  std::vector<const vpImage<unsigned char> *> images;
+  std::vector<pcl::PointCloud<pcl::PointXYZ>::ConstPtr> pointClouds;
   for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
     it != m_mapOfTrackers.end(); ++it) {
-    TrackerWrapper *tracker = it->second;
-    tracker->preTracking(mapOfImages[it->first], mapOfPointClouds[it->first]);
+    trackers.push_back(it->second);
+    images.push_back(mapOfImages[it->first]);
+    pointClouds.push_back(mapOfPointClouds[it->first]);
   }
+
+  vpProcessCameras(trackers.size(), m_parallelCameraTracking,
+                   [&](size_t i) { trackers[i]->preTracking(images[i], pointClouds[i]); });
 }
 #endif
 
@@ -3284,12 +3456,21 @@ void vpMbGenericTracker::preTracking(std::map<std::string, const vpImage<unsigne
   std::map<std::string, unsigned int> &mapOfPointCloudWidths,
   std::map<std::string, unsigned int> &mapOfPointCloudHeights)
 {
+  std::vector<TrackerWrapper *> trackers;
+  std::vector<const vpImage<unsigned char> *> images;
+  std::vector<const std::vector<vpColVector> *> pointClouds;
+  std::vector<unsigned int> widths, heights;
   for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
     it != m_mapOfTrackers.end(); ++it) {
-    TrackerWrapper *tracker = it->second;
-    tracker->preTracking(mapOfImages[it->first], mapOfPointClouds[it->first], mapOfPointCloudWidths[it->first],
-      mapOfPointCloudHeights[it->first]);
+    trackers.push_back(it->second);
+    images.push_back(mapOfImages[it->first]);
+    pointClouds.push_back(mapOfPointClouds[it->first]);
+    widths.push_back(mapOfPointCloudWidths[it->first]);
+    heights.push_back(mapOfPointCloudHeights[it->first]);
   }
+
+  vpProcessCameras(trackers.size(), m_parallelCameraTracking,
+                   [&](size_t i) { trackers[i]->preTracking(images[i], pointClouds[i], widths[i], heights[i]); });
 }
 
 void vpMbGenericTracker::preTracking(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages,
@@ -3297,12 +3478,137 @@ void vpMbGenericTracker::preTracking(std::map<std::string, const vpImage<unsigne
   std::map<std::string, unsigned int> &mapOfPointCloudWidths,
   std::map<std::string, unsigned int> &mapOfPointCloudHeights)
 {
+  std::vector<TrackerWrapper *> trackers;
+  std::vector<const vpImage<unsigned char> *> images;
+  std::vector<const vpMatrix *> pointClouds;
+  std::vector<unsigned int> widths, heights;
   for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
     it != m_mapOfTrackers.end(); ++it) {
-    TrackerWrapper *tracker = it->second;
-    tracker->preTracking(mapOfImages[it->first], mapOfPointClouds[it->first], mapOfPointCloudWidths[it->first],
-      mapOfPointCloudHeights[it->first]);
+    trackers.push_back(it->second);
+    images.push_back(mapOfImages[it->first]);
+    pointClouds.push_back(mapOfPointClouds[it->first]);
+    widths.push_back(mapOfPointCloudWidths[it->first]);
+    heights.push_back(mapOfPointCloudHeights[it->first]);
+  }
+
+  vpProcessCameras(trackers.size(), m_parallelCameraTracking,
+                   [&](size_t i) { trackers[i]->preTracking(images[i], pointClouds[i], widths[i], heights[i]); });
+}
+
+/*!
+  Run the tracking stages before the pose estimation of each camera, \e trackerPreTracking being called with the
+  tracker, the image and the depth data of the camera.
+*/
+template <class DepthData, class TrackerPreTracking>
+void vpMbGenericTracker::preTrackingDepth(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages,
+  std::map<std::string, const DepthData *> &mapOfDepthData, const TrackerPreTracking &trackerPreTracking)
+{
+  std::vector<TrackerWrapper *> trackers;
+  std::vector<const vpImage<unsigned char> *> images;
+  std::vector<const DepthData *> depthData;
+  for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
+    it != m_mapOfTrackers.end(); ++it) {
+    trackers.push_back(it->second);
+    images.push_back(mapOfImages[it->first]);
+    depthData.push_back(mapOfDepthData[it->first]);
+  }
+
+  vpProcessCameras(trackers.size(), m_parallelCameraTracking,
+                   [&](size_t i) { trackerPreTracking(trackers[i], images[i], depthData[i]); });
+}
+
+void vpMbGenericTracker::preTracking(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages,
+  std::map<std::string, const vpPointCloud *> &mapOfPointClouds)
+{
+  preTrackingDepth(mapOfImages, mapOfPointClouds,
+    [](TrackerWrapper *tracker, const vpImage<unsigned char> *I, const vpPointCloud *point_cloud) {
+      tracker->preTracking(I, point_cloud);
+    });
+}
+
+void vpMbGenericTracker::preTracking(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages,
+  std::map<std::string, const vpImage<uint16_t> *> &mapOfDepthImages, float depth_scale)
+{
+  preTrackingDepth(mapOfImages, mapOfDepthImages,
+    [depth_scale](TrackerWrapper *tracker, const vpImage<unsigned char> *I, const vpImage<uint16_t> *depth_raw) {
+      tracker->preTracking(I, depth_raw, depth_scale);
+    });
+}
+
+#if defined(VISP_HAVE_PCL) && defined(VISP_HAVE_PCL_COMMON)
+void vpMbGenericTracker::postTracking(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages,
+  std::map<std::string, pcl::PointCloud<pcl::PointXYZ>::ConstPtr> &mapOfPointClouds)
+{
+  std::vector<TrackerWrapper *> trackers;
+  std::vector<const vpImage<unsigned char> *> images;
+  std::vector<pcl::PointCloud<pcl::PointXYZ>::ConstPtr> pointClouds;
+  for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
+    it != m_mapOfTrackers.end(); ++it) {
+    trackers.push_back(it->second);
+    images.push_back(mapOfImages[it->first]);
+    pointClouds.push_back(mapOfPointClouds[it->first]);
+  }
+
+  vpProcessCameras(trackers.size(), m_parallelCameraTracking, [&](size_t i) {
+    TrackerWrapper *tracker = trackers[i];
+
+    if (tracker->m_trackerType & EDGE_TRACKER && displayFeatures) {
+      tracker->m_featuresToBeDisplayedEdge = tracker->getFeaturesForDisplayEdge();
+    }
+
+    tracker->postTracking(images[i], pointClouds[i]);
+
+    if (displayFeatures) {
+#if defined(VISP_HAVE_MODULE_KLT) && defined(VISP_HAVE_OPENCV) && defined(HAVE_OPENCV_IMGPROC) && defined(HAVE_OPENCV_VIDEO)
+      if (tracker->m_trackerType & KLT_TRACKER) {
+        tracker->m_featuresToBeDisplayedKlt = tracker->getFeaturesForDisplayKlt();
+      }
+#endif
+
+      if (tracker->m_trackerType & DEPTH_NORMAL_TRACKER) {
+        tracker->m_featuresToBeDisplayedDepthNormal = tracker->getFeaturesForDisplayDepthNormal();
+      }
+    }
+  });
+}
+#endif
+
+void vpMbGenericTracker::postTracking(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages,
+  std::map<std::string, unsigned int> &mapOfPointCloudWidths,
+  std::map<std::string, unsigned int> &mapOfPointCloudHeights)
+{
+  std::vector<TrackerWrapper *> trackers;
+  std::vector<const vpImage<unsigned char> *> images;
+  std::vector<unsigned int> widths, heights;
+  for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
+    it != m_mapOfTrackers.end(); ++it) {
+    trackers.push_back(it->second);
+    images.push_back(mapOfImages[it->first]);
+    widths.push_back(mapOfPointCloudWidths[it->first]);
+    heights.push_back(mapOfPointCloudHeights[it->first]);
   }
+
+  vpProcessCameras(trackers.size(), m_parallelCameraTracking, [&](size_t i) {
+    TrackerWrapper *tracker = trackers[i];
+
+    if (tracker->m_trackerType & EDGE_TRACKER && displayFeatures) {
+      tracker->m_featuresToBeDisplayedEdge = tracker->getFeaturesForDisplayEdge();
+    }
+
+    tracker->postTracking(images[i], widths[i], heights[i]);
+
+    if (displayFeatures) {
+#if defined(VISP_HAVE_MODULE_KLT) && defined(VISP_HAVE_OPENCV) && defined(HAVE_OPENCV_IMGPROC) && defined(HAVE_OPENCV_VIDEO)
+      if (tracker->m_trackerType & KLT_TRACKER) {
+        tracker->m_featuresToBeDisplayedKlt = tracker->getFeaturesForDisplayKlt();
+      }
+#endif
+
+      if (tracker->m_trackerType & DEPTH_NORMAL_TRACKER) {
+        tracker->m_featuresToBeDisplayedDepthNormal = tracker->getFeaturesForDisplayDepthNormal();
+      }
+    }
+  });
 }
 
 /*!
@@ -4323,6 +4629,24 @@ void vpMbGenericTracker::setFeatureFactors(const std::map<vpTrackerType, double>
   }
 }
 
+/*!
+  Enable/Disable the view frustum culling of the faces.
+
+  \param v : True to cull the faces outside the view frustum.
+
+  \note This function will set the new parameter for all the cameras.
+*/
+void vpMbGenericTracker::setFrustumCullingVisibilityTest(const bool &v)
+{
+  vpMbTracker::setFrustumCullingVisibilityTest(v);
+
+  for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
+    it != m_mapOfTrackers.end(); ++it) {
+    TrackerWrapper *tracker = it->second;
+    tracker->setFrustumCullingVisibilityTest(v);
+  }
+}
+
 /*!
    Set the threshold value between 0 and 1 over good moving edges ratio. It
   allows to decide if the tracker has enough valid moving edges to compute a
@@ -4349,7 +4673,6 @@ void vpMbGenericTracker::setGoodMovingEdgesRatioThreshold(double threshold)
   }
 }
 
-#ifdef VISP_HAVE_OGRE
 /*!
   Set the ratio of visibility attempts that has to be successful to consider a
   polygon as visible.
@@ -4389,7 +4712,6 @@ void vpMbGenericTracker::setNbRayCastingAttemptsForVisibility(const unsigned int
     tracker->setNbRayCastingAttemptsForVisibility(attempts);
   }
 }
-#endif
 
 #if defined(VISP_HAVE_MODULE_KLT) && defined(VISP_HAVE_OPENCV) && defined(HAVE_OPENCV_IMGPROC) && defined(HAVE_OPENCV_VIDEO)
 /*!
@@ -4802,6 +5124,23 @@ void vpMbGenericTracker::setOptimizationMethod(const vpMbtOptimizationMethod &op
   }
 }
 
+/*!
+  Enable or disable the concurrent processing of the cameras.
+
+  When enabled and ViSP is built with OpenMP, the per-camera stages of track() run in parallel, one thread per
+  camera: moving-edge, KLT and depth feature extraction, the computation of the per-camera interaction matrices,
+  residuals and robust weights at each virtual visual servoing iteration, and the visibility update performed after
+  the pose estimation. The stacking of the per-camera features and the pose update remain sequential and follow the
+  camera name order, so that the estimated pose is identical to the one obtained without multithreading.
+
+  Without OpenMP this setting has no effect.
+
+  \param parallel : If true, process the cameras concurrently.
+
+  \sa getParallelCameraTracking()
+*/
+void vpMbGenericTracker::setParallelCameraTracking(bool parallel) { m_parallelCameraTracking = parallel; }
+
 /*!
   Set the pose to be used in entry (as guess) of the next call to the track()
   function. This pose will be just used once.
@@ -5166,6 +5505,24 @@ void vpMbGenericTracker::setReferenceCameraName(const std::string &referenceCame
   }
 }
 
+/*!
+  Enable/Disable the ray casting visibility test without Ogre3D.
+
+  \param v : True to use the ray casting visibility test.
+
+  \note This function will set the new parameter for all the cameras.
+*/
+void vpMbGenericTracker::setRayCastingVisibilityTest(const bool &v)
+{
+  vpMbTracker::setRayCastingVisibilityTest(v);
+
+  for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
+    it != m_mapOfTrackers.end(); ++it) {
+    TrackerWrapper *tracker = it->second;
+    tracker->setRayCastingVisibilityTest(v);
+  }
+}
+
 void vpMbGenericTracker::setScanLineVisibilityTest(const bool &v)
 {
   vpMbTracker::setScanLineVisibilityTest(v);
@@ -5501,28 +5858,7 @@ void vpMbGenericTracker::track(std::map<std::string, const vpImage<unsigned char
 
   testTracking();
 
-  for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
-    it != m_mapOfTrackers.end(); ++it) {
-    TrackerWrapper *tracker = it->second;
-
-    if (tracker->m_trackerType & EDGE_TRACKER && displayFeatures) {
-      tracker->m_featuresToBeDisplayedEdge = tracker->getFeaturesForDisplayEdge();
-    }
-
-    tracker->postTracking(mapOfImages[it->first], mapOfPointClouds[it->first]);
-
-    if (displayFeatures) {
-#if defined(VISP_HAVE_MODULE_KLT) && defined(VISP_HAVE_OPENCV) && defined(HAVE_OPENCV_IMGPROC) && defined(HAVE_OPENCV_VIDEO)
-      if (tracker->m_trackerType & KLT_TRACKER) {
-        tracker->m_featuresToBeDisplayedKlt = tracker->getFeaturesForDisplayKlt();
-      }
-#endif
-
-      if (tracker->m_trackerType & DEPTH_NORMAL_TRACKER) {
-        tracker->m_featuresToBeDisplayedDepthNormal = tracker->getFeaturesForDisplayDepthNormal();
-      }
-    }
-  }
+  postTracking(mapOfImages, mapOfPointClouds);
 
   computeProjectionError();
 }
@@ -5587,28 +5923,7 @@ void vpMbGenericTracker::track(std::map<std::string, const vpImage<vpRGBa> *> &m
 
   testTracking();
 
-  for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
-    it != m_mapOfTrackers.end(); ++it) {
-    TrackerWrapper *tracker = it->second;
-
-    if (tracker->m_trackerType & EDGE_TRACKER && displayFeatures) {
-      tracker->m_featuresToBeDisplayedEdge = tracker->getFeaturesForDisplayEdge();
-    }
-
-    tracker->postTracking(mapOfImages[it->first], mapOfPointClouds[it->first]);
-
-    if (displayFeatures) {
-#if defined(VISP_HAVE_MODULE_KLT) && defined(VISP_HAVE_OPENCV) && defined(HAVE_OPENCV_IMGPROC) && defined(HAVE_OPENCV_VIDEO)
-      if (tracker->m_trackerType & KLT_TRACKER) {
-        tracker->m_featuresToBeDisplayedKlt = tracker->getFeaturesForDisplayKlt();
-      }
-#endif
-
-      if (tracker->m_trackerType & DEPTH_NORMAL_TRACKER) {
-        tracker->m_featuresToBeDisplayedDepthNormal = tracker->getFeaturesForDisplayDepthNormal();
-      }
-    }
-  }
+  postTracking(mapOfImages, mapOfPointClouds);
 
   computeProjectionError();
 }
@@ -5668,28 +5983,7 @@ void vpMbGenericTracker::track(std::map<std::string, const vpImage<unsigned char
 
   testTracking();
 
-  for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
-    it != m_mapOfTrackers.end(); ++it) {
-    TrackerWrapper *tracker = it->second;
-
-    if (tracker->m_trackerType & EDGE_TRACKER && displayFeatures) {
-      tracker->m_featuresToBeDisplayedEdge = tracker->getFeaturesForDisplayEdge();
-    }
-
-    tracker->postTracking(mapOfImages[it->first], mapOfPointCloudWidths[it->first], mapOfPointCloudHeights[it->first]);
-
-    if (displayFeatures) {
-#if defined(VISP_HAVE_MODULE_KLT) && defined(VISP_HAVE_OPENCV) && defined(HAVE_OPENCV_IMGPROC) && defined(HAVE_OPENCV_VIDEO)
-      if (tracker->m_trackerType & KLT_TRACKER) {
-        tracker->m_featuresToBeDisplayedKlt = tracker->getFeaturesForDisplayKlt();
-      }
-#endif
-
-      if (tracker->m_trackerType & DEPTH_NORMAL_TRACKER) {
-        tracker->m_featuresToBeDisplayedDepthNormal = tracker->getFeaturesForDisplayDepthNormal();
-      }
-    }
-  }
+  postTracking(mapOfImages, mapOfPointCloudWidths, mapOfPointCloudHeights);
 
   computeProjectionError();
 }
@@ -5758,28 +6052,7 @@ void vpMbGenericTracker::track(std::map<std::string, const vpImage<vpRGBa> *> &m
 
   testTracking();
 
-  for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
-    it != m_mapOfTrackers.end(); ++it) {
-    TrackerWrapper *tracker = it->second;
-
-    if (tracker->m_trackerType & EDGE_TRACKER && displayFeatures) {
-      tracker->m_featuresToBeDisplayedEdge = tracker->getFeaturesForDisplayEdge();
-    }
-
-    tracker->postTracking(mapOfImages[it->first], mapOfPointCloudWidths[it->first], mapOfPointCloudHeights[it->first]);
-
-    if (displayFeatures) {
-#if defined(VISP_HAVE_MODULE_KLT) && defined(VISP_HAVE_OPENCV) && defined(HAVE_OPENCV_IMGPROC) && defined(HAVE_OPENCV_VIDEO)
-      if (tracker->m_trackerType & KLT_TRACKER) {
-        tracker->m_featuresToBeDisplayedKlt = tracker->getFeaturesForDisplayKlt();
-      }
-#endif
-
-      if (tracker->m_trackerType & DEPTH_NORMAL_TRACKER) {
-        tracker->m_featuresToBeDisplayedDepthNormal = tracker->getFeaturesForDisplayDepthNormal();
-      }
-    }
-  }
+  postTracking(mapOfImages, mapOfPointCloudWidths, mapOfPointCloudHeights);
 
   computeProjectionError();
 }
@@ -5828,28 +6101,7 @@ void vpMbGenericTracker::track(std::map<std::string, const vpImage<unsigned char
 
   testTracking();
 
-  for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
-    it != m_mapOfTrackers.end(); ++it) {
-    TrackerWrapper *tracker = it->second;
-
-    if (tracker->m_trackerType & EDGE_TRACKER && displayFeatures) {
-      tracker->m_featuresToBeDisplayedEdge = tracker->getFeaturesForDisplayEdge();
-    }
-
-    tracker->postTracking(mapOfImages[it->first], mapOfPointCloudWidths[it->first], mapOfPointCloudHeights[it->first]);
-
-    if (displayFeatures) {
-#if defined(VISP_HAVE_MODULE_KLT) && defined(VISP_HAVE_OPENCV) && defined(HAVE_OPENCV_IMGPROC) && defined(HAVE_OPENCV_VIDEO)
-      if (tracker->m_trackerType & KLT_TRACKER) {
-        tracker->m_featuresToBeDisplayedKlt = tracker->getFeaturesForDisplayKlt();
-      }
-#endif
-
-      if (tracker->m_trackerType & DEPTH_NORMAL_TRACKER) {
-        tracker->m_featuresToBeDisplayedDepthNormal = tracker->getFeaturesForDisplayDepthNormal();
-      }
-    }
-  }
+  postTracking(mapOfImages, mapOfPointCloudWidths, mapOfPointCloudHeights);
 
   computeProjectionError();
 }
@@ -5918,32 +6170,163 @@ void vpMbGenericTracker::track(std::map<std::string, const vpImage<vpRGBa> *> &m
 
   testTracking();
 
+  postTracking(mapOfImages, mapOfPointCloudWidths, mapOfPointCloudHeights);
+
+  computeProjectionError();
+}
+
+/*!
+  Realize the tracking of the object in the images and in the depth data, organized point clouds or depth images
+  whose size is given by getWidth() and getHeight(). \e preTrackingCameras runs the tracking stages before the pose
+  estimation.
+*/
+template <class DepthData, class PreTracking>
+void vpMbGenericTracker::trackDepth(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages,
+  std::map<std::string, const DepthData *> &mapOfDepthData, const PreTracking &preTrackingCameras)
+{
+  std::map<std::string, unsigned int> mapOfPointCloudWidths, mapOfPointCloudHeights;
   for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
     it != m_mapOfTrackers.end(); ++it) {
     TrackerWrapper *tracker = it->second;
 
-    if (tracker->m_trackerType & EDGE_TRACKER && displayFeatures) {
-      tracker->m_featuresToBeDisplayedEdge = tracker->getFeaturesForDisplayEdge();
+    if ((tracker->m_trackerType & (EDGE_TRACKER |
+#if defined(VISP_HAVE_MODULE_KLT) && defined(VISP_HAVE_OPENCV) && defined(HAVE_OPENCV_IMGPROC) && defined(HAVE_OPENCV_VIDEO)
+                                   KLT_TRACKER |
+#endif
+                                   DEPTH_NORMAL_TRACKER | DEPTH_DENSE_TRACKER)) == 0) {
+      throw vpException(vpException::fatalError, "Bad tracker type: %d", tracker->m_trackerType);
     }
 
-    tracker->postTracking(mapOfImages[it->first], mapOfPointCloudWidths[it->first], mapOfPointCloudHeights[it->first]);
-
-    if (displayFeatures) {
+    if (tracker->m_trackerType & (EDGE_TRACKER
 #if defined(VISP_HAVE_MODULE_KLT) && defined(VISP_HAVE_OPENCV) && defined(HAVE_OPENCV_IMGPROC) && defined(HAVE_OPENCV_VIDEO)
-      if (tracker->m_trackerType & KLT_TRACKER) {
-        tracker->m_featuresToBeDisplayedKlt = tracker->getFeaturesForDisplayKlt();
-      }
+                                  | KLT_TRACKER
 #endif
+                                  ) &&
+      mapOfImages[it->first] == nullptr) {
+      throw vpException(vpException::fatalError, "Image pointer is nullptr!");
+    }
 
-      if (tracker->m_trackerType & DEPTH_NORMAL_TRACKER) {
-        tracker->m_featuresToBeDisplayedDepthNormal = tracker->getFeaturesForDisplayDepthNormal();
-      }
+    const DepthData *depth = mapOfDepthData[it->first];
+    if (tracker->m_trackerType & (DEPTH_NORMAL_TRACKER | DEPTH_DENSE_TRACKER) && (depth == nullptr)) {
+      throw vpException(vpException::fatalError, "Depth data pointer is nullptr!");
     }
+
+    mapOfPointCloudWidths[it->first] = depth ? depth->getWidth() : 0;
+    mapOfPointCloudHeights[it->first] = depth ? depth->getHeight() : 0;
   }
 
+  preTrackingCameras();
+
+  try {
+    computeVVS(mapOfImages);
+  }
+  catch (...) {
+    covarianceMatrix = -1;
+    throw; // throw the original exception
+  }
+
+  testTracking();
+
+  postTracking(mapOfImages, mapOfPointCloudWidths, mapOfPointCloudHeights);
+
   computeProjectionError();
 }
 
+/*!
+  Realize the tracking of the object in the image and in the organized point clouds,
+  for instance computed without any third-party library with vpImageConvert::depthToPointCloud().
+
+  \throw vpException : if the tracking is supposed to have failed
+
+  \param mapOfImages : Map of images.
+  \param mapOfPointClouds : Map of organized point clouds. The point cloud of a depth tracker
+  must have the size of the depth image used to set its camera parameters.
+*/
+void vpMbGenericTracker::track(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages,
+  std::map<std::string, const vpPointCloud *> &mapOfPointClouds)
+{
+  trackDepth(mapOfImages, mapOfPointClouds, [&]() { preTracking(mapOfImages, mapOfPointClouds); });
+}
+
+/*!
+  Realize the tracking of the object in the image and in the organized point clouds.
+
+  \throw vpException : if the tracking is supposed to have failed
+
+  \param mapOfColorImages : Map of images.
+  \param mapOfPointClouds : Map of organized point clouds.
+*/
+void vpMbGenericTracker::track(std::map<std::string, const vpImage<vpRGBa> *> &mapOfColorImages,
+  std::map<std::string, const vpPointCloud *> &mapOfPointClouds)
+{
+  std::map<std::string, const vpImage<unsigned char> *> mapOfImages;
+  for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
+    it != m_mapOfTrackers.end(); ++it) {
+    TrackerWrapper *tracker = it->second;
+
+    if (tracker->m_trackerType & (EDGE_TRACKER
+#if defined(VISP_HAVE_MODULE_KLT) && defined(VISP_HAVE_OPENCV) && defined(HAVE_OPENCV_IMGPROC) && defined(HAVE_OPENCV_VIDEO)
+                                  | KLT_TRACKER
+#endif
+                                  ) &&
+      mapOfColorImages[it->first] != nullptr) {
+      vpImageConvert::convert(*mapOfColorImages[it->first], tracker->m_I);
+      mapOfImages[it->first] = &tracker->m_I; // update grayscale image buffer
+    }
+  }
+
+  track(mapOfImages, mapOfPointClouds);
+}
+
+/*!
+  Realize the tracking of the object in the image and in the raw depth images. The depth trackers only
+  unproject the pixels inside the projection of the visible faces, at their sampling steps, using their
+  camera parameters, which avoids computing the point cloud of the whole depth image.
+
+  \throw vpException : if the tracking is supposed to have failed
+
+  \param mapOfImages : Map of images.
+  \param mapOfDepthImages : Map of raw depth images. The depth image of a depth tracker
+  must have the size used to set its camera parameters.
+  \param depth_scale : Depth scale to convert the raw values in meter, for instance 0.001 for a depth in mm.
+*/
+void vpMbGenericTracker::track(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages,
+  std::map<std::string, const vpImage<uint16_t> *> &mapOfDepthImages, float depth_scale)
+{
+  trackDepth(mapOfImages, mapOfDepthImages, [&]() { preTracking(mapOfImages, mapOfDepthImages, depth_scale); });
+}
+
+/*!
+  Realize the tracking of the object in the image and in the raw depth images.
+
+  \throw vpException : if the tracking is supposed to have failed
+
+  \param mapOfColorImages : Map of images.
+  \param mapOfDepthImages : Map of raw depth images.
+  \param depth_scale : Depth scale to convert the raw values in meter, for instance 0.001 for a depth in mm.
+*/
+void vpMbGenericTracker::track(std::map<std::string, const vpImage<vpRGBa> *> &mapOfColorImages,
+  std::map<std::string, const vpImage<uint16_t> *> &mapOfDepthImages, float depth_scale)
+{
+  std::map<std::string, const vpImage<unsigned char> *> mapOfImages;
+  for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
+    it != m_mapOfTrackers.end(); ++it) {
+    TrackerWrapper *tracker = it->second;
+
+    if (tracker->m_trackerType & (EDGE_TRACKER
+#if defined(VISP_HAVE_MODULE_KLT) && defined(VISP_HAVE_OPENCV) && defined(HAVE_OPENCV_IMGPROC) && defined(HAVE_OPENCV_VIDEO)
+                                  | KLT_TRACKER
+#endif
+                                  ) &&
+      mapOfColorImages[it->first] != nullptr) {
+      vpImageConvert::convert(*mapOfColorImages[it->first], tracker->m_I);
+      mapOfImages[it->first] = &tracker->m_I; // update grayscale image buffer
+    }
+  }
+
+  track(mapOfImages, mapOfDepthImages, depth_scale);
+}
+
 /** TrackerWrapper **/
 vpMbGenericTracker::TrackerWrapper::TrackerWrapper()
   : m_error(), m_L(), m_trackerType(EDGE_TRACKER), m_w(), m_weightedError()
@@ -6702,6 +7085,29 @@ void vpMbGenericTracker::TrackerWrapper::initMbtTracking(const vpImage<unsigned
   }
 }
 
+/*!
+  Load a model shared with the other trackers, as loadModel() would do from
+  \e modelFile.
+
+  \param model : The model, loaded from \e modelFile.
+  \param modelFile : The file the model has been loaded from.
+  \param odTo : Transformation matrix applied to the points of the model.
+*/
+void vpMbGenericTracker::TrackerWrapper::loadSharedModel(const vpMbtModel &model, const std::string &modelFile,
+  const vpHomogeneousMatrix &odTo)
+{
+  loadModel(model, odTo);
+  modelFileName = modelFile;
+
+#ifdef VISP_HAVE_COIN3D
+  // SoDB::init() is called by vpMbtModel::loadVRML()
+  std::string extension = vpIoTools::getFileExtension(modelFile);
+  if ((extension == ".wrl") || (extension == ".WRL")) {
+    m_sodb_init_called = true;
+  }
+#endif
+}
+
 void vpMbGenericTracker::TrackerWrapper::loadConfigFile(const std::string &configFile, bool verbose)
 {
 #if defined(VISP_HAVE_PUGIXML)
@@ -7075,6 +7481,83 @@ void vpMbGenericTracker::TrackerWrapper::preTracking(const vpImage<unsigned char
   }
 }
 
+/*!
+  Track the image features and segment the depth data with \e segmentDepth, called with DEPTH_NORMAL_TRACKER or
+  DEPTH_DENSE_TRACKER for the depth tracker to update.
+*/
+template <class DepthSegmentation>
+void vpMbGenericTracker::TrackerWrapper::preTrackingDepth(const vpImage<unsigned char> *const ptr_I,
+  const DepthSegmentation &segmentDepth)
+{
+  if (m_trackerType & EDGE_TRACKER) {
+    try {
+      vpMbEdgeTracker::trackMovingEdge(*ptr_I);
+    }
+    catch (...) {
+      std::cerr << "Error in moving edge tracking" << std::endl;
+      throw;
+    }
+  }
+
+#if defined(VISP_HAVE_MODULE_KLT) && defined(VISP_HAVE_OPENCV) && defined(HAVE_OPENCV_IMGPROC) && defined(HAVE_OPENCV_VIDEO)
+  if (m_trackerType & KLT_TRACKER) {
+    try {
+      vpMbKltTracker::preTracking(*ptr_I);
+    }
+    catch (const vpException &e) {
+      std::cerr << "Error in KLT tracking: " << e.what() << std::endl;
+      throw;
+    }
+  }
+#endif
+
+  if (m_trackerType & DEPTH_NORMAL_TRACKER) {
+    try {
+      segmentDepth(DEPTH_NORMAL_TRACKER);
+    }
+    catch (...) {
+      std::cerr << "Error in Depth tracking" << std::endl;
+      throw;
+    }
+  }
+
+  if (m_trackerType & DEPTH_DENSE_TRACKER) {
+    try {
+      segmentDepth(DEPTH_DENSE_TRACKER);
+    }
+    catch (...) {
+      std::cerr << "Error in Depth dense tracking" << std::endl;
+      throw;
+    }
+  }
+}
+
+void vpMbGenericTracker::TrackerWrapper::preTracking(const vpImage<unsigned char> *const ptr_I,
+  const vpPointCloud *const point_cloud)
+{
+  preTrackingDepth(ptr_I, [&](int trackerType) {
+    if (trackerType == DEPTH_NORMAL_TRACKER) {
+      vpMbDepthNormalTracker::segmentPointCloud(*point_cloud);
+    }
+    else {
+      vpMbDepthDenseTracker::segmentPointCloud(*point_cloud);
+    }
+  });
+}
+
+void vpMbGenericTracker::TrackerWrapper::preTracking(const vpImage<unsigned char> *const ptr_I,
+  const vpImage<uint16_t> *const depth_raw, float depth_scale)
+{
+  preTrackingDepth(ptr_I, [&](int trackerType) {
+    if (trackerType == DEPTH_NORMAL_TRACKER) {
+      vpMbDepthNormalTracker::segmentPointCloud(*depth_raw, depth_scale);
+    }
+    else {
+      vpMbDepthDenseTracker::segmentPointCloud(*depth_raw, depth_scale);
+    }
+  });
+}
+
 void vpMbGenericTracker::TrackerWrapper::reInitModel(const vpImage<unsigned char> *const I,
   const vpImage<vpRGBa> *const I_color, const std::string &cad_name,
   const vpHomogeneousMatrix &cMo, bool verbose,
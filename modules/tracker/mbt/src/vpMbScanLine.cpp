@@ -51,6 +51,10 @@
 #include <visp3/core/vpMeterPixelConversion.h>
 #include <visp3/mbt/vpMbScanLine.h>
 
+#ifdef VISP_HAVE_OPENMP
+#include <omp.h>
+#endif
+
 #if defined(DEBUG_DISP)
 #include <visp3/gui/vpDisplayGDI.h>
 #include <visp3/gui/vpDisplayX.h>
@@ -59,7 +63,9 @@
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 BEGIN_VISP_NAMESPACE
 vpMbScanLine::vpMbScanLine()
-  : w(0), h(0), K(), maskBorder(0), mask(), primitive_ids(), visibility_samples(), depthTreshold(1e-06)
+  : w(0), h(0), K(), maskBorder(0), mask(), maskX(), maskY(), primitive_ids(), depthTreshold(1e-06), nbThreads(0),
+  vertices(), polygonEdges(), scenePolygons(), edgeKeys(), scanlinesY(), scanlinesX(), samplesY(), samplesX(),
+  statesY(), statesX(), buffers(), edges(), sampleBegins(), visibility_samples()
 #if defined(DEBUG_DISP)
   ,
   dispMaskDebug(nullptr), dispLineDebug(nullptr), linedebugImg()
@@ -89,19 +95,26 @@ vpMbScanLine::~vpMbScanLine()
 
   \param a : First point of the line.
   \param b : Second point of the line.
-  \param edge : Pair with the two points of the line.
+  \param edge : Index of the edge of the line.
   \param ID : Id of the given line (has to be know when using queries).
+  \param first : First scanline of the band being rendered.
+  \param last : Scanline following the last one of the band being rendered.
+  \param offset : Index in \e scanlines of the scanline 0.
   \param scanlines : Resulting intersections.
+  \param touchedFirst : Updated with the first scanline that has been intersected.
+  \param touchedLast : Updated with the scanline following the last one that has been intersected.
 */
-void vpMbScanLine::drawLineY(const vpColVector &a, const vpColVector &b, const vpMbScanLineEdge &edge, const int ID,
-                             std::vector<std::vector<vpMbScanLineSegment> > &scanlines)
+void vpMbScanLine::drawLineY(const vpMbScanLineVertex &a, const vpMbScanLineVertex &b, unsigned int edge,
+                             const int ID, unsigned int first, unsigned int last, unsigned int offset,
+                             std::vector<std::vector<vpMbScanLineIntersection> > &scanlines, unsigned int &touchedFirst,
+                             unsigned int &touchedLast)
 {
-  double x0 = a[0] / a[2];
-  double y0 = a[1] / a[2];
-  double z0 = a[2];
-  double x1 = b[0] / b[2];
-  double y1 = b[1] / b[2];
-  double z1 = b[2];
+  double x0 = a.x;
+  double y0 = a.y;
+  double z0 = a.z;
+  double x1 = b.x;
+  double y1 = b.y;
+  double z1 = b.z;
   if (y0 > y1) {
     std::swap(x0, x1);
     std::swap(y0, y1);
@@ -117,10 +130,10 @@ void vpMbScanLine::drawLineY(const vpColVector &a, const vpColVector &b, const v
 
   const bool b_sample_Y = (std::fabs(y0 - y1) > std::fabs(x0 - x1));
 
-  for (unsigned int y = _y0; y < _y1; ++y) {
+  for (unsigned int y = std::max<unsigned int>(_y0, first); y < _y1 && y < last; ++y) {
     double x = x0 + (x1 - x0) * (y - y0) / (y1 - y0);
     const double alpha = getAlpha(y, y0 * z0, z0, y1 * z1, z1);
-    vpMbScanLineSegment s;
+    vpMbScanLineIntersection s;
     s.p = x;
     s.type = POINT;
     s.Z2 = s.Z1 = mix(z0, z1, alpha);
@@ -128,7 +141,9 @@ void vpMbScanLine::drawLineY(const vpColVector &a, const vpColVector &b, const v
     s.ID = ID;
     s.edge = edge;
     s.b_sample_Y = b_sample_Y;
-    scanlines[y].push_back(s);
+    scanlines[y - offset].push_back(s);
+    touchedFirst = std::min<unsigned int>(touchedFirst, y);
+    touchedLast = std::max<unsigned int>(touchedLast, y + 1);
   }
 }
 
@@ -138,19 +153,26 @@ void vpMbScanLine::drawLineY(const vpColVector &a, const vpColVector &b, const v
 
   \param a : First point of the line.
   \param b : Second point of the line.
-  \param edge : Pair with the two points of the line.
+  \param edge : Index of the edge of the line.
   \param ID : Id of the given line (has to be know when using queries).
+  \param first : First scanline of the band being rendered.
+  \param last : Scanline following the last one of the band being rendered.
+  \param offset : Index in \e scanlines of the scanline 0.
   \param scanlines : Resulting intersections.
+  \param touchedFirst : Updated with the first scanline that has been intersected.
+  \param touchedLast : Updated with the scanline following the last one that has been intersected.
 */
-void vpMbScanLine::drawLineX(const vpColVector &a, const vpColVector &b, const vpMbScanLineEdge &edge, const int ID,
-                             std::vector<std::vector<vpMbScanLineSegment> > &scanlines)
+void vpMbScanLine::drawLineX(const vpMbScanLineVertex &a, const vpMbScanLineVertex &b, unsigned int edge,
+                             const int ID, unsigned int first, unsigned int last, unsigned int offset,
+                             std::vector<std::vector<vpMbScanLineIntersection> > &scanlines, unsigned int &touchedFirst,
+                             unsigned int &touchedLast)
 {
-  double x0 = a[0] / a[2];
-  double y0 = a[1] / a[2];
-  double z0 = a[2];
-  double x1 = b[0] / b[2];
-  double y1 = b[1] / b[2];
-  double z1 = b[2];
+  double x0 = a.x;
+  double y0 = a.y;
+  double z0 = a.z;
+  double x1 = b.x;
+  double y1 = b.y;
+  double z1 = b.z;
   if (x0 > x1) {
     std::swap(x0, x1);
     std::swap(y0, y1);
@@ -166,10 +188,10 @@ void vpMbScanLine::drawLineX(const vpColVector &a, const vpColVector &b, const v
 
   const bool b_sample_Y = (std::fabs(y0 - y1) > std::fabs(x0 - x1));
 
-  for (unsigned int x = _x0; x < _x1; ++x) {
+  for (unsigned int x = std::max<unsigned int>(_x0, first); x < _x1 && x < last; ++x) {
     double y = y0 + (y1 - y0) * (x - x0) / (x1 - x0);
     const double alpha = getAlpha(x, x0 * z0, z0, x1 * z1, z1);
-    vpMbScanLineSegment s;
+    vpMbScanLineIntersection s;
     s.p = y;
     s.type = POINT;
     s.Z2 = s.Z1 = mix(z0, z1, alpha);
@@ -177,112 +199,88 @@ void vpMbScanLine::drawLineX(const vpColVector &a, const vpColVector &b, const v
     s.ID = ID;
     s.edge = edge;
     s.b_sample_Y = b_sample_Y;
-    scanlines[x].push_back(s);
-  }
-}
-
-/*!
-  Compute the Y-axis scanlines intersections of a polygon.
-
-  \param polygon : Polygon composed by an array of lines.
-  \param ID : ID of the polygon (has to be know when using queries).
-  \param scanlines : Resulting intersections.
-*/
-void vpMbScanLine::drawPolygonY(const std::vector<std::pair<vpPoint, unsigned int> > &polygon, const int ID,
-                                std::vector<std::vector<vpMbScanLineSegment> > &scanlines)
-{
-  if (polygon.size() < 2)
-    return;
-
-  if (polygon.size() == 2) {
-    vpColVector p1, p2;
-    createVectorFromPoint(polygon.front().first, p1, K);
-    createVectorFromPoint(polygon.back().first, p2, K);
-
-    drawLineY(p1, p2, makeMbScanLineEdge(polygon.front().first, polygon.back().first), ID, scanlines);
-    return;
-  }
-
-  std::vector<std::vector<vpMbScanLineSegment> > local_scanlines;
-  local_scanlines.resize(h);
-
-  for (size_t i = 0; i < polygon.size(); ++i) {
-    vpColVector p1, p2;
-    createVectorFromPoint(polygon[i].first, p1, K);
-    createVectorFromPoint(polygon[(i + 1) % polygon.size()].first, p2, K);
-
-    drawLineY(p1, p2, makeMbScanLineEdge(polygon[i].first, polygon[(i + 1) % polygon.size()].first), ID,
-              local_scanlines);
+    scanlines[x - offset].push_back(s);
+    touchedFirst = std::min<unsigned int>(touchedFirst, x);
+    touchedLast = std::max<unsigned int>(touchedLast, x + 1);
   }
-
-  createScanLinesFromLocals(scanlines, local_scanlines, h);
 }
 
 /*!
-  Compute the X-axis scanlines intersections of a polygon.
-
-  \param polygon : Polygon composed by an array of lines.
-  \param ID : ID of the polygon (has to be know when using queries).
-  \param scanlines : Resulting intersections.
+  Compute the intersections of a polygon with the Y-axis or X-axis scanlines
+  of a band.
+
+  \param axisY : True for the Y-axis scanlines (image rows), false for the
+  X-axis ones (image columns).
+  \param polygon : Projected polygon.
+  \param first : First scanline of the band.
+  \param last : Scanline following the last one of the band.
+  \param buffer : Working buffers of the band.
 */
-void vpMbScanLine::drawPolygonX(const std::vector<std::pair<vpPoint, unsigned int> > &polygon, const int ID,
-                                std::vector<std::vector<vpMbScanLineSegment> > &scanlines)
+void vpMbScanLine::drawPolygon(bool axisY, const vpMbScanLinePolygon &polygon, unsigned int first, unsigned int last,
+                               vpMbScanLineBuffer &buffer)
 {
-  if (polygon.size() < 2)
-    return;
-
-  if (polygon.size() == 2) {
-    vpColVector p1, p2;
-    createVectorFromPoint(polygon.front().first, p1, K);
-    createVectorFromPoint(polygon.back().first, p2, K);
-
-    drawLineX(p1, p2, makeMbScanLineEdge(polygon.front().first, polygon.back().first), ID, scanlines);
+  std::vector<std::vector<vpMbScanLineIntersection> > &scanlines = axisY ? scanlinesY : scanlinesX;
+  unsigned int touchedFirst = last, touchedLast = first;
+
+  if (polygon.size == 2) {
+    if (axisY)
+      drawLineY(vertices[polygon.first], vertices[polygon.first + 1], polygonEdges[polygon.first], polygon.ID, first,
+                last, 0, scanlines, touchedFirst, touchedLast);
+    else
+      drawLineX(vertices[polygon.first], vertices[polygon.first + 1], polygonEdges[polygon.first], polygon.ID, first,
+                last, 0, scanlines, touchedFirst, touchedLast);
     return;
   }
 
-  std::vector<std::vector<vpMbScanLineSegment> > local_scanlines;
-  local_scanlines.resize(w);
-
-  for (size_t i = 0; i < polygon.size(); ++i) {
-    vpColVector p1, p2;
-    createVectorFromPoint(polygon[i].first, p1, K);
-    createVectorFromPoint(polygon[(i + 1) % polygon.size()].first, p2, K);
-
-    drawLineX(p1, p2, makeMbScanLineEdge(polygon[i].first, polygon[(i + 1) % polygon.size()].first), ID,
-              local_scanlines);
+  std::vector<std::vector<vpMbScanLineIntersection> > &local_scanlines = buffer.localScanlines;
+  if (local_scanlines.size() < last - first)
+    local_scanlines.resize(last - first);
+
+  for (size_t i = 0; i < polygon.size; ++i) {
+    const size_t i1 = polygon.first + i;
+    const size_t i2 = polygon.first + ((i + 1) % polygon.size);
+    if (axisY)
+      drawLineY(vertices[i1], vertices[i2], polygonEdges[i1], polygon.ID, first, last, first, local_scanlines,
+                touchedFirst, touchedLast);
+    else
+      drawLineX(vertices[i1], vertices[i2], polygonEdges[i1], polygon.ID, first, last, first, local_scanlines,
+                touchedFirst, touchedLast);
   }
 
-  createScanLinesFromLocals(scanlines, local_scanlines, w);
+  createScanLinesFromLocals(scanlines, local_scanlines, touchedFirst, touchedLast, first);
 }
 
 /*!
   Organise local scanlines in a global scanline vector.
   It also marks the computed intersections as starting or ending points.
-  This function will only be called by the drawPolygons functions.
+  This function will only be called by drawPolygon(). The local scanlines
+  are left empty.
 
   \param scanlines : Global scanline vector.
   \param localScanlines : Local scanline vector (X or Y-axis).
-  \param size : Corresponding size (typically the width or the height).
+  \param first : First scanline to organise.
+  \param last : Scanline following the last one to organise.
+  \param offset : Index in \e localScanlines of the scanline 0.
 */
-void vpMbScanLine::createScanLinesFromLocals(std::vector<std::vector<vpMbScanLineSegment> > &scanlines,
-                                             std::vector<std::vector<vpMbScanLineSegment> > &localScanlines,
-                                             const unsigned int &size)
+void vpMbScanLine::createScanLinesFromLocals(std::vector<std::vector<vpMbScanLineIntersection> > &scanlines,
+                                             std::vector<std::vector<vpMbScanLineIntersection> > &localScanlines,
+                                             unsigned int first, unsigned int last, unsigned int offset)
 {
-  for (unsigned int j = 0; j < size; ++j) {
-    std::vector<vpMbScanLineSegment> &scanline = localScanlines[j];
+  for (unsigned int j = first; j < last; ++j) {
+    std::vector<vpMbScanLineIntersection> &scanline = localScanlines[j - offset];
     sort(scanline.begin(), scanline.end(),
-         vpMbScanLineSegmentComparator()); // Not sure its necessary
+         vpMbScanLineIntersectionComparator()); // Not sure its necessary
 
     bool b_start = true;
     for (size_t i = 0; i < scanline.size(); ++i) {
-      vpMbScanLineSegment s = scanline[i];
+      vpMbScanLineIntersection s = scanline[i];
       if (b_start) {
         s.type = START;
         s.P1 = s.p * s.Z1;
         b_start = false;
       }
       else {
-        vpMbScanLineSegment &prev = scanlines[j].back();
+        vpMbScanLineIntersection &prev = scanlines[j].back();
         s.type = END;
         s.P1 = prev.P1;
         s.Z1 = prev.Z1;
@@ -293,13 +291,229 @@ void vpMbScanLine::createScanLinesFromLocals(std::vector<std::vector<vpMbScanLin
       }
       scanlines[j].push_back(s);
     }
+    scanline.clear();
+  }
+}
+
+/*!
+  Compute the intersections of all the polygons of the scene with the
+  scanlines of a band, then render these scanlines.
+
+  The rendering of a scanline depends on the visible polygon at the end of
+  the previous one. The first scanline of the band is rendered as if there
+  were none, drawScene() renders it again when it is not the case.
+
+  \param axisY : True for the Y-axis scanlines (image rows), false for the
+  X-axis ones (image columns).
+  \param first : First scanline of the band.
+  \param last : Scanline following the last one of the band.
+  \param buffer : Working buffers of the band.
+*/
+void vpMbScanLine::drawBand(bool axisY, unsigned int first, unsigned int last, vpMbScanLineBuffer &buffer)
+{
+  std::vector<std::vector<vpMbScanLineIntersection> > &scanlines = axisY ? scanlinesY : scanlinesX;
+  std::vector<vpMbScanLineState> &states = axisY ? statesY : statesX;
+
+  for (unsigned int line = first; line < last; ++line)
+    scanlines[line].clear();
+
+  for (size_t i = 0; i < scenePolygons.size(); ++i) {
+    const vpMbScanLinePolygon &polygon = scenePolygons[i];
+    // The polygon only intersects the scanlines in [min, max[
+    const double min = axisY ? polygon.ymin : polygon.xmin;
+    const double max = axisY ? polygon.ymax : polygon.xmax;
+    if (max <= first || min >= last)
+      continue;
+
+    drawPolygon(axisY, polygon, first, last, buffer);
+  }
+
+  vpMbScanLineState state;
+  for (unsigned int line = first; line < last; ++line) {
+    std::vector<vpMbScanLineIntersection> &scanline = scanlines[line];
+    sort(scanline.begin(), scanline.end(), vpMbScanLineIntersectionComparator());
+
+    resetScanLine(axisY, line);
+    renderScanLine(axisY, line, state, buffer.stack);
+    states[line] = state;
+  }
+}
+
+/*!
+  Reset the visibility samples and the masks computed from a scanline.
+
+  \param axisY : True for a Y-axis scanline (image row), false for a X-axis
+  one (image column).
+  \param line : Index of the scanline.
+*/
+void vpMbScanLine::resetScanLine(bool axisY, unsigned int line)
+{
+  if (axisY) {
+    samplesY[line].clear();
+    for (unsigned int x = 0; x < w; ++x) {
+      primitive_ids[line][x] = -1;
+      mask[line][x] = 0;
+    }
+    if (maskBorder != 0)
+      for (unsigned int x = 0; x < w; ++x)
+        maskY[line][x] = 0;
+  }
+  else {
+    samplesX[line].clear();
+    if (maskBorder != 0)
+      for (unsigned int y = 0; y < h; ++y)
+        maskX[y][line] = 0;
   }
 }
 
+/*!
+  Render a sorted scanline: find the visible polygon along the scanline,
+  fill the masks and record the visible edges as visibility samples.
+
+  \param axisY : True for a Y-axis scanline (image row), false for a X-axis
+  one (image column).
+  \param line : Index of the scanline.
+  \param state : Visible polygon at the end of the previous scanline, updated
+  with the one at the end of this scanline.
+  \param stack : Working buffer.
+*/
+void vpMbScanLine::renderScanLine(bool axisY, unsigned int line, vpMbScanLineState &state,
+                                  std::vector<std::pair<double, vpMbScanLineIntersection> > &stack)
+{
+  const std::vector<vpMbScanLineIntersection> &scanline = axisY ? scanlinesY[line] : scanlinesX[line];
+  std::vector<unsigned int> &samples = axisY ? samplesY[line] : samplesX[line];
+  int &last_ID = state.last_ID;
+  vpMbScanLineIntersection &last_visible = state.last_visible;
+
+  stack.clear();
+  for (size_t i = 0; i < scanline.size(); ++i) {
+    const vpMbScanLineIntersection &s = scanline[i];
+
+    switch (s.type) {
+    case START:
+      stack.push_back(std::make_pair(s.Z1, s));
+      break;
+    case END:
+      for (size_t j = 0; j < stack.size(); ++j)
+        if (stack[j].second.ID == s.ID) {
+          if (j != stack.size() - 1)
+            stack[j] = stack.back();
+          stack.pop_back();
+          break;
+        }
+      break;
+    case POINT:
+      break;
+    }
+
+    for (size_t j = 0; j < stack.size(); ++j) {
+      const vpMbScanLineIntersection &s0 = stack[j].second;
+      stack[j].first = mix(s0.Z1, s0.Z2, getAlpha(s.type == POINT ? s.p : (s.p + 0.5), s0.P1, s0.Z1, s0.P2, s0.Z2));
+    }
+    sort(stack.begin(), stack.end(), vpMbScanLineIntersectionComparator());
+
+    int new_ID = stack.empty() ? -1 : stack.front().second.ID;
+
+    if (new_ID != last_ID || s.type == POINT) {
+      if (s.b_sample_Y == axisY)
+        switch (s.type) {
+        case POINT:
+          if (new_ID == -1 || s.Z1 - depthTreshold <= stack.front().first)
+            samples.push_back(s.edge);
+          break;
+        case START:
+          if (new_ID == s.ID)
+            samples.push_back(s.edge);
+          break;
+        case END:
+          if (last_ID == s.ID)
+            samples.push_back(s.edge);
+          break;
+        }
+
+      // This part will only be used for MbKltTracking
+      if (axisY && last_ID != -1) {
+        const unsigned int y = line;
+        const unsigned int x0 = std::max<unsigned int>((unsigned int)0, (unsigned int)(std::ceil(last_visible.p)));
+        double x1 = std::min<double>((double)w, (double)s.p);
+        for (unsigned int x = x0 + maskBorder; x < x1 - maskBorder; ++x) {
+          primitive_ids[(unsigned int)y][(unsigned int)x] = last_visible.ID;
+
+          if (maskBorder != 0)
+            maskY[(unsigned int)y][(unsigned int)x] = 255;
+          else
+            mask[(unsigned int)y][(unsigned int)x] = 255;
+        }
+      }
+      else if (!axisY && maskBorder != 0 && last_ID != -1) {
+        const unsigned int x = line;
+        const unsigned int y0 = std::max<unsigned int>((unsigned int)0, (unsigned int)(std::ceil(last_visible.p)));
+        double y1 = std::min<double>((double)h, (double)s.p);
+        for (unsigned int y = y0 + maskBorder; y < y1 - maskBorder; ++y) {
+          maskX[(unsigned int)y][(unsigned int)x] = 255;
+        }
+      }
+
+      last_ID = new_ID;
+      if (!stack.empty()) {
+        last_visible = stack.front().second;
+        last_visible.p = s.p;
+      }
+    }
+  }
+}
+
+/*!
+  Gather the visibility samples recorded by the scanlines per edge, sorted
+  and without duplicates.
+*/
+void vpMbScanLine::buildEdgeSamples()
+{
+  sampleBegins.assign(edges.size() + 1, 0);
+  for (unsigned int y = 0; y < h; ++y)
+    for (size_t i = 0; i < samplesY[y].size(); ++i)
+      ++sampleBegins[samplesY[y][i] + 1];
+  for (unsigned int x = 0; x < w; ++x)
+    for (size_t i = 0; i < samplesX[x].size(); ++i)
+      ++sampleBegins[samplesX[x][i] + 1];
+  for (size_t i = 1; i < sampleBegins.size(); ++i)
+    sampleBegins[i] += sampleBegins[i - 1];
+
+  visibility_samples.resize(sampleBegins.back());
+  std::vector<size_t> ends(sampleBegins.begin(), sampleBegins.end() - 1);
+  for (unsigned int y = 0; y < h; ++y)
+    for (size_t i = 0; i < samplesY[y].size(); ++i)
+      visibility_samples[ends[samplesY[y][i]]++] = static_cast<int>(y);
+  for (unsigned int x = 0; x < w; ++x)
+    for (size_t i = 0; i < samplesX[x].size(); ++i)
+      visibility_samples[ends[samplesX[x][i]]++] = static_cast<int>(x);
+
+  // Samples are already sorted, unless the edge has been sampled along both axes, but an edge shared by several
+  // polygons is sampled several times
+  size_t size = 0;
+  for (size_t i = 0; i < edges.size(); ++i) {
+    std::vector<int>::iterator first = visibility_samples.begin() + sampleBegins[i];
+    std::vector<int>::iterator last = visibility_samples.begin() + ends[i];
+    if (!std::is_sorted(first, last))
+      std::sort(first, last);
+    last = std::unique(first, last);
+
+    sampleBegins[i] = size;
+    size = static_cast<size_t>(std::copy(first, last, visibility_samples.begin() + size) - visibility_samples.begin());
+  }
+  sampleBegins.back() = size;
+  visibility_samples.resize(size);
+}
+
 /*!
   Render a scene of polygons and compute scanlines intersections in order to
   use queries.
 
+  The image rows (Y-axis scanlines) and then the image columns (X-axis
+  scanlines) are split in bands rendered in parallel when OpenMP is
+  available. The buffers holding the intersections are kept from one call to
+  the next one.
+
   \param polygons : List of polygons composed by arrays of lines.
   \param listPolyIndices : List of polygons IDs (has to be know when using
   queries). \param cam : Camera parameters. \param width : Width of the image
@@ -313,173 +527,119 @@ void vpMbScanLine::drawScene(const std::vector<std::vector<std::pair<vpPoint, un
   this->h = height;
   this->K = cam;
 
-  visibility_samples.clear();
-
-  std::vector<std::vector<vpMbScanLineSegment> > scanlinesY;
-  scanlinesY.resize(h);
-  std::vector<std::vector<vpMbScanLineSegment> > scanlinesX;
-  scanlinesX.resize(w);
-
-  mask.resize(h, w, 0);
-
-  vpImage<unsigned char> maskY(h, w, 0);
-  vpImage<unsigned char> maskX(h, w, 0);
-
-  primitive_ids.resize(h, w, -1);
-
+  // Project the vertices and give the same index to the edges shared by several polygons
+  vertices.clear();
+  polygonEdges.clear();
+  scenePolygons.clear();
+  edgeKeys.clear();
   for (unsigned int ID = 0; ID < polygons.size(); ++ID) {
-    drawPolygonY(*(polygons[ID]), listPolyIndices[ID], scanlinesY);
-    drawPolygonX(*(polygons[ID]), listPolyIndices[ID], scanlinesX);
-  }
-
-  // Y
-  int last_ID = -1;
-  vpMbScanLineSegment last_visible;
-  for (unsigned int y = 0; y < scanlinesY.size(); ++y) {
-    std::vector<vpMbScanLineSegment> &scanline = scanlinesY[y];
-    sort(scanline.begin(), scanline.end(), vpMbScanLineSegmentComparator());
-
-    std::vector<std::pair<double, vpMbScanLineSegment> > stack;
-    for (size_t i = 0; i < scanline.size(); ++i) {
-      const vpMbScanLineSegment &s = scanline[i];
-
-      switch (s.type) {
-      case START:
-        stack.push_back(std::make_pair(s.Z1, s));
-        break;
-      case END:
-        for (size_t j = 0; j < stack.size(); ++j)
-          if (stack[j].second.ID == s.ID) {
-            if (j != stack.size() - 1)
-              stack[j] = stack.back();
-            stack.pop_back();
-            break;
-          }
-        break;
-      case POINT:
-        break;
-      }
+    const std::vector<std::pair<vpPoint, unsigned int> > &polygon = *(polygons[ID]);
+    if (polygon.size() < 2)
+      continue;
+
+    vpMbScanLinePolygon scenePolygon;
+    scenePolygon.first = vertices.size();
+    scenePolygon.size = polygon.size();
+    scenePolygon.ID = listPolyIndices[ID];
+    scenePolygon.xmin = scenePolygon.ymin = std::numeric_limits<double>::max();
+    scenePolygon.xmax = scenePolygon.ymax = -std::numeric_limits<double>::max();
+    bool finite = true;
+    for (size_t i = 0; i < polygon.size(); ++i) {
+      const vpMbScanLineVertex vertex = projectPoint(polygon[i].first, K);
+      vertices.push_back(vertex);
+
+      finite = finite && !vpMath::isNaN(vertex.x) && !vpMath::isInf(vertex.x) && !vpMath::isNaN(vertex.y) &&
+        !vpMath::isInf(vertex.y);
+      scenePolygon.xmin = std::min<double>(scenePolygon.xmin, vertex.x);
+      scenePolygon.xmax = std::max<double>(scenePolygon.xmax, vertex.x);
+      scenePolygon.ymin = std::min<double>(scenePolygon.ymin, vertex.y);
+      scenePolygon.ymax = std::max<double>(scenePolygon.ymax, vertex.y);
+    }
+    if (!finite) {
+      scenePolygon.xmin = scenePolygon.ymin = -std::numeric_limits<double>::max();
+      scenePolygon.xmax = scenePolygon.ymax = std::numeric_limits<double>::max();
+    }
 
-      for (size_t j = 0; j < stack.size(); ++j) {
-        const vpMbScanLineSegment &s0 = stack[j].second;
-        stack[j].first = mix(s0.Z1, s0.Z2, getAlpha(s.type == POINT ? s.p : (s.p + 0.5), s0.P1, s0.Z1, s0.P2, s0.Z2));
-      }
-      sort(stack.begin(), stack.end(), vpMbScanLineSegmentComparator());
-
-      int new_ID = stack.empty() ? -1 : stack.front().second.ID;
-
-      if (new_ID != last_ID || s.type == POINT) {
-        if (s.b_sample_Y)
-          switch (s.type) {
-          case POINT:
-            if (new_ID == -1 || s.Z1 - depthTreshold <= stack.front().first)
-              visibility_samples[s.edge].insert((int)y);
-            break;
-          case START:
-            if (new_ID == s.ID)
-              visibility_samples[s.edge].insert((int)y);
-            break;
-          case END:
-            if (last_ID == s.ID)
-              visibility_samples[s.edge].insert((int)y);
-            break;
-          }
-
-        // This part will only be used for MbKltTracking
-        if (last_ID != -1) {
-          const unsigned int x0 = std::max<unsigned int>((unsigned int)0, (unsigned int)(std::ceil(last_visible.p)));
-          double x1 = std::min<double>((double)w, (double)s.p);
-          for (unsigned int x = x0 + maskBorder; x < x1 - maskBorder; ++x) {
-            primitive_ids[(unsigned int)y][(unsigned int)x] = last_visible.ID;
-
-            if (maskBorder != 0)
-              maskY[(unsigned int)y][(unsigned int)x] = 255;
-            else
-              mask[(unsigned int)y][(unsigned int)x] = 255;
-          }
-        }
+    // A two points polygon is a single edge
+    const size_t nbEdges = (polygon.size() == 2) ? 1 : polygon.size();
+    polygonEdges.resize(vertices.size(), 0);
+    for (size_t i = 0; i < nbEdges; ++i)
+      edgeKeys.push_back(std::make_pair(
+        makeMbScanLineEdgeKey(polygon[i].first, polygon[(i + 1) % polygon.size()].first), scenePolygon.first + i));
+    scenePolygons.push_back(scenePolygon);
+  }
 
-        last_ID = new_ID;
-        if (!stack.empty()) {
-          last_visible = stack.front().second;
-          last_visible.p = s.p;
-        }
-      }
-    }
+  vpMbScanLineEdgeKeyComparator comparator;
+  std::sort(edgeKeys.begin(), edgeKeys.end(),
+            [&comparator](const std::pair<vpMbScanLineEdgeKey, size_t> &a,
+                          const std::pair<vpMbScanLineEdgeKey, size_t> &b) { return comparator(a.first, b.first); });
+  edges.clear();
+  for (size_t i = 0; i < edgeKeys.size(); ++i) {
+    if (edges.empty() || comparator(edges.back(), edgeKeys[i].first))
+      edges.push_back(edgeKeys[i].first);
+    polygonEdges[edgeKeys[i].second] = static_cast<unsigned int>(edges.size() - 1);
   }
 
-  // X
-  last_ID = -1;
-  for (unsigned int x = 0; x < scanlinesX.size(); ++x) {
-    std::vector<vpMbScanLineSegment> &scanline = scanlinesX[x];
-    sort(scanline.begin(), scanline.end(), vpMbScanLineSegmentComparator());
+  // The rows of the images are reset while rendering the scanlines
+  mask.resize(h, w);
+  primitive_ids.resize(h, w);
+  if (maskBorder != 0) {
+    maskY.resize(h, w);
+    maskX.resize(h, w);
+  }
 
-    std::vector<std::pair<double, vpMbScanLineSegment> > stack;
-    for (size_t i = 0; i < scanline.size(); ++i) {
-      const vpMbScanLineSegment &s = scanline[i];
-
-      switch (s.type) {
-      case START:
-        stack.push_back(std::make_pair(s.Z1, s));
-        break;
-      case END:
-        for (size_t j = 0; j < stack.size(); ++j)
-          if (stack[j].second.ID == s.ID) {
-            if (j != stack.size() - 1)
-              stack[j] = stack.back();
-            stack.pop_back();
-            break;
-          }
-        break;
-      case POINT:
-        break;
-      }
+  scanlinesY.resize(h);
+  scanlinesX.resize(w);
+  samplesY.resize(h);
+  samplesX.resize(w);
+  statesY.resize(h);
+  statesX.resize(w);
+
+  int nbThreadsUsed = 1;
+#ifdef VISP_HAVE_OPENMP
+  nbThreadsUsed = (nbThreads > 0) ? static_cast<int>(nbThreads) : omp_get_max_threads();
+#endif
 
-      for (size_t j = 0; j < stack.size(); ++j) {
-        const vpMbScanLineSegment &s0 = stack[j].second;
-        stack[j].first = mix(s0.Z1, s0.Z2, getAlpha(s.type == POINT ? s.p : (s.p + 0.5), s0.P1, s0.Z1, s0.P2, s0.Z2));
-      }
-      sort(stack.begin(), stack.end(), vpMbScanLineSegmentComparator());
-
-      int new_ID = stack.empty() ? -1 : stack.front().second.ID;
-
-      if (new_ID != last_ID || s.type == POINT) {
-        if (!s.b_sample_Y)
-          switch (s.type) {
-          case POINT:
-            if (new_ID == -1 || s.Z1 - depthTreshold <= stack.front().first)
-              visibility_samples[s.edge].insert((int)x);
-            break;
-          case START:
-            if (new_ID == s.ID)
-              visibility_samples[s.edge].insert((int)x);
-            break;
-          case END:
-            if (last_ID == s.ID)
-              visibility_samples[s.edge].insert((int)x);
-            break;
-          }
-
-        // This part will only be used for MbKltTracking
-        if (maskBorder != 0 && last_ID != -1) {
-          const unsigned int y0 = std::max<unsigned int>((unsigned int)0, (unsigned int)(std::ceil(last_visible.p)));
-          double y1 = std::min<double>((double)h, (double)s.p);
-          for (unsigned int y = y0 + maskBorder; y < y1 - maskBorder; ++y) {
-            // primitive_ids[(unsigned int)y][(unsigned int)x] =
-            // last_visible.ID;
-            maskX[(unsigned int)y][(unsigned int)x] = 255;
-          }
-        }
+  for (int pass = 0; pass < 2; ++pass) {
+    const bool axisY = (pass == 0);
+    const unsigned int size = axisY ? h : w;
+    // A few bands per thread to balance the load, the polygons being rarely spread uniformly over the image
+    const int nbBands = (nbThreadsUsed > 1) ? static_cast<int>(std::min<unsigned int>(
+      size, 4 * static_cast<unsigned int>(nbThreadsUsed))) : static_cast<int>(std::min<unsigned int>(size, 1));
+    if (buffers.size() < static_cast<size_t>(nbBands))
+      buffers.resize(nbBands);
+
+#ifdef VISP_HAVE_OPENMP
+#pragma omp parallel for num_threads(nbThreadsUsed) schedule(dynamic, 1)
+#endif
+    for (int band = 0; band < nbBands; ++band) {
+      const unsigned int first = static_cast<unsigned int>((static_cast<size_t>(size) * band) / nbBands);
+      const unsigned int last = static_cast<unsigned int>((static_cast<size_t>(size) * (band + 1)) / nbBands);
+      drawBand(axisY, first, last, buffers[band]);
+    }
 
-        last_ID = new_ID;
-        if (!stack.empty()) {
-          last_visible = stack.front().second;
-          last_visible.p = s.p;
-        }
+    // Render again the first scanlines of a band when a polygon is visible at the end of the previous band, until
+    // the result matches the one the band has been rendered with
+    std::vector<vpMbScanLineState> &states = axisY ? statesY : statesX;
+    for (int band = 1; band < nbBands; ++band) {
+      const unsigned int first = static_cast<unsigned int>((static_cast<size_t>(size) * band) / nbBands);
+      const unsigned int last = static_cast<unsigned int>((static_cast<size_t>(size) * (band + 1)) / nbBands);
+      vpMbScanLineState state = states[first - 1];
+      vpMbScanLineState assumed;
+      for (unsigned int line = first; line < last; ++line) {
+        if (state.last_ID == -1 && assumed.last_ID == -1)
+          break;
+
+        assumed = states[line];
+        resetScanLine(axisY, line);
+        renderScanLine(axisY, line, state, buffers[band].stack);
+        states[line] = state;
       }
     }
   }
 
+  buildEdgeSamples();
+
   if (maskBorder != 0)
     for (unsigned int i = 0; i < h; i++)
       for (unsigned int j = 0; j < w; j++)
@@ -528,20 +688,20 @@ void vpMbScanLine::drawScene(const std::vector<std::vector<std::pair<vpPoint, un
   False otherwise.
 */
 void vpMbScanLine::queryLineVisibility(const vpPoint &a, const vpPoint &b,
-                                       std::vector<std::pair<vpPoint, vpPoint> > &lines, const bool &displayResults)
+                                       std::vector<std::pair<vpPoint, vpPoint> > &lines,
+                                       const bool &displayResults) const
 {
-  vpColVector _a, _b;
-  createVectorFromPoint(a, _a, K);
-  createVectorFromPoint(b, _b, K);
-
-  double x0 = _a[0] / _a[2];
-  double y0 = _a[1] / _a[2];
-  double z0 = _a[2];
-  double x1 = _b[0] / _b[2];
-  double y1 = _b[1] / _b[2];
-  double z1 = _b[2];
-
-  vpMbScanLineEdge edge = makeMbScanLineEdge(a, b);
+  const vpMbScanLineVertex _a = projectPoint(a, K);
+  const vpMbScanLineVertex _b = projectPoint(b, K);
+
+  double x0 = _a.x;
+  double y0 = _a.y;
+  double z0 = _a.z;
+  double x1 = _b.x;
+  double y1 = _b.y;
+  double z1 = _b.z;
+
+  vpMbScanLineEdgeKey edge = makeMbScanLineEdgeKey(a, b);
   lines.clear();
 
   if (displayResults) {
@@ -557,8 +717,11 @@ void vpMbScanLine::queryLineVisibility(const vpPoint &a, const vpPoint &b,
 #endif
   }
 
-  if (!visibility_samples.count(edge))
+  const std::vector<vpMbScanLineEdgeKey>::const_iterator it_edge =
+    std::lower_bound(edges.begin(), edges.end(), edge, vpMbScanLineEdgeKeyComparator());
+  if (it_edge == edges.end() || vpMbScanLineEdgeKeyComparator()(edge, *it_edge))
     return;
+  const size_t index = static_cast<size_t>(it_edge - edges.begin());
 
   // Initialized as the biggest difference between the two points is on the
   // X-axis
@@ -574,22 +737,14 @@ void vpMbScanLine::queryLineVisibility(const vpPoint &a, const vpPoint &b,
   }
 
   // Cannot call swap(a,b) since a and b are const
-  // The fix consists in 2 new points that contain the right points
-  vpPoint a_;
-  vpPoint b_;
+  // Instead of swap we set the right address of the corresponding pointers
+  const vpPoint *a_ = &a;
+  const vpPoint *b_ = &b;
 
   if (*v0 > *v1) {
     std::swap(v0, v1);
     std::swap(w0, w1);
-    // std::swap(a, b);
-    // Cannot call swap(a,b) since a and b are const
-    // Instead of swap we set the right address of the corresponding pointers
-    a_ = b;
-    b_ = a;
-  }
-  else {
-    a_ = a;
-    b_ = b;
+    std::swap(a_, b_);
   }
 
   // if (*v0 >= size - 1 || *v1 < 0 || *v1 == *v0)
@@ -599,44 +754,49 @@ void vpMbScanLine::queryLineVisibility(const vpPoint &a, const vpPoint &b,
   const int _v0 = std::max<int>(0, int(std::ceil(*v0)));
   const int _v1 = std::min<int>((int)(size - 1), (int)(std::ceil(*v1) - 1));
 
-  const std::set<int> &visible_samples = visibility_samples[edge];
+  // The extremities of the visible parts are kept as samples, and only converted into points once the part is
+  // complete. The first and second points of the line are respectively stored as -1 and -2.
+  const double V0 = *v0, W0 = *w0, V1 = *v1, W1 = *w1;
+  const auto toPoint = [&](int v) {
+    if (v == -1)
+      return *a_;
+    if (v == -2)
+      return *b_;
+    return mix(*a_, *b_, getAlpha(v, V0 * W0, W0, V1 * W1, W1));
+  };
+
   int last = _v0;
-  vpPoint line_start;
-  vpPoint line_end;
+  int line_start = 0;
+  int line_end = 0;
   bool b_line_started = false;
-  for (std::set<int>::const_iterator it = visible_samples.begin(); it != visible_samples.end(); ++it) {
-    const int v = *it;
-    const double alpha = getAlpha(v, (*v0) * (*w0), (*w0), (*v1) * (*w1), (*w1));
-    // const vpPoint p = mix(a, b, alpha);
-    const vpPoint p = mix(a_, b_, alpha);
+  for (size_t i = sampleBegins[index]; i < sampleBegins[index + 1]; ++i) {
+    const int v = visibility_samples[i];
     if (last + 1 != v) {
       if (b_line_started)
-        lines.push_back(std::make_pair(line_start, line_end));
+        lines.push_back(std::make_pair(toPoint(line_start), toPoint(line_end)));
       b_line_started = false;
     }
     if (v == _v0) {
-      // line_start = a;
-      line_start = a_;
-      line_end = p;
+      line_start = -1;
+      line_end = v;
       b_line_started = true;
     }
     else if (v == _v1) {
-   // line_end = b;
-      line_end = b_;
+      line_end = -2;
       if (!b_line_started)
-        line_start = p;
+        line_start = v;
       b_line_started = true;
     }
     else {
-      line_end = p;
+      line_end = v;
       if (!b_line_started)
-        line_start = p;
+        line_start = v;
       b_line_started = true;
     }
     last = v;
   }
   if (b_line_started)
-    lines.push_back(std::make_pair(line_start, line_end));
+    lines.push_back(std::make_pair(toPoint(line_start), toPoint(line_end)));
 
   if (displayResults) {
 #if (defined(VISP_HAVE_X11) || defined(VISP_HAVE_GDI)) && defined(DEBUG_DISP)
@@ -655,17 +815,39 @@ void vpMbScanLine::queryLineVisibility(const vpPoint &a, const vpPoint &b,
 }
 
 /*!
-  Create a vpMbScanLineEdge from two points while ordering them.
+  Test the visibility of several lines, in parallel when OpenMP is available.
+  The result is the same as calling queryLineVisibility() for each of them.
+
+  \param queries : Lines to test, as pairs of points.
+  \param lines : For each line of \e queries, the list of its visible parts.
+*/
+void vpMbScanLine::queryLinesVisibility(const std::vector<std::pair<vpPoint, vpPoint> > &queries,
+                                        std::vector<std::vector<std::pair<vpPoint, vpPoint> > > &lines) const
+{
+  lines.resize(queries.size());
+  const int nbQueries = static_cast<int>(queries.size());
+
+#ifdef VISP_HAVE_OPENMP
+  const int nbThreadsUsed = (nbThreads > 0) ? static_cast<int>(nbThreads) : omp_get_max_threads();
+#pragma omp parallel for num_threads(nbThreadsUsed) schedule(static)
+#endif
+  for (int i = 0; i < nbQueries; ++i) {
+    queryLineVisibility(queries[i].first, queries[i].second, lines[i]);
+  }
+}
+
+/*!
+  Create a vpMbScanLineEdgeKey from two points while ordering them.
 
   \param a : First point of the line.
   \param b : Second point of the line.
 
-  \return Resulting vpMbScanLineEdge.
+  \return Resulting vpMbScanLineEdgeKey.
 */
-vpMbScanLine::vpMbScanLineEdge vpMbScanLine::makeMbScanLineEdge(const vpPoint &a, const vpPoint &b)
+vpMbScanLine::vpMbScanLineEdgeKey vpMbScanLine::makeMbScanLineEdgeKey(const vpPoint &a, const vpPoint &b)
 {
-  vpColVector _a(3);
-  vpColVector _b(3);
+  double _a[3];
+  double _b[3];
 
   _a[0] = std::ceil((a.get_X() * 1e8) * 1e-6);
   _a[1] = std::ceil((a.get_Y() * 1e8) * 1e-6);
@@ -684,26 +866,29 @@ vpMbScanLine::vpMbScanLineEdge vpMbScanLine::makeMbScanLineEdge(const vpPoint &a
     else if (_a[i] > _b[i])
       break;
 
-  if (b_comp)
-    return std::make_pair(_a, _b);
-
-  return std::make_pair(_b, _a);
+  vpMbScanLineEdgeKey edge;
+  for (unsigned int i = 0; i < 3; ++i) {
+    edge.first[i] = b_comp ? _a[i] : _b[i];
+    edge.second[i] = b_comp ? _b[i] : _a[i];
+  }
+  return edge;
 }
 
 /*!
-  Create a vpColVector of a projected point.
+  Project a point in the image.
 
-  \param p : Point to project.
-  \param v : Resulting vector.
+  \param p : Point to project, in the camera frame.
   \param K : Camera parameters.
+
+  \return Pixel coordinates and depth of the point.
 */
-void vpMbScanLine::createVectorFromPoint(const vpPoint &p, vpColVector &v, const vpCameraParameters &K)
+vpMbScanLine::vpMbScanLineVertex vpMbScanLine::projectPoint(const vpPoint &p, const vpCameraParameters &K)
 {
-  v = vpColVector(3);
-
-  v[0] = p.get_X() * K.get_px() + K.get_u0() * p.get_Z();
-  v[1] = p.get_Y() * K.get_py() + K.get_v0() * p.get_Z();
-  v[2] = p.get_Z();
+  vpMbScanLineVertex v;
+  v.x = (p.get_X() * K.get_px() + K.get_u0() * p.get_Z()) / p.get_Z();
+  v.y = (p.get_Y() * K.get_py() + K.get_v0() * p.get_Z()) / p.get_Z();
+  v.z = p.get_Z();
+  return v;
 }
 
 /*!
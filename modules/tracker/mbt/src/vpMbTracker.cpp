@@ -75,45 +75,13 @@
 
 #ifdef VISP_HAVE_COIN3D
 // Inventor includes
-#include <Inventor/VRMLnodes/SoVRMLCoordinate.h>
-#include <Inventor/VRMLnodes/SoVRMLGroup.h>
-#include <Inventor/VRMLnodes/SoVRMLIndexedFaceSet.h>
-#include <Inventor/VRMLnodes/SoVRMLIndexedLineSet.h>
-#include <Inventor/VRMLnodes/SoVRMLShape.h>
-#include <Inventor/VRMLnodes/SoVRMLTransform.h>
-#include <Inventor/actions/SoGetMatrixAction.h>
-#include <Inventor/actions/SoGetPrimitiveCountAction.h>
-#include <Inventor/actions/SoSearchAction.h>
-#include <Inventor/actions/SoToVRML2Action.h>
-#include <Inventor/actions/SoWriteAction.h>
-#include <Inventor/misc/SoChildList.h>
-#include <Inventor/nodes/SoSeparator.h>
-#endif
-
-#if defined(VISP_HAVE_THREADS)
-#include <mutex>
+#include <Inventor/SoDB.h>
 #endif
 
 BEGIN_VISP_NAMESPACE
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 namespace
 {
-#if defined(VISP_HAVE_THREADS)
-std::mutex g_mutex_cout;
-#endif
-/*!
-  Structure to store info about segment in CAO model files.
- */
-struct SegmentInfo
-{
-  SegmentInfo() : extremities(), name(), useLod(false), minLineLengthThresh(0.) { }
-
-  std::vector<vpPoint> extremities;
-  std::string name;
-  bool useLod;
-  double minLineLengthThresh;
-};
-
 /*!
   Structure to store info about a polygon face represented by a vpPolygon and
   by a list of vpPoint representing the corners of the polygon face in 3D.
@@ -130,48 +98,6 @@ struct PolygonFaceInfo
   vpPolygon polygon;
   std::vector<vpPoint> faceCorners;
 };
-
-/*!
-  Reference: https://stackoverflow.com/a/6089413
-  To replace the following old code:
-      char buffer[256];
-      fileId.getline(buffer, 256);
-  This should take care of the different line ending styles.
- */
-std::istream &safeGetline(std::istream &is, std::string &t)
-{
-  t.clear();
-
-  // The characters in the stream are read one-by-one using a std::streambuf.
-  // That is faster than reading them one-by-one using the std::istream.
-  // Code that uses streambuf this way must be guarded by a sentry object.
-  // The sentry object performs various tasks,
-  // such as thread synchronization and updating the stream state.
-
-  std::istream::sentry se(is, true);
-  std::streambuf *sb = is.rdbuf();
-
-  for (;;) {
-    int c = sb->sbumpc();
-    if (c == '\n') {
-      return is;
-    }
-    else if (c == '\r') {
-      if (sb->sgetc() == '\n')
-        sb->sbumpc();
-      return is;
-    }
-    else if (c == std::streambuf::traits_type::eof()) {
-   // Also handle the case when the last line has no line ending
-      if (t.empty())
-        is.setstate(std::ios::eofbit);
-      return is;
-    }
-    else { // default case
-      t += (char)c;
-    }
-  }
-}
 } // namespace
 #endif // DOXYGEN_SHOULD_SKIP_THIS
 
@@ -189,11 +115,11 @@ vpMbTracker::vpMbTracker()
   nbPolygonPoints(0), nbCylinders(0), nbCircles(0), useLodGeneral(false), applyLodSettingInConfig(false),
   minLineLengthThresholdGeneral(50.0), minPolygonAreaThresholdGeneral(2500.0), mapOfParameterNames(),
   m_computeInteraction(true), m_lambda(1.0), m_maxIter(30), m_stopCriteriaEpsilon(1e-8), m_initialMu(0.01),
-  m_projectionErrorLines(), m_projectionErrorCylinders(), m_projectionErrorCircles(), m_projectionErrorFaces(),
-  m_projectionErrorOgreShowConfigDialog(false), m_projectionErrorMe(), m_projectionErrorKernelSize(2), m_SobelX(5, 5),
-  m_SobelY(5, 5), m_projectionErrorDisplay(false), m_projectionErrorDisplayLength(20),
-  m_projectionErrorDisplayThickness(1), m_projectionErrorCam(), m_mask(nullptr), m_I(), m_sodb_init_called(false),
-  m_rand()
+  m_projectionErrorLines(), m_projectionErrorLinesIndex(), m_projectionErrorCylinders(), m_projectionErrorCircles(),
+  m_projectionErrorFaces(), m_projectionErrorOgreShowConfigDialog(false), m_projectionErrorMe(),
+  m_projectionErrorKernelSize(2), m_SobelX(5, 5), m_SobelY(5, 5), m_projectionErrorDisplay(false),
+  m_projectionErrorDisplayLength(20), m_projectionErrorDisplayThickness(1), m_projectionErrorCam(), m_mask(nullptr),
+  m_I(), m_sodb_init_called(false), m_rand(), m_model()
 {
   oJo.eye();
   // Map used to parse additional information in CAO model files,
@@ -1437,18 +1363,26 @@ void vpMbTracker::addPolygon(const std::vector<std::vector<vpPoint> > &listFaces
 
 /*!
   Load a 3D model from the file in parameter. This file must either be a vrml
-  file (.wrl) or a CAO file (.cao). CAO format is described in the
-  loadCAOModel() method.
+  file (.wrl), a CAO file (.cao) or a compiled model file written by
+  vpMbtModel::compile(). CAO format is described in the loadCAOModel() method.
+
+  A compiled model file is memory mapped and its primitives are added to the
+  tracker without parsing any text, which makes the loading of large models
+  much faster. The level of detail settings that were not set in the model
+  file are resolved with the settings of the tracker when the model is loaded,
+  as for a CAO file.
 
   \throw vpException::ioError if the file cannot be open, or if its extension
-  is not wrl or cao.
+  is not wrl or cao and it is not a compiled model file.
 
   \param modelFile : the file containing the the 3D model description.
-  The extension of this file is either .wrl or .cao.
+  The extension of this file is either .wrl or .cao, or the file is a compiled
+  model file.
   \param verbose : verbose option to print additional information when loading
   CAO model files which include other CAO model files.
-  \param odTo : optional transformation matrix (currently only for .cao) to transform
-  3D points expressed in the original object frame to the desired object frame.
+  \param odTo : optional transformation matrix (currently only for .cao and
+  compiled model files) to transform 3D points expressed in the original object
+  frame to the desired object frame.
 */
 void vpMbTracker::loadModel(const std::string &modelFile, bool verbose, const vpHomogeneousMatrix &odTo)
 {
@@ -1472,6 +1406,11 @@ void vpMbTracker::loadModel(const std::string &modelFile, bool verbose, const vp
             (*(it - 1) == 'L' && *(it - 2) == 'R' && *(it - 3) == 'W' && *(it - 4) == '.')) {
       loadVRMLModel(modelFile);
     }
+    else if (vpMbtModel::isCompiledModel(modelFile)) {
+      vpMbtModel model;
+      model.loadCompiled(modelFile);
+      loadModel(model, odTo);
+    }
     else {
       throw vpException(vpException::ioError, "Error: File %s doesn't contain a cao or wrl model", modelFile.c_str());
     }
@@ -1484,6 +1423,161 @@ void vpMbTracker::loadModel(const std::string &modelFile, bool verbose, const vp
   this->modelFileName = modelFile;
 }
 
+/*!
+  Load a 3D model that has already been loaded or compiled, see vpMbtModel.
+  The tracker keeps a copy of the model that shares its buffer, so that
+  several trackers of the same object load it from a single vpMbtModel
+  without parsing the model file again:
+
+  \code
+  vpMbtModel model;
+  model.load("object.cao");
+  for (size_t i = 0; i < trackers.size(); ++i) {
+    trackers[i]->loadModel(model);
+  }
+  \endcode
+
+  The faces and the lines, cylinders and circles built from the model keep
+  the state of each tracker (visibility, moving edges, ...), they are
+  created for each tracker as when loading a model file.
+
+  \param model : The model.
+  \param odTo : optional transformation matrix to transform 3D points
+  expressed in the frame of the model to the desired object frame.
+
+  \sa getModel()
+*/
+void vpMbTracker::loadModel(const vpMbtModel &model, const vpHomogeneousMatrix &odTo)
+{
+  nbPoints = model.getNbPoints();
+  nbLines = model.getNbLines();
+  nbPolygonLines = model.getNbPolygonLines();
+  nbPolygonPoints = model.getNbPolygonPoints();
+  nbCylinders = model.getNbCylinders();
+  nbCircles = model.getNbCircles();
+  addModelPrimitives(model, (int)faces.size(), odTo);
+  m_model = model;
+
+  this->modelInitialised = true;
+}
+
+/*!
+  Add to the tracker the primitives of a model, in the order of the model.
+  The faces, lines, cylinders and circles are created by the initFaceFromLines(),
+  initFaceFromCorners(), initCylinder() and initCircle() methods implemented in
+  the child class.
+
+  \param model : The model.
+  \param startIdFace : Id of the first face of the model.
+  \param odTo : Transformation matrix applied to the points of the model.
+*/
+void vpMbTracker::addModelPrimitives(const vpMbtModel &model, int startIdFace, const vpHomogeneousMatrix &odTo)
+{
+  bool identity = true;
+  for (unsigned int i = 0; i < 4 && identity; ++i) {
+    for (unsigned int j = 0; j < 4 && identity; ++j) {
+      identity = (odTo[i][j] == (i == j ? 1. : 0.));
+    }
+  }
+
+  // Points of the model, built once since they are shared by the primitives
+  std::vector<vpPoint> vertices(model.getNbVertices());
+  for (unsigned int k = 0; k < model.getNbVertices(); ++k) {
+    vertices[k] = model.getVertex(k);
+    if (!identity) {
+      vpColVector pt_3d(4, 1.0);
+      pt_3d[0] = vertices[k].get_oX();
+      pt_3d[1] = vertices[k].get_oY();
+      pt_3d[2] = vertices[k].get_oZ();
+      vpColVector pt_3d_tf = odTo * pt_3d;
+      vertices[k].setWorldCoordinates(pt_3d_tf[0], pt_3d_tf[1], pt_3d_tf[2]);
+    }
+  }
+
+  std::vector<vpPoint> corners;
+  for (unsigned int i = 0; i < model.getNbPrimitives(); ++i) {
+    const vpMbtModel::vpPrimitive &primitive = model.getPrimitive(i);
+    const int idFace = startIdFace + primitive.idFace;
+    const std::string name = model.getPrimitiveName(i);
+
+    // Level of detail settings that are not stored in the model are resolved with the settings of the tracker
+    bool useLod = !applyLodSettingInConfig ? useLodGeneral : false;
+    if (primitive.useLodMode == vpMbtModel::LOD_EXPLICIT) {
+      useLod = (primitive.useLod != 0);
+    }
+    else if (primitive.useLodMode == vpMbtModel::LOD_GENERAL) {
+      useLod = useLodGeneral;
+    }
+    double minPolygonAreaThreshold = !applyLodSettingInConfig ? minPolygonAreaThresholdGeneral : 2500.0;
+    if (primitive.areaMode == vpMbtModel::LOD_EXPLICIT) {
+      minPolygonAreaThreshold = primitive.minPolygonAreaThreshold;
+    }
+    else if (primitive.areaMode == vpMbtModel::LOD_GENERAL) {
+      minPolygonAreaThreshold = minPolygonAreaThresholdGeneral;
+    }
+    double minLineLengthThreshold = !applyLodSettingInConfig ? minLineLengthThresholdGeneral : 50.0;
+    if (primitive.lengthMode == vpMbtModel::LOD_EXPLICIT) {
+      minLineLengthThreshold = primitive.minLineLengthThreshold;
+    }
+    else if (primitive.lengthMode == vpMbtModel::LOD_GENERAL) {
+      minLineLengthThreshold = minLineLengthThresholdGeneral;
+    }
+
+    corners.resize(primitive.nbIndices);
+    for (unsigned int j = 0; j < primitive.nbIndices; ++j) {
+      corners[j] = vertices[model.getPrimitiveVertex(i, j)];
+    }
+
+    switch (primitive.type) {
+    case vpMbtModel::POLYGON_FROM_LINES:
+      addPolygon(corners, idFace, name, useLod, minPolygonAreaThreshold, minLineLengthThreshold);
+      initFaceFromLines(*(faces.getPolygon().back())); // Init from the last polygon that was added
+
+      addProjectionErrorPolygon(corners, idFace, name, useLod, minPolygonAreaThreshold, minLineLengthThreshold);
+      initProjectionErrorFaceFromLines(*(m_projectionErrorFaces.getPolygon().back()));
+      break;
+
+    case vpMbtModel::POLYGON_FROM_POINTS:
+      addPolygon(corners, idFace, name, useLod, minPolygonAreaThreshold, minLineLengthThreshold);
+      initFaceFromCorners(*(faces.getPolygon().back())); // Init from the last polygon that was added
+
+      addProjectionErrorPolygon(corners, idFace, name, useLod, minPolygonAreaThreshold, minLineLengthThreshold);
+      initProjectionErrorFaceFromCorners(*(m_projectionErrorFaces.getPolygon().back()));
+      break;
+
+    case vpMbtModel::CYLINDER: {
+      // The revolution axis uses the id of the cylinder, its bounding box the next one
+      addPolygon(corners[0], corners[1], idFace, name, useLod, minLineLengthThreshold);
+
+      addProjectionErrorPolygon(corners[0], corners[1], idFace, name, useLod, minLineLengthThreshold);
+
+      std::vector<std::vector<vpPoint> > listFaces;
+      createCylinderBBox(corners[0], corners[1], primitive.radius, listFaces);
+      addPolygon(listFaces, idFace + 1, name, useLod, minLineLengthThreshold);
+
+      initCylinder(corners[0], corners[1], primitive.radius, idFace, name);
+
+      addProjectionErrorPolygon(listFaces, idFace + 1, name, useLod, minLineLengthThreshold);
+      initProjectionErrorCylinder(corners[0], corners[1], primitive.radius, idFace, name);
+      break;
+    }
+
+    case vpMbtModel::CIRCLE:
+      addPolygon(corners[0], corners[1], corners[2], primitive.radius, idFace, name, useLod, minPolygonAreaThreshold);
+
+      initCircle(corners[0], corners[1], corners[2], primitive.radius, idFace, name);
+
+      addProjectionErrorPolygon(corners[0], corners[1], corners[2], primitive.radius, idFace, name, useLod,
+                                minPolygonAreaThreshold);
+      initProjectionErrorCircle(corners[0], corners[1], corners[2], primitive.radius, idFace, name);
+      break;
+
+    default:
+      break;
+    }
+  }
+}
+
 /*!
   Load the 3D model of the object from a vrml file. Only LineSet and FaceSet
   are extracted from the vrml file.
@@ -1506,49 +1600,86 @@ void vpMbTracker::loadVRMLModel(const std::string &modelFile)
 {
 #ifdef VISP_HAVE_COIN3D
   m_sodb_init_called = true;
-  SoDB::init(); // Call SoDB::finish() before ending the program.
+#endif
+  vpMbtModel model;
+  model.loadVRML(modelFile);
+  addModelPrimitives(model, (int)faces.size());
+  m_model = model;
+}
 
-  SoInput in;
-  SbBool ok = in.openFile(modelFile.c_str());
-  SoVRMLGroup *sceneGraphVRML2;
+#if defined(VISP_HAVE_COIN3D) && defined(VISP_BUILD_DEPRECATED_FUNCTIONS)
+/*!
+  \deprecated Use rather vpMbtModel::loadVRMLGroup() and loadModel(const vpMbtModel &, const vpHomogeneousMatrix &).
 
-  if (!ok) {
-    vpERROR_TRACE("can't open file to load model");
-    throw vpException(vpException::fatalError, "can't open file to load model");
-  }
+  Add to the tracker the faces, lines and cylinders of a VRML object Group.
 
-  if (!in.isFileVRML2()) {
-    SoSeparator *sceneGraph = SoDB::readAll(&in);
-    if (sceneGraph == nullptr) { /*return -1;*/
-    }
-    sceneGraph->ref();
+  \param sceneGraphVRML2 : Current node (either Transform, or Group node).
+  \param transform : Transformation matrix for this group.
+  \param idFace : Index of the face.
+*/
+void vpMbTracker::extractGroup(SoVRMLGroup *sceneGraphVRML2, vpHomogeneousMatrix &transform, int &idFace)
+{
+  vpMbtModel model;
+  model.loadVRMLGroup(sceneGraphVRML2, transform, idFace);
+  addModelPrimitives(model, 0);
+}
 
-    SoToVRML2Action tovrml2;
-    tovrml2.apply(sceneGraph);
+/*!
+  \deprecated Use rather vpMbtModel::loadVRMLFaces() and loadModel(const vpMbtModel &, const vpHomogeneousMatrix &).
 
-    sceneGraphVRML2 = tovrml2.getVRML2SceneGraph();
-    sceneGraphVRML2->ref();
-    sceneGraph->unref();
-  }
-  else {
-    sceneGraphVRML2 = SoDB::readAllVRML(&in);
-    if (sceneGraphVRML2 == nullptr) { /*return -1;*/
-    }
-    sceneGraphVRML2->ref();
-  }
+  Add to the tracker the faces of a VRML face set. The faces are initialized
+  with the initFaceFromCorners() method implemented in the child class.
 
-  in.closeFile();
+  \param face_set : Pointer to the face in the vrml format.
+  \param transform : Transformation matrix applied to the face.
+  \param idFace : Face id.
+  \param polygonName: Name of the polygon.
+*/
+void vpMbTracker::extractFaces(SoVRMLIndexedFaceSet *face_set, vpHomogeneousMatrix &transform, int &idFace,
+                               const std::string &polygonName)
+{
+  vpMbtModel model;
+  model.loadVRMLFaces(face_set, transform, idFace, polygonName);
+  addModelPrimitives(model, 0);
+}
 
-  vpHomogeneousMatrix transform;
-  int indexFace = (int)faces.size();
-  extractGroup(sceneGraphVRML2, transform, indexFace);
+/*!
+  \deprecated Use rather vpMbtModel::loadVRMLLines() and loadModel(const vpMbtModel &, const vpHomogeneousMatrix &).
 
-  sceneGraphVRML2->unref();
-#else
-  vpERROR_TRACE("coin not detected with ViSP, cannot load model : %s", modelFile.c_str());
-  throw vpException(vpException::fatalError, "coin not detected with ViSP, cannot load model");
-#endif
+  Add to the tracker the lines of a VRML line set. The lines are initialized
+  with the initFaceFromCorners() method implemented in the child class.
+
+  \param line_set : Pointer to the line in the vrml format.
+  \param idFace : Id of the face.
+  \param polygonName: Name of the polygon.
+*/
+void vpMbTracker::extractLines(SoVRMLIndexedLineSet *line_set, int &idFace, const std::string &polygonName)
+{
+  vpMbtModel model;
+  model.loadVRMLLines(line_set, idFace, polygonName);
+  addModelPrimitives(model, 0);
+}
+
+/*!
+  \deprecated Use rather vpMbtModel::loadVRMLCylinders() and loadModel(const vpMbtModel &, const vpHomogeneousMatrix
+  &).
+
+  Add to the tracker the cylinder of a VRML face set. The cylinder is
+  initialized with the initCylinder() method implemented in the child class.
+
+  \param face_set : Pointer to the cylinder in the vrml format.
+  \param transform : Transformation matrix applied to the cylinder.
+  \param idFace : Id of the face.
+  \param polygonName: Name of the polygon.
+*/
+void vpMbTracker::extractCylinders(SoVRMLIndexedFaceSet *face_set, vpHomogeneousMatrix &transform, int &idFace,
+                                   const std::string &polygonName)
+{
+  vpMbtModel model;
+  model.loadVRMLCylinders(face_set, transform, idFace, polygonName);
+  addModelPrimitives(model, 0);
 }
+#endif
 
 void vpMbTracker::removeComment(std::ifstream &fileId)
 {
@@ -1670,916 +1801,21 @@ std::map<std::string, std::string> vpMbTracker::parseParameters(std::string &end
 void vpMbTracker::loadCAOModel(const std::string &modelFile, std::vector<std::string> &vectorOfModelFilename,
                                int &startIdFace, bool verbose, bool parent, const vpHomogeneousMatrix &odTo)
 {
-  const unsigned int maxDataCAO = 100000; // arbitrary value
-
-  std::ifstream fileId;
-  fileId.exceptions(std::ifstream::failbit | std::ifstream::eofbit);
-  fileId.open(modelFile.c_str(), std::ifstream::in);
-  if (fileId.fail()) {
-    std::cout << "cannot read CAO model file: " << modelFile << std::endl;
-    throw vpException(vpException::ioError, "cannot read CAO model file");
-  }
-
-  if (verbose) {
-    std::cout << "Model file : " << modelFile << std::endl;
-  }
-  vectorOfModelFilename.push_back(modelFile);
-
-  try {
-    char c;
-    // Extraction of the version (remove empty line and commented ones
-    // (comment line begin with the #)).
-    // while ((fileId.get(c) != nullptr) && (c == '#')) fileId.ignore(256, '\n');
-    removeComment(fileId);
-
-    //////////////////////////Read CAO Version (V1, V2,...)//////////////////////////
-    int caoVersion;
-    fileId.get(c);
-    if (c == 'V') {
-      fileId >> caoVersion;
-      fileId.ignore(std::numeric_limits<std::streamsize>::max(), fileId.widen('\n')); // skip the rest of the line
-    }
-    else {
-      std::cout << "in vpMbTracker::loadCAOModel() -> Bad parameter header "
-        "file : use V0, V1, ...";
-      throw vpException(vpException::badValue, "in vpMbTracker::loadCAOModel() -> Bad parameter "
-                                               "header file : use V0, V1, ...");
-    }
-
-    removeComment(fileId);
-
-    //////////////////////////Read the header part if present//////////////////////////
-    std::string line;
-    const std::string prefix_load = "load";
-
-    fileId.get(c);
-    fileId.unget();
-    bool header = false;
-    while (c == 'l' || c == 'L') {
-      getline(fileId, line);
-
-      if (!line.compare(0, prefix_load.size(), prefix_load)) {
-        // remove "load("
-        std::string paramsStr = line.substr(5);
-        // get parameters inside load()
-        paramsStr = paramsStr.substr(0, paramsStr.find_first_of(")"));
-        // split by comma
-        std::vector<std::string> params = vpIoTools::splitChain(paramsStr, ",");
-        // remove whitespaces
-        for (size_t i = 0; i < params.size(); i++) {
-          params[i] = vpIoTools::trim(params[i]);
-        }
-
-        if (!params.empty()) {
-          // Get the loaded model pathname
-          std::string headerPathRead = params[0];
-          headerPathRead = headerPathRead.substr(1);
-          headerPathRead = headerPathRead.substr(0, headerPathRead.find_first_of("\""));
-
-          std::string headerPath = headerPathRead;
-          if (!vpIoTools::isAbsolutePathname(headerPathRead)) {
-            std::string parentDirectory = vpIoTools::getParent(modelFile);
-            headerPath = vpIoTools::createFilePath(parentDirectory, headerPathRead);
-          }
-
-          // Normalize path
-          headerPath = vpIoTools::path(headerPath);
-
-          // Get real path
-          headerPath = vpIoTools::getAbsolutePathname(headerPath);
-
-          vpHomogeneousMatrix oTo_local;
-          vpTranslationVector t;
-          vpThetaUVector tu;
-          for (size_t i = 1; i < params.size(); i++) {
-            std::string param = params[i];
-            {
-              const std::string prefix = "t=[";
-              if (!param.compare(0, prefix.size(), prefix)) {
-                param = param.substr(prefix.size());
-                param = param.substr(0, param.find_first_of("]"));
-
-                std::vector<std::string> values = vpIoTools::splitChain(param, ";");
-                if (values.size() == 3) {
-                  t[0] = atof(values[0].c_str());
-                  t[1] = atof(values[1].c_str());
-                  t[2] = atof(values[2].c_str());
-                }
-              }
-            }
-            {
-              const std::string prefix = "tu=[";
-              if (!param.compare(0, prefix.size(), prefix)) {
-                param = param.substr(prefix.size());
-                param = param.substr(0, param.find_first_of("]"));
-
-                std::vector<std::string> values = vpIoTools::splitChain(param, ";");
-                if (values.size() == 3) {
-                  for (size_t j = 0; j < values.size(); j++) {
-                    std::string value = values[j];
-                    bool radian = true;
-                    size_t unitPos = value.find("deg");
-                    if (unitPos != std::string::npos) {
-                      value = value.substr(0, unitPos);
-                      radian = false;
-                    }
-
-                    unitPos = value.find("rad");
-                    if (unitPos != std::string::npos) {
-                      value = value.substr(0, unitPos);
-                    }
-                    tu[static_cast<unsigned int>(j)] = !radian ? vpMath::rad(atof(value.c_str())) : atof(value.c_str());
-                  }
-                }
-              }
-            }
-          }
-          oTo_local.buildFrom(t, tu);
-
-          bool cyclic = false;
-          for (std::vector<std::string>::const_iterator it = vectorOfModelFilename.begin();
-               it != vectorOfModelFilename.end() && !cyclic; ++it) {
-            if (headerPath == *it) {
-              cyclic = true;
-            }
-          }
-
-          if (!cyclic) {
-            if (vpIoTools::checkFilename(headerPath)) {
-              header = true;
-              loadCAOModel(headerPath, vectorOfModelFilename, startIdFace, verbose, false, odTo * oTo_local);
-            }
-            else {
-              throw vpException(vpException::ioError, "file cannot be open");
-            }
-          }
-          else {
-            std::cout << "WARNING Cyclic dependency detected with file " << headerPath << " declared in " << modelFile
-              << std::endl;
-          }
-        }
-      }
-
-      removeComment(fileId);
-      fileId.get(c);
-      fileId.unget();
-    }
-
-    //////////////////////////Read the point declaration part//////////////////////////
-    unsigned int caoNbrPoint;
-    fileId >> caoNbrPoint;
-    fileId.ignore(std::numeric_limits<std::streamsize>::max(), fileId.widen('\n')); // skip the rest of the line
-
-    nbPoints += caoNbrPoint;
-    if (verbose || (parent && !header)) {
-#if defined(VISP_HAVE_THREADS)
-      std::lock_guard<std::mutex> lock(g_mutex_cout);
-#endif
-      std::cout << "> " << caoNbrPoint << " points" << std::endl;
-    }
-
-    if (caoNbrPoint > maxDataCAO) {
-      throw vpException(vpException::badValue, "Exceed the max number of points in the CAO model.");
-    }
-
-    if (caoNbrPoint == 0 && !header) {
-      throw vpException(vpException::badValue, "in vpMbTracker::loadCAOModel() -> no points are defined");
-    }
-    std::vector<vpPoint> caoPoints(caoNbrPoint);
-
-    for (unsigned int k = 0; k < caoNbrPoint; k++) {
-      removeComment(fileId);
-
-      vpColVector pt_3d(4, 1.0);
-      fileId >> pt_3d[0];
-      fileId >> pt_3d[1];
-      fileId >> pt_3d[2];
-
-      if (caoVersion == 2) {
-        // glob values (not used in MBT but for matching)
-        int i, j; // image coordinate (used for matching)
-        fileId >> i;
-        fileId >> j;
-      }
+  vpMbtModel model;
+  model.loadCAO(modelFile, vectorOfModelFilename, verbose, parent, odTo);
 
-      fileId.ignore(std::numeric_limits<std::streamsize>::max(), fileId.widen('\n')); // skip the rest of the line
+  nbPoints += model.getNbPoints();
+  nbLines += model.getNbLines();
+  nbPolygonLines += model.getNbPolygonLines();
+  nbPolygonPoints += model.getNbPolygonPoints();
+  nbCylinders += model.getNbCylinders();
+  nbCircles += model.getNbCircles();
 
-      vpColVector pt_3d_tf = odTo * pt_3d;
-      caoPoints[k].setWorldCoordinates(pt_3d_tf[0], pt_3d_tf[1], pt_3d_tf[2]);
-    }
-
-    removeComment(fileId);
-
-    //////////////////////////Read the segment declaration part//////////////////////////
-    // Store in a map the potential segments to add
-    std::map<std::pair<unsigned int, unsigned int>, SegmentInfo> segmentTemporaryMap;
-    unsigned int caoNbrLine;
-    fileId >> caoNbrLine;
-    fileId.ignore(std::numeric_limits<std::streamsize>::max(), fileId.widen('\n')); // skip the rest of the line
-
-    nbLines += caoNbrLine;
-    std::vector<unsigned int> caoLinePoints;
-    if (verbose || (parent && !header)) {
-#if defined(VISP_HAVE_THREADS)
-      std::lock_guard<std::mutex> lock(g_mutex_cout);
-#endif
-      std::cout << "> " << caoNbrLine << " lines" << std::endl;
-    }
-
-    if (caoNbrLine > maxDataCAO) {
-      throw vpException(vpException::badValue, "Exceed the max number of lines in the CAO model.");
-    }
-
-    if (caoNbrLine > 0)
-      caoLinePoints.resize(2 * caoNbrLine);
-
-    unsigned int index1, index2;
-    // Initialization of idFace with startIdFace for dealing with recursive
-    // load in header
-    int idFace = startIdFace;
-
-    for (unsigned int k = 0; k < caoNbrLine; k++) {
-      removeComment(fileId);
-
-      fileId >> index1;
-      fileId >> index2;
-
-      //////////////////////////Read the parameter value if present//////////////////////////
-      // Get the end of the line
-      std::string endLine = "";
-      if (safeGetline(fileId, endLine).good()) {
-        std::map<std::string, std::string> mapOfParams = parseParameters(endLine);
-
-        std::string segmentName = "";
-        double minLineLengthThresh = !applyLodSettingInConfig ? minLineLengthThresholdGeneral : 50.0;
-        bool useLod = !applyLodSettingInConfig ? useLodGeneral : false;
-        if (mapOfParams.find("name") != mapOfParams.end()) {
-          segmentName = mapOfParams["name"];
-        }
-        if (mapOfParams.find("minLineLengthThreshold") != mapOfParams.end()) {
-          minLineLengthThresh = std::atof(mapOfParams["minLineLengthThreshold"].c_str());
-        }
-        if (mapOfParams.find("useLod") != mapOfParams.end()) {
-          useLod = vpIoTools::parseBoolean(mapOfParams["useLod"]);
-        }
-
-        SegmentInfo segmentInfo;
-        segmentInfo.name = segmentName;
-        segmentInfo.useLod = useLod;
-        segmentInfo.minLineLengthThresh = minLineLengthThresh;
-
-        caoLinePoints[2 * k] = index1;
-        caoLinePoints[2 * k + 1] = index2;
-
-        if (index1 < caoNbrPoint && index2 < caoNbrPoint) {
-          std::vector<vpPoint> extremities;
-          extremities.push_back(caoPoints[index1]);
-          extremities.push_back(caoPoints[index2]);
-          segmentInfo.extremities = extremities;
-
-          std::pair<unsigned int, unsigned int> key(index1, index2);
-
-          segmentTemporaryMap[key] = segmentInfo;
-        }
-        else {
-          vpTRACE(" line %d has wrong coordinates.", k);
-        }
-      }
-    }
-
-    removeComment(fileId);
-
-    //////////////////////////Read the face segment declaration part//////////////////////////
-    /* Load polygon from the lines extracted earlier (the first point of the
-     * line is used)*/
-    // Store in a vector the indexes of the segments added in the face segment
-    // case
-    std::vector<std::pair<unsigned int, unsigned int> > faceSegmentKeyVector;
-    unsigned int caoNbrPolygonLine;
-    fileId >> caoNbrPolygonLine;
-    fileId.ignore(std::numeric_limits<std::streamsize>::max(), fileId.widen('\n')); // skip the rest of the line
-
-    nbPolygonLines += caoNbrPolygonLine;
-    if (verbose || (parent && !header)) {
-#if defined(VISP_HAVE_THREADS)
-      std::lock_guard<std::mutex> lock(g_mutex_cout);
-#endif
-      std::cout << "> " << caoNbrPolygonLine << " polygon lines" << std::endl;
-    }
-
-    if (caoNbrPolygonLine > maxDataCAO) {
-      throw vpException(vpException::badValue, "Exceed the max number of polygon lines.");
-    }
-
-    unsigned int index;
-    for (unsigned int k = 0; k < caoNbrPolygonLine; k++) {
-      removeComment(fileId);
-
-      unsigned int nbLinePol;
-      fileId >> nbLinePol;
-      std::vector<vpPoint> corners;
-      if (nbLinePol > maxDataCAO) {
-        throw vpException(vpException::badValue, "Exceed the max number of lines.");
-      }
-
-      for (unsigned int n = 0; n < nbLinePol; n++) {
-        fileId >> index;
-
-        if (index >= caoNbrLine) {
-          throw vpException(vpException::badValue, "Exceed the max number of lines.");
-        }
-        corners.push_back(caoPoints[caoLinePoints[2 * index]]);
-        corners.push_back(caoPoints[caoLinePoints[2 * index + 1]]);
-
-        std::pair<unsigned int, unsigned int> key(caoLinePoints[2 * index], caoLinePoints[2 * index + 1]);
-        faceSegmentKeyVector.push_back(key);
-      }
-
-      //////////////////////////Read the parameter value if present//////////////////////////
-      // Get the end of the line
-      std::string endLine = "";
-      if (safeGetline(fileId, endLine).good()) {
-        std::map<std::string, std::string> mapOfParams = parseParameters(endLine);
-
-        std::string polygonName = "";
-        bool useLod = !applyLodSettingInConfig ? useLodGeneral : false;
-        double minPolygonAreaThreshold = !applyLodSettingInConfig ? minPolygonAreaThresholdGeneral : 2500.0;
-        if (mapOfParams.find("name") != mapOfParams.end()) {
-          polygonName = mapOfParams["name"];
-        }
-        if (mapOfParams.find("minPolygonAreaThreshold") != mapOfParams.end()) {
-          minPolygonAreaThreshold = std::atof(mapOfParams["minPolygonAreaThreshold"].c_str());
-        }
-        if (mapOfParams.find("useLod") != mapOfParams.end()) {
-          useLod = vpIoTools::parseBoolean(mapOfParams["useLod"]);
-        }
-
-        addPolygon(corners, idFace, polygonName, useLod, minPolygonAreaThreshold, minLineLengthThresholdGeneral);
-        initFaceFromLines(*(faces.getPolygon().back())); // Init from the last polygon that was added
-
-        addProjectionErrorPolygon(corners, idFace++, polygonName, useLod, minPolygonAreaThreshold,
-                                  minLineLengthThresholdGeneral);
-        initProjectionErrorFaceFromLines(*(m_projectionErrorFaces.getPolygon().back()));
-      }
-    }
-
-    // Add the segments which were not already added in the face segment case
-    for (std::map<std::pair<unsigned int, unsigned int>, SegmentInfo>::const_iterator it = segmentTemporaryMap.begin();
-         it != segmentTemporaryMap.end(); ++it) {
-      if (std::find(faceSegmentKeyVector.begin(), faceSegmentKeyVector.end(), it->first) ==
-          faceSegmentKeyVector.end()) {
-        addPolygon(it->second.extremities, idFace, it->second.name, it->second.useLod, minPolygonAreaThresholdGeneral,
-                   it->second.minLineLengthThresh);
-        initFaceFromCorners(*(faces.getPolygon().back())); // Init from the last polygon that was added
-
-        addProjectionErrorPolygon(it->second.extremities, idFace++, it->second.name, it->second.useLod,
-                                  minPolygonAreaThresholdGeneral, it->second.minLineLengthThresh);
-        initProjectionErrorFaceFromCorners(*(m_projectionErrorFaces.getPolygon().back()));
-      }
-    }
-
-    removeComment(fileId);
-
-    //////////////////////////Read the face point declaration part//////////////////////////
-    /* Extract the polygon using the point coordinates (top of the file) */
-    unsigned int caoNbrPolygonPoint;
-    fileId >> caoNbrPolygonPoint;
-    fileId.ignore(std::numeric_limits<std::streamsize>::max(), fileId.widen('\n')); // skip the rest of the line
-
-    nbPolygonPoints += caoNbrPolygonPoint;
-    if (verbose || (parent && !header)) {
-#if defined(VISP_HAVE_THREADS)
-      std::lock_guard<std::mutex> lock(g_mutex_cout);
-#endif
-      std::cout << "> " << caoNbrPolygonPoint << " polygon points" << std::endl;
-    }
-
-    if (caoNbrPolygonPoint > maxDataCAO) {
-      throw vpException(vpException::badValue, "Exceed the max number of polygon point.");
-    }
-
-    for (unsigned int k = 0; k < caoNbrPolygonPoint; k++) {
-      removeComment(fileId);
-
-      unsigned int nbPointPol;
-      fileId >> nbPointPol;
-      if (nbPointPol > maxDataCAO) {
-        throw vpException(vpException::badValue, "Exceed the max number of points.");
-      }
-      std::vector<vpPoint> corners;
-      for (unsigned int n = 0; n < nbPointPol; n++) {
-        fileId >> index;
-        if (index > caoNbrPoint - 1) {
-          throw vpException(vpException::badValue, "Exceed the max number of points.");
-        }
-        corners.push_back(caoPoints[index]);
-      }
-
-      //////////////////////////Read the parameter value if present//////////////////////////
-      // Get the end of the line
-      std::string endLine = "";
-      if (safeGetline(fileId, endLine).good()) {
-        std::map<std::string, std::string> mapOfParams = parseParameters(endLine);
-
-        std::string polygonName = "";
-        bool useLod = !applyLodSettingInConfig ? useLodGeneral : false;
-        double minPolygonAreaThreshold = !applyLodSettingInConfig ? minPolygonAreaThresholdGeneral : 2500.0;
-        if (mapOfParams.find("name") != mapOfParams.end()) {
-          polygonName = mapOfParams["name"];
-        }
-        if (mapOfParams.find("minPolygonAreaThreshold") != mapOfParams.end()) {
-          minPolygonAreaThreshold = std::atof(mapOfParams["minPolygonAreaThreshold"].c_str());
-        }
-        if (mapOfParams.find("useLod") != mapOfParams.end()) {
-          useLod = vpIoTools::parseBoolean(mapOfParams["useLod"]);
-        }
-
-        addPolygon(corners, idFace, polygonName, useLod, minPolygonAreaThreshold, minLineLengthThresholdGeneral);
-        initFaceFromCorners(*(faces.getPolygon().back())); // Init from the last polygon that was added
-
-        addProjectionErrorPolygon(corners, idFace++, polygonName, useLod, minPolygonAreaThreshold,
-                                  minLineLengthThresholdGeneral);
-        initProjectionErrorFaceFromCorners(*(m_projectionErrorFaces.getPolygon().back()));
-      }
-    }
-
-    //////////////////////////Read the cylinder declaration part//////////////////////////
-    unsigned int caoNbCylinder;
-    try {
-      removeComment(fileId);
-
-      if (fileId.eof()) { // check if not at the end of the file (for old
-                          // style files)
-        return;
-      }
-
-      /* Extract the cylinders */
-      fileId >> caoNbCylinder;
-      fileId.ignore(std::numeric_limits<std::streamsize>::max(), fileId.widen('\n')); // skip the rest of the line
-
-      nbCylinders += caoNbCylinder;
-      if (verbose || (parent && !header)) {
-#if defined(VISP_HAVE_THREADS)
-        std::lock_guard<std::mutex> lock(g_mutex_cout);
-#endif
-        std::cout << "> " << caoNbCylinder << " cylinders" << std::endl;
-      }
-
-      if (caoNbCylinder > maxDataCAO) {
-        throw vpException(vpException::badValue, "Exceed the max number of cylinders.");
-      }
-
-      for (unsigned int k = 0; k < caoNbCylinder; ++k) {
-        removeComment(fileId);
-
-        double radius;
-        unsigned int indexP1, indexP2;
-        fileId >> indexP1;
-        fileId >> indexP2;
-        fileId >> radius;
-
-        //////////////////////////Read the parameter value if present//////////////////////////
-        // Get the end of the line
-        std::string endLine = "";
-        if (safeGetline(fileId, endLine).good()) {
-          std::map<std::string, std::string> mapOfParams = parseParameters(endLine);
-
-          std::string polygonName = "";
-          bool useLod = !applyLodSettingInConfig ? useLodGeneral : false;
-          double minLineLengthThreshold = !applyLodSettingInConfig ? minLineLengthThresholdGeneral : 50.0;
-          if (mapOfParams.find("name") != mapOfParams.end()) {
-            polygonName = mapOfParams["name"];
-          }
-          if (mapOfParams.find("minLineLengthThreshold") != mapOfParams.end()) {
-            minLineLengthThreshold = std::atof(mapOfParams["minLineLengthThreshold"].c_str());
-          }
-          if (mapOfParams.find("useLod") != mapOfParams.end()) {
-            useLod = vpIoTools::parseBoolean(mapOfParams["useLod"]);
-          }
-
-          int idRevolutionAxis = idFace;
-          addPolygon(caoPoints[indexP1], caoPoints[indexP2], idFace, polygonName, useLod, minLineLengthThreshold);
-
-          addProjectionErrorPolygon(caoPoints[indexP1], caoPoints[indexP2], idFace++, polygonName, useLod,
-                                    minLineLengthThreshold);
-
-          std::vector<std::vector<vpPoint> > listFaces;
-          createCylinderBBox(caoPoints[indexP1], caoPoints[indexP2], radius, listFaces);
-          addPolygon(listFaces, idFace, polygonName, useLod, minLineLengthThreshold);
-
-          initCylinder(caoPoints[indexP1], caoPoints[indexP2], radius, idRevolutionAxis, polygonName);
-
-          addProjectionErrorPolygon(listFaces, idFace, polygonName, useLod, minLineLengthThreshold);
-          initProjectionErrorCylinder(caoPoints[indexP1], caoPoints[indexP2], radius, idRevolutionAxis, polygonName);
-
-          idFace += 4;
-        }
-      }
-
-    }
-    catch (const std::exception &e) {
-      std::cerr << "Cannot get the number of cylinders. Defaulting to zero." << std::endl;
-      std::cerr << "Exception: " << e.what() << std::endl;
-      caoNbCylinder = 0;
-    }
-
-    //////////////////////////Read the circle declaration part//////////////////////////
-    unsigned int caoNbCircle;
-    try {
-      removeComment(fileId);
-
-      if (fileId.eof()) { // check if not at the end of the file (for old
-                          // style files)
-        return;
-      }
-
-      // To handle CAO model file without no new line at the end, we check if the first char is zero or not
-      // Otherwise "fileId >> caoNbCircle;" gives:
-      //   "Cannot get the number of circles. Defaulting to zero."
-      //   "Exception: basic_ios::clear: iostream error"
-      char c_circle;
-      fileId.get(c_circle);
-      int nb_circles = c_circle - '0';
-      if (nb_circles > 0) {
-        fileId.unget();
-
-        /* Extract the circles */
-        fileId >> caoNbCircle;
-        fileId.ignore(std::numeric_limits<std::streamsize>::max(), fileId.widen('\n')); // skip the rest of the line
-
-        nbCircles += caoNbCircle;
-        if (verbose || (parent && !header)) {
-#if defined(VISP_HAVE_THREADS)
-          std::lock_guard<std::mutex> lock(g_mutex_cout);
-#endif
-          std::cout << "> " << caoNbCircle << " circles" << std::endl;
-        }
-
-        if (caoNbCircle > maxDataCAO) {
-          throw vpException(vpException::badValue, "Exceed the max number of cicles.");
-        }
-
-        for (unsigned int k = 0; k < caoNbCircle; ++k) {
-          removeComment(fileId);
-
-          double radius;
-          unsigned int indexP1, indexP2, indexP3;
-          fileId >> radius;
-          fileId >> indexP1;
-          fileId >> indexP2;
-          fileId >> indexP3;
-
-          //////////////////////////Read the parameter value if present//////////////////////////
-          // Get the end of the line
-          std::string endLine = "";
-          if (safeGetline(fileId, endLine).good()) {
-            std::map<std::string, std::string> mapOfParams = parseParameters(endLine);
-
-            std::string polygonName = "";
-            bool useLod = !applyLodSettingInConfig ? useLodGeneral : false;
-            double minPolygonAreaThreshold = !applyLodSettingInConfig ? minPolygonAreaThresholdGeneral : 2500.0;
-            if (mapOfParams.find("name") != mapOfParams.end()) {
-              polygonName = mapOfParams["name"];
-            }
-            if (mapOfParams.find("minPolygonAreaThreshold") != mapOfParams.end()) {
-              minPolygonAreaThreshold = std::atof(mapOfParams["minPolygonAreaThreshold"].c_str());
-            }
-            if (mapOfParams.find("useLod") != mapOfParams.end()) {
-              useLod = vpIoTools::parseBoolean(mapOfParams["useLod"]);
-            }
-
-            addPolygon(caoPoints[indexP1], caoPoints[indexP2], caoPoints[indexP3], radius, idFace, polygonName, useLod,
-                      minPolygonAreaThreshold);
-
-            initCircle(caoPoints[indexP1], caoPoints[indexP2], caoPoints[indexP3], radius, idFace, polygonName);
-
-            addProjectionErrorPolygon(caoPoints[indexP1], caoPoints[indexP2], caoPoints[indexP3], radius, idFace,
-                                      polygonName, useLod, minPolygonAreaThreshold);
-            initProjectionErrorCircle(caoPoints[indexP1], caoPoints[indexP2], caoPoints[indexP3], radius, idFace++,
-                                      polygonName);
-          }
-        }
-      }
-    }
-    catch (const std::exception &e) {
-      std::cerr << "Cannot get the number of circles. Defaulting to zero." << std::endl;
-      std::cerr << "Exception: " << e.what() << std::endl;
-      caoNbCircle = 0;
-    }
-
-    startIdFace = idFace;
-
-    if (header && parent) {
-      if (verbose) {
-#if defined(VISP_HAVE_THREADS)
-        std::lock_guard<std::mutex> lock(g_mutex_cout);
-#endif
-        std::cout << "Global information for " << vpIoTools::getName(modelFile) << " :" << std::endl;
-        std::cout << "Total nb of points : " << nbPoints << std::endl;
-        std::cout << "Total nb of lines : " << nbLines << std::endl;
-        std::cout << "Total nb of polygon lines : " << nbPolygonLines << std::endl;
-        std::cout << "Total nb of polygon points : " << nbPolygonPoints << std::endl;
-        std::cout << "Total nb of cylinders : " << nbCylinders << std::endl;
-        std::cout << "Total nb of circles : " << nbCircles << std::endl;
-      }
-      else {
-#if defined(VISP_HAVE_THREADS)
-        std::lock_guard<std::mutex> lock(g_mutex_cout);
-#endif
-        std::cout << "> " << nbPoints << " points" << std::endl;
-        std::cout << "> " << nbLines << " lines" << std::endl;
-        std::cout << "> " << nbPolygonLines << " polygon lines" << std::endl;
-        std::cout << "> " << nbPolygonPoints << " polygon points" << std::endl;
-        std::cout << "> " << nbCylinders << " cylinders" << std::endl;
-        std::cout << "> " << nbCircles << " circles" << std::endl;
-      }
-    }
-
-    // Go up: remove current model
-    vectorOfModelFilename.pop_back();
-  }
-  catch (const std::exception &e) {
-    std::cerr << "Cannot read line!" << std::endl;
-    std::cerr << "Exception: " << e.what() << std::endl;
-    throw vpException(vpException::ioError, "cannot read line");
-  }
-}
-
-#ifdef VISP_HAVE_COIN3D
-/*!
-  Extract a VRML object Group.
-
-  \param sceneGraphVRML2 : Current node (either Transform, or Group node).
-  \param transform : Transformation matrix for this group.
-  \param idFace : Index of the face.
-*/
-void vpMbTracker::extractGroup(SoVRMLGroup *sceneGraphVRML2, vpHomogeneousMatrix &transform, int &idFace)
-{
-  vpHomogeneousMatrix transformCur;
-  SoVRMLTransform *sceneGraphVRML2Trasnform = dynamic_cast<SoVRMLTransform *>(sceneGraphVRML2);
-  if (sceneGraphVRML2Trasnform) {
-    float rx, ry, rz, rw;
-    sceneGraphVRML2Trasnform->rotation.getValue().getValue(rx, ry, rz, rw);
-    vpRotationMatrix rotMat(vpQuaternionVector(rx, ry, rz, rw));
-    //     std::cout << "Rotation: " << rx << " " << ry << " " << rz << " " <<
-    //     rw << std::endl;
-
-    float tx, ty, tz;
-    tx = sceneGraphVRML2Trasnform->translation.getValue()[0];
-    ty = sceneGraphVRML2Trasnform->translation.getValue()[1];
-    tz = sceneGraphVRML2Trasnform->translation.getValue()[2];
-    vpTranslationVector transVec(tx, ty, tz);
-    //     std::cout << "Translation: " << tx << " " << ty << " " << tz <<
-    //     std::endl;
-
-    float sx, sy, sz;
-    sx = sceneGraphVRML2Trasnform->scale.getValue()[0];
-    sy = sceneGraphVRML2Trasnform->scale.getValue()[1];
-    sz = sceneGraphVRML2Trasnform->scale.getValue()[2];
-    //     std::cout << "Scale: " << sx << " " << sy << " " << sz <<
-    //     std::endl;
-
-    for (unsigned int i = 0; i < 3; i++)
-      rotMat[0][i] *= sx;
-    for (unsigned int i = 0; i < 3; i++)
-      rotMat[1][i] *= sy;
-    for (unsigned int i = 0; i < 3; i++)
-      rotMat[2][i] *= sz;
-
-    transformCur = vpHomogeneousMatrix(transVec, rotMat);
-    transform = transform * transformCur;
-  }
-
-  int nbShapes = sceneGraphVRML2->getNumChildren();
-  //   std::cout << sceneGraphVRML2->getTypeId().getName().getString() <<
-  //   std::endl; std::cout << "Nb object in VRML : " << nbShapes <<
-  //   std::endl;
-
-  SoNode *child;
-
-  for (int i = 0; i < nbShapes; i++) {
-    vpHomogeneousMatrix transform_recursive(transform);
-    child = sceneGraphVRML2->getChild(i);
-
-    if (child->getTypeId() == SoVRMLGroup::getClassTypeId()) {
-      extractGroup((SoVRMLGroup *)child, transform_recursive, idFace);
-    }
-
-    if (child->getTypeId() == SoVRMLTransform::getClassTypeId()) {
-      extractGroup((SoVRMLTransform *)child, transform_recursive, idFace);
-    }
-
-    if (child->getTypeId() == SoVRMLShape::getClassTypeId()) {
-      SoChildList *child2list = child->getChildren();
-      std::string name = child->getName().getString();
-
-      for (int j = 0; j < child2list->getLength(); j++) {
-        if (((SoNode *)child2list->get(j))->getTypeId() == SoVRMLIndexedFaceSet::getClassTypeId()) {
-          SoVRMLIndexedFaceSet *face_set;
-          face_set = (SoVRMLIndexedFaceSet *)child2list->get(j);
-          if (!strncmp(face_set->getName().getString(), "cyl", 3)) {
-            extractCylinders(face_set, transform, idFace, name);
-          }
-          else {
-            extractFaces(face_set, transform, idFace, name);
-          }
-        }
-        if (((SoNode *)child2list->get(j))->getTypeId() == SoVRMLIndexedLineSet::getClassTypeId()) {
-          SoVRMLIndexedLineSet *line_set;
-          line_set = (SoVRMLIndexedLineSet *)child2list->get(j);
-          extractLines(line_set, idFace, name);
-        }
-      }
-    }
-  }
-}
-
-/*!
-  Extract a face of the object to track from the VMRL model. This method calls
-  the initFaceFromCorners() method implemented in the child class.
-
-  \param face_set : Pointer to the face in the vrml format.
-  \param transform : Transformation matrix applied to the face.
-  \param idFace : Face id.
-  \param polygonName: Name of the polygon.
-*/
-void vpMbTracker::extractFaces(SoVRMLIndexedFaceSet *face_set, vpHomogeneousMatrix &transform, int &idFace,
-                               const std::string &polygonName)
-{
-  std::vector<vpPoint> corners;
-
-  //  SoMFInt32 indexList = _face_set->coordIndex;
-  //  int indexListSize = indexList.getNum();
-  int indexListSize = face_set->coordIndex.getNum();
-
-  vpColVector pointTransformed(4);
-  vpPoint pt;
-  SoVRMLCoordinate *coord;
-
-  for (int i = 0; i < indexListSize; i++) {
-    if (face_set->coordIndex[i] == -1) {
-      if (corners.size() > 1) {
-        addPolygon(corners, idFace, polygonName);
-        initFaceFromCorners(*(faces.getPolygon().back())); // Init from the last polygon that was added
-
-        addProjectionErrorPolygon(corners, idFace++, polygonName);
-        initProjectionErrorFaceFromCorners(*(m_projectionErrorFaces.getPolygon().back()));
-        corners.resize(0);
-      }
-    }
-    else {
-      coord = (SoVRMLCoordinate *)(face_set->coord.getValue());
-      int index = face_set->coordIndex[i];
-      pointTransformed[0] = coord->point[index].getValue()[0];
-      pointTransformed[1] = coord->point[index].getValue()[1];
-      pointTransformed[2] = coord->point[index].getValue()[2];
-      pointTransformed[3] = 1.0;
-
-      pointTransformed = transform * pointTransformed;
-
-      pt.setWorldCoordinates(pointTransformed[0], pointTransformed[1], pointTransformed[2]);
-      corners.push_back(pt);
-    }
-  }
-}
-
-/*!
-  Extract a cylinder  to track from the VMRL model. This method calls
-  the initCylinder() method implemented in the child class.
-
-  \warning This method extract cylinder described using an indexed face set
-  not a cylinder set since software such as AC3D or blender export a cylinder
-  using this data type. the object name is used, if it begins with "cyl" then
-  this method is called otherwise the extractFaces() is used.
-
-  \param face_set : Pointer to the cylinder in the vrml format.
-  \param transform : Transformation matrix applied to the cylinder.
-  \param idFace : Id of the face.
-  \param polygonName: Name of the polygon.
-*/
-void vpMbTracker::extractCylinders(SoVRMLIndexedFaceSet *face_set, vpHomogeneousMatrix &transform, int &idFace,
-                                   const std::string &polygonName)
-{
-  std::vector<vpPoint> corners_c1, corners_c2; // points belonging to the
-                                               // first circle and to the
-                                               // second one.
-  SoVRMLCoordinate *coords = (SoVRMLCoordinate *)face_set->coord.getValue();
-
-  unsigned int indexListSize = (unsigned int)coords->point.getNum();
-
-  if (indexListSize % 2 == 1) {
-    std::cout << "Not an even number of points when extracting a cylinder." << std::endl;
-    throw vpException(vpException::dimensionError, "Not an even number of points when extracting a cylinder.");
-  }
-  corners_c1.resize(indexListSize / 2);
-  corners_c2.resize(indexListSize / 2);
-  vpColVector pointTransformed(4);
-  vpPoint pt;
-
-  // extract all points and fill the two sets.
-
-  for (int i = 0; i < coords->point.getNum(); ++i) {
-    pointTransformed[0] = coords->point[i].getValue()[0];
-    pointTransformed[1] = coords->point[i].getValue()[1];
-    pointTransformed[2] = coords->point[i].getValue()[2];
-    pointTransformed[3] = 1.0;
-
-    pointTransformed = transform * pointTransformed;
-
-    pt.setWorldCoordinates(pointTransformed[0], pointTransformed[1], pointTransformed[2]);
-
-    if (i < (int)corners_c1.size()) {
-      corners_c1[(unsigned int)i] = pt;
-    }
-    else {
-      corners_c2[(unsigned int)i - corners_c1.size()] = pt;
-    }
-  }
-
-  vpPoint p1 = getGravityCenter(corners_c1);
-  vpPoint p2 = getGravityCenter(corners_c2);
-
-  vpColVector dist(3);
-  dist[0] = p1.get_oX() - corners_c1[0].get_oX();
-  dist[1] = p1.get_oY() - corners_c1[0].get_oY();
-  dist[2] = p1.get_oZ() - corners_c1[0].get_oZ();
-  double radius_c1 = sqrt(dist.sumSquare());
-  dist[0] = p2.get_oX() - corners_c2[0].get_oX();
-  dist[1] = p2.get_oY() - corners_c2[0].get_oY();
-  dist[2] = p2.get_oZ() - corners_c2[0].get_oZ();
-  double radius_c2 = sqrt(dist.sumSquare());
-
-  if (std::fabs(radius_c1 - radius_c2) >
-      (std::numeric_limits<double>::epsilon() * vpMath::maximum(radius_c1, radius_c2))) {
-    std::cout << "Radius from the two circles of the cylinders are different." << std::endl;
-    throw vpException(vpException::badValue, "Radius from the two circles of the cylinders are different.");
-  }
-
-  // addPolygon(p1, p2, idFace, polygonName);
-  // initCylinder(p1, p2, radius_c1, idFace++);
-
-  int idRevolutionAxis = idFace;
-  addPolygon(p1, p2, idFace, polygonName);
-
-  addProjectionErrorPolygon(p1, p2, idFace++, polygonName);
-
-  std::vector<std::vector<vpPoint> > listFaces;
-  createCylinderBBox(p1, p2, radius_c1, listFaces);
-  addPolygon(listFaces, idFace, polygonName);
-
-  initCylinder(p1, p2, radius_c1, idRevolutionAxis, polygonName);
-
-  addProjectionErrorPolygon(listFaces, idFace, polygonName);
-  initProjectionErrorCylinder(p1, p2, radius_c1, idRevolutionAxis, polygonName);
-
-  idFace += 4;
-}
-
-/*!
-  Extract a line of the object to track from the VMRL model. This method calls
-  the initFaceFromCorners() method implemented in the child class.
-
-  \param line_set : Pointer to the line in the vrml format.
-  \param idFace : Id of the face.
-  \param polygonName: Name of the polygon.
-*/
-void vpMbTracker::extractLines(SoVRMLIndexedLineSet *line_set, int &idFace, const std::string &polygonName)
-{
-  std::vector<vpPoint> corners;
-  corners.resize(0);
-
-  int indexListSize = line_set->coordIndex.getNum();
-
-  SbVec3f point(0, 0, 0);
-  vpPoint pt;
-  SoVRMLCoordinate *coord;
-
-  for (int i = 0; i < indexListSize; i++) {
-    if (line_set->coordIndex[i] == -1) {
-      if (corners.size() > 1) {
-        addPolygon(corners, idFace, polygonName);
-        initFaceFromCorners(*(faces.getPolygon().back())); // Init from the last polygon that was added
-
-        addProjectionErrorPolygon(corners, idFace++, polygonName);
-        initProjectionErrorFaceFromCorners(*(m_projectionErrorFaces.getPolygon().back()));
-        corners.resize(0);
-      }
-    }
-    else {
-      coord = (SoVRMLCoordinate *)(line_set->coord.getValue());
-      int index = line_set->coordIndex[i];
-      point[0] = coord->point[index].getValue()[0];
-      point[1] = coord->point[index].getValue()[1];
-      point[2] = coord->point[index].getValue()[2];
-
-      pt.setWorldCoordinates(point[0], point[1], point[2]);
-      corners.push_back(pt);
-    }
-  }
+  addModelPrimitives(model, startIdFace);
+  startIdFace += model.getNbFaceIds();
+  m_model = model;
 }
 
-#endif // VISP_HAVE_COIN3D
-
 /*!
   Compute the center of gravity of a set of point. This is used in the
   cylinder extraction to find the center of the circles.
@@ -3342,8 +2578,11 @@ void vpMbTracker::addProjectionErrorLine(vpPoint &P1, vpPoint &P2, int polygon,
   bool already_here = false;
   vpMbtDistanceLine *l;
 
-  for (std::vector<vpMbtDistanceLine *>::const_iterator it = m_projectionErrorLines.begin();
-       it != m_projectionErrorLines.end(); ++it) {
+  // Only the lines whose extremities are close to P1 and P2 are compared
+  std::vector<vpMbtDistanceLine *> candidates;
+  m_projectionErrorLinesIndex.update(m_projectionErrorLines);
+  m_projectionErrorLinesIndex.find(P1, P2, candidates);
+  for (std::vector<vpMbtDistanceLine *>::const_iterator it = candidates.begin(); it != candidates.end(); ++it) {
     l = *it;
     if ((samePoint(*(l->p1), P1) && samePoint(*(l->p2), P2)) || (samePoint(*(l->p1), P2) && samePoint(*(l->p2), P1))) {
       already_here = true;
@@ -3375,6 +2614,7 @@ void vpMbTracker::addProjectionErrorLine(vpPoint &P1, vpPoint &P2, int polygon,
       l->getPolygon().setFarClippingDistance(distFarClip);
 
     m_projectionErrorLines.push_back(l);
+    m_projectionErrorLinesIndex.insert(l);
   }
 }
 
@@ -0,0 +1,534 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2024 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Bounding volume hierarchy over the polygons of the model used by the
+ * model-based tracker.
+ */
+
+/*!
+ * \file vpMbtBoundingVolumeHierarchy.cpp
+ * \brief Bounding volume hierarchy over the polygons of the model used by the
+ * model-based tracker.
+ */
+
+#include <visp3/mbt/vpMbtBoundingVolumeHierarchy.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <visp3/core/vpPixelMeterConversion.h>
+
+BEGIN_VISP_NAMESPACE
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace
+{
+//! Maximum number of faces in a leaf
+const unsigned int maxLeafSize = 4;
+//! Angular margin in radian that absorbs the difference between a normal computed in the object frame and the same
+//! normal computed in the camera frame by vpMbtPolygon::isVisible()
+const double angleMargin = 1e-3;
+//! Ray parameter margin used to ignore intersections at the ends of the tested segment
+const double rayMargin = 1e-6;
+//! Number of points sampled along each image border to compute the bounds of the view frustum
+const unsigned int nbBorderSamples = 8;
+
+inline double dot(const double a[3], const double b[3]) { return (a[0] * b[0]) + (a[1] * b[1]) + (a[2] * b[2]); }
+
+inline double norm(const double a[3]) { return std::sqrt(dot(a, a)); }
+
+/*!
+ * vpMbtPolygon::isVisible() computes the direction of the camera from the
+ * centroid of the face accumulated in a vpPoint, whose Z coordinate is 1 by
+ * default. This shifts the point the face is seen from by 1/nbpt along the
+ * optical axis, which is reproduced here so that the culling never disagrees
+ * with the per-face test.
+ */
+inline void computeViewpoint(const double camera[3], const double opticalAxis[3], double nbpt, double viewpoint[3])
+{
+  for (unsigned int c = 0; c < 3; ++c) {
+    viewpoint[c] = camera[c] - (opticalAxis[c] / nbpt);
+  }
+}
+
+//! Unsigned angle between two vectors, robust for small angles
+inline double angleBetween(const double a[3], const double b[3])
+{
+  const double cross[3] = { (a[1] * b[2]) - (a[2] * b[1]), (a[2] * b[0]) - (a[0] * b[2]),
+                            (a[0] * b[1]) - (a[1] * b[0]) };
+  return std::atan2(norm(cross), dot(a, b));
+}
+
+//! Plane of the view frustum, such as normal . X + offset >= 0 inside the frustum
+struct vpFrustumPlane
+{
+  double m_normal[3];
+  double m_offset;
+};
+
+//! Planes of the view frustum expressed in the object frame
+void computeFrustumPlanes(const vpHomogeneousMatrix &cMo, const vpCameraParameters &cam, unsigned int width,
+                          unsigned int height, std::vector<vpFrustumPlane> &planes)
+{
+  // Bounds of the normalized coordinates of the image borders. The image border is sampled so that distortion is
+  // taken into account, and the bounds are slightly enlarged to remain conservative in between the samples
+  double xmin = std::numeric_limits<double>::max(), xmax = -std::numeric_limits<double>::max();
+  double ymin = std::numeric_limits<double>::max(), ymax = -std::numeric_limits<double>::max();
+  for (unsigned int s = 0; s <= nbBorderSamples; ++s) {
+    const double u = (static_cast<double>(s) * width) / nbBorderSamples;
+    const double v = (static_cast<double>(s) * height) / nbBorderSamples;
+    const double borders[4][2] = { { u, 0. }, { u, static_cast<double>(height) },
+                                   { 0., v }, { static_cast<double>(width), v } };
+    for (unsigned int b = 0; b < 4; ++b) {
+      double x = 0., y = 0.;
+      vpPixelMeterConversion::convertPoint(cam, borders[b][0], borders[b][1], x, y);
+      xmin = std::min(xmin, x);
+      xmax = std::max(xmax, x);
+      ymin = std::min(ymin, y);
+      ymax = std::max(ymax, y);
+    }
+  }
+  const double marginX = 0.05 * (xmax - xmin), marginY = 0.05 * (ymax - ymin);
+  xmin -= marginX;
+  xmax += marginX;
+  ymin -= marginY;
+  ymax += marginY;
+
+  // Planes going through the optical center in the camera frame, with the near plane Z = 0
+  const double cameraPlanes[5][3] = { { 1., 0., -xmin }, { -1., 0., xmax }, { 0., 1., -ymin },
+                                      { 0., -1., ymax }, { 0., 0., 1. } };
+  const vpRotationMatrix cRo = cMo.getRotationMatrix();
+  const vpTranslationVector cto = cMo.getTranslationVector();
+  planes.resize(5);
+  for (unsigned int k = 0; k < 5; ++k) {
+    // n_c . (cRo X_o + cto) >= 0  <=>  (cRo^T n_c) . X_o + n_c . cto >= 0
+    for (unsigned int c = 0; c < 3; ++c) {
+      planes[k].m_normal[c] =
+        (cRo[0][c] * cameraPlanes[k][0]) + (cRo[1][c] * cameraPlanes[k][1]) + (cRo[2][c] * cameraPlanes[k][2]);
+    }
+    planes[k].m_offset = (cameraPlanes[k][0] * cto[0]) + (cameraPlanes[k][1] * cto[1]) + (cameraPlanes[k][2] * cto[2]);
+  }
+}
+
+//! True if the box is entirely on the outer side of one of the planes
+bool isBoxOutside(const double bbMin[3], const double bbMax[3], const std::vector<vpFrustumPlane> &planes)
+{
+  for (size_t k = 0; k < planes.size(); ++k) {
+    const double *n = planes[k].m_normal;
+    // Corner of the box the furthest along the normal of the plane
+    const double p[3] = { n[0] >= 0. ? bbMax[0] : bbMin[0], n[1] >= 0. ? bbMax[1] : bbMin[1],
+                          n[2] >= 0. ? bbMax[2] : bbMin[2] };
+    if ((dot(n, p) + planes[k].m_offset) < 0.) {
+      return true;
+    }
+  }
+  return false;
+}
+
+//! True if all the points are on the outer side of one of the planes
+bool arePointsOutside(const std::vector<double> &points, const std::vector<vpFrustumPlane> &planes)
+{
+  for (size_t k = 0; k < planes.size(); ++k) {
+    bool outside = true;
+    for (size_t i = 0; (i < points.size()) && outside; i += 3) {
+      outside = (dot(planes[k].m_normal, &points[i]) + planes[k].m_offset) < 0.;
+    }
+    if (outside) {
+      return true;
+    }
+  }
+  return false;
+}
+} // namespace
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+/*!
+ * Default constructor that builds an empty hierarchy.
+ */
+vpMbtBoundingVolumeHierarchy::vpMbtBoundingVolumeHierarchy() : m_faces(), m_nodes(), m_faceIndices() { }
+
+/*!
+ * Build the hierarchy from the object frame coordinates of the polygons.
+ * The i-th polygon is referred to as face i by cull() and isOccluded().
+ *
+ * Since the hierarchy only depends on the model, it has to be built once,
+ * when the model is loaded.
+ *
+ * \param polygons : Polygons of the model.
+ */
+void vpMbtBoundingVolumeHierarchy::build(const std::vector<const vpMbtPolygon *> &polygons)
+{
+  clear();
+  m_faces.resize(polygons.size());
+  m_faceIndices.resize(polygons.size());
+
+  for (size_t k = 0; k < polygons.size(); ++k) {
+    const vpMbtPolygon *polygon = polygons[k];
+    vpFace &face = m_faces[k];
+    const unsigned int nbpt = polygon->getNbPoint();
+
+    face.m_vertices.resize(3 * nbpt);
+    face.m_centroid[0] = face.m_centroid[1] = face.m_centroid[2] = 0.;
+    for (unsigned int i = 0; i < nbpt; ++i) {
+      const vpPoint &P = polygon->p[i];
+      face.m_vertices[(3 * i) + 0] = P.get_oX();
+      face.m_vertices[(3 * i) + 1] = P.get_oY();
+      face.m_vertices[(3 * i) + 2] = P.get_oZ();
+      for (unsigned int c = 0; c < 3; ++c) {
+        face.m_centroid[c] += face.m_vertices[(3 * i) + c];
+      }
+    }
+    for (unsigned int c = 0; c < 3; ++c) {
+      face.m_centroid[c] /= std::max(nbpt, 1u);
+    }
+
+    // Newell's method, as in vpMbtPolygon::isVisible()
+    face.m_normal[0] = face.m_normal[1] = face.m_normal[2] = 0.;
+    for (unsigned int i = 0; i < nbpt; ++i) {
+      const double *cur = &face.m_vertices[3 * i];
+      const double *next = &face.m_vertices[3 * ((i + 1) % nbpt)];
+      face.m_normal[0] += (cur[1] - next[1]) * (cur[2] + next[2]);
+      face.m_normal[1] += (cur[2] - next[2]) * (cur[0] + next[0]);
+      face.m_normal[2] += (cur[0] - next[0]) * (cur[1] + next[1]);
+    }
+    const double normalNorm = norm(face.m_normal);
+    face.m_surface = (nbpt > 2) && (normalNorm > std::numeric_limits<double>::epsilon());
+    face.m_orientable = face.m_surface && polygon->hasOrientation;
+    face.m_axisU = 0;
+    face.m_axisV = 1;
+    face.m_offset = 0.;
+    if (face.m_surface) {
+      for (unsigned int c = 0; c < 3; ++c) {
+        face.m_normal[c] /= normalNorm;
+      }
+      face.m_offset = -dot(face.m_normal, face.m_centroid);
+      // Project the face on the plane orthogonal to the largest component of its normal
+      const double an[3] = { std::fabs(face.m_normal[0]), std::fabs(face.m_normal[1]), std::fabs(face.m_normal[2]) };
+      const unsigned int dropped = (an[0] > an[1]) ? ((an[0] > an[2]) ? 0 : 2) : ((an[1] > an[2]) ? 1 : 2);
+      face.m_axisU = (dropped + 1) % 3;
+      face.m_axisV = (dropped + 2) % 3;
+    }
+
+    m_faceIndices[k] = static_cast<unsigned int>(k);
+  }
+
+  if (!m_faces.empty()) {
+    m_nodes.reserve(2 * ((m_faces.size() / maxLeafSize) + 1));
+    buildNode(0, static_cast<unsigned int>(m_faces.size()));
+  }
+}
+
+/*!
+ * Recursively build the node gathering the faces m_faceIndices[first], ...,
+ * m_faceIndices[first + count - 1].
+ *
+ * \return Index of the node.
+ */
+unsigned int vpMbtBoundingVolumeHierarchy::buildNode(unsigned int first, unsigned int count)
+{
+  const unsigned int index = static_cast<unsigned int>(m_nodes.size());
+  m_nodes.push_back(vpNode());
+
+  vpNode node;
+  double centroidMin[3], centroidMax[3], normalSum[3] = { 0., 0., 0. };
+  for (unsigned int c = 0; c < 3; ++c) {
+    node.m_bbMin[c] = centroidMin[c] = std::numeric_limits<double>::max();
+    node.m_bbMax[c] = centroidMax[c] = -std::numeric_limits<double>::max();
+  }
+  node.m_orientable = true;
+  node.m_nbptMin = std::numeric_limits<unsigned int>::max();
+  node.m_nbptMax = 0;
+  for (unsigned int i = first; i < first + count; ++i) {
+    const vpFace &face = m_faces[m_faceIndices[i]];
+    const unsigned int nbpt = static_cast<unsigned int>(face.m_vertices.size() / 3);
+    node.m_nbptMin = std::min(node.m_nbptMin, nbpt);
+    node.m_nbptMax = std::max(node.m_nbptMax, nbpt);
+    for (size_t v = 0; v < face.m_vertices.size(); v += 3) {
+      for (unsigned int c = 0; c < 3; ++c) {
+        node.m_bbMin[c] = std::min(node.m_bbMin[c], face.m_vertices[v + c]);
+        node.m_bbMax[c] = std::max(node.m_bbMax[c], face.m_vertices[v + c]);
+      }
+    }
+    for (unsigned int c = 0; c < 3; ++c) {
+      centroidMin[c] = std::min(centroidMin[c], face.m_centroid[c]);
+      centroidMax[c] = std::max(centroidMax[c], face.m_centroid[c]);
+      normalSum[c] += face.m_normal[c];
+    }
+    node.m_orientable = node.m_orientable && face.m_orientable;
+  }
+
+  node.m_sphereRadius = 0.;
+  for (unsigned int c = 0; c < 3; ++c) {
+    node.m_sphereCenter[c] = 0.5 * (centroidMin[c] + centroidMax[c]);
+  }
+  for (unsigned int i = first; i < first + count; ++i) {
+    const double *centroid = m_faces[m_faceIndices[i]].m_centroid;
+    const double d[3] = { centroid[0] - node.m_sphereCenter[0], centroid[1] - node.m_sphereCenter[1],
+                          centroid[2] - node.m_sphereCenter[2] };
+    node.m_sphereRadius = std::max(node.m_sphereRadius, norm(d));
+  }
+
+  node.m_coneAngle = M_PI;
+  node.m_coneAxis[0] = node.m_coneAxis[1] = 0.;
+  node.m_coneAxis[2] = 1.;
+  const double normalSumNorm = norm(normalSum);
+  if (node.m_orientable && (normalSumNorm > std::numeric_limits<double>::epsilon())) {
+    node.m_coneAngle = 0.;
+    for (unsigned int c = 0; c < 3; ++c) {
+      node.m_coneAxis[c] = normalSum[c] / normalSumNorm;
+    }
+    for (unsigned int i = first; i < first + count; ++i) {
+      node.m_coneAngle = std::max(node.m_coneAngle, angleBetween(node.m_coneAxis, m_faces[m_faceIndices[i]].m_normal));
+    }
+  }
+  else {
+    node.m_orientable = false;
+  }
+
+  node.m_first = first;
+  node.m_count = count;
+  node.m_right = 0;
+
+  // Split at the median of the centroids along the largest axis
+  unsigned int axis = 0;
+  for (unsigned int c = 1; c < 3; ++c) {
+    if ((centroidMax[c] - centroidMin[c]) > (centroidMax[axis] - centroidMin[axis])) {
+      axis = c;
+    }
+  }
+  if ((count > maxLeafSize) && (centroidMax[axis] > centroidMin[axis])) {
+    const unsigned int half = count / 2;
+    std::vector<unsigned int>::iterator begin = m_faceIndices.begin() + first;
+    const std::vector<vpFace> &faces = m_faces;
+    std::nth_element(begin, begin + half, begin + count, [&faces, axis](unsigned int a, unsigned int b) {
+      return faces[a].m_centroid[axis] < faces[b].m_centroid[axis];
+      });
+    buildNode(first, half);
+    node.m_right = buildNode(first + half, count - half);
+  }
+
+  m_nodes[index] = node;
+  return index;
+}
+
+/*!
+ * Remove all the faces and nodes of the hierarchy.
+ */
+void vpMbtBoundingVolumeHierarchy::clear()
+{
+  m_faces.clear();
+  m_nodes.clear();
+  m_faceIndices.clear();
+}
+
+/*!
+ * Split the faces into the ones that are guaranteed to be hidden from the
+ * camera and the ones that have to be tested individually.
+ *
+ * A face is \e culled if its normal makes with the direction of the camera an
+ * angle greater than \e angle, so that vpMbtPolygon::isVisible() would
+ * consider it neither visible nor appearing with an angle lower than \e angle.
+ * Faces that are lines, or that have no orientation, are never culled by this
+ * test. Whole nodes are rejected at once when the cone of their normals seen
+ * from the camera is entirely beyond \e angle.
+ *
+ * When the camera parameters are given, faces entirely outside the view
+ * frustum, including the faces behind the camera, are culled as well.
+ * The frustum is slightly enlarged so that this test is conservative.
+ *
+ * \param cMo : Pose of the camera.
+ * \param angle : Angle in radian beyond which a face is back-facing.
+ * \param candidates : Indices of the faces that may be visible.
+ * \param culled : Indices of the faces that are hidden.
+ * \param cam : When not null, camera parameters used to build the view frustum.
+ * \param width, height : Image size used to build the view frustum.
+ */
+void vpMbtBoundingVolumeHierarchy::cull(const vpHomogeneousMatrix &cMo, double angle,
+                                        std::vector<unsigned int> &candidates, std::vector<unsigned int> &culled,
+                                        const vpCameraParameters *cam, unsigned int width, unsigned int height) const
+{
+  candidates.clear();
+  culled.clear();
+  if (m_nodes.empty()) {
+    return;
+  }
+
+  const vpHomogeneousMatrix oMc = cMo.inverse();
+  const double camera[3] = { oMc[0][3], oMc[1][3], oMc[2][3] };
+  const double opticalAxis[3] = { oMc[0][2], oMc[1][2], oMc[2][2] };
+  const double threshold = angle + angleMargin;
+
+  std::vector<vpFrustumPlane> planes;
+  if ((cam != nullptr) && (width > 0) && (height > 0)) {
+    computeFrustumPlanes(cMo, *cam, width, height, planes);
+  }
+
+  std::vector<unsigned int> stack;
+  stack.reserve(64);
+  stack.push_back(0);
+  while (!stack.empty()) {
+    const vpNode &node = m_nodes[stack.back()];
+    const unsigned int nodeIndex = stack.back();
+    stack.pop_back();
+
+    bool hidden = (!planes.empty()) && isBoxOutside(node.m_bbMin, node.m_bbMax, planes);
+    if ((!hidden) && node.m_orientable) {
+      // Lower bound of the angle between the normal of a face of the node and the direction of the camera. The
+      // viewpoints of the faces lie on a segment of the optical axis, which enlarges the sphere of the centroids
+      double viewpoint[3];
+      computeViewpoint(camera, opticalAxis, (2. * node.m_nbptMin * node.m_nbptMax) / (node.m_nbptMin + node.m_nbptMax),
+                       viewpoint);
+      const double radius = node.m_sphereRadius + (0.5 * ((1. / node.m_nbptMin) - (1. / node.m_nbptMax)));
+      const double v[3] = { viewpoint[0] - node.m_sphereCenter[0], viewpoint[1] - node.m_sphereCenter[1],
+                            viewpoint[2] - node.m_sphereCenter[2] };
+      const double distance = norm(v);
+      if (distance > radius) {
+        hidden = (angleBetween(node.m_coneAxis, v) - std::asin(radius / distance) - node.m_coneAngle) > threshold;
+      }
+    }
+
+    if (hidden) {
+      culled.insert(culled.end(), m_faceIndices.begin() + node.m_first,
+                    m_faceIndices.begin() + node.m_first + node.m_count);
+    }
+    else if (node.m_right == 0) {
+      for (unsigned int i = node.m_first; i < node.m_first + node.m_count; ++i) {
+        const vpFace &face = m_faces[m_faceIndices[i]];
+        bool faceHidden = (!planes.empty()) && arePointsOutside(face.m_vertices, planes);
+        if ((!faceHidden) && face.m_orientable) {
+          double viewpoint[3];
+          computeViewpoint(camera, opticalAxis, static_cast<double>(face.m_vertices.size() / 3), viewpoint);
+          const double v[3] = { viewpoint[0] - face.m_centroid[0], viewpoint[1] - face.m_centroid[1],
+                                viewpoint[2] - face.m_centroid[2] };
+          faceHidden = angleBetween(face.m_normal, v) > threshold;
+        }
+        (faceHidden ? culled : candidates).push_back(m_faceIndices[i]);
+      }
+    }
+    else {
+      stack.push_back(node.m_right);
+      stack.push_back(nodeIndex + 1);
+    }
+  }
+}
+
+/*!
+ * Test if a face intersects the segment origin + t * direction, with t in ]0, 1[.
+ */
+bool vpMbtBoundingVolumeHierarchy::intersectFace(const vpFace &face, const double origin[3],
+                                                 const double direction[3]) const
+{
+  const double denominator = dot(face.m_normal, direction);
+  if (std::fabs(denominator) <= std::numeric_limits<double>::epsilon()) {
+    return false;
+  }
+  const double t = -(dot(face.m_normal, origin) + face.m_offset) / denominator;
+  if ((t <= rayMargin) || (t >= (1. - rayMargin))) {
+    return false;
+  }
+
+  // Crossing number test on the projection of the face
+  const double u = origin[face.m_axisU] + (t * direction[face.m_axisU]);
+  const double v = origin[face.m_axisV] + (t * direction[face.m_axisV]);
+  const size_t nbpt = face.m_vertices.size() / 3;
+  bool inside = false;
+  for (size_t i = 0, j = nbpt - 1; i < nbpt; j = i++) {
+    const double ui = face.m_vertices[(3 * i) + face.m_axisU], vi = face.m_vertices[(3 * i) + face.m_axisV];
+    const double uj = face.m_vertices[(3 * j) + face.m_axisU], vj = face.m_vertices[(3 * j) + face.m_axisV];
+    if (((vi > v) != (vj > v)) && (u < ((((uj - ui) * (v - vi)) / (vj - vi)) + ui))) {
+      inside = !inside;
+    }
+  }
+  return inside;
+}
+
+/*!
+ * Test if the segment between two points, expressed in the object frame, goes
+ * through a face of the model. Faces that are lines never occlude the segment.
+ *
+ * \param origin : First end of the segment, typically the position of the camera.
+ * \param target : Second end of the segment, typically a point of the face to test.
+ * \param ignoredFace : Index of a face that is not considered, typically the face that contains \e target.
+ *
+ * \return True if a face other than \e ignoredFace lies strictly in between \e origin and \e target.
+ */
+bool vpMbtBoundingVolumeHierarchy::isOccluded(const vpTranslationVector &origin, const vpTranslationVector &target,
+                                              unsigned int ignoredFace) const
+{
+  if (m_nodes.empty()) {
+    return false;
+  }
+
+  const double o[3] = { origin[0], origin[1], origin[2] };
+  const double d[3] = { target[0] - origin[0], target[1] - origin[1], target[2] - origin[2] };
+
+  std::vector<unsigned int> stack;
+  stack.reserve(64);
+  stack.push_back(0);
+  while (!stack.empty()) {
+    const unsigned int nodeIndex = stack.back();
+    const vpNode &node = m_nodes[nodeIndex];
+    stack.pop_back();
+
+    // Slab test of the segment against the bounding box
+    double tmin = 0., tmax = 1.;
+    for (unsigned int c = 0; (c < 3) && (tmin <= tmax); ++c) {
+      if (std::fabs(d[c]) <= std::numeric_limits<double>::epsilon()) {
+        if ((o[c] < node.m_bbMin[c]) || (o[c] > node.m_bbMax[c])) {
+          tmin = 1.;
+          tmax = 0.;
+        }
+      }
+      else {
+        const double t1 = (node.m_bbMin[c] - o[c]) / d[c], t2 = (node.m_bbMax[c] - o[c]) / d[c];
+        tmin = std::max(tmin, std::min(t1, t2));
+        tmax = std::min(tmax, std::max(t1, t2));
+      }
+    }
+    if (tmin > tmax) {
+      continue;
+    }
+
+    if (node.m_right == 0) {
+      for (unsigned int i = node.m_first; i < node.m_first + node.m_count; ++i) {
+        const unsigned int faceIndex = m_faceIndices[i];
+        if ((faceIndex != ignoredFace) && m_faces[faceIndex].m_surface && intersectFace(m_faces[faceIndex], o, d)) {
+          return true;
+        }
+      }
+    }
+    else {
+      stack.push_back(node.m_right);
+      stack.push_back(nodeIndex + 1);
+    }
+  }
+  return false;
+}
+END_VISP_NAMESPACE
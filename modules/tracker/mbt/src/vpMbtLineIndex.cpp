@@ -0,0 +1,109 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2024 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Index of the lines of the model-based tracker by their extremities.
+ */
+
+/*!
+ * \file vpMbtLineIndex.cpp
+ * \brief Index of the lines of the model-based tracker by their extremities.
+ */
+
+#include <visp3/mbt/vpMbtDistanceLine.h>
+#include <visp3/mbt/vpMbtLineIndex.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+BEGIN_VISP_NAMESPACE
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace
+{
+inline double getKey(const vpPoint &P1, const vpPoint &P2) { return std::min(P1.get_oX(), P2.get_oX()); }
+
+/*!
+ * Half width of the range of keys searched by find(). vpMbTracker::samePoint()
+ * accepts coordinates that differ by up to the machine epsilon, the margin
+ * also covers the rounding of the bounds of the range.
+ */
+inline double getTolerance(double key)
+{
+  return 4. * std::numeric_limits<double>::epsilon() * (1. + std::fabs(key));
+}
+} // namespace
+#endif
+
+vpMbtLineIndex::vpMbtLineIndex() : m_lines(), m_size(0), m_last(nullptr) { }
+
+/*!
+ * Remove all the lines from the index.
+ */
+void vpMbtLineIndex::clear()
+{
+  m_lines.clear();
+  m_size = 0;
+  m_last = nullptr;
+}
+
+/*!
+ * Get the lines that may have the same extremities as a segment, whatever
+ * their order.
+ *
+ * \param P1 : The first extremity of the segment.
+ * \param P2 : The second extremity of the segment.
+ * \param candidates : The candidate lines.
+ */
+void vpMbtLineIndex::find(const vpPoint &P1, const vpPoint &P2, std::vector<vpMbtDistanceLine *> &candidates) const
+{
+  candidates.clear();
+
+  const double key = getKey(P1, P2);
+  const double tolerance = getTolerance(key);
+  std::multimap<double, vpMbtDistanceLine *>::const_iterator it = m_lines.lower_bound(key - tolerance);
+  const std::multimap<double, vpMbtDistanceLine *>::const_iterator it_end = m_lines.upper_bound(key + tolerance);
+  for (; it != it_end; ++it) {
+    candidates.push_back(it->second);
+  }
+}
+
+/*!
+ * Add a line to the index. The line is supposed to be appended to the list
+ * the index refers to.
+ *
+ * \param line : The line, whose extremities are set.
+ */
+void vpMbtLineIndex::insert(vpMbtDistanceLine *line)
+{
+  m_lines.insert(std::make_pair(getKey(*(line->p1), *(line->p2)), line));
+  ++m_size;
+  m_last = line;
+}
+END_VISP_NAMESPACE
@@ -0,0 +1,1657 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2024 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Compiled 3D model used by the model-based tracker.
+ */
+
+/*!
+ * \file vpMbtModel.cpp
+ * \brief Compiled 3D model used by the model-based tracker.
+ */
+
+#include <visp3/mbt/vpMbtModel.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <map>
+
+#include <visp3/core/vpColVector.h>
+#include <visp3/core/vpDebug.h>
+#include <visp3/core/vpException.h>
+#include <visp3/core/vpIoTools.h>
+#include <visp3/core/vpMath.h>
+
+#if !defined(_WIN32) && (defined(__unix__) || defined(__unix) || (defined(__APPLE__) && defined(__MACH__))) // UNIX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define VP_MBT_MODEL_HAVE_MMAP
+#endif
+
+#ifdef VISP_HAVE_COIN3D
+#include <Inventor/SoDB.h>
+#include <Inventor/SoInput.h>
+#include <Inventor/VRMLnodes/SoVRMLCoordinate.h>
+#include <Inventor/VRMLnodes/SoVRMLShape.h>
+#include <Inventor/VRMLnodes/SoVRMLTransform.h>
+#include <Inventor/actions/SoToVRML2Action.h>
+#include <Inventor/misc/SoChildList.h>
+#include <Inventor/nodes/SoSeparator.h>
+#include <visp3/core/vpQuaternionVector.h>
+#include <visp3/core/vpRotationMatrix.h>
+#endif
+
+#if defined(VISP_HAVE_THREADS)
+#include <mutex>
+#endif
+
+BEGIN_VISP_NAMESPACE
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace
+{
+#if defined(VISP_HAVE_THREADS)
+std::mutex g_mutex_cout;
+#endif
+
+const char g_magic[8] = { 'V', 'P', 'M', 'B', 'T', 'M', 'D', 'L' };
+const uint32_t g_version = 1;
+const uint32_t g_byteOrder = 0x01020304;
+
+static_assert(sizeof(vpMbtModel::vpHeader) == 64, "The header of the compiled models must be 64 bytes long");
+static_assert(sizeof(vpMbtModel::vpPrimitive) == 56, "The primitive records of the compiled models must be 56 bytes long");
+
+/*!
+  Structure to store info about segment in CAO model files.
+ */
+struct SegmentInfo
+{
+  SegmentInfo() : extremities(), name(), useLodMode(vpMbtModel::LOD_DEFAULT), useLod(false),
+    lengthMode(vpMbtModel::LOD_DEFAULT), minLineLengthThresh(0.)
+  { }
+
+  std::vector<uint32_t> extremities;
+  std::string name;
+  vpMbtModel::vpLodMode useLodMode;
+  bool useLod;
+  vpMbtModel::vpLodMode lengthMode;
+  double minLineLengthThresh;
+};
+
+/*!
+  Reference: https://stackoverflow.com/a/6089413
+  To replace the following old code:
+      char buffer[256];
+      fileId.getline(buffer, 256);
+  This should take care of the different line ending styles.
+ */
+std::istream &safeGetline(std::istream &is, std::string &t)
+{
+  t.clear();
+
+  // The characters in the stream are read one-by-one using a std::streambuf.
+  // That is faster than reading them one-by-one using the std::istream.
+  // Code that uses streambuf this way must be guarded by a sentry object.
+  // The sentry object performs various tasks,
+  // such as thread synchronization and updating the stream state.
+
+  std::istream::sentry se(is, true);
+  std::streambuf *sb = is.rdbuf();
+
+  for (;;) {
+    int c = sb->sbumpc();
+    if (c == '\n') {
+      return is;
+    }
+    else if (c == '\r') {
+      if (sb->sgetc() == '\n')
+        sb->sbumpc();
+      return is;
+    }
+    else if (c == std::streambuf::traits_type::eof()) {
+   // Also handle the case when the last line has no line ending
+      if (t.empty())
+        is.setstate(std::ios::eofbit);
+      return is;
+    }
+    else { // default case
+      t += (char)c;
+    }
+  }
+}
+
+void removeComment(std::ifstream &fileId)
+{
+  char c;
+
+  fileId.get(c);
+  while (!fileId.fail() && (c == '#')) {
+    fileId.ignore(std::numeric_limits<std::streamsize>::max(), fileId.widen('\n'));
+    fileId.get(c);
+  }
+  if (fileId.fail()) {
+    throw(vpException(vpException::ioError, "Reached end of file"));
+  }
+  fileId.unget();
+}
+
+std::map<std::string, std::string> createParameterNames()
+{
+  std::map<std::string, std::string> mapOfParameterNames;
+  mapOfParameterNames["name"] = "string";
+  mapOfParameterNames["minPolygonAreaThreshold"] = "number";
+  mapOfParameterNames["minLineLengthThreshold"] = "number";
+  mapOfParameterNames["useLod"] = "boolean";
+  return mapOfParameterNames;
+}
+
+std::map<std::string, std::string> parseParameters(std::string &endLine)
+{
+  static const std::map<std::string, std::string> mapOfParameterNames = createParameterNames();
+  std::map<std::string, std::string> mapOfParams;
+
+  bool exit = false;
+  while (!endLine.empty() && !exit) {
+    exit = true;
+
+    for (std::map<std::string, std::string>::const_iterator it = mapOfParameterNames.begin();
+         it != mapOfParameterNames.end(); ++it) {
+      endLine = vpIoTools::trim(endLine);
+      std::string param(it->first + "=");
+
+      // Compare with a potential parameter
+      if (endLine.compare(0, param.size(), param) == 0) {
+        exit = false;
+        endLine = endLine.substr(param.size());
+
+        bool parseQuote = false;
+        if (it->second == "string") {
+          // Check if the string is between quotes
+          if (endLine.size() > 2 && endLine[0] == '"') {
+            parseQuote = true;
+            endLine = endLine.substr(1);
+            size_t pos = endLine.find_first_of('"');
+
+            if (pos != std::string::npos) {
+              mapOfParams[it->first] = endLine.substr(0, pos);
+              endLine = endLine.substr(pos + 1);
+            }
+            else {
+              parseQuote = false;
+            }
+          }
+        }
+
+        if (!parseQuote) {
+          // Deal with space or tabulation after parameter value to substring
+          // to the next sequence
+          size_t pos1 = endLine.find_first_of(' ');
+          size_t pos2 = endLine.find_first_of('\t');
+          size_t pos = pos1 < pos2 ? pos1 : pos2;
+
+          mapOfParams[it->first] = endLine.substr(0, pos);
+          endLine = endLine.substr(pos + 1);
+        }
+      }
+    }
+  }
+
+  return mapOfParams;
+}
+
+// Offsets of the parts of the model buffer, all multiple of 8 bytes. They are computed with 64 bits integers, that
+// cannot overflow with the 32 bits counts of the header, so that a corrupted header cannot wrap them around.
+struct vpLayout
+{
+  explicit vpLayout(const vpMbtModel::vpHeader &header)
+  {
+    primitives = sizeof(vpMbtModel::vpHeader);
+    indices = primitives + (static_cast<uint64_t>(header.nbPrimitives) * sizeof(vpMbtModel::vpPrimitive));
+    vertices = indices + ((((static_cast<uint64_t>(header.nbIndices) * sizeof(uint32_t)) + 7) / 8) * 8);
+    names = vertices + (static_cast<uint64_t>(header.nbVertices) * 3 * sizeof(double));
+    size = names + header.namesSize;
+  }
+
+  // True if the whole buffer can be addressed on this platform
+  bool isAddressable() const { return size <= static_cast<uint64_t>(std::numeric_limits<size_t>::max()); }
+
+  uint64_t primitives;
+  uint64_t indices;
+  uint64_t vertices;
+  uint64_t names;
+  uint64_t size;
+};
+
+#ifdef VP_MBT_MODEL_HAVE_MMAP
+struct vpUnmapper
+{
+  explicit vpUnmapper(size_t size) : m_size(size) { }
+
+  void operator()(const unsigned char *data) const
+  {
+    munmap(const_cast<unsigned char *>(data), m_size);
+  }
+
+  size_t m_size;
+};
+#endif
+
+#ifdef VISP_HAVE_COIN3D
+vpPoint getGravityCenter(const std::vector<vpPoint> &pts)
+{
+  if (pts.empty()) {
+    std::cout << "Cannot extract center of gravity of empty set." << std::endl;
+    throw vpException(vpException::dimensionError, "Cannot extract center of gravity of empty set.");
+  }
+  double oX = 0;
+  double oY = 0;
+  double oZ = 0;
+  vpPoint G;
+
+  for (unsigned int i = 0; i < pts.size(); ++i) {
+    oX += pts[i].get_oX();
+    oY += pts[i].get_oY();
+    oZ += pts[i].get_oZ();
+  }
+
+  G.setWorldCoordinates(oX / pts.size(), oY / pts.size(), oZ / pts.size());
+  return G;
+}
+#endif
+} // namespace
+
+/*!
+  Primitives, points and names of a model being parsed, packed in the model
+  buffer by vpMbtModel::build().
+ */
+class vpMbtModel::vpBuilder
+{
+public:
+  vpBuilder()
+    : primitives(), indices(), vertices(), names(), nbPoints(0), nbLines(0), nbPolygonLines(0), nbPolygonPoints(0),
+    nbCylinders(0), nbCircles(0), nbFaceIds(0)
+  { }
+
+  void addPrimitive(vpPrimitiveType type, int idFace, const std::vector<uint32_t> &points, double radius,
+                    const std::string &name, vpLodMode useLodMode, bool useLod, vpLodMode areaMode,
+                    double minPolygonAreaThreshold, vpLodMode lengthMode, double minLineLengthThreshold)
+  {
+    vpPrimitive primitive;
+    std::memset(&primitive, 0, sizeof(primitive));
+    primitive.type = static_cast<uint32_t>(type);
+    primitive.idFace = idFace;
+    primitive.firstIndex = static_cast<uint32_t>(indices.size());
+    primitive.nbIndices = static_cast<uint32_t>(points.size());
+    primitive.radius = radius;
+    primitive.minPolygonAreaThreshold = minPolygonAreaThreshold;
+    primitive.minLineLengthThreshold = minLineLengthThreshold;
+    primitive.nameOffset = static_cast<uint32_t>(names.size());
+    primitive.nameLength = static_cast<uint32_t>(name.size());
+    primitive.useLodMode = static_cast<uint8_t>(useLodMode);
+    primitive.useLod = useLod ? 1 : 0;
+    primitive.areaMode = static_cast<uint8_t>(areaMode);
+    primitive.lengthMode = static_cast<uint8_t>(lengthMode);
+    primitives.push_back(primitive);
+
+    indices.insert(indices.end(), points.begin(), points.end());
+    names += name;
+    // A cylinder uses the id of its axis and the one of its bounding box, and reserves five ids
+    nbFaceIds = std::max<int>(nbFaceIds, idFace + (type == CYLINDER ? 5 : 1));
+  }
+
+  uint32_t addVertex(double oX, double oY, double oZ)
+  {
+    vertices.push_back(oX);
+    vertices.push_back(oY);
+    vertices.push_back(oZ);
+    return static_cast<uint32_t>(vertices.size() / 3 - 1);
+  }
+
+  uint32_t addVertex(const vpPoint &P) { return addVertex(P.get_oX(), P.get_oY(), P.get_oZ()); }
+
+  std::vector<vpPrimitive> primitives;
+  std::vector<uint32_t> indices;
+  std::vector<double> vertices;
+  std::string names;
+  unsigned int nbPoints;
+  unsigned int nbLines;
+  unsigned int nbPolygonLines;
+  unsigned int nbPolygonPoints;
+  unsigned int nbCylinders;
+  unsigned int nbCircles;
+  int nbFaceIds;
+};
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+/*!
+  Default constructor, that builds an empty model.
+*/
+vpMbtModel::vpMbtModel() : m_data(), m_size(0), m_mapped(false)
+{
+  build(vpBuilder());
+}
+
+/*!
+  Compile a 3D model into a compiled model file that can then be loaded by
+  vpMbTracker::loadModel() or load() without parsing the model again.
+
+  \throw vpException::ioError if the model file cannot be read or the compiled
+  model file cannot be written.
+
+  \param modelFile : The file containing the 3D model description, a *.cao or
+  a *.wrl file.
+  \param compiledFile : The compiled model file to write.
+  \param verbose : Verbose option to print additional information when loading
+  CAO model files which include other CAO model files.
+  \param odTo : Optional transformation matrix (currently only for .cao) to
+  transform 3D points expressed in the original object frame to the desired
+  object frame.
+*/
+void vpMbtModel::compile(const std::string &modelFile, const std::string &compiledFile, bool verbose,
+                         const vpHomogeneousMatrix &odTo)
+{
+  vpMbtModel model;
+  model.load(modelFile, verbose, odTo);
+  model.save(compiledFile);
+}
+
+/*!
+  Get the name of a primitive of the model.
+
+  \param i : Index of the primitive, lower than getNbPrimitives().
+  \return Name of the primitive, empty if the primitive has no name.
+*/
+std::string vpMbtModel::getPrimitiveName(unsigned int i) const
+{
+  const vpPrimitive &primitive = primitives()[i];
+  return std::string(names() + primitive.nameOffset, primitive.nameLength);
+}
+
+/*!
+  Get a 3D point of the model.
+
+  \param k : Index of the point, lower than getNbVertices().
+  \return The point with its coordinates in the object frame set.
+*/
+vpPoint vpMbtModel::getVertex(unsigned int k) const
+{
+  const double *vertex = vertices() + 3 * k;
+  vpPoint P;
+  P.setWorldCoordinates(vertex[0], vertex[1], vertex[2]);
+  return P;
+}
+
+/*!
+  Check if a file is a compiled model file, written by save() or compile().
+
+  \param filename : Name of the file.
+  \return True if the file starts with the signature of the compiled model
+  files.
+*/
+bool vpMbtModel::isCompiledModel(const std::string &filename)
+{
+  std::ifstream file(filename.c_str(), std::ios::in | std::ios::binary);
+  char magic[sizeof(g_magic)];
+  if (!file.read(magic, sizeof(magic))) {
+    return false;
+  }
+  return std::memcmp(magic, g_magic, sizeof(g_magic)) == 0;
+}
+
+/*!
+  Load a 3D model from a *.cao file, a *.wrl file or a compiled model file.
+
+  \throw vpException::ioError if the file does not exist, or if it is neither
+  a cao, a wrl or a compiled model file.
+
+  \param modelFile : The file containing the 3D model description.
+  \param verbose : Verbose option to print additional information when loading
+  CAO model files which include other CAO model files.
+  \param odTo : Optional transformation matrix (only for .cao) to transform 3D
+  points expressed in the original object frame to the desired object frame.
+  The points of a compiled model file are expressed in the frame that was used
+  to compile it.
+*/
+void vpMbtModel::load(const std::string &modelFile, bool verbose, const vpHomogeneousMatrix &odTo)
+{
+  if (!vpIoTools::checkFilename(modelFile)) {
+    throw vpException(vpException::ioError, "Error: File %s doesn't exist", modelFile.c_str());
+  }
+
+  std::string extension = vpIoTools::getFileExtension(modelFile);
+  std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+  if (extension == ".cao") {
+    std::vector<std::string> vectorOfModelFilename;
+    loadCAO(modelFile, vectorOfModelFilename, verbose, true, odTo);
+  }
+  else if (extension == ".wrl") {
+    loadVRML(modelFile);
+  }
+  else if (isCompiledModel(modelFile)) {
+    loadCompiled(modelFile);
+  }
+  else {
+    throw vpException(vpException::ioError, "Error: File %s doesn't contain a cao, wrl or compiled model",
+                      modelFile.c_str());
+  }
+}
+
+/*!
+  Load a 3D model contained in a *.cao file. The format of the file is
+  described in vpMbTracker::loadCAOModel().
+
+  \param modelFile : Full name of the main *.cao file containing the model.
+  \param vectorOfModelFilename : A vector of *.cao files.
+  \param verbose : If true, will print additional information with CAO model
+  files which include other CAO model files.
+  \param parent : This parameter is set to true when parsing a parent CAO
+  model file, and false when parsing an included CAO model file.
+  \param odTo : Optional transformation matrix to transform 3D points
+  expressed in the original object frame to the desired object frame.
+*/
+void vpMbtModel::loadCAO(const std::string &modelFile, std::vector<std::string> &vectorOfModelFilename, bool verbose,
+                         bool parent, const vpHomogeneousMatrix &odTo)
+{
+  vpBuilder builder;
+  int startIdFace = 0;
+  loadCAO(modelFile, vectorOfModelFilename, startIdFace, verbose, parent, odTo, builder);
+  build(builder);
+}
+
+void vpMbtModel::loadCAO(const std::string &modelFile, std::vector<std::string> &vectorOfModelFilename,
+                         int &startIdFace, bool verbose, bool parent, const vpHomogeneousMatrix &odTo,
+                         vpBuilder &builder)
+{
+  const unsigned int maxDataCAO = 100000; // arbitrary value
+
+  std::ifstream fileId;
+  fileId.exceptions(std::ifstream::failbit | std::ifstream::eofbit);
+  fileId.open(modelFile.c_str(), std::ifstream::in);
+  if (fileId.fail()) {
+    std::cout << "cannot read CAO model file: " << modelFile << std::endl;
+    throw vpException(vpException::ioError, "cannot read CAO model file");
+  }
+
+  if (verbose) {
+    std::cout << "Model file : " << modelFile << std::endl;
+  }
+  vectorOfModelFilename.push_back(modelFile);
+
+  try {
+    char c;
+    // Extraction of the version (remove empty line and commented ones
+    // (comment line begin with the #)).
+    // while ((fileId.get(c) != nullptr) && (c == '#')) fileId.ignore(256, '\n');
+    removeComment(fileId);
+
+    //////////////////////////Read CAO Version (V1, V2,...)//////////////////////////
+    int caoVersion;
+    fileId.get(c);
+    if (c == 'V') {
+      fileId >> caoVersion;
+      fileId.ignore(std::numeric_limits<std::streamsize>::max(), fileId.widen('\n')); // skip the rest of the line
+    }
+    else {
+      std::cout << "in vpMbTracker::loadCAOModel() -> Bad parameter header "
+        "file : use V0, V1, ...";
+      throw vpException(vpException::badValue, "in vpMbTracker::loadCAOModel() -> Bad parameter "
+                                               "header file : use V0, V1, ...");
+    }
+
+    removeComment(fileId);
+
+    //////////////////////////Read the header part if present//////////////////////////
+    std::string line;
+    const std::string prefix_load = "load";
+
+    fileId.get(c);
+    fileId.unget();
+    bool header = false;
+    while (c == 'l' || c == 'L') {
+      getline(fileId, line);
+
+      if (!line.compare(0, prefix_load.size(), prefix_load)) {
+        // remove "load("
+        std::string paramsStr = line.substr(5);
+        // get parameters inside load()
+        paramsStr = paramsStr.substr(0, paramsStr.find_first_of(")"));
+        // split by comma
+        std::vector<std::string> params = vpIoTools::splitChain(paramsStr, ",");
+        // remove whitespaces
+        for (size_t i = 0; i < params.size(); i++) {
+          params[i] = vpIoTools::trim(params[i]);
+        }
+
+        if (!params.empty()) {
+          // Get the loaded model pathname
+          std::string headerPathRead = params[0];
+          headerPathRead = headerPathRead.substr(1);
+          headerPathRead = headerPathRead.substr(0, headerPathRead.find_first_of("\""));
+
+          std::string headerPath = headerPathRead;
+          if (!vpIoTools::isAbsolutePathname(headerPathRead)) {
+            std::string parentDirectory = vpIoTools::getParent(modelFile);
+            headerPath = vpIoTools::createFilePath(parentDirectory, headerPathRead);
+          }
+
+          // Normalize path
+          headerPath = vpIoTools::path(headerPath);
+
+          // Get real path
+          headerPath = vpIoTools::getAbsolutePathname(headerPath);
+
+          vpHomogeneousMatrix oTo_local;
+          vpTranslationVector t;
+          vpThetaUVector tu;
+          for (size_t i = 1; i < params.size(); i++) {
+            std::string param = params[i];
+            {
+              const std::string prefix = "t=[";
+              if (!param.compare(0, prefix.size(), prefix)) {
+                param = param.substr(prefix.size());
+                param = param.substr(0, param.find_first_of("]"));
+
+                std::vector<std::string> values = vpIoTools::splitChain(param, ";");
+                if (values.size() == 3) {
+                  t[0] = atof(values[0].c_str());
+                  t[1] = atof(values[1].c_str());
+                  t[2] = atof(values[2].c_str());
+                }
+              }
+            }
+            {
+              const std::string prefix = "tu=[";
+              if (!param.compare(0, prefix.size(), prefix)) {
+                param = param.substr(prefix.size());
+                param = param.substr(0, param.find_first_of("]"));
+
+                std::vector<std::string> values = vpIoTools::splitChain(param, ";");
+                if (values.size() == 3) {
+                  for (size_t j = 0; j < values.size(); j++) {
+                    std::string value = values[j];
+                    bool radian = true;
+                    size_t unitPos = value.find("deg");
+                    if (unitPos != std::string::npos) {
+                      value = value.substr(0, unitPos);
+                      radian = false;
+                    }
+
+                    unitPos = value.find("rad");
+                    if (unitPos != std::string::npos) {
+                      value = value.substr(0, unitPos);
+                    }
+                    tu[static_cast<unsigned int>(j)] = !radian ? vpMath::rad(atof(value.c_str())) : atof(value.c_str());
+                  }
+                }
+              }
+            }
+          }
+          oTo_local.buildFrom(t, tu);
+
+          bool cyclic = false;
+          for (std::vector<std::string>::const_iterator it = vectorOfModelFilename.begin();
+               it != vectorOfModelFilename.end() && !cyclic; ++it) {
+            if (headerPath == *it) {
+              cyclic = true;
+            }
+          }
+
+          if (!cyclic) {
+            if (vpIoTools::checkFilename(headerPath)) {
+              header = true;
+              loadCAO(headerPath, vectorOfModelFilename, startIdFace, verbose, false, odTo * oTo_local, builder);
+            }
+            else {
+              throw vpException(vpException::ioError, "file cannot be open");
+            }
+          }
+          else {
+            std::cout << "WARNING Cyclic dependency detected with file " << headerPath << " declared in " << modelFile
+              << std::endl;
+          }
+        }
+      }
+
+      removeComment(fileId);
+      fileId.get(c);
+      fileId.unget();
+    }
+
+    //////////////////////////Read the point declaration part//////////////////////////
+    unsigned int caoNbrPoint;
+    fileId >> caoNbrPoint;
+    fileId.ignore(std::numeric_limits<std::streamsize>::max(), fileId.widen('\n')); // skip the rest of the line
+
+    builder.nbPoints += caoNbrPoint;
+    if (verbose || (parent && !header)) {
+#if defined(VISP_HAVE_THREADS)
+      std::lock_guard<std::mutex> lock(g_mutex_cout);
+#endif
+      std::cout << "> " << caoNbrPoint << " points" << std::endl;
+    }
+
+    if (caoNbrPoint > maxDataCAO) {
+      throw vpException(vpException::badValue, "Exceed the max number of points in the CAO model.");
+    }
+
+    if (caoNbrPoint == 0 && !header) {
+      throw vpException(vpException::badValue, "in vpMbTracker::loadCAOModel() -> no points are defined");
+    }
+    // Index of the points of the file in the points of the model
+    std::vector<uint32_t> caoPoints(caoNbrPoint);
+
+    for (unsigned int k = 0; k < caoNbrPoint; k++) {
+      removeComment(fileId);
+
+      vpColVector pt_3d(4, 1.0);
+      fileId >> pt_3d[0];
+      fileId >> pt_3d[1];
+      fileId >> pt_3d[2];
+
+      if (caoVersion == 2) {
+        // glob values (not used in MBT but for matching)
+        int i, j; // image coordinate (used for matching)
+        fileId >> i;
+        fileId >> j;
+      }
+
+      fileId.ignore(std::numeric_limits<std::streamsize>::max(), fileId.widen('\n')); // skip the rest of the line
+
+      vpColVector pt_3d_tf = odTo * pt_3d;
+      caoPoints[k] = builder.addVertex(pt_3d_tf[0], pt_3d_tf[1], pt_3d_tf[2]);
+    }
+
+    removeComment(fileId);
+
+    //////////////////////////Read the segment declaration part//////////////////////////
+    // Store in a map the potential segments to add
+    std::map<std::pair<unsigned int, unsigned int>, SegmentInfo> segmentTemporaryMap;
+    unsigned int caoNbrLine;
+    fileId >> caoNbrLine;
+    fileId.ignore(std::numeric_limits<std::streamsize>::max(), fileId.widen('\n')); // skip the rest of the line
+
+    builder.nbLines += caoNbrLine;
+    std::vector<unsigned int> caoLinePoints;
+    if (verbose || (parent && !header)) {
+#if defined(VISP_HAVE_THREADS)
+      std::lock_guard<std::mutex> lock(g_mutex_cout);
+#endif
+      std::cout << "> " << caoNbrLine << " lines" << std::endl;
+    }
+
+    if (caoNbrLine > maxDataCAO) {
+      throw vpException(vpException::badValue, "Exceed the max number of lines in the CAO model.");
+    }
+
+    if (caoNbrLine > 0)
+      caoLinePoints.resize(2 * caoNbrLine);
+
+    unsigned int index1, index2;
+    // Initialization of idFace with startIdFace for dealing with recursive
+    // load in header
+    int idFace = startIdFace;
+
+    for (unsigned int k = 0; k < caoNbrLine; k++) {
+      removeComment(fileId);
+
+      fileId >> index1;
+      fileId >> index2;
+
+      //////////////////////////Read the parameter value if present//////////////////////////
+      // Get the end of the line
+      std::string endLine = "";
+      if (safeGetline(fileId, endLine).good()) {
+        std::map<std::string, std::string> mapOfParams = parseParameters(endLine);
+
+        SegmentInfo segmentInfo;
+        if (mapOfParams.find("name") != mapOfParams.end()) {
+          segmentInfo.name = mapOfParams["name"];
+        }
+        if (mapOfParams.find("minLineLengthThreshold") != mapOfParams.end()) {
+          segmentInfo.lengthMode = LOD_EXPLICIT;
+          segmentInfo.minLineLengthThresh = std::atof(mapOfParams["minLineLengthThreshold"].c_str());
+        }
+        if (mapOfParams.find("useLod") != mapOfParams.end()) {
+          segmentInfo.useLodMode = LOD_EXPLICIT;
+          segmentInfo.useLod = vpIoTools::parseBoolean(mapOfParams["useLod"]);
+        }
+
+        caoLinePoints[2 * k] = index1;
+        caoLinePoints[2 * k + 1] = index2;
+
+        if (index1 < caoNbrPoint && index2 < caoNbrPoint) {
+          segmentInfo.extremities.push_back(caoPoints[index1]);
+          segmentInfo.extremities.push_back(caoPoints[index2]);
+
+          std::pair<unsigned int, unsigned int> key(index1, index2);
+
+          segmentTemporaryMap[key] = segmentInfo;
+        }
+        else {
+          vpTRACE(" line %d has wrong coordinates.", k);
+        }
+      }
+    }
+
+    removeComment(fileId);
+
+    //////////////////////////Read the face segment declaration part//////////////////////////
+    /* Load polygon from the lines extracted earlier (the first point of the
+     * line is used)*/
+    // Store in a vector the indexes of the segments added in the face segment
+    // case
+    std::vector<std::pair<unsigned int, unsigned int> > faceSegmentKeyVector;
+    unsigned int caoNbrPolygonLine;
+    fileId >> caoNbrPolygonLine;
+    fileId.ignore(std::numeric_limits<std::streamsize>::max(), fileId.widen('\n')); // skip the rest of the line
+
+    builder.nbPolygonLines += caoNbrPolygonLine;
+    if (verbose || (parent && !header)) {
+#if defined(VISP_HAVE_THREADS)
+      std::lock_guard<std::mutex> lock(g_mutex_cout);
+#endif
+      std::cout << "> " << caoNbrPolygonLine << " polygon lines" << std::endl;
+    }
+
+    if (caoNbrPolygonLine > maxDataCAO) {
+      throw vpException(vpException::badValue, "Exceed the max number of polygon lines.");
+    }
+
+    unsigned int index;
+    for (unsigned int k = 0; k < caoNbrPolygonLine; k++) {
+      removeComment(fileId);
+
+      unsigned int nbLinePol;
+      fileId >> nbLinePol;
+      std::vector<uint32_t> corners;
+      if (nbLinePol > maxDataCAO) {
+        throw vpException(vpException::badValue, "Exceed the max number of lines.");
+      }
+
+      for (unsigned int n = 0; n < nbLinePol; n++) {
+        fileId >> index;
+
+        if (index >= caoNbrLine) {
+          throw vpException(vpException::badValue, "Exceed the max number of lines.");
+        }
+        corners.push_back(caoPoints[caoLinePoints[2 * index]]);
+        corners.push_back(caoPoints[caoLinePoints[2 * index + 1]]);
+
+        std::pair<unsigned int, unsigned int> key(caoLinePoints[2 * index], caoLinePoints[2 * index + 1]);
+        faceSegmentKeyVector.push_back(key);
+      }
+
+      //////////////////////////Read the parameter value if present//////////////////////////
+      // Get the end of the line
+      std::string endLine = "";
+      if (safeGetline(fileId, endLine).good()) {
+        std::map<std::string, std::string> mapOfParams = parseParameters(endLine);
+
+        std::string polygonName = "";
+        vpLodMode useLodMode = LOD_DEFAULT, areaMode = LOD_DEFAULT;
+        bool useLod = false;
+        double minPolygonAreaThreshold = 0.;
+        if (mapOfParams.find("name") != mapOfParams.end()) {
+          polygonName = mapOfParams["name"];
+        }
+        if (mapOfParams.find("minPolygonAreaThreshold") != mapOfParams.end()) {
+          areaMode = LOD_EXPLICIT;
+          minPolygonAreaThreshold = std::atof(mapOfParams["minPolygonAreaThreshold"].c_str());
+        }
+        if (mapOfParams.find("useLod") != mapOfParams.end()) {
+          useLodMode = LOD_EXPLICIT;
+          useLod = vpIoTools::parseBoolean(mapOfParams["useLod"]);
+        }
+
+        builder.addPrimitive(POLYGON_FROM_LINES, idFace++, corners, 0., polygonName, useLodMode, useLod, areaMode,
+                             minPolygonAreaThreshold, LOD_GENERAL, 0.);
+      }
+    }
+
+    // Add the segments which were not already added in the face segment case
+    for (std::map<std::pair<unsigned int, unsigned int>, SegmentInfo>::const_iterator it = segmentTemporaryMap.begin();
+         it != segmentTemporaryMap.end(); ++it) {
+      if (std::find(faceSegmentKeyVector.begin(), faceSegmentKeyVector.end(), it->first) ==
+          faceSegmentKeyVector.end()) {
+        builder.addPrimitive(POLYGON_FROM_POINTS, idFace++, it->second.extremities, 0., it->second.name,
+                             it->second.useLodMode, it->second.useLod, LOD_GENERAL, 0., it->second.lengthMode,
+                             it->second.minLineLengthThresh);
+      }
+    }
+
+    removeComment(fileId);
+
+    //////////////////////////Read the face point declaration part//////////////////////////
+    /* Extract the polygon using the point coordinates (top of the file) */
+    unsigned int caoNbrPolygonPoint;
+    fileId >> caoNbrPolygonPoint;
+    fileId.ignore(std::numeric_limits<std::streamsize>::max(), fileId.widen('\n')); // skip the rest of the line
+
+    builder.nbPolygonPoints += caoNbrPolygonPoint;
+    if (verbose || (parent && !header)) {
+#if defined(VISP_HAVE_THREADS)
+      std::lock_guard<std::mutex> lock(g_mutex_cout);
+#endif
+      std::cout << "> " << caoNbrPolygonPoint << " polygon points" << std::endl;
+    }
+
+    if (caoNbrPolygonPoint > maxDataCAO) {
+      throw vpException(vpException::badValue, "Exceed the max number of polygon point.");
+    }
+
+    for (unsigned int k = 0; k < caoNbrPolygonPoint; k++) {
+      removeComment(fileId);
+
+      unsigned int nbPointPol;
+      fileId >> nbPointPol;
+      if (nbPointPol > maxDataCAO) {
+        throw vpException(vpException::badValue, "Exceed the max number of points.");
+      }
+      std::vector<uint32_t> corners;
+      for (unsigned int n = 0; n < nbPointPol; n++) {
+        fileId >> index;
+        if (index > caoNbrPoint - 1) {
+          throw vpException(vpException::badValue, "Exceed the max number of points.");
+        }
+        corners.push_back(caoPoints[index]);
+      }
+
+      //////////////////////////Read the parameter value if present//////////////////////////
+      // Get the end of the line
+      std::string endLine = "";
+      if (safeGetline(fileId, endLine).good()) {
+        std::map<std::string, std::string> mapOfParams = parseParameters(endLine);
+
+        std::string polygonName = "";
+        vpLodMode useLodMode = LOD_DEFAULT, areaMode = LOD_DEFAULT;
+        bool useLod = false;
+        double minPolygonAreaThreshold = 0.;
+        if (mapOfParams.find("name") != mapOfParams.end()) {
+          polygonName = mapOfParams["name"];
+        }
+        if (mapOfParams.find("minPolygonAreaThreshold") != mapOfParams.end()) {
+          areaMode = LOD_EXPLICIT;
+          minPolygonAreaThreshold = std::atof(mapOfParams["minPolygonAreaThreshold"].c_str());
+        }
+        if (mapOfParams.find("useLod") != mapOfParams.end()) {
+          useLodMode = LOD_EXPLICIT;
+          useLod = vpIoTools::parseBoolean(mapOfParams["useLod"]);
+        }
+
+        builder.addPrimitive(POLYGON_FROM_POINTS, idFace++, corners, 0., polygonName, useLodMode, useLod, areaMode,
+                             minPolygonAreaThreshold, LOD_GENERAL, 0.);
+      }
+    }
+
+    //////////////////////////Read the cylinder declaration part//////////////////////////
+    unsigned int caoNbCylinder;
+    try {
+      removeComment(fileId);
+
+      if (fileId.eof()) { // check if not at the end of the file (for old
+                          // style files)
+        return;
+      }
+
+      /* Extract the cylinders */
+      fileId >> caoNbCylinder;
+      fileId.ignore(std::numeric_limits<std::streamsize>::max(), fileId.widen('\n')); // skip the rest of the line
+
+      builder.nbCylinders += caoNbCylinder;
+      if (verbose || (parent && !header)) {
+#if defined(VISP_HAVE_THREADS)
+        std::lock_guard<std::mutex> lock(g_mutex_cout);
+#endif
+        std::cout << "> " << caoNbCylinder << " cylinders" << std::endl;
+      }
+
+      if (caoNbCylinder > maxDataCAO) {
+        throw vpException(vpException::badValue, "Exceed the max number of cylinders.");
+      }
+
+      for (unsigned int k = 0; k < caoNbCylinder; ++k) {
+        removeComment(fileId);
+
+        double radius;
+        unsigned int indexP1, indexP2;
+        fileId >> indexP1;
+        fileId >> indexP2;
+        fileId >> radius;
+
+        //////////////////////////Read the parameter value if present//////////////////////////
+        // Get the end of the line
+        std::string endLine = "";
+        if (safeGetline(fileId, endLine).good()) {
+          std::map<std::string, std::string> mapOfParams = parseParameters(endLine);
+
+          std::string polygonName = "";
+          vpLodMode useLodMode = LOD_DEFAULT, lengthMode = LOD_DEFAULT;
+          bool useLod = false;
+          double minLineLengthThreshold = 0.;
+          if (mapOfParams.find("name") != mapOfParams.end()) {
+            polygonName = mapOfParams["name"];
+          }
+          if (mapOfParams.find("minLineLengthThreshold") != mapOfParams.end()) {
+            lengthMode = LOD_EXPLICIT;
+            minLineLengthThreshold = std::atof(mapOfParams["minLineLengthThreshold"].c_str());
+          }
+          if (mapOfParams.find("useLod") != mapOfParams.end()) {
+            useLodMode = LOD_EXPLICIT;
+            useLod = vpIoTools::parseBoolean(mapOfParams["useLod"]);
+          }
+
+          std::vector<uint32_t> axis;
+          axis.push_back(caoPoints[indexP1]);
+          axis.push_back(caoPoints[indexP2]);
+          builder.addPrimitive(CYLINDER, idFace, axis, radius, polygonName, useLodMode, useLod, LOD_GENERAL, 0.,
+                               lengthMode, minLineLengthThreshold);
+
+          idFace += 5;
+        }
+      }
+
+    }
+    catch (const std::exception &e) {
+      std::cerr << "Cannot get the number of cylinders. Defaulting to zero." << std::endl;
+      std::cerr << "Exception: " << e.what() << std::endl;
+      caoNbCylinder = 0;
+    }
+
+    //////////////////////////Read the circle declaration part//////////////////////////
+    unsigned int caoNbCircle;
+    try {
+      removeComment(fileId);
+
+      if (fileId.eof()) { // check if not at the end of the file (for old
+                          // style files)
+        return;
+      }
+
+      // To handle CAO model file without no new line at the end, we check if the first char is zero or not
+      // Otherwise "fileId >> caoNbCircle;" gives:
+      //   "Cannot get the number of circles. Defaulting to zero."
+      //   "Exception: basic_ios::clear: iostream error"
+      char c_circle;
+      fileId.get(c_circle);
+      int nb_circles = c_circle - '0';
+      if (nb_circles > 0) {
+        fileId.unget();
+
+        /* Extract the circles */
+        fileId >> caoNbCircle;
+        fileId.ignore(std::numeric_limits<std::streamsize>::max(), fileId.widen('\n')); // skip the rest of the line
+
+        builder.nbCircles += caoNbCircle;
+        if (verbose || (parent && !header)) {
+#if defined(VISP_HAVE_THREADS)
+          std::lock_guard<std::mutex> lock(g_mutex_cout);
+#endif
+          std::cout << "> " << caoNbCircle << " circles" << std::endl;
+        }
+
+        if (caoNbCircle > maxDataCAO) {
+          throw vpException(vpException::badValue, "Exceed the max number of cicles.");
+        }
+
+        for (unsigned int k = 0; k < caoNbCircle; ++k) {
+          removeComment(fileId);
+
+          double radius;
+          unsigned int indexP1, indexP2, indexP3;
+          fileId >> radius;
+          fileId >> indexP1;
+          fileId >> indexP2;
+          fileId >> indexP3;
+
+          //////////////////////////Read the parameter value if present//////////////////////////
+          // Get the end of the line
+          std::string endLine = "";
+          if (safeGetline(fileId, endLine).good()) {
+            std::map<std::string, std::string> mapOfParams = parseParameters(endLine);
+
+            std::string polygonName = "";
+            vpLodMode useLodMode = LOD_DEFAULT, areaMode = LOD_DEFAULT;
+            bool useLod = false;
+            double minPolygonAreaThreshold = 0.;
+            if (mapOfParams.find("name") != mapOfParams.end()) {
+              polygonName = mapOfParams["name"];
+            }
+            if (mapOfParams.find("minPolygonAreaThreshold") != mapOfParams.end()) {
+              areaMode = LOD_EXPLICIT;
+              minPolygonAreaThreshold = std::atof(mapOfParams["minPolygonAreaThreshold"].c_str());
+            }
+            if (mapOfParams.find("useLod") != mapOfParams.end()) {
+              useLodMode = LOD_EXPLICIT;
+              useLod = vpIoTools::parseBoolean(mapOfParams["useLod"]);
+            }
+
+            std::vector<uint32_t> points;
+            points.push_back(caoPoints[indexP1]);
+            points.push_back(caoPoints[indexP2]);
+            points.push_back(caoPoints[indexP3]);
+            builder.addPrimitive(CIRCLE, idFace++, points, radius, polygonName, useLodMode, useLod, areaMode,
+                                 minPolygonAreaThreshold, LOD_GENERAL, 0.);
+          }
+        }
+      }
+    }
+    catch (const std::exception &e) {
+      std::cerr << "Cannot get the number of circles. Defaulting to zero." << std::endl;
+      std::cerr << "Exception: " << e.what() << std::endl;
+      caoNbCircle = 0;
+    }
+
+    startIdFace = idFace;
+
+    if (header && parent) {
+      if (verbose) {
+#if defined(VISP_HAVE_THREADS)
+        std::lock_guard<std::mutex> lock(g_mutex_cout);
+#endif
+        std::cout << "Global information for " << vpIoTools::getName(modelFile) << " :" << std::endl;
+        std::cout << "Total nb of points : " << builder.nbPoints << std::endl;
+        std::cout << "Total nb of lines : " << builder.nbLines << std::endl;
+        std::cout << "Total nb of polygon lines : " << builder.nbPolygonLines << std::endl;
+        std::cout << "Total nb of polygon points : " << builder.nbPolygonPoints << std::endl;
+        std::cout << "Total nb of cylinders : " << builder.nbCylinders << std::endl;
+        std::cout << "Total nb of circles : " << builder.nbCircles << std::endl;
+      }
+      else {
+#if defined(VISP_HAVE_THREADS)
+        std::lock_guard<std::mutex> lock(g_mutex_cout);
+#endif
+        std::cout << "> " << builder.nbPoints << " points" << std::endl;
+        std::cout << "> " << builder.nbLines << " lines" << std::endl;
+        std::cout << "> " << builder.nbPolygonLines << " polygon lines" << std::endl;
+        std::cout << "> " << builder.nbPolygonPoints << " polygon points" << std::endl;
+        std::cout << "> " << builder.nbCylinders << " cylinders" << std::endl;
+        std::cout << "> " << builder.nbCircles << " circles" << std::endl;
+      }
+    }
+
+    // Go up: remove current model
+    vectorOfModelFilename.pop_back();
+  }
+  catch (const std::exception &e) {
+    std::cerr << "Cannot read line!" << std::endl;
+    std::cerr << "Exception: " << e.what() << std::endl;
+    throw vpException(vpException::ioError, "cannot read line");
+  }
+}
+
+/*!
+  Load a compiled model file written by save() or compile(). The file is
+  memory mapped when the platform allows it, otherwise it is read in a single
+  call.
+
+  \throw vpException::ioError if the file cannot be read.
+  \throw vpException::badValue if the file is not a valid compiled model file.
+
+  \param compiledFile : The compiled model file.
+*/
+void vpMbtModel::loadCompiled(const std::string &compiledFile)
+{
+#ifdef VP_MBT_MODEL_HAVE_MMAP
+  int fd = open(compiledFile.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw vpException(vpException::ioError, "Cannot open compiled model file %s", compiledFile.c_str());
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(vpHeader))) {
+    close(fd);
+    throw vpException(vpException::badValue, "File %s is not a compiled model", compiledFile.c_str());
+  }
+  const size_t size = static_cast<size_t>(st.st_size);
+  void *addr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (addr == MAP_FAILED) {
+    throw vpException(vpException::ioError, "Cannot map compiled model file %s", compiledFile.c_str());
+  }
+  std::shared_ptr<const unsigned char> data(static_cast<const unsigned char *>(addr), vpUnmapper(size));
+  const bool mapped = true;
+#else
+  std::ifstream file(compiledFile.c_str(), std::ios::in | std::ios::binary | std::ios::ate);
+  if (!file.is_open()) {
+    throw vpException(vpException::ioError, "Cannot open compiled model file %s", compiledFile.c_str());
+  }
+  const std::streamoff length = static_cast<std::streamoff>(file.tellg());
+  if (length < static_cast<std::streamoff>(sizeof(vpHeader))) {
+    throw vpException(vpException::badValue, "File %s is not a compiled model", compiledFile.c_str());
+  }
+  const size_t size = static_cast<size_t>(length);
+  unsigned char *buffer = new unsigned char[size];
+  std::shared_ptr<const unsigned char> data(buffer, std::default_delete<unsigned char[]>());
+  file.seekg(0, std::ios::beg);
+  if (!file.read(reinterpret_cast<char *>(buffer), static_cast<std::streamsize>(size))) {
+    throw vpException(vpException::ioError, "Cannot read compiled model file %s", compiledFile.c_str());
+  }
+  const bool mapped = false;
+#endif
+
+  vpMbtModel model;
+  model.m_data = data;
+  model.m_size = size;
+  model.m_mapped = mapped;
+  model.check();
+  *this = model;
+}
+
+/*!
+  Load the 3D model of the object from a vrml file. Only LineSet and FaceSet
+  are extracted from the vrml file. See vpMbTracker::loadVRMLModel() for the
+  way cylinders are described.
+
+  \throw vpException::fatalError if the file cannot be open, or if ViSP is not
+  built with Coin.
+
+  \param modelFile : The full name of the file containing the 3D model.
+*/
+void vpMbtModel::loadVRML(const std::string &modelFile)
+{
+#ifdef VISP_HAVE_COIN3D
+  SoDB::init(); // Call SoDB::finish() before ending the program.
+
+  SoInput in;
+  SbBool ok = in.openFile(modelFile.c_str());
+  SoVRMLGroup *sceneGraphVRML2;
+
+  if (!ok) {
+    vpERROR_TRACE("can't open file to load model");
+    throw vpException(vpException::fatalError, "can't open file to load model");
+  }
+
+  if (!in.isFileVRML2()) {
+    SoSeparator *sceneGraph = SoDB::readAll(&in);
+    if (sceneGraph == nullptr) { /*return -1;*/
+    }
+    sceneGraph->ref();
+
+    SoToVRML2Action tovrml2;
+    tovrml2.apply(sceneGraph);
+
+    sceneGraphVRML2 = tovrml2.getVRML2SceneGraph();
+    sceneGraphVRML2->ref();
+    sceneGraph->unref();
+  }
+  else {
+    sceneGraphVRML2 = SoDB::readAllVRML(&in);
+    if (sceneGraphVRML2 == nullptr) { /*return -1;*/
+    }
+    sceneGraphVRML2->ref();
+  }
+
+  in.closeFile();
+
+  vpHomogeneousMatrix transform;
+  int indexFace = 0;
+  loadVRMLGroup(sceneGraphVRML2, transform, indexFace);
+
+  sceneGraphVRML2->unref();
+#else
+  vpERROR_TRACE("coin not detected with ViSP, cannot load model : %s", modelFile.c_str());
+  throw vpException(vpException::fatalError, "coin not detected with ViSP, cannot load model");
+#endif
+}
+
+/*!
+  Write the model into a compiled model file, that can then be loaded by
+  vpMbTracker::loadModel() or load().
+
+  The compiled model file stores the numbers with the byte order of the
+  machine that writes it, and can only be loaded on machines with the same
+  byte order.
+
+  \throw vpException::ioError if the file cannot be written.
+
+  \param compiledFile : The compiled model file to write.
+*/
+void vpMbtModel::save(const std::string &compiledFile) const
+{
+  std::ofstream file(compiledFile.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!file.is_open()) {
+    throw vpException(vpException::ioError, "Cannot create compiled model file %s", compiledFile.c_str());
+  }
+  file.write(reinterpret_cast<const char *>(m_data.get()), static_cast<std::streamsize>(m_size));
+  if (!file) {
+    throw vpException(vpException::ioError, "Cannot write compiled model file %s", compiledFile.c_str());
+  }
+}
+
+void vpMbtModel::build(const vpBuilder &builder)
+{
+  vpHeader header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.magic, g_magic, sizeof(g_magic));
+  header.version = g_version;
+  header.byteOrder = g_byteOrder;
+  header.nbPrimitives = static_cast<uint32_t>(builder.primitives.size());
+  header.nbIndices = static_cast<uint32_t>(builder.indices.size());
+  header.nbVertices = static_cast<uint32_t>(builder.vertices.size() / 3);
+  header.namesSize = static_cast<uint32_t>(builder.names.size());
+  header.nbPoints = builder.nbPoints;
+  header.nbLines = builder.nbLines;
+  header.nbPolygonLines = builder.nbPolygonLines;
+  header.nbPolygonPoints = builder.nbPolygonPoints;
+  header.nbCylinders = builder.nbCylinders;
+  header.nbCircles = builder.nbCircles;
+  header.nbFaceIds = builder.nbFaceIds;
+
+  const vpLayout layout(header);
+  if (!layout.isAddressable()) {
+    throw vpException(vpException::memoryAllocationError, "Model too large");
+  }
+  const size_t size = static_cast<size_t>(layout.size);
+  unsigned char *buffer = new unsigned char[size];
+  m_data = std::shared_ptr<const unsigned char>(buffer, std::default_delete<unsigned char[]>());
+  m_size = size;
+  m_mapped = false;
+
+  std::memset(buffer, 0, size);
+  std::memcpy(buffer, &header, sizeof(header));
+  if (!builder.primitives.empty()) {
+    std::memcpy(buffer + layout.primitives, &builder.primitives[0],
+                builder.primitives.size() * sizeof(vpPrimitive));
+  }
+  if (!builder.indices.empty()) {
+    std::memcpy(buffer + layout.indices, &builder.indices[0], builder.indices.size() * sizeof(uint32_t));
+  }
+  if (!builder.vertices.empty()) {
+    std::memcpy(buffer + layout.vertices, &builder.vertices[0], builder.vertices.size() * sizeof(double));
+  }
+  if (!builder.names.empty()) {
+    std::memcpy(buffer + layout.names, builder.names.data(), builder.names.size());
+  }
+}
+
+void vpMbtModel::check() const
+{
+  const vpHeader &h = header();
+  if (std::memcmp(h.magic, g_magic, sizeof(g_magic)) != 0) {
+    throw vpException(vpException::badValue, "Not a compiled model");
+  }
+  if (h.byteOrder != g_byteOrder) {
+    throw vpException(vpException::badValue, "Compiled model written on a machine with a different byte order");
+  }
+  if (h.version != g_version) {
+    throw vpException(vpException::badValue, "Unsupported compiled model version %u", h.version);
+  }
+  const vpLayout layout(h);
+  if (!layout.isAddressable() || (layout.size != static_cast<uint64_t>(m_size))) {
+    throw vpException(vpException::badValue, "Truncated or corrupted compiled model");
+  }
+
+  const vpPrimitive *prims = primitives();
+  for (unsigned int i = 0; i < h.nbPrimitives; ++i) {
+    const vpPrimitive &primitive = prims[i];
+    const unsigned int minIndices = primitive.type == CYLINDER ? 2 : (primitive.type == CIRCLE ? 3 : 0);
+    if (primitive.type > CIRCLE || primitive.nbIndices < minIndices ||
+        primitive.firstIndex > h.nbIndices || primitive.nbIndices > h.nbIndices - primitive.firstIndex ||
+        primitive.nameOffset > h.namesSize || primitive.nameLength > h.namesSize - primitive.nameOffset) {
+      throw vpException(vpException::badValue, "Corrupted primitive %u in compiled model", i);
+    }
+  }
+  const uint32_t *idx = indices();
+  for (unsigned int i = 0; i < h.nbIndices; ++i) {
+    if (idx[i] >= h.nbVertices) {
+      throw vpException(vpException::badValue, "Corrupted point index %u in compiled model", i);
+    }
+  }
+}
+
+const vpMbtModel::vpHeader &vpMbtModel::header() const
+{
+  return *reinterpret_cast<const vpHeader *>(m_data.get());
+}
+
+const uint32_t *vpMbtModel::indices() const
+{
+  return reinterpret_cast<const uint32_t *>(m_data.get() + static_cast<size_t>(vpLayout(header()).indices));
+}
+
+const char *vpMbtModel::names() const
+{
+  return reinterpret_cast<const char *>(m_data.get() + static_cast<size_t>(vpLayout(header()).names));
+}
+
+const vpMbtModel::vpPrimitive *vpMbtModel::primitives() const
+{
+  return reinterpret_cast<const vpPrimitive *>(m_data.get() + sizeof(vpHeader));
+}
+
+const double *vpMbtModel::vertices() const
+{
+  return reinterpret_cast<const double *>(m_data.get() + static_cast<size_t>(vpLayout(header()).vertices));
+}
+
+#ifdef VISP_HAVE_COIN3D
+/*!
+  Load the cylinder described by a VRML face set, see loadVRML().
+
+  \param face_set : Pointer to the cylinder in the vrml format.
+  \param transform : Transformation matrix applied to the cylinder.
+  \param idFace : Id of the first face of the cylinder, increased by the number of faces of the cylinder.
+  \param polygonName: Name of the polygon.
+*/
+void vpMbtModel::loadVRMLCylinders(SoVRMLIndexedFaceSet *face_set, vpHomogeneousMatrix &transform, int &idFace,
+                                   const std::string &polygonName)
+{
+  vpBuilder builder;
+  extractCylinders(face_set, transform, idFace, polygonName, builder);
+  build(builder);
+}
+
+/*!
+  Load the faces described by a VRML face set, see loadVRML().
+
+  \param face_set : Pointer to the face in the vrml format.
+  \param transform : Transformation matrix applied to the face.
+  \param idFace : Id of the first face, increased by the number of faces.
+  \param polygonName: Name of the polygon.
+*/
+void vpMbtModel::loadVRMLFaces(SoVRMLIndexedFaceSet *face_set, vpHomogeneousMatrix &transform, int &idFace,
+                               const std::string &polygonName)
+{
+  vpBuilder builder;
+  extractFaces(face_set, transform, idFace, polygonName, builder);
+  build(builder);
+}
+
+/*!
+  Load the faces, lines and cylinders of a VRML object Group, see loadVRML().
+
+  \param sceneGraphVRML2 : Current node (either Transform, or Group node).
+  \param transform : Transformation matrix for this group.
+  \param idFace : Id of the first face, increased by the number of faces.
+*/
+void vpMbtModel::loadVRMLGroup(SoVRMLGroup *sceneGraphVRML2, vpHomogeneousMatrix &transform, int &idFace)
+{
+  vpBuilder builder;
+  extractGroup(sceneGraphVRML2, transform, idFace, builder);
+  build(builder);
+}
+
+/*!
+  Load the lines described by a VRML line set, see loadVRML().
+
+  \param line_set : Pointer to the line in the vrml format.
+  \param idFace : Id of the first face, increased by the number of lines.
+  \param polygonName: Name of the polygon.
+*/
+void vpMbtModel::loadVRMLLines(SoVRMLIndexedLineSet *line_set, int &idFace, const std::string &polygonName)
+{
+  vpBuilder builder;
+  extractLines(line_set, idFace, polygonName, builder);
+  build(builder);
+}
+
+/*!
+  Extract a VRML object Group.
+
+  \param sceneGraphVRML2 : Current node (either Transform, or Group node).
+  \param transform : Transformation matrix for this group.
+  \param idFace : Index of the face.
+  \param builder : Model being built.
+*/
+void vpMbtModel::extractGroup(SoVRMLGroup *sceneGraphVRML2, vpHomogeneousMatrix &transform, int &idFace,
+                              vpBuilder &builder)
+{
+  vpHomogeneousMatrix transformCur;
+  SoVRMLTransform *sceneGraphVRML2Trasnform = dynamic_cast<SoVRMLTransform *>(sceneGraphVRML2);
+  if (sceneGraphVRML2Trasnform) {
+    float rx, ry, rz, rw;
+    sceneGraphVRML2Trasnform->rotation.getValue().getValue(rx, ry, rz, rw);
+    vpRotationMatrix rotMat(vpQuaternionVector(rx, ry, rz, rw));
+
+    float tx, ty, tz;
+    tx = sceneGraphVRML2Trasnform->translation.getValue()[0];
+    ty = sceneGraphVRML2Trasnform->translation.getValue()[1];
+    tz = sceneGraphVRML2Trasnform->translation.getValue()[2];
+    vpTranslationVector transVec(tx, ty, tz);
+
+    float sx, sy, sz;
+    sx = sceneGraphVRML2Trasnform->scale.getValue()[0];
+    sy = sceneGraphVRML2Trasnform->scale.getValue()[1];
+    sz = sceneGraphVRML2Trasnform->scale.getValue()[2];
+
+    for (unsigned int i = 0; i < 3; i++)
+      rotMat[0][i] *= sx;
+    for (unsigned int i = 0; i < 3; i++)
+      rotMat[1][i] *= sy;
+    for (unsigned int i = 0; i < 3; i++)
+      rotMat[2][i] *= sz;
+
+    transformCur = vpHomogeneousMatrix(transVec, rotMat);
+    transform = transform * transformCur;
+  }
+
+  int nbShapes = sceneGraphVRML2->getNumChildren();
+
+  SoNode *child;
+
+  for (int i = 0; i < nbShapes; i++) {
+    vpHomogeneousMatrix transform_recursive(transform);
+    child = sceneGraphVRML2->getChild(i);
+
+    if (child->getTypeId() == SoVRMLGroup::getClassTypeId()) {
+      extractGroup((SoVRMLGroup *)child, transform_recursive, idFace, builder);
+    }
+
+    if (child->getTypeId() == SoVRMLTransform::getClassTypeId()) {
+      extractGroup((SoVRMLTransform *)child, transform_recursive, idFace, builder);
+    }
+
+    if (child->getTypeId() == SoVRMLShape::getClassTypeId()) {
+      SoChildList *child2list = child->getChildren();
+      std::string name = child->getName().getString();
+
+      for (int j = 0; j < child2list->getLength(); j++) {
+        if (((SoNode *)child2list->get(j))->getTypeId() == SoVRMLIndexedFaceSet::getClassTypeId()) {
+          SoVRMLIndexedFaceSet *face_set;
+          face_set = (SoVRMLIndexedFaceSet *)child2list->get(j);
+          if (!strncmp(face_set->getName().getString(), "cyl", 3)) {
+            extractCylinders(face_set, transform, idFace, name, builder);
+          }
+          else {
+            extractFaces(face_set, transform, idFace, name, builder);
+          }
+        }
+        if (((SoNode *)child2list->get(j))->getTypeId() == SoVRMLIndexedLineSet::getClassTypeId()) {
+          SoVRMLIndexedLineSet *line_set;
+          line_set = (SoVRMLIndexedLineSet *)child2list->get(j);
+          extractLines(line_set, idFace, name, builder);
+        }
+      }
+    }
+  }
+}
+
+/*!
+  Extract a face of the object to track from the VMRL model.
+
+  \param face_set : Pointer to the face in the vrml format.
+  \param transform : Transformation matrix applied to the face.
+  \param idFace : Face id.
+  \param polygonName: Name of the polygon.
+  \param builder : Model being built.
+*/
+void vpMbtModel::extractFaces(SoVRMLIndexedFaceSet *face_set, vpHomogeneousMatrix &transform, int &idFace,
+                              const std::string &polygonName, vpBuilder &builder)
+{
+  std::vector<uint32_t> corners;
+
+  int indexListSize = face_set->coordIndex.getNum();
+
+  vpColVector pointTransformed(4);
+  SoVRMLCoordinate *coord;
+
+  for (int i = 0; i < indexListSize; i++) {
+    if (face_set->coordIndex[i] == -1) {
+      if (corners.size() > 1) {
+        builder.addPrimitive(POLYGON_FROM_POINTS, idFace++, corners, 0., polygonName, LOD_EXPLICIT, false,
+                             LOD_EXPLICIT, 2500.0, LOD_EXPLICIT, 50.0);
+        corners.resize(0);
+      }
+    }
+    else {
+      coord = (SoVRMLCoordinate *)(face_set->coord.getValue());
+      int index = face_set->coordIndex[i];
+      pointTransformed[0] = coord->point[index].getValue()[0];
+      pointTransformed[1] = coord->point[index].getValue()[1];
+      pointTransformed[2] = coord->point[index].getValue()[2];
+      pointTransformed[3] = 1.0;
+
+      pointTransformed = transform * pointTransformed;
+
+      corners.push_back(builder.addVertex(pointTransformed[0], pointTransformed[1], pointTransformed[2]));
+    }
+  }
+}
+
+/*!
+  Extract a cylinder to track from the VMRL model.
+
+  \param face_set : Pointer to the cylinder in the vrml format.
+  \param transform : Transformation matrix applied to the cylinder.
+  \param idFace : Id of the face.
+  \param polygonName: Name of the polygon.
+  \param builder : Model being built.
+*/
+void vpMbtModel::extractCylinders(SoVRMLIndexedFaceSet *face_set, vpHomogeneousMatrix &transform, int &idFace,
+                                  const std::string &polygonName, vpBuilder &builder)
+{
+  std::vector<vpPoint> corners_c1, corners_c2; // points belonging to the
+                                               // first circle and to the
+                                               // second one.
+  SoVRMLCoordinate *coords = (SoVRMLCoordinate *)face_set->coord.getValue();
+
+  unsigned int indexListSize = (unsigned int)coords->point.getNum();
+
+  if (indexListSize % 2 == 1) {
+    std::cout << "Not an even number of points when extracting a cylinder." << std::endl;
+    throw vpException(vpException::dimensionError, "Not an even number of points when extracting a cylinder.");
+  }
+  corners_c1.resize(indexListSize / 2);
+  corners_c2.resize(indexListSize / 2);
+  vpColVector pointTransformed(4);
+  vpPoint pt;
+
+  // extract all points and fill the two sets.
+
+  for (int i = 0; i < coords->point.getNum(); ++i) {
+    pointTransformed[0] = coords->point[i].getValue()[0];
+    pointTransformed[1] = coords->point[i].getValue()[1];
+    pointTransformed[2] = coords->point[i].getValue()[2];
+    pointTransformed[3] = 1.0;
+
+    pointTransformed = transform * pointTransformed;
+
+    pt.setWorldCoordinates(pointTransformed[0], pointTransformed[1], pointTransformed[2]);
+
+    if (i < (int)corners_c1.size()) {
+      corners_c1[(unsigned int)i] = pt;
+    }
+    else {
+      corners_c2[(unsigned int)i - corners_c1.size()] = pt;
+    }
+  }
+
+  vpPoint p1 = getGravityCenter(corners_c1);
+  vpPoint p2 = getGravityCenter(corners_c2);
+
+  vpColVector dist(3);
+  dist[0] = p1.get_oX() - corners_c1[0].get_oX();
+  dist[1] = p1.get_oY() - corners_c1[0].get_oY();
+  dist[2] = p1.get_oZ() - corners_c1[0].get_oZ();
+  double radius_c1 = sqrt(dist.sumSquare());
+  dist[0] = p2.get_oX() - corners_c2[0].get_oX();
+  dist[1] = p2.get_oY() - corners_c2[0].get_oY();
+  dist[2] = p2.get_oZ() - corners_c2[0].get_oZ();
+  double radius_c2 = sqrt(dist.sumSquare());
+
+  if (std::fabs(radius_c1 - radius_c2) >
+      (std::numeric_limits<double>::epsilon() * vpMath::maximum(radius_c1, radius_c2))) {
+    std::cout << "Radius from the two circles of the cylinders are different." << std::endl;
+    throw vpException(vpException::badValue, "Radius from the two circles of the cylinders are different.");
+  }
+
+  std::vector<uint32_t> axis;
+  axis.push_back(builder.addVertex(p1));
+  axis.push_back(builder.addVertex(p2));
+  builder.addPrimitive(CYLINDER, idFace, axis, radius_c1, polygonName, LOD_EXPLICIT, false, LOD_EXPLICIT, 2500.0,
+                       LOD_EXPLICIT, 50.0);
+
+  idFace += 5;
+}
+
+/*!
+  Extract a line of the object to track from the VMRL model.
+
+  \param line_set : Pointer to the line in the vrml format.
+  \param idFace : Id of the face.
+  \param polygonName: Name of the polygon.
+  \param builder : Model being built.
+*/
+void vpMbtModel::extractLines(SoVRMLIndexedLineSet *line_set, int &idFace, const std::string &polygonName,
+                              vpBuilder &builder)
+{
+  std::vector<uint32_t> corners;
+
+  int indexListSize = line_set->coordIndex.getNum();
+
+  SbVec3f point(0, 0, 0);
+  SoVRMLCoordinate *coord;
+
+  for (int i = 0; i < indexListSize; i++) {
+    if (line_set->coordIndex[i] == -1) {
+      if (corners.size() > 1) {
+        builder.addPrimitive(POLYGON_FROM_POINTS, idFace++, corners, 0., polygonName, LOD_EXPLICIT, false,
+                             LOD_EXPLICIT, 2500.0, LOD_EXPLICIT, 50.0);
+        corners.resize(0);
+      }
+    }
+    else {
+      coord = (SoVRMLCoordinate *)(line_set->coord.getValue());
+      int index = line_set->coordIndex[i];
+      point[0] = coord->point[index].getValue()[0];
+      point[1] = coord->point[index].getValue()[1];
+      point[2] = coord->point[index].getValue()[2];
+
+      corners.push_back(builder.addVertex(point[0], point[1], point[2]));
+    }
+  }
+}
+#endif // VISP_HAVE_COIN3D
+
+END_VISP_NAMESPACE
@@ -0,0 +1,205 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2024 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ *
+ * Description:
+ * Test the depth trackers fed with a raw depth image.
+ */
+
+/*!
+  \example catchMbtDepthImage.cpp
+
+  \brief Test the depth trackers fed with a raw depth image.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2)
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <map>
+
+#include <catch_amalgamated.hpp>
+#include <visp3/core/vpImageConvert.h>
+#include <visp3/core/vpIoTools.h>
+#include <visp3/core/vpPointCloud.h>
+#include <visp3/mbt/vpMbGenericTracker.h>
+
+#ifdef ENABLE_VISP_NAMESPACE
+using namespace VISP_NAMESPACE_NAME;
+#endif
+
+namespace
+{
+const double cubeSize = 0.1;
+const float depthScale = 0.0001f;
+
+// Same cube as the one of the generic RGB-D tutorial, 10 cm wide
+std::string writeCubeModel()
+{
+  const std::string directory = vpIoTools::makeTempDirectory(vpIoTools::getTempPath() + "/catchMbtDepthImage_XXXXXX");
+  const std::string filename = vpIoTools::createFilePath(directory, "cube.cao");
+  std::ofstream file(filename.c_str());
+  file << "V1\n8\n";
+  file << "0 0 0\n" << -cubeSize << " 0 0\n" << -cubeSize << " " << cubeSize << " 0\n0 " << cubeSize << " 0\n";
+  file << "0 0 " << cubeSize << "\n" << -cubeSize << " 0 " << cubeSize << "\n" << -cubeSize << " " << cubeSize << " "
+    << cubeSize << "\n0 " << cubeSize << " " << cubeSize << "\n";
+  file << "0\n0\n6\n4 0 4 5 1\n4 1 5 6 2\n4 6 7 3 2\n4 3 7 4 0\n4 0 1 2 3\n4 7 6 5 4\n0\n0\n";
+  return filename;
+}
+
+// Ray cast the cube, whose corners are between (-cubeSize, 0, 0) and (0, cubeSize, cubeSize) in the object frame
+void renderDepth(const vpCameraParameters &cam, const vpHomogeneousMatrix &cMo, vpImage<uint16_t> &depth_raw)
+{
+  const vpHomogeneousMatrix oMc = cMo.inverse();
+  const vpRotationMatrix oRc = oMc.getRotationMatrix();
+  const vpTranslationVector oTc = oMc.getTranslationVector();
+  const double boxMin[3] = { -cubeSize, 0., 0. }, boxMax[3] = { 0., cubeSize, cubeSize };
+
+  for (unsigned int i = 0; i < depth_raw.getHeight(); ++i) {
+    for (unsigned int j = 0; j < depth_raw.getWidth(); ++j) {
+      const double x = (j - cam.get_u0()) / cam.get_px(), y = (i - cam.get_v0()) / cam.get_py();
+      double tEnter = 0., tExit = std::numeric_limits<double>::max();
+      for (unsigned int k = 0; k < 3; ++k) {
+        const double dir = (oRc[k][0] * x) + (oRc[k][1] * y) + oRc[k][2];
+        const double t1 = (boxMin[k] - oTc[k]) / dir, t2 = (boxMax[k] - oTc[k]) / dir;
+        tEnter = std::max(tEnter, std::min(t1, t2));
+        tExit = std::min(tExit, std::max(t1, t2));
+      }
+      // The Z coordinate of the point of the ray is its parameter
+      depth_raw[i][j] = (tEnter <= tExit) ? static_cast<uint16_t>(vpMath::round(tEnter / depthScale)) : 0;
+    }
+  }
+}
+
+void initTracker(vpMbGenericTracker &tracker, const std::string &model, const vpCameraParameters &cam,
+                 const vpHomogeneousMatrix &cMo)
+{
+  tracker.setCameraParameters(cam);
+  tracker.loadModel(model);
+  tracker.setDepthDenseSamplingStep(2, 2);
+  tracker.setDepthNormalSamplingStep(2, 2);
+  vpImage<unsigned char> I(480, 640);
+  tracker.initFromPose(I, cMo);
+}
+
+bool samePose(const vpHomogeneousMatrix &cMo1, const vpHomogeneousMatrix &cMo2, double translationThresh,
+              double rotationThresh)
+{
+  const vpHomogeneousMatrix cdMc = cMo1 * cMo2.inverse();
+  return (cdMc.getTranslationVector().frobeniusNorm() < translationThresh) &&
+    (vpThetaUVector(cdMc.getRotationMatrix()).getTheta() < rotationThresh);
+}
+} // namespace
+
+TEST_CASE("Depth trackers fed with a raw depth image", "[mbt][depth]")
+{
+  const std::string model = writeCubeModel();
+  const vpCameraParameters cam(600, 600, 320, 240);
+  const vpHomogeneousMatrix cMo = vpHomogeneousMatrix(0.02, -0.01, 0.5, 0.4, -0.6, 0.2) *
+    vpHomogeneousMatrix(cubeSize / 2, -cubeSize / 2, -cubeSize / 2, 0, 0, 0);
+  const vpHomogeneousMatrix cMo_init = vpHomogeneousMatrix(0.005, 0.004, -0.006, vpMath::rad(2), vpMath::rad(-1.5),
+                                                           vpMath::rad(1)) * cMo;
+
+  vpImage<uint16_t> depth_raw(480, 640);
+  renderDepth(cam, cMo, depth_raw);
+  vpPointCloud pointcloud;
+  vpImageConvert::depthToPointCloud(depth_raw, depthScale, cam, pointcloud);
+  REQUIRE(pointcloud.getNumberOfValidPoints() > 1000);
+
+  const int trackerTypes[] = { vpMbGenericTracker::DEPTH_DENSE_TRACKER, vpMbGenericTracker::DEPTH_NORMAL_TRACKER };
+  for (unsigned int t = 0; t < 2; ++t) {
+    INFO("Tracker type " << trackerTypes[t]);
+    vpMbGenericTracker tracker(1, trackerTypes[t]), tracker_pointcloud(1, trackerTypes[t]);
+    initTracker(tracker, model, cam, cMo_init);
+    initTracker(tracker_pointcloud, model, cam, cMo_init);
+
+    const std::string name = tracker.getCameraNames().front();
+    std::map<std::string, const vpImage<unsigned char> *> mapOfImages;
+    mapOfImages[name] = nullptr;
+    std::map<std::string, const vpImage<uint16_t> *> mapOfDepthImages;
+    mapOfDepthImages[name] = &depth_raw;
+    std::map<std::string, const vpPointCloud *> mapOfPointClouds;
+    mapOfPointClouds[name] = &pointcloud;
+
+    for (int iter = 0; iter < 5; ++iter) {
+      tracker.track(mapOfImages, mapOfDepthImages, depthScale);
+      tracker_pointcloud.track(mapOfImages, mapOfPointClouds);
+    }
+    CHECK(samePose(tracker.getPose(), cMo, 1e-3, vpMath::rad(0.2)));
+    // The point cloud is stored in float
+    CHECK(samePose(tracker.getPose(), tracker_pointcloud.getPose(), 1e-5, 1e-4));
+  }
+
+  SECTION("Dense depth tracker")
+  {
+    vpMbDepthDenseTracker tracker;
+    tracker.setCameraParameters(cam);
+    tracker.loadModel(model);
+    tracker.setDepthDenseSamplingStep(2, 2);
+    vpImage<unsigned char> I(480, 640);
+    tracker.initFromPose(I, cMo_init);
+    for (int iter = 0; iter < 5; ++iter) {
+      tracker.track(depth_raw, depthScale);
+    }
+    CHECK(samePose(tracker.getPose(), cMo, 1e-3, vpMath::rad(0.2)));
+  }
+
+  SECTION("Normal depth tracker")
+  {
+    vpMbDepthNormalTracker tracker;
+    tracker.setCameraParameters(cam);
+    tracker.loadModel(model);
+    tracker.setDepthNormalSamplingStep(2, 2);
+    vpImage<unsigned char> I(480, 640);
+    tracker.initFromPose(I, cMo_init);
+    for (int iter = 0; iter < 5; ++iter) {
+      tracker.track(depth_raw, depthScale);
+    }
+    CHECK(samePose(tracker.getPose(), cMo, 1e-3, vpMath::rad(0.2)));
+  }
+
+  vpIoTools::remove(vpIoTools::getParent(model));
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session;
+  session.applyCommandLine(argc, argv);
+  int numFailed = session.run();
+  return numFailed;
+}
+#else
+#include <cstdlib>
+
+int main() { return EXIT_SUCCESS; }
+#endif
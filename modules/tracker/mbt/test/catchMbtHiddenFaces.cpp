@@ -0,0 +1,347 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2024 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test and benchmark the visibility of the faces computed with the bounding
+ * volume hierarchy.
+ */
+
+/*!
+  \example catchMbtHiddenFaces.cpp
+
+  \brief Test and benchmark the visibility of the faces computed with the
+  bounding volume hierarchy.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2)
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <catch_amalgamated.hpp>
+#include <visp3/core/vpUniRand.h>
+#include <visp3/mbt/vpMbHiddenFaces.h>
+
+#ifdef ENABLE_VISP_NAMESPACE
+using namespace VISP_NAMESPACE_NAME;
+#endif
+
+namespace
+{
+bool runBenchmark = false;
+
+// Add a face whose normal points away from the given center
+void addFace(vpMbHiddenFaces<vpMbtPolygon> &faces, std::vector<vpPoint> points, const vpColVector &center)
+{
+  vpColVector normal(3), centroid(3);
+  for (size_t i = 0; i < points.size(); ++i) {
+    const vpPoint &cur = points[i], &next = points[(i + 1) % points.size()];
+    normal[0] += (cur.get_oY() - next.get_oY()) * (cur.get_oZ() + next.get_oZ());
+    normal[1] += (cur.get_oZ() - next.get_oZ()) * (cur.get_oX() + next.get_oX());
+    normal[2] += (cur.get_oX() - next.get_oX()) * (cur.get_oY() + next.get_oY());
+    centroid[0] += cur.get_oX();
+    centroid[1] += cur.get_oY();
+    centroid[2] += cur.get_oZ();
+  }
+  centroid /= static_cast<double>(points.size());
+  if (vpColVector::dotProd(normal, centroid - center) < 0) {
+    std::reverse(points.begin(), points.end());
+  }
+
+  vpMbtPolygon polygon;
+  polygon.setNbPoint(static_cast<unsigned int>(points.size()));
+  for (size_t i = 0; i < points.size(); ++i) {
+    polygon.addPoint(static_cast<unsigned int>(i), points[i]);
+  }
+  polygon.setIndex(static_cast<int>(faces.size()));
+  faces.addPolygon(&polygon);
+}
+
+void addCube(vpMbHiddenFaces<vpMbtPolygon> &faces, double x, double y, double z, double halfSize)
+{
+  vpColVector center(3);
+  center[0] = x;
+  center[1] = y;
+  center[2] = z;
+  for (unsigned int axis = 0; axis < 3; ++axis) {
+    for (int side = -1; side <= 1; side += 2) {
+      std::vector<vpPoint> points;
+      const double corners[4][2] = { { -1, -1 }, { 1, -1 }, { 1, 1 }, { -1, 1 } };
+      for (unsigned int k = 0; k < 4; ++k) {
+        double P[3];
+        P[axis] = side * halfSize;
+        P[(axis + 1) % 3] = corners[k][0] * halfSize;
+        P[(axis + 2) % 3] = corners[k][1] * halfSize;
+        points.push_back(vpPoint(x + P[0], y + P[1], z + P[2]));
+      }
+      addFace(faces, points, center);
+    }
+  }
+}
+
+// Tessellated sphere surrounded by small cubes, plus a line and a face without orientation
+void createModel(vpMbHiddenFaces<vpMbtPolygon> &faces, unsigned int nbLatitudes, unsigned int nbLongitudes)
+{
+  const double radius = 0.3;
+  const vpColVector origin(3, 0.);
+  for (unsigned int i = 0; i < nbLatitudes; ++i) {
+    const double lat0 = vpMath::rad(-80 + (160. * i) / nbLatitudes);
+    const double lat1 = vpMath::rad(-80 + (160. * (i + 1)) / nbLatitudes);
+    for (unsigned int j = 0; j < nbLongitudes; ++j) {
+      const double lon0 = (2 * M_PI * j) / nbLongitudes, lon1 = (2 * M_PI * (j + 1)) / nbLongitudes;
+      std::vector<vpPoint> points;
+      points.push_back(vpPoint(radius * cos(lat0) * cos(lon0), radius * cos(lat0) * sin(lon0), radius * sin(lat0)));
+      points.push_back(vpPoint(radius * cos(lat0) * cos(lon1), radius * cos(lat0) * sin(lon1), radius * sin(lat0)));
+      points.push_back(vpPoint(radius * cos(lat1) * cos(lon1), radius * cos(lat1) * sin(lon1), radius * sin(lat1)));
+      points.push_back(vpPoint(radius * cos(lat1) * cos(lon0), radius * cos(lat1) * sin(lon0), radius * sin(lat1)));
+      addFace(faces, points, origin);
+    }
+  }
+
+  for (int x = -1; x <= 1; ++x) {
+    for (int y = -1; y <= 1; ++y) {
+      for (int z = -1; z <= 1; ++z) {
+        if ((x != 0) || (y != 0) || (z != 0)) {
+          addCube(faces, 0.45 * x, 0.45 * y, 0.45 * z, 0.03);
+        }
+      }
+    }
+  }
+
+  vpMbtPolygon line;
+  line.setNbPoint(2);
+  line.addPoint(0, vpPoint(0, 0, 0.5));
+  line.addPoint(1, vpPoint(0, 0, 0.7));
+  line.setIndex(static_cast<int>(faces.size()));
+  faces.addPolygon(&line);
+
+  vpMbtPolygon notOriented;
+  notOriented.setNbPoint(3);
+  notOriented.addPoint(0, vpPoint(0.5, 0, 0));
+  notOriented.addPoint(1, vpPoint(0.6, 0, 0));
+  notOriented.addPoint(2, vpPoint(0.6, 0.1, 0));
+  notOriented.setIsPolygonOriented(false);
+  notOriented.setIndex(static_cast<int>(faces.size()));
+  faces.addPolygon(&notOriented);
+}
+
+// Random pose looking at the model from the given distance
+vpHomogeneousMatrix randomPose(vpUniRand &rng, double distanceMin, double distanceMax, double offset)
+{
+  return vpHomogeneousMatrix(rng.uniform(-offset, offset), rng.uniform(-offset, offset),
+                             rng.uniform(distanceMin, distanceMax), rng.uniform(-M_PI, M_PI),
+                             rng.uniform(-M_PI, M_PI), rng.uniform(-M_PI, M_PI));
+}
+
+// Historical visibility computation that tests all the faces one by one
+unsigned int setVisibleBruteForce(vpMbHiddenFaces<vpMbtPolygon> &faces, unsigned int width, unsigned int height,
+                                  const vpCameraParameters &cam, const vpHomogeneousMatrix &cMo,
+                                  double angleAppears, double angleDisappears, bool &changed)
+{
+  changed = false;
+  unsigned int nbVisible = 0;
+  for (unsigned int i = 0; i < faces.size(); ++i) {
+    if (faces.computeVisibility(cMo, angleAppears, angleDisappears, changed, false, true, width, height, cam,
+                                vpTranslationVector(), i)) {
+      ++nbVisible;
+    }
+  }
+  return nbVisible;
+}
+} // namespace
+
+TEST_CASE("Visibility with the bounding volume hierarchy", "[mbt][visibility]")
+{
+  const unsigned int width = 640, height = 480;
+  const vpCameraParameters cam(600, 600, 320, 240);
+  const double angleAppears = vpMath::rad(85), angleDisappears = vpMath::rad(89);
+
+  vpMbHiddenFaces<vpMbtPolygon> faces;
+  createModel(faces, 32, 64);
+  vpMbHiddenFaces<vpMbtPolygon> faces_ref(faces);
+  vpUniRand rng(42);
+
+  SECTION("Back-face culling gives the same visibility as the per-face test")
+  {
+    for (int iter = 0; iter < 100; ++iter) {
+      const vpHomogeneousMatrix cMo = randomPose(rng, 0.8, 3., 0.5);
+      bool changed = false, changed_ref = false;
+      const unsigned int nbVisible =
+        faces.setVisible(width, height, cam, cMo, angleAppears, angleDisappears, changed);
+      const unsigned int nbVisible_ref =
+        setVisibleBruteForce(faces_ref, width, height, cam, cMo, angleAppears, angleDisappears, changed_ref);
+
+      REQUIRE(nbVisible == nbVisible_ref);
+      CHECK(changed == changed_ref);
+      CHECK(nbVisible == faces.getNbVisiblePolygon());
+      for (unsigned int i = 0; i < faces.size(); ++i) {
+        INFO("Iteration " << iter << ", face " << i);
+        REQUIRE(faces.isVisible(i) == faces_ref.isVisible(i));
+        REQUIRE(faces.isAppearing(i) == faces_ref.isAppearing(i));
+      }
+    }
+    // The hierarchy is built once and half of the sphere is back-facing
+    CHECK(faces.getBoundingVolumeHierarchy().getNbFaces() == faces.size());
+    CHECK(faces.getBoundingVolumeHierarchy().getNbNodes() > 1);
+  }
+
+  SECTION("Frustum culling only hides faces outside of the image")
+  {
+    faces.setFrustumCulling(true);
+    vpCameraParameters cam_fov = cam;
+    cam_fov.computeFov(width, height);
+
+    unsigned int nbFrustumCulled = 0;
+    for (int iter = 0; iter < 50; ++iter) {
+      const vpHomogeneousMatrix cMo = randomPose(rng, 0.4, 1., 0.4);
+      // Faces hidden by the frustum use the appearance angle afterward, so start from the same state
+      faces_ref = faces;
+      bool changed = false, changed_ref = false;
+      faces.setVisible(width, height, cam, cMo, angleAppears, angleDisappears, changed);
+      setVisibleBruteForce(faces_ref, width, height, cam, cMo, angleAppears, angleDisappears, changed_ref);
+
+      for (unsigned int i = 0; i < faces.size(); ++i) {
+        INFO("Iteration " << iter << ", face " << i);
+        if (faces.isVisible(i)) {
+          REQUIRE(faces_ref.isVisible(i));
+        }
+        else if (faces_ref.isVisible(i)) {
+          // The face has to be entirely outside the field of view
+          vpMbtPolygon polygon(*faces_ref[i]);
+          polygon.setClipping(vpPolygon3D::NEAR_CLIPPING | vpPolygon3D::FOV_CLIPPING);
+          polygon.changeFrame(cMo);
+          polygon.computePolygonClipped(cam_fov);
+          std::vector<std::pair<vpPoint, unsigned int> > clipped;
+          polygon.getPolygonClipped(clipped);
+          REQUIRE(clipped.empty());
+          ++nbFrustumCulled;
+        }
+      }
+    }
+    CHECK(nbFrustumCulled > 0);
+  }
+
+  SECTION("Ray casting")
+  {
+    // Small square in front of a larger one, both facing the camera that looks toward +Z
+    vpMbHiddenFaces<vpMbtPolygon> squares;
+    const vpColVector behind(3, 1.);
+    std::vector<vpPoint> front, back;
+    const double corners[4][2] = { { -1, -1 }, { 1, -1 }, { 1, 1 }, { -1, 1 } };
+    for (unsigned int k = 0; k < 4; ++k) {
+      front.push_back(vpPoint(0.05 * corners[k][0], 0.05 * corners[k][1], 0.));
+      back.push_back(vpPoint(0.1 * corners[k][0], 0.1 * corners[k][1], 0.1));
+    }
+    addFace(squares, front, behind);
+    addFace(squares, back, behind);
+    squares.setRayCastingVisibilityTest(true);
+
+    bool changed = false;
+    // Camera on the optical axis of the squares, 1 meter away from the front one
+    vpHomogeneousMatrix cMo(0, 0, 1, 0, 0, 0);
+    CHECK(squares.setVisible(width, height, cam, cMo, angleAppears, angleDisappears, changed) == 1);
+    CHECK(squares.isVisible(0));
+    CHECK_FALSE(squares.isVisible(1));
+
+    // Camera moved aside, the center of the back square is no more occluded
+    cMo.buildFrom(-1, 0, 1, 0, 0, 0);
+    CHECK(squares.setVisible(width, height, cam, cMo, angleAppears, angleDisappears, changed) == 2);
+    CHECK(changed);
+    CHECK(squares.isVisible(1));
+
+    // With several rays, the back square is partially occluded
+    squares.setNbRayCastingAttemptsForVisibility(100);
+    squares.setGoodNbRayCastingAttemptsRatio(0.99);
+    cMo.buildFrom(-0.1, 0, 1, 0, 0, 0);
+    squares.setVisible(width, height, cam, cMo, angleAppears, angleDisappears, changed);
+    CHECK_FALSE(squares.isVisible(1));
+    squares.setGoodNbRayCastingAttemptsRatio(0.01);
+    squares.setVisible(width, height, cam, cMo, angleAppears, angleDisappears, changed);
+    CHECK(squares.isVisible(1));
+
+    // Without ray casting, only the angle is tested
+    squares.setRayCastingVisibilityTest(false);
+    cMo.buildFrom(0, 0, 1, 0, 0, 0);
+    CHECK(squares.setVisible(width, height, cam, cMo, angleAppears, angleDisappears, changed) == 2);
+  }
+}
+
+TEST_CASE("Visibility benchmark", "[benchmark]")
+{
+  if (runBenchmark) {
+    const unsigned int width = 640, height = 480;
+    const vpCameraParameters cam(600, 600, 320, 240);
+    const double angleAppears = vpMath::rad(85), angleDisappears = vpMath::rad(89);
+
+    // Around 50k faces
+    vpMbHiddenFaces<vpMbtPolygon> faces;
+    createModel(faces, 160, 312);
+    vpMbHiddenFaces<vpMbtPolygon> faces_frustum(faces), faces_ref(faces);
+    faces_frustum.setFrustumCulling(true);
+    const vpHomogeneousMatrix cMo(0.05, -0.02, 0.5, vpMath::rad(10), vpMath::rad(20), 0);
+    bool changed = false;
+
+    BENCHMARK("Benchmark per-face visibility")
+    {
+      return setVisibleBruteForce(faces_ref, width, height, cam, cMo, angleAppears, angleDisappears, changed);
+    };
+    BENCHMARK("Benchmark visibility with back-face culling")
+    {
+      return faces.setVisible(width, height, cam, cMo, angleAppears, angleDisappears, changed);
+    };
+    BENCHMARK("Benchmark visibility with back-face and frustum culling")
+    {
+      return faces_frustum.setVisible(width, height, cam, cMo, angleAppears, angleDisappears, changed);
+    };
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session;
+
+  auto cli = session.cli()         // Get Catch's composite command line parser
+    | Catch::Clara::Opt(runBenchmark)   // bind variable to a new option, with a hint string
+    ["--benchmark"] // the option names it will respond to
+    ("run benchmark of the visibility computation"); // description string for the help output
+
+  // Now pass the new composite back to Catch so it uses that
+  session.cli(cli);
+  session.applyCommandLine(argc, argv);
+  int numFailed = session.run();
+  return numFailed;
+}
+#else
+#include <cstdlib>
+
+int main() { return EXIT_SUCCESS; }
+#endif
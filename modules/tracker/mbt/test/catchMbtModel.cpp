@@ -0,0 +1,508 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2024 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test and benchmark the compiled models of the model-based tracker.
+ */
+
+/*!
+  \example catchMbtModel.cpp
+
+  \brief Test and benchmark the compiled models of the model-based tracker.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2)
+
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <list>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <catch_amalgamated.hpp>
+#include <visp3/core/vpIoTools.h>
+#include <visp3/mbt/vpMbGenericTracker.h>
+#include <visp3/mbt/vpMbtModel.h>
+
+#ifdef ENABLE_VISP_NAMESPACE
+using namespace VISP_NAMESPACE_NAME;
+#endif
+
+namespace
+{
+bool runBenchmark = false;
+
+void writeFile(const std::string &filename, const std::string &content)
+{
+  std::ofstream file(filename.c_str(), std::ios::out | std::ios::binary);
+  file << content;
+}
+
+// Model with lines, faces, cylinders, circles and level of detail settings, that includes an other model twice and
+// an old style model without cylinders and circles
+void writeModels(const std::string &directory)
+{
+  writeFile(vpIoTools::createFilePath(directory, "part.cao"),
+            "V1\n"
+            "# Points\n"
+            "4\n"
+            "0 0 0\n"
+            "0.1 0 0\n"
+            "0.1 0.1 0\n"
+            "0 0.1 0\n"
+            "# Lines\n"
+            "3\n"
+            "0 1 name=edge useLod=true minLineLengthThreshold=20\n"
+            "1 2\n"
+            "2 3\n"
+            "# Faces from lines\n"
+            "1\n"
+            "3 0 1 2 name=\"face lines\" minPolygonAreaThreshold=300\n"
+            "# Faces from points\n"
+            "1\n"
+            "4 0 1 2 3 useLod=false\n"
+            "# Cylinders\n"
+            "1\n"
+            "0 2 0.02 name=cylinder minLineLengthThreshold=10\n"
+            "# Circles\n"
+            "1\n"
+            "0.05 0 1 3 name=circle useLod=true\n");
+  writeFile(vpIoTools::createFilePath(directory, "old.cao"),
+            "V1\n"
+            "3\n"
+            "0 0 0.2\n"
+            "0.1 0 0.2\n"
+            "0 0.1 0.2\n"
+            "2\n"
+            "0 1\n"
+            "1 2\n"
+            "0\n"
+            "1\n"
+            "3 0 1 2\n");
+  writeFile(vpIoTools::createFilePath(directory, "object.cao"),
+            "V1\n"
+            "load(\"part.cao\", t=[0.1;0;0], tu=[0;0;90deg])\n"
+            "load(\"old.cao\")\n"
+            "load(\"part.cao\", t=[0;0.2;0])\n"
+            "5\n"
+            "0 0 0.3\n"
+            "0.2 0 0.3\n"
+            "0.2 0.2 0.3\n"
+            "0 0.2 0.3\n"
+            "0.1 0.1 0.4\n"
+            "4\n"
+            "0 1 name=l0\n"
+            "1 2\n"
+            "2 3\n"
+            "3 4 useLod=true\n"
+            "1\n"
+            "2 0 1\n"
+            "2\n"
+            "3 0 1 4 name=triangle\n"
+            "4 0 1 2 3\n"
+            "2\n"
+            "0 2 0.01\n"
+            "1 3 0.02 useLod=true\n"
+            "2\n"
+            "0.1 4 0 1\n"
+            "0.2 4 1 2 minPolygonAreaThreshold=10\n");
+}
+
+// Large model made of a grid of quads
+void writeLargeModel(const std::string &filename, unsigned int n)
+{
+  std::ofstream file(filename.c_str());
+  file << "V1\n" << (n + 1) * (n + 1) << "\n";
+  for (unsigned int i = 0; i <= n; ++i) {
+    for (unsigned int j = 0; j <= n; ++j) {
+      file << 0.01 * i << " " << 0.01 * j << " " << 0.001 * ((i * j) % 7) << "\n";
+    }
+  }
+  file << "0\n0\n" << n * n << "\n";
+  for (unsigned int i = 0; i < n; ++i) {
+    for (unsigned int j = 0; j < n; ++j) {
+      const unsigned int k = i * (n + 1) + j;
+      file << "4 " << k << " " << k + 1 << " " << k + n + 2 << " " << k + n + 1 << " name=face_" << i << "_" << j
+        << "\n";
+    }
+  }
+  file << "0\n0\n";
+}
+
+void loadModel(vpMbGenericTracker &tracker, const std::string &modelFile, bool lod,
+               const vpHomogeneousMatrix &odTo = vpHomogeneousMatrix())
+{
+  if (lod) {
+    tracker.setLod(true);
+    tracker.setMinLineLengthThresh(33.);
+    tracker.setMinPolygonAreaThresh(444.);
+  }
+  tracker.loadModel(modelFile, false, odTo);
+}
+
+bool samePoint(const vpPoint &P1, const vpPoint &P2, double eps)
+{
+  return std::fabs(P1.get_oX() - P2.get_oX()) <= eps && std::fabs(P1.get_oY() - P2.get_oY()) <= eps &&
+    std::fabs(P1.get_oZ() - P2.get_oZ()) <= eps;
+}
+
+// Check that two trackers have the same faces, lines, cylinders and circles
+void checkSameModel(vpMbGenericTracker &tracker1, vpMbGenericTracker &tracker2, double eps)
+{
+  vpMbHiddenFaces<vpMbtPolygon> &faces1 = tracker1.getFaces();
+  vpMbHiddenFaces<vpMbtPolygon> &faces2 = tracker2.getFaces();
+  REQUIRE(faces1.size() == faces2.size());
+  for (unsigned int i = 0; i < faces1.size(); ++i) {
+    INFO("Face " << i);
+    const vpMbtPolygon &f1 = *faces1[i];
+    const vpMbtPolygon &f2 = *faces2[i];
+    CHECK(f1.getIndex() == f2.getIndex());
+    CHECK(f1.getName() == f2.getName());
+    CHECK(f1.useLod == f2.useLod);
+    CHECK(f1.minLineLengthThresh == f2.minLineLengthThresh);
+    CHECK(f1.minPolygonAreaThresh == f2.minPolygonAreaThresh);
+    REQUIRE(f1.getNbPoint() == f2.getNbPoint());
+    for (unsigned int j = 0; j < f1.getNbPoint(); ++j) {
+      CHECK(samePoint(f1.p[j], f2.p[j], eps));
+    }
+  }
+
+  std::list<vpMbtDistanceLine *> lines1, lines2;
+  tracker1.getLline(lines1);
+  tracker2.getLline(lines2);
+  REQUIRE(lines1.size() == lines2.size());
+  for (std::list<vpMbtDistanceLine *>::const_iterator it1 = lines1.begin(), it2 = lines2.begin(); it1 != lines1.end();
+       ++it1, ++it2) {
+    CHECK((*it1)->getName() == (*it2)->getName());
+    CHECK((*it1)->Lindex_polygon == (*it2)->Lindex_polygon);
+    CHECK(samePoint(*(*it1)->p1, *(*it2)->p1, eps));
+    CHECK(samePoint(*(*it1)->p2, *(*it2)->p2, eps));
+  }
+
+  std::list<vpMbtDistanceCylinder *> cylinders1, cylinders2;
+  tracker1.getLcylinder(cylinders1);
+  tracker2.getLcylinder(cylinders2);
+  REQUIRE(cylinders1.size() == cylinders2.size());
+  for (std::list<vpMbtDistanceCylinder *>::const_iterator it1 = cylinders1.begin(), it2 = cylinders2.begin();
+       it1 != cylinders1.end(); ++it1, ++it2) {
+    CHECK((*it1)->getName() == (*it2)->getName());
+    CHECK((*it1)->index_polygon == (*it2)->index_polygon);
+    CHECK((*it1)->radius == (*it2)->radius);
+    CHECK(samePoint(*(*it1)->p1, *(*it2)->p1, eps));
+  }
+
+  std::list<vpMbtDistanceCircle *> circles1, circles2;
+  tracker1.getLcircle(circles1);
+  tracker2.getLcircle(circles2);
+  REQUIRE(circles1.size() == circles2.size());
+  for (std::list<vpMbtDistanceCircle *>::const_iterator it1 = circles1.begin(), it2 = circles2.begin();
+       it1 != circles1.end(); ++it1, ++it2) {
+    CHECK((*it1)->getName() == (*it2)->getName());
+    CHECK((*it1)->index_polygon == (*it2)->index_polygon);
+    CHECK((*it1)->radius == (*it2)->radius);
+    CHECK(samePoint(*(*it1)->p1, *(*it2)->p1, eps));
+  }
+}
+} // namespace
+
+TEST_CASE("Compiled model", "[mbt][model]")
+{
+  const std::string tmp_dir = vpIoTools::makeTempDirectory(vpIoTools::getTempPath());
+  writeModels(tmp_dir);
+  const std::string modelFile = vpIoTools::createFilePath(tmp_dir, "object.cao");
+  const std::string compiledFile = vpIoTools::createFilePath(tmp_dir, "object.bin");
+  const vpHomogeneousMatrix odTo(0.01, 0.02, 0.03, 0.1, 0.2, 0.3);
+
+  SECTION("A tracker loads the same model from the text and from the compiled model")
+  {
+    vpMbtModel::compile(modelFile, compiledFile, false, odTo);
+    REQUIRE(vpMbtModel::isCompiledModel(compiledFile));
+    CHECK_FALSE(vpMbtModel::isCompiledModel(modelFile));
+
+    vpMbtModel model;
+    model.load(compiledFile);
+    std::ifstream file(compiledFile.c_str(), std::ios::binary | std::ios::ate);
+    CHECK(model.getSize() == static_cast<size_t>(file.tellg()));
+    CHECK(model.getNbPoints() == 16);
+    CHECK(model.getNbCylinders() == 4);
+    CHECK(model.getNbCircles() == 4);
+
+    for (int lod = 0; lod < 2; ++lod) {
+      INFO("Level of detail " << lod);
+      vpMbGenericTracker tracker_text(1, vpMbGenericTracker::EDGE_TRACKER);
+      vpMbGenericTracker tracker_compiled(1, vpMbGenericTracker::EDGE_TRACKER);
+      loadModel(tracker_text, modelFile, lod != 0, odTo);
+      loadModel(tracker_compiled, compiledFile, lod != 0);
+      checkSameModel(tracker_text, tracker_compiled, 0.);
+    }
+  }
+
+  SECTION("The transformation is applied to the points of a compiled model")
+  {
+    vpMbtModel::compile(modelFile, compiledFile);
+    vpMbGenericTracker tracker_text(1, vpMbGenericTracker::EDGE_TRACKER);
+    vpMbGenericTracker tracker_compiled(1, vpMbGenericTracker::EDGE_TRACKER);
+    loadModel(tracker_text, modelFile, false, odTo);
+    loadModel(tracker_compiled, compiledFile, false, odTo);
+    checkSameModel(tracker_text, tracker_compiled, 1e-12);
+  }
+
+  SECTION("Copies share the model buffer")
+  {
+    vpMbtModel model;
+    model.load(modelFile);
+    vpMbtModel copy = model;
+    CHECK(copy.getNbPrimitives() == model.getNbPrimitives());
+    CHECK(&copy.getPrimitive(0) == &model.getPrimitive(0));
+    for (unsigned int i = 0; i < model.getNbPrimitives(); ++i) {
+      CHECK(copy.getPrimitiveName(i) == model.getPrimitiveName(i));
+    }
+  }
+
+  SECTION("Invalid compiled models are rejected")
+  {
+    vpMbtModel model;
+    model.load(modelFile);
+    model.save(compiledFile);
+
+    // Truncated file
+    std::string content;
+    {
+      std::ifstream file(compiledFile.c_str(), std::ios::binary);
+      content.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+    const std::string truncatedFile = vpIoTools::createFilePath(tmp_dir, "truncated.bin");
+    writeFile(truncatedFile, content.substr(0, content.size() - 1));
+    CHECK_THROWS_AS(model.load(truncatedFile), vpException);
+
+    // Number of points whose size in bytes wraps around in 32 bits: 0x55555556 * 3 = 2 modulo 2^32. The vertices
+    // section is shortened to this wrapped size so that only a 64 bits computation of the layout detects it.
+    {
+      vpMbtModel::vpHeader header;
+      std::memcpy(&header, content.data(), sizeof(header));
+      const size_t verticesOffset = sizeof(header) + (header.nbPrimitives * sizeof(vpMbtModel::vpPrimitive)) +
+        ((((header.nbIndices * sizeof(uint32_t)) + 7) / 8) * 8);
+      const size_t namesOffset = verticesOffset + (header.nbVertices * 3 * sizeof(double));
+      header.nbVertices = 0x55555556;
+      const uint32_t wrappedVerticesSize = static_cast<uint32_t>(header.nbVertices * 3) * sizeof(double);
+      REQUIRE(wrappedVerticesSize <= namesOffset - verticesOffset);
+
+      std::string corrupted = content.substr(0, verticesOffset + wrappedVerticesSize) + content.substr(namesOffset);
+      std::memcpy(&corrupted[0], &header, sizeof(header));
+      const std::string corruptedFile = vpIoTools::createFilePath(tmp_dir, "corrupted.bin");
+      writeFile(corruptedFile, corrupted);
+      CHECK_THROWS_AS(model.load(corruptedFile), vpException);
+    }
+
+    // Unknown file
+    const std::string unknownFile = vpIoTools::createFilePath(tmp_dir, "unknown.bin");
+    writeFile(unknownFile, "not a model");
+    CHECK_THROWS_AS(model.load(unknownFile), vpException);
+    vpMbGenericTracker tracker(1, vpMbGenericTracker::EDGE_TRACKER);
+    CHECK_THROWS_AS(tracker.loadModel(unknownFile), vpException);
+  }
+
+  vpIoTools::remove(tmp_dir);
+}
+
+TEST_CASE("Shared model", "[mbt][model]")
+{
+  const std::string tmp_dir = vpIoTools::makeTempDirectory(vpIoTools::getTempPath());
+  writeModels(tmp_dir);
+  const std::string modelFile = vpIoTools::createFilePath(tmp_dir, "object.cao");
+  const std::string compiledFile = vpIoTools::createFilePath(tmp_dir, "object.bin");
+  const vpHomogeneousMatrix odTo(0.01, 0.02, 0.03, 0.1, 0.2, 0.3);
+  vpMbtModel::compile(modelFile, compiledFile);
+
+  std::vector<int> trackerTypes;
+  trackerTypes.push_back(vpMbGenericTracker::EDGE_TRACKER);
+  trackerTypes.push_back(vpMbGenericTracker::EDGE_TRACKER | vpMbGenericTracker::DEPTH_NORMAL_TRACKER);
+  trackerTypes.push_back(vpMbGenericTracker::DEPTH_DENSE_TRACKER);
+  std::vector<std::string> cameraNames;
+  cameraNames.push_back("Camera1");
+  cameraNames.push_back("Camera2");
+  cameraNames.push_back("Camera3");
+
+  SECTION("The cameras of a generic tracker share the model they load")
+  {
+    const std::string files[] = { modelFile, compiledFile };
+    for (size_t k = 0; k < 2; ++k) {
+      INFO("Model file " << files[k]);
+      vpMbGenericTracker tracker(trackerTypes);
+      tracker.loadModel(files[k], false, odTo);
+
+      vpMbGenericTracker tracker_single(1, vpMbGenericTracker::EDGE_TRACKER);
+      tracker_single.loadModel(files[k], false, odTo);
+      checkSameModel(tracker_single, tracker, 0.);
+
+      const vpMbtModel::vpPrimitive *primitive = &tracker.getModel().getPrimitive(0);
+      for (size_t i = 0; i < cameraNames.size(); ++i) {
+        tracker.setReferenceCameraName(cameraNames[i]);
+        CHECK(&tracker.getModel().getPrimitive(0) == primitive);
+        CHECK(tracker.getFaces().size() == tracker_single.getFaces().size());
+        // Faces keep the state of each camera
+        if (i > 0) {
+          CHECK(tracker.getFaces(cameraNames[i])[0] != tracker.getFaces(cameraNames[0])[0]);
+        }
+      }
+    }
+  }
+
+  SECTION("Each distinct model file and transformation is loaded once")
+  {
+    std::map<std::string, std::string> mapOfModelFiles;
+    std::map<std::string, vpHomogeneousMatrix> mapOfT;
+    for (size_t i = 0; i < cameraNames.size(); ++i) {
+      mapOfModelFiles[cameraNames[i]] = modelFile;
+    }
+    mapOfT[cameraNames[0]] = odTo;
+
+    vpMbGenericTracker tracker(trackerTypes);
+    tracker.loadModel(mapOfModelFiles, false, mapOfT);
+    tracker.setReferenceCameraName(cameraNames[2]);
+    const vpMbtModel::vpPrimitive *primitive = &tracker.getModel().getPrimitive(0);
+    tracker.setReferenceCameraName(cameraNames[1]);
+    CHECK(&tracker.getModel().getPrimitive(0) == primitive);
+    tracker.setReferenceCameraName(cameraNames[0]);
+    CHECK(&tracker.getModel().getPrimitive(0) != primitive);
+
+    vpMbGenericTracker tracker_single(1, vpMbGenericTracker::EDGE_TRACKER);
+    tracker_single.loadModel(modelFile, false, odTo);
+    checkSameModel(tracker_single, tracker, 0.);
+  }
+
+  SECTION("Independent trackers share a model")
+  {
+    vpMbtModel model;
+    model.load(compiledFile);
+
+    vpMbGenericTracker tracker_file(1, vpMbGenericTracker::EDGE_TRACKER);
+    tracker_file.loadModel(compiledFile, false, odTo);
+    for (int i = 0; i < 3; ++i) {
+      vpMbGenericTracker tracker(1, vpMbGenericTracker::EDGE_TRACKER);
+      tracker.loadModel(model, odTo);
+      CHECK(&tracker.getModel().getPrimitive(0) == &model.getPrimitive(0));
+      checkSameModel(tracker_file, tracker, 0.);
+    }
+  }
+
+  SECTION("Lines shared by faces are added once")
+  {
+    const unsigned int n = 4;
+    const std::string gridFile = vpIoTools::createFilePath(tmp_dir, "grid.cao");
+    writeLargeModel(gridFile, n);
+    vpMbGenericTracker tracker(1, vpMbGenericTracker::EDGE_TRACKER);
+    tracker.loadModel(gridFile);
+
+    std::list<vpMbtDistanceLine *> lines;
+    tracker.getLline(lines);
+    CHECK(lines.size() == 2 * n * (n + 1));
+    size_t nbSharedLines = 0;
+    for (std::list<vpMbtDistanceLine *>::const_iterator it = lines.begin(); it != lines.end(); ++it) {
+      CHECK((*it)->Lindex_polygon.size() <= 2);
+      nbSharedLines += ((*it)->Lindex_polygon.size() == 2) ? 1 : 0;
+    }
+    CHECK(nbSharedLines == 2 * n * (n - 1));
+  }
+
+  vpIoTools::remove(tmp_dir);
+}
+
+TEST_CASE("Compiled model benchmark", "[benchmark]")
+{
+  if (runBenchmark) {
+    const std::string tmp_dir = vpIoTools::makeTempDirectory(vpIoTools::getTempPath());
+    const std::string modelFile = vpIoTools::createFilePath(tmp_dir, "grid.cao");
+    const std::string compiledFile = vpIoTools::createFilePath(tmp_dir, "grid.bin");
+    writeLargeModel(modelFile, 30);
+    vpMbtModel::compile(modelFile, compiledFile);
+
+    BENCHMARK("Benchmark parsing the text model")
+    {
+      vpMbtModel model;
+      model.load(modelFile);
+      return model.getNbPrimitives();
+    };
+    BENCHMARK("Benchmark loading the compiled model")
+    {
+      vpMbtModel model;
+      model.load(compiledFile);
+      return model.getNbPrimitives();
+    };
+    BENCHMARK("Benchmark tracker loading the text model")
+    {
+      vpMbGenericTracker tracker(1, vpMbGenericTracker::EDGE_TRACKER);
+      tracker.loadModel(modelFile);
+      return tracker.getFaces().size();
+    };
+    BENCHMARK("Benchmark tracker loading the compiled model")
+    {
+      vpMbGenericTracker tracker(1, vpMbGenericTracker::EDGE_TRACKER);
+      tracker.loadModel(compiledFile);
+      return tracker.getFaces().size();
+    };
+
+    vpMbtModel model;
+    model.load(compiledFile);
+    BENCHMARK("Benchmark tracker loading a shared model")
+    {
+      vpMbGenericTracker tracker(1, vpMbGenericTracker::EDGE_TRACKER);
+      tracker.loadModel(model);
+      return tracker.getFaces().size();
+    };
+
+    vpIoTools::remove(tmp_dir);
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session;
+
+  auto cli = session.cli()         // Get Catch's composite command line parser
+    | Catch::Clara::Opt(runBenchmark)   // bind variable to a new option, with a hint string
+    ["--benchmark"] // the option names it will respond to
+    ("run benchmark of the compiled models"); // description string for the help output
+
+  // Now pass the new composite back to Catch so it uses that
+  session.cli(cli);
+  session.applyCommandLine(argc, argv);
+  int numFailed = session.run();
+  return numFailed;
+}
+#else
+#include <cstdlib>
+
+int main() { return EXIT_SUCCESS; }
+#endif
@@ -0,0 +1,309 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2024 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test and benchmark the scanline visibility renderer.
+ */
+
+/*!
+  \example catchMbtScanLine.cpp
+
+  \brief Test and benchmark the scanline visibility renderer.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2)
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include <catch_amalgamated.hpp>
+#include <visp3/core/vpMeterPixelConversion.h>
+#include <visp3/core/vpUniRand.h>
+#include <visp3/mbt/vpMbScanLine.h>
+
+#ifdef ENABLE_VISP_NAMESPACE
+using namespace VISP_NAMESPACE_NAME;
+#endif
+
+namespace
+{
+bool runBenchmark = false;
+
+typedef std::vector<std::pair<vpPoint, unsigned int> > vpPolygon;
+typedef std::vector<std::pair<vpPoint, vpPoint> > vpLines;
+
+const unsigned int width = 640, height = 480;
+const vpCameraParameters cam(600, 600, 320, 240);
+
+// Point of the camera frame that projects in (u, v) at the given depth
+vpPoint backProject(double u, double v, double Z)
+{
+  vpPoint P;
+  P.set_X((u - cam.get_u0()) / cam.get_px() * Z);
+  P.set_Y((v - cam.get_v0()) / cam.get_py() * Z);
+  P.set_Z(Z);
+  return P;
+}
+
+vpPolygon createRectangle(double u0, double v0, double u1, double v1, double Z)
+{
+  vpPolygon polygon;
+  polygon.push_back(std::make_pair(backProject(u0, v0, Z), 0));
+  polygon.push_back(std::make_pair(backProject(u1, v0, Z), 1));
+  polygon.push_back(std::make_pair(backProject(u1, v1, Z), 2));
+  polygon.push_back(std::make_pair(backProject(u0, v1, Z), 3));
+  return polygon;
+}
+
+// Slanted triangles, quads and lines, some of them partially outside of the image, with vertices at integer
+// pixel coordinates when snap is true
+void createRandomScene(vpUniRand &rng, unsigned int nbPolygons, double maxRadius, bool snap,
+                       std::vector<vpPolygon> &polygons)
+{
+  polygons.resize(nbPolygons);
+  for (unsigned int i = 0; i < nbPolygons; ++i) {
+    const unsigned int nbPoints = (i % 7 == 0) ? 2 : ((i % 3 == 0) ? 3 : 4);
+    const double uc = rng.uniform(-50., width + 50.), vc = rng.uniform(-50., height + 50.);
+    const double radius = rng.uniform(2., maxRadius), Z = rng.uniform(0.5, 3.), dZ = rng.uniform(-0.3, 0.3);
+    polygons[i].clear();
+    for (unsigned int j = 0; j < nbPoints; ++j) {
+      const double angle = (2 * M_PI * j) / nbPoints + rng.uniform(-0.3, 0.3);
+      double u = uc + radius * std::cos(angle), v = vc + radius * std::sin(angle);
+      if (snap) {
+        u = vpMath::round(u);
+        v = vpMath::round(v);
+      }
+      polygons[i].push_back(std::make_pair(backProject(u, v, Z + dZ * std::cos(angle)), j));
+    }
+  }
+}
+
+void drawScene(vpMbScanLine &renderer, std::vector<vpPolygon> &polygons)
+{
+  std::vector<vpPolygon *> listPolygons;
+  std::vector<int> listIndices;
+  for (size_t i = 0; i < polygons.size(); ++i) {
+    listPolygons.push_back(&polygons[i]);
+    listIndices.push_back(static_cast<int>(i));
+  }
+  renderer.drawScene(listPolygons, listIndices, cam, width, height);
+}
+
+// Both orientations of the edges of the polygons
+void createQueries(const std::vector<vpPolygon> &polygons, vpLines &queries)
+{
+  queries.clear();
+  for (size_t i = 0; i < polygons.size(); ++i) {
+    const vpPolygon &polygon = polygons[i];
+    for (size_t j = 0; j < polygon.size(); ++j) {
+      const vpPoint &a = polygon[j].first, &b = polygon[(j + 1) % polygon.size()].first;
+      queries.push_back(std::make_pair(a, b));
+      queries.push_back(std::make_pair(b, a));
+    }
+  }
+}
+
+bool samePoint(const vpPoint &a, const vpPoint &b)
+{
+  const double eps = std::numeric_limits<double>::epsilon();
+  return vpMath::equal(a.get_X(), b.get_X(), eps) && vpMath::equal(a.get_Y(), b.get_Y(), eps) &&
+    vpMath::equal(a.get_Z(), b.get_Z(), eps);
+}
+
+bool sameLines(const vpLines &lines1, const vpLines &lines2)
+{
+  if (lines1.size() != lines2.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < lines1.size(); ++i) {
+    if (!samePoint(lines1[i].first, lines2[i].first) || !samePoint(lines1[i].second, lines2[i].second)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename Type> bool sameImage(const vpImage<Type> &I1, const vpImage<Type> &I2)
+{
+  if (I1.getHeight() != I2.getHeight() || I1.getWidth() != I2.getWidth()) {
+    return false;
+  }
+  for (unsigned int i = 0; i < I1.getSize(); ++i) {
+    if (I1.bitmap[i] != I2.bitmap[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
+TEST_CASE("Scanline visibility", "[mbt][visibility]")
+{
+  SECTION("A polygon hides the parts of the one behind it")
+  {
+    std::vector<vpPolygon> polygons;
+    polygons.push_back(createRectangle(100.5, 100.5, 300.5, 300.5, 2.));
+    polygons.push_back(createRectangle(200.5, 150.5, 400.5, 250.5, 1.));
+    vpMbScanLine renderer;
+    drawScene(renderer, polygons);
+
+    const vpImage<int> &ids = renderer.getPrimitiveIDs();
+    CHECK(ids[50][50] == -1);
+    CHECK(ids[200][150] == 0);
+    CHECK(ids[200][250] == 1);
+    CHECK(ids[200][350] == 1);
+    CHECK(ids[280][250] == 0);
+    CHECK(renderer.getMask()[200][250] == 255);
+    CHECK(renderer.getMask()[50][50] == 0);
+
+    vpLines lines;
+    // Top edge of the rectangle behind, fully visible
+    renderer.queryLineVisibility(polygons[0][0].first, polygons[0][1].first, lines);
+    REQUIRE(lines.size() == 1);
+    CHECK(samePoint(lines[0].first, polygons[0][0].first));
+    CHECK(samePoint(lines[0].second, polygons[0][1].first));
+
+    // Right edge of the rectangle behind, hidden between v = 150.5 and v = 250.5
+    renderer.queryLineVisibility(polygons[0][1].first, polygons[0][2].first, lines);
+    REQUIRE(lines.size() == 2);
+    CHECK(samePoint(lines[0].first, polygons[0][1].first));
+    CHECK(samePoint(lines[1].second, polygons[0][2].first));
+    vpImagePoint ip;
+    vpMeterPixelConversion::convertPoint(cam, lines[0].second.get_X() / lines[0].second.get_Z(),
+                                         lines[0].second.get_Y() / lines[0].second.get_Z(), ip);
+    CHECK(ip.get_v() == Catch::Approx(150.5).margin(1.));
+    vpMeterPixelConversion::convertPoint(cam, lines[1].first.get_X() / lines[1].first.get_Z(),
+                                         lines[1].first.get_Y() / lines[1].first.get_Z(), ip);
+    CHECK(ip.get_v() == Catch::Approx(250.5).margin(1.));
+
+    // A line that is not an edge of the scene
+    renderer.queryLineVisibility(backProject(10, 10, 1.), backProject(20, 20, 1.), lines);
+    CHECK(lines.empty());
+  }
+
+  SECTION("Same results whatever the number of threads")
+  {
+    vpUniRand rng(123);
+    vpMbScanLine renderer_ref, renderer;
+    renderer_ref.setNbThreads(1);
+    std::vector<vpPolygon> polygons;
+    vpLines queries;
+    for (unsigned int iter = 0; iter < 60; ++iter) {
+      INFO("Iteration " << iter);
+      createRandomScene(rng, 1 + (iter % 30) * 3, 150., (iter % 2) == 0, polygons);
+      const unsigned int maskBorder = (iter % 3 == 0) ? 3 : 0;
+      renderer_ref.setMaskBorder(maskBorder);
+      renderer.setMaskBorder(maskBorder);
+      // The buffers of the renderer are reused from one scene to the next
+      renderer.setNbThreads(2 + (iter % 7));
+      drawScene(renderer_ref, polygons);
+      drawScene(renderer, polygons);
+
+      CHECK(sameImage(renderer_ref.getPrimitiveIDs(), renderer.getPrimitiveIDs()));
+      CHECK(sameImage(renderer_ref.getMask(), renderer.getMask()));
+
+      createQueries(polygons, queries);
+      std::vector<vpLines> lines;
+      renderer.queryLinesVisibility(queries, lines);
+      REQUIRE(lines.size() == queries.size());
+      bool same = true;
+      for (size_t i = 0; i < queries.size(); ++i) {
+        vpLines lines_ref;
+        renderer_ref.queryLineVisibility(queries[i].first, queries[i].second, lines_ref);
+        same = same && sameLines(lines_ref, lines[i]);
+      }
+      CHECK(same);
+    }
+  }
+}
+
+TEST_CASE("Scanline visibility benchmark", "[benchmark]")
+{
+  if (runBenchmark) {
+    vpUniRand rng(42);
+    std::vector<vpPolygon> polygons;
+    createRandomScene(rng, 20000, 15., false, polygons);
+    vpLines queries;
+    createQueries(polygons, queries);
+
+    vpMbScanLine renderer_single, renderer;
+    renderer_single.setNbThreads(1);
+
+    BENCHMARK("Benchmark scanline rendering, one thread")
+    {
+      drawScene(renderer_single, polygons);
+      return renderer_single.getPrimitiveIDs()[height / 2][width / 2];
+    };
+    BENCHMARK("Benchmark scanline rendering")
+    {
+      drawScene(renderer, polygons);
+      return renderer.getPrimitiveIDs()[height / 2][width / 2];
+    };
+    BENCHMARK("Benchmark line visibility queries, one by one")
+    {
+      vpLines lines;
+      size_t nbLines = 0;
+      for (size_t i = 0; i < queries.size(); ++i) {
+        renderer.queryLineVisibility(queries[i].first, queries[i].second, lines);
+        nbLines += lines.size();
+      }
+      return nbLines;
+    };
+    BENCHMARK("Benchmark line visibility queries, batched")
+    {
+      std::vector<vpLines> lines;
+      renderer.queryLinesVisibility(queries, lines);
+      return lines.size();
+    };
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session;
+
+  auto cli = session.cli()         // Get Catch's composite command line parser
+    | Catch::Clara::Opt(runBenchmark)   // bind variable to a new option, with a hint string
+    ["--benchmark"] // the option names it will respond to
+    ("run benchmark of the scanline visibility renderer"); // description string for the help output
+
+  // Now pass the new composite back to Catch so it uses that
+  session.cli(cli);
+  session.applyCommandLine(argc, argv);
+  int numFailed = session.run();
+  return numFailed;
+}
+#else
+#include <cstdlib>
+
+int main() { return EXIT_SUCCESS; }
+#endif
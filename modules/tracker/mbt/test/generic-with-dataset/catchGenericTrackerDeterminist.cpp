@@ -281,6 +281,36 @@ TEST_CASE("Check Stereo MBT determinism parallel", "[MBT_determinism]")
   checkPoses(cMo1, cMo2);
 }
 
+TEST_CASE("Check Stereo MBT determinism with parallel camera tracking", "[MBT_determinism]")
+{
+  // Cameras processed sequentially
+  vpMbGenericTracker tracker1(2);
+  vpCameraParameters cam;
+  configureTracker(tracker1, cam);
+  CHECK_FALSE(tracker1.getParallelCameraTracking());
+
+  // Cameras processed concurrently
+  vpMbGenericTracker tracker2(2);
+  configureTracker(tracker2, cam);
+  tracker2.setParallelCameraTracking(true);
+  CHECK(tracker2.getParallelCameraTracking());
+
+  vpImage<unsigned char> I;
+  vpHomogeneousMatrix cMo1, cMo2;
+  for (int cpt = 0; read_data(cpt, I); cpt++) {
+    tracker1.track(I, I);
+    tracker1.getPose(cMo1);
+
+    tracker2.track(I, I);
+    tracker2.getPose(cMo2);
+  }
+  std::cout << "Sequential stereo tracker, final cMo:\n" << cMo1 << std::endl;
+  std::cout << "Parallel stereo tracker, final cMo:\n" << cMo2 << std::endl;
+
+  // Check that both poses are identical
+  checkPoses(cMo1, cMo2);
+}
+
 int main(int argc, char *argv[])
 {
   Catch::Session session;
@@ -411,6 +411,58 @@ TEST_CASE("Benchmark generic tracker", "[benchmark]")
         CHECK(sqrt(tu_err.sumSquare()) < max_rotation_error);
     }
   }
+
+  // Moving-edge sites of the model lines, tracked in the next image without pose estimation
+  {
+    vpMbGenericTracker edge_tracker(1, vpMbGenericTracker::EDGE_TRACKER);
+#if defined(VISP_HAVE_PUGIXML)
+    edge_tracker.loadConfigFile(configFileCam1, verbose);
+#else
+    edge_tracker.setCameraParameters(cam_color);
+    edge_tracker.setMovingEdge(tracker.getMovingEdge());
+    edge_tracker.setAngleAppear(vpMath::rad(85.0));
+    edge_tracker.setAngleDisappear(vpMath::rad(89.0));
+    edge_tracker.setNearClippingDistance(0.01);
+    edge_tracker.setFarClippingDistance(2.0);
+    edge_tracker.setClipping(edge_tracker.getClipping() | vpMbtPolygon::FOV_CLIPPING);
+#endif
+    edge_tracker.loadModel(input_directory + "/Models/chateau.cao", verbose);
+    edge_tracker.loadModel(input_directory + "/Models/cube.cao", verbose, T);
+    const vpMe me = edge_tracker.getMovingEdge();
+
+    // Sites initialized at the true pose of each image
+    std::vector<std::vector<vpMeSite> > sites_all;
+    for (size_t i = 0; i + 1 < images.size(); i++) {
+      edge_tracker.initFromPose(images[i], cMo_truth_all[i]);
+      std::list<vpMbtDistanceLine *> lines;
+      edge_tracker.getLline(lines);
+      std::vector<vpMeSite> sites;
+      for (vpMbtDistanceLine *line : lines) {
+        for (vpMbtMeLine *meline : line->meline) {
+          if (meline != nullptr) {
+            const std::list<vpMeSite> &meList = meline->getMeList();
+            sites.insert(sites.end(), meList.begin(), meList.end());
+          }
+        }
+      }
+      sites_all.push_back(sites);
+    }
+
+    unsigned int nbTracked = 0;
+    BENCHMARK("Moving edges tracking")
+    {
+      nbTracked = 0;
+      for (size_t i = 0; i < sites_all.size(); i++) {
+        std::vector<vpMeSite> sites = sites_all[i];
+        for (vpMeSite &site : sites) {
+          site.track(images[i + 1], &me, true);
+          nbTracked += (site.getState() == vpMeSite::NO_SUPPRESSION) ? 1 : 0;
+        }
+      }
+      return nbTracked;
+    };
+    CHECK(nbTracked > 0);
+  }
 } // if (runBenchmark)
 }
 
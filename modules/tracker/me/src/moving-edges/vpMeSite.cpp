@@ -336,28 +336,64 @@ void vpMeSite::track(const vpImage<unsigned char> &I, const vpMe *me, const bool
 
   // range = +/- range of pixels within which the correspondent
   // of the current pixel will be sought
-  unsigned int range = me->getRange();
-  const unsigned int normalSides = 2;
-  const unsigned int numQueries = range * normalSides + 1;
+  int range = static_cast<int>(me->getRange());
   unsigned int mask_index = computeMaskIndex(m_alpha, *me);
-  vpMeSite *list_query_pixels = getQueryList(I, static_cast<int>(range));
 
   double contrast_max = 1 + me->getMu2();
   double contrast_min = 1 - me->getMu1();
 
   double threshold = computeFinalThreshold(*me);
 
-  if (test_contrast) { // likelihood test
-    double diff = 1e6;
+  if (test_contrast) {
     // Change of mask sign to have a continuity at 0 and 180.
     // Threshold at 120 to be more than the 90 initial value
     if (vpMath::abs((int)(mask_index - m_index_prev)) > 120) {
       m_mask_sign = -m_mask_sign;
     }
-    for (unsigned int n = 0; n < numQueries; ++n) {
-      // Convolution results
-      list_query_pixels[n].m_mask_sign = m_mask_sign;
-      double convolution_ = list_query_pixels[n].convolution(I, *me, mask_index);
+  }
+
+  // The query sites along the normal are not instantiated: their position is
+  // computed on the fly and the convolution is done using row pointers, which
+  // avoids a heap allocation per site and per frame.
+  const int height = static_cast<int>(I.getHeight());
+  const int width = static_cast<int>(I.getWidth());
+  const unsigned int msize = me->getMaskSize();
+  const int half = static_cast<int>((msize - 1) >> 1);
+  const int margin = half + me->getStrip();
+  const vpMatrix &mask = me->getMask()[mask_index];
+  const double salpha = sin(m_alpha);
+  const double calpha = cos(m_alpha);
+  const bool displayRange = (m_selectDisplay == RANGE_RESULT) || (m_selectDisplay == RANGE);
+  double diff = 1e6;
+  vpImagePoint ip;
+
+  for (int k = -range; k <= range; ++k) {
+    const double ii = m_ifloat + (k * salpha);
+    const double jj = m_jfloat + (k * calpha);
+
+    if (displayRange) {
+      ip.set_i(ii);
+      ip.set_j(jj);
+      vpDisplay::displayCross(I, ip, 1, vpColor::yellow);
+    }
+
+    // Convolution results
+    double convolution_ = 0.0;
+    const int i = static_cast<int>(ii);
+    const int j = static_cast<int>(jj);
+    if (!outsideImage(i, j, margin, height, width)) {
+      const unsigned int ihalf = static_cast<unsigned int>(i - half);
+      const unsigned int jhalf = static_cast<unsigned int>(j - half);
+      for (unsigned int a = 0; a < msize; ++a) {
+        const double *mask_row = mask[a];
+        const unsigned char *im_row = I[ihalf + a] + jhalf;
+        for (unsigned int b = 0; b < msize; ++b) {
+          convolution_ += m_mask_sign * mask_row[b] * im_row[b];
+        }
+      }
+    }
+
+    if (test_contrast) { // likelihood test
       // no fabs since m_convlt > 0 and we look for a similar one
       const double likelihood = convolution_ + m_convlt;
 
@@ -367,22 +403,21 @@ void vpMeSite::track(const vpImage<unsigned char> &I, const vpMe *me, const bool
           diff = fabs(1 - contrast);
           max_convolution = convolution_;
           max = likelihood;
-          max_rank = static_cast<int>(n);
+          max_rank = k + range;
         }
       }
     }
-  }
-  else { // test on contrast only
-    for (unsigned int n = 0; n < numQueries; ++n) {
-      // Convolution results
-      double convolution_ = list_query_pixels[n].convolution(I, me);
+    else { // test on contrast only
       const double likelihood = fabs(2 * convolution_);
       if ((likelihood > max) && (likelihood > threshold)) {
         max_convolution = convolution_;
         max = likelihood;
-        max_rank = static_cast<int>(n);
+        max_rank = k + range;
       }
     }
+  }
+
+  if (!test_contrast) {
     // in case max_convolution < 0, change of mask sign so that m_convlt > 0
     // for the future likelihood tests
     if (max_convolution < 0) {
@@ -391,27 +426,41 @@ void vpMeSite::track(const vpImage<unsigned char> &I, const vpMe *me, const bool
     }
   }
 
-  vpImagePoint ip;
+  // Retrieve the position of the selected query site, or of the first one
+  // when none is retained for display purpose
+  const int k = (max_rank >= 0 ? max_rank : 0) - range;
+  const double ii = m_ifloat + (k * salpha);
+  const double jj = m_jfloat + (k * calpha);
+  int i = static_cast<int>(ii);
+  int j = static_cast<int>(jj);
+  if (outsideImage(i, j, margin, height, width)) {
+    i = 0;
+    j = 0;
+  }
 
   if (max_rank >= 0) {
     if ((m_selectDisplay == RANGE_RESULT) || (m_selectDisplay == RESULT)) {
-      ip.set_i(list_query_pixels[max_rank].m_i);
-      ip.set_j(list_query_pixels[max_rank].m_j);
+      ip.set_i(i);
+      ip.set_j(j);
       vpDisplay::displayPoint(I, ip, vpColor::red);
     }
 
-    list_query_pixels[max_rank].m_mask_sign = m_mask_sign;
-    list_query_pixels[max_rank].m_index_prev = mask_index;
-    list_query_pixels[max_rank].m_convlt = max_convolution;
-    list_query_pixels[max_rank].m_normGradient = vpMath::sqr(max_convolution);
-
-    *this = list_query_pixels[max_rank]; // The vpMeSite2 is replaced by the vpMeSite2 of max likelihood
+    // The site is replaced by the query site of max likelihood
+    m_i = i;
+    m_j = j;
+    m_ifloat = ii;
+    m_jfloat = jj;
+    m_index_prev = mask_index;
+    m_convlt = max_convolution;
+    m_normGradient = vpMath::sqr(max_convolution);
+    m_weight = 1;
+    m_state = NO_SUPPRESSION;
   }
   else // none of the query sites is better than the threshold
   {
     if ((m_selectDisplay == RANGE_RESULT) || (m_selectDisplay == RESULT)) {
-      ip.set_i(list_query_pixels[0].m_i);
-      ip.set_j(list_query_pixels[0].m_j);
+      ip.set_i(i);
+      ip.set_j(j);
       vpDisplay::displayPoint(I, ip, vpColor::green);
     }
     m_normGradient = 0;
@@ -421,9 +470,7 @@ void vpMeSite::track(const vpImage<unsigned char> &I, const vpMe *me, const bool
     else {
       m_state = THRESHOLD; // threshold suppression
     }
-
   }
-  delete[] list_query_pixels;
 }
 
 void vpMeSite::trackMultipleHypotheses(const vpImage<unsigned char> &I, const vpMe &me, const bool &test_contrast,
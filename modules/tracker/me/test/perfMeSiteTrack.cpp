@@ -0,0 +1,240 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2024 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test and benchmark moving-edges site tracking.
+ */
+
+/*!
+  \example perfMeSiteTrack.cpp
+
+  \brief Test and benchmark moving-edges site tracking against a naive
+  implementation based on vpMeSite::getQueryList().
+ */
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2)
+
+#include <vector>
+
+#include <catch_amalgamated.hpp>
+#include <visp3/core/vpMath.h>
+#include <visp3/me/vpMe.h>
+#include <visp3/me/vpMeSite.h>
+
+#ifdef ENABLE_VISP_NAMESPACE
+using namespace VISP_NAMESPACE_NAME;
+#endif
+
+static bool runBenchmark = false;
+
+namespace
+{
+// Dark disk on a bright background, the disk being slightly shifted between frames
+void createImage(vpImage<unsigned char> &I, double ic, double jc, double radius)
+{
+  I.resize(240, 320);
+  for (unsigned int i = 0; i < I.getHeight(); ++i) {
+    for (unsigned int j = 0; j < I.getWidth(); ++j) {
+      double d = sqrt(vpMath::sqr(i - ic) + vpMath::sqr(j - jc));
+      I[i][j] = static_cast<unsigned char>(d < radius ? 50 + (i + j) % 7 : 200 - (i * j) % 5);
+    }
+  }
+}
+
+// Sites sampled along the disk contour, some of them close to the image border
+std::vector<vpMeSite> createSites(double ic, double jc, double radius, const vpMe &me)
+{
+  std::vector<vpMeSite> sites;
+  const unsigned int nbSites = 360;
+  for (unsigned int n = 0; n < nbSites; ++n) {
+    double theta = (2 * M_PI * n) / nbSites;
+    vpMeSite site;
+    site.init(ic + radius * sin(theta), jc + radius * cos(theta), theta, 0, 1);
+    site.setContrastThreshold(10., me);
+    sites.push_back(site);
+  }
+  return sites;
+}
+
+// Former implementation of vpMeSite::track(), allocating the query sites
+void naiveTrack(vpMeSite &site, const vpImage<unsigned char> &I, const vpMe &me, bool test_contrast)
+{
+  int max_rank = -1;
+  double max_convolution = 0;
+  double max = 0;
+  double contrast = 0;
+  const unsigned int range = me.getRange();
+  const unsigned int numQueries = range * 2 + 1;
+  unsigned int mask_index = site.computeMaskIndex(site.m_alpha, me);
+  vpMeSite *list_query_pixels = site.getQueryList(I, static_cast<int>(range));
+  const double contrast_max = 1 + me.getMu2();
+  const double contrast_min = 1 - me.getMu1();
+  const double threshold = site.computeFinalThreshold(me);
+
+  if (test_contrast) {
+    double diff = 1e6;
+    for (unsigned int n = 0; n < numQueries; ++n) {
+      list_query_pixels[n].m_mask_sign = site.m_mask_sign;
+      double convolution_ = list_query_pixels[n].convolution(I, me, mask_index);
+      const double likelihood = convolution_ + site.m_convlt;
+      if (likelihood > threshold) {
+        contrast = convolution_ / site.m_convlt;
+        if ((contrast > contrast_min) && (contrast < contrast_max) && (fabs(1 - contrast) < diff)) {
+          diff = fabs(1 - contrast);
+          max_convolution = convolution_;
+          max = likelihood;
+          max_rank = static_cast<int>(n);
+        }
+      }
+    }
+  }
+  else {
+    for (unsigned int n = 0; n < numQueries; ++n) {
+      double convolution_ = list_query_pixels[n].convolution(I, &me);
+      const double likelihood = fabs(2 * convolution_);
+      if ((likelihood > max) && (likelihood > threshold)) {
+        max_convolution = convolution_;
+        max = likelihood;
+        max_rank = static_cast<int>(n);
+      }
+    }
+    if (max_convolution < 0) {
+      max_convolution = -max_convolution;
+      site.m_mask_sign = -site.m_mask_sign;
+    }
+  }
+
+  if (max_rank >= 0) {
+    const vpMeSite &best = list_query_pixels[max_rank];
+    site.m_i = best.m_i;
+    site.m_j = best.m_j;
+    site.m_ifloat = best.m_ifloat;
+    site.m_jfloat = best.m_jfloat;
+    site.m_convlt = max_convolution;
+    site.m_normGradient = vpMath::sqr(max_convolution);
+    site.m_weight = 1;
+    site.setState(vpMeSite::NO_SUPPRESSION);
+  }
+  else {
+    site.m_normGradient = 0;
+    site.setState(std::fabs(contrast) > std::numeric_limits<double>::epsilon() ? vpMeSite::CONTRAST
+                  : vpMeSite::THRESHOLD);
+  }
+  delete[] list_query_pixels;
+}
+
+void checkSites(const std::vector<vpMeSite> &sites, const std::vector<vpMeSite> &sites_ref)
+{
+  REQUIRE(sites.size() == sites_ref.size());
+  for (size_t n = 0; n < sites.size(); ++n) {
+    CHECK(sites[n].m_i == sites_ref[n].m_i);
+    CHECK(sites[n].m_j == sites_ref[n].m_j);
+    CHECK(sites[n].m_ifloat == sites_ref[n].m_ifloat);
+    CHECK(sites[n].m_jfloat == sites_ref[n].m_jfloat);
+    CHECK(sites[n].m_mask_sign == sites_ref[n].m_mask_sign);
+    CHECK(sites[n].m_convlt == sites_ref[n].m_convlt);
+    CHECK(sites[n].m_normGradient == sites_ref[n].m_normGradient);
+    CHECK(sites[n].getState() == sites_ref[n].getState());
+  }
+}
+} // anonymous namespace
+
+TEST_CASE("Moving-edges site tracking", "[me_site]")
+{
+  vpMe me;
+  me.setRange(7);
+  me.setMaskSize(5);
+  me.setMaskNumber(180);
+  me.setLikelihoodThresholdType(vpMe::NORMALIZED_THRESHOLD);
+  me.setThreshold(20);
+
+  vpImage<unsigned char> I0, I1;
+  const double ic = 115, jc = 150, radius = 110;
+  createImage(I0, ic, jc, radius);
+  createImage(I1, ic + 2.5, jc - 3.2, radius + 1.5);
+
+  std::vector<vpMeSite> sites = createSites(ic + 1.3, jc - 0.7, radius, me);
+  std::vector<vpMeSite> sites_ref = sites;
+
+  // Initialisation without likelihood test, then tracking with the contrast test
+  for (size_t n = 0; n < sites.size(); ++n) {
+    sites[n].track(I0, &me, false);
+    naiveTrack(sites_ref[n], I0, me, false);
+  }
+  checkSites(sites, sites_ref);
+
+  for (size_t n = 0; n < sites.size(); ++n) {
+    sites[n].track(I1, &me, true);
+    naiveTrack(sites_ref[n], I1, me, true);
+  }
+  checkSites(sites, sites_ref);
+
+  if (runBenchmark) {
+    const std::vector<vpMeSite> sites_init = sites;
+
+    BENCHMARK("Benchmark naive moving-edges site tracking")
+    {
+      sites_ref = sites_init;
+      for (size_t n = 0; n < sites_ref.size(); ++n) {
+        naiveTrack(sites_ref[n], I0, me, true);
+      }
+      return sites_ref;
+    };
+
+    BENCHMARK("Benchmark ViSP moving-edges site tracking")
+    {
+      sites = sites_init;
+      for (size_t n = 0; n < sites.size(); ++n) {
+        sites[n].track(I0, &me, true);
+      }
+      return sites;
+    };
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session;
+
+  auto cli = session.cli()         // Get Catch's composite command line parser
+    | Catch::Clara::Opt(runBenchmark)   // bind variable to a new option, with a hint string
+    ["--benchmark"] // the option names it will respond to
+    ("run benchmark comparing naive code with ViSP implementation"); // description string for the help output
+
+  // Now pass the new composite back to Catch so it uses that
+  session.cli(cli);
+  session.applyCommandLine(argc, argv);
+  int numFailed = session.run();
+  return numFailed;
+}
+#else
+int main() { return EXIT_SUCCESS; }
+#endif
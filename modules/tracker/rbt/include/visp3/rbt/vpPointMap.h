@@ -38,7 +38,10 @@
 #include <visp3/core/vpMeterPixelConversion.h>
 #include <visp3/core/vpPixelMeterConversion.h>
 
+#include <cstdint>
 #include <list>
+#include <unordered_map>
+#include <vector>
 
 BEGIN_VISP_NAMESPACE
 
@@ -51,6 +54,7 @@ public:
     m_minDistNewPoint = minDistNewPoints;
     m_maxDepthError = maxDepthErrorVisibility;
     m_outlierThreshold = outlierThreshold;
+    buildIndex();
   }
   /**
    * \name Settings
@@ -64,7 +68,11 @@ public:
   }
 
   double getMinDistanceAddNewPoints() const { return m_minDistNewPoint; }
-  void setMinDistanceAddNewPoints(double distance) { m_minDistNewPoint = distance; }
+  void setMinDistanceAddNewPoints(double distance)
+  {
+    m_minDistNewPoint = distance;
+    buildIndex();
+  }
 
   double getMaxDepthErrorVisibilityCriterion() const { return m_maxDepthError; }
   void setMaxDepthErrorVisibilityCriterion(double depthError) { m_maxDepthError = depthError; }
@@ -77,7 +85,11 @@ public:
   */
 
   const vpMatrix &getPoints() { return m_X; }
-  void setPoints(const vpMatrix &X) { m_X = X; }
+  void setPoints(const vpMatrix &X)
+  {
+    m_X = X;
+    buildIndex();
+  }
 
   void getPoints(const vpArray2D<int> &indices, vpMatrix &X);
 
@@ -100,9 +112,11 @@ public:
   void updatePoints(const vpArray2D<int> &indicesToRemove, const vpMatrix &pointsToAdd, std::list<int> &removedIndices, unsigned int &numAddedPoints);
   void updatePoint(unsigned int index, double X, double Y, double Z)
   {
+    removeFromIndex(index);
     m_X[index][0] = X;
     m_X[index][1] = Y;
     m_X[index][2] = Z;
+    addToIndex(index);
   }
 
   void computeReprojectionErrorAndJacobian(const vpArray2D<int> &indices, const vpHomogeneousMatrix &cTw, const vpMatrix &observations, vpMatrix &J, vpColVector &e) const
@@ -173,7 +187,27 @@ public:
   }
 
 private:
+  /**
+   * \name Spatial index
+   *
+   * The points of the map are hashed into cubic voxels whose side is the minimum distance between points.
+   * Points closer than this distance to a given location can only lie in the 27 voxels around it, which makes
+   * the minimum distance test of selectValidNewCandidates() independent of the map size.
+   * The index is disabled when the minimum distance is not strictly positive.
+   * @{
+  */
+  typedef std::unordered_map<int64_t, std::vector<unsigned int> > vpVoxelIndex;
+
+  void buildIndex();
+  void addToIndex(unsigned int index);
+  void moveInIndex(unsigned int index, unsigned int newIndex);
+  void removeFromIndex(unsigned int index);
+  /**
+   * @}
+  */
+
   vpMatrix m_X; // N x 3, points expressed in world frame
+  vpVoxelIndex m_voxels; // Map points indices, sorted by voxel
   unsigned m_maxPoints;
   double m_minDistNewPoint;
   double m_maxDepthError;
@@ -30,8 +30,67 @@
 
 #include <visp3/rbt/vpPointMap.h>
 
+#include <algorithm>
+#include <cmath>
+
 BEGIN_VISP_NAMESPACE
 
+namespace
+{
+void voxelCoordinates(const double *X, double voxelSize, int voxel[3])
+{
+  for (unsigned int k = 0; k < 3; ++k) {
+    voxel[k] = static_cast<int>(std::floor(X[k] / voxelSize));
+  }
+}
+
+// Pack 21 bits of each voxel coordinate. Collisions for very distant voxels only cost an extra distance test.
+int64_t voxelKey(int vx, int vy, int vz)
+{
+  const uint64_t mask = 0x1FFFFF;
+  return static_cast<int64_t>(((static_cast<uint64_t>(vx) & mask) << 42) | ((static_cast<uint64_t>(vy) & mask) << 21)
+                              | (static_cast<uint64_t>(vz) & mask));
+}
+
+int64_t voxelKey(const double *X, double voxelSize)
+{
+  int voxel[3];
+  voxelCoordinates(X, voxelSize, voxel);
+  return voxelKey(voxel[0], voxel[1], voxel[2]);
+}
+
+/*
+ * Check whether a point of the index is strictly closer than sqrt(distanceSq) to X, with distanceSq lower or
+ * equal to the squared voxel size. getPoint returns the coordinates of the point with the given index.
+ */
+template <typename PointAccessor>
+bool hasPointCloserThan(const std::unordered_map<int64_t, std::vector<unsigned int> > &voxels, double voxelSize,
+                        const double *X, double distanceSq, const PointAccessor &getPoint)
+{
+  int voxel[3];
+  voxelCoordinates(X, voxelSize, voxel);
+  for (int dx = -1; dx <= 1; ++dx) {
+    for (int dy = -1; dy <= 1; ++dy) {
+      for (int dz = -1; dz <= 1; ++dz) {
+        std::unordered_map<int64_t, std::vector<unsigned int> >::const_iterator it =
+          voxels.find(voxelKey(voxel[0] + dx, voxel[1] + dy, voxel[2] + dz));
+        if (it == voxels.end()) {
+          continue;
+        }
+        for (unsigned int index : it->second) {
+          const double *other = getPoint(index);
+          const double errSq = vpMath::sqr(X[0] - other[0]) + vpMath::sqr(X[1] - other[1]) + vpMath::sqr(X[2] - other[2]);
+          if (errSq < distanceSq) {
+            return true;
+          }
+        }
+      }
+    }
+  }
+  return false;
+}
+}
+
 void vpPointMap::getPoints(const vpArray2D<int> &indices, vpMatrix &X)
 {
   X.resize(indices.getRows(), 3, false, false);
@@ -189,6 +248,7 @@ void vpPointMap::selectValidNewCandidates(const vpCameraParameters &cam, const v
 
   std::vector<std::array<double, 3>> validoXList;
   validoXList.reserve(uvs.getRows());
+  vpVoxelIndex validoXVoxels;
 
   for (unsigned int i = 0; i < uvs.getRows(); ++i) {
     double u = uvs[i][0], v = uvs[i][1];
@@ -205,28 +265,21 @@ void vpPointMap::selectValidNewCandidates(const vpCameraParameters &cam, const v
     oX = wRc * cX;
     oX += t;
 
-    // Filter candidates that are too close to already existing points in the map
+    // Filter candidates that are too close to already existing points in the map or to already accepted candidates
     bool isFarEnoughFromOtherPoints = true;
     if (m_minDistNewPoint > 0.0) {
-      for (unsigned int j = 0; j < m_X.getRows(); ++j) {
-        double errSq = vpMath::sqr(oX[0] - m_X[j][0]) + vpMath::sqr(oX[1] - m_X[j][1]) + vpMath::sqr(oX[2] - m_X[j][2]);
-        if (errSq < farEnoughThresholdSq) {
-          isFarEnoughFromOtherPoints = false;
-          break;
-        }
-      }
+      isFarEnoughFromOtherPoints = !hasPointCloserThan(m_voxels, m_minDistNewPoint, oX.data, farEnoughThresholdSq,
+                                                       [this](unsigned int j) { return m_X[j]; });
       if (isFarEnoughFromOtherPoints) {
-        for (const std::array<double, 3> &other: validoXList) {
-          double errSq = vpMath::sqr(oX[0] - other[0]) + vpMath::sqr(oX[1] - other[1]) + vpMath::sqr(oX[2] - other[2]);
-          if (errSq < farEnoughThresholdSq) {
-            isFarEnoughFromOtherPoints = false;
-            break;
-          }
-        }
+        isFarEnoughFromOtherPoints = !hasPointCloserThan(validoXVoxels, m_minDistNewPoint, oX.data, farEnoughThresholdSq,
+                                                         [&validoXList](unsigned int j) { return validoXList[j].data(); });
       }
     }
 
     if (isFarEnoughFromOtherPoints) {
+      if (m_minDistNewPoint > 0.0) {
+        validoXVoxels[voxelKey(oX.data, m_minDistNewPoint)].push_back(static_cast<unsigned int>(validoXList.size()));
+      }
       validoXList.push_back({ oX[0], oX[1], oX[2] });
       validCandidateIndices.push_back(originalIndices[i][0]);
     }
@@ -276,6 +329,22 @@ void vpPointMap::updatePoints(const vpArray2D<int> &indicesToRemove, const vpMat
 
     removedIndices.merge(startingIndices);
   }
+  // Kept rows are shifted down by the number of removed rows before them
+  if (m_minDistNewPoint > 0.0 && !removedIndices.empty()) {
+    std::list<int>::const_iterator removedIt = removedIndices.begin();
+    unsigned int shift = 0;
+    for (unsigned int i = static_cast<unsigned int>(removedIndices.front()); i < m_X.getRows(); ++i) {
+      if (removedIt != removedIndices.end() && static_cast<unsigned int>(*removedIt) == i) {
+        removeFromIndex(i);
+        ++shift;
+        ++removedIt;
+      }
+      else {
+        moveInIndex(i, i - shift);
+      }
+    }
+  }
+
   vpMatrix newX(newSize, 3);
 
   unsigned int newXIndex = 0;
@@ -305,6 +374,56 @@ void vpPointMap::updatePoints(const vpArray2D<int> &indicesToRemove, const vpMat
   }
 
   m_X = std::move(newX);
+  for (unsigned int i = m_X.getRows() - numAddedPoints; i < m_X.getRows(); ++i) {
+    addToIndex(i);
+  }
+}
+
+void vpPointMap::buildIndex()
+{
+  m_voxels.clear();
+  for (unsigned int i = 0; i < m_X.getRows(); ++i) {
+    addToIndex(i);
+  }
+}
+
+void vpPointMap::addToIndex(unsigned int index)
+{
+  if (m_minDistNewPoint > 0.0) {
+    m_voxels[voxelKey(m_X[index], m_minDistNewPoint)].push_back(index);
+  }
+}
+
+void vpPointMap::moveInIndex(unsigned int index, unsigned int newIndex)
+{
+  if (m_minDistNewPoint > 0.0) {
+    vpVoxelIndex::iterator it = m_voxels.find(voxelKey(m_X[index], m_minDistNewPoint));
+    if (it != m_voxels.end()) {
+      std::vector<unsigned int> &indices = it->second;
+      std::vector<unsigned int>::iterator indexIt = std::find(indices.begin(), indices.end(), index);
+      if (indexIt != indices.end()) {
+        *indexIt = newIndex;
+      }
+    }
+  }
+}
+
+void vpPointMap::removeFromIndex(unsigned int index)
+{
+  if (m_minDistNewPoint > 0.0) {
+    vpVoxelIndex::iterator it = m_voxels.find(voxelKey(m_X[index], m_minDistNewPoint));
+    if (it != m_voxels.end()) {
+      std::vector<unsigned int> &indices = it->second;
+      std::vector<unsigned int>::iterator indexIt = std::find(indices.begin(), indices.end(), index);
+      if (indexIt != indices.end()) {
+        *indexIt = indices.back();
+        indices.pop_back();
+      }
+      if (indices.empty()) {
+        m_voxels.erase(it);
+      }
+    }
+  }
 }
 
 END_VISP_NAMESPACE
@@ -0,0 +1,209 @@
+/*
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2024 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See https://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the selection of new points for vpPointMap.
+ */
+
+/*!
+  \example catchPointMap.cpp
+
+  \brief Test the selection of new points for vpPointMap.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2)
+
+#include <catch_amalgamated.hpp>
+#include <visp3/core/vpCameraParameters.h>
+#include <visp3/core/vpHomogeneousMatrix.h>
+#include <visp3/core/vpPixelMeterConversion.h>
+#include <visp3/core/vpUniRand.h>
+#include <visp3/rbt/vpPointMap.h>
+
+#include <list>
+#include <vector>
+
+#ifdef ENABLE_VISP_NAMESPACE
+using namespace VISP_NAMESPACE_NAME;
+#endif
+
+namespace
+{
+double squaredDistance(const double *a, const double *b)
+{
+  return vpMath::sqr(a[0] - b[0]) + vpMath::sqr(a[1] - b[1]) + vpMath::sqr(a[2] - b[2]);
+}
+
+// Exhaustive minimum distance test against the map points and the candidates accepted so far
+std::list<int> selectExhaustive(const vpMatrix &X, const vpMatrix &oXCandidates, double minDist)
+{
+  std::list<int> expectedIndices;
+  std::vector<unsigned int> accepted;
+  for (unsigned int i = 0; i < oXCandidates.getRows(); ++i) {
+    bool farEnough = true;
+    for (unsigned int j = 0; j < X.getRows() && farEnough; ++j) {
+      farEnough = squaredDistance(oXCandidates[i], X[j]) >= (minDist * minDist);
+    }
+    for (size_t k = 0; k < accepted.size() && farEnough; ++k) {
+      farEnough = squaredDistance(oXCandidates[i], oXCandidates[accepted[k]]) >= (minDist * minDist);
+    }
+    if (farEnough) {
+      accepted.push_back(i);
+      expectedIndices.push_back(static_cast<int>(i));
+    }
+  }
+  return expectedIndices;
+}
+}
+
+SCENARIO("Selecting new points for the point map", "[rbt]")
+{
+  const unsigned int h = 240, w = 320;
+  const vpCameraParameters cam(300, 300, w / 2, h / 2);
+  const vpHomogeneousMatrix cTw(0.01, -0.02, 0.0, 0.0, 0.1, 0.0);
+  const vpHomogeneousMatrix wTc = cTw.inverse();
+  vpImage<float> depth(h, w, 0.5f);
+  const double minDist = 0.005;
+  vpUniRand random(421);
+
+  // Candidates are drawn from the whole image, half of them being already in the map
+  const unsigned int numCandidates = 2000;
+  vpArray2D<int> candidateIndices(numCandidates, 1);
+  vpMatrix uvs(numCandidates, 2);
+  vpMatrix oXCandidates(numCandidates, 3);
+  for (unsigned int i = 0; i < numCandidates; ++i) {
+    candidateIndices[i][0] = static_cast<int>(i);
+    uvs[i][0] = random.uniform(0.0, static_cast<double>(w - 1));
+    uvs[i][1] = random.uniform(0.0, static_cast<double>(h - 1));
+    double x, y;
+    vpPixelMeterConversion::convertPointWithoutDistortion(cam, uvs[i][0], uvs[i][1], x, y);
+    vpColVector cX({ x * 0.5, y * 0.5, 0.5, 1.0 });
+    vpColVector oX = wTc * cX;
+    for (unsigned int j = 0; j < 3; ++j) {
+      oXCandidates[i][j] = oX[j];
+    }
+  }
+  vpMatrix X(numCandidates / 2, 3);
+  for (unsigned int i = 0; i < X.getRows(); ++i) {
+    for (unsigned int j = 0; j < 3; ++j) {
+      X[i][j] = oXCandidates[i * 2][j] + random.uniform(-minDist, minDist);
+    }
+  }
+
+  vpPointMap map(10000, minDist, 0.01, 2.0);
+  map.setPoints(X);
+
+  WHEN("Checking the minimum distance to the map and to the other candidates")
+  {
+    const std::list<int> expectedIndices = selectExhaustive(X, oXCandidates, minDist);
+
+    vpMatrix oXs;
+    std::list<int> validIndices;
+    map.selectValidNewCandidates(cam, cTw, candidateIndices, uvs, depth, oXs, validIndices);
+    THEN("The selected candidates are the same as with an exhaustive search")
+    {
+      REQUIRE(validIndices == expectedIndices);
+      REQUIRE(oXs.getRows() == validIndices.size());
+    }
+  }
+
+  WHEN("Moving a map point on a candidate")
+  {
+    map.updatePoint(0, oXCandidates[1][0], oXCandidates[1][1], oXCandidates[1][2]);
+    vpArray2D<int> singleIndex(1, 1, 1);
+    vpMatrix singleUv(1, 2);
+    singleUv[0][0] = uvs[1][0];
+    singleUv[0][1] = uvs[1][1];
+    vpMatrix oXs;
+    std::list<int> validIndices;
+    map.selectValidNewCandidates(cam, cTw, singleIndex, singleUv, depth, oXs, validIndices);
+    THEN("The candidate is rejected")
+    {
+      REQUIRE(validIndices.empty());
+    }
+  }
+
+  WHEN("Removing and adding map points")
+  {
+    // Remove every third point and add points near the odd candidates, the map overflows so the oldest points go
+    vpArray2D<int> indicesToRemove(X.getRows() / 3, 1);
+    for (unsigned int i = 0; i < indicesToRemove.getRows(); ++i) {
+      indicesToRemove[i][0] = static_cast<int>(i * 3 + 1);
+    }
+    vpMatrix pointsToAdd(200, 3);
+    for (unsigned int i = 0; i < pointsToAdd.getRows(); ++i) {
+      for (unsigned int j = 0; j < 3; ++j) {
+        pointsToAdd[i][j] = oXCandidates[i * 2 + 1][j] + random.uniform(-minDist, minDist);
+      }
+    }
+    map.setNumMaxPoints(X.getRows() - indicesToRemove.getRows() + 100);
+    std::list<int> removedIndices;
+    unsigned int numAddedPoints = 0;
+    map.updatePoints(indicesToRemove, pointsToAdd, removedIndices, numAddedPoints);
+    const vpMatrix updatedX = map.getPoints();
+    REQUIRE(numAddedPoints == pointsToAdd.getRows());
+    REQUIRE(updatedX.getRows() == map.getNumMaxPoints());
+
+    const std::list<int> expectedIndices = selectExhaustive(updatedX, oXCandidates, minDist);
+
+    vpMatrix oXs;
+    std::list<int> validIndices;
+    map.selectValidNewCandidates(cam, cTw, candidateIndices, uvs, depth, oXs, validIndices);
+    THEN("The selected candidates are the same as with an exhaustive search")
+    {
+      REQUIRE(validIndices == expectedIndices);
+    }
+
+    THEN("Moving a map point still updates the index")
+    {
+      const unsigned int last = updatedX.getRows() - 1;
+      map.updatePoint(last, oXCandidates[0][0] + 1.0, oXCandidates[0][1], oXCandidates[0][2]);
+      map.updatePoint(last, oXCandidates[0][0], oXCandidates[0][1], oXCandidates[0][2]);
+      vpArray2D<int> singleIndex(1, 1, 0);
+      vpMatrix singleUv(1, 2);
+      singleUv[0][0] = uvs[0][0];
+      singleUv[0][1] = uvs[0][1];
+      map.selectValidNewCandidates(cam, cTw, singleIndex, singleUv, depth, oXs, validIndices);
+      REQUIRE(validIndices.empty());
+    }
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session;
+  session.applyCommandLine(argc, argv);
+  int numFailed = session.run();
+  return numFailed;
+}
+#else
+int main() { return EXIT_SUCCESS; }
+#endif
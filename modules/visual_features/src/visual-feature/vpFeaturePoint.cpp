@@ -49,6 +49,7 @@
 #include <visp3/core/vpDebug.h>
 
 // math
+#include <visp3/core/vpFixedMatrix.h>
 #include <visp3/core/vpMath.h>
 
 #include <visp3/core/vpFeatureDisplay.h>
@@ -214,8 +215,6 @@ vpMatrix vpFeaturePoint::interaction(unsigned int select)
 {
   vpMatrix L;
 
-  L.resize(0, 6);
-
   if (deallocate == vpBasicFeature::user) {
     for (unsigned int i = 0; i < nbParameters; i++) {
       if (flags[i] == false) {
@@ -258,32 +257,34 @@ vpMatrix vpFeaturePoint::interaction(unsigned int select)
     throw(vpFeatureException(vpFeatureException::badInitializationError, "Point Z coordinates is null"));
   }
 
-  if (vpFeaturePoint::selectX() & select) {
-    vpMatrix Lx(1, 6);
-    Lx = 0;
-
-    Lx[0][0] = -1 / Z_;
-    Lx[0][1] = 0;
-    Lx[0][2] = x_ / Z_;
-    Lx[0][3] = x_ * y_;
-    Lx[0][4] = -(1 + x_ * x_);
-    Lx[0][5] = y_;
-
-    L = vpMatrix::stack(L, Lx);
-  }
-
-  if (vpFeaturePoint::selectY() & select) {
-    vpMatrix Ly(1, 6);
-    Ly = 0;
-
-    Ly[0][0] = 0;
-    Ly[0][1] = -1 / Z_;
-    Ly[0][2] = y_ / Z_;
-    Ly[0][3] = 1 + y_ * y_;
-    Ly[0][4] = -x_ * y_;
-    Ly[0][5] = -x_;
-
-    L = vpMatrix::stack(L, Ly);
+  // Both rows are built on the stack, then the selected ones are copied in L
+  // that is allocated only once
+  vpFixedMatrix<2, 6> Lxy;
+  Lxy[0][0] = -1 / Z_;
+  Lxy[0][1] = 0;
+  Lxy[0][2] = x_ / Z_;
+  Lxy[0][3] = x_ * y_;
+  Lxy[0][4] = -(1 + x_ * x_);
+  Lxy[0][5] = y_;
+
+  Lxy[1][0] = 0;
+  Lxy[1][1] = -1 / Z_;
+  Lxy[1][2] = y_ / Z_;
+  Lxy[1][3] = 1 + y_ * y_;
+  Lxy[1][4] = -x_ * y_;
+  Lxy[1][5] = -x_;
+
+  const bool selectX = (vpFeaturePoint::selectX() & select) != 0;
+  const bool selectY = (vpFeaturePoint::selectY() & select) != 0;
+  L.resize((selectX ? 1 : 0) + (selectY ? 1 : 0), 6, false, false);
+  unsigned int row = 0;
+  for (unsigned int i = 0; i < 2; i++) {
+    if ((i == 0) ? selectX : selectY) {
+      for (unsigned int j = 0; j < 6; j++) {
+        L[row][j] = Lxy[i][j];
+      }
+      row++;
+    }
   }
   return L;
 }